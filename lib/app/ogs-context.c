@@ -62,6 +62,17 @@ ogs_app_context_t *ogs_app()
     return &self;
 }
 
+static void recalculate_packet_pool_size(void)
+{
+    /*
+     * The UP function buffers downlink packets up to pool.buffer bytes.
+     * One packet per UE, and the bursts of recvmmsg()/sendmmsg(),
+     * are added for the packets being forwarded.
+     */
+    self.pool.packet = self.pool.buffer / OGS_MAX_PKT_LEN +
+        self.max.ue + 2 * OGS_MAX_NUM_OF_MMSG;
+}
+
 static void recalculate_pool_size(void)
 {
 #define MAX_NUM_OF_TUNNEL       3   /* Num of Tunnel per Bearer */
@@ -74,7 +85,10 @@ static void recalculate_pool_size(void)
     self.pool.message = self.max.ue;
     self.pool.event = self.max.ue;
 
-    self.pool.packet = self.max.ue * OGS_MAX_NUM_OF_PACKET_BUFFER;
+#define MAX_NUM_OF_BUFFERED_PACKET  8 /* Num of buffered packets per UE */
+    self.pool.buffer =
+        self.max.ue * MAX_NUM_OF_BUFFERED_PACKET * OGS_MAX_PKT_LEN;
+    recalculate_packet_pool_size();
 
     self.pool.nf = self.max.gnb;
 
@@ -188,6 +202,9 @@ static void app_context_prepare(void)
 
     self.sockopt.no_delay = true;
 
+#define METRICS_HTTP_PORT           9090
+    self.metrics.port = METRICS_HTTP_PORT;
+
 #define MAX_NUM_OF_UE               1024    /* Num of UE per AMF/MME */
 #define MAX_NUM_OF_GNB              32      /* Num of gNB per AMF/MME */
 
@@ -281,6 +298,20 @@ int ogs_app_context_parse_config(void)
                         ogs_yaml_iter_value(&logger_iter);
                 }
             }
+        } else if (!strcmp(root_key, "metrics")) {
+            ogs_yaml_iter_t metrics_iter;
+            ogs_yaml_iter_recurse(&root_iter, &metrics_iter);
+            while (ogs_yaml_iter_next(&metrics_iter)) {
+                const char *metrics_key = ogs_yaml_iter_key(&metrics_iter);
+                ogs_assert(metrics_key);
+                if (!strcmp(metrics_key, "addr")) {
+                    self.metrics.addr = ogs_yaml_iter_value(&metrics_iter);
+                } else if (!strcmp(metrics_key, "port")) {
+                    const char *v = ogs_yaml_iter_value(&metrics_iter);
+                    if (v) self.metrics.port = atoi(v);
+                } else
+                    ogs_warn("unknown key `%s`", metrics_key);
+            }
         } else if (!strcmp(root_key, "parameter")) {
             ogs_yaml_iter_t parameter_iter;
             ogs_yaml_iter_recurse(&root_iter, &parameter_iter);
@@ -470,6 +501,14 @@ int ogs_app_context_parse_config(void)
                     const char *v = ogs_yaml_iter_value(&pool_iter);
                     if (v)
                         self.pool.defconfig.cluster_big_pool = atoi(v);
+                } else if (!strcmp(pool_key, "buffer")) {
+                    const char *v = ogs_yaml_iter_value(&pool_iter);
+                    if (v) {
+                        self.pool.buffer = atoll(v);
+                        recalculate_packet_pool_size();
+                    }
+                } else if (!strcmp(pool_key, "trim")) {
+                    self.pool.trim = ogs_yaml_iter_bool(&pool_iter);
                 } else
                     ogs_warn("unknown key `%s`", pool_key);
             }
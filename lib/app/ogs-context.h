@@ -47,6 +47,14 @@ typedef struct ogs_app_context_s {
     ogs_timer_mgr_t *timer_mgr;
     ogs_pollset_t *pollset;
 
+    struct {
+        const char *addr;
+        uint16_t port;
+
+        ogs_socknode_t *node;
+        ogs_metrics_server_t *server;
+    } metrics;
+
     struct {
         /* Element */
         int no_mme;
@@ -109,6 +117,7 @@ typedef struct ogs_app_context_s {
     struct {
         ogs_pkbuf_config_t defconfig;
         uint64_t packet;
+        uint64_t buffer;    /* Bytes of the buffered downlink packets */
 
         uint64_t nf;
 
@@ -132,6 +141,9 @@ typedef struct ogs_app_context_s {
 
         uint64_t impi;
         uint64_t impu;
+
+        /* Give the memory of an empty chunk back to the OS */
+        bool trim;
     } pool;
 
     struct {
@@ -149,11 +149,35 @@ int ogs_app_initialize(
     ogs_app()->pollset = ogs_pollset_create(ogs_app()->pool.socket);
     ogs_assert(ogs_app()->pollset);
 
+    /**************************************************************************
+     * Stage 8 : Metrics served from the event loop of the NF
+     */
+    if (ogs_app()->metrics.addr) {
+        ogs_sockaddr_t *addr = NULL;
+
+        rv = ogs_getaddrinfo(&addr, AF_UNSPEC,
+                ogs_app()->metrics.addr, ogs_app()->metrics.port, 0);
+        if (rv != OGS_OK) return rv;
+
+        ogs_app()->metrics.node = ogs_socknode_new(addr);
+        ogs_assert(ogs_app()->metrics.node);
+
+        ogs_app()->metrics.server = ogs_metrics_server_open(
+                ogs_app()->pollset, ogs_app()->timer_mgr,
+                ogs_app()->metrics.node);
+        if (!ogs_app()->metrics.server) return OGS_ERROR;
+    }
+
     return rv;
 }
 
 void ogs_app_terminate(void)
 {
+    if (ogs_app()->metrics.server)
+        ogs_metrics_server_close(ogs_app()->metrics.server);
+    if (ogs_app()->metrics.node)
+        ogs_socknode_free(ogs_app()->metrics.node);
+
     ogs_app_context_final();
 
     ogs_pkbuf_default_destroy();
@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "core-config-private.h"
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include "ogs-core.h"
+
+#define CHECKPOINT_MAGIC        "OGSCKPT"
+#define CHECKPOINT_NAME_LEN     32
+#define CHECKPOINT_ALIGN(__sIZE, __aLIGN) \
+    (((__sIZE) + (__aLIGN) - 1) & ~((size_t)(__aLIGN) - 1))
+
+typedef struct checkpoint_header_s {
+    char magic[8];
+    char name[CHECKPOINT_NAME_LEN];
+    uint32_t version;
+    uint32_t num_of_slot;
+    uint64_t user_size;
+    uint64_t slot_size;
+} checkpoint_header_t;
+
+/* Followed by the encoded data */
+typedef struct checkpoint_slot_s {
+    uint32_t length;
+    uint32_t checksum;
+} checkpoint_slot_t;
+
+struct ogs_checkpoint_s {
+    int fd;
+    uint8_t *base;
+    size_t size;
+
+    size_t user_offset;
+    size_t slot_offset;
+    size_t slot_size;
+    size_t slot_stride;
+    int num_of_slot;
+
+    bool restored;
+
+    uint8_t *dirty;             /* Bitmap of the dirty slots */
+    int *dirty_list;
+    int num_of_dirty;
+
+    ogs_time_t sync_interval;
+    ogs_time_t last_sync;
+    bool unsynced;
+};
+
+/* FNV-1a */
+static uint32_t checkpoint_checksum(const uint8_t *data, size_t length)
+{
+    uint32_t hash = 2166136261U;
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static checkpoint_slot_t *checkpoint_slot(ogs_checkpoint_t *cp, int index)
+{
+    ogs_assert(index > 0 && index <= cp->num_of_slot);
+
+    return (checkpoint_slot_t *)
+        (cp->base + cp->slot_offset + (size_t)(index-1) * cp->slot_stride);
+}
+
+ogs_checkpoint_t *ogs_checkpoint_open(const char *path,
+        const char *name, uint32_t version,
+        size_t user_size, size_t slot_size, int num_of_slot)
+{
+#if HAVE_SYS_MMAN_H
+    ogs_checkpoint_t *cp = NULL;
+    checkpoint_header_t header, old;
+    struct stat st;
+
+    ogs_assert(path);
+    ogs_assert(name);
+    ogs_assert(strlen(name) < CHECKPOINT_NAME_LEN);
+    ogs_assert(slot_size > 0);
+    ogs_assert(num_of_slot > 0);
+
+    cp = calloc(1, sizeof(*cp));
+    ogs_assert(cp);
+
+    cp->user_offset = CHECKPOINT_ALIGN(sizeof(checkpoint_header_t), 64);
+    cp->slot_offset = CHECKPOINT_ALIGN(cp->user_offset + user_size, 64);
+    cp->slot_size = slot_size;
+    cp->slot_stride = CHECKPOINT_ALIGN(
+            sizeof(checkpoint_slot_t) + slot_size, sizeof(uint64_t));
+    cp->num_of_slot = num_of_slot;
+    cp->size = cp->slot_offset + (size_t)num_of_slot * cp->slot_stride;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    ogs_cpystrn(header.name, name, CHECKPOINT_NAME_LEN);
+    header.version = version;
+    header.num_of_slot = num_of_slot;
+    header.user_size = user_size;
+    header.slot_size = slot_size;
+
+    cp->fd = open(path, O_RDWR|O_CREAT, 0600);
+    if (cp->fd < 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno, "open(%s) failed", path);
+        goto cleanup;
+    }
+
+    if (fstat(cp->fd, &st) != 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno, "fstat(%s) failed", path);
+        goto cleanup;
+    }
+
+    if ((size_t)st.st_size == cp->size &&
+        pread(cp->fd, &old, sizeof(old), 0) == sizeof(old) &&
+        memcmp(&old, &header, sizeof(header)) == 0) {
+        cp->restored = true;
+    } else {
+        if (st.st_size)
+            ogs_warn("Checkpoint '%s' does not match [%s]", path, name);
+
+        /* The file is zero-filled, so every slot is empty */
+        if (ftruncate(cp->fd, 0) != 0 ||
+            ftruncate(cp->fd, cp->size) != 0) {
+            ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                    "ftruncate(%s) failed", path);
+            goto cleanup;
+        }
+    }
+
+    cp->base = mmap(NULL, cp->size,
+            PROT_READ|PROT_WRITE, MAP_SHARED, cp->fd, 0);
+    if (cp->base == MAP_FAILED) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno, "mmap(%s) failed", path);
+        cp->base = NULL;
+        goto cleanup;
+    }
+
+    /* The header is written last */
+    if (cp->restored == false)
+        memcpy(cp->base, &header, sizeof(header));
+
+    cp->dirty = calloc((num_of_slot + 7) / 8, sizeof(*cp->dirty));
+    ogs_assert(cp->dirty);
+    cp->dirty_list = malloc(sizeof(*cp->dirty_list) * num_of_slot);
+    ogs_assert(cp->dirty_list);
+
+    cp->last_sync = ogs_get_monotonic_time();
+
+    ogs_info("Checkpoint '%s' [%s:%d slots of %d bytes] %s", path, name,
+            num_of_slot, (int)slot_size, cp->restored ? "restored" : "created");
+
+    return cp;
+
+cleanup:
+    if (cp->base)
+        munmap(cp->base, cp->size);
+    if (cp->fd >= 0)
+        close(cp->fd);
+    free(cp);
+
+    return NULL;
+#else
+    ogs_error("Checkpoint is not supported on this platform");
+    return NULL;
+#endif
+}
+
+void ogs_checkpoint_close(ogs_checkpoint_t *cp)
+{
+    ogs_assert(cp);
+
+#if HAVE_SYS_MMAN_H
+    if (cp->sync_interval)
+        ogs_checkpoint_sync(cp);
+
+    munmap(cp->base, cp->size);
+    close(cp->fd);
+#endif
+
+    free(cp->dirty);
+    free(cp->dirty_list);
+    free(cp);
+}
+
+bool ogs_checkpoint_restored(ogs_checkpoint_t *cp)
+{
+    ogs_assert(cp);
+    return cp->restored;
+}
+
+void *ogs_checkpoint_user(ogs_checkpoint_t *cp)
+{
+    ogs_assert(cp);
+    return cp->base + cp->user_offset;
+}
+
+void ogs_checkpoint_set_sync(ogs_checkpoint_t *cp, ogs_time_t sync_interval)
+{
+    ogs_assert(cp);
+    cp->sync_interval = sync_interval;
+}
+
+void ogs_checkpoint_mark(ogs_checkpoint_t *cp, int index)
+{
+    ogs_assert(cp);
+    ogs_assert(index > 0 && index <= cp->num_of_slot);
+
+    if (cp->dirty[(index-1) / 8] & (1 << ((index-1) % 8)))
+        return;
+
+    cp->dirty[(index-1) / 8] |= (1 << ((index-1) % 8));
+    cp->dirty_list[cp->num_of_dirty++] = index;
+}
+
+int ogs_checkpoint_flush(ogs_checkpoint_t *cp,
+        ogs_checkpoint_encode_f encode, void *data)
+{
+    int i, index, length, num_of_dirty;
+    checkpoint_slot_t *slot = NULL;
+
+    ogs_assert(cp);
+    ogs_assert(encode);
+
+    num_of_dirty = cp->num_of_dirty;
+
+    for (i = 0; i < num_of_dirty; i++) {
+        index = cp->dirty_list[i];
+        cp->dirty[(index-1) / 8] &= ~(1 << ((index-1) % 8));
+
+        slot = checkpoint_slot(cp, index);
+
+        /* Encoded in place, and validated by the checksum */
+        length = encode(index, slot + 1, cp->slot_size, data);
+        if (length < 0 || length > cp->slot_size) {
+            ogs_error("Cannot encode the checkpoint [%d:%d]", index, length);
+            length = 0;
+        }
+
+        slot->checksum = checkpoint_checksum((uint8_t *)(slot + 1), length);
+        slot->length = length;
+    }
+    cp->num_of_dirty = 0;
+
+    if (num_of_dirty)
+        cp->unsynced = true;
+
+    if (cp->sync_interval && cp->unsynced &&
+        ogs_get_monotonic_time() - cp->last_sync >= cp->sync_interval)
+        ogs_checkpoint_sync(cp);
+
+    return num_of_dirty;
+}
+
+void ogs_checkpoint_sync(ogs_checkpoint_t *cp)
+{
+    ogs_assert(cp);
+
+#if HAVE_SYS_MMAN_H
+    if (msync(cp->base, cp->size, MS_SYNC) != 0)
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno, "msync() failed");
+#endif
+
+    cp->unsynced = false;
+    cp->last_sync = ogs_get_monotonic_time();
+}
+
+int ogs_checkpoint_restore(ogs_checkpoint_t *cp,
+        ogs_checkpoint_decode_f decode, void *data)
+{
+    int index, count = 0;
+    checkpoint_slot_t *slot = NULL;
+
+    ogs_assert(cp);
+    ogs_assert(decode);
+
+    for (index = 1; index <= cp->num_of_slot; index++) {
+        slot = checkpoint_slot(cp, index);
+        if (slot->length == 0)
+            continue;
+
+        if (slot->length > cp->slot_size ||
+            slot->checksum != checkpoint_checksum(
+                (uint8_t *)(slot + 1), slot->length)) {
+            ogs_warn("Invalid checkpoint [%d:%d]", index, slot->length);
+            slot->length = 0;
+            continue;
+        }
+
+        if (decode(index, slot + 1, slot->length, data) != OGS_OK) {
+            slot->length = 0;
+            continue;
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+void ogs_checkpoint_cursor_init(
+        ogs_checkpoint_cursor_t *cursor, const void *buf, size_t size)
+{
+    ogs_assert(cursor);
+    ogs_assert(buf);
+
+    cursor->pos = (uint8_t *)buf;
+    cursor->end = cursor->pos + size;
+    cursor->overflow = false;
+}
+
+void ogs_checkpoint_put(
+        ogs_checkpoint_cursor_t *cursor, const void *value, size_t size)
+{
+    ogs_assert(cursor);
+
+    if (cursor->overflow || cursor->end - cursor->pos < size) {
+        cursor->overflow = true;
+        return;
+    }
+
+    memcpy(cursor->pos, value, size);
+    cursor->pos += size;
+}
+
+void ogs_checkpoint_get(
+        ogs_checkpoint_cursor_t *cursor, void *value, size_t size)
+{
+    ogs_assert(cursor);
+
+    if (cursor->overflow || cursor->end - cursor->pos < size) {
+        cursor->overflow = true;
+        memset(value, 0, size);
+        return;
+    }
+
+    memcpy(value, cursor->pos, size);
+    cursor->pos += size;
+}
+
+/* A NULL string is encoded as an empty string */
+void ogs_checkpoint_put_string(
+        ogs_checkpoint_cursor_t *cursor, const char *string)
+{
+    uint8_t length = 0;
+
+    if (string) {
+        if (strlen(string) > UINT8_MAX) {
+            cursor->overflow = true;
+            return;
+        }
+        length = strlen(string);
+    }
+
+    OGS_CHECKPOINT_PUT(cursor, length);
+    if (length)
+        ogs_checkpoint_put(cursor, string, length);
+}
+
+/* Returns NULL for an empty string */
+char *ogs_checkpoint_get_string(ogs_checkpoint_cursor_t *cursor)
+{
+    uint8_t length = 0;
+    char *string = NULL;
+
+    OGS_CHECKPOINT_GET(cursor, length);
+    if (cursor->overflow || length == 0)
+        return NULL;
+
+    if (cursor->end - cursor->pos < length) {
+        cursor->overflow = true;
+        return NULL;
+    }
+
+    string = ogs_strndup((const char *)cursor->pos, length);
+    ogs_assert(string);
+    cursor->pos += length;
+
+    return string;
+}
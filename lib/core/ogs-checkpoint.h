@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_CORE_INSIDE) && !defined(OGS_CORE_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_CHECKPOINT_H
+#define OGS_CHECKPOINT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Checkpoint of the contexts of a pool in a memory-mapped file,
+ * so that a restarted process can rebuild them without the peers.
+ *
+ * The file has a user area and one fixed-size slot per object of the pool.
+ * The slot of an object is selected by its pool index, starting from 1.
+ * ogs_checkpoint_mark() only records the index. The dirty slots are
+ * encoded by ogs_checkpoint_flush(), at most once per flush even if
+ * the object was changed many times. If the object was removed,
+ * the encoder returns 0 and the slot is erased.
+ *
+ * The data of a slot is written before its length and checksum,
+ * so a slot that was being written when the process died is discarded.
+ * The mapping is shared, so the checkpoint survives the crash of the
+ * process without any system call. The file is synchronized to the disk
+ * only if 'sync_interval' is set.
+ *
+ * If the header of an existing file does not match the parameters,
+ * e.g. the pool size has changed, the checkpoint starts empty.
+ */
+typedef int (*ogs_checkpoint_encode_f)(
+        int index, void *buf, size_t size, void *data);
+typedef int (*ogs_checkpoint_decode_f)(
+        int index, const void *buf, size_t length, void *data);
+
+typedef struct ogs_checkpoint_s ogs_checkpoint_t;
+
+ogs_checkpoint_t *ogs_checkpoint_open(const char *path,
+        const char *name, uint32_t version,
+        size_t user_size, size_t slot_size, int num_of_slot);
+void ogs_checkpoint_close(ogs_checkpoint_t *cp);
+
+/* true if the file was left by a previous run */
+bool ogs_checkpoint_restored(ogs_checkpoint_t *cp);
+void *ogs_checkpoint_user(ogs_checkpoint_t *cp);
+
+void ogs_checkpoint_set_sync(ogs_checkpoint_t *cp, ogs_time_t sync_interval);
+
+void ogs_checkpoint_mark(ogs_checkpoint_t *cp, int index);
+int ogs_checkpoint_flush(ogs_checkpoint_t *cp,
+        ogs_checkpoint_encode_f encode, void *data);
+void ogs_checkpoint_sync(ogs_checkpoint_t *cp);
+
+/* Calls 'decode' for every valid slot in the order of the index */
+int ogs_checkpoint_restore(ogs_checkpoint_t *cp,
+        ogs_checkpoint_decode_f decode, void *data);
+
+/*
+ * Cursor for the encoder and the decoder.
+ * The values are copied in host byte order, since the checkpoint
+ * is only read back by the same build on the same host.
+ * An overflow is sticky and checked once at the end.
+ */
+typedef struct ogs_checkpoint_cursor_s {
+    uint8_t *pos, *end;
+    bool overflow;
+} ogs_checkpoint_cursor_t;
+
+void ogs_checkpoint_cursor_init(
+        ogs_checkpoint_cursor_t *cursor, const void *buf, size_t size);
+void ogs_checkpoint_put(
+        ogs_checkpoint_cursor_t *cursor, const void *value, size_t size);
+void ogs_checkpoint_get(
+        ogs_checkpoint_cursor_t *cursor, void *value, size_t size);
+void ogs_checkpoint_put_string(
+        ogs_checkpoint_cursor_t *cursor, const char *string);
+char *ogs_checkpoint_get_string(ogs_checkpoint_cursor_t *cursor);
+
+#define OGS_CHECKPOINT_PUT(__cURSOR, __vALUE) \
+    ogs_checkpoint_put(__cURSOR, &(__vALUE), sizeof(__vALUE))
+#define OGS_CHECKPOINT_GET(__cURSOR, __vALUE) \
+    ogs_checkpoint_get(__cURSOR, &(__vALUE), sizeof(__vALUE))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_CHECKPOINT_H */
@@ -24,6 +24,7 @@ int __ogs_sock_domain;
 int __ogs_event_domain;
 int __ogs_thread_domain;
 int __ogs_tlv_domain;
+int __ogs_metrics_domain;
 
 static ogs_core_context_t self = {
     .log.pool = 8,
@@ -34,11 +35,14 @@ static ogs_core_context_t self = {
     .pkbuf.config_pool = 8,
 
     .tlv.pool = 512,
+
+    .metrics.slot = 4096,
 };
 
 void ogs_core_initialize(void)
 {
     ogs_log_init();
+    ogs_metrics_init();
     ogs_pkbuf_init();
     ogs_socket_init();
     ogs_tlv_init();
@@ -49,6 +53,8 @@ void ogs_core_initialize(void)
     ogs_log_install_domain(&__ogs_thread_domain,
             "thread", ogs_core()->log.level);
     ogs_log_install_domain(&__ogs_tlv_domain, "tlv", ogs_core()->log.level);
+    ogs_log_install_domain(&__ogs_metrics_domain,
+            "metrics", ogs_core()->log.level);
 }
 
 void ogs_core_terminate(void)
@@ -56,6 +62,7 @@ void ogs_core_terminate(void)
     ogs_tlv_final();
     ogs_socket_final();
     ogs_pkbuf_final();
+    ogs_metrics_final();
     ogs_log_final();
 }
 
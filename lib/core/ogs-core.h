@@ -57,6 +57,10 @@
 #include "core/ogs-env.h"
 #include "core/ogs-fsm.h"
 #include "core/ogs-hash.h"
+#include "core/ogs-ihash.h"
+#include "core/ogs-lpm.h"
+#include "core/ogs-metrics.h"
+#include "core/ogs-checkpoint.h"
 #include "core/ogs-misc.h"
 #include "core/ogs-getopt.h"
 #include "core/ogs-3gpp-types.h"
@@ -72,6 +76,7 @@ extern int __ogs_sock_domain;
 extern int __ogs_event_domain;
 extern int __ogs_thread_domain;
 extern int __ogs_tlv_domain;
+extern int __ogs_metrics_domain;
 
 typedef struct {
     struct {
@@ -89,6 +94,10 @@ typedef struct {
         int pool;
     } tlv;
 
+    struct {
+        int slot;
+    } metrics;
+
 } ogs_core_context_t;
 
 void ogs_core_initialize(void);
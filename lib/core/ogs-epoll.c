@@ -126,8 +126,11 @@ static int epoll_add(ogs_poll_t *poll)
         map->write = poll;
 
     ee.events = 0;
-    if (map->read)
+    if (map->read) {
         ee.events |= (EPOLLIN|EPOLLRDHUP);
+        if (map->read->when & OGS_POLLET)
+            ee.events |= EPOLLET;
+    }
     if (map->write)
         ee.events |= EPOLLOUT;
     ee.data.ptr = map;
@@ -165,8 +168,11 @@ static int epoll_remove(ogs_poll_t *poll)
         map->write = NULL;
 
     ee.events = 0;
-    if (map->read)
+    if (map->read) {
         ee.events |= (EPOLLIN|EPOLLRDHUP);
+        if (map->read->when & OGS_POLLET)
+            ee.events |= EPOLLET;
+    }
     if (map->write)
         ee.events |= EPOLLOUT;
 
@@ -194,14 +200,23 @@ static int epoll_remove(ogs_poll_t *poll)
 static int epoll_process(ogs_pollset_t *pollset, ogs_time_t timeout)
 {
     struct epoll_context_s *context = NULL;
-	int num_of_poll;
-	int i;
+    int num_of_poll;
+    int num_of_pending;
+    int i;
 
     ogs_assert(pollset);
     context = pollset->context;
     ogs_assert(context);
 
-	num_of_poll = epoll_wait(context->epfd, context->event_list,
+    /*
+     * Edge-triggered handlers which stopped on their budget have data
+     * left without a new edge. Call them first and do not block.
+     */
+    num_of_pending = ogs_pollset_dispatch_pending(pollset);
+    if (num_of_pending || ogs_list_first(&pollset->pending))
+        timeout = 0;
+
+    num_of_poll = epoll_wait(context->epfd, context->event_list,
             pollset->capacity,
             timeout == OGS_INFINITE_TIME ? OGS_INFINITE_TIME :
                 ogs_time_to_msec(timeout));
@@ -209,18 +224,18 @@ static int epoll_process(ogs_pollset_t *pollset, ogs_time_t timeout)
         ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno, "epoll failed");
         return OGS_ERROR;
     } else if (num_of_poll == 0) {
-        return OGS_TIMEUP;
+        return num_of_pending ? OGS_OK : OGS_TIMEUP;
     }
 
-	for (i = 0; i < num_of_poll; i++) {
+    for (i = 0; i < num_of_poll; i++) {
         struct epoll_map_s *map = NULL;
-		uint32_t received;
+        uint32_t received;
         short when = 0;
 
-		received = context->event_list[i].events;
-		if (received & (EPOLLERR|EPOLLHUP)) {
+        received = context->event_list[i].events;
+        if (received & (EPOLLERR|EPOLLHUP)) {
             when = OGS_POLLIN|OGS_POLLOUT;
-		} else {
+        } else {
             if (received & (EPOLLIN|EPOLLRDHUP)) {
                 when |= OGS_POLLIN;
             }
@@ -236,12 +251,23 @@ static int epoll_process(ogs_pollset_t *pollset, ogs_time_t timeout)
         ogs_assert(map);
 
         if (map->read && map->write && map->read == map->write) {
-            map->read->handler(when, map->read->fd, map->read->data);
+            ogs_pollset_dispatch(map->read, when);
         } else {
-            if (map->read && (when & OGS_POLLIN))
-                map->read->handler(when, map->read->fd, map->read->data);
+            ogs_socket_t fd = INVALID_SOCKET;
+
+            if (map->read && (when & OGS_POLLIN)) {
+                fd = map->read->fd;
+                ogs_pollset_dispatch(map->read, when);
+                if (!(when & OGS_POLLOUT))
+                    continue;
+
+                /* The read handler can remove the polls of the fd */
+                map = ogs_hash_get(context->map_hash, &fd, sizeof(fd));
+                if (!map)
+                    continue;
+            }
             if (map->write && (when & OGS_POLLOUT))
-                map->write->handler(when, map->write->fd, map->write->data);
+                ogs_pollset_dispatch(map->write, when);
         }
     }
     
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2019-2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+
+#define INITIAL_SIZE    16  /* tunable == 2^n */
+
+/* Grow the table when it is 7/8 full */
+#define MAX_LOAD_NUM    7
+#define MAX_LOAD_DEN    8
+
+/* Number of old slots moved into the new array on each update */
+#define MIGRATE_STEP    32
+
+#define KEY_WORDS       (OGS_IHASH_MAX_KEY_LEN / sizeof(uint64_t))
+
+typedef struct ogs_ihash_slot_s {
+    uint32_t        hash;
+    uint32_t        dist;   /* Probe distance + 1 (0 : empty slot) */
+    const void      *val;   /* NULL with dist != 0 : removed from old array */
+    uint64_t        key[KEY_WORDS];
+} ogs_ihash_slot_t;
+
+typedef struct ogs_ihash_array_s {
+    ogs_ihash_slot_t *slot;
+    unsigned int    mask;   /* size - 1 */
+    unsigned int    count;
+} ogs_ihash_array_t;
+
+struct ogs_ihash_s {
+    int             klen;
+    uint64_t        seed;
+    unsigned int    count;
+
+    ogs_ihash_array_t cur;
+
+    /* Array being moved into 'cur'. slot is NULL if no resize is running */
+    ogs_ihash_array_t old;
+    unsigned int    migrate;
+};
+
+static void array_alloc(ogs_ihash_array_t *a, unsigned int size)
+{
+    ogs_assert(a);
+    ogs_assert(size && (size & (size - 1)) == 0);
+
+    a->slot = calloc(size, sizeof(ogs_ihash_slot_t));
+    ogs_assert(a->slot);
+    a->mask = size - 1;
+    a->count = 0;
+}
+
+static void array_free(ogs_ihash_array_t *a)
+{
+    ogs_assert(a);
+
+    free(a->slot);
+    a->slot = NULL;
+    a->mask = 0;
+    a->count = 0;
+}
+
+static uint64_t mix64(uint64_t x)
+{
+    /* splitmix64 finalizer */
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint32_t hash_key(ogs_ihash_t *ht, const uint64_t *key)
+{
+    uint64_t h;
+
+    h = mix64(key[0] ^ ht->seed);
+    if (ht->klen > sizeof(uint64_t))
+        h = mix64(h ^ key[1]);
+
+    return (uint32_t)(h >> 32);
+}
+
+static void make_key(ogs_ihash_t *ht, uint64_t *dst, const void *key)
+{
+    memset(dst, 0, OGS_IHASH_MAX_KEY_LEN);
+    memcpy(dst, key, ht->klen);
+}
+
+static ogs_ihash_slot_t *array_find(
+        ogs_ihash_array_t *a, uint32_t hash, const uint64_t *key)
+{
+    unsigned int i;
+    uint32_t dist;
+
+    i = hash & a->mask;
+    for (dist = 1; ; dist++) {
+        ogs_ihash_slot_t *s = &a->slot[i];
+
+        /*
+         * Robin Hood invariant :
+         * the key would have displaced an entry closer to its home slot.
+         * This also catches the empty slot (dist == 0).
+         */
+        if (s->dist < dist)
+            return NULL;
+
+        if (s->hash == hash && s->val &&
+            s->key[0] == key[0] && s->key[1] == key[1])
+            return s;
+
+        i = (i + 1) & a->mask;
+    }
+
+    /* Unreachable */
+    return NULL;
+}
+
+static void array_insert(ogs_ihash_array_t *a,
+        uint32_t hash, const uint64_t *key, const void *val)
+{
+    ogs_ihash_slot_t entry, tmp;
+    unsigned int i;
+
+    entry.hash = hash;
+    entry.dist = 1;
+    entry.val = val;
+    memcpy(entry.key, key, sizeof(entry.key));
+
+    i = hash & a->mask;
+    for ( ;; ) {
+        ogs_ihash_slot_t *s = &a->slot[i];
+
+        if (s->dist == 0) {
+            *s = entry;
+            a->count++;
+            return;
+        }
+
+        /* Take the slot from an entry that is closer to its home */
+        if (s->dist < entry.dist) {
+            tmp = *s;
+            *s = entry;
+            entry = tmp;
+        }
+
+        i = (i + 1) & a->mask;
+        entry.dist++;
+        ogs_assert(entry.dist <= a->mask + 1);
+    }
+}
+
+static void array_delete(ogs_ihash_array_t *a, ogs_ihash_slot_t *s)
+{
+    unsigned int i, next;
+
+    /* Backward shift : no tombstone is left in the current array */
+    i = s - a->slot;
+    for ( ;; ) {
+        next = (i + 1) & a->mask;
+        if (a->slot[next].dist <= 1) {
+            memset(&a->slot[i], 0, sizeof(a->slot[i]));
+            break;
+        }
+        a->slot[i] = a->slot[next];
+        a->slot[i].dist--;
+        i = next;
+    }
+
+    a->count--;
+}
+
+static void migrate(ogs_ihash_t *ht, unsigned int step)
+{
+    if (!ht->old.slot)
+        return;
+
+    while (step-- && ht->migrate <= ht->old.mask) {
+        ogs_ihash_slot_t *s = &ht->old.slot[ht->migrate++];
+
+        if (s->dist && s->val) {
+            array_insert(&ht->cur, s->hash, s->key, s->val);
+
+            /*
+             * Keep 'dist' so that the probe sequence of the entries
+             * which are not moved yet is not broken.
+             */
+            s->val = NULL;
+        }
+    }
+
+    if (ht->migrate > ht->old.mask)
+        array_free(&ht->old);
+}
+
+static void grow(ogs_ihash_t *ht)
+{
+    /* Finish the previous resize before starting a new one */
+    migrate(ht, ht->old.mask + 1);
+    ogs_assert(ht->old.slot == NULL);
+
+    ht->old = ht->cur;
+    ht->migrate = 0;
+
+    array_alloc(&ht->cur, (ht->old.mask + 1) * 2);
+}
+
+ogs_ihash_t *ogs_ihash_make(int klen)
+{
+    ogs_ihash_t *ht = NULL;
+    ogs_time_t now = ogs_get_monotonic_time();
+
+    ogs_assert(klen > 0 && klen <= OGS_IHASH_MAX_KEY_LEN);
+
+    ht = ogs_calloc(1, sizeof(*ht));
+    ogs_assert(ht);
+
+    ht->klen = klen;
+    ht->seed = mix64((uint64_t)now ^ (uintptr_t)ht);
+
+    array_alloc(&ht->cur, INITIAL_SIZE);
+
+    return ht;
+}
+
+void ogs_ihash_destroy(ogs_ihash_t *ht)
+{
+    ogs_assert(ht);
+
+    array_free(&ht->cur);
+    array_free(&ht->old);
+
+    ogs_free(ht);
+}
+
+void ogs_ihash_set(ogs_ihash_t *ht, const void *key, const void *val)
+{
+    uint64_t k[KEY_WORDS];
+    uint32_t hash;
+    ogs_ihash_slot_t *s = NULL;
+
+    ogs_assert(ht);
+    ogs_assert(key);
+
+    make_key(ht, k, key);
+    hash = hash_key(ht, k);
+
+    migrate(ht, MIGRATE_STEP);
+
+    s = array_find(&ht->cur, hash, k);
+    if (s) {
+        if (val) {
+            s->val = val;
+        } else {
+            array_delete(&ht->cur, s);
+            ht->count--;
+        }
+        return;
+    }
+
+    if (ht->old.slot) {
+        s = array_find(&ht->old, hash, k);
+        if (s) {
+            s->val = NULL;
+            ht->count--;
+        }
+    }
+
+    if (!val)
+        return;
+
+    if ((ht->cur.count + 1) * MAX_LOAD_DEN > (ht->cur.mask + 1) * MAX_LOAD_NUM)
+        grow(ht);
+
+    array_insert(&ht->cur, hash, k, val);
+    ht->count++;
+}
+
+void *ogs_ihash_get(ogs_ihash_t *ht, const void *key)
+{
+    uint64_t k[KEY_WORDS];
+    uint32_t hash;
+    ogs_ihash_slot_t *s = NULL;
+
+    ogs_assert(ht);
+    ogs_assert(key);
+
+    make_key(ht, k, key);
+    hash = hash_key(ht, k);
+
+    s = array_find(&ht->cur, hash, k);
+    if (s)
+        return (void *)s->val;
+
+    if (ht->old.slot) {
+        s = array_find(&ht->old, hash, k);
+        if (s)
+            return (void *)s->val;
+    }
+
+    return NULL;
+}
+
+unsigned int ogs_ihash_count(ogs_ihash_t *ht)
+{
+    ogs_assert(ht);
+    return ht->count;
+}
+
+void ogs_ihash_clear(ogs_ihash_t *ht)
+{
+    ogs_assert(ht);
+
+    array_free(&ht->old);
+    memset(ht->cur.slot, 0, (ht->cur.mask + 1) * sizeof(ogs_ihash_slot_t));
+    ht->cur.count = 0;
+    ht->count = 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2019-2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_CORE_INSIDE) && !defined(OGS_CORE_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_IHASH_H
+#define OGS_IHASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hash table for fixed-size keys such as TEID, SEID and IP address.
+ *
+ * Unlike ogs_hash_t, the key is copied into the table,
+ * so the caller does not need to keep the key memory.
+ *
+ * Entries are stored in a single open-addressing array (Robin Hood probing).
+ * When the table grows, a new array is allocated and the entries are
+ * moved a few at a time on each ogs_ihash_set(), so that no single call
+ * has to rehash the whole table.
+ */
+#define OGS_IHASH_MAX_KEY_LEN   16
+
+typedef struct ogs_ihash_s ogs_ihash_t;
+
+ogs_ihash_t *ogs_ihash_make(int klen);
+void ogs_ihash_destroy(ogs_ihash_t *ht);
+
+/* If val is NULL, the entry is removed */
+void ogs_ihash_set(ogs_ihash_t *ht, const void *key, const void *val);
+void *ogs_ihash_get(ogs_ihash_t *ht, const void *key);
+
+unsigned int ogs_ihash_count(ogs_ihash_t *ht);
+void ogs_ihash_clear(ogs_ihash_t *ht);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OGS_IHASH_H */
@@ -95,6 +95,13 @@ static OGS_LIST(log_list);
 static OGS_POOL(domain_pool, ogs_log_domain_t);
 static OGS_LIST(domain_list);
 
+/*
+ * Until ogs_log_init() is called, every message is passed to
+ * ogs_log_vprintf() and written to stderr as before.
+ */
+static uint8_t default_domain_level[2] = { OGS_LOG_FULL, OGS_LOG_FULL };
+uint8_t *ogs_log_domain_level = default_domain_level;
+
 static ogs_log_t *add_log(ogs_log_type_e type);
 static int file_cycle(ogs_log_t *log);
 
@@ -116,6 +123,12 @@ void ogs_log_init(void)
     ogs_pool_init(&log_pool, ogs_core()->log.pool);
     ogs_pool_init(&domain_pool, ogs_core()->log.domain_pool);
 
+    /* Unknown domains are passed through to report the missing domain */
+    ogs_log_domain_level = malloc(ogs_core()->log.domain_pool + 1);
+    ogs_assert(ogs_log_domain_level);
+    memset(ogs_log_domain_level, OGS_LOG_FULL,
+            ogs_core()->log.domain_pool + 1);
+
     ogs_log_add_domain("core", ogs_core()->log.level);
     ogs_log_add_stderr();
 }
@@ -132,6 +145,9 @@ void ogs_log_final(void)
     ogs_list_for_each_safe(&domain_list, saved_domain, domain)
         ogs_log_remove_domain(domain);
     ogs_pool_final(&domain_pool);
+
+    free(ogs_log_domain_level);
+    ogs_log_domain_level = default_domain_level;
 }
 
 void ogs_log_cycle(void)
@@ -212,6 +228,7 @@ ogs_log_domain_t *ogs_log_add_domain(const char *name, ogs_log_level_e level)
     domain->name = name;
     domain->id = ogs_pool_index(&domain_pool, domain);
     domain->level = level;
+    ogs_log_domain_level[domain->id] = level;
 
     ogs_list_add(&domain_list, domain);
 
@@ -235,6 +252,8 @@ void ogs_log_remove_domain(ogs_log_domain_t *domain)
 {
     ogs_assert(domain);
 
+    ogs_log_domain_level[domain->id] = OGS_LOG_FULL;
+
     ogs_list_remove(&domain_list, domain);
     ogs_pool_free(&domain_pool, domain);
 }
@@ -249,6 +268,7 @@ void ogs_log_set_domain_level(int id, ogs_log_level_e level)
     ogs_assert(domain);
 
     domain->level = level;
+    ogs_log_domain_level[id] = level;
 }
 
 ogs_log_level_e ogs_log_get_domain_level(int id)
@@ -329,14 +349,18 @@ void ogs_log_set_mask_level(const char *_mask, ogs_log_level_e level)
             name = ogs_strtok_r(NULL, delim, &saveptr)) {
 
             domain = ogs_log_find_domain(name);
-            if (domain)
+            if (domain) {
                 domain->level = level;
+                ogs_log_domain_level[domain->id] = level;
+            }
         }
 
         ogs_free(mask);
     } else {
-        ogs_list_for_each(&domain_list, domain)
+        ogs_list_for_each(&domain_list, domain) {
             domain->level = level;
+            ogs_log_domain_level[domain->id] = level;
+        }
     }
 }
 
@@ -388,15 +412,18 @@ void ogs_log_vprintf(ogs_log_level_e level, int id,
 
     int wrote_stderr = 0;
 
-    ogs_list_for_each(&log_list, log) {
-        domain = ogs_pool_find(&domain_pool, id);
-        if (!domain) {
-            fprintf(stderr, "No LogDomain[id:%d] in %s:%d", id, file, line);
-            ogs_assert_if_reached();
-        }
-        if (domain->level < level)
-            return;
+    if (!ogs_list_first(&log_list))
+        goto stderr_only;
 
+    domain = ogs_pool_find(&domain_pool, id);
+    if (!domain) {
+        fprintf(stderr, "No LogDomain[id:%d] in %s:%d", id, file, line);
+        ogs_assert_if_reached();
+    }
+    if (domain->level < level)
+        return;
+
+    ogs_list_for_each(&log_list, log) {
         p = logstr;
         last = logstr + OGS_HUGE_LEN;
 
@@ -432,6 +459,7 @@ void ogs_log_vprintf(ogs_log_level_e level, int id,
             wrote_stderr = 1;
     }
 
+stderr_only:
     if (!wrote_stderr)
     {
         int use_color = 0;
@@ -477,6 +505,9 @@ void ogs_log_hexdump_func(ogs_log_level_e level, int id,
     char dumpstr[OGS_HUGE_LEN];
     char *p, *last;
 
+    if (ogs_log_domain_level[id] < level)
+        return;
+
     last = dumpstr + OGS_HUGE_LEN;
     p = dumpstr;
 
@@ -39,18 +39,41 @@ extern "C" {
 #define ogs_debug(...) ogs_log_message(OGS_LOG_DEBUG, 0, __VA_ARGS__)
 #define ogs_trace(...) ogs_log_message(OGS_LOG_TRACE, 0, __VA_ARGS__)
 
+/*
+ * Messages above OGS_LOG_COMPILE_LEVEL are removed by the compiler.
+ * Otherwise the level is checked against the cached level of the domain
+ * before the call, so that the arguments of a disabled message
+ * are never evaluated.
+ */
+#ifndef OGS_LOG_COMPILE_LEVEL
+#define OGS_LOG_COMPILE_LEVEL OGS_LOG_TRACE
+#endif
+
+#define ogs_log_enabled(level, id) \
+    ((level) <= OGS_LOG_COMPILE_LEVEL && \
+     (level) <= ogs_log_domain_level[id])
+
 #define ogs_log_message(level, err, ...) \
-    ogs_log_printf(level, OGS_LOG_DOMAIN, \
-    err, __FILE__, __LINE__, OGS_FUNC,  \
-    0, __VA_ARGS__) 
+    do { \
+        if (ogs_unlikely(ogs_log_enabled(level, OGS_LOG_DOMAIN))) \
+            ogs_log_printf(level, OGS_LOG_DOMAIN, \
+                err, __FILE__, __LINE__, OGS_FUNC, \
+                0, __VA_ARGS__); \
+    } while(0)
 
 #define ogs_log_print(level, ...) \
-    ogs_log_printf(level, OGS_LOG_DOMAIN, \
-    0, NULL, 0, NULL,  \
-    1, __VA_ARGS__) 
+    do { \
+        if (ogs_unlikely(ogs_log_enabled(level, OGS_LOG_DOMAIN))) \
+            ogs_log_printf(level, OGS_LOG_DOMAIN, \
+                0, NULL, 0, NULL, \
+                1, __VA_ARGS__); \
+    } while(0)
 
 #define ogs_log_hexdump(level, _d, _l) \
-    ogs_log_hexdump_func(level, OGS_LOG_DOMAIN, _d, _l)
+    do { \
+        if (ogs_unlikely(ogs_log_enabled(level, OGS_LOG_DOMAIN))) \
+            ogs_log_hexdump_func(level, OGS_LOG_DOMAIN, _d, _l); \
+    } while(0)
 
 typedef enum {
     OGS_LOG_NONE,
@@ -64,6 +87,12 @@ typedef enum {
     OGS_LOG_FULL = OGS_LOG_TRACE,
 } ogs_log_level_e;
 
+/*
+ * Level of each domain indexed by the domain id.
+ * Updated whenever the level of a domain changes.
+ */
+extern uint8_t *ogs_log_domain_level;
+
 typedef struct ogs_log_s ogs_log_t;
 typedef struct ogs_log_domain_s ogs_log_domain_t;
 
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2019-2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+
+#define OGS_LPM_MAX_PREFIXLEN   (OGS_LPM_MAX_KEY_LEN * 8)
+
+struct ogs_lpm_s {
+    int             klen;
+    int             maxbits;
+    unsigned int    count;
+
+    /* One exact-match table per prefix length */
+    ogs_ihash_t     *table[OGS_LPM_MAX_PREFIXLEN+1];
+
+    /* Prefix lengths in use, longest first */
+    uint8_t         len[OGS_LPM_MAX_PREFIXLEN+1];
+    int             num_of_len;
+};
+
+static void make_key(ogs_lpm_t *lpm,
+        uint8_t *dst, const void *key, uint8_t prefixlen)
+{
+    int bytes = prefixlen >> 3;
+    int bits = prefixlen & 7;
+
+    memcpy(dst, key, lpm->klen);
+
+    /* Clear the host part */
+    if (bits) {
+        dst[bytes] &= 0xff << (8 - bits);
+        bytes++;
+    }
+    if (bytes < lpm->klen)
+        memset(dst + bytes, 0, lpm->klen - bytes);
+}
+
+static void len_add(ogs_lpm_t *lpm, uint8_t prefixlen)
+{
+    int i;
+
+    for (i = lpm->num_of_len; i > 0 && lpm->len[i-1] < prefixlen; i--)
+        lpm->len[i] = lpm->len[i-1];
+    lpm->len[i] = prefixlen;
+    lpm->num_of_len++;
+}
+
+static void len_remove(ogs_lpm_t *lpm, uint8_t prefixlen)
+{
+    int i;
+
+    for (i = 0; i < lpm->num_of_len; i++)
+        if (lpm->len[i] == prefixlen)
+            break;
+    ogs_assert(i < lpm->num_of_len);
+
+    for (lpm->num_of_len--; i < lpm->num_of_len; i++)
+        lpm->len[i] = lpm->len[i+1];
+}
+
+ogs_lpm_t *ogs_lpm_make(int klen)
+{
+    ogs_lpm_t *lpm = NULL;
+
+    ogs_assert(klen > 0 && klen <= OGS_LPM_MAX_KEY_LEN);
+
+    lpm = ogs_calloc(1, sizeof(*lpm));
+    ogs_assert(lpm);
+
+    lpm->klen = klen;
+    lpm->maxbits = klen * 8;
+
+    return lpm;
+}
+
+void ogs_lpm_destroy(ogs_lpm_t *lpm)
+{
+    ogs_assert(lpm);
+
+    ogs_lpm_clear(lpm);
+    ogs_free(lpm);
+}
+
+void ogs_lpm_set(ogs_lpm_t *lpm,
+        const void *key, uint8_t prefixlen, const void *val)
+{
+    uint8_t k[OGS_LPM_MAX_KEY_LEN];
+    ogs_ihash_t *table = NULL;
+    unsigned int count;
+
+    ogs_assert(lpm);
+    ogs_assert(key);
+    ogs_assert(prefixlen <= lpm->maxbits);
+
+    make_key(lpm, k, key, prefixlen);
+
+    table = lpm->table[prefixlen];
+    if (!table) {
+        if (!val)
+            return;
+
+        table = lpm->table[prefixlen] = ogs_ihash_make(lpm->klen);
+        len_add(lpm, prefixlen);
+    }
+
+    count = ogs_ihash_count(table);
+    ogs_ihash_set(table, k, val);
+    lpm->count += ogs_ihash_count(table);
+    lpm->count -= count;
+
+    if (ogs_ihash_count(table) == 0) {
+        ogs_ihash_destroy(table);
+        lpm->table[prefixlen] = NULL;
+        len_remove(lpm, prefixlen);
+    }
+}
+
+void *ogs_lpm_get(ogs_lpm_t *lpm, const void *key, uint8_t prefixlen)
+{
+    uint8_t k[OGS_LPM_MAX_KEY_LEN];
+
+    ogs_assert(lpm);
+    ogs_assert(key);
+    ogs_assert(prefixlen <= lpm->maxbits);
+
+    if (!lpm->table[prefixlen])
+        return NULL;
+
+    make_key(lpm, k, key, prefixlen);
+    return ogs_ihash_get(lpm->table[prefixlen], k);
+}
+
+void *ogs_lpm_lookup(ogs_lpm_t *lpm, const void *addr)
+{
+    uint8_t k[OGS_LPM_MAX_KEY_LEN];
+    void *val = NULL;
+    int i;
+
+    ogs_assert(lpm);
+    ogs_assert(addr);
+
+    for (i = 0; i < lpm->num_of_len; i++) {
+        make_key(lpm, k, addr, lpm->len[i]);
+        val = ogs_ihash_get(lpm->table[lpm->len[i]], k);
+        if (val)
+            return val;
+    }
+
+    return NULL;
+}
+
+unsigned int ogs_lpm_count(ogs_lpm_t *lpm)
+{
+    ogs_assert(lpm);
+    return lpm->count;
+}
+
+void ogs_lpm_clear(ogs_lpm_t *lpm)
+{
+    int i;
+
+    ogs_assert(lpm);
+
+    for (i = 0; i < lpm->num_of_len; i++) {
+        ogs_ihash_destroy(lpm->table[lpm->len[i]]);
+        lpm->table[lpm->len[i]] = NULL;
+    }
+    lpm->num_of_len = 0;
+    lpm->count = 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2019-2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_CORE_INSIDE) && !defined(OGS_CORE_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_LPM_H
+#define OGS_LPM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Longest prefix match table for IPv4/IPv6 routes.
+ *
+ * The key is an address in network byte order and the prefix length
+ * in bits. Each prefix length in use has its own ogs_ihash_t, so a lookup
+ * costs one hash probe per distinct prefix length, longest first.
+ * UE addresses, delegated prefixes and framed routes usually use only
+ * a handful of lengths.
+ */
+#define OGS_LPM_MAX_KEY_LEN     16
+
+typedef struct ogs_lpm_s ogs_lpm_t;
+
+ogs_lpm_t *ogs_lpm_make(int klen);
+void ogs_lpm_destroy(ogs_lpm_t *lpm);
+
+/* If val is NULL, the prefix is removed */
+void ogs_lpm_set(ogs_lpm_t *lpm,
+        const void *key, uint8_t prefixlen, const void *val);
+/* Exact match of the prefix */
+void *ogs_lpm_get(ogs_lpm_t *lpm, const void *key, uint8_t prefixlen);
+/* Longest prefix which contains the address */
+void *ogs_lpm_lookup(ogs_lpm_t *lpm, const void *addr);
+
+unsigned int ogs_lpm_count(ogs_lpm_t *lpm);
+void ogs_lpm_clear(ogs_lpm_t *lpm);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OGS_LPM_H */
@@ -101,3 +101,26 @@ void *ogs_realloc_debug(void *ptr, size_t size, const char *file_line)
         return ptr;
     }
 }
+
+void *ogs_pkbuf_to_mem(ogs_pkbuf_t *pkbuf)
+{
+    size_t headroom = 0;
+    void *ptr = NULL;
+
+    ogs_assert(pkbuf);
+
+    /* The headroom of a cluster shared by a copy cannot be taken */
+    headroom = sizeof(ogs_pkbuf_t *);
+    if (ogs_pkbuf_headroom(pkbuf) < headroom || pkbuf->cluster->ref != 1) {
+        ptr = ogs_malloc(pkbuf->len);
+        ogs_assert(ptr);
+        memcpy(ptr, pkbuf->data, pkbuf->len);
+
+        ogs_pkbuf_free(pkbuf);
+        return ptr;
+    }
+
+    memcpy(pkbuf->data - headroom, &pkbuf, headroom);
+
+    return pkbuf->data;
+}
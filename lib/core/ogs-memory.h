@@ -52,6 +52,15 @@ void *ogs_calloc_debug(size_t nmemb, size_t size, const char *file_line);
 #define ogs_realloc(ptr, size) ogs_realloc_debug(ptr, size, OGS_FILE_LINE)
 void *ogs_realloc_debug(void *ptr, size_t size, const char *file_line);
 
+/*
+ * Hands the data of 'pkbuf' over as memory released by ogs_free(),
+ * e.g. to place an encoded message into an ASN.1 OCTET STRING.
+ * The data is not copied if the headroom can hold the back pointer
+ * and the buffer is not shared by ogs_pkbuf_copy().
+ * The memory must not be passed to ogs_realloc().
+ */
+void *ogs_pkbuf_to_mem(ogs_pkbuf_t *pkbuf);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,653 @@
+/*
+ * Copyright (C) 2019-2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "core-config-private.h"
+
+#if HAVE_STDARG_H
+#include <stdarg.h>
+#endif
+
+#include "ogs-core.h"
+
+#undef OGS_LOG_DOMAIN
+#define OGS_LOG_DOMAIN __ogs_metrics_domain
+
+OGS_THREAD_LOCAL uint64_t *ogs_metrics_local = NULL;
+OGS_THREAD_LOCAL bool ogs_metrics_shared = false;
+
+static struct {
+    ogs_thread_mutex_t mutex;
+    ogs_list_t list;
+
+    unsigned int size;          /* Number of slots in a shard */
+    unsigned int used;
+
+    unsigned int next;
+    uint64_t *shard[OGS_METRICS_MAX_SHARD];
+} self;
+
+void ogs_metrics_init(void)
+{
+    memset(&self, 0, sizeof(self));
+
+    ogs_thread_mutex_init(&self.mutex);
+    ogs_list_init(&self.list);
+
+    self.size = ogs_core()->metrics.slot;
+    ogs_assert(self.size);
+}
+
+void ogs_metrics_final(void)
+{
+    ogs_metrics_t *metrics = NULL, *next_metrics = NULL;
+    int i;
+
+    ogs_list_for_each_safe(&self.list, next_metrics, metrics)
+        ogs_metrics_remove(metrics);
+
+    for (i = 0; i < OGS_METRICS_MAX_SHARD; i++)
+        if (self.shard[i])
+            free(self.shard[i]);
+
+    /* Only the calling thread can forget its shard */
+    ogs_metrics_local = NULL;
+    ogs_metrics_shared = false;
+
+    ogs_thread_mutex_destroy(&self.mutex);
+}
+
+uint64_t *ogs_metrics_shard_attach(void)
+{
+    unsigned int i;
+    uint64_t *shard = NULL;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    i = self.next;
+    if (i < OGS_METRICS_MAX_SHARD - 1)
+        self.next++;
+    else
+        ogs_metrics_shared = true;
+
+    shard = self.shard[i];
+    if (!shard) {
+        shard = calloc(self.size, sizeof(uint64_t));
+        ogs_assert(shard);
+        __atomic_store_n(&self.shard[i], shard, __ATOMIC_RELEASE);
+    }
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    ogs_metrics_local = shard;
+
+    return shard;
+}
+
+static ogs_metrics_t *metrics_add(ogs_metrics_type_e type,
+        const char *name, const char *help, const char *labels,
+        unsigned int nslot)
+{
+    ogs_metrics_t *metrics = NULL, *iter = NULL, *last = NULL;
+
+    ogs_assert(name);
+    ogs_assert(help);
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    if (self.used + nslot > self.size) {
+        ogs_thread_mutex_unlock(&self.mutex);
+        ogs_error("No metrics slot for `%s` [%d/%d]",
+                name, self.used, self.size);
+        return NULL;
+    }
+
+    metrics = calloc(1, sizeof *metrics);
+    ogs_assert(metrics);
+
+    metrics->type = type;
+    metrics->name = strdup(name);
+    ogs_assert(metrics->name);
+    metrics->help = strdup(help);
+    ogs_assert(metrics->help);
+    if (labels) {
+        metrics->labels = strdup(labels);
+        ogs_assert(metrics->labels);
+    }
+
+    metrics->slot = self.used;
+    metrics->nslot = nslot;
+    metrics->vector.dimension = 1;
+    self.used += nslot;
+
+    /* Keep a family together so that HELP and TYPE are written once */
+    ogs_list_for_each(&self.list, iter) {
+        if (!strcmp(iter->name, name)) {
+            ogs_assert(iter->type == type);
+            last = iter;
+        }
+    }
+    if (last)
+        ogs_list_insert_next(&self.list, last, metrics);
+    else
+        ogs_list_add(&self.list, metrics);
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    return metrics;
+}
+
+ogs_metrics_t *ogs_metrics_add(ogs_metrics_type_e type,
+        const char *name, const char *help, const char *labels)
+{
+    ogs_assert(type != OGS_METRICS_HISTOGRAM);
+    return metrics_add(type, name, help, labels, 1);
+}
+
+ogs_metrics_t *ogs_metrics_add_vector(ogs_metrics_type_e type,
+        const char *name, const char *help, const char *labels,
+        const char *vname, int dimension, ogs_metrics_label_f vlabel)
+{
+    ogs_metrics_t *metrics = NULL;
+
+    ogs_assert(type != OGS_METRICS_HISTOGRAM);
+    ogs_assert(vname);
+    ogs_assert(dimension > 0);
+
+    metrics = metrics_add(type, name, help, labels, dimension);
+    if (!metrics)
+        return NULL;
+
+    metrics->vector.name = strdup(vname);
+    ogs_assert(metrics->vector.name);
+    metrics->vector.dimension = dimension;
+    metrics->vector.value = vlabel;
+
+    return metrics;
+}
+
+ogs_metrics_t *ogs_metrics_add_histogram(
+        const char *name, const char *help, const char *labels,
+        const int64_t *bucket, int nbucket)
+{
+    ogs_metrics_t *metrics = NULL;
+    int i;
+
+    ogs_assert(bucket);
+    ogs_assert(nbucket > 0 && nbucket <= OGS_METRICS_MAX_BUCKET);
+    for (i = 1; i < nbucket; i++)
+        ogs_assert(bucket[i-1] < bucket[i]);
+
+    /* Each bucket, '+Inf' and the sum */
+    metrics = metrics_add(OGS_METRICS_HISTOGRAM,
+            name, help, labels, nbucket + 2);
+    if (!metrics)
+        return NULL;
+
+    metrics->nbucket = nbucket;
+    memcpy(metrics->bucket, bucket, nbucket * sizeof(bucket[0]));
+
+    return metrics;
+}
+
+ogs_metrics_t *ogs_metrics_add_collector(
+        const char *name, const char *help, const char *labels,
+        ogs_metrics_collect_f collect, void *data)
+{
+    ogs_metrics_t *metrics = NULL;
+
+    ogs_assert(collect);
+
+    metrics = metrics_add(OGS_METRICS_GAUGE, name, help, labels, 0);
+    if (!metrics)
+        return NULL;
+
+    metrics->collect = collect;
+    metrics->data = data;
+
+    return metrics;
+}
+
+/* The layout of OGS_POOL() does not depend on the object type */
+typedef OGS_POOL(ogs_metrics_pool_t, void);
+
+static int64_t pool_used(void *data)
+{
+    ogs_metrics_pool_t *pool = data;
+    return ogs_pool_used(pool);
+}
+
+ogs_metrics_t *ogs_metrics_add_pool_used(void *pool, const char *name)
+{
+    char labels[256];
+
+    ogs_assert(pool);
+    ogs_assert(name);
+
+    ogs_snprintf(labels, sizeof(labels), "pool=\"%s\"", name);
+    return ogs_metrics_add_collector("pool_used",
+            "Objects in use in a memory pool", labels, pool_used, pool);
+}
+
+void ogs_metrics_remove(ogs_metrics_t *metrics)
+{
+    ogs_assert(metrics);
+
+    /*
+     * The slots are not reused. A metric is removed only when
+     * its library is finalized.
+     */
+    ogs_thread_mutex_lock(&self.mutex);
+    ogs_list_remove(&self.list, metrics);
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    free(metrics->name);
+    free(metrics->help);
+    if (metrics->labels)
+        free(metrics->labels);
+    if (metrics->vector.name)
+        free(metrics->vector.name);
+    free(metrics);
+}
+
+static int64_t slot_value(unsigned int slot)
+{
+    uint64_t value = 0, *shard = NULL;
+    int i;
+
+    for (i = 0; i < OGS_METRICS_MAX_SHARD; i++) {
+        shard = __atomic_load_n(&self.shard[i], __ATOMIC_ACQUIRE);
+        if (shard)
+            value += __atomic_load_n(&shard[slot], __ATOMIC_RELAXED);
+    }
+
+    return (int64_t)value;
+}
+
+int64_t ogs_metrics_value(ogs_metrics_t *metrics, int index)
+{
+    ogs_assert(metrics);
+
+    if (metrics->collect)
+        return metrics->collect(metrics->data);
+
+    ogs_assert(index >= 0 && index < metrics->nslot);
+    return slot_value(metrics->slot + index);
+}
+
+typedef struct metrics_buf_s {
+    char *data;
+    size_t len;
+    size_t size;
+} metrics_buf_t;
+
+static void buf_printf(metrics_buf_t *buf, const char *fmt, ...)
+    OGS_GNUC_PRINTF(2, 3);
+
+static void buf_printf(metrics_buf_t *buf, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    while (1) {
+        va_start(ap, fmt);
+        n = ogs_vsnprintf(buf->data + buf->len, buf->size - buf->len, fmt, ap);
+        va_end(ap);
+        ogs_assert(n >= 0);
+
+        if (buf->len + n < buf->size)
+            break;
+
+        buf->size *= 2;
+        buf->data = realloc(buf->data, buf->size);
+        ogs_assert(buf->data);
+    }
+
+    buf->len += n;
+}
+
+static void print_sample(metrics_buf_t *buf, ogs_metrics_t *metrics,
+        const char *suffix, const char *extra, int64_t value)
+{
+    buf_printf(buf, "%s%s", metrics->name, suffix);
+    if (metrics->labels || extra) {
+        buf_printf(buf, "{%s%s%s}",
+                metrics->labels ? metrics->labels : "",
+                metrics->labels && extra ? "," : "",
+                extra ? extra : "");
+    }
+    buf_printf(buf, " %lld\n", (long long)value);
+}
+
+static void print_metrics(metrics_buf_t *buf, ogs_metrics_t *metrics)
+{
+    char extra[256];
+    int64_t value, count;
+    int i;
+
+    if (metrics->collect) {
+        print_sample(buf, metrics, "", NULL,
+                metrics->collect(metrics->data));
+
+    } else if (metrics->type == OGS_METRICS_HISTOGRAM) {
+        count = 0;
+        for (i = 0; i <= metrics->nbucket; i++) {
+            count += slot_value(metrics->slot + i);
+            if (i < metrics->nbucket)
+                ogs_snprintf(extra, sizeof(extra),
+                        "le=\"%lld\"", (long long)metrics->bucket[i]);
+            else
+                ogs_snprintf(extra, sizeof(extra), "le=\"+Inf\"");
+            print_sample(buf, metrics, "_bucket", extra, count);
+        }
+        print_sample(buf, metrics, "_sum", NULL,
+                slot_value(metrics->slot + metrics->nbucket + 1));
+        print_sample(buf, metrics, "_count", NULL, count);
+
+    } else if (metrics->vector.name) {
+        for (i = 0; i < metrics->vector.dimension; i++) {
+            value = slot_value(metrics->slot + i);
+            if (!value)
+                continue;
+
+            if (metrics->vector.value)
+                ogs_snprintf(extra, sizeof(extra), "%s=\"%s\"",
+                        metrics->vector.name, metrics->vector.value(i));
+            else
+                ogs_snprintf(extra, sizeof(extra), "%s=\"%d\"",
+                        metrics->vector.name, i);
+            print_sample(buf, metrics, "", extra, value);
+        }
+
+    } else {
+        print_sample(buf, metrics, "", NULL, slot_value(metrics->slot));
+    }
+}
+
+char *ogs_metrics_export(size_t *len)
+{
+    metrics_buf_t buf;
+    ogs_metrics_t *metrics = NULL;
+    const char *family = NULL;
+
+    buf.len = 0;
+    buf.size = OGS_HUGE_LEN;
+    buf.data = malloc(buf.size);
+    ogs_assert(buf.data);
+    buf.data[0] = 0;
+
+    ogs_thread_mutex_lock(&self.mutex);
+
+    ogs_list_for_each(&self.list, metrics) {
+        if (!family || strcmp(family, metrics->name)) {
+            family = metrics->name;
+            buf_printf(&buf, "# HELP %s %s\n", metrics->name, metrics->help);
+            buf_printf(&buf, "# TYPE %s %s\n", metrics->name,
+                    metrics->type == OGS_METRICS_COUNTER ? "counter" :
+                    metrics->type == OGS_METRICS_GAUGE ? "gauge" :
+                    "histogram");
+        }
+        print_metrics(&buf, metrics);
+    }
+
+    ogs_thread_mutex_unlock(&self.mutex);
+
+    if (len)
+        *len = buf.len;
+
+    return buf.data;
+}
+
+/*
+ * A minimal HTTP/1.0 responder. Each connection reads one request,
+ * writes the metrics and is closed, all from the caller's pollset.
+ * A connection which is not done within METRICS_CONNECTION_TIMEOUT
+ * is closed so that idle clients cannot hold all the slots.
+ */
+#define MAX_METRICS_CONNECTION          16
+#define MAX_METRICS_REQUEST             1024
+#define METRICS_CONNECTION_TIMEOUT      ogs_time_from_sec(5)
+
+struct ogs_metrics_server_s {
+    ogs_pollset_t *pollset;
+    ogs_timer_mgr_t *timer_mgr;
+    ogs_socknode_t *node;
+    ogs_poll_t *poll;
+
+    ogs_list_t conn_list;
+    int nconn;
+};
+
+typedef struct metrics_conn_s {
+    ogs_lnode_t lnode;
+
+    ogs_metrics_server_t *server;
+    ogs_sock_t *sock;
+    ogs_poll_t *poll;
+    ogs_timer_t *timer;
+
+    char request[MAX_METRICS_REQUEST];
+    size_t rlen;
+
+    char *response;
+    size_t len;
+    size_t sent;
+} metrics_conn_t;
+
+static void conn_close(metrics_conn_t *conn)
+{
+    ogs_metrics_server_t *server = NULL;
+
+    ogs_assert(conn);
+    server = conn->server;
+    ogs_assert(server);
+
+    ogs_list_remove(&server->conn_list, conn);
+    server->nconn--;
+
+    if (conn->poll)
+        ogs_pollset_remove(conn->poll);
+    ogs_timer_delete(conn->timer);
+    ogs_sock_destroy(conn->sock);
+    if (conn->response)
+        free(conn->response);
+    free(conn);
+}
+
+static void conn_timeout(void *data)
+{
+    metrics_conn_t *conn = data;
+
+    ogs_assert(conn);
+
+    ogs_warn("metrics: connection timed out");
+    conn_close(conn);
+}
+
+static void conn_send(short when, ogs_socket_t fd, void *data)
+{
+    metrics_conn_t *conn = data;
+    ssize_t sent;
+
+    ogs_assert(conn);
+
+    sent = ogs_send(fd, conn->response + conn->sent,
+            conn->len - conn->sent, 0);
+    if (sent < 0) {
+        if (ogs_socket_errno == OGS_EAGAIN)
+            return;
+        ogs_log_message(OGS_LOG_WARN, ogs_socket_errno,
+                "metrics: send() failed");
+        conn_close(conn);
+        return;
+    }
+
+    conn->sent += sent;
+    if (conn->sent == conn->len)
+        conn_close(conn);
+}
+
+static void conn_respond(metrics_conn_t *conn)
+{
+    char *body = NULL;
+    size_t len = 0;
+    char header[OGS_HUGE_LEN];
+    int n;
+
+    ogs_assert(conn);
+
+    if (!strncmp(conn->request, "GET /metrics ", 13) ||
+        !strncmp(conn->request, "GET / ", 6)) {
+        body = ogs_metrics_export(&len);
+        n = ogs_snprintf(header, sizeof(header),
+                "HTTP/1.0 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                "Content-Length: %d\r\n"
+                "Connection: close\r\n\r\n", (int)len);
+    } else {
+        n = ogs_snprintf(header, sizeof(header),
+                "HTTP/1.0 404 Not Found\r\n"
+                "Content-Length: 0\r\n"
+                "Connection: close\r\n\r\n");
+    }
+
+    conn->len = n + len;
+    conn->response = malloc(conn->len);
+    ogs_assert(conn->response);
+    memcpy(conn->response, header, n);
+    if (body) {
+        memcpy(conn->response + n, body, len);
+        free(body);
+    }
+
+    ogs_pollset_remove(conn->poll);
+    conn->poll = ogs_pollset_add(conn->server->pollset,
+            OGS_POLLOUT, conn->sock->fd, conn_send, conn);
+    ogs_assert(conn->poll);
+}
+
+static void conn_recv(short when, ogs_socket_t fd, void *data)
+{
+    metrics_conn_t *conn = data;
+    ssize_t size;
+
+    ogs_assert(conn);
+
+    size = ogs_recv(fd, conn->request + conn->rlen,
+            sizeof(conn->request) - conn->rlen - 1, 0);
+    if (size <= 0) {
+        if (size < 0 && ogs_socket_errno == OGS_EAGAIN)
+            return;
+        conn_close(conn);
+        return;
+    }
+
+    conn->rlen += size;
+    conn->request[conn->rlen] = 0;
+
+    if (strstr(conn->request, "\r\n\r\n") || strstr(conn->request, "\n\n"))
+        conn_respond(conn);
+    else if (conn->rlen == sizeof(conn->request) - 1)
+        conn_close(conn);
+}
+
+static void server_accept(short when, ogs_socket_t fd, void *data)
+{
+    ogs_metrics_server_t *server = data;
+    metrics_conn_t *conn = NULL;
+    ogs_sock_t *sock = NULL;
+
+    ogs_assert(server);
+
+    sock = ogs_sock_accept(server->node->sock);
+    if (!sock) {
+        ogs_log_message(OGS_LOG_WARN, ogs_socket_errno,
+                "metrics: accept() failed");
+        return;
+    }
+
+    if (server->nconn >= MAX_METRICS_CONNECTION) {
+        ogs_warn("metrics: too many connections [%d]", server->nconn);
+        ogs_sock_destroy(sock);
+        return;
+    }
+
+    ogs_assert(ogs_nonblocking(sock->fd) == OGS_OK);
+
+    conn = calloc(1, sizeof *conn);
+    ogs_assert(conn);
+    conn->server = server;
+    conn->sock = sock;
+    conn->poll = ogs_pollset_add(server->pollset,
+            OGS_POLLIN, sock->fd, conn_recv, conn);
+    ogs_assert(conn->poll);
+    conn->timer = ogs_timer_add(server->timer_mgr, conn_timeout, conn);
+    ogs_assert(conn->timer);
+    ogs_timer_start(conn->timer, METRICS_CONNECTION_TIMEOUT);
+
+    ogs_list_add(&server->conn_list, conn);
+    server->nconn++;
+}
+
+ogs_metrics_server_t *ogs_metrics_server_open(ogs_pollset_t *pollset,
+        ogs_timer_mgr_t *timer_mgr, ogs_socknode_t *node)
+{
+    ogs_metrics_server_t *server = NULL;
+    ogs_sock_t *sock = NULL;
+    char buf[OGS_ADDRSTRLEN];
+
+    ogs_assert(pollset);
+    ogs_assert(timer_mgr);
+    ogs_assert(node);
+
+    sock = ogs_tcp_server(node);
+    if (!sock)
+        return NULL;
+
+    ogs_assert(ogs_nonblocking(sock->fd) == OGS_OK);
+
+    server = calloc(1, sizeof *server);
+    ogs_assert(server);
+    server->pollset = pollset;
+    server->timer_mgr = timer_mgr;
+    server->node = node;
+    ogs_list_init(&server->conn_list);
+
+    server->poll = ogs_pollset_add(pollset,
+            OGS_POLLIN, sock->fd, server_accept, server);
+    ogs_assert(server->poll);
+
+    ogs_info("metrics_server() [http://%s]:%d/metrics",
+            OGS_ADDR(node->addr, buf), OGS_PORT(node->addr));
+
+    return server;
+}
+
+void ogs_metrics_server_close(ogs_metrics_server_t *server)
+{
+    metrics_conn_t *conn = NULL, *next_conn = NULL;
+
+    ogs_assert(server);
+
+    ogs_list_for_each_safe(&server->conn_list, next_conn, conn)
+        conn_close(conn);
+
+    ogs_pollset_remove(server->poll);
+    ogs_sock_destroy(server->node->sock);
+    server->node->sock = NULL;
+    free(server);
+}
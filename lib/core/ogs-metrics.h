@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019-2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_CORE_INSIDE) && !defined(OGS_CORE_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_METRICS_H
+#define OGS_METRICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Runtime metrics in the Prometheus text exposition format.
+ *
+ * Every thread that updates a metric owns a shard, a flat array of
+ * 64-bit slots. A metric is a range of slots at the same offset in every
+ * shard, so an update is a plain add to memory that no other thread
+ * writes. The shards are only summed when the metrics are exported.
+ * Threads beyond OGS_METRICS_MAX_SHARD share the last shard and fall
+ * back to an atomic add.
+ *
+ * A vector metric has 'dimension' slots selected by an index such as
+ * the message type. Only the non-zero entries of a vector are exported.
+ *
+ * An update of a NULL metric is ignored, so a library can be used
+ * without registering its metrics.
+ *
+ * The registry and the shards use the system allocator since
+ * ogs_malloc() itself is built on the packet buffer pools.
+ */
+#define OGS_METRICS_MAX_SHARD           32
+#define OGS_METRICS_MAX_BUCKET          16
+
+#if defined(_MSC_VER)
+#define OGS_THREAD_LOCAL __declspec(thread)
+#else
+#define OGS_THREAD_LOCAL __thread
+#endif
+
+typedef enum {
+    OGS_METRICS_COUNTER,
+    OGS_METRICS_GAUGE,
+    OGS_METRICS_HISTOGRAM,
+} ogs_metrics_type_e;
+
+typedef int64_t (*ogs_metrics_collect_f)(void *data);
+typedef const char *(*ogs_metrics_label_f)(int index);
+
+typedef struct ogs_metrics_s {
+    ogs_lnode_t lnode;
+
+    ogs_metrics_type_e type;
+    char *name;
+    char *help;
+    char *labels;               /* e.g. 'pool="ue"', or NULL */
+
+    unsigned int slot;          /* Offset in each shard */
+    unsigned int nslot;
+
+    struct {
+        char *name;
+        int dimension;
+        ogs_metrics_label_f value;  /* NULL: the index itself */
+    } vector;
+
+    int nbucket;
+    int64_t bucket[OGS_METRICS_MAX_BUCKET];
+
+    ogs_metrics_collect_f collect;
+    void *data;
+} ogs_metrics_t;
+
+void ogs_metrics_init(void);
+void ogs_metrics_final(void);
+
+ogs_metrics_t *ogs_metrics_add(ogs_metrics_type_e type,
+        const char *name, const char *help, const char *labels);
+/* Counter with one slot per index, exported with the label 'vname' */
+ogs_metrics_t *ogs_metrics_add_vector(ogs_metrics_type_e type,
+        const char *name, const char *help, const char *labels,
+        const char *vname, int dimension, ogs_metrics_label_f vlabel);
+/* Cumulative histogram with upper bounds in ascending order */
+ogs_metrics_t *ogs_metrics_add_histogram(
+        const char *name, const char *help, const char *labels,
+        const int64_t *bucket, int nbucket);
+/* Gauge which is read from 'collect' when the metrics are exported */
+ogs_metrics_t *ogs_metrics_add_collector(
+        const char *name, const char *help, const char *labels,
+        ogs_metrics_collect_f collect, void *data);
+/* Gauge 'pool_used' of an OGS_POOL() with the label pool="<name>" */
+#define ogs_metrics_add_pool(pool, name) \
+    ogs_metrics_add_pool_used((void *)(pool), name)
+ogs_metrics_t *ogs_metrics_add_pool_used(void *pool, const char *name);
+void ogs_metrics_remove(ogs_metrics_t *metrics);
+
+/* Sum over all shards */
+int64_t ogs_metrics_value(ogs_metrics_t *metrics, int index);
+
+/* Text exposition. The caller frees the buffer with free() */
+char *ogs_metrics_export(size_t *len);
+
+extern OGS_THREAD_LOCAL uint64_t *ogs_metrics_local;
+extern OGS_THREAD_LOCAL bool ogs_metrics_shared;
+uint64_t *ogs_metrics_shard_attach(void);
+
+static ogs_inline uint64_t *ogs_metrics_shard(void)
+{
+    if (ogs_unlikely(!ogs_metrics_local))
+        return ogs_metrics_shard_attach();
+    return ogs_metrics_local;
+}
+
+static ogs_inline void ogs_metrics_slot_add(unsigned int slot, int64_t n)
+{
+    uint64_t *shard = ogs_metrics_shard();
+
+    /* The exporter may read the slot at any time, but never writes it */
+    if (ogs_likely(!ogs_metrics_shared))
+        __atomic_store_n(&shard[slot],
+                __atomic_load_n(&shard[slot], __ATOMIC_RELAXED) + n,
+                __ATOMIC_RELAXED);
+    else
+        __atomic_fetch_add(&shard[slot], (uint64_t)n, __ATOMIC_RELAXED);
+}
+
+static ogs_inline void ogs_metrics_add_n(
+        ogs_metrics_t *metrics, int index, int64_t n)
+{
+    if (metrics && index >= 0 && index < metrics->vector.dimension)
+        ogs_metrics_slot_add(metrics->slot + index, n);
+}
+
+#define ogs_metrics_inc(metrics) ogs_metrics_add_n(metrics, 0, 1)
+#define ogs_metrics_dec(metrics) ogs_metrics_add_n(metrics, 0, -1)
+#define ogs_metrics_add_value(metrics, n) ogs_metrics_add_n(metrics, 0, n)
+#define ogs_metrics_vector_inc(metrics, index) \
+    ogs_metrics_add_n(metrics, index, 1)
+
+static ogs_inline void ogs_metrics_observe(
+        ogs_metrics_t *metrics, int64_t value)
+{
+    int i;
+
+    if (!metrics)
+        return;
+
+    for (i = 0; i < metrics->nbucket; i++)
+        if (value <= metrics->bucket[i])
+            break;
+
+    /* Buckets are followed by '+Inf' and the sum */
+    ogs_metrics_slot_add(metrics->slot + i, 1);
+    ogs_metrics_slot_add(metrics->slot + metrics->nbucket + 1, value);
+}
+
+/*
+ * Export the metrics on http://addr/metrics from the given pollset.
+ * The timers of the connections run on the given timer manager.
+ */
+typedef struct ogs_metrics_server_s ogs_metrics_server_t;
+
+ogs_metrics_server_t *ogs_metrics_server_open(ogs_pollset_t *pollset,
+        ogs_timer_mgr_t *timer_mgr, ogs_socknode_t *node);
+void ogs_metrics_server_close(ogs_metrics_server_t *server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_METRICS_H */
@@ -64,6 +64,9 @@ typedef struct ogs_pkbuf_pool_s {
 static OGS_POOL(pkbuf_pool, ogs_pkbuf_pool_t);
 static ogs_pkbuf_pool_t *default_pool = NULL;
 
+static ogs_metrics_t *alloc_failures = NULL;
+static ogs_metrics_t *default_pool_used[7];
+
 static ogs_cluster_t *cluster_alloc(
         ogs_pkbuf_pool_t *pool, unsigned int size);
 static void cluster_free(ogs_pkbuf_pool_t *pool, ogs_cluster_t *cluster);
@@ -80,10 +83,19 @@ void *ogs_pkbuf_put_data(
 void ogs_pkbuf_init(void)
 {
     ogs_pool_init(&pkbuf_pool, ogs_core()->pkbuf.pool);
+
+    alloc_failures = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "pkbuf_alloc_failures_total",
+            "Packet buffers not allocated because a cluster pool was empty",
+            NULL);
 }
 
 void ogs_pkbuf_final(void)
 {
+    if (alloc_failures)
+        ogs_metrics_remove(alloc_failures);
+    alloc_failures = NULL;
+
     ogs_pool_final(&pkbuf_pool);
 }
 
@@ -101,13 +113,54 @@ void ogs_pkbuf_default_init(ogs_pkbuf_config_t *config)
     config->cluster_big_pool = 8;
 }
 
+#define CLUSTER_USED(__size) \
+static int64_t cluster_##__size##_used(void *data) \
+{ \
+    ogs_pkbuf_pool_t *pool = data; \
+    return ogs_pool_used(&pool->cluster_##__size); \
+}
+CLUSTER_USED(128)
+CLUSTER_USED(256)
+CLUSTER_USED(512)
+CLUSTER_USED(1024)
+CLUSTER_USED(2048)
+CLUSTER_USED(8192)
+CLUSTER_USED(big)
+
 void ogs_pkbuf_default_create(ogs_pkbuf_config_t *config)
 {
+    static const struct {
+        const char *labels;
+        ogs_metrics_collect_f collect;
+    } cluster[7] = {
+        { "size=\"128\"", cluster_128_used },
+        { "size=\"256\"", cluster_256_used },
+        { "size=\"512\"", cluster_512_used },
+        { "size=\"1024\"", cluster_1024_used },
+        { "size=\"2048\"", cluster_2048_used },
+        { "size=\"8192\"", cluster_8192_used },
+        { "size=\"big\"", cluster_big_used },
+    };
+    int i;
+
     default_pool = ogs_pkbuf_pool_create(config);
+
+    for (i = 0; i < 7; i++)
+        default_pool_used[i] = ogs_metrics_add_collector(
+                "pkbuf_clusters_used", "Clusters in use by size",
+                cluster[i].labels, cluster[i].collect, default_pool);
 }
 
 void ogs_pkbuf_default_destroy(void)
 {
+    int i;
+
+    for (i = 0; i < 7; i++) {
+        if (default_pool_used[i])
+            ogs_metrics_remove(default_pool_used[i]);
+        default_pool_used[i] = NULL;
+    }
+
     ogs_pkbuf_pool_destroy(default_pool);
 }
 
@@ -195,6 +248,7 @@ ogs_pkbuf_t *ogs_pkbuf_alloc_debug(
 
     cluster = cluster_alloc(pool, size);
     if (!cluster) {
+        ogs_metrics_inc(alloc_failures);
         ogs_error("ogs_pkbuf_alloc() failed [size=%d]", size);
         ogs_thread_mutex_unlock(&pool->mutex);
         return NULL;
@@ -38,6 +38,7 @@ typedef struct ogs_poll_s {
     void *data;
 
     ogs_pollset_t *pollset;
+    bool pending;
 } ogs_poll_t;
 
 typedef struct ogs_pollset_s {
@@ -50,8 +51,14 @@ typedef struct ogs_pollset_s {
     } notify;
 
     unsigned int capacity;
+
+    ogs_poll_t *current;        /* Handler in progress */
+    ogs_list_t pending;         /* Handlers to call again without an edge */
 } ogs_pollset_t;
 
+void ogs_pollset_dispatch(ogs_poll_t *poll, short when);
+int ogs_pollset_dispatch_pending(ogs_pollset_t *pollset);
+
 #ifdef __cplusplus
 }
 #endif
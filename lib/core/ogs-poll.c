@@ -40,6 +40,7 @@ ogs_pollset_t *ogs_pollset_create(unsigned int capacity)
     pollset->capacity = capacity;
 
     ogs_pool_init(&pollset->pool, capacity);
+    ogs_list_init(&pollset->pending);
 
     if (ogs_pollset_actions_initialized == false) {
 #if defined(HAVE_KQUEUE)
@@ -96,6 +97,7 @@ ogs_poll_t *ogs_pollset_add(ogs_pollset_t *pollset, short when,
         poll->data = data;
 
     poll->pollset = pollset;
+    poll->pending = false;
 
     rc = ogs_pollset_actions.add(poll);
     if (rc != OGS_OK) {
@@ -121,6 +123,11 @@ void ogs_pollset_remove(ogs_poll_t *poll)
         ogs_error("cannot delete poll");
     }
 
+    if (poll->pending)
+        ogs_list_remove(&pollset->pending, poll);
+    if (pollset->current == poll)
+        pollset->current = NULL;
+
     ogs_pool_free(&pollset->pool, poll);
 }
 
@@ -128,3 +135,58 @@ void *ogs_pollset_self_handler_data(void)
 {
     return &self_handler_data;
 }
+
+void ogs_pollset_continue(ogs_pollset_t *pollset)
+{
+    ogs_poll_t *poll = NULL;
+
+    ogs_assert(pollset);
+
+    poll = pollset->current;
+    if (!poll || !(poll->when & OGS_POLLET) || poll->pending)
+        return;
+
+    poll->pending = true;
+    ogs_list_add(&pollset->pending, poll);
+}
+
+void ogs_pollset_dispatch(ogs_poll_t *poll, short when)
+{
+    ogs_pollset_t *pollset = NULL;
+
+    ogs_assert(poll);
+    pollset = poll->pollset;
+    ogs_assert(pollset);
+
+    pollset->current = poll;
+    poll->handler(when, poll->fd, poll->data);
+    pollset->current = NULL;
+}
+
+int ogs_pollset_dispatch_pending(ogs_pollset_t *pollset)
+{
+    ogs_poll_t *poll = NULL;
+    int i, count = 0;
+
+    ogs_assert(pollset);
+
+    /*
+     * A handler that runs out of budget again is appended to the list,
+     * so only the handlers pending at the start are called.
+     */
+    ogs_list_for_each(&pollset->pending, poll)
+        count++;
+
+    for (i = 0; i < count; i++) {
+        poll = ogs_list_first(&pollset->pending);
+        if (!poll)
+            break;
+
+        ogs_list_remove(&pollset->pending, poll);
+        poll->pending = false;
+
+        ogs_pollset_dispatch(poll, OGS_POLLIN);
+    }
+
+    return i;
+}
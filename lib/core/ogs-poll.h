@@ -35,12 +35,26 @@ void ogs_pollset_destroy(ogs_pollset_t *pollset);
 
 #define OGS_POLLIN      0x01
 #define OGS_POLLOUT     0x02
+#define OGS_POLLET      0x04
+
+/*
+ * With OGS_POLLET, the read handler is called once per edge and has to
+ * read until EAGAIN. To be fair to the other sockets, it should stop after
+ * OGS_POLL_BUDGET messages and call ogs_pollset_continue(); it is called
+ * again on the next ogs_pollset_poll() without waiting for a new edge.
+ *
+ * The backends without edge-triggered support ignore OGS_POLLET.
+ * The descriptor stays level-triggered, and ogs_pollset_continue()
+ * has no effect.
+ */
+#define OGS_POLL_BUDGET 64
 
 ogs_poll_t *ogs_pollset_add(ogs_pollset_t *pollset, short when,
         ogs_socket_t fd, ogs_poll_handler_f handler, void *data);
 void ogs_pollset_remove(ogs_poll_t *poll);
 
 void *ogs_pollset_self_handler_data(void);
+void ogs_pollset_continue(ogs_pollset_t *pollset);
 
 typedef struct ogs_pollset_actions_s {
     void (*init)(ogs_pollset_t *pollset);
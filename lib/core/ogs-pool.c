@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "core-config-private.h"
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include "ogs-core.h"
+
+void ogs_pool_trim_memory(void *ptr, size_t size)
+{
+#if HAVE_SYS_MMAN_H && defined(MADV_DONTNEED)
+    uintptr_t page, start, end;
+
+    ogs_assert(ptr);
+
+    page = sysconf(_SC_PAGESIZE);
+
+    /* Only the pages that are entirely inside the chunk */
+    start = ((uintptr_t)ptr + page - 1) & ~(page - 1);
+    end = ((uintptr_t)ptr + size) & ~(page - 1);
+
+    if (start < end)
+        if (madvise((void *)start, end - start, MADV_DONTNEED) != 0)
+            ogs_log_message(OGS_LOG_WARN, ogs_errno, "madvise() failed");
+#endif
+}
@@ -30,29 +30,47 @@ extern "C" {
 
 typedef unsigned int ogs_index_t;
 
+/*
+ * The arrays are allocated for the full size of the pool,
+ * but the objects are handed out chunk by chunk (OGS_POOL_CHUNK_SIZE).
+ * The free list only holds the objects of the chunks added so far,
+ * so allocations are served from the low chunks of the array instead
+ * of cycling through all of it, while the index of an object
+ * stays the same.
+ *
+ * If trim is set with ogs_pool_set_trim(), the memory of a chunk is given
+ * back to the OS when all of its objects are freed. Do not use it
+ * if the content of a free object has to be kept (e.g. M-TMSI pool).
+ */
+#define OGS_POOL_CHUNK_SIZE 1024
+
 #define OGS_POOL(pool, type) \
     struct { \
         const char *name; \
         int head, tail; \
         int size, avail; \
+        int grown, peak; \
+        bool trim; \
+        int *chunk_used; \
         type **free, *array, **index; \
     } pool
 
 #define ogs_pool_init(pool, _size) do { \
-    int i; \
     (pool)->name = #pool; \
     (pool)->free = malloc(sizeof(*(pool)->free) * _size); \
     ogs_assert((pool)->free); \
     (pool)->array = malloc(sizeof(*(pool)->array) * _size); \
     ogs_assert((pool)->array); \
-    (pool)->index = malloc(sizeof(*(pool)->index) * _size); \
+    (pool)->index = calloc(_size, sizeof(*(pool)->index)); \
     ogs_assert((pool)->index); \
+    (pool)->chunk_used = calloc( \
+            (_size + OGS_POOL_CHUNK_SIZE - 1) / OGS_POOL_CHUNK_SIZE + 1, \
+            sizeof(*(pool)->chunk_used)); \
+    ogs_assert((pool)->chunk_used); \
     (pool)->size = (pool)->avail = _size; \
     (pool)->head = (pool)->tail = 0; \
-    for (i = 0; i < _size; i++) { \
-        (pool)->free[i] = &((pool)->array[i]); \
-        (pool)->index[i] = NULL; \
-    } \
+    (pool)->grown = (pool)->peak = 0; \
+    (pool)->trim = false; \
 } while (0)
 
 #define ogs_pool_final(pool) do { \
@@ -62,6 +80,7 @@ typedef unsigned int ogs_index_t;
     free((pool)->free); \
     free((pool)->array); \
     free((pool)->index); \
+    free((pool)->chunk_used); \
 } while (0)
 
 #define ogs_pool_index(pool, node) (((node) - (pool)->array)+1)
@@ -70,14 +89,34 @@ typedef unsigned int ogs_index_t;
 #define ogs_pool_cycle(pool, node) \
     ogs_pool_find((pool), ogs_pool_index((pool), (node)))
 
+#define ogs_pool_chunk(pool, node) \
+    ((ogs_pool_index((pool), (node))-1) / OGS_POOL_CHUNK_SIZE)
+
+/* Add the next chunk of objects to the empty free list */
+#define ogs_pool_grow(pool) do { \
+    int __i, __n; \
+    __n = ogs_min(OGS_POOL_CHUNK_SIZE, (pool)->size - (pool)->grown); \
+    for (__i = 0; __i < __n; __i++) \
+        (pool)->free[__i] = &((pool)->array[(pool)->grown + __i]); \
+    (pool)->grown += __n; \
+    (pool)->head = 0; \
+    (pool)->tail = __n % (pool)->grown; \
+} while (0)
+
 #define ogs_pool_alloc(pool, node) do { \
     *(node) = NULL; \
     if ((pool)->avail > 0) { \
+        if ((pool)->avail == (pool)->size - (pool)->grown) \
+            ogs_pool_grow(pool); \
         (pool)->avail--; \
         *(node) = (void*)(pool)->free[(pool)->head]; \
         (pool)->free[(pool)->head] = NULL; \
-        (pool)->head = ((pool)->head + 1) % ((pool)->size); \
+        (pool)->head = ((pool)->head + 1) % ((pool)->grown); \
         (pool)->index[ogs_pool_index(pool, *(node))-1] = *(node); \
+        if ((pool)->chunk_used) \
+            (pool)->chunk_used[ogs_pool_chunk(pool, *(node))]++; \
+        if ((pool)->size - (pool)->avail > (pool)->peak) \
+            (pool)->peak = (pool)->size - (pool)->avail; \
     } \
 } while (0)
 
@@ -85,14 +124,63 @@ typedef unsigned int ogs_index_t;
     if ((pool)->avail < (pool)->size) { \
         (pool)->avail++; \
         (pool)->free[(pool)->tail] = (void*)(node); \
-        (pool)->tail = ((pool)->tail + 1) % ((pool)->size); \
+        (pool)->tail = ((pool)->tail + 1) % ((pool)->grown); \
         (pool)->index[ogs_pool_index(pool, node)-1] = NULL; \
+        if ((pool)->chunk_used && \
+            --(pool)->chunk_used[ogs_pool_chunk(pool, node)] == 0 && \
+            (pool)->trim) { \
+            int __chunk = ogs_pool_chunk(pool, node); \
+            ogs_pool_trim_memory( \
+                &(pool)->array[__chunk * OGS_POOL_CHUNK_SIZE], \
+                sizeof(*(pool)->array) * ogs_min(OGS_POOL_CHUNK_SIZE, \
+                    (pool)->grown - __chunk * OGS_POOL_CHUNK_SIZE)); \
+        } \
+    } \
+} while (0)
+
+/*
+ * Warm restart : take the objects at the indexes saved by the previous run
+ * out of a new pool with ogs_pool_restore(), then call
+ * ogs_pool_restore_done() to build the free list from the other objects.
+ * No object may be allocated in between.
+ */
+#define ogs_pool_restore(pool, node, _index) do { \
+    *(node) = NULL; \
+    if ((_index) > 0 && (_index) <= (pool)->size && \
+        (pool)->index[(_index)-1] == NULL) { \
+        (pool)->avail--; \
+        *(node) = &(pool)->array[(_index)-1]; \
+        (pool)->index[(_index)-1] = *(node); \
+        if ((pool)->chunk_used) \
+            (pool)->chunk_used[((_index)-1) / OGS_POOL_CHUNK_SIZE]++; \
+    } \
+} while (0)
+
+#define ogs_pool_restore_done(pool) do { \
+    int __i, __n = 0; \
+    if ((pool)->avail < (pool)->size) { \
+        for (__i = 0; __i < (pool)->size; __i++) \
+            if ((pool)->index[__i] == NULL) \
+                (pool)->free[__n++] = &((pool)->array[__i]); \
+        (pool)->grown = (pool)->size; \
+        (pool)->head = 0; \
+        (pool)->tail = __n % (pool)->size; \
+        (pool)->peak = ogs_max((pool)->peak, (pool)->size - (pool)->avail); \
     } \
 } while (0)
 
 #define ogs_pool_size(pool) ((pool)->size)
 #define ogs_pool_avail(pool) ((pool)->avail)
 
+/* Occupancy */
+#define ogs_pool_used(pool) ((pool)->size - (pool)->avail)
+#define ogs_pool_peak(pool) ((pool)->peak)
+#define ogs_pool_grown(pool) ((pool)->grown)
+
+#define ogs_pool_set_trim(pool, _trim) ((pool)->trim = (_trim))
+
+void ogs_pool_trim_memory(void *ptr, size_t size);
+
 #define ogs_index_init(pool, _size) do { \
     int i; \
     (pool)->name = #pool; \
@@ -108,6 +196,10 @@ typedef unsigned int ogs_index_t;
         (pool)->free[i] = &((pool)->array[i]); \
         (pool)->index[i] = NULL; \
     } \
+    (pool)->grown = _size; \
+    (pool)->peak = 0; \
+    (pool)->trim = false; \
+    (pool)->chunk_used = NULL; \
 } while (0)
 
 #define ogs_index_final(pool) do { \
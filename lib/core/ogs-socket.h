@@ -74,6 +74,7 @@ int ogs_closesocket(ogs_socket_t fd);
 int ogs_nonblocking(ogs_socket_t fd);
 int ogs_closeonexec(ogs_socket_t fd);
 int ogs_listen_reusable(ogs_socket_t fd);
+int ogs_listen_reusable_port(ogs_socket_t fd);
 
 #ifdef __cplusplus
 }
@@ -39,6 +39,8 @@ typedef struct ogs_socknode_s {
     ogs_sock_t *sock;
     void (*cleanup)(ogs_sock_t *sock);
     ogs_poll_t *poll;
+
+    bool reuse_port;    /* SO_REUSEPORT for a listener per thread */
 } ogs_socknode_t;
 
 ogs_socknode_t *ogs_socknode_new(ogs_sockaddr_t *addr);
@@ -39,6 +39,13 @@ ogs_sock_t *ogs_tcp_server(ogs_socknode_t *node)
             rv = ogs_listen_reusable(new->fd);
             ogs_assert(rv == OGS_OK);
 
+            if (node->reuse_port &&
+                ogs_listen_reusable_port(new->fd) != OGS_OK) {
+                ogs_sock_destroy(new);
+                addr = addr->next;
+                continue;
+            }
+
             if (ogs_sock_bind(new, addr) == OGS_OK) {
                 ogs_debug("tcp_server() [%s]:%d",
                         OGS_ADDR(addr, buf), OGS_PORT(addr));
@@ -158,6 +158,229 @@ ogs_pkbuf_t *ogs_tlv_build_msg(ogs_tlv_desc_t *desc, void *msg, int mode);
 int ogs_tlv_parse_msg(
         void *msg, ogs_tlv_desc_t *desc, ogs_pkbuf_t *pkbuf, int mode);
 
+/*
+ * Direct encoder/decoder
+ *
+ * gtp-tlv.py and pfcp-tlv.py generate a codec for each message
+ * on top of the helpers below. The IEs are written straight into the pkbuf
+ * and are dispatched on their type with a switch when parsing,
+ * so no ogs_tlv_t node and no descriptor is used.
+ *
+ * 'mode' is a constant in the generated code,
+ * so the switch statements are folded by the compiler.
+ */
+static ogs_inline uint32_t ogs_tlv_header_len(uint8_t mode)
+{
+    switch (mode) {
+    case OGS_TLV_MODE_T1_L1:
+        return 2;
+    case OGS_TLV_MODE_T1_L2:
+        return 3;
+    case OGS_TLV_MODE_T1_L2_I1:
+    case OGS_TLV_MODE_T2_L2:
+        return 4;
+    default:
+        ogs_assert_if_reached();
+        return 0;
+    }
+}
+
+static ogs_inline uint8_t *ogs_tlv_put_header(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint32_t length, uint8_t instance)
+{
+    switch (mode) {
+    case OGS_TLV_MODE_T1_L1:
+        *pos++ = type;
+        *pos++ = length;
+        break;
+    case OGS_TLV_MODE_T1_L2:
+        *pos++ = type;
+        *pos++ = length >> 8;
+        *pos++ = length;
+        break;
+    case OGS_TLV_MODE_T1_L2_I1:
+        *pos++ = type;
+        *pos++ = length >> 8;
+        *pos++ = length;
+        *pos++ = instance;
+        break;
+    case OGS_TLV_MODE_T2_L2:
+        *pos++ = type >> 8;
+        *pos++ = type;
+        *pos++ = length >> 8;
+        *pos++ = length;
+        break;
+    default:
+        ogs_assert_if_reached();
+        break;
+    }
+
+    return pos;
+}
+
+/* Returns the value of the IE, or NULL if the IE overruns 'end' */
+static ogs_inline uint8_t *ogs_tlv_get_header(uint8_t *pos, uint8_t *end,
+        uint8_t mode, uint16_t *type, uint16_t *length, uint8_t *instance)
+{
+    if (end - pos < ogs_tlv_header_len(mode)) {
+        ogs_error("Truncated TLV header [%d]", (int)(end - pos));
+        return NULL;
+    }
+
+    *instance = 0;
+    switch (mode) {
+    case OGS_TLV_MODE_T1_L1:
+        *type = pos[0];
+        *length = pos[1];
+        break;
+    case OGS_TLV_MODE_T1_L2:
+        *type = pos[0];
+        *length = (pos[1] << 8) | pos[2];
+        break;
+    case OGS_TLV_MODE_T1_L2_I1:
+        *type = pos[0];
+        *length = (pos[1] << 8) | pos[2];
+        *instance = pos[3];
+        break;
+    case OGS_TLV_MODE_T2_L2:
+        *type = (pos[0] << 8) | pos[1];
+        *length = (pos[2] << 8) | pos[3];
+        break;
+    default:
+        ogs_assert_if_reached();
+        break;
+    }
+    pos += ogs_tlv_header_len(mode);
+
+    if (end - pos < *length) {
+        ogs_error("Invalid TLV length %d. Only %d bytes left",
+                *length, (int)(end - pos));
+        return NULL;
+    }
+
+    return pos;
+}
+
+static ogs_inline uint8_t *ogs_tlv_write_uint8(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint8_t instance, ogs_tlv_uint8_t *v)
+{
+    pos = ogs_tlv_put_header(pos, mode, type, 1, instance);
+    *pos++ = v->u8;
+    return pos;
+}
+
+static ogs_inline uint8_t *ogs_tlv_write_uint16(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint8_t instance, ogs_tlv_uint16_t *v)
+{
+    pos = ogs_tlv_put_header(pos, mode, type, 2, instance);
+    *pos++ = v->u16 >> 8;
+    *pos++ = v->u16;
+    return pos;
+}
+
+static ogs_inline uint8_t *ogs_tlv_write_uint24(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint8_t instance, ogs_tlv_uint24_t *v)
+{
+    pos = ogs_tlv_put_header(pos, mode, type, 3, instance);
+    *pos++ = v->u24 >> 16;
+    *pos++ = v->u24 >> 8;
+    *pos++ = v->u24;
+    return pos;
+}
+
+static ogs_inline uint8_t *ogs_tlv_write_uint32(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint8_t instance, ogs_tlv_uint32_t *v)
+{
+    pos = ogs_tlv_put_header(pos, mode, type, 4, instance);
+    *pos++ = v->u32 >> 24;
+    *pos++ = v->u32 >> 16;
+    *pos++ = v->u32 >> 8;
+    *pos++ = v->u32;
+    return pos;
+}
+
+static ogs_inline uint8_t *ogs_tlv_write_octet(uint8_t *pos, uint8_t mode,
+        uint16_t type, uint8_t instance, ogs_tlv_octet_t *v)
+{
+    if (v->len == 0) {
+        ogs_fatal("No TLV length - T:%d I:%d", type, instance);
+        ogs_assert_if_reached();
+    }
+
+    pos = ogs_tlv_put_header(pos, mode, type, v->len, instance);
+    memcpy(pos, v->data, v->len);
+    return pos + v->len;
+}
+
+/*
+ * The value of a group IE is written first at 'hdr + header length'
+ * up to 'end'. Then the header is filled in with the length.
+ */
+static ogs_inline uint8_t *ogs_tlv_write_group(uint8_t *hdr, uint8_t mode,
+        uint16_t type, uint8_t instance, uint8_t *end)
+{
+    ogs_tlv_put_header(hdr, mode,
+            type, end - hdr - ogs_tlv_header_len(mode), instance);
+    return end;
+}
+
+static ogs_inline int ogs_tlv_read_uint8(
+        ogs_tlv_uint8_t *v, uint8_t *pos, uint16_t length)
+{
+    if (length != 1) {
+        ogs_error("Invalid TLV length %d. It should be 1", length);
+        return OGS_ERROR;
+    }
+    v->u8 = pos[0];
+    v->presence = 1;
+    return OGS_OK;
+}
+
+static ogs_inline int ogs_tlv_read_uint16(
+        ogs_tlv_uint16_t *v, uint8_t *pos, uint16_t length)
+{
+    if (length != 2) {
+        ogs_error("Invalid TLV length %d. It should be 2", length);
+        return OGS_ERROR;
+    }
+    v->u16 = (pos[0] << 8) | pos[1];
+    v->presence = 1;
+    return OGS_OK;
+}
+
+static ogs_inline int ogs_tlv_read_uint24(
+        ogs_tlv_uint24_t *v, uint8_t *pos, uint16_t length)
+{
+    if (length != 3) {
+        ogs_error("Invalid TLV length %d. It should be 3", length);
+        return OGS_ERROR;
+    }
+    v->u24 = (pos[0] << 16) | (pos[1] << 8) | pos[2];
+    v->presence = 1;
+    return OGS_OK;
+}
+
+static ogs_inline int ogs_tlv_read_uint32(
+        ogs_tlv_uint32_t *v, uint8_t *pos, uint16_t length)
+{
+    if (length != 4) {
+        ogs_error("Invalid TLV length %d. It should be 4", length);
+        return OGS_ERROR;
+    }
+    v->u32 = ((uint32_t)pos[0] << 24) | (pos[1] << 16) | (pos[2] << 8) | pos[3];
+    v->presence = 1;
+    return OGS_OK;
+}
+
+static ogs_inline int ogs_tlv_read_octet(
+        ogs_tlv_octet_t *v, uint8_t *pos, uint16_t length)
+{
+    v->data = pos;
+    v->len = length;
+    v->presence = 1;
+    return OGS_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* recvmmsg(), sendmmsg() */
+#endif
+
+#include "core-config-private.h"
+
 #include "ogs-core.h"
 
 #undef OGS_LOG_DOMAIN
@@ -139,3 +145,112 @@ int ogs_udp_connect(ogs_sock_t *sock, ogs_sockaddr_t *sa_list)
 
     return OGS_OK;
 }
+
+/*
+ * Receive up to num datagrams with one system call if recvmmsg() is
+ * available. Each pkbuf provides its data/len as the receive buffer and
+ * is trimmed to the size of the datagram. Returns the number of
+ * datagrams or -1 with ogs_socket_errno set. On a non-blocking socket,
+ * less than num means that the receive queue is empty.
+ */
+int ogs_recvmmsg(ogs_socket_t fd,
+        ogs_pkbuf_t **pkbuf, ogs_sockaddr_t *from, int num)
+{
+#if HAVE_RECVMMSG
+    struct mmsghdr msg[OGS_MAX_NUM_OF_MMSG];
+    struct iovec iov[OGS_MAX_NUM_OF_MMSG];
+    int i, n;
+
+    ogs_assert(fd != INVALID_SOCKET);
+    ogs_assert(pkbuf);
+    ogs_assert(from);
+    ogs_assert(num > 0 && num <= OGS_MAX_NUM_OF_MMSG);
+
+    memset(msg, 0, sizeof(msg[0]) * num);
+    for (i = 0; i < num; i++) {
+        ogs_assert(pkbuf[i]);
+        iov[i].iov_base = pkbuf[i]->data;
+        iov[i].iov_len = pkbuf[i]->len;
+
+        memset(&from[i], 0, sizeof from[i]);
+        msg[i].msg_hdr.msg_name = &from[i].sa;
+        msg[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        msg[i].msg_hdr.msg_iov = &iov[i];
+        msg[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    n = recvmmsg(fd, msg, num, 0, NULL);
+    for (i = 0; i < n; i++)
+        ogs_pkbuf_trim(pkbuf[i], msg[i].msg_len);
+
+    return n;
+#else
+    int i;
+
+    ogs_assert(pkbuf);
+    ogs_assert(from);
+
+    for (i = 0; i < num; i++) {
+        ssize_t size;
+
+        ogs_assert(pkbuf[i]);
+        size = ogs_recvfrom(fd, pkbuf[i]->data, pkbuf[i]->len, 0, &from[i]);
+        if (size < 0)
+            return i ? i : -1;
+
+        ogs_pkbuf_trim(pkbuf[i], size);
+    }
+
+    return num;
+#endif
+}
+
+/*
+ * Send num datagrams with one system call if sendmmsg() is available.
+ * Returns the number of datagrams sent, which can be less than num,
+ * or -1 with ogs_socket_errno set if the first one failed.
+ */
+int ogs_sendmmsg(ogs_socket_t fd,
+        ogs_pkbuf_t **pkbuf, ogs_sockaddr_t *to, int num)
+{
+#if HAVE_SENDMMSG
+    struct mmsghdr msg[OGS_MAX_NUM_OF_MMSG];
+    struct iovec iov[OGS_MAX_NUM_OF_MMSG];
+    int i;
+
+    ogs_assert(fd != INVALID_SOCKET);
+    ogs_assert(pkbuf);
+    ogs_assert(to);
+    ogs_assert(num > 0 && num <= OGS_MAX_NUM_OF_MMSG);
+
+    memset(msg, 0, sizeof(msg[0]) * num);
+    for (i = 0; i < num; i++) {
+        ogs_assert(pkbuf[i]);
+        iov[i].iov_base = pkbuf[i]->data;
+        iov[i].iov_len = pkbuf[i]->len;
+
+        msg[i].msg_hdr.msg_name = &to[i].sa;
+        msg[i].msg_hdr.msg_namelen = ogs_sockaddr_len(&to[i]);
+        msg[i].msg_hdr.msg_iov = &iov[i];
+        msg[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    return sendmmsg(fd, msg, num, 0);
+#else
+    int i;
+
+    ogs_assert(pkbuf);
+    ogs_assert(to);
+
+    for (i = 0; i < num; i++) {
+        ssize_t sent;
+
+        ogs_assert(pkbuf[i]);
+        sent = ogs_sendto(fd, pkbuf[i]->data, pkbuf[i]->len, 0, &to[i]);
+        if (sent < 0 || sent != pkbuf[i]->len)
+            return i ? i : -1;
+    }
+
+    return num;
+#endif
+}
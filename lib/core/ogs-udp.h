@@ -33,6 +33,13 @@ ogs_sock_t *ogs_udp_server(ogs_socknode_t *node);
 ogs_sock_t *ogs_udp_client(ogs_socknode_t *node);
 int ogs_udp_connect(ogs_sock_t *sock, ogs_sockaddr_t *sa_list);
 
+#define OGS_MAX_NUM_OF_MMSG     32
+
+int ogs_recvmmsg(ogs_socket_t fd,
+        ogs_pkbuf_t **pkbuf, ogs_sockaddr_t *from, int num);
+int ogs_sendmmsg(ogs_socket_t fd,
+        ogs_pkbuf_t **pkbuf, ogs_sockaddr_t *to, int num);
+
 #ifdef __cplusplus
 }
 #endif
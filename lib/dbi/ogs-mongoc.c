@@ -133,6 +133,10 @@ int ogs_mongoc_init(const char *db_uri)
 
 void ogs_mongoc_final(void)
 {
+    if (self.pool) {
+        mongoc_client_pool_destroy(self.pool);
+        self.pool = NULL;
+    }
     if (self.database) {
         mongoc_database_destroy(self.database);
         self.database = NULL;
@@ -183,3 +187,54 @@ void ogs_dbi_final()
 
     ogs_mongoc_final();
 }
+
+int ogs_dbi_pool_init(void)
+{
+    ogs_assert(self.client);
+    ogs_assert(!self.pool);
+
+    self.pool = mongoc_client_pool_new(mongoc_client_get_uri(self.client));
+    if (!self.pool) {
+        ogs_error("Failed to create client pool [%s]", self.masked_db_uri);
+        return OGS_ERROR;
+    }
+
+#if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 4
+    mongoc_client_pool_set_error_api(self.pool, 2);
+#endif
+
+    return OGS_OK;
+}
+
+mongoc_collection_t *ogs_dbi_subscriber_get(mongoc_client_t **client)
+{
+    mongoc_collection_t *collection = NULL;
+
+    ogs_assert(client);
+
+    if (!self.pool) {
+        *client = NULL;
+        return self.collection.subscriber;
+    }
+
+    *client = mongoc_client_pool_pop(self.pool);
+    ogs_assert(*client);
+    collection = mongoc_client_get_collection(
+            *client, self.name, "subscribers");
+    ogs_assert(collection);
+
+    return collection;
+}
+
+void ogs_dbi_subscriber_put(
+        mongoc_client_t *client, mongoc_collection_t *collection)
+{
+    if (!client)
+        return;
+
+    ogs_assert(self.pool);
+    ogs_assert(collection);
+
+    mongoc_collection_destroy(collection);
+    mongoc_client_pool_push(self.pool, client);
+}
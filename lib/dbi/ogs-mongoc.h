@@ -37,6 +37,8 @@ typedef struct ogs_mongoc_s {
     void *client;
     void *database;
 
+    void *pool;     /* mongoc_client_pool_t of ogs_dbi_pool_init() */
+
     char *masked_db_uri;
 
     struct {
@@ -51,6 +53,21 @@ ogs_mongoc_t *ogs_mongoc(void);
 int ogs_dbi_init(const char *db_uri);
 void ogs_dbi_final(void);
 
+/*
+ * Database access from many threads, e.g. the worker threads of
+ * freeDiameter.
+ *
+ * Without the pool, every query uses the single client of ogs_mongoc(),
+ * so the caller has to serialize the queries. With the pool, a query
+ * takes a client of the pool for its duration, and the queries of
+ * different threads run in parallel on different connections.
+ */
+int ogs_dbi_pool_init(void);
+
+mongoc_collection_t *ogs_dbi_subscriber_get(mongoc_client_t **client);
+void ogs_dbi_subscriber_put(
+        mongoc_client_t *client, mongoc_collection_t *collection);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,8 @@ int ogs_dbi_session_data(char *supi, ogs_s_nssai_t *s_nssai, char *dnn,
         ogs_session_data_t *session_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *collection = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_t *opts = NULL;
@@ -57,12 +59,14 @@ int ogs_dbi_session_data(char *supi, ogs_s_nssai_t *s_nssai, char *dnn,
     supi_id = ogs_id_get_value(supi);
     ogs_assert(supi_id);
 
+    collection = ogs_dbi_subscriber_get(&client);
+    ogs_assert(collection);
+
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
-    cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+    cursor = mongoc_collection_find_with_opts(collection, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(collection,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -491,6 +495,8 @@ out:
     if (opts) bson_destroy(opts);
     if (cursor) mongoc_cursor_destroy(cursor);
 
+    ogs_dbi_subscriber_put(client, collection);
+
     ogs_free(supi_type);
     ogs_free(supi_id);
 
@@ -64,11 +64,25 @@ static int ogs_gtp_context_prepare(void)
     self.gtpc_port = OGS_GTPV2_C_UDP_PORT;
     self.gtpu_port = OGS_GTPV1_U_UDP_PORT;
 
+    self.echo.t3_response_duration =
+        ogs_app()->time.message.gtp.t3_response_duration;
+    self.echo.n3_response_rcount =
+        ogs_app()->time.message.gtp.n3_response_rcount;
+
     return OGS_OK;
 }
 
 static int ogs_gtp_context_validation(const char *local)
 {
+    if (self.echo.interval &&
+        (self.echo.t3_response_duration <= 0 ||
+         self.echo.n3_response_rcount <= 0)) {
+        ogs_error("Invalid GTP-U Echo T3[%lld] N3[%d] in `%s`",
+                (long long)self.echo.t3_response_duration,
+                self.echo.n3_response_rcount, local);
+        return OGS_ERROR;
+    }
+
     return OGS_OK;
 }
 
@@ -484,6 +498,25 @@ int ogs_gtp_context_parse_config(const char *local, const char *remote)
                         ogs_list_for_each_safe(&list6, next_iter, iter)
                             ogs_list_add(&self.gtpu_list, iter);
                     }
+                } else if (!strcmp(local_key, "echo")) {
+                    ogs_yaml_iter_t echo_iter;
+                    ogs_yaml_iter_recurse(&local_iter, &echo_iter);
+
+                    while (ogs_yaml_iter_next(&echo_iter)) {
+                        const char *echo_key = ogs_yaml_iter_key(&echo_iter);
+                        const char *v = ogs_yaml_iter_value(&echo_iter);
+                        ogs_assert(echo_key);
+                        if (!strcmp(echo_key, "interval")) {
+                            if (v) self.echo.interval =
+                                ogs_time_from_sec(atoll(v));
+                        } else if (!strcmp(echo_key, "t3")) {
+                            if (v) self.echo.t3_response_duration =
+                                ogs_time_from_msec(atoll(v));
+                        } else if (!strcmp(echo_key, "n3")) {
+                            if (v) self.echo.n3_response_rcount = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", echo_key);
+                    }
                 }
             }
         }
@@ -517,6 +550,8 @@ void ogs_gtp_node_free(ogs_gtp_node_t *node)
 {
     ogs_assert(node);
 
+    ogs_gtp_echo_remove(node);
+
     if (node->sock)
         ogs_sock_destroy(node->sock);
 
@@ -50,6 +50,12 @@ typedef struct ogs_gtp_context_s {
 
     ogs_list_t      gtpu_peer_list; /* GTPU Node List */
     ogs_list_t      gtpu_resource_list; /* UP IP Resource List */
+
+    struct {
+        ogs_time_t  interval;       /* 0: No GTP-U Echo Request */
+        ogs_time_t  t3_response_duration;
+        int         n3_response_rcount;
+    } echo;
 } ogs_gtp_context_t;
 
 #define OGS_SETUP_GTP_NODE(__cTX, __gNODE) \
@@ -74,6 +80,19 @@ typedef struct ogs_gtp_node_s {
 
     ogs_list_t      local_list;    
     ogs_list_t      remote_list;   
+
+    struct {
+        ogs_lnode_t lnode;          /* Slot of the timing wheel */
+        bool        linked;
+        uint64_t    expires;        /* Tick of the timing wheel */
+
+        uint16_t    sqn;
+        ogs_time_t  sent;           /* Outstanding Echo Request */
+        int         lost;           /* Consecutive lost Echo Requests */
+        bool        down;
+
+        ogs_time_t  rtt;            /* Smoothed round-trip time */
+    } path;
 } ogs_gtp_node_t;
 
 typedef struct ogs_gtpu_resource_s {
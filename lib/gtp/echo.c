@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-gtp.h"
+
+#define ECHO_TICK               ogs_time_from_msec(100)
+#define ECHO_WHEEL_SIZE         1024    /* Power of 2 */
+#define ECHO_WHEEL_MASK         (ECHO_WHEEL_SIZE - 1)
+
+/* Sequence Number, N-PDU Number and Next Extension Header Type */
+#define ECHO_REQUEST_LEN        4
+
+typedef enum {
+    ECHO_EVENT_REQUEST = 0,
+    ECHO_EVENT_RESPONSE,
+    ECHO_EVENT_LOST,
+    ECHO_EVENT_FAILURE,
+    ECHO_EVENT_RECOVERY,
+
+    MAX_NUM_OF_ECHO_EVENT,
+} echo_event_e;
+
+static struct {
+    bool opened;
+    ogs_gtp_echo_path_f path_cb;
+
+    ogs_timer_t *timer;
+    ogs_time_t base;            /* Monotonic time of the tick 0 */
+    uint64_t tick;              /* Next tick to run */
+    ogs_list_t slot[ECHO_WHEEL_SIZE];
+
+    ogs_hash_t *peer_hash;      /* Address of the peer to gnode */
+    int num_of_down;
+} echo;
+
+static struct {
+    ogs_metrics_t *event;
+    ogs_metrics_t *rtt;
+    ogs_metrics_t *down;
+} metrics;
+
+static const char *echo_event_name[MAX_NUM_OF_ECHO_EVENT] = {
+    "request",
+    "response",
+    "lost",
+    "failure",
+    "recovery",
+};
+
+static const int64_t rtt_bucket[] = {
+    1000, 2500, 5000, 10000, 25000, 50000,
+    100000, 250000, 500000, 1000000
+};
+
+static void echo_tick(void *data);
+
+static const char *echo_event_label(int index)
+{
+    return echo_event_name[index];
+}
+
+static int64_t echo_down(void *data)
+{
+    return echo.num_of_down;
+}
+
+static uint64_t current_tick(void)
+{
+    return (ogs_get_monotonic_time() - echo.base) / ECHO_TICK;
+}
+
+static void *peer_key(ogs_sockaddr_t *addr, int *len)
+{
+    ogs_assert(addr);
+    ogs_assert(len);
+
+    switch (addr->ogs_sa_family) {
+    case AF_INET:
+        *len = sizeof(addr->sin.sin_addr);
+        return &addr->sin.sin_addr;
+    case AF_INET6:
+        *len = sizeof(addr->sin6.sin6_addr);
+        return &addr->sin6.sin6_addr;
+    default:
+        return NULL;
+    }
+}
+
+int ogs_gtp_echo_open(ogs_gtp_echo_path_f path_cb)
+{
+    int i;
+
+    ogs_assert(echo.opened == false);
+
+    if (ogs_gtp_self()->echo.interval == 0)
+        return OGS_OK;
+
+    echo.path_cb = path_cb;
+
+    echo.timer = ogs_timer_add(ogs_app()->timer_mgr, echo_tick, NULL);
+    ogs_assert(echo.timer);
+    echo.base = ogs_get_monotonic_time();
+    echo.tick = 0;
+    for (i = 0; i < ECHO_WHEEL_SIZE; i++)
+        ogs_list_init(&echo.slot[i]);
+
+    echo.peer_hash = ogs_hash_make();
+    ogs_assert(echo.peer_hash);
+    echo.num_of_down = 0;
+
+    metrics.event = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "gtpu_path_events_total",
+            "GTP-U Echo Requests and path state changes by event",
+            NULL, "event", MAX_NUM_OF_ECHO_EVENT, echo_event_label);
+    metrics.rtt = ogs_metrics_add_histogram(
+            "gtpu_path_rtt_microseconds",
+            "Time from sending a GTP-U Echo Request to receiving the response",
+            NULL, rtt_bucket, OGS_ARRAY_SIZE(rtt_bucket));
+    metrics.down = ogs_metrics_add_collector("gtpu_peers_down",
+            "GTP-U peers whose path is down",
+            NULL, echo_down, NULL);
+
+    echo.opened = true;
+
+    ogs_timer_start(echo.timer, ECHO_TICK);
+
+    return OGS_OK;
+}
+
+void ogs_gtp_echo_close(void)
+{
+    ogs_lnode_t *lnode = NULL, *next_lnode = NULL;
+    ogs_gtp_node_t *gnode = NULL;
+    int i;
+
+    if (echo.opened == false)
+        return;
+
+    for (i = 0; i < ECHO_WHEEL_SIZE; i++) {
+        ogs_list_for_each_safe(&echo.slot[i], next_lnode, lnode) {
+            gnode = ogs_container_of(lnode, ogs_gtp_node_t, path.lnode);
+            ogs_list_remove(&echo.slot[i], lnode);
+            gnode->path.linked = false;
+        }
+    }
+
+    ogs_hash_destroy(echo.peer_hash);
+    ogs_timer_delete(echo.timer);
+
+    if (metrics.event) ogs_metrics_remove(metrics.event);
+    if (metrics.rtt) ogs_metrics_remove(metrics.rtt);
+    if (metrics.down) ogs_metrics_remove(metrics.down);
+    memset(&metrics, 0, sizeof(metrics));
+
+    memset(&echo, 0, sizeof(echo));
+}
+
+static void path_unlink(ogs_gtp_node_t *gnode)
+{
+    ogs_assert(gnode);
+
+    if (gnode->path.linked == false)
+        return;
+
+    ogs_list_remove(&echo.slot[gnode->path.expires & ECHO_WHEEL_MASK],
+            &gnode->path.lnode);
+    gnode->path.linked = false;
+}
+
+static void path_schedule(ogs_gtp_node_t *gnode, ogs_time_t timeout)
+{
+    uint64_t ticks;
+
+    ogs_assert(gnode);
+
+    path_unlink(gnode);
+
+    ticks = (timeout + ECHO_TICK - 1) / ECHO_TICK;
+    if (ticks == 0)
+        ticks = 1;
+
+    gnode->path.expires = current_tick() + ticks;
+    ogs_list_add(&echo.slot[gnode->path.expires & ECHO_WHEEL_MASK],
+            &gnode->path.lnode);
+    gnode->path.linked = true;
+}
+
+void ogs_gtp_echo_add(ogs_gtp_node_t *gnode)
+{
+    void *key = NULL;
+    int len = 0;
+
+    ogs_assert(gnode);
+
+    if (echo.opened == false || gnode->path.linked == true)
+        return;
+
+    key = peer_key(&gnode->addr, &len);
+    if (!key) {
+        ogs_error("Unknown family [%d]", gnode->addr.ogs_sa_family);
+        return;
+    }
+    ogs_hash_set(echo.peer_hash, key, len, gnode);
+
+    /* The first Echo Requests to a number of new peers are spread */
+    path_schedule(gnode,
+            ogs_random32() % (uint32_t)ogs_gtp_self()->echo.interval);
+}
+
+void ogs_gtp_echo_remove(ogs_gtp_node_t *gnode)
+{
+    void *key = NULL;
+    int len = 0;
+
+    ogs_assert(gnode);
+
+    if (echo.opened == false)
+        return;
+
+    path_unlink(gnode);
+
+    key = peer_key(&gnode->addr, &len);
+    if (key && ogs_hash_get(echo.peer_hash, key, len) == gnode)
+        ogs_hash_set(echo.peer_hash, key, len, NULL);
+
+    if (gnode->path.down) {
+        gnode->path.down = false;
+        echo.num_of_down--;
+    }
+}
+
+static void send_echo_request(ogs_gtp_node_t *gnode)
+{
+    char buf[OGS_ADDRSTRLEN];
+    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_gtp_header_t *gtp_h = NULL;
+    uint8_t *p = NULL;
+
+    ogs_assert(gnode);
+    ogs_assert(gnode->sock);
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_GTPV1U_HEADER_LEN + ECHO_REQUEST_LEN);
+    ogs_expect_or_return(pkbuf);
+    ogs_pkbuf_put(pkbuf, OGS_GTPV1U_HEADER_LEN + ECHO_REQUEST_LEN);
+
+    gtp_h = (ogs_gtp_header_t *)pkbuf->data;
+    gtp_h->flags = OGS_GTPU_FLAGS_V | OGS_GTPU_FLAGS_PT | OGS_GTPU_FLAGS_S;
+    gtp_h->type = OGS_GTPU_MSGTYPE_ECHO_REQ;
+    gtp_h->length = htobe16(ECHO_REQUEST_LEN);
+    gtp_h->teid = 0;
+
+    gnode->path.sqn++;
+
+    p = pkbuf->data + OGS_GTPV1U_HEADER_LEN;
+    p[0] = gnode->path.sqn >> 8;
+    p[1] = gnode->path.sqn & 0xff;
+    p[2] = 0;       /* N-PDU Number */
+    p[3] = 0;       /* Next Extension Header Type */
+
+    ogs_debug("[SEND] Echo Request to [%s] SQN[%d]",
+            OGS_ADDR(&gnode->addr, buf), gnode->path.sqn);
+
+    gnode->path.sent = ogs_get_monotonic_time();
+    ogs_gtp_sendto(gnode, pkbuf);
+    ogs_pkbuf_free(pkbuf);
+
+    ogs_metrics_vector_inc(metrics.event, ECHO_EVENT_REQUEST);
+}
+
+static void path_expire(ogs_gtp_node_t *gnode)
+{
+    char buf[OGS_ADDRSTRLEN];
+
+    ogs_assert(gnode);
+
+    if (gnode->path.sent) {
+        /* No Echo Response within T3-RESPONSE */
+        gnode->path.sent = 0;
+        ogs_metrics_vector_inc(metrics.event, ECHO_EVENT_LOST);
+
+        if (gnode->path.down) {
+            path_schedule(gnode, ogs_gtp_self()->echo.interval);
+            return;
+        }
+
+        gnode->path.lost++;
+        if (gnode->path.lost >= ogs_gtp_self()->echo.n3_response_rcount) {
+            ogs_warn("[%s] GTP-U path failure after %d Echo Requests",
+                    OGS_ADDR(&gnode->addr, buf), gnode->path.lost);
+
+            gnode->path.down = true;
+            echo.num_of_down++;
+            ogs_metrics_vector_inc(metrics.event, ECHO_EVENT_FAILURE);
+
+            if (echo.path_cb)
+                echo.path_cb(gnode);
+
+            path_schedule(gnode, ogs_gtp_self()->echo.interval);
+            return;
+        }
+    }
+
+    send_echo_request(gnode);
+    path_schedule(gnode, ogs_gtp_self()->echo.t3_response_duration);
+}
+
+static void echo_tick(void *data)
+{
+    uint64_t now;
+    ogs_list_t *slot = NULL;
+    ogs_lnode_t *lnode = NULL, *next_lnode = NULL;
+    ogs_gtp_node_t *gnode = NULL;
+
+    now = current_tick();
+
+    /* A late timer never runs a slot more than once */
+    if (now >= echo.tick + ECHO_WHEEL_SIZE)
+        echo.tick = now - ECHO_WHEEL_SIZE + 1;
+
+    ogs_gtp_send_batch_start();
+
+    for (; echo.tick <= now; echo.tick++) {
+        slot = &echo.slot[echo.tick & ECHO_WHEEL_MASK];
+
+        ogs_list_for_each_safe(slot, next_lnode, lnode) {
+            gnode = ogs_container_of(lnode, ogs_gtp_node_t, path.lnode);
+
+            /* Due in a later turn of the wheel */
+            if (gnode->path.expires > echo.tick)
+                continue;
+
+            ogs_list_remove(slot, lnode);
+            gnode->path.linked = false;
+
+            path_expire(gnode);
+        }
+    }
+
+    ogs_gtp_send_batch_flush();
+
+    ogs_timer_start(echo.timer, ECHO_TICK);
+}
+
+int ogs_gtp_echo_handle_response(ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from)
+{
+    char buf[OGS_ADDRSTRLEN];
+    ogs_gtp_header_t *gtp_h = NULL;
+    ogs_gtp_node_t *gnode = NULL;
+    void *key = NULL;
+    int len = 0;
+    ogs_time_t rtt;
+
+    ogs_assert(pkbuf);
+    ogs_assert(from);
+
+    if (echo.opened == false)
+        return OGS_ERROR;
+
+    if (pkbuf->len < OGS_GTPV1U_HEADER_LEN) {
+        ogs_error("Invalid Echo Response Length [%d]", pkbuf->len);
+        return OGS_ERROR;
+    }
+    gtp_h = (ogs_gtp_header_t *)pkbuf->data;
+
+    key = peer_key(from, &len);
+    if (key)
+        gnode = ogs_hash_get(echo.peer_hash, key, len);
+    if (!gnode || !gnode->path.sent) {
+        ogs_debug("[%s] Unexpected Echo Response", OGS_ADDR(from, buf));
+        return OGS_ERROR;
+    }
+
+    if (gtp_h->flags & OGS_GTPU_FLAGS_S) {
+        uint8_t *p = pkbuf->data + OGS_GTPV1U_HEADER_LEN;
+
+        if (pkbuf->len < OGS_GTPV1U_HEADER_LEN + 2 ||
+            ((p[0] << 8) | p[1]) != gnode->path.sqn) {
+            ogs_debug("[%s] Stale Echo Response", OGS_ADDR(from, buf));
+            return OGS_ERROR;
+        }
+    }
+
+    rtt = ogs_get_monotonic_time() - gnode->path.sent;
+    gnode->path.rtt = gnode->path.rtt ?
+        (7 * gnode->path.rtt + rtt) / 8 : rtt;
+    ogs_metrics_observe(metrics.rtt, rtt);
+    ogs_metrics_vector_inc(metrics.event, ECHO_EVENT_RESPONSE);
+
+    gnode->path.sent = 0;
+    gnode->path.lost = 0;
+
+    if (gnode->path.down) {
+        ogs_info("[%s] GTP-U path recovery", OGS_ADDR(from, buf));
+
+        gnode->path.down = false;
+        echo.num_of_down--;
+        ogs_metrics_vector_inc(metrics.event, ECHO_EVENT_RECOVERY);
+
+        if (echo.path_cb)
+            echo.path_cb(gnode);
+    }
+
+    path_schedule(gnode, ogs_gtp_self()->echo.interval);
+
+    return OGS_OK;
+}
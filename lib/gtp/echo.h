@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(OGS_GTP_INSIDE) && !defined(OGS_GTP_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_GTP_ECHO_H
+#define OGS_GTP_ECHO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * GTP-U path management (TS 29.281 7.2.1)
+ *
+ * Every GTP-U peer of the user plane is sent an Echo Request each
+ * ogs_gtp_self()->echo.interval. A request without a response in
+ * T3-RESPONSE is lost, and the path is down after N3-REQUESTS lost
+ * requests in a row. A down peer is still probed each interval,
+ * and the path is up again on the first Echo Response.
+ *
+ * The deadlines of all peers are kept in one hashed timing wheel driven
+ * by a single ogs_timer_t, so that a tick only visits the peers due in
+ * its slot. The callback is invoked on the change of gnode->path.down,
+ * between ogs_gtp_send_batch_start() and ogs_gtp_send_batch_flush().
+ */
+typedef void (*ogs_gtp_echo_path_f)(ogs_gtp_node_t *gnode);
+
+int ogs_gtp_echo_open(ogs_gtp_echo_path_f path_cb);
+void ogs_gtp_echo_close(void);
+
+void ogs_gtp_echo_add(ogs_gtp_node_t *gnode);
+void ogs_gtp_echo_remove(ogs_gtp_node_t *gnode);
+
+/* Returns OGS_OK if the Echo Response is from a peer being probed */
+int ogs_gtp_echo_handle_response(ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_GTP_ECHO_H */
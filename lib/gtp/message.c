@@ -20,7 +20,7 @@
 /*******************************************************************************
  * This file had been created by gtp-tlv.py script v0.1.0
  * Please do not modify this file but regenerate it via script.
- * Created on: 2020-10-14 13:48:14.476575 by acetcom
+ * Created on: 2026-10-18 21:32:35.744206 by root
  * from 29274-g30.docx
  ******************************************************************************/
 
@@ -2685,6 +2685,6511 @@ ogs_tlv_desc_t ogs_gtp_tlv_desc_modify_access_bearers_response =
 }};
 
 
+/* Direct encoder/decoder */
+#define TLV_MODE OGS_TLV_MODE_T1_L2_I1
+#define TLV_HLEN 4
+
+static uint32_t tlv_length_remote_ue_context(ogs_gtp_tlv_remote_ue_context_t *ie);
+static uint8_t *tlv_write_remote_ue_context(uint8_t *pos, ogs_gtp_tlv_remote_ue_context_t *ie);
+static int tlv_read_remote_ue_context(
+        ogs_gtp_tlv_remote_ue_context_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_bearer_context(ogs_gtp_tlv_bearer_context_t *ie);
+static uint8_t *tlv_write_bearer_context(uint8_t *pos, ogs_gtp_tlv_bearer_context_t *ie);
+static int tlv_read_bearer_context(
+        ogs_gtp_tlv_bearer_context_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_overload_control_information(ogs_gtp_tlv_overload_control_information_t *ie);
+static uint8_t *tlv_write_overload_control_information(uint8_t *pos, ogs_gtp_tlv_overload_control_information_t *ie);
+static int tlv_read_overload_control_information(
+        ogs_gtp_tlv_overload_control_information_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_load_control_information(ogs_gtp_tlv_load_control_information_t *ie);
+static uint8_t *tlv_write_load_control_information(uint8_t *pos, ogs_gtp_tlv_load_control_information_t *ie);
+static int tlv_read_load_control_information(
+        ogs_gtp_tlv_load_control_information_t *ie, uint8_t *pos, uint32_t length);
+
+static uint32_t tlv_length_remote_ue_context(ogs_gtp_tlv_remote_ue_context_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->remote_user_id.presence)
+        length += TLV_HLEN + ie->remote_user_id.len;
+    if (ie->remote_ue_ip_information.presence)
+        length += TLV_HLEN + ie->remote_ue_ip_information.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remote_ue_context(uint8_t *pos, ogs_gtp_tlv_remote_ue_context_t *ie)
+{
+    if (ie->remote_user_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_REMOTE_USER_ID_TYPE, 0, &ie->remote_user_id);
+    if (ie->remote_ue_ip_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_REMOTE_UE_IP_INFORMATION_TYPE, 0, &ie->remote_ue_ip_information);
+
+    return pos;
+}
+
+static int tlv_read_remote_ue_context(ogs_gtp_tlv_remote_ue_context_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_REMOTE_USER_ID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->remote_user_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_REMOTE_UE_IP_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->remote_ue_ip_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_bearer_context(ogs_gtp_tlv_bearer_context_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->tft.presence)
+        length += TLV_HLEN + ie->tft.len;
+    if (ie->s1_u_enodeb_f_teid.presence)
+        length += TLV_HLEN + ie->s1_u_enodeb_f_teid.len;
+    if (ie->s4_u_sgsn_f_teid.presence)
+        length += TLV_HLEN + ie->s4_u_sgsn_f_teid.len;
+    if (ie->s5_s8_u_sgw_f_teid.presence)
+        length += TLV_HLEN + ie->s5_s8_u_sgw_f_teid.len;
+    if (ie->s5_s8_u_pgw_f_teid.presence)
+        length += TLV_HLEN + ie->s5_s8_u_pgw_f_teid.len;
+    if (ie->s12_rnc_f_teid.presence)
+        length += TLV_HLEN + ie->s12_rnc_f_teid.len;
+    if (ie->s2b_u_epdg_f_teid_5.presence)
+        length += TLV_HLEN + ie->s2b_u_epdg_f_teid_5.len;
+    if (ie->s2a_u_twan_f_teid_6.presence)
+        length += TLV_HLEN + ie->s2a_u_twan_f_teid_6.len;
+    if (ie->bearer_level_qos.presence)
+        length += TLV_HLEN + ie->bearer_level_qos.len;
+    if (ie->s11_u_mme_f_teid.presence)
+        length += TLV_HLEN + ie->s11_u_mme_f_teid.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->charging_id.presence)
+        length += TLV_HLEN + ie->charging_id.len;
+    if (ie->bearer_flags.presence)
+        length += TLV_HLEN + ie->bearer_flags.len;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+    if (ie->maximum_packet_loss_rate.presence)
+        length += TLV_HLEN + ie->maximum_packet_loss_rate.len;
+    if (ie->s2b_u_epdg_f_teid_8.presence)
+        length += TLV_HLEN + ie->s2b_u_epdg_f_teid_8.len;
+    if (ie->s2b_u_pgw_f_teid.presence)
+        length += TLV_HLEN + ie->s2b_u_pgw_f_teid.len;
+    if (ie->s2a_u_twan_f_teid_10.presence)
+        length += TLV_HLEN + ie->s2a_u_twan_f_teid_10.len;
+    if (ie->s2a_u_pgw_f_teid.presence)
+        length += TLV_HLEN + ie->s2a_u_pgw_f_teid.len;
+    if (ie->ran_nas_cause.presence)
+        length += TLV_HLEN + ie->ran_nas_cause.len;
+    if (ie->additional_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->additional_protocol_configuration_options.len;
+    if (ie->bss_container.presence)
+        length += TLV_HLEN + ie->bss_container.len;
+    if (ie->transaction_identifier.presence)
+        length += TLV_HLEN + ie->transaction_identifier.len;
+    if (ie->packet_flow_id.presence)
+        length += TLV_HLEN + ie->packet_flow_id.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_bearer_context(uint8_t *pos, ogs_gtp_tlv_bearer_context_t *ie)
+{
+    if (ie->eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->eps_bearer_id);
+    if (ie->tft.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_BEARER_TFT_TYPE, 0, &ie->tft);
+    if (ie->s1_u_enodeb_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->s1_u_enodeb_f_teid);
+    if (ie->s4_u_sgsn_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 1, &ie->s4_u_sgsn_f_teid);
+    if (ie->s5_s8_u_sgw_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 2, &ie->s5_s8_u_sgw_f_teid);
+    if (ie->s5_s8_u_pgw_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 3, &ie->s5_s8_u_pgw_f_teid);
+    if (ie->s12_rnc_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 4, &ie->s12_rnc_f_teid);
+    if (ie->s2b_u_epdg_f_teid_5.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 5, &ie->s2b_u_epdg_f_teid_5);
+    if (ie->s2a_u_twan_f_teid_6.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 6, &ie->s2a_u_twan_f_teid_6);
+    if (ie->bearer_level_qos.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_BEARER_QOS_TYPE, 0, &ie->bearer_level_qos);
+    if (ie->s11_u_mme_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 7, &ie->s11_u_mme_f_teid);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->charging_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHARGING_ID_TYPE, 0, &ie->charging_id);
+    if (ie->bearer_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_BEARER_FLAGS_TYPE, 0, &ie->bearer_flags);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+    if (ie->maximum_packet_loss_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MAXIMUM_PACKET_LOSS_RATE_TYPE, 0, &ie->maximum_packet_loss_rate);
+    if (ie->s2b_u_epdg_f_teid_8.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 8, &ie->s2b_u_epdg_f_teid_8);
+    if (ie->s2b_u_pgw_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 9, &ie->s2b_u_pgw_f_teid);
+    if (ie->s2a_u_twan_f_teid_10.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 10, &ie->s2a_u_twan_f_teid_10);
+    if (ie->s2a_u_pgw_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 11, &ie->s2a_u_pgw_f_teid);
+    if (ie->ran_nas_cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_RAN_NAS_CAUSE_TYPE, 0, &ie->ran_nas_cause);
+    if (ie->additional_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APCO_TYPE, 0, &ie->additional_protocol_configuration_options);
+    if (ie->bss_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->bss_container);
+    if (ie->transaction_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TI_TYPE, 0, &ie->transaction_identifier);
+    if (ie->packet_flow_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PACKET_FLOW_ID_TYPE, 0, &ie->packet_flow_id);
+
+    return pos;
+}
+
+static int tlv_read_bearer_context(ogs_gtp_tlv_bearer_context_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_TFT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->tft, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->s1_u_enodeb_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->s4_u_sgsn_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->s5_s8_u_sgw_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->s5_s8_u_pgw_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 4) {
+                if (ogs_tlv_read_octet(&ie->s12_rnc_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 5) {
+                if (ogs_tlv_read_octet(&ie->s2b_u_epdg_f_teid_5, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 6) {
+                if (ogs_tlv_read_octet(&ie->s2a_u_twan_f_teid_6, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 7) {
+                if (ogs_tlv_read_octet(&ie->s11_u_mme_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 8) {
+                if (ogs_tlv_read_octet(&ie->s2b_u_epdg_f_teid_8, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 9) {
+                if (ogs_tlv_read_octet(&ie->s2b_u_pgw_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 10) {
+                if (ogs_tlv_read_octet(&ie->s2a_u_twan_f_teid_10, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 11) {
+                if (ogs_tlv_read_octet(&ie->s2a_u_pgw_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_QOS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->bearer_level_qos, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHARGING_ID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->charging_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_FLAGS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->bearer_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MAXIMUM_PACKET_LOSS_RATE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->maximum_packet_loss_rate, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RAN_NAS_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ran_nas_cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->additional_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->bss_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->transaction_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PACKET_FLOW_ID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->packet_flow_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_overload_control_information(ogs_gtp_tlv_overload_control_information_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->overload_control_sequence_number.presence)
+        length += TLV_HLEN + ie->overload_control_sequence_number.len;
+    if (ie->overload_reduction_metric.presence)
+        length += TLV_HLEN + ie->overload_reduction_metric.len;
+    if (ie->period_of_validity.presence)
+        length += TLV_HLEN + ie->period_of_validity.len;
+    if (ie->list_of_access_point_name.presence)
+        length += TLV_HLEN + ie->list_of_access_point_name.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_overload_control_information(uint8_t *pos, ogs_gtp_tlv_overload_control_information_t *ie)
+{
+    if (ie->overload_control_sequence_number.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SEQUENCE_NUMBER_TYPE, 0, &ie->overload_control_sequence_number);
+    if (ie->overload_reduction_metric.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_METRIC_TYPE, 0, &ie->overload_reduction_metric);
+    if (ie->period_of_validity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPC_TIMER_TYPE, 0, &ie->period_of_validity);
+    if (ie->list_of_access_point_name.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APN_TYPE, 0, &ie->list_of_access_point_name);
+
+    return pos;
+}
+
+static int tlv_read_overload_control_information(ogs_gtp_tlv_overload_control_information_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_SEQUENCE_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->overload_control_sequence_number, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_METRIC_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->overload_reduction_metric, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPC_TIMER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->period_of_validity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->list_of_access_point_name, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_load_control_information(ogs_gtp_tlv_load_control_information_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->load_control_sequence_number.presence)
+        length += TLV_HLEN + ie->load_control_sequence_number.len;
+    if (ie->load_metric.presence)
+        length += TLV_HLEN + ie->load_metric.len;
+    if (ie->list_of_apn_and_relative_capacity.presence)
+        length += TLV_HLEN + ie->list_of_apn_and_relative_capacity.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_load_control_information(uint8_t *pos, ogs_gtp_tlv_load_control_information_t *ie)
+{
+    if (ie->load_control_sequence_number.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SEQUENCE_NUMBER_TYPE, 0, &ie->load_control_sequence_number);
+    if (ie->load_metric.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_METRIC_TYPE, 0, &ie->load_metric);
+    if (ie->list_of_apn_and_relative_capacity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APN_AND_RELATIVE_CAPACITY_TYPE, 0, &ie->list_of_apn_and_relative_capacity);
+
+    return pos;
+}
+
+static int tlv_read_load_control_information(ogs_gtp_tlv_load_control_information_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_SEQUENCE_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->load_control_sequence_number, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_METRIC_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->load_metric, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_AND_RELATIVE_CAPACITY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->list_of_apn_and_relative_capacity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_echo_request(ogs_gtp_echo_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->sending_node_features.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_echo_request(uint8_t *pos, ogs_gtp_echo_request_t *ie)
+{
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->sending_node_features.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_NODE_FEATURES_TYPE, 0, &ie->sending_node_features);
+
+    return pos;
+}
+
+static int msg_read_echo_request(ogs_gtp_echo_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_NODE_FEATURES_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->sending_node_features, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_echo_response(ogs_gtp_echo_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->sending_node_features.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_echo_response(uint8_t *pos, ogs_gtp_echo_response_t *ie)
+{
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->sending_node_features.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_NODE_FEATURES_TYPE, 0, &ie->sending_node_features);
+
+    return pos;
+}
+
+static int msg_read_echo_response(ogs_gtp_echo_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_NODE_FEATURES_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->sending_node_features, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_create_session_request(ogs_gtp_create_session_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->imsi.presence)
+        length += TLV_HLEN + ie->imsi.len;
+    if (ie->msisdn.presence)
+        length += TLV_HLEN + ie->msisdn.len;
+    if (ie->me_identity.presence)
+        length += TLV_HLEN + ie->me_identity.len;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->serving_network.presence)
+        length += TLV_HLEN + ie->serving_network.len;
+    if (ie->rat_type.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->pgw_s5_s8_address_for_control_plane_or_pmip.presence)
+        length += TLV_HLEN + ie->pgw_s5_s8_address_for_control_plane_or_pmip.len;
+    if (ie->access_point_name.presence)
+        length += TLV_HLEN + ie->access_point_name.len;
+    if (ie->selection_mode.presence)
+        length += TLV_HLEN + 1;
+    if (ie->pdn_type.presence)
+        length += TLV_HLEN + 1;
+    if (ie->pdn_address_allocation.presence)
+        length += TLV_HLEN + ie->pdn_address_allocation.len;
+    if (ie->maximum_apn_restriction.presence)
+        length += TLV_HLEN + 1;
+    if (ie->aggregate_maximum_bit_rate.presence)
+        length += TLV_HLEN + ie->aggregate_maximum_bit_rate.len;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->trusted_wlan_mode_indication.presence)
+        length += TLV_HLEN + ie->trusted_wlan_mode_indication.len;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->bearer_contexts_to_be_created.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_to_be_created);
+    if (ie->bearer_contexts_to_be_removed.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_to_be_removed);
+    if (ie->trace_information.presence)
+        length += TLV_HLEN + ie->trace_information.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->user_csg_information.presence)
+        length += TLV_HLEN + ie->user_csg_information.len;
+    if (ie->charging_characteristics.presence)
+        length += TLV_HLEN + ie->charging_characteristics.len;
+    if (ie->mme_s4_sgsn_ldn.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_ldn.len;
+    if (ie->sgw_ldn.presence)
+        length += TLV_HLEN + ie->sgw_ldn.len;
+    if (ie->epdg_ldn.presence)
+        length += TLV_HLEN + ie->epdg_ldn.len;
+    if (ie->twan_ldn.presence)
+        length += TLV_HLEN + ie->twan_ldn.len;
+    if (ie->signalling_priority_indication.presence)
+        length += TLV_HLEN + ie->signalling_priority_indication.len;
+    if (ie->ue_local_ip_address.presence)
+        length += TLV_HLEN + ie->ue_local_ip_address.len;
+    if (ie->ue_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->additional_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->additional_protocol_configuration_options.len;
+    if (ie->hnb_local_ip_address.presence)
+        length += TLV_HLEN + ie->hnb_local_ip_address.len;
+    if (ie->hnb_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->mme_s4_sgsn_identifier.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_identifier.len;
+    if (ie->twan_identifier.presence)
+        length += TLV_HLEN + ie->twan_identifier.len;
+    if (ie->epdg_ip_address.presence)
+        length += TLV_HLEN + ie->epdg_ip_address.len;
+    if (ie->cn_operator_selection_entity.presence)
+        length += TLV_HLEN + ie->cn_operator_selection_entity.len;
+    if (ie->presence_reporting_area_information.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_information.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->twan_epdg_s_overload_control_information);
+    if (ie->origination_time_stamp.presence)
+        length += TLV_HLEN + ie->origination_time_stamp.len;
+    if (ie->maximum_wait_time.presence)
+        length += TLV_HLEN + ie->maximum_wait_time.len;
+    if (ie->wlan_location_information.presence)
+        length += TLV_HLEN + ie->wlan_location_information.len;
+    if (ie->wlan_location_timestamp.presence)
+        length += TLV_HLEN + ie->wlan_location_timestamp.len;
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->remote_ue_context_connected.presence)
+        length += TLV_HLEN + tlv_length_remote_ue_context(&ie->remote_ue_context_connected);
+    if (ie->_aaa_server_identifier.presence)
+        length += TLV_HLEN + ie->_aaa_server_identifier.len;
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+    if (ie->serving_plmn_rate_control.presence)
+        length += TLV_HLEN + ie->serving_plmn_rate_control.len;
+    if (ie->mo_exception_data_counter.presence)
+        length += TLV_HLEN + ie->mo_exception_data_counter.len;
+    if (ie->ue_tcp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->mapped_ue_usage_type.presence)
+        length += TLV_HLEN + ie->mapped_ue_usage_type.len;
+    if (ie->user_location_information_for_sgw_.presence)
+        length += TLV_HLEN + ie->user_location_information_for_sgw_.len;
+    if (ie->sgw_u_node_name.presence)
+        length += TLV_HLEN + ie->sgw_u_node_name.len;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+    if (ie->up_function_selection_indication_flags.presence)
+        length += TLV_HLEN + ie->up_function_selection_indication_flags.len;
+    if (ie->apn_rate_control_status.presence)
+        length += TLV_HLEN + ie->apn_rate_control_status.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_create_session_request(uint8_t *pos, ogs_gtp_create_session_request_t *ie)
+{
+    if (ie->imsi.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IMSI_TYPE, 0, &ie->imsi);
+    if (ie->msisdn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MSISDN_TYPE, 0, &ie->msisdn);
+    if (ie->me_identity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MEI_TYPE, 0, &ie->me_identity);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->serving_network.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SERVING_NETWORK_TYPE, 0, &ie->serving_network);
+    if (ie->rat_type.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RAT_TYPE_TYPE, 0, &ie->rat_type);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->pgw_s5_s8_address_for_control_plane_or_pmip.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 1, &ie->pgw_s5_s8_address_for_control_plane_or_pmip);
+    if (ie->access_point_name.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APN_TYPE, 0, &ie->access_point_name);
+    if (ie->selection_mode.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_SELECTION_MODE_TYPE, 0, &ie->selection_mode);
+    if (ie->pdn_type.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_PDN_TYPE_TYPE, 0, &ie->pdn_type);
+    if (ie->pdn_address_allocation.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PAA_TYPE, 0, &ie->pdn_address_allocation);
+    if (ie->maximum_apn_restriction.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_APN_RESTRICTION_TYPE, 0, &ie->maximum_apn_restriction);
+    if (ie->aggregate_maximum_bit_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_AMBR_TYPE, 0, &ie->aggregate_maximum_bit_rate);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->trusted_wlan_mode_indication.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWMI_TYPE, 0, &ie->trusted_wlan_mode_indication);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->bearer_contexts_to_be_created.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_to_be_created));
+    if (ie->bearer_contexts_to_be_removed.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 1,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_to_be_removed));
+    if (ie->trace_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TRACE_INFORMATION_TYPE, 0, &ie->trace_information);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 2, &ie->epdg_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 3, &ie->twan_fq_csid);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->user_csg_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UCI_TYPE, 0, &ie->user_csg_information);
+    if (ie->charging_characteristics.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHARGING_CHARACTERISTICS_TYPE, 0, &ie->charging_characteristics);
+    if (ie->mme_s4_sgsn_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 0, &ie->mme_s4_sgsn_ldn);
+    if (ie->sgw_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 1, &ie->sgw_ldn);
+    if (ie->epdg_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 2, &ie->epdg_ldn);
+    if (ie->twan_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 3, &ie->twan_ldn);
+    if (ie->signalling_priority_indication.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SIGNALLING_PRIORITY_INDICATION_TYPE, 0, &ie->signalling_priority_indication);
+    if (ie->ue_local_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->ue_local_ip_address);
+    if (ie->ue_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 0, &ie->ue_udp_port);
+    if (ie->additional_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APCO_TYPE, 0, &ie->additional_protocol_configuration_options);
+    if (ie->hnb_local_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 1, &ie->hnb_local_ip_address);
+    if (ie->hnb_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 1, &ie->hnb_udp_port);
+    if (ie->mme_s4_sgsn_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 2, &ie->mme_s4_sgsn_identifier);
+    if (ie->twan_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 0, &ie->twan_identifier);
+    if (ie->epdg_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 3, &ie->epdg_ip_address);
+    if (ie->cn_operator_selection_entity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CN_OPERATOR_SELECTION_ENTITY_TYPE, 0, &ie->cn_operator_selection_entity);
+    if (ie->presence_reporting_area_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE, 0, &ie->presence_reporting_area_information);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->twan_epdg_s_overload_control_information));
+    if (ie->origination_time_stamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MILLISECOND_TIME_STAMP_TYPE, 0, &ie->origination_time_stamp);
+    if (ie->maximum_wait_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INTEGER_NUMBER_TYPE, 0, &ie->maximum_wait_time);
+    if (ie->wlan_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 1, &ie->wlan_location_information);
+    if (ie->wlan_location_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 0, &ie->wlan_location_timestamp);
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->remote_ue_context_connected.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_REMOTE_UE_CONTEXT_TYPE, 0,
+                tlv_write_remote_ue_context(pos + TLV_HLEN, &ie->remote_ue_context_connected));
+    if (ie->_aaa_server_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_NODE_IDENTIFIER_TYPE, 0, &ie->_aaa_server_identifier);
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+    if (ie->serving_plmn_rate_control.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SERVING_PLMN_RATE_CONTROL_TYPE, 0, &ie->serving_plmn_rate_control);
+    if (ie->mo_exception_data_counter.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_COUNTER_TYPE, 0, &ie->mo_exception_data_counter);
+    if (ie->ue_tcp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 2, &ie->ue_tcp_port);
+    if (ie->mapped_ue_usage_type.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MAPPED_UE_USAGE_TYPE_TYPE, 0, &ie->mapped_ue_usage_type);
+    if (ie->user_location_information_for_sgw_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 1, &ie->user_location_information_for_sgw_);
+    if (ie->sgw_u_node_name.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQDN_TYPE, 0, &ie->sgw_u_node_name);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+    if (ie->up_function_selection_indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UP_FUNCTION_SELECTION_INDICATION_FLAGS_TYPE, 0, &ie->up_function_selection_indication_flags);
+    if (ie->apn_rate_control_status.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APN_RATE_CONTROL_STATUS_TYPE, 0, &ie->apn_rate_control_status);
+
+    return pos;
+}
+
+static int msg_read_create_session_request(ogs_gtp_create_session_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_IMSI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->imsi, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MSISDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->msisdn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MEI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->me_identity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->user_location_information_for_sgw_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SERVING_NETWORK_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->serving_network, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RAT_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->rat_type, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->pgw_s5_s8_address_for_control_plane_or_pmip, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->access_point_name, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SELECTION_MODE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->selection_mode, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PDN_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->pdn_type, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PAA_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pdn_address_allocation, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_RESTRICTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->maximum_apn_restriction, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_AMBR_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->aggregate_maximum_bit_rate, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWMI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->trusted_wlan_mode_indication, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_to_be_created, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_to_be_created.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_to_be_removed, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_to_be_removed.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TRACE_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->trace_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->epdg_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->twan_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UCI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_csg_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHARGING_CHARACTERISTICS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->charging_characteristics, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->epdg_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->twan_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SIGNALLING_PRIORITY_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->signalling_priority_indication, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_local_ip_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->hnb_local_ip_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->epdg_ip_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PORT_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint16(&ie->ue_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint16(&ie->hnb_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_uint16(&ie->ue_tcp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->additional_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CN_OPERATOR_SELECTION_ENTITY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cn_operator_selection_entity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->twan_epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->twan_epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MILLISECOND_TIME_STAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->origination_time_stamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INTEGER_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->maximum_wait_time, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_REMOTE_UE_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_remote_ue_context(&ie->remote_ue_context_connected, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->remote_ue_context_connected.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_NODE_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->_aaa_server_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SERVING_PLMN_RATE_CONTROL_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->serving_plmn_rate_control, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_COUNTER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mo_exception_data_counter, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MAPPED_UE_USAGE_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mapped_ue_usage_type, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sgw_u_node_name, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UP_FUNCTION_SELECTION_INDICATION_FLAGS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->up_function_selection_indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_RATE_CONTROL_STATUS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->apn_rate_control_status, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_create_session_response(ogs_gtp_create_session_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->change_reporting_action_.presence)
+        length += TLV_HLEN + ie->change_reporting_action_.len;
+    if (ie->csg_information_reporting_action.presence)
+        length += TLV_HLEN + ie->csg_information_reporting_action.len;
+    if (ie->hnb_information_reporting.presence)
+        length += TLV_HLEN + ie->hnb_information_reporting.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->pgw_s5_s8__s2a_s2b_f_teid_for_pmip_based_interface_or_for_gtp_based_control_plane_interface.presence)
+        length += TLV_HLEN + ie->pgw_s5_s8__s2a_s2b_f_teid_for_pmip_based_interface_or_for_gtp_based_control_plane_interface.len;
+    if (ie->pdn_address_allocation.presence)
+        length += TLV_HLEN + ie->pdn_address_allocation.len;
+    if (ie->apn_restriction.presence)
+        length += TLV_HLEN + 1;
+    if (ie->aggregate_maximum_bit_rate.presence)
+        length += TLV_HLEN + ie->aggregate_maximum_bit_rate.len;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->bearer_contexts_created.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_created);
+    if (ie->bearer_contexts_marked_for_removal.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_marked_for_removal);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->charging_gateway_name.presence)
+        length += TLV_HLEN + ie->charging_gateway_name.len;
+    if (ie->charging_gateway_address.presence)
+        length += TLV_HLEN + ie->charging_gateway_address.len;
+    if (ie->pgw_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->sgw_ldn.presence)
+        length += TLV_HLEN + ie->sgw_ldn.len;
+    if (ie->pgw_ldn.presence)
+        length += TLV_HLEN + ie->pgw_ldn.len;
+    if (ie->pgw_back_off_time.presence)
+        length += TLV_HLEN + ie->pgw_back_off_time.len;
+    if (ie->additional_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->additional_protocol_configuration_options.len;
+    if (ie->trusted_wlan_ipv4_parameters_.presence)
+        length += TLV_HLEN + ie->trusted_wlan_ipv4_parameters_.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->presence_reporting_area_action.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_action.len;
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_node_level_load_control_information);
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_apn_level_load_control_information);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->pdn_connection_charging_id.presence)
+        length += TLV_HLEN + ie->pdn_connection_charging_id.len;
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_create_session_response(uint8_t *pos, ogs_gtp_create_session_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->change_reporting_action_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHANGE_REPORTING_ACTION_TYPE, 0, &ie->change_reporting_action_);
+    if (ie->csg_information_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE, 0, &ie->csg_information_reporting_action);
+    if (ie->hnb_information_reporting.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ENB_INFORMATION_REPORTING_TYPE, 0, &ie->hnb_information_reporting);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->pgw_s5_s8__s2a_s2b_f_teid_for_pmip_based_interface_or_for_gtp_based_control_plane_interface.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 1, &ie->pgw_s5_s8__s2a_s2b_f_teid_for_pmip_based_interface_or_for_gtp_based_control_plane_interface);
+    if (ie->pdn_address_allocation.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PAA_TYPE, 0, &ie->pdn_address_allocation);
+    if (ie->apn_restriction.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_APN_RESTRICTION_TYPE, 0, &ie->apn_restriction);
+    if (ie->aggregate_maximum_bit_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_AMBR_TYPE, 0, &ie->aggregate_maximum_bit_rate);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->bearer_contexts_created.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_created));
+    if (ie->bearer_contexts_marked_for_removal.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 1,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_marked_for_removal));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->charging_gateway_name.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQDN_TYPE, 0, &ie->charging_gateway_name);
+    if (ie->charging_gateway_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->charging_gateway_address);
+    if (ie->pgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->pgw_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->sgw_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 0, &ie->sgw_ldn);
+    if (ie->pgw_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 1, &ie->pgw_ldn);
+    if (ie->pgw_back_off_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPC_TIMER_TYPE, 0, &ie->pgw_back_off_time);
+    if (ie->additional_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APCO_TYPE, 0, &ie->additional_protocol_configuration_options);
+    if (ie->trusted_wlan_ipv4_parameters_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP4CP_TYPE, 0, &ie->trusted_wlan_ipv4_parameters_);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->presence_reporting_area_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE, 0, &ie->presence_reporting_area_action);
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_node_level_load_control_information));
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_apn_level_load_control_information));
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->pdn_connection_charging_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHARGING_ID_TYPE, 0, &ie->pdn_connection_charging_id);
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+
+    return pos;
+}
+
+static int msg_read_create_session_response(ogs_gtp_create_session_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHANGE_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->change_reporting_action_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->csg_information_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ENB_INFORMATION_REPORTING_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->hnb_information_reporting, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->pgw_s5_s8__s2a_s2b_f_teid_for_pmip_based_interface_or_for_gtp_based_control_plane_interface, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PAA_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pdn_address_allocation, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_RESTRICTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->apn_restriction, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_AMBR_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->aggregate_maximum_bit_rate, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_created, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_created.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_marked_for_removal, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_marked_for_removal.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->charging_gateway_name, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->charging_gateway_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sgw_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->pgw_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPC_TIMER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pgw_back_off_time, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->additional_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP4CP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->trusted_wlan_ipv4_parameters_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->pgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_node_level_load_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_load_control_information(&ie->pgw_s_apn_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_apn_level_load_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHARGING_ID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pdn_connection_charging_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_modify_bearer_request(ogs_gtp_modify_bearer_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->me_identity.presence)
+        length += TLV_HLEN + ie->me_identity.len;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->serving_network.presence)
+        length += TLV_HLEN + ie->serving_network.len;
+    if (ie->rat_type.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->aggregate_maximum_bit_rate.presence)
+        length += TLV_HLEN + ie->aggregate_maximum_bit_rate.len;
+    if (ie->delay_downlink_packet_notification_request.presence)
+        length += TLV_HLEN + ie->delay_downlink_packet_notification_request.len;
+    if (ie->bearer_contexts_to_be_modified.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_to_be_modified);
+    if (ie->bearer_contexts_to_be_removed.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_to_be_removed);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->user_csg_information.presence)
+        length += TLV_HLEN + ie->user_csg_information.len;
+    if (ie->ue_local_ip_address.presence)
+        length += TLV_HLEN + ie->ue_local_ip_address.len;
+    if (ie->ue_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->mme_s4_sgsn_ldn.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_ldn.len;
+    if (ie->sgw_ldn.presence)
+        length += TLV_HLEN + ie->sgw_ldn.len;
+    if (ie->hnb_local_ip_address.presence)
+        length += TLV_HLEN + ie->hnb_local_ip_address.len;
+    if (ie->hnb_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->mme_s4_sgsn_identifier.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_identifier.len;
+    if (ie->cn_operator_selection_entity.presence)
+        length += TLV_HLEN + ie->cn_operator_selection_entity.len;
+    if (ie->presence_reporting_area_information.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_information.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->epdg_s_overload_control_information);
+    if (ie->serving_plmn_rate_control.presence)
+        length += TLV_HLEN + ie->serving_plmn_rate_control.len;
+    if (ie->mo_exception_data_counter.presence)
+        length += TLV_HLEN + ie->mo_exception_data_counter.len;
+    if (ie->imsi.presence)
+        length += TLV_HLEN + ie->imsi.len;
+    if (ie->user_location_information_for_sgw_.presence)
+        length += TLV_HLEN + ie->user_location_information_for_sgw_.len;
+    if (ie->wlan_location_information.presence)
+        length += TLV_HLEN + ie->wlan_location_information.len;
+    if (ie->wlan_location_timestamp.presence)
+        length += TLV_HLEN + ie->wlan_location_timestamp.len;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_modify_bearer_request(uint8_t *pos, ogs_gtp_modify_bearer_request_t *ie)
+{
+    if (ie->me_identity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MEI_TYPE, 0, &ie->me_identity);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->serving_network.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SERVING_NETWORK_TYPE, 0, &ie->serving_network);
+    if (ie->rat_type.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RAT_TYPE_TYPE, 0, &ie->rat_type);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->aggregate_maximum_bit_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_AMBR_TYPE, 0, &ie->aggregate_maximum_bit_rate);
+    if (ie->delay_downlink_packet_notification_request.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_DELAY_VALUE_TYPE, 0, &ie->delay_downlink_packet_notification_request);
+    if (ie->bearer_contexts_to_be_modified.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_to_be_modified));
+    if (ie->bearer_contexts_to_be_removed.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 1,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_to_be_removed));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->user_csg_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UCI_TYPE, 0, &ie->user_csg_information);
+    if (ie->ue_local_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 1, &ie->ue_local_ip_address);
+    if (ie->ue_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 1, &ie->ue_udp_port);
+    if (ie->mme_s4_sgsn_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 0, &ie->mme_s4_sgsn_ldn);
+    if (ie->sgw_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 1, &ie->sgw_ldn);
+    if (ie->hnb_local_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->hnb_local_ip_address);
+    if (ie->hnb_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 0, &ie->hnb_udp_port);
+    if (ie->mme_s4_sgsn_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 2, &ie->mme_s4_sgsn_identifier);
+    if (ie->cn_operator_selection_entity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CN_OPERATOR_SELECTION_ENTITY_TYPE, 0, &ie->cn_operator_selection_entity);
+    if (ie->presence_reporting_area_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE, 0, &ie->presence_reporting_area_information);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->epdg_s_overload_control_information));
+    if (ie->serving_plmn_rate_control.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SERVING_PLMN_RATE_CONTROL_TYPE, 0, &ie->serving_plmn_rate_control);
+    if (ie->mo_exception_data_counter.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_COUNTER_TYPE, 0, &ie->mo_exception_data_counter);
+    if (ie->imsi.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IMSI_TYPE, 0, &ie->imsi);
+    if (ie->user_location_information_for_sgw_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 1, &ie->user_location_information_for_sgw_);
+    if (ie->wlan_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 0, &ie->wlan_location_information);
+    if (ie->wlan_location_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 0, &ie->wlan_location_timestamp);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+
+    return pos;
+}
+
+static int msg_read_modify_bearer_request(ogs_gtp_modify_bearer_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_MEI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->me_identity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->user_location_information_for_sgw_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SERVING_NETWORK_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->serving_network, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RAT_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->rat_type, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_AMBR_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->aggregate_maximum_bit_rate, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_DELAY_VALUE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->delay_downlink_packet_notification_request, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_to_be_modified, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_to_be_modified.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_to_be_removed, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_to_be_removed.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UCI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_csg_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->ue_local_ip_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->hnb_local_ip_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PORT_NUMBER_TYPE:
+            if (instance == 1) {
+                if (ogs_tlv_read_uint16(&ie->ue_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 0) {
+                if (ogs_tlv_read_uint16(&ie->hnb_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CN_OPERATOR_SELECTION_ENTITY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cn_operator_selection_entity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SERVING_PLMN_RATE_CONTROL_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->serving_plmn_rate_control, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_COUNTER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mo_exception_data_counter, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IMSI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->imsi, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_modify_bearer_response(ogs_gtp_modify_bearer_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->msisdn.presence)
+        length += TLV_HLEN + ie->msisdn.len;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->apn_restriction.presence)
+        length += TLV_HLEN + 1;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->bearer_contexts_modified.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_modified);
+    if (ie->bearer_contexts_marked_for_removal.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_marked_for_removal);
+    if (ie->change_reporting_action.presence)
+        length += TLV_HLEN + ie->change_reporting_action.len;
+    if (ie->csg_information_reporting_action.presence)
+        length += TLV_HLEN + ie->csg_information_reporting_action.len;
+    if (ie->hnb_information_reporting_.presence)
+        length += TLV_HLEN + ie->hnb_information_reporting_.len;
+    if (ie->charging_gateway_name.presence)
+        length += TLV_HLEN + ie->charging_gateway_name.len;
+    if (ie->charging_gateway_address.presence)
+        length += TLV_HLEN + ie->charging_gateway_address.len;
+    if (ie->pgw_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->sgw_ldn.presence)
+        length += TLV_HLEN + ie->sgw_ldn.len;
+    if (ie->pgw_ldn.presence)
+        length += TLV_HLEN + ie->pgw_ldn.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->presence_reporting_area_action.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_action.len;
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_node_level_load_control_information);
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_apn_level_load_control_information);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->pdn_connection_charging_id.presence)
+        length += TLV_HLEN + ie->pdn_connection_charging_id.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_modify_bearer_response(uint8_t *pos, ogs_gtp_modify_bearer_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->msisdn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MSISDN_TYPE, 0, &ie->msisdn);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->apn_restriction.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_APN_RESTRICTION_TYPE, 0, &ie->apn_restriction);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->bearer_contexts_modified.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_modified));
+    if (ie->bearer_contexts_marked_for_removal.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 1,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_marked_for_removal));
+    if (ie->change_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHANGE_REPORTING_ACTION_TYPE, 0, &ie->change_reporting_action);
+    if (ie->csg_information_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE, 0, &ie->csg_information_reporting_action);
+    if (ie->hnb_information_reporting_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ENB_INFORMATION_REPORTING_TYPE, 0, &ie->hnb_information_reporting_);
+    if (ie->charging_gateway_name.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQDN_TYPE, 0, &ie->charging_gateway_name);
+    if (ie->charging_gateway_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->charging_gateway_address);
+    if (ie->pgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->pgw_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->sgw_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 0, &ie->sgw_ldn);
+    if (ie->pgw_ldn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_LDN_TYPE, 1, &ie->pgw_ldn);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->presence_reporting_area_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE, 0, &ie->presence_reporting_area_action);
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_node_level_load_control_information));
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_apn_level_load_control_information));
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->pdn_connection_charging_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHARGING_ID_TYPE, 0, &ie->pdn_connection_charging_id);
+
+    return pos;
+}
+
+static int msg_read_modify_bearer_response(ogs_gtp_modify_bearer_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MSISDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->msisdn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_RESTRICTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->apn_restriction, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_modified, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_modified.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_marked_for_removal, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_marked_for_removal.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHANGE_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->change_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->csg_information_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ENB_INFORMATION_REPORTING_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->hnb_information_reporting_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->charging_gateway_name, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->charging_gateway_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LDN_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sgw_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->pgw_ldn, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->pgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_node_level_load_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_load_control_information(&ie->pgw_s_apn_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_apn_level_load_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHARGING_ID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pdn_connection_charging_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_session_request(ogs_gtp_delete_session_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->originating_node.presence)
+        length += TLV_HLEN + 1;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->uli_timestamp.presence)
+        length += TLV_HLEN + ie->uli_timestamp.len;
+    if (ie->ran_nas_release_cause.presence)
+        length += TLV_HLEN + ie->ran_nas_release_cause.len;
+    if (ie->twan_identifier.presence)
+        length += TLV_HLEN + ie->twan_identifier.len;
+    if (ie->twan_identifier_timestamp.presence)
+        length += TLV_HLEN + ie->twan_identifier_timestamp.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->twan_epdg_s_overload_control_information);
+    if (ie->wlan_location_information.presence)
+        length += TLV_HLEN + ie->wlan_location_information.len;
+    if (ie->wlan_location_timestamp.presence)
+        length += TLV_HLEN + ie->wlan_location_timestamp.len;
+    if (ie->ue_local_ip_address.presence)
+        length += TLV_HLEN + ie->ue_local_ip_address.len;
+    if (ie->ue_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+    if (ie->ue_tcp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_session_request(uint8_t *pos, ogs_gtp_delete_session_request_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->originating_node.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_NODE_TYPE_TYPE, 0, &ie->originating_node);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->uli_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TIMESTAMP_TYPE, 0, &ie->uli_timestamp);
+    if (ie->ran_nas_release_cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_RAN_NAS_CAUSE_TYPE, 0, &ie->ran_nas_release_cause);
+    if (ie->twan_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 0, &ie->twan_identifier);
+    if (ie->twan_identifier_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 0, &ie->twan_identifier_timestamp);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->twan_epdg_s_overload_control_information));
+    if (ie->wlan_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 1, &ie->wlan_location_information);
+    if (ie->wlan_location_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 1, &ie->wlan_location_timestamp);
+    if (ie->ue_local_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->ue_local_ip_address);
+    if (ie->ue_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 0, &ie->ue_udp_port);
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+    if (ie->ue_tcp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 1, &ie->ue_tcp_port);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+
+    return pos;
+}
+
+static int msg_read_delete_session_request(ogs_gtp_delete_session_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_NODE_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->originating_node, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->uli_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RAN_NAS_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ran_nas_release_cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->twan_epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->twan_epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_local_ip_address, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PORT_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint16(&ie->ue_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint16(&ie->ue_tcp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_session_response(ogs_gtp_delete_session_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_node_level_load_control_information);
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_apn_level_load_control_information);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+    if (ie->apn_rate_control_status.presence)
+        length += TLV_HLEN + ie->apn_rate_control_status.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_session_response(uint8_t *pos, ogs_gtp_delete_session_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_node_level_load_control_information));
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_apn_level_load_control_information));
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+    if (ie->apn_rate_control_status.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APN_RATE_CONTROL_STATUS_TYPE, 0, &ie->apn_rate_control_status);
+
+    return pos;
+}
+
+static int msg_read_delete_session_response(ogs_gtp_delete_session_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->pgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_node_level_load_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_load_control_information(&ie->pgw_s_apn_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_apn_level_load_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_RATE_CONTROL_STATUS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->apn_rate_control_status, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_modify_bearer_command(ogs_gtp_modify_bearer_command_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->apn_aggregate_maximum_bit_rate.presence)
+        length += TLV_HLEN + ie->apn_aggregate_maximum_bit_rate.len;
+    if (ie->bearer_context.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_context);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->twan_epdg_s_overload_control_information);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_modify_bearer_command(uint8_t *pos, ogs_gtp_modify_bearer_command_t *ie)
+{
+    if (ie->apn_aggregate_maximum_bit_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_AMBR_TYPE, 0, &ie->apn_aggregate_maximum_bit_rate);
+    if (ie->bearer_context.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_context));
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->twan_epdg_s_overload_control_information));
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+
+    return pos;
+}
+
+static int msg_read_modify_bearer_command(ogs_gtp_modify_bearer_command_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_AMBR_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->apn_aggregate_maximum_bit_rate, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_context, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_context.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->twan_epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->twan_epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_modify_bearer_failure_indication(ogs_gtp_modify_bearer_failure_indication_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+
+    return length;
+}
+
+static uint8_t *msg_write_modify_bearer_failure_indication(uint8_t *pos, ogs_gtp_modify_bearer_failure_indication_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+
+    return pos;
+}
+
+static int msg_read_modify_bearer_failure_indication(ogs_gtp_modify_bearer_failure_indication_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_bearer_command(ogs_gtp_delete_bearer_command_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts);
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->uli_timestamp.presence)
+        length += TLV_HLEN + ie->uli_timestamp.len;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_bearer_command(uint8_t *pos, ogs_gtp_delete_bearer_command_t *ie)
+{
+    if (ie->bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts));
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->uli_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TIMESTAMP_TYPE, 0, &ie->uli_timestamp);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+
+    return pos;
+}
+
+static int msg_read_delete_bearer_command(ogs_gtp_delete_bearer_command_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->uli_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_bearer_failure_indication(ogs_gtp_delete_bearer_failure_indication_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->bearer_context.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_context);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_bearer_failure_indication(uint8_t *pos, ogs_gtp_delete_bearer_failure_indication_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->bearer_context.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_context));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+
+    return pos;
+}
+
+static int msg_read_delete_bearer_failure_indication(ogs_gtp_delete_bearer_failure_indication_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_context, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_context.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_bearer_resource_command(ogs_gtp_bearer_resource_command_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->procedure_transaction_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->flow_quality_of_service.presence)
+        length += TLV_HLEN + ie->flow_quality_of_service.len;
+    if (ie->traffic_aggregate_description.presence)
+        length += TLV_HLEN + ie->traffic_aggregate_description.len;
+    if (ie->rat_type.presence)
+        length += TLV_HLEN + 1;
+    if (ie->serving_network.presence)
+        length += TLV_HLEN + ie->serving_network.len;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->s4_u_sgsn_f_teid.presence)
+        length += TLV_HLEN + ie->s4_u_sgsn_f_teid.len;
+    if (ie->s12_rnc_f_teid.presence)
+        length += TLV_HLEN + ie->s12_rnc_f_teid.len;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->signalling_priority_indication__.presence)
+        length += TLV_HLEN + ie->signalling_priority_indication__.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_bearer_resource_command(uint8_t *pos, ogs_gtp_bearer_resource_command_t *ie)
+{
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->procedure_transaction_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_PTI_TYPE, 0, &ie->procedure_transaction_id);
+    if (ie->flow_quality_of_service.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FLOW_QOS_TYPE, 0, &ie->flow_quality_of_service);
+    if (ie->traffic_aggregate_description.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TAD_TYPE, 0, &ie->traffic_aggregate_description);
+    if (ie->rat_type.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RAT_TYPE_TYPE, 0, &ie->rat_type);
+    if (ie->serving_network.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SERVING_NETWORK_TYPE, 0, &ie->serving_network);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 1, &ie->eps_bearer_id);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->s4_u_sgsn_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->s4_u_sgsn_f_teid);
+    if (ie->s12_rnc_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 1, &ie->s12_rnc_f_teid);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->signalling_priority_indication__.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SIGNALLING_PRIORITY_INDICATION_TYPE, 0, &ie->signalling_priority_indication__);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 2, &ie->sender_f_teid_for_control_plane);
+
+    return pos;
+}
+
+static int msg_read_bearer_resource_command(ogs_gtp_bearer_resource_command_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint8(&ie->eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PTI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->procedure_transaction_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FLOW_QOS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->flow_quality_of_service, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TAD_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->traffic_aggregate_description, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RAT_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->rat_type, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SERVING_NETWORK_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->serving_network, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->s4_u_sgsn_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->s12_rnc_f_teid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SIGNALLING_PRIORITY_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->signalling_priority_indication__, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_bearer_resource_failure_indication(ogs_gtp_bearer_resource_failure_indication_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->procedure_transaction_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_bearer_resource_failure_indication(uint8_t *pos, ogs_gtp_bearer_resource_failure_indication_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->procedure_transaction_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_PTI_TYPE, 0, &ie->procedure_transaction_id);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+
+    return pos;
+}
+
+static int msg_read_bearer_resource_failure_indication(ogs_gtp_bearer_resource_failure_indication_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PTI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->procedure_transaction_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_downlink_data_notification_failure_indication(ogs_gtp_downlink_data_notification_failure_indication_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->originating_node.presence)
+        length += TLV_HLEN + 1;
+    if (ie->imsi.presence)
+        length += TLV_HLEN + ie->imsi.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_downlink_data_notification_failure_indication(uint8_t *pos, ogs_gtp_downlink_data_notification_failure_indication_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->originating_node.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_NODE_TYPE_TYPE, 0, &ie->originating_node);
+    if (ie->imsi.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IMSI_TYPE, 0, &ie->imsi);
+
+    return pos;
+}
+
+static int msg_read_downlink_data_notification_failure_indication(ogs_gtp_downlink_data_notification_failure_indication_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_NODE_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->originating_node, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IMSI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->imsi, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_create_bearer_request(ogs_gtp_create_bearer_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->procedure_transaction_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts);
+    if (ie->pgw_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->change_reporting_action.presence)
+        length += TLV_HLEN + ie->change_reporting_action.len;
+    if (ie->csg_information_reporting_action.presence)
+        length += TLV_HLEN + ie->csg_information_reporting_action.len;
+    if (ie->hnb_information_reporting.presence)
+        length += TLV_HLEN + ie->hnb_information_reporting.len;
+    if (ie->presence_reporting_area_action.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_action.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_node_level_load_control_information);
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_apn_level_load_control_information);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_create_bearer_request(uint8_t *pos, ogs_gtp_create_bearer_request_t *ie)
+{
+    if (ie->procedure_transaction_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_PTI_TYPE, 0, &ie->procedure_transaction_id);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts));
+    if (ie->pgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->pgw_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->change_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHANGE_REPORTING_ACTION_TYPE, 0, &ie->change_reporting_action);
+    if (ie->csg_information_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE, 0, &ie->csg_information_reporting_action);
+    if (ie->hnb_information_reporting.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ENB_INFORMATION_REPORTING_TYPE, 0, &ie->hnb_information_reporting);
+    if (ie->presence_reporting_area_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE, 0, &ie->presence_reporting_area_action);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_node_level_load_control_information));
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_apn_level_load_control_information));
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+
+    return pos;
+}
+
+static int msg_read_create_bearer_request(ogs_gtp_create_bearer_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_PTI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->procedure_transaction_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHANGE_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->change_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->csg_information_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ENB_INFORMATION_REPORTING_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->hnb_information_reporting, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->pgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_node_level_load_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_load_control_information(&ie->pgw_s_apn_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_apn_level_load_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_create_bearer_response(ogs_gtp_create_bearer_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->twan_identifier.presence)
+        length += TLV_HLEN + ie->twan_identifier.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->presence_reporting_area_information.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_information.len;
+    if (ie->mme_s4_sgsn_identifier.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_identifier.len;
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->twan_epdg_s_overload_control_information);
+    if (ie->wlan_location_information.presence)
+        length += TLV_HLEN + ie->wlan_location_information.len;
+    if (ie->wlan_location_timestamp.presence)
+        length += TLV_HLEN + ie->wlan_location_timestamp.len;
+    if (ie->ue_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->ue_tcp_port.presence)
+        length += TLV_HLEN + 2;
+
+    return length;
+}
+
+static uint8_t *msg_write_create_bearer_response(uint8_t *pos, ogs_gtp_create_bearer_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 2, &ie->epdg_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 3, &ie->twan_fq_csid);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->twan_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 0, &ie->twan_identifier);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->presence_reporting_area_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE, 0, &ie->presence_reporting_area_information);
+    if (ie->mme_s4_sgsn_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->mme_s4_sgsn_identifier);
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->twan_epdg_s_overload_control_information));
+    if (ie->wlan_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 1, &ie->wlan_location_information);
+    if (ie->wlan_location_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 1, &ie->wlan_location_timestamp);
+    if (ie->ue_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 0, &ie->ue_udp_port);
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->ue_tcp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 1, &ie->ue_tcp_port);
+
+    return pos;
+}
+
+static int msg_read_create_bearer_response(ogs_gtp_create_bearer_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->epdg_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->twan_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->twan_epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->twan_epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE:
+            if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PORT_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint16(&ie->ue_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint16(&ie->ue_tcp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_update_bearer_request(ogs_gtp_update_bearer_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts);
+    if (ie->procedure_transaction_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->aggregate_maximum_bit_rate.presence)
+        length += TLV_HLEN + ie->aggregate_maximum_bit_rate.len;
+    if (ie->change_reporting_action.presence)
+        length += TLV_HLEN + ie->change_reporting_action.len;
+    if (ie->csg_information_reporting_action.presence)
+        length += TLV_HLEN + ie->csg_information_reporting_action.len;
+    if (ie->hnb_information_reporting_.presence)
+        length += TLV_HLEN + ie->hnb_information_reporting_.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->presence_reporting_area_action.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_action.len;
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_node_level_load_control_information);
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_apn_level_load_control_information);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_update_bearer_request(uint8_t *pos, ogs_gtp_update_bearer_request_t *ie)
+{
+    if (ie->bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts));
+    if (ie->procedure_transaction_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_PTI_TYPE, 0, &ie->procedure_transaction_id);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->aggregate_maximum_bit_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_AMBR_TYPE, 0, &ie->aggregate_maximum_bit_rate);
+    if (ie->change_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CHANGE_REPORTING_ACTION_TYPE, 0, &ie->change_reporting_action);
+    if (ie->csg_information_reporting_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE, 0, &ie->csg_information_reporting_action);
+    if (ie->hnb_information_reporting_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ENB_INFORMATION_REPORTING_TYPE, 0, &ie->hnb_information_reporting_);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->pgw_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->presence_reporting_area_action.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE, 0, &ie->presence_reporting_area_action);
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_node_level_load_control_information));
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_apn_level_load_control_information));
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+
+    return pos;
+}
+
+static int msg_read_update_bearer_request(ogs_gtp_update_bearer_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PTI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->procedure_transaction_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_AMBR_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->aggregate_maximum_bit_rate, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CHANGE_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->change_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CSG_INFORMATION_REPORTING_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->csg_information_reporting_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ENB_INFORMATION_REPORTING_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->hnb_information_reporting_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_ACTION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_action, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->pgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_node_level_load_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_load_control_information(&ie->pgw_s_apn_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_apn_level_load_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_update_bearer_response(ogs_gtp_update_bearer_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts);
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->twan_identifier.presence)
+        length += TLV_HLEN + ie->twan_identifier.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->presence_reporting_area_information.presence)
+        length += TLV_HLEN + ie->presence_reporting_area_information.len;
+    if (ie->mme_s4_sgsn_identifier.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_identifier.len;
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->twan_epdg_s_overload_control_information);
+    if (ie->wlan_location_information.presence)
+        length += TLV_HLEN + ie->wlan_location_information.len;
+    if (ie->wlan_location_timestamp.presence)
+        length += TLV_HLEN + ie->wlan_location_timestamp.len;
+    if (ie->ue_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->ue_tcp_port.presence)
+        length += TLV_HLEN + 2;
+
+    return length;
+}
+
+static uint8_t *msg_write_update_bearer_response(uint8_t *pos, ogs_gtp_update_bearer_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts));
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 2, &ie->epdg_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 3, &ie->twan_fq_csid);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->twan_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 0, &ie->twan_identifier);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->presence_reporting_area_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE, 0, &ie->presence_reporting_area_information);
+    if (ie->mme_s4_sgsn_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->mme_s4_sgsn_identifier);
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->twan_epdg_s_overload_control_information));
+    if (ie->wlan_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 1, &ie->wlan_location_information);
+    if (ie->wlan_location_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 1, &ie->wlan_location_timestamp);
+    if (ie->ue_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 0, &ie->ue_udp_port);
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->ue_tcp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 1, &ie->ue_tcp_port);
+
+    return pos;
+}
+
+static int msg_read_update_bearer_response(ogs_gtp_update_bearer_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->epdg_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->twan_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->twan_epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->twan_epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PRESENCE_REPORTING_AREA_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->presence_reporting_area_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE:
+            if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PORT_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint16(&ie->ue_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint16(&ie->ue_tcp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_bearer_request(ogs_gtp_delete_bearer_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->eps_bearer_ids.presence)
+        length += TLV_HLEN + 1;
+    if (ie->failed_bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->failed_bearer_contexts);
+    if (ie->procedure_transaction_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->pgw_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_node_level_load_control_information);
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->pgw_s_apn_level_load_control_information);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->pgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->pgw_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->apn_rate_control_status.presence)
+        length += TLV_HLEN + ie->apn_rate_control_status.len;
+    if (ie->extended_protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->extended_protocol_configuration_options.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_bearer_request(uint8_t *pos, ogs_gtp_delete_bearer_request_t *ie)
+{
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->eps_bearer_ids.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 1, &ie->eps_bearer_ids);
+    if (ie->failed_bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->failed_bearer_contexts));
+    if (ie->procedure_transaction_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_PTI_TYPE, 0, &ie->procedure_transaction_id);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->pgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->pgw_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->pgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_node_level_load_control_information));
+    if (ie->pgw_s_apn_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->pgw_s_apn_level_load_control_information));
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->pgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->pgw_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->apn_rate_control_status.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_APN_RATE_CONTROL_STATUS_TYPE, 0, &ie->apn_rate_control_status);
+    if (ie->extended_protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPCO_TYPE, 0, &ie->extended_protocol_configuration_options);
+
+    return pos;
+}
+
+static int msg_read_delete_bearer_request(ogs_gtp_delete_bearer_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint8(&ie->eps_bearer_ids, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->failed_bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->failed_bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PTI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->procedure_transaction_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->pgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->pgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_node_level_load_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_load_control_information(&ie->pgw_s_apn_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_apn_level_load_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->pgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->pgw_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_APN_RATE_CONTROL_STATUS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->apn_rate_control_status, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->extended_protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_bearer_response(ogs_gtp_delete_bearer_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->linked_eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->bearer_contexts.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->sgw_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->protocol_configuration_options.presence)
+        length += TLV_HLEN + ie->protocol_configuration_options.len;
+    if (ie->ue_time_zone.presence)
+        length += TLV_HLEN + ie->ue_time_zone.len;
+    if (ie->user_location_information.presence)
+        length += TLV_HLEN + ie->user_location_information.len;
+    if (ie->uli_timestamp.presence)
+        length += TLV_HLEN + ie->uli_timestamp.len;
+    if (ie->twan_identifier.presence)
+        length += TLV_HLEN + ie->twan_identifier.len;
+    if (ie->twan_identifier_timestamp.presence)
+        length += TLV_HLEN + ie->twan_identifier_timestamp.len;
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->mme_s4_sgsn_identifier.presence)
+        length += TLV_HLEN + ie->mme_s4_sgsn_identifier.len;
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->twan_epdg_s_overload_control_information);
+    if (ie->wlan_location_information.presence)
+        length += TLV_HLEN + ie->wlan_location_information.len;
+    if (ie->wlan_location_timestamp.presence)
+        length += TLV_HLEN + ie->wlan_location_timestamp.len;
+    if (ie->ue_udp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->nbifom_container.presence)
+        length += TLV_HLEN + ie->nbifom_container.len;
+    if (ie->ue_tcp_port.presence)
+        length += TLV_HLEN + 2;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_bearer_response(uint8_t *pos, ogs_gtp_delete_bearer_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->linked_eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->linked_eps_bearer_id);
+    if (ie->bearer_contexts.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->sgw_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 1, &ie->sgw_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 2, &ie->epdg_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_FQ_CSID_TYPE, 3, &ie->twan_fq_csid);
+    if (ie->protocol_configuration_options.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PCO_TYPE, 0, &ie->protocol_configuration_options);
+    if (ie->ue_time_zone.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_UE_TIME_ZONE_TYPE, 0, &ie->ue_time_zone);
+    if (ie->user_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TYPE, 0, &ie->user_location_information);
+    if (ie->uli_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ULI_TIMESTAMP_TYPE, 0, &ie->uli_timestamp);
+    if (ie->twan_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 0, &ie->twan_identifier);
+    if (ie->twan_identifier_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 0, &ie->twan_identifier_timestamp);
+    if (ie->mme_s4_sgsn_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->mme_s4_sgsn_s_overload_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 1,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->mme_s4_sgsn_identifier.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IP_ADDRESS_TYPE, 0, &ie->mme_s4_sgsn_identifier);
+    if (ie->twan_epdg_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 2,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->twan_epdg_s_overload_control_information));
+    if (ie->wlan_location_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TYPE, 1, &ie->wlan_location_information);
+    if (ie->wlan_location_timestamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE, 1, &ie->wlan_location_timestamp);
+    if (ie->ue_udp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 0, &ie->ue_udp_port);
+    if (ie->nbifom_container.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_CONTAINER_TYPE, 0, &ie->nbifom_container);
+    if (ie->ue_tcp_port.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_GTP_PORT_NUMBER_TYPE, 1, &ie->ue_tcp_port);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+
+    return pos;
+}
+
+static int msg_read_delete_bearer_response(ogs_gtp_delete_bearer_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->linked_eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_FQ_CSID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->sgw_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 2) {
+                if (ogs_tlv_read_octet(&ie->epdg_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 3) {
+                if (ogs_tlv_read_octet(&ie->twan_fq_csid, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PCO_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->protocol_configuration_options, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_UE_TIME_ZONE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->ue_time_zone, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->user_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ULI_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->uli_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_TWAN_IDENTIFIER_TIMESTAMP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->twan_identifier_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_octet(&ie->wlan_location_timestamp, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->mme_s4_sgsn_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->mme_s4_sgsn_s_overload_control_information.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else if (instance == 2) {
+                if (tlv_read_overload_control_information(&ie->twan_epdg_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->twan_epdg_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IP_ADDRESS_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->mme_s4_sgsn_identifier, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PORT_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint16(&ie->ue_udp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else if (instance == 1) {
+                if (ogs_tlv_read_uint16(&ie->ue_tcp_port, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_CONTAINER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->nbifom_container, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_create_indirect_data_forwarding_tunnel_request(ogs_gtp_create_indirect_data_forwarding_tunnel_request_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->imsi.presence)
+        length += TLV_HLEN + ie->imsi.len;
+    if (ie->me_identity.presence)
+        length += TLV_HLEN + ie->me_identity.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    for (i = 0; i < 8 && ie->bearer_contexts[i].presence; i++)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts[i]);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_create_indirect_data_forwarding_tunnel_request(uint8_t *pos, ogs_gtp_create_indirect_data_forwarding_tunnel_request_t *ie)
+{
+    int i;
+
+    if (ie->imsi.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IMSI_TYPE, 0, &ie->imsi);
+    if (ie->me_identity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_MEI_TYPE, 0, &ie->me_identity);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    for (i = 0; i < 8 && ie->bearer_contexts[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts[i]));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+
+    return pos;
+}
+
+static int msg_read_create_indirect_data_forwarding_tunnel_request(ogs_gtp_create_indirect_data_forwarding_tunnel_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_IMSI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->imsi, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_MEI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->me_identity, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                for (i = 0; i < 8 && ie->bearer_contexts[i].presence; i++);
+                if (i == 8) {
+                    ogs_fatal("Multiple of the same type TLV need more room");
+                    ogs_assert_if_reached();
+                    break;
+                }
+                if (tlv_read_bearer_context(&ie->bearer_contexts[i], pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts[i].presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_create_indirect_data_forwarding_tunnel_response(ogs_gtp_create_indirect_data_forwarding_tunnel_response_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    for (i = 0; i < 8 && ie->bearer_contexts[i].presence; i++)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts[i]);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_create_indirect_data_forwarding_tunnel_response(uint8_t *pos, ogs_gtp_create_indirect_data_forwarding_tunnel_response_t *ie)
+{
+    int i;
+
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    for (i = 0; i < 8 && ie->bearer_contexts[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts[i]));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+
+    return pos;
+}
+
+static int msg_read_create_indirect_data_forwarding_tunnel_response(ogs_gtp_create_indirect_data_forwarding_tunnel_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                for (i = 0; i < 8 && ie->bearer_contexts[i].presence; i++);
+                if (i == 8) {
+                    ogs_fatal("Multiple of the same type TLV need more room");
+                    ogs_assert_if_reached();
+                    break;
+                }
+                if (tlv_read_bearer_context(&ie->bearer_contexts[i], pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts[i].presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_indirect_data_forwarding_tunnel_request(ogs_gtp_delete_indirect_data_forwarding_tunnel_request_t *ie)
+{
+    uint32_t length = 0;
+
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_indirect_data_forwarding_tunnel_request(uint8_t *pos, ogs_gtp_delete_indirect_data_forwarding_tunnel_request_t *ie)
+{
+    return pos;
+}
+
+static int msg_read_delete_indirect_data_forwarding_tunnel_request(ogs_gtp_delete_indirect_data_forwarding_tunnel_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_delete_indirect_data_forwarding_tunnel_response(ogs_gtp_delete_indirect_data_forwarding_tunnel_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_delete_indirect_data_forwarding_tunnel_response(uint8_t *pos, ogs_gtp_delete_indirect_data_forwarding_tunnel_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+
+    return pos;
+}
+
+static int msg_read_delete_indirect_data_forwarding_tunnel_response(ogs_gtp_delete_indirect_data_forwarding_tunnel_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_release_access_bearers_request(ogs_gtp_release_access_bearers_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->list_of_rabs.presence)
+        length += TLV_HLEN + 1;
+    if (ie->originating_node.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_release_access_bearers_request(uint8_t *pos, ogs_gtp_release_access_bearers_request_t *ie)
+{
+    if (ie->list_of_rabs.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->list_of_rabs);
+    if (ie->originating_node.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_NODE_TYPE_TYPE, 0, &ie->originating_node);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+
+    return pos;
+}
+
+static int msg_read_release_access_bearers_request(ogs_gtp_release_access_bearers_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->list_of_rabs, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_NODE_TYPE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->originating_node, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_release_access_bearers_response(ogs_gtp_release_access_bearers_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+
+    return length;
+}
+
+static uint8_t *msg_write_release_access_bearers_response(uint8_t *pos, ogs_gtp_release_access_bearers_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+
+    return pos;
+}
+
+static int msg_read_release_access_bearers_response(ogs_gtp_release_access_bearers_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_downlink_data_notification(ogs_gtp_downlink_data_notification_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->eps_bearer_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->allocation_retention_priority.presence)
+        length += TLV_HLEN + ie->allocation_retention_priority.len;
+    if (ie->imsi.presence)
+        length += TLV_HLEN + ie->imsi.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+    if (ie->paging_and_service_information.presence)
+        length += TLV_HLEN + ie->paging_and_service_information.len;
+    if (ie->dl_data_packets_size.presence)
+        length += TLV_HLEN + ie->dl_data_packets_size.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_downlink_data_notification(uint8_t *pos, ogs_gtp_downlink_data_notification_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->eps_bearer_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_EBI_TYPE, 0, &ie->eps_bearer_id);
+    if (ie->allocation_retention_priority.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_ARP_TYPE, 0, &ie->allocation_retention_priority);
+    if (ie->imsi.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IMSI_TYPE, 0, &ie->imsi);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+    if (ie->paging_and_service_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_PAGING_AND_SERVICE_INFORMATION_TYPE, 0, &ie->paging_and_service_information);
+    if (ie->dl_data_packets_size.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INTEGER_NUMBER_TYPE, 0, &ie->dl_data_packets_size);
+
+    return pos;
+}
+
+static int msg_read_downlink_data_notification(ogs_gtp_downlink_data_notification_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EBI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->eps_bearer_id, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_ARP_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->allocation_retention_priority, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IMSI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->imsi, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_PAGING_AND_SERVICE_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->paging_and_service_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INTEGER_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->dl_data_packets_size, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_downlink_data_notification_acknowledge(ogs_gtp_downlink_data_notification_acknowledge_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->data_notification_delay.presence)
+        length += TLV_HLEN + ie->data_notification_delay.len;
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->dl_low_priority_traffic_throttling_.presence)
+        length += TLV_HLEN + ie->dl_low_priority_traffic_throttling_.len;
+    if (ie->imsi.presence)
+        length += TLV_HLEN + ie->imsi.len;
+    if (ie->dl_buffering_duration.presence)
+        length += TLV_HLEN + ie->dl_buffering_duration.len;
+    if (ie->dl_buffering_suggested_packet_count.presence)
+        length += TLV_HLEN + ie->dl_buffering_suggested_packet_count.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_downlink_data_notification_acknowledge(uint8_t *pos, ogs_gtp_downlink_data_notification_acknowledge_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->data_notification_delay.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_DELAY_VALUE_TYPE, 0, &ie->data_notification_delay);
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->dl_low_priority_traffic_throttling_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_THROTTLING_TYPE, 0, &ie->dl_low_priority_traffic_throttling_);
+    if (ie->imsi.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_IMSI_TYPE, 0, &ie->imsi);
+    if (ie->dl_buffering_duration.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_EPC_TIMER_TYPE, 0, &ie->dl_buffering_duration);
+    if (ie->dl_buffering_suggested_packet_count.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INTEGER_NUMBER_TYPE, 0, &ie->dl_buffering_suggested_packet_count);
+
+    return pos;
+}
+
+static int msg_read_downlink_data_notification_acknowledge(ogs_gtp_downlink_data_notification_acknowledge_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_DELAY_VALUE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->data_notification_delay, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_THROTTLING_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->dl_low_priority_traffic_throttling_, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_IMSI_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->imsi, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_EPC_TIMER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->dl_buffering_duration, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INTEGER_NUMBER_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->dl_buffering_suggested_packet_count, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_modify_access_bearers_request(ogs_gtp_modify_access_bearers_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sender_f_teid_for_control_plane.presence)
+        length += TLV_HLEN + ie->sender_f_teid_for_control_plane.len;
+    if (ie->delay_downlink_packet_notification_request.presence)
+        length += TLV_HLEN + ie->delay_downlink_packet_notification_request.len;
+    if (ie->bearer_contexts_to_be_modified.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_to_be_modified);
+    if (ie->bearer_contexts_to_be_removed.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_to_be_removed);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->secondary_rat_usage_data_report.presence)
+        length += TLV_HLEN + ie->secondary_rat_usage_data_report.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_modify_access_bearers_request(uint8_t *pos, ogs_gtp_modify_access_bearers_request_t *ie)
+{
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sender_f_teid_for_control_plane.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_F_TEID_TYPE, 0, &ie->sender_f_teid_for_control_plane);
+    if (ie->delay_downlink_packet_notification_request.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_DELAY_VALUE_TYPE, 0, &ie->delay_downlink_packet_notification_request);
+    if (ie->bearer_contexts_to_be_modified.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_to_be_modified));
+    if (ie->bearer_contexts_to_be_removed.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 1,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_to_be_removed));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->secondary_rat_usage_data_report.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE, 0, &ie->secondary_rat_usage_data_report);
+
+    return pos;
+}
+
+static int msg_read_modify_access_bearers_request(ogs_gtp_modify_access_bearers_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_F_TEID_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->sender_f_teid_for_control_plane, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_DELAY_VALUE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->delay_downlink_packet_notification_request, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_to_be_modified, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_to_be_modified.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_to_be_removed, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_to_be_removed.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_SECONDARY_RAT_USAGE_DATA_REPORT_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->secondary_rat_usage_data_report, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_modify_access_bearers_response(ogs_gtp_modify_access_bearers_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + ie->cause.len;
+    if (ie->bearer_contexts_modified.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_modified);
+    if (ie->bearer_contexts_marked_for_removal.presence)
+        length += TLV_HLEN + tlv_length_bearer_context(&ie->bearer_contexts_marked_for_removal);
+    if (ie->recovery.presence)
+        length += TLV_HLEN + 1;
+    if (ie->indication_flags.presence)
+        length += TLV_HLEN + ie->indication_flags.len;
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->sgw_s_node_level_load_control_information);
+    if (ie->sgw_s_overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->sgw_s_overload_control_information);
+
+    return length;
+}
+
+static uint8_t *msg_write_modify_access_bearers_response(uint8_t *pos, ogs_gtp_modify_access_bearers_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->bearer_contexts_modified.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 0,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_modified));
+    if (ie->bearer_contexts_marked_for_removal.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_BEARER_CONTEXT_TYPE, 1,
+                tlv_write_bearer_context(pos + TLV_HLEN, &ie->bearer_contexts_marked_for_removal));
+    if (ie->recovery.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_GTP_RECOVERY_TYPE, 0, &ie->recovery);
+    if (ie->indication_flags.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_GTP_INDICATION_TYPE, 0, &ie->indication_flags);
+    if (ie->sgw_s_node_level_load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->sgw_s_node_level_load_control_information));
+    if (ie->sgw_s_overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->sgw_s_overload_control_information));
+
+    return pos;
+}
+
+static int msg_read_modify_access_bearers_response(ogs_gtp_modify_access_bearers_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_GTP_CAUSE_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->cause, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_BEARER_CONTEXT_TYPE:
+            if (instance == 0) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_modified, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_modified.presence = 1;
+            } else if (instance == 1) {
+                if (tlv_read_bearer_context(&ie->bearer_contexts_marked_for_removal, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->bearer_contexts_marked_for_removal.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_RECOVERY_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_uint8(&ie->recovery, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_INDICATION_TYPE:
+            if (instance == 0) {
+                if (ogs_tlv_read_octet(&ie->indication_flags, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_load_control_information(&ie->sgw_s_node_level_load_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_node_level_load_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        case OGS_GTP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (instance == 0) {
+                if (tlv_read_overload_control_information(&ie->sgw_s_overload_control_information, pos, len) != OGS_OK)
+                    return OGS_ERROR;
+                ie->sgw_s_overload_control_information.presence = 1;
+            } else
+                ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
 int ogs_gtp_parse_msg(ogs_gtp_message_t *gtp_message, ogs_pkbuf_t *pkbuf)
 {
     int rv = OGS_ERROR;
@@ -2718,128 +9223,128 @@ int ogs_gtp_parse_msg(ogs_gtp_message_t *gtp_message, ogs_pkbuf_t *pkbuf)
 
     switch(gtp_message->h.type) {
     case OGS_GTP_ECHO_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->echo_request,
-                &ogs_gtp_tlv_desc_echo_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_echo_request(&gtp_message->echo_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_ECHO_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->echo_response,
-                &ogs_gtp_tlv_desc_echo_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_echo_response(&gtp_message->echo_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_CREATE_SESSION_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->create_session_request,
-                &ogs_gtp_tlv_desc_create_session_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_create_session_request(&gtp_message->create_session_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_CREATE_SESSION_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->create_session_response,
-                &ogs_gtp_tlv_desc_create_session_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_create_session_response(&gtp_message->create_session_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_MODIFY_BEARER_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->modify_bearer_request,
-                &ogs_gtp_tlv_desc_modify_bearer_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_modify_bearer_request(&gtp_message->modify_bearer_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_MODIFY_BEARER_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->modify_bearer_response,
-                &ogs_gtp_tlv_desc_modify_bearer_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_modify_bearer_response(&gtp_message->modify_bearer_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_SESSION_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_session_request,
-                &ogs_gtp_tlv_desc_delete_session_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_session_request(&gtp_message->delete_session_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_SESSION_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_session_response,
-                &ogs_gtp_tlv_desc_delete_session_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_session_response(&gtp_message->delete_session_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_MODIFY_BEARER_COMMAND_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->modify_bearer_command,
-                &ogs_gtp_tlv_desc_modify_bearer_command, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_modify_bearer_command(&gtp_message->modify_bearer_command,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_MODIFY_BEARER_FAILURE_INDICATION_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->modify_bearer_failure_indication,
-                &ogs_gtp_tlv_desc_modify_bearer_failure_indication, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_modify_bearer_failure_indication(&gtp_message->modify_bearer_failure_indication,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_BEARER_COMMAND_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_bearer_command,
-                &ogs_gtp_tlv_desc_delete_bearer_command, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_bearer_command(&gtp_message->delete_bearer_command,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_BEARER_FAILURE_INDICATION_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_bearer_failure_indication,
-                &ogs_gtp_tlv_desc_delete_bearer_failure_indication, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_bearer_failure_indication(&gtp_message->delete_bearer_failure_indication,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_BEARER_RESOURCE_COMMAND_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->bearer_resource_command,
-                &ogs_gtp_tlv_desc_bearer_resource_command, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_bearer_resource_command(&gtp_message->bearer_resource_command,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_BEARER_RESOURCE_FAILURE_INDICATION_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->bearer_resource_failure_indication,
-                &ogs_gtp_tlv_desc_bearer_resource_failure_indication, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_bearer_resource_failure_indication(&gtp_message->bearer_resource_failure_indication,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_FAILURE_INDICATION_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->downlink_data_notification_failure_indication,
-                &ogs_gtp_tlv_desc_downlink_data_notification_failure_indication, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_downlink_data_notification_failure_indication(&gtp_message->downlink_data_notification_failure_indication,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_CREATE_BEARER_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->create_bearer_request,
-                &ogs_gtp_tlv_desc_create_bearer_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_create_bearer_request(&gtp_message->create_bearer_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_CREATE_BEARER_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->create_bearer_response,
-                &ogs_gtp_tlv_desc_create_bearer_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_create_bearer_response(&gtp_message->create_bearer_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_UPDATE_BEARER_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->update_bearer_request,
-                &ogs_gtp_tlv_desc_update_bearer_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_update_bearer_request(&gtp_message->update_bearer_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_UPDATE_BEARER_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->update_bearer_response,
-                &ogs_gtp_tlv_desc_update_bearer_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_update_bearer_response(&gtp_message->update_bearer_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_BEARER_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_bearer_request,
-                &ogs_gtp_tlv_desc_delete_bearer_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_bearer_request(&gtp_message->delete_bearer_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_BEARER_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_bearer_response,
-                &ogs_gtp_tlv_desc_delete_bearer_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_bearer_response(&gtp_message->delete_bearer_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->create_indirect_data_forwarding_tunnel_request,
-                &ogs_gtp_tlv_desc_create_indirect_data_forwarding_tunnel_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_create_indirect_data_forwarding_tunnel_request(&gtp_message->create_indirect_data_forwarding_tunnel_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->create_indirect_data_forwarding_tunnel_response,
-                &ogs_gtp_tlv_desc_create_indirect_data_forwarding_tunnel_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_create_indirect_data_forwarding_tunnel_response(&gtp_message->create_indirect_data_forwarding_tunnel_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_indirect_data_forwarding_tunnel_request,
-                &ogs_gtp_tlv_desc_delete_indirect_data_forwarding_tunnel_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_indirect_data_forwarding_tunnel_request(&gtp_message->delete_indirect_data_forwarding_tunnel_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->delete_indirect_data_forwarding_tunnel_response,
-                &ogs_gtp_tlv_desc_delete_indirect_data_forwarding_tunnel_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_delete_indirect_data_forwarding_tunnel_response(&gtp_message->delete_indirect_data_forwarding_tunnel_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_RELEASE_ACCESS_BEARERS_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->release_access_bearers_request,
-                &ogs_gtp_tlv_desc_release_access_bearers_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_release_access_bearers_request(&gtp_message->release_access_bearers_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_RELEASE_ACCESS_BEARERS_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->release_access_bearers_response,
-                &ogs_gtp_tlv_desc_release_access_bearers_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_release_access_bearers_response(&gtp_message->release_access_bearers_response,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->downlink_data_notification,
-                &ogs_gtp_tlv_desc_downlink_data_notification, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_downlink_data_notification(&gtp_message->downlink_data_notification,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_ACKNOWLEDGE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->downlink_data_notification_acknowledge,
-                &ogs_gtp_tlv_desc_downlink_data_notification_acknowledge, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_downlink_data_notification_acknowledge(&gtp_message->downlink_data_notification_acknowledge,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_MODIFY_ACCESS_BEARERS_REQUEST_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->modify_access_bearers_request,
-                &ogs_gtp_tlv_desc_modify_access_bearers_request, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_modify_access_bearers_request(&gtp_message->modify_access_bearers_request,
+                pkbuf->data, pkbuf->len);
         break;
     case OGS_GTP_MODIFY_ACCESS_BEARERS_RESPONSE_TYPE:
-        rv = ogs_tlv_parse_msg(&gtp_message->modify_access_bearers_response,
-                &ogs_gtp_tlv_desc_modify_access_bearers_response, pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        rv = msg_read_modify_access_bearers_response(&gtp_message->modify_access_bearers_response,
+                pkbuf->data, pkbuf->len);
         break;
     default:
         ogs_warn("Not implmeneted(type:%d)", gtp_message->h.type);
@@ -2854,137 +9359,275 @@ int ogs_gtp_parse_msg(ogs_gtp_message_t *gtp_message, ogs_pkbuf_t *pkbuf)
 ogs_pkbuf_t *ogs_gtp_build_msg(ogs_gtp_message_t *gtp_message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
+    uint8_t *pos = NULL;
+    uint32_t length = 0;
 
     ogs_assert(gtp_message);
     switch(gtp_message->h.type) {
     case OGS_GTP_ECHO_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_echo_request,
-                &gtp_message->echo_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_echo_request(
+                &gtp_message->echo_request);
         break;
     case OGS_GTP_ECHO_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_echo_response,
-                &gtp_message->echo_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_echo_response(
+                &gtp_message->echo_response);
         break;
     case OGS_GTP_CREATE_SESSION_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_session_request,
-                &gtp_message->create_session_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_create_session_request(
+                &gtp_message->create_session_request);
         break;
     case OGS_GTP_CREATE_SESSION_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_session_response,
-                &gtp_message->create_session_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_create_session_response(
+                &gtp_message->create_session_response);
         break;
     case OGS_GTP_MODIFY_BEARER_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_modify_bearer_request,
-                &gtp_message->modify_bearer_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_modify_bearer_request(
+                &gtp_message->modify_bearer_request);
         break;
     case OGS_GTP_MODIFY_BEARER_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_modify_bearer_response,
-                &gtp_message->modify_bearer_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_modify_bearer_response(
+                &gtp_message->modify_bearer_response);
         break;
     case OGS_GTP_DELETE_SESSION_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_session_request,
-                &gtp_message->delete_session_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_session_request(
+                &gtp_message->delete_session_request);
         break;
     case OGS_GTP_DELETE_SESSION_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_session_response,
-                &gtp_message->delete_session_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_session_response(
+                &gtp_message->delete_session_response);
         break;
     case OGS_GTP_MODIFY_BEARER_COMMAND_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_modify_bearer_command,
-                &gtp_message->modify_bearer_command, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_modify_bearer_command(
+                &gtp_message->modify_bearer_command);
         break;
     case OGS_GTP_MODIFY_BEARER_FAILURE_INDICATION_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_modify_bearer_failure_indication,
-                &gtp_message->modify_bearer_failure_indication, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_modify_bearer_failure_indication(
+                &gtp_message->modify_bearer_failure_indication);
         break;
     case OGS_GTP_DELETE_BEARER_COMMAND_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_bearer_command,
-                &gtp_message->delete_bearer_command, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_bearer_command(
+                &gtp_message->delete_bearer_command);
         break;
     case OGS_GTP_DELETE_BEARER_FAILURE_INDICATION_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_bearer_failure_indication,
-                &gtp_message->delete_bearer_failure_indication, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_bearer_failure_indication(
+                &gtp_message->delete_bearer_failure_indication);
         break;
     case OGS_GTP_BEARER_RESOURCE_COMMAND_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_bearer_resource_command,
-                &gtp_message->bearer_resource_command, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_bearer_resource_command(
+                &gtp_message->bearer_resource_command);
         break;
     case OGS_GTP_BEARER_RESOURCE_FAILURE_INDICATION_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_bearer_resource_failure_indication,
-                &gtp_message->bearer_resource_failure_indication, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_bearer_resource_failure_indication(
+                &gtp_message->bearer_resource_failure_indication);
         break;
     case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_FAILURE_INDICATION_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_downlink_data_notification_failure_indication,
-                &gtp_message->downlink_data_notification_failure_indication, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_downlink_data_notification_failure_indication(
+                &gtp_message->downlink_data_notification_failure_indication);
         break;
     case OGS_GTP_CREATE_BEARER_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_bearer_request,
-                &gtp_message->create_bearer_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_create_bearer_request(
+                &gtp_message->create_bearer_request);
         break;
     case OGS_GTP_CREATE_BEARER_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_bearer_response,
-                &gtp_message->create_bearer_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_create_bearer_response(
+                &gtp_message->create_bearer_response);
         break;
     case OGS_GTP_UPDATE_BEARER_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_update_bearer_request,
-                &gtp_message->update_bearer_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_update_bearer_request(
+                &gtp_message->update_bearer_request);
         break;
     case OGS_GTP_UPDATE_BEARER_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_update_bearer_response,
-                &gtp_message->update_bearer_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_update_bearer_response(
+                &gtp_message->update_bearer_response);
         break;
     case OGS_GTP_DELETE_BEARER_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_bearer_request,
-                &gtp_message->delete_bearer_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_bearer_request(
+                &gtp_message->delete_bearer_request);
         break;
     case OGS_GTP_DELETE_BEARER_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_bearer_response,
-                &gtp_message->delete_bearer_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_bearer_response(
+                &gtp_message->delete_bearer_response);
         break;
     case OGS_GTP_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_indirect_data_forwarding_tunnel_request,
-                &gtp_message->create_indirect_data_forwarding_tunnel_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_create_indirect_data_forwarding_tunnel_request(
+                &gtp_message->create_indirect_data_forwarding_tunnel_request);
         break;
     case OGS_GTP_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_indirect_data_forwarding_tunnel_response,
-                &gtp_message->create_indirect_data_forwarding_tunnel_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_create_indirect_data_forwarding_tunnel_response(
+                &gtp_message->create_indirect_data_forwarding_tunnel_response);
         break;
     case OGS_GTP_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_indirect_data_forwarding_tunnel_request,
-                &gtp_message->delete_indirect_data_forwarding_tunnel_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_indirect_data_forwarding_tunnel_request(
+                &gtp_message->delete_indirect_data_forwarding_tunnel_request);
         break;
     case OGS_GTP_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_delete_indirect_data_forwarding_tunnel_response,
-                &gtp_message->delete_indirect_data_forwarding_tunnel_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_delete_indirect_data_forwarding_tunnel_response(
+                &gtp_message->delete_indirect_data_forwarding_tunnel_response);
         break;
     case OGS_GTP_RELEASE_ACCESS_BEARERS_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_release_access_bearers_request,
-                &gtp_message->release_access_bearers_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_release_access_bearers_request(
+                &gtp_message->release_access_bearers_request);
         break;
     case OGS_GTP_RELEASE_ACCESS_BEARERS_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_release_access_bearers_response,
-                &gtp_message->release_access_bearers_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_release_access_bearers_response(
+                &gtp_message->release_access_bearers_response);
         break;
     case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_downlink_data_notification,
-                &gtp_message->downlink_data_notification, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_downlink_data_notification(
+                &gtp_message->downlink_data_notification);
         break;
     case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_ACKNOWLEDGE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_downlink_data_notification_acknowledge,
-                &gtp_message->downlink_data_notification_acknowledge, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_downlink_data_notification_acknowledge(
+                &gtp_message->downlink_data_notification_acknowledge);
         break;
     case OGS_GTP_MODIFY_ACCESS_BEARERS_REQUEST_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_modify_access_bearers_request,
-                &gtp_message->modify_access_bearers_request, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_modify_access_bearers_request(
+                &gtp_message->modify_access_bearers_request);
         break;
     case OGS_GTP_MODIFY_ACCESS_BEARERS_RESPONSE_TYPE:
-        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_modify_access_bearers_response,
-                &gtp_message->modify_access_bearers_response, OGS_TLV_MODE_T1_L2_I1);
+        length = msg_length_modify_access_bearers_response(
+                &gtp_message->modify_access_bearers_response);
         break;
     default:
         ogs_warn("Not implmeneted(type:%d)", gtp_message->h.type);
+        return NULL;
+    }
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_TLV_MAX_HEADROOM+length);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_reserve(pkbuf, OGS_TLV_MAX_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length);
+
+    switch(gtp_message->h.type) {
+    case OGS_GTP_ECHO_REQUEST_TYPE:
+        pos = msg_write_echo_request(pkbuf->data,
+                &gtp_message->echo_request);
+        break;
+    case OGS_GTP_ECHO_RESPONSE_TYPE:
+        pos = msg_write_echo_response(pkbuf->data,
+                &gtp_message->echo_response);
+        break;
+    case OGS_GTP_CREATE_SESSION_REQUEST_TYPE:
+        pos = msg_write_create_session_request(pkbuf->data,
+                &gtp_message->create_session_request);
+        break;
+    case OGS_GTP_CREATE_SESSION_RESPONSE_TYPE:
+        pos = msg_write_create_session_response(pkbuf->data,
+                &gtp_message->create_session_response);
+        break;
+    case OGS_GTP_MODIFY_BEARER_REQUEST_TYPE:
+        pos = msg_write_modify_bearer_request(pkbuf->data,
+                &gtp_message->modify_bearer_request);
+        break;
+    case OGS_GTP_MODIFY_BEARER_RESPONSE_TYPE:
+        pos = msg_write_modify_bearer_response(pkbuf->data,
+                &gtp_message->modify_bearer_response);
+        break;
+    case OGS_GTP_DELETE_SESSION_REQUEST_TYPE:
+        pos = msg_write_delete_session_request(pkbuf->data,
+                &gtp_message->delete_session_request);
+        break;
+    case OGS_GTP_DELETE_SESSION_RESPONSE_TYPE:
+        pos = msg_write_delete_session_response(pkbuf->data,
+                &gtp_message->delete_session_response);
+        break;
+    case OGS_GTP_MODIFY_BEARER_COMMAND_TYPE:
+        pos = msg_write_modify_bearer_command(pkbuf->data,
+                &gtp_message->modify_bearer_command);
+        break;
+    case OGS_GTP_MODIFY_BEARER_FAILURE_INDICATION_TYPE:
+        pos = msg_write_modify_bearer_failure_indication(pkbuf->data,
+                &gtp_message->modify_bearer_failure_indication);
+        break;
+    case OGS_GTP_DELETE_BEARER_COMMAND_TYPE:
+        pos = msg_write_delete_bearer_command(pkbuf->data,
+                &gtp_message->delete_bearer_command);
+        break;
+    case OGS_GTP_DELETE_BEARER_FAILURE_INDICATION_TYPE:
+        pos = msg_write_delete_bearer_failure_indication(pkbuf->data,
+                &gtp_message->delete_bearer_failure_indication);
+        break;
+    case OGS_GTP_BEARER_RESOURCE_COMMAND_TYPE:
+        pos = msg_write_bearer_resource_command(pkbuf->data,
+                &gtp_message->bearer_resource_command);
+        break;
+    case OGS_GTP_BEARER_RESOURCE_FAILURE_INDICATION_TYPE:
+        pos = msg_write_bearer_resource_failure_indication(pkbuf->data,
+                &gtp_message->bearer_resource_failure_indication);
+        break;
+    case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_FAILURE_INDICATION_TYPE:
+        pos = msg_write_downlink_data_notification_failure_indication(pkbuf->data,
+                &gtp_message->downlink_data_notification_failure_indication);
+        break;
+    case OGS_GTP_CREATE_BEARER_REQUEST_TYPE:
+        pos = msg_write_create_bearer_request(pkbuf->data,
+                &gtp_message->create_bearer_request);
+        break;
+    case OGS_GTP_CREATE_BEARER_RESPONSE_TYPE:
+        pos = msg_write_create_bearer_response(pkbuf->data,
+                &gtp_message->create_bearer_response);
+        break;
+    case OGS_GTP_UPDATE_BEARER_REQUEST_TYPE:
+        pos = msg_write_update_bearer_request(pkbuf->data,
+                &gtp_message->update_bearer_request);
+        break;
+    case OGS_GTP_UPDATE_BEARER_RESPONSE_TYPE:
+        pos = msg_write_update_bearer_response(pkbuf->data,
+                &gtp_message->update_bearer_response);
+        break;
+    case OGS_GTP_DELETE_BEARER_REQUEST_TYPE:
+        pos = msg_write_delete_bearer_request(pkbuf->data,
+                &gtp_message->delete_bearer_request);
+        break;
+    case OGS_GTP_DELETE_BEARER_RESPONSE_TYPE:
+        pos = msg_write_delete_bearer_response(pkbuf->data,
+                &gtp_message->delete_bearer_response);
+        break;
+    case OGS_GTP_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST_TYPE:
+        pos = msg_write_create_indirect_data_forwarding_tunnel_request(pkbuf->data,
+                &gtp_message->create_indirect_data_forwarding_tunnel_request);
+        break;
+    case OGS_GTP_CREATE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE_TYPE:
+        pos = msg_write_create_indirect_data_forwarding_tunnel_response(pkbuf->data,
+                &gtp_message->create_indirect_data_forwarding_tunnel_response);
+        break;
+    case OGS_GTP_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_REQUEST_TYPE:
+        pos = msg_write_delete_indirect_data_forwarding_tunnel_request(pkbuf->data,
+                &gtp_message->delete_indirect_data_forwarding_tunnel_request);
+        break;
+    case OGS_GTP_DELETE_INDIRECT_DATA_FORWARDING_TUNNEL_RESPONSE_TYPE:
+        pos = msg_write_delete_indirect_data_forwarding_tunnel_response(pkbuf->data,
+                &gtp_message->delete_indirect_data_forwarding_tunnel_response);
+        break;
+    case OGS_GTP_RELEASE_ACCESS_BEARERS_REQUEST_TYPE:
+        pos = msg_write_release_access_bearers_request(pkbuf->data,
+                &gtp_message->release_access_bearers_request);
+        break;
+    case OGS_GTP_RELEASE_ACCESS_BEARERS_RESPONSE_TYPE:
+        pos = msg_write_release_access_bearers_response(pkbuf->data,
+                &gtp_message->release_access_bearers_response);
+        break;
+    case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_TYPE:
+        pos = msg_write_downlink_data_notification(pkbuf->data,
+                &gtp_message->downlink_data_notification);
+        break;
+    case OGS_GTP_DOWNLINK_DATA_NOTIFICATION_ACKNOWLEDGE_TYPE:
+        pos = msg_write_downlink_data_notification_acknowledge(pkbuf->data,
+                &gtp_message->downlink_data_notification_acknowledge);
+        break;
+    case OGS_GTP_MODIFY_ACCESS_BEARERS_REQUEST_TYPE:
+        pos = msg_write_modify_access_bearers_request(pkbuf->data,
+                &gtp_message->modify_access_bearers_request);
+        break;
+    case OGS_GTP_MODIFY_ACCESS_BEARERS_RESPONSE_TYPE:
+        pos = msg_write_modify_access_bearers_response(pkbuf->data,
+                &gtp_message->modify_access_bearers_response);
+        break;
+    default:
+        ogs_assert_if_reached();
         break;
     }
+    ogs_assert(pos == pkbuf->data + length);
 
     return pkbuf;
 }
@@ -35,6 +35,7 @@
 #include "gtp/context.h"
 #include "gtp/build.h"
 #include "gtp/path.h"
+#include "gtp/echo.h"
 #include "gtp/xact.h"
 #include "gtp/util.h"
 
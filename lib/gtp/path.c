@@ -19,6 +19,39 @@
 
 #include "ogs-gtp.h"
 
+static struct {
+    bool started;
+    ogs_socket_t fd;
+
+    int num;
+    ogs_pkbuf_t *pkbuf[OGS_MAX_NUM_OF_MMSG];
+    ogs_sockaddr_t addr[OGS_MAX_NUM_OF_MMSG];
+} sendq;
+
+static void sendq_flush(void)
+{
+    int i, n, sent = 0;
+
+    while (sent < sendq.num) {
+        n = ogs_sendmmsg(sendq.fd,
+                sendq.pkbuf + sent, sendq.addr + sent, sendq.num - sent);
+        if (n < 0) {
+            if (ogs_socket_errno == OGS_EAGAIN)
+                break;
+
+            /* Skip the datagram which failed, e.g. no route to the peer */
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_sendmmsg() failed");
+            n = 1;
+        }
+        sent += n;
+    }
+
+    for (i = 0; i < sendq.num; i++)
+        ogs_pkbuf_free(sendq.pkbuf[i]);
+    sendq.num = 0;
+}
+
 ogs_sock_t *ogs_gtp_server(ogs_socknode_t *node)
 {
     char buf[OGS_ADDRSTRLEN];
@@ -99,19 +132,42 @@ int ogs_gtp_send(ogs_gtp_node_t *gnode, ogs_pkbuf_t *pkbuf)
 }
 
 int ogs_gtp_sendto(ogs_gtp_node_t *gnode, ogs_pkbuf_t *pkbuf)
+{
+    ogs_assert(gnode);
+    ogs_assert(gnode->sock);
+
+    return ogs_gtp_sendto_addr(gnode->sock->fd, &gnode->addr, pkbuf);
+}
+
+/*
+ * Only the struct sockaddr_in or sockaddr_in6 of addr is read,
+ * so it can point to a copy of the peer address.
+ */
+int ogs_gtp_sendto_addr(
+        ogs_socket_t fd, ogs_sockaddr_t *addr, ogs_pkbuf_t *pkbuf)
 {
     ssize_t sent;
-    ogs_sock_t *sock = NULL;
-    ogs_sockaddr_t *addr = NULL;
 
-    ogs_assert(gnode);
-    ogs_assert(pkbuf);
-    sock = gnode->sock;
-    ogs_assert(sock);
-    addr = &gnode->addr;
+    ogs_assert(fd != INVALID_SOCKET);
     ogs_assert(addr);
+    ogs_assert(pkbuf);
+
+    if (sendq.started) {
+        if (sendq.num &&
+            (sendq.fd != fd || sendq.num == OGS_MAX_NUM_OF_MMSG))
+            sendq_flush();
+
+        sendq.pkbuf[sendq.num] = ogs_pkbuf_copy(pkbuf);
+        if (sendq.pkbuf[sendq.num]) {
+            sendq.fd = fd;
+            memcpy(&sendq.addr[sendq.num], addr, ogs_sockaddr_len(addr));
+            sendq.num++;
+
+            return OGS_OK;
+        }
+    }
 
-    sent = ogs_sendto(sock->fd, pkbuf->data, pkbuf->len, 0, addr);
+    sent = ogs_sendto(fd, pkbuf->data, pkbuf->len, 0, addr);
     if (sent < 0 || sent != pkbuf->len) {
         if (ogs_socket_errno != OGS_EAGAIN) {
             ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
@@ -123,10 +179,43 @@ int ogs_gtp_sendto(ogs_gtp_node_t *gnode, ogs_pkbuf_t *pkbuf)
     return OGS_OK;
 }
 
+/*
+ * Between ogs_gtp_send_batch_start() and ogs_gtp_send_batch_flush(),
+ * ogs_gtp_sendto() only queues a reference to the packet. The queue is
+ * sent with one sendmmsg() when it is full, when the socket changes and
+ * at ogs_gtp_send_batch_flush(). The caller, typically a receive handler
+ * draining its socket, has to flush before it returns to the poll loop.
+ */
+void ogs_gtp_send_batch_start(void)
+{
+    ogs_assert(sendq.started == false);
+    sendq.started = true;
+}
+
+void ogs_gtp_send_batch_flush(void)
+{
+    ogs_assert(sendq.started == true);
+    if (sendq.num)
+        sendq_flush();
+    sendq.started = false;
+}
+
 int ogs_gtp_send_user_plane(
         ogs_gtp_node_t *gnode,
         ogs_gtp_header_t *gtp_hdesc, ogs_gtp_extension_header_t *ext_hdesc,
         ogs_pkbuf_t *pkbuf)
+{
+    ogs_assert(gnode);
+    ogs_assert(gnode->sock);
+
+    return ogs_gtp_send_user_plane_to(gnode->sock->fd, &gnode->addr,
+            gtp_hdesc, ext_hdesc, pkbuf);
+}
+
+int ogs_gtp_send_user_plane_to(
+        ogs_socket_t fd, ogs_sockaddr_t *addr,
+        ogs_gtp_header_t *gtp_hdesc, ogs_gtp_extension_header_t *ext_hdesc,
+        ogs_pkbuf_t *pkbuf)
 {
     char buf[OGS_ADDRSTRLEN];
     int rv;
@@ -136,7 +225,7 @@ int ogs_gtp_send_user_plane(
     uint8_t flags;
     uint8_t gtp_hlen = 0;
 
-    ogs_assert(gnode);
+    ogs_assert(addr);
     ogs_assert(gtp_hdesc);
     ogs_assert(ext_hdesc);
     ogs_assert(pkbuf);
@@ -216,12 +305,12 @@ int ogs_gtp_send_user_plane(
     }
 
     ogs_debug("SEND GTP-U[%d] to Peer[%s] : TEID[0x%x]",
-            gtp_hdesc->type, OGS_ADDR(&gnode->addr, buf), gtp_hdesc->teid);
-    rv = ogs_gtp_sendto(gnode, pkbuf);
+            gtp_hdesc->type, OGS_ADDR(addr, buf), gtp_hdesc->teid);
+    rv = ogs_gtp_sendto_addr(fd, addr, pkbuf);
     if (rv != OGS_OK) {
         if (ogs_socket_errno != OGS_EAGAIN) {
             ogs_error("SEND GTP-U[%d] to Peer[%s] : TEID[0x%x]",
-                gtp_hdesc->type, OGS_ADDR(&gnode->addr, buf), gtp_hdesc->teid);
+                gtp_hdesc->type, OGS_ADDR(addr, buf), gtp_hdesc->teid);
         }
     }
 
@@ -73,11 +73,20 @@ int ogs_gtp_connect(ogs_sock_t *ipv4, ogs_sock_t *ipv6, ogs_gtp_node_t *gnode);
 
 int ogs_gtp_send(ogs_gtp_node_t *gnode, ogs_pkbuf_t *pkbuf);
 int ogs_gtp_sendto(ogs_gtp_node_t *gnode, ogs_pkbuf_t *pkbuf);
+int ogs_gtp_sendto_addr(
+        ogs_socket_t fd, ogs_sockaddr_t *addr, ogs_pkbuf_t *pkbuf);
+
+void ogs_gtp_send_batch_start(void);
+void ogs_gtp_send_batch_flush(void);
 
 int ogs_gtp_send_user_plane(
         ogs_gtp_node_t *gnode,
         ogs_gtp_header_t *gtp_hdesc, ogs_gtp_extension_header_t *ext_hdesc,
         ogs_pkbuf_t *pkbuf);
+int ogs_gtp_send_user_plane_to(
+        ogs_socket_t fd, ogs_sockaddr_t *addr,
+        ogs_gtp_header_t *gtp_hdesc, ogs_gtp_extension_header_t *ext_hdesc,
+        ogs_pkbuf_t *pkbuf);
 
 ogs_pkbuf_t *ogs_gtp_handle_echo_req(ogs_pkbuf_t *pkt);
 void ogs_gtp_send_error_message(
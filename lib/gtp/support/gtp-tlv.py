@@ -626,6 +626,175 @@ for (k, v) in sorted_msg_list:
         f.write("}};\n\n")
 f.write("\n")
 
+def ie_fields(ies, k):
+    fields = []
+    for ies in ies:
+        field = { "name" : v_lower(ies["ie_value"]), "type" : ies["ie_type"], \
+                "instance" : int(ies["instance"]), "more" : 0 }
+        if ies["ie_type"] == "F-TEID":
+            if ies["ie_value"] == "S2b-U ePDG F-TEID" or ies["ie_value"] == "S2a-U TWAN F-TEID":
+                field["name"] += "_" + ies["instance"]
+        if (k == 'Create Indirect Data Forwarding Tunnel Request' or k == 'Create Indirect Data Forwarding Tunnel Response') and ies["ie_value"] == 'Bearer Contexts':
+            field["more"] = 8
+        fields.append(field)
+    return fields
+
+def ie_kind(k):
+    if k in group_list.keys():
+        return "group"
+    if "size" in type_list[k]:
+        return { 1 : "uint8", 2 : "uint16", 3 : "uint24", 4 : "uint32" }[type_list[k]["size"]]
+    return "octet"
+
+def ie_length(field, ref):
+    kind = ie_kind(field["type"])
+    if kind == "group":
+        return "TLV_HLEN + tlv_length_%s(&%s)" % (v_lower(field["type"]), ref)
+    elif kind == "octet":
+        return "TLV_HLEN + %s.len" % ref
+    else:
+        return "TLV_HLEN + %d" % type_list[field["type"]]["size"]
+
+def ie_write(field, ref, indent):
+    kind = ie_kind(field["type"])
+    if kind == "group":
+        return "pos = ogs_tlv_write_group(pos, TLV_MODE,\n" + indent + \
+            "        OGS_GTP_%s_TYPE, %d,\n" % (v_upper(field["type"]), field["instance"]) + indent + \
+            "        tlv_write_%s(pos + TLV_HLEN, &%s));\n" % (v_lower(field["type"]), ref)
+    return "pos = ogs_tlv_write_%s(pos, TLV_MODE,\n" % kind + indent + \
+        "        OGS_GTP_%s_TYPE, %d, &%s);\n" % (v_upper(field["type"]), field["instance"], ref)
+
+def ie_read(field, ref, indent):
+    kind = ie_kind(field["type"])
+    if kind == "group":
+        return indent + "if (tlv_read_%s(&%s, pos, len) != OGS_OK)\n" % (v_lower(field["type"]), ref) + \
+            indent + "    return OGS_ERROR;\n" + \
+            indent + "%s.presence = 1;\n" % ref
+    return indent + "if (ogs_tlv_read_%s(&%s, pos, len) != OGS_OK)\n" % (kind, ref) + \
+        indent + "    return OGS_ERROR;\n"
+
+def output_codec(f, prefix, name, ctype, fields):
+    more = len([field for field in fields if field["more"]]) != 0
+
+    f.write("static uint32_t %s_length_%s(%s *ie)\n" % (prefix, name, ctype))
+    f.write("{\n")
+    f.write("    uint32_t length = 0;\n")
+    if more:
+        f.write("    int i;\n")
+    f.write("\n")
+    for field in fields:
+        ref = "ie->" + field["name"]
+        if field["more"]:
+            f.write("    for (i = 0; i < %d && %s[i].presence; i++)\n" % (field["more"], ref))
+            f.write("        length += %s;\n" % ie_length(field, ref + "[i]"))
+        else:
+            f.write("    if (%s.presence)\n" % ref)
+            f.write("        length += %s;\n" % ie_length(field, ref))
+    f.write("\n")
+    f.write("    return length;\n")
+    f.write("}\n\n")
+
+    f.write("static uint8_t *%s_write_%s(uint8_t *pos, %s *ie)\n" % (prefix, name, ctype))
+    f.write("{\n")
+    if more:
+        f.write("    int i;\n\n")
+    for field in fields:
+        ref = "ie->" + field["name"]
+        if field["more"]:
+            f.write("    for (i = 0; i < %d && %s[i].presence; i++)\n" % (field["more"], ref))
+            f.write("        " + ie_write(field, ref + "[i]", "        "))
+        else:
+            f.write("    if (%s.presence)\n" % ref)
+            f.write("        " + ie_write(field, ref, "        "))
+    if len(fields):
+        f.write("\n")
+    f.write("    return pos;\n")
+    f.write("}\n\n")
+
+    f.write("static int %s_read_%s(%s *ie, uint8_t *pos, uint32_t length)\n" % (prefix, name, ctype))
+    f.write("{\n")
+    f.write("    uint8_t *end = pos + length;\n")
+    f.write("    uint16_t type, len;\n")
+    f.write("    uint8_t instance;\n")
+    if more:
+        f.write("    int i;\n")
+    f.write("\n")
+    f.write("    while (pos < end) {\n")
+    f.write("        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);\n")
+    f.write("        if (!pos)\n")
+    f.write("            return OGS_ERROR;\n")
+    f.write("\n")
+    f.write("        switch (type) {\n")
+    types = []
+    for field in fields:
+        if field["type"] not in types:
+            types.append(field["type"])
+    for type in types:
+        f.write("        case OGS_GTP_%s_TYPE:\n" % v_upper(type))
+        instances = []
+        for field in fields:
+            # The first IE of the same type and instance gets the value
+            if field["type"] != type or field["instance"] in instances:
+                continue
+            ref = "ie->" + field["name"]
+            if len(instances) == 0:
+                f.write("            if (instance == %d) {\n" % field["instance"])
+            else:
+                f.write("            } else if (instance == %d) {\n" % field["instance"])
+            instances.append(field["instance"])
+            if field["more"]:
+                f.write("                for (i = 0; i < %d && %s[i].presence; i++);\n" % (field["more"], ref))
+                f.write("                if (i == %d) {\n" % field["more"])
+                f.write("                    ogs_fatal(\"Multiple of the same type TLV need more room\");\n")
+                f.write("                    ogs_assert_if_reached();\n")
+                f.write("                    break;\n")
+                f.write("                }\n")
+                f.write(ie_read(field, ref + "[i]", "                "))
+            else:
+                f.write(ie_read(field, ref, "                "))
+        f.write("            } else\n")
+        f.write("                ogs_warn(\"Unknown TLV type [%d]\", type);\n")
+        f.write("            break;\n")
+    f.write("        default:\n")
+    f.write("            ogs_warn(\"Unknown TLV type [%d]\", type);\n")
+    f.write("            break;\n")
+    f.write("        }\n")
+    f.write("\n")
+    f.write("        pos += len;\n")
+    f.write("    }\n")
+    f.write("\n")
+    f.write("    return OGS_OK;\n")
+    f.write("}\n\n")
+
+# Group IEs which can be reached from the messages
+used_group_list = []
+def use_group(fields):
+    for field in fields:
+        if field["type"] in group_list.keys() and field["type"] not in used_group_list:
+            used_group_list.append(field["type"])
+            use_group(ie_fields(group_list[field["type"]]["ies"], field["type"]))
+for (k, v) in sorted_msg_list:
+    if "ies" in msg_list[k]:
+        use_group(ie_fields(msg_list[k]["ies"], k))
+
+f.write("/* Direct encoder/decoder */\n")
+f.write("#define TLV_MODE OGS_TLV_MODE_T1_L2_I1\n")
+f.write("#define TLV_HLEN 4\n\n")
+for (k, v) in sorted_group_list:
+    if k not in used_group_list:
+        continue
+    f.write("static uint32_t tlv_length_%s(ogs_gtp_tlv_%s_t *ie);\n" % (v_lower(k), v_lower(k)))
+    f.write("static uint8_t *tlv_write_%s(uint8_t *pos, ogs_gtp_tlv_%s_t *ie);\n" % (v_lower(k), v_lower(k)))
+    f.write("static int tlv_read_%s(\n        ogs_gtp_tlv_%s_t *ie, uint8_t *pos, uint32_t length);\n" % (v_lower(k), v_lower(k)))
+f.write("\n")
+for (k, v) in sorted_group_list:
+    if k not in used_group_list:
+        continue
+    output_codec(f, "tlv", v_lower(k), "ogs_gtp_tlv_%s_t" % v_lower(k), ie_fields(group_list[k]["ies"], k))
+for (k, v) in sorted_msg_list:
+    if "ies" in msg_list[k]:
+        output_codec(f, "msg", v_lower(k), "ogs_gtp_%s_t" % v_lower(k), ie_fields(msg_list[k]["ies"], k))
+
 f.write("""int ogs_gtp_parse_msg(ogs_gtp_message_t *gtp_message, ogs_pkbuf_t *pkbuf)
 {
     int rv = OGS_ERROR;
@@ -662,8 +831,8 @@ f.write("""int ogs_gtp_parse_msg(ogs_gtp_message_t *gtp_message, ogs_pkbuf_t *pk
 for (k, v) in sorted_msg_list:
     if "ies" in msg_list[k]:
         f.write("    case OGS_GTP_%s_TYPE:\n" % v_upper(k))
-        f.write("        rv = ogs_tlv_parse_msg(&gtp_message->%s,\n" % v_lower(k))
-        f.write("                &ogs_gtp_tlv_desc_%s, pkbuf, OGS_TLV_MODE_T1_L2_I1);\n" % v_lower(k))
+        f.write("        rv = msg_read_%s(&gtp_message->%s,\n" % (v_lower(k), v_lower(k)))
+        f.write("                pkbuf->data, pkbuf->len);\n")
         f.write("        break;\n")
 f.write("""    default:
         ogs_warn("Not implmeneted(type:%d)", gtp_message->h.type);
@@ -680,6 +849,8 @@ f.write("""    default:
 f.write("""ogs_pkbuf_t *ogs_gtp_build_msg(ogs_gtp_message_t *gtp_message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
+    uint8_t *pos = NULL;
+    uint32_t length = 0;
 
     ogs_assert(gtp_message);
     switch(gtp_message->h.type) {
@@ -687,13 +858,32 @@ f.write("""ogs_pkbuf_t *ogs_gtp_build_msg(ogs_gtp_message_t *gtp_message)
 for (k, v) in sorted_msg_list:
     if "ies" in msg_list[k]:
         f.write("    case OGS_GTP_%s_TYPE:\n" % v_upper(k))
-        f.write("        pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_%s,\n" % v_lower(k))
-        f.write("                &gtp_message->%s, OGS_TLV_MODE_T1_L2_I1);\n" % v_lower(k))
+        f.write("        length = msg_length_%s(\n" % v_lower(k))
+        f.write("                &gtp_message->%s);\n" % v_lower(k))
         f.write("        break;\n")
 f.write("""    default:
         ogs_warn("Not implmeneted(type:%d)", gtp_message->h.type);
+        return NULL;
+    }
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_TLV_MAX_HEADROOM+length);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_reserve(pkbuf, OGS_TLV_MAX_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length);
+
+    switch(gtp_message->h.type) {
+""")
+for (k, v) in sorted_msg_list:
+    if "ies" in msg_list[k]:
+        f.write("    case OGS_GTP_%s_TYPE:\n" % v_upper(k))
+        f.write("        pos = msg_write_%s(pkbuf->data,\n" % v_lower(k))
+        f.write("                &gtp_message->%s);\n" % v_lower(k))
+        f.write("        break;\n")
+f.write("""    default:
+        ogs_assert_if_reached();
         break;
     }
+    ogs_assert(pos == pkbuf->data + length);
 
     return pkbuf;
 }
@@ -32,6 +32,12 @@ static uint32_t g_xact_id = 0;
 
 static OGS_POOL(pool, ogs_gtp_xact_t);
 
+static struct {
+    ogs_metrics_t *rx, *tx;
+    ogs_metrics_t *retransmit, *timeout;
+    ogs_metrics_t *xact;
+} metrics;
+
 static ogs_gtp_xact_stage_t ogs_gtp_xact_get_stage(uint8_t type, uint32_t sqn);
 static int ogs_gtp_xact_delete(ogs_gtp_xact_t *xact);
 
@@ -46,6 +52,21 @@ int ogs_gtp_xact_init(void)
 
     g_xact_id = 0;
 
+    metrics.rx = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "gtpv2_messages_received_total",
+            "GTPv2-C messages received by type", NULL, "type", 256, NULL);
+    metrics.tx = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "gtpv2_messages_sent_total",
+            "GTPv2-C messages sent by type", NULL, "type", 256, NULL);
+    metrics.retransmit = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "gtpv2_retransmissions_total",
+            "GTPv2-C messages sent again on timeout or duplicated request",
+            NULL);
+    metrics.timeout = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "gtpv2_response_timeouts_total",
+            "GTPv2-C requests given up without a response", NULL);
+    metrics.xact = ogs_metrics_add_pool(&pool, "gtp_xact");
+
     ogs_gtp_xact_initialized = 1;
 
     return OGS_OK;
@@ -55,6 +76,13 @@ void ogs_gtp_xact_final(void)
 {
     ogs_assert(ogs_gtp_xact_initialized == 1);
 
+    if (metrics.rx) ogs_metrics_remove(metrics.rx);
+    if (metrics.tx) ogs_metrics_remove(metrics.tx);
+    if (metrics.retransmit) ogs_metrics_remove(metrics.retransmit);
+    if (metrics.timeout) ogs_metrics_remove(metrics.timeout);
+    if (metrics.xact) ogs_metrics_remove(metrics.xact);
+    memset(&metrics, 0, sizeof(metrics));
+
     ogs_pool_final(&pool);
 
     ogs_gtp_xact_initialized = 0;
@@ -272,6 +300,8 @@ int ogs_gtp_xact_update_tx(ogs_gtp_xact_t *xact,
     xact->seq[xact->step].type = h->type;
     xact->seq[xact->step].pkbuf = pkbuf;
 
+    ogs_metrics_vector_inc(metrics.tx, h->type);
+
     /* Step */
     xact->step++;
 
@@ -326,6 +356,7 @@ int ogs_gtp_xact_update_rx(ogs_gtp_xact_t *xact, uint8_t type)
                             OGS_PORT(&xact->gnode->addr));
                     rv = ogs_gtp_sendto(xact->gnode, pkbuf);
                     ogs_expect(rv == OGS_OK);
+                    ogs_metrics_inc(metrics.retransmit);
                 } else {
                     ogs_warn("[%d] %s Request Duplicated. Discard!"
                             " for step %d type %d peer [%s]:%d",
@@ -392,6 +423,7 @@ int ogs_gtp_xact_update_rx(ogs_gtp_xact_t *xact, uint8_t type)
                             OGS_PORT(&xact->gnode->addr));
                     rv = ogs_gtp_sendto(xact->gnode, pkbuf);
                     ogs_expect(rv == OGS_OK);
+                    ogs_metrics_inc(metrics.retransmit);
                 } else {
                     ogs_warn("[%d] %s Request Duplicated. Discard!"
                             " for step %d type %d peer [%s]:%d",
@@ -593,7 +625,9 @@ static void response_timeout(void *data)
             ogs_error("ogs_gtp_sendto() failed");
             goto out;
         }
+        ogs_metrics_inc(metrics.retransmit);
     } else {
+        ogs_metrics_inc(metrics.timeout);
         ogs_warn("[%d] %s No Reponse. Give up! "
                 "for step %d type %d peer [%s]:%d",
                 xact->xid,
@@ -658,6 +692,8 @@ int ogs_gtp_xact_receive(
     ogs_assert(gnode);
     ogs_assert(h);
 
+    ogs_metrics_vector_inc(metrics.rx, h->type);
+
     if (h->teid_presence) sqn = h->sqn;
     else sqn = h->sqn_only;
 
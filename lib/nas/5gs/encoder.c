@@ -2806,6 +2806,999 @@ int ogs_nas_5gs_encode_5gsm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *me
     return encoded;
 }
 
+static int ogs_nas_5gs_size_registration_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_request_t *registration_request = &message->gmm.registration_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gs_registration_type_t);
+    size += registration_request->mobile_identity.length + sizeof(registration_request->mobile_identity.length);
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NON_CURRENT_NATIVE_NAS_KEY_SET_IDENTIFIER_PRESENT)
+        size += sizeof(ogs_nas_key_set_identifier_t);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_5GMM_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + registration_request->gmm_capability.length + sizeof(registration_request->gmm_capability.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_SECURITY_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + registration_request->ue_security_capability.length + sizeof(registration_request->ue_security_capability.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_request->requested_nssai.length + sizeof(registration_request->requested_nssai.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_LAST_VISITED_REGISTERED_TAI_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gs_tracking_area_identity_t);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_S1_UE_NETWORK_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + registration_request->s1_ue_network_capability.length + sizeof(registration_request->s1_ue_network_capability.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UPLINK_DATA_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->uplink_data_status.length + sizeof(registration_request->uplink_data_status.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->pdu_session_status.length + sizeof(registration_request->pdu_session_status.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_MICO_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_mico_indication_t);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->ue_status.length + sizeof(registration_request->ue_status.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_ADDITIONAL_GUTI_PRESENT)
+        size += sizeof(uint8_t) + registration_request->additional_guti.length + sizeof(registration_request->additional_guti.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_ALLOWED_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->allowed_pdu_session_status.length + sizeof(registration_request->allowed_pdu_session_status.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_USAGE_SETTING_PRESENT)
+        size += sizeof(uint8_t) + registration_request->ue_usage_setting.length + sizeof(registration_request->ue_usage_setting.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->requested_drx_parameters.length + sizeof(registration_request->requested_drx_parameters.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_EPS_NAS_MESSAGE_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + registration_request->eps_nas_message_container.length + sizeof(registration_request->eps_nas_message_container.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_LADN_INDICATION_PRESENT)
+        size += sizeof(uint8_t) + registration_request->ladn_indication.length + sizeof(registration_request->ladn_indication.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PAYLOAD_CONTAINER_TYPE_PRESENT)
+        size += sizeof(ogs_nas_payload_container_type_t);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PAYLOAD_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + registration_request->payload_container.length + sizeof(registration_request->payload_container.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NETWORK_SLICING_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_network_slicing_indication_t);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_5GS_UPDATE_TYPE_PRESENT)
+        size += sizeof(uint8_t) + registration_request->update_type.length + sizeof(registration_request->update_type.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_MOBILE_STATION_CLASSMARK_2_PRESENT)
+        size += sizeof(uint8_t) + registration_request->mobile_station_classmark_2.length + sizeof(registration_request->mobile_station_classmark_2.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_SUPPORTED_CODECS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->supported_codecs.length + sizeof(registration_request->supported_codecs.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NAS_MESSAGE_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + registration_request->nas_message_container.length + sizeof(registration_request->nas_message_container.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_EPS_BEARER_CONTEXT_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->eps_bearer_context_status.length + sizeof(registration_request->eps_bearer_context_status.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_EXTENDED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + registration_request->requested_extended_drx_parameters.length + sizeof(registration_request->requested_extended_drx_parameters.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_T3324_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_request->t3324_value.length + sizeof(registration_request->t3324_value.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + registration_request->ue_radio_capability_id.length + sizeof(registration_request->ue_radio_capability_id.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_MAPPED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_request->requested_mapped_nssai.length + sizeof(registration_request->requested_mapped_nssai.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_ADDITIONAL_INFORMATION_REQUESTED_PRESENT)
+        size += sizeof(uint8_t) + registration_request->additional_information_requested.length + sizeof(registration_request->additional_information_requested.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_WUS_ASSISTANCE_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + registration_request->requested_wus_assistance_information.length + sizeof(registration_request->requested_wus_assistance_information.length);
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_N5GC_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_n5gc_indication_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_registration_accept(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_accept_t *registration_accept = &message->gmm.registration_accept;
+    int size = 0;
+
+    size += registration_accept->registration_result.length + sizeof(registration_accept->registration_result.length);
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_5G_GUTI_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->guti.length + sizeof(registration_accept->guti.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EQUIVALENT_PLMNS_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->equivalent_plmns.length + sizeof(registration_accept->equivalent_plmns.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_TAI_LIST_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->tai_list.length + sizeof(registration_accept->tai_list.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_ALLOWED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->allowed_nssai.length + sizeof(registration_accept->allowed_nssai.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_REJECTED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->rejected_nssai.length + sizeof(registration_accept->rejected_nssai.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_CONFIGURED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->configured_nssai.length + sizeof(registration_accept->configured_nssai.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_5GS_NETWORK_FEATURE_SUPPORT_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->network_feature_support.length + sizeof(registration_accept->network_feature_support.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->pdu_session_status.length + sizeof(registration_accept->pdu_session_status.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->pdu_session_reactivation_result.length + sizeof(registration_accept->pdu_session_reactivation_result.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_ERROR_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->pdu_session_reactivation_result_error_cause.length + sizeof(registration_accept->pdu_session_reactivation_result_error_cause.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_LADN_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->ladn_information.length + sizeof(registration_accept->ladn_information.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_MICO_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_mico_indication_t);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NETWORK_SLICING_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_network_slicing_indication_t);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_SERVICE_AREA_LIST_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->service_area_list.length + sizeof(registration_accept->service_area_list.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3512_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->t3512_value.length + sizeof(registration_accept->t3512_value.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NON_3GPP_DE_REGISTRATION_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->non_3gpp_de_registration_timer_value.length + sizeof(registration_accept->non_3gpp_de_registration_timer_value.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3502_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->t3502_value.length + sizeof(registration_accept->t3502_value.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EMERGENCY_NUMBER_LIST_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->emergency_number_list.length + sizeof(registration_accept->emergency_number_list.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EXTENDED_EMERGENCY_NUMBER_LIST_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->extended_emergency_number_list.length + sizeof(registration_accept->extended_emergency_number_list.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_SOR_TRANSPARENT_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->sor_transparent_container.length + sizeof(registration_accept->sor_transparent_container.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->eap_message.length + sizeof(registration_accept->eap_message.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NSSAI_INCLUSION_MODE_PRESENT)
+        size += sizeof(ogs_nas_nssai_inclusion_mode_t);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_OPERATOR_DEFINED_ACCESS_CATEGORY_DEFINITIONS_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->operator_defined_access_category_definitions.length + sizeof(registration_accept->operator_defined_access_category_definitions.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->negotiated_drx_parameters.length + sizeof(registration_accept->negotiated_drx_parameters.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NON_3GPP_NW_POLICIES_PRESENT)
+        size += sizeof(ogs_nas_non_3gpp_nw_provided_policies_t);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EPS_BEARER_CONTEXT_STATUS_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->eps_bearer_context_status.length + sizeof(registration_accept->eps_bearer_context_status.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_EXTENDED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->negotiated_extended_drx_parameters.length + sizeof(registration_accept->negotiated_extended_drx_parameters.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3447_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->t3447_value.length + sizeof(registration_accept->t3447_value.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3448_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->t3448_value.length + sizeof(registration_accept->t3448_value.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3324_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->t3324_value.length + sizeof(registration_accept->t3324_value.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->ue_radio_capability_id.length + sizeof(registration_accept->ue_radio_capability_id.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PENDING_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->pending_nssai.length + sizeof(registration_accept->pending_nssai.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_CIPHERING_KEY_DATA_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->ciphering_key_data.length + sizeof(registration_accept->ciphering_key_data.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_CAG_INFORMATION_LIST_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->cag_information_list.length + sizeof(registration_accept->cag_information_list.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_TRUNCATED_5G_S_TMSI_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->truncated_s_tmsi_configuration.length + sizeof(registration_accept->truncated_s_tmsi_configuration.length);
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_WUS_ASSISTANCE_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + registration_accept->negotiated_wus_assistance_information.length + sizeof(registration_accept->negotiated_wus_assistance_information.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_registration_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_complete_t *registration_complete = &message->gmm.registration_complete;
+    int size = 0;
+
+    if (registration_complete->presencemask & OGS_NAS_5GS_REGISTRATION_COMPLETE_SOR_TRANSPARENT_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + registration_complete->sor_transparent_container.length + sizeof(registration_complete->sor_transparent_container.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_registration_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_reject_t *registration_reject = &message->gmm.registration_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gmm_cause_t);
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_reject->t3346_value.length + sizeof(registration_reject->t3346_value.length);
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3502_VALUE_PRESENT)
+        size += sizeof(uint8_t) + registration_reject->t3502_value.length + sizeof(registration_reject->t3502_value.length);
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + registration_reject->eap_message.length + sizeof(registration_reject->eap_message.length);
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_REJECTED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + registration_reject->rejected_nssai.length + sizeof(registration_reject->rejected_nssai.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_deregistration_request_to_ue(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_deregistration_request_to_ue_t *deregistration_request_to_ue = &message->gmm.deregistration_request_to_ue;
+    int size = 0;
+
+    size += sizeof(ogs_nas_de_registration_type_t);
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_5GMM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gmm_cause_t);
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_T3346_VALUE_PRESENT)
+        size += sizeof(uint8_t) + deregistration_request_to_ue->t3346_value.length + sizeof(deregistration_request_to_ue->t3346_value.length);
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_REJECTED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + deregistration_request_to_ue->rejected_nssai.length + sizeof(deregistration_request_to_ue->rejected_nssai.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_service_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_service_request_t *service_request = &message->gmm.service_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_key_set_identifier_t);
+    size += service_request->s_tmsi.length + sizeof(service_request->s_tmsi.length);
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_UPLINK_DATA_STATUS_PRESENT)
+        size += sizeof(uint8_t) + service_request->uplink_data_status.length + sizeof(service_request->uplink_data_status.length);
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + service_request->pdu_session_status.length + sizeof(service_request->pdu_session_status.length);
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_ALLOWED_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + service_request->allowed_pdu_session_status.length + sizeof(service_request->allowed_pdu_session_status.length);
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_NAS_MESSAGE_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + service_request->nas_message_container.length + sizeof(service_request->nas_message_container.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_service_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_service_reject_t *service_reject = &message->gmm.service_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gmm_cause_t);
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + service_reject->pdu_session_status.length + sizeof(service_reject->pdu_session_status.length);
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_T3346_VALUE_PRESENT)
+        size += sizeof(uint8_t) + service_reject->t3346_value.length + sizeof(service_reject->t3346_value.length);
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + service_reject->eap_message.length + sizeof(service_reject->eap_message.length);
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_T3448_VALUE_PRESENT)
+        size += sizeof(uint8_t) + service_reject->t3448_value.length + sizeof(service_reject->t3448_value.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_service_accept(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_service_accept_t *service_accept = &message->gmm.service_accept;
+    int size = 0;
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + service_accept->pdu_session_status.length + sizeof(service_accept->pdu_session_status.length);
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_PRESENT)
+        size += sizeof(uint8_t) + service_accept->pdu_session_reactivation_result.length + sizeof(service_accept->pdu_session_reactivation_result.length);
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_ERROR_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + service_accept->pdu_session_reactivation_result_error_cause.length + sizeof(service_accept->pdu_session_reactivation_result_error_cause.length);
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + service_accept->eap_message.length + sizeof(service_accept->eap_message.length);
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_T3448_VALUE_PRESENT)
+        size += sizeof(uint8_t) + service_accept->t3448_value.length + sizeof(service_accept->t3448_value.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_configuration_update_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_configuration_update_command_t *configuration_update_command = &message->gmm.configuration_update_command;
+    int size = 0;
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_CONFIGURATION_UPDATE_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_configuration_update_indication_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_5G_GUTI_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->guti.length + sizeof(configuration_update_command->guti.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_TAI_LIST_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->tai_list.length + sizeof(configuration_update_command->tai_list.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_ALLOWED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->allowed_nssai.length + sizeof(configuration_update_command->allowed_nssai.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SERVICE_AREA_LIST_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->service_area_list.length + sizeof(configuration_update_command->service_area_list.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_FULL_NAME_FOR_NETWORK_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->full_name_for_network.length + sizeof(configuration_update_command->full_name_for_network.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SHORT_NAME_FOR_NETWORK_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->short_name_for_network.length + sizeof(configuration_update_command->short_name_for_network.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LOCAL_TIME_ZONE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_time_zone_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UNIVERSAL_TIME_AND_LOCAL_TIME_ZONE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_time_zone_and_time_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NETWORK_DAYLIGHT_SAVING_TIME_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->network_daylight_saving_time.length + sizeof(configuration_update_command->network_daylight_saving_time.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LADN_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->ladn_information.length + sizeof(configuration_update_command->ladn_information.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_MICO_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_mico_indication_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NETWORK_SLICING_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_network_slicing_indication_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_CONFIGURED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->configured_nssai.length + sizeof(configuration_update_command->configured_nssai.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_REJECTED_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->rejected_nssai.length + sizeof(configuration_update_command->rejected_nssai.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_OPERATOR_DEFINED_ACCESS_CATEGORY_DEFINITIONS_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->operator_defined_access_category_definitions.length + sizeof(configuration_update_command->operator_defined_access_category_definitions.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SMS_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_sms_indication_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_T3447_VALUE_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->t3447_value.length + sizeof(configuration_update_command->t3447_value.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_CAG_INFORMATION_LIST_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->cag_information_list.length + sizeof(configuration_update_command->cag_information_list.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->ue_radio_capability_id.length + sizeof(configuration_update_command->ue_radio_capability_id.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_5GS_REGISTRATION_RESULT_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->registration_result.length + sizeof(configuration_update_command->registration_result.length);
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_TRUNCATED_5G_S_TMSI_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + configuration_update_command->truncated_s_tmsi_configuration.length + sizeof(configuration_update_command->truncated_s_tmsi_configuration.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_authentication_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_request_t *authentication_request = &message->gmm.authentication_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_key_set_identifier_t);
+    size += authentication_request->abba.length + sizeof(authentication_request->abba.length);
+
+    if (authentication_request->presencemask & OGS_NAS_5GS_AUTHENTICATION_REQUEST_AUTHENTICATION_PARAMETER_RAND_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_authentication_parameter_rand_t);
+    if (authentication_request->presencemask & OGS_NAS_5GS_AUTHENTICATION_REQUEST_AUTHENTICATION_PARAMETER_AUTN_PRESENT)
+        size += sizeof(uint8_t) + authentication_request->authentication_parameter_autn.length + sizeof(authentication_request->authentication_parameter_autn.length);
+    if (authentication_request->presencemask & OGS_NAS_5GS_AUTHENTICATION_REQUEST_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + authentication_request->eap_message.length + sizeof(authentication_request->eap_message.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_authentication_response(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_response_t *authentication_response = &message->gmm.authentication_response;
+    int size = 0;
+
+    if (authentication_response->presencemask & OGS_NAS_5GS_AUTHENTICATION_RESPONSE_AUTHENTICATION_RESPONSE_PARAMETER_PRESENT)
+        size += sizeof(uint8_t) + authentication_response->authentication_response_parameter.length + sizeof(authentication_response->authentication_response_parameter.length);
+    if (authentication_response->presencemask & OGS_NAS_5GS_AUTHENTICATION_RESPONSE_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + authentication_response->eap_message.length + sizeof(authentication_response->eap_message.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_authentication_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_reject_t *authentication_reject = &message->gmm.authentication_reject;
+    int size = 0;
+
+    if (authentication_reject->presencemask & OGS_NAS_5GS_AUTHENTICATION_REJECT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + authentication_reject->eap_message.length + sizeof(authentication_reject->eap_message.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_authentication_failure(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_failure_t *authentication_failure = &message->gmm.authentication_failure;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gmm_cause_t);
+
+    if (authentication_failure->presencemask & OGS_NAS_5GS_AUTHENTICATION_FAILURE_AUTHENTICATION_FAILURE_PARAMETER_PRESENT)
+        size += sizeof(uint8_t) + authentication_failure->authentication_failure_parameter.length + sizeof(authentication_failure->authentication_failure_parameter.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_authentication_result(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_result_t *authentication_result = &message->gmm.authentication_result;
+    int size = 0;
+
+    size += sizeof(ogs_nas_key_set_identifier_t);
+    size += authentication_result->eap_message.length + sizeof(authentication_result->eap_message.length);
+
+    if (authentication_result->presencemask & OGS_NAS_5GS_AUTHENTICATION_RESULT_ABBA_PRESENT)
+        size += sizeof(uint8_t) + authentication_result->abba.length + sizeof(authentication_result->abba.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_identity_request(ogs_nas_5gs_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gs_identity_type_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_identity_response(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_identity_response_t *identity_response = &message->gmm.identity_response;
+    int size = 0;
+
+    size += identity_response->mobile_identity.length + sizeof(identity_response->mobile_identity.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_security_mode_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_security_mode_command_t *security_mode_command = &message->gmm.security_mode_command;
+    int size = 0;
+
+    size += sizeof(ogs_nas_security_algorithms_t);
+    size += sizeof(ogs_nas_key_set_identifier_t);
+    size += security_mode_command->replayed_ue_security_capabilities.length + sizeof(security_mode_command->replayed_ue_security_capabilities.length);
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_IMEISV_REQUEST_PRESENT)
+        size += sizeof(ogs_nas_imeisv_request_t);
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_SELECTED_EPS_NAS_SECURITY_ALGORITHMS_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_eps_nas_security_algorithms_t);
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_ADDITIONAL_5G_SECURITY_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + security_mode_command->additional_security_information.length + sizeof(security_mode_command->additional_security_information.length);
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + security_mode_command->eap_message.length + sizeof(security_mode_command->eap_message.length);
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_ABBA_PRESENT)
+        size += sizeof(uint8_t) + security_mode_command->abba.length + sizeof(security_mode_command->abba.length);
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_REPLAYED_S1_UE_SECURITY_CAPABILITIES_PRESENT)
+        size += sizeof(uint8_t) + security_mode_command->replayed_s1_ue_security_capabilities.length + sizeof(security_mode_command->replayed_s1_ue_security_capabilities.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_security_mode_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_security_mode_complete_t *security_mode_complete = &message->gmm.security_mode_complete;
+    int size = 0;
+
+    if (security_mode_complete->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMPLETE_IMEISV_PRESENT)
+        size += sizeof(uint8_t) + security_mode_complete->imeisv.length + sizeof(security_mode_complete->imeisv.length);
+    if (security_mode_complete->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMPLETE_NAS_MESSAGE_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + security_mode_complete->nas_message_container.length + sizeof(security_mode_complete->nas_message_container.length);
+    if (security_mode_complete->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMPLETE_NON_IMEISV_PEI_PRESENT)
+        size += sizeof(uint8_t) + security_mode_complete->non_imeisv_pei.length + sizeof(security_mode_complete->non_imeisv_pei.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_security_mode_reject(ogs_nas_5gs_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gmm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_5gmm_status(ogs_nas_5gs_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gmm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_notification(ogs_nas_5gs_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_access_type_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_notification_response(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_notification_response_t *notification_response = &message->gmm.notification_response;
+    int size = 0;
+
+    if (notification_response->presencemask & OGS_NAS_5GS_NOTIFICATION_RESPONSE_PDU_SESSION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + notification_response->pdu_session_status.length + sizeof(notification_response->pdu_session_status.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_ul_nas_transport(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_ul_nas_transport_t *ul_nas_transport = &message->gmm.ul_nas_transport;
+    int size = 0;
+
+    size += sizeof(ogs_nas_payload_container_type_t);
+    size += ul_nas_transport->payload_container.length + sizeof(ul_nas_transport->payload_container.length);
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_PDU_SESSION_ID_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_pdu_session_identity_2_t);
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_OLD_PDU_SESSION_ID_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_pdu_session_identity_2_t);
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_REQUEST_TYPE_PRESENT)
+        size += sizeof(ogs_nas_request_type_t);
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_S_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + ul_nas_transport->s_nssai.length + sizeof(ul_nas_transport->s_nssai.length);
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_DNN_PRESENT)
+        size += sizeof(uint8_t) + ul_nas_transport->dnn.length + sizeof(ul_nas_transport->dnn.length) + 1;
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + ul_nas_transport->additional_information.length + sizeof(ul_nas_transport->additional_information.length);
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_MA_PDU_SESSION_INFORMATION_PRESENT)
+        size += sizeof(ogs_nas_ma_pdu_session_information_t);
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_RELEASE_ASSISTANCE_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_release_assistance_indication_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_dl_nas_transport(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_dl_nas_transport_t *dl_nas_transport = &message->gmm.dl_nas_transport;
+    int size = 0;
+
+    size += sizeof(ogs_nas_payload_container_type_t);
+    size += dl_nas_transport->payload_container.length + sizeof(dl_nas_transport->payload_container.length);
+
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_PDU_SESSION_ID_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_pdu_session_identity_2_t);
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + dl_nas_transport->additional_information.length + sizeof(dl_nas_transport->additional_information.length);
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_5GMM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gmm_cause_t);
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + dl_nas_transport->back_off_timer_value.length + sizeof(dl_nas_transport->back_off_timer_value.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_establishment_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_establishment_request_t *pdu_session_establishment_request = &message->gsm.pdu_session_establishment_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_integrity_protection_maximum_data_rate_t);
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_PDU_SESSION_TYPE_PRESENT)
+        size += sizeof(ogs_nas_pdu_session_type_t);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_SSC_MODE_PRESENT)
+        size += sizeof(ogs_nas_ssc_mode_t);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_5GSM_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->gsm_capability.length + sizeof(pdu_session_establishment_request->gsm_capability.length);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_MAXIMUM_NUMBER_OF_SUPPORTED_PACKET_FILTERS_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_maximum_number_of_supported_packet_filters_t);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_ALWAYS_ON_PDU_SESSION_REQUESTED_PRESENT)
+        size += sizeof(ogs_nas_always_on_pdu_session_requested_t);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_SM_PDU_DN_REQUEST_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->sm_pdu_dn_request_container.length + sizeof(pdu_session_establishment_request->sm_pdu_dn_request_container.length);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->extended_protocol_configuration_options.length + sizeof(pdu_session_establishment_request->extended_protocol_configuration_options.length);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->header_compression_configuration.length + sizeof(pdu_session_establishment_request->header_compression_configuration.length);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_DS_TT_ETHERNET_PORT_MAC_ADDRESS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->ds_tt_ethernet_port_mac_address.length + sizeof(pdu_session_establishment_request->ds_tt_ethernet_port_mac_address.length);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_UE_DS_TT_RESIDENCE_TIME_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->ue_ds_tt_residence_time.length + sizeof(pdu_session_establishment_request->ue_ds_tt_residence_time.length);
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_request->port_management_information_container.length + sizeof(pdu_session_establishment_request->port_management_information_container.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_establishment_accept(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_establishment_accept_t *pdu_session_establishment_accept = &message->gsm.pdu_session_establishment_accept;
+    int size = 0;
+
+    size += sizeof(ogs_nas_pdu_session_type_t);
+    size += pdu_session_establishment_accept->authorized_qos_rules.length + sizeof(pdu_session_establishment_accept->authorized_qos_rules.length);
+    size += pdu_session_establishment_accept->session_ambr.length + sizeof(pdu_session_establishment_accept->session_ambr.length);
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_5GSM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gsm_cause_t);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_PDU_ADDRESS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->pdu_address.length + sizeof(pdu_session_establishment_accept->pdu_address.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_RQ_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_S_NSSAI_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->s_nssai.length + sizeof(pdu_session_establishment_accept->s_nssai.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_ALWAYS_ON_PDU_SESSION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_always_on_pdu_session_indication_t);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_MAPPED_EPS_BEARER_CONTEXTS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->mapped_eps_bearer_contexts.length + sizeof(pdu_session_establishment_accept->mapped_eps_bearer_contexts.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->eap_message.length + sizeof(pdu_session_establishment_accept->eap_message.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_AUTHORIZED_QOS_FLOW_DESCRIPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->authorized_qos_flow_descriptions.length + sizeof(pdu_session_establishment_accept->authorized_qos_flow_descriptions.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->extended_protocol_configuration_options.length + sizeof(pdu_session_establishment_accept->extended_protocol_configuration_options.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_DNN_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->dnn.length + sizeof(pdu_session_establishment_accept->dnn.length) + 1;
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_5GSM_NETWORK_FEATURE_SUPPORT_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->gsm_network_feature_support.length + sizeof(pdu_session_establishment_accept->gsm_network_feature_support.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_SERVING_PLMN_RATE_CONTROL_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->serving_plmn_rate_control.length + sizeof(pdu_session_establishment_accept->serving_plmn_rate_control.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_ATSSS_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->atsss_container.length + sizeof(pdu_session_establishment_accept->atsss_container.length);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_CONTROL_PLANE_ONLY_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_control_plane_only_indication_t);
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_accept->header_compression_configuration.length + sizeof(pdu_session_establishment_accept->header_compression_configuration.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_establishment_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_establishment_reject_t *pdu_session_establishment_reject = &message->gsm.pdu_session_establishment_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gsm_cause_t);
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_reject->back_off_timer_value.length + sizeof(pdu_session_establishment_reject->back_off_timer_value.length);
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_ALLOWED_SSC_MODE_PRESENT)
+        size += sizeof(ogs_nas_allowed_ssc_mode_t);
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_reject->eap_message.length + sizeof(pdu_session_establishment_reject->eap_message.length);
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_reject->extended_protocol_configuration_options.length + sizeof(pdu_session_establishment_reject->extended_protocol_configuration_options.length);
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_reject->re_attempt_indicator.length + sizeof(pdu_session_establishment_reject->re_attempt_indicator.length);
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_5GSM_CONGESTION_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_establishment_reject->gsm_congestion_re_attempt_indicator.length + sizeof(pdu_session_establishment_reject->gsm_congestion_re_attempt_indicator.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_authentication_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_authentication_command_t *pdu_session_authentication_command = &message->gsm.pdu_session_authentication_command;
+    int size = 0;
+
+    size += pdu_session_authentication_command->eap_message.length + sizeof(pdu_session_authentication_command->eap_message.length);
+
+    if (pdu_session_authentication_command->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMMAND_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_authentication_command->extended_protocol_configuration_options.length + sizeof(pdu_session_authentication_command->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_authentication_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_authentication_complete_t *pdu_session_authentication_complete = &message->gsm.pdu_session_authentication_complete;
+    int size = 0;
+
+    size += pdu_session_authentication_complete->eap_message.length + sizeof(pdu_session_authentication_complete->eap_message.length);
+
+    if (pdu_session_authentication_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMPLETE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_authentication_complete->extended_protocol_configuration_options.length + sizeof(pdu_session_authentication_complete->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_authentication_result(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_authentication_result_t *pdu_session_authentication_result = &message->gsm.pdu_session_authentication_result;
+    int size = 0;
+
+    if (pdu_session_authentication_result->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_RESULT_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_authentication_result->eap_message.length + sizeof(pdu_session_authentication_result->eap_message.length);
+    if (pdu_session_authentication_result->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_RESULT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_authentication_result->extended_protocol_configuration_options.length + sizeof(pdu_session_authentication_result->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_modification_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_request_t *pdu_session_modification_request = &message->gsm.pdu_session_modification_request;
+    int size = 0;
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_5GSM_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->gsm_capability.length + sizeof(pdu_session_modification_request->gsm_capability.length);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_5GSM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gsm_cause_t);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_MAXIMUM_NUMBER_OF_SUPPORTED_PACKET_FILTERS_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_maximum_number_of_supported_packet_filters_t);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_ALWAYS_ON_PDU_SESSION_REQUESTED_PRESENT)
+        size += sizeof(ogs_nas_always_on_pdu_session_requested_t);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_INTEGRITY_PROTECTION_MAXIMUM_DATA_RATE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_integrity_protection_maximum_data_rate_t);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_REQUESTED_QOS_RULES_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->requested_qos_rules.length + sizeof(pdu_session_modification_request->requested_qos_rules.length);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_REQUESTED_QOS_FLOW_DESCRIPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->requested_qos_flow_descriptions.length + sizeof(pdu_session_modification_request->requested_qos_flow_descriptions.length);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_MAPPED_EPS_BEARER_CONTEXTS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->mapped_eps_bearer_contexts.length + sizeof(pdu_session_modification_request->mapped_eps_bearer_contexts.length);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->extended_protocol_configuration_options.length + sizeof(pdu_session_modification_request->extended_protocol_configuration_options.length);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->port_management_information_container.length + sizeof(pdu_session_modification_request->port_management_information_container.length);
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_request->header_compression_configuration.length + sizeof(pdu_session_modification_request->header_compression_configuration.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_modification_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_reject_t *pdu_session_modification_reject = &message->gsm.pdu_session_modification_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gsm_cause_t);
+
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_reject->back_off_timer_value.length + sizeof(pdu_session_modification_reject->back_off_timer_value.length);
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_reject->extended_protocol_configuration_options.length + sizeof(pdu_session_modification_reject->extended_protocol_configuration_options.length);
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_reject->re_attempt_indicator.length + sizeof(pdu_session_modification_reject->re_attempt_indicator.length);
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_5GSM_CONGESTION_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_reject->gsm_congestion_re_attempt_indicator.length + sizeof(pdu_session_modification_reject->gsm_congestion_re_attempt_indicator.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_modification_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_command_t *pdu_session_modification_command = &message->gsm.pdu_session_modification_command;
+    int size = 0;
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_5GSM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gsm_cause_t);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_SESSION_AMBR_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->session_ambr.length + sizeof(pdu_session_modification_command->session_ambr.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_RQ_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_ALWAYS_ON_PDU_SESSION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_always_on_pdu_session_indication_t);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_AUTHORIZED_QOS_RULES_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->authorized_qos_rules.length + sizeof(pdu_session_modification_command->authorized_qos_rules.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_MAPPED_EPS_BEARER_CONTEXTS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->mapped_eps_bearer_contexts.length + sizeof(pdu_session_modification_command->mapped_eps_bearer_contexts.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_AUTHORIZED_QOS_FLOW_DESCRIPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->authorized_qos_flow_descriptions.length + sizeof(pdu_session_modification_command->authorized_qos_flow_descriptions.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->extended_protocol_configuration_options.length + sizeof(pdu_session_modification_command->extended_protocol_configuration_options.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_ATSSS_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->atsss_container.length + sizeof(pdu_session_modification_command->atsss_container.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->header_compression_configuration.length + sizeof(pdu_session_modification_command->header_compression_configuration.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->port_management_information_container.length + sizeof(pdu_session_modification_command->port_management_information_container.length);
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_SERVING_PLMN_RATE_CONTROL_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command->serving_plmn_rate_control.length + sizeof(pdu_session_modification_command->serving_plmn_rate_control.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_modification_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_complete_t *pdu_session_modification_complete = &message->gsm.pdu_session_modification_complete;
+    int size = 0;
+
+    if (pdu_session_modification_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMPLETE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_complete->extended_protocol_configuration_options.length + sizeof(pdu_session_modification_complete->extended_protocol_configuration_options.length);
+    if (pdu_session_modification_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMPLETE_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_complete->port_management_information_container.length + sizeof(pdu_session_modification_complete->port_management_information_container.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_modification_command_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_command_reject_t *pdu_session_modification_command_reject = &message->gsm.pdu_session_modification_command_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gsm_cause_t);
+
+    if (pdu_session_modification_command_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_modification_command_reject->extended_protocol_configuration_options.length + sizeof(pdu_session_modification_command_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_release_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_request_t *pdu_session_release_request = &message->gsm.pdu_session_release_request;
+    int size = 0;
+
+    if (pdu_session_release_request->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_REQUEST_5GSM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gsm_cause_t);
+    if (pdu_session_release_request->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_request->extended_protocol_configuration_options.length + sizeof(pdu_session_release_request->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_release_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_reject_t *pdu_session_release_reject = &message->gsm.pdu_session_release_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gsm_cause_t);
+
+    if (pdu_session_release_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_reject->extended_protocol_configuration_options.length + sizeof(pdu_session_release_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_release_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_command_t *pdu_session_release_command = &message->gsm.pdu_session_release_command;
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gsm_cause_t);
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_command->back_off_timer_value.length + sizeof(pdu_session_release_command->back_off_timer_value.length);
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_EAP_MESSAGE_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_command->eap_message.length + sizeof(pdu_session_release_command->eap_message.length);
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_5GSM_CONGESTION_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_command->gsm_congestion_re_attempt_indicator.length + sizeof(pdu_session_release_command->gsm_congestion_re_attempt_indicator.length);
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_command->extended_protocol_configuration_options.length + sizeof(pdu_session_release_command->extended_protocol_configuration_options.length);
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_ACCESS_TYPE_PRESENT)
+        size += sizeof(ogs_nas_access_type_t);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_pdu_session_release_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_complete_t *pdu_session_release_complete = &message->gsm.pdu_session_release_complete;
+    int size = 0;
+
+    if (pdu_session_release_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMPLETE_5GSM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_5gsm_cause_t);
+    if (pdu_session_release_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMPLETE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdu_session_release_complete->extended_protocol_configuration_options.length + sizeof(pdu_session_release_complete->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_5gs_size_5gsm_status(ogs_nas_5gs_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_5gsm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_5gmm_size(ogs_nas_5gs_message_t *message)
+{
+    int size = sizeof(ogs_nas_5gmm_header_t);
+
+    switch(message->gmm.h.message_type) {
+    case OGS_NAS_5GS_REGISTRATION_REQUEST:
+        size += ogs_nas_5gs_size_registration_request(message);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_ACCEPT:
+        size += ogs_nas_5gs_size_registration_accept(message);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_COMPLETE:
+        size += ogs_nas_5gs_size_registration_complete(message);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_REJECT:
+        size += ogs_nas_5gs_size_registration_reject(message);
+        break;
+    case OGS_NAS_5GS_DEREGISTRATION_REQUEST:
+        size += ogs_nas_5gs_size_deregistration_request_to_ue(message);
+        break;
+    case OGS_NAS_5GS_SERVICE_REQUEST:
+        size += ogs_nas_5gs_size_service_request(message);
+        break;
+    case OGS_NAS_5GS_SERVICE_REJECT:
+        size += ogs_nas_5gs_size_service_reject(message);
+        break;
+    case OGS_NAS_5GS_SERVICE_ACCEPT:
+        size += ogs_nas_5gs_size_service_accept(message);
+        break;
+    case OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND:
+        size += ogs_nas_5gs_size_configuration_update_command(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_REQUEST:
+        size += ogs_nas_5gs_size_authentication_request(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_RESPONSE:
+        size += ogs_nas_5gs_size_authentication_response(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_REJECT:
+        size += ogs_nas_5gs_size_authentication_reject(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_FAILURE:
+        size += ogs_nas_5gs_size_authentication_failure(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_RESULT:
+        size += ogs_nas_5gs_size_authentication_result(message);
+        break;
+    case OGS_NAS_5GS_IDENTITY_REQUEST:
+        size += ogs_nas_5gs_size_identity_request(message);
+        break;
+    case OGS_NAS_5GS_IDENTITY_RESPONSE:
+        size += ogs_nas_5gs_size_identity_response(message);
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_COMMAND:
+        size += ogs_nas_5gs_size_security_mode_command(message);
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_COMPLETE:
+        size += ogs_nas_5gs_size_security_mode_complete(message);
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_REJECT:
+        size += ogs_nas_5gs_size_security_mode_reject(message);
+        break;
+    case OGS_NAS_5GS_5GMM_STATUS:
+        size += ogs_nas_5gs_size_5gmm_status(message);
+        break;
+    case OGS_NAS_5GS_NOTIFICATION:
+        size += ogs_nas_5gs_size_notification(message);
+        break;
+    case OGS_NAS_5GS_NOTIFICATION_RESPONSE:
+        size += ogs_nas_5gs_size_notification_response(message);
+        break;
+    case OGS_NAS_5GS_UL_NAS_TRANSPORT:
+        size += ogs_nas_5gs_size_ul_nas_transport(message);
+        break;
+    case OGS_NAS_5GS_DL_NAS_TRANSPORT:
+        size += ogs_nas_5gs_size_dl_nas_transport(message);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+static int ogs_nas_5gsm_size(ogs_nas_5gs_message_t *message)
+{
+    int size = sizeof(ogs_nas_5gsm_header_t);
+
+    switch(message->gsm.h.message_type) {
+    case OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST:
+        size += ogs_nas_5gs_size_pdu_session_establishment_request(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT:
+        size += ogs_nas_5gs_size_pdu_session_establishment_accept(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT:
+        size += ogs_nas_5gs_size_pdu_session_establishment_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMMAND:
+        size += ogs_nas_5gs_size_pdu_session_authentication_command(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMPLETE:
+        size += ogs_nas_5gs_size_pdu_session_authentication_complete(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_RESULT:
+        size += ogs_nas_5gs_size_pdu_session_authentication_result(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST:
+        size += ogs_nas_5gs_size_pdu_session_modification_request(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT:
+        size += ogs_nas_5gs_size_pdu_session_modification_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND:
+        size += ogs_nas_5gs_size_pdu_session_modification_command(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMPLETE:
+        size += ogs_nas_5gs_size_pdu_session_modification_complete(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_REJECT:
+        size += ogs_nas_5gs_size_pdu_session_modification_command_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_REQUEST:
+        size += ogs_nas_5gs_size_pdu_session_release_request(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_REJECT:
+        size += ogs_nas_5gs_size_pdu_session_release_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND:
+        size += ogs_nas_5gs_size_pdu_session_release_command(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_COMPLETE:
+        size += ogs_nas_5gs_size_pdu_session_release_complete(message);
+        break;
+    case OGS_NAS_5GS_5GSM_STATUS:
+        size += ogs_nas_5gs_size_5gsm_status(message);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
 ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
@@ -2815,11 +3808,14 @@ ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_5gmm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_5gmm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -2975,11 +3971,14 @@ ogs_pkbuf_t *ogs_nas_5gsm_encode(ogs_nas_5gs_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_5gsm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_5gsm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -114,6 +114,19 @@ def v_lower(v):
 def get_value(v):
     return re.sub('5gs_', '', re.sub('5g_', '', re.sub('5gsm', 'gsm', re.sub('5gmm', 'gmm', re.sub('\'', '_', re.sub('/', '_', re.sub('-', '_', re.sub(' ', '_', v)))).lower()))))
 
+def size_of_ie(k, ie):
+    t = type_list[ie["type"]]
+    if (t["format"] == "TV" or t["format"] == "T") and t["length"] == "1":
+        return "sizeof(ogs_nas_%s_t)" % v_lower(ie["type"])
+    elif t["format"] == "TV" or t["format"] == "V":
+        if t["length"] == "4":
+            return "3"
+        return "sizeof(ogs_nas_%s_t)" % v_lower(ie["type"])
+    size = "%s->%s.length + sizeof(%s->%s.length)" % (get_value(k), get_value(ie["value"]), get_value(k), get_value(ie["value"]))
+    if "extra_size" in t:
+        size += " + %d" % t["extra_size"]
+    return size
+
 def get_cells(cells):
     iei = cells[0].text.encode('ascii', 'ignore')
     value = re.sub("\s*$", "", re.sub("\s*\n*\s*\([^\)]*\)*", "", re.sub("'s", "", cells[1].text))).encode('ascii', 'ignore')
@@ -842,6 +855,90 @@ for (k, v) in sorted_msg_list:
 """)
 
 
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if len(msg_list[k]["ies"]) == 0:
+        continue
+    if k.find("FROM UE") != -1:
+        continue
+
+    f.write("static int ogs_nas_5gs_size_%s(ogs_nas_5gs_message_t *message)\n{\n" % v_lower(k))
+    used = [ies for ies in msg_list[k]["ies"] if ies["presence"] != "M" or size_of_ie(k, ies).find("->") != -1]
+    if len(used) == 0:
+        pass
+    elif float(msg_list[k]["type"]) < 192:
+        f.write("    ogs_nas_5gs_%s_t *%s = &message->gmm.%s;\n" % (v_lower(k), get_value(k), get_value(k)))
+    else:
+        f.write("    ogs_nas_5gs_%s_t *%s = &message->gsm.%s;\n" % (v_lower(k), get_value(k), get_value(k)))
+    f.write("    int size = 0;\n\n")
+
+    for ie in [ies for ies in msg_list[k]["ies"] if ies["presence"] == "M"]:
+        f.write("    size += %s;\n" % size_of_ie(k, ie))
+
+    if len([ies for ies in msg_list[k]["ies"] if ies["presence"] == "M"]) != 0 and \
+       len([ies for ies in msg_list[k]["ies"] if ies["presence"] != "M"]) != 0:
+        f.write("\n")
+
+    for ie in [ies for ies in msg_list[k]["ies"] if ies["presence"] != "M"]:
+        f.write("    if (%s->presencemask & OGS_NAS_5GS_%s_%s_PRESENT)\n" % (get_value(k), v_upper(k), v_upper(ie["value"])))
+        if ie["length"] == "1" and (ie["format"] == "TV" or ie["format"] == "T"):
+            f.write("        size += %s;\n" % size_of_ie(k, ie))
+        else:
+            f.write("        size += sizeof(uint8_t) + %s;\n" % size_of_ie(k, ie))
+
+    f.write("""
+    return size;
+}
+
+""")
+
+f.write("""static int ogs_nas_5gmm_size(ogs_nas_5gs_message_t *message)
+{
+    int size = sizeof(ogs_nas_5gmm_header_t);
+
+    switch(message->gmm.h.message_type) {
+""")
+
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if float(msg_list[k]["type"]) < 192 and k.find("FROM UE") == -1 and len(msg_list[k]["ies"]) != 0:
+        f.write("    case OGS_NAS_5GS_%s:\n" % v_upper(k))
+        f.write("        size += ogs_nas_5gs_size_%s(message);\n" % v_lower(k))
+        f.write("        break;\n")
+
+f.write("""    default:
+        break;
+    }
+
+    return size;
+}
+
+static int ogs_nas_5gsm_size(ogs_nas_5gs_message_t *message)
+{
+    int size = sizeof(ogs_nas_5gsm_header_t);
+
+    switch(message->gsm.h.message_type) {
+""")
+
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if float(msg_list[k]["type"]) >= 192 and len(msg_list[k]["ies"]) != 0:
+        f.write("    case OGS_NAS_5GS_%s:\n" % v_upper(k))
+        f.write("        size += ogs_nas_5gs_size_%s(message);\n" % v_lower(k))
+        f.write("        break;\n")
+
+f.write("""    default:
+        break;
+    }
+
+    return size;
+}
+
+""")
+
 f.write("""ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
@@ -851,11 +948,14 @@ f.write("""ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_5gmm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_5gmm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -902,11 +1002,14 @@ f.write("""ogs_pkbuf_t *ogs_nas_5gsm_encode(ogs_nas_5gs_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_5gsm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_5gsm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -61,3 +61,6 @@ type_list["PDU session reactivation result"]["decode"] = \
 "    pdu_session_reactivation_result->psi = be16toh(pdu_session_reactivation_result->psi);\n\n"
 type_list["PDU session reactivation result"]["encode"] = \
 "    target.psi = htobe16(pdu_session_reactivation_result->psi);\n\n"
+
+# ogs_fqdn_build() adds the length octet of the first label
+type_list["DNN"]["extra_size"] = 1
@@ -446,3 +446,23 @@ void ogs_nas_bitrate_from_uint64(ogs_nas_bitrate_t *nas, uint64_t bitrate)
     }
     nas->value = bitrate;
 }
+
+void ogs_nas_gprs_timer_2_from_sec(ogs_nas_gprs_timer_2_t *timer, int sec)
+{
+    ogs_assert(timer);
+    ogs_assert(sec >= 0);
+
+    timer->length = 1;
+
+    /* The value is 5 bits, so use the finest unit that can hold it */
+    if (sec <= 2 * 31) {
+        timer->unit = OGS_NAS_GRPS_TIMER_UNIT_MULTIPLES_OF_2_SS;
+        timer->value = sec / 2;
+    } else if (sec <= 60 * 31) {
+        timer->unit = OGS_NAS_GRPS_TIMER_UNIT_MULTIPLES_OF_1_MM;
+        timer->value = sec / 60;
+    } else {
+        timer->unit = OGS_NAS_GRPS_TIMER_UNIT_MULTIPLES_OF_DECI_HH;
+        timer->value = ogs_min(sec / 360, 31);
+    }
+}
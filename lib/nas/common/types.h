@@ -272,6 +272,8 @@ ED2(uint8_t unit:3;,
     uint8_t value:5;)
 } __attribute__ ((packed)) ogs_nas_gprs_timer_2_t;
 
+void ogs_nas_gprs_timer_2_from_sec(ogs_nas_gprs_timer_2_t *timer, int sec);
+
 /* 9.9.3.16B GPRS timer 3
  * See subclause 10.5.7.4a in 3GPP TS 24.008 [13].
  * O TLV 3 */
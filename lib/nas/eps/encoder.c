@@ -3232,6 +3232,1181 @@ int ogs_nas_eps_encode_esm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *mes
     return encoded;
 }
 
+static int ogs_nas_eps_size_attach_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_request_t *attach_request = &message->emm.attach_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_eps_attach_type_t);
+    size += attach_request->eps_mobile_identity.length + sizeof(attach_request->eps_mobile_identity.length);
+    size += attach_request->ue_network_capability.length + sizeof(attach_request->ue_network_capability.length);
+    size += attach_request->esm_message_container.length + sizeof(attach_request->esm_message_container.length);
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_OLD_P_TMSI_SIGNATURE_PRESENT)
+        size += sizeof(uint8_t) + 3;
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_ADDITIONAL_GUTI_PRESENT)
+        size += sizeof(uint8_t) + attach_request->additional_guti.length + sizeof(attach_request->additional_guti.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_LAST_VISITED_REGISTERED_TAI_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_tracking_area_identity_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_DRX_PARAMETER_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_drx_parameter_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MS_NETWORK_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + attach_request->ms_network_capability.length + sizeof(attach_request->ms_network_capability.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_OLD_LOCATION_AREA_IDENTIFICATION_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_location_area_identification_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_TMSI_STATUS_PRESENT)
+        size += sizeof(ogs_nas_tmsi_status_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MOBILE_STATION_CLASSMARK_2_PRESENT)
+        size += sizeof(uint8_t) + attach_request->mobile_station_classmark_2.length + sizeof(attach_request->mobile_station_classmark_2.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MOBILE_STATION_CLASSMARK_3_PRESENT)
+        size += sizeof(uint8_t) + attach_request->mobile_station_classmark_3.length + sizeof(attach_request->mobile_station_classmark_3.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_SUPPORTED_CODECS_PRESENT)
+        size += sizeof(uint8_t) + attach_request->supported_codecs.length + sizeof(attach_request->supported_codecs.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_ADDITIONAL_UPDATE_TYPE_PRESENT)
+        size += sizeof(ogs_nas_additional_update_type_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_VOICE_DOMAIN_PREFERENCE_AND_UE_USAGE_SETTING_PRESENT)
+        size += sizeof(uint8_t) + attach_request->voice_domain_preference_and_ue_usage_setting.length + sizeof(attach_request->voice_domain_preference_and_ue_usage_setting.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_DEVICE_PROPERTIES_PRESENT)
+        size += sizeof(ogs_nas_device_properties_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_OLD_GUTI_TYPE_PRESENT)
+        size += sizeof(ogs_nas_guti_type_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MS_NETWORK_FEATURE_SUPPORT_PRESENT)
+        size += sizeof(ogs_nas_ms_network_feature_support_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_TMSI_BASED_NRI_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + attach_request->tmsi_based_nri_container.length + sizeof(attach_request->tmsi_based_nri_container.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_T3324_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_request->t3324_value.length + sizeof(attach_request->t3324_value.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_T3412_EXTENDED_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_request->t3412_extended_value.length + sizeof(attach_request->t3412_extended_value.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_EXTENDED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + attach_request->extended_drx_parameters.length + sizeof(attach_request->extended_drx_parameters.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_UE_ADDITIONAL_SECURITY_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + attach_request->ue_additional_security_capability.length + sizeof(attach_request->ue_additional_security_capability.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_UE_STATUS_PRESENT)
+        size += sizeof(uint8_t) + attach_request->ue_status.length + sizeof(attach_request->ue_status.length);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_ADDITIONAL_INFORMATION_REQUESTED_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_additional_information_requested_t);
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_N1_UE_NETWORK_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + attach_request->n1_ue_network_capability.length + sizeof(attach_request->n1_ue_network_capability.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_attach_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_accept_t *attach_accept = &message->emm.attach_accept;
+    int size = 0;
+
+    size += sizeof(ogs_nas_eps_attach_result_t);
+    size += sizeof(ogs_nas_gprs_timer_t);
+    size += attach_accept->tai_list.length + sizeof(attach_accept->tai_list.length);
+    size += attach_accept->esm_message_container.length + sizeof(attach_accept->esm_message_container.length);
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_GUTI_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->guti.length + sizeof(attach_accept->guti.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_LOCATION_AREA_IDENTIFICATION_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_location_area_identification_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_MS_IDENTITY_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->ms_identity.length + sizeof(attach_accept->ms_identity.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EMM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_emm_cause_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3402_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3423_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EQUIVALENT_PLMNS_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->equivalent_plmns.length + sizeof(attach_accept->equivalent_plmns.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EMERGENCY_NUMBER_LIST_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->emergency_number_list.length + sizeof(attach_accept->emergency_number_list.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EPS_NETWORK_FEATURE_SUPPORT_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->eps_network_feature_support.length + sizeof(attach_accept->eps_network_feature_support.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_ADDITIONAL_UPDATE_RESULT_PRESENT)
+        size += sizeof(ogs_nas_additional_update_result_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3412_EXTENDED_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->t3412_extended_value.length + sizeof(attach_accept->t3412_extended_value.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3324_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->t3324_value.length + sizeof(attach_accept->t3324_value.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EXTENDED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->extended_drx_parameters.length + sizeof(attach_accept->extended_drx_parameters.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_DCN_ID_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->dcn_id.length + sizeof(attach_accept->dcn_id.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_SMS_SERVICES_STATUS_PRESENT)
+        size += sizeof(ogs_nas_sms_services_status_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NON__NW_PROVIDED_POLICIES_PRESENT)
+        size += sizeof(ogs_nas_non__nw_provided_policies_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3448_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->t3448_value.length + sizeof(attach_accept->t3448_value.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NETWORK_POLICY_PRESENT)
+        size += sizeof(ogs_nas_network_policy_t);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3447_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->t3447_value.length + sizeof(attach_accept->t3447_value.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EXTENDED_EMERGENCY_NUMBER_LIST_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->extended_emergency_number_list.length + sizeof(attach_accept->extended_emergency_number_list.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_CIPHERING_KEY_DATA_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->ciphering_key_data.length + sizeof(attach_accept->ciphering_key_data.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + attach_accept->ue_radio_capability_id.length + sizeof(attach_accept->ue_radio_capability_id.length);
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_attach_complete(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_complete_t *attach_complete = &message->emm.attach_complete;
+    int size = 0;
+
+    size += attach_complete->esm_message_container.length + sizeof(attach_complete->esm_message_container.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_attach_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_reject_t *attach_reject = &message->emm.attach_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_emm_cause_t);
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_ESM_MESSAGE_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + attach_reject->esm_message_container.length + sizeof(attach_reject->esm_message_container.length);
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_T3346_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_reject->t3346_value.length + sizeof(attach_reject->t3346_value.length);
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_T3402_VALUE_PRESENT)
+        size += sizeof(uint8_t) + attach_reject->t3402_value.length + sizeof(attach_reject->t3402_value.length);
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_EXTENDED_EMM_CAUSE_PRESENT)
+        size += sizeof(ogs_nas_extended_emm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_detach_request_to_ue(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_detach_request_to_ue_t *detach_request_to_ue = &message->emm.detach_request_to_ue;
+    int size = 0;
+
+    size += sizeof(ogs_nas_detach_type_t);
+
+    if (detach_request_to_ue->presencemask & OGS_NAS_EPS_DETACH_REQUEST_EMM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_emm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_tracking_area_update_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_tracking_area_update_request_t *tracking_area_update_request = &message->emm.tracking_area_update_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_eps_update_type_t);
+    size += tracking_area_update_request->old_guti.length + sizeof(tracking_area_update_request->old_guti.length);
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_NON_CURRENT_NATIVE_NAS_KEY_SET_IDENTIFIER_PRESENT)
+        size += sizeof(ogs_nas_key_set_identifier_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_GPRS_CIPHERING_KEY_SEQUENCE_NUMBER_PRESENT)
+        size += sizeof(ogs_nas_ciphering_key_sequence_number_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_OLD_P_TMSI_SIGNATURE_PRESENT)
+        size += sizeof(uint8_t) + 3;
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_GUTI_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->additional_guti.length + sizeof(tracking_area_update_request->additional_guti.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_NONCEUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_nonce_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_NETWORK_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->ue_network_capability.length + sizeof(tracking_area_update_request->ue_network_capability.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_LAST_VISITED_REGISTERED_TAI_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_tracking_area_identity_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_DRX_PARAMETER_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_drx_parameter_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_RADIO_CAPABILITY_INFORMATION_UPDATE_NEEDED_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_information_update_needed_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_EPS_BEARER_CONTEXT_STATUS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->eps_bearer_context_status.length + sizeof(tracking_area_update_request->eps_bearer_context_status.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MS_NETWORK_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->ms_network_capability.length + sizeof(tracking_area_update_request->ms_network_capability.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_OLD_LOCATION_AREA_IDENTIFICATION_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_location_area_identification_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_TMSI_STATUS_PRESENT)
+        size += sizeof(ogs_nas_tmsi_status_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MOBILE_STATION_CLASSMARK_2_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->mobile_station_classmark_2.length + sizeof(tracking_area_update_request->mobile_station_classmark_2.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MOBILE_STATION_CLASSMARK_3_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->mobile_station_classmark_3.length + sizeof(tracking_area_update_request->mobile_station_classmark_3.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_SUPPORTED_CODECS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->supported_codecs.length + sizeof(tracking_area_update_request->supported_codecs.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_UPDATE_TYPE_PRESENT)
+        size += sizeof(ogs_nas_additional_update_type_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_VOICE_DOMAIN_PREFERENCE_AND_UE_USAGE_SETTING_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->voice_domain_preference_and_ue_usage_setting.length + sizeof(tracking_area_update_request->voice_domain_preference_and_ue_usage_setting.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_OLD_GUTI_TYPE_PRESENT)
+        size += sizeof(ogs_nas_guti_type_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_DEVICE_PROPERTIES_PRESENT)
+        size += sizeof(ogs_nas_device_properties_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MS_NETWORK_FEATURE_SUPPORT_PRESENT)
+        size += sizeof(ogs_nas_ms_network_feature_support_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_TMSI_BASED_NRI_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->tmsi_based_nri_container.length + sizeof(tracking_area_update_request->tmsi_based_nri_container.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_T3324_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->t3324_value.length + sizeof(tracking_area_update_request->t3324_value.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_T3412_EXTENDED_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->t3412_extended_value.length + sizeof(tracking_area_update_request->t3412_extended_value.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_EXTENDED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->extended_drx_parameters.length + sizeof(tracking_area_update_request->extended_drx_parameters.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_ADDITIONAL_SECURITY_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->ue_additional_security_capability.length + sizeof(tracking_area_update_request->ue_additional_security_capability.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_STATUS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->ue_status.length + sizeof(tracking_area_update_request->ue_status.length);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_INFORMATION_REQUESTED_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_additional_information_requested_t);
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_N1_UE_NETWORK_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_request->n1_ue_network_capability.length + sizeof(tracking_area_update_request->n1_ue_network_capability.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_tracking_area_update_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_tracking_area_update_accept_t *tracking_area_update_accept = &message->emm.tracking_area_update_accept;
+    int size = 0;
+
+    size += sizeof(ogs_nas_eps_update_result_t);
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_GUTI_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->guti.length + sizeof(tracking_area_update_accept->guti.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_TAI_LIST_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->tai_list.length + sizeof(tracking_area_update_accept->tai_list.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EPS_BEARER_CONTEXT_STATUS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->eps_bearer_context_status.length + sizeof(tracking_area_update_accept->eps_bearer_context_status.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_LOCATION_AREA_IDENTIFICATION_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_location_area_identification_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_MS_IDENTITY_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->ms_identity.length + sizeof(tracking_area_update_accept->ms_identity.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EMM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_emm_cause_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3402_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3423_VALUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_gprs_timer_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EQUIVALENT_PLMNS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->equivalent_plmns.length + sizeof(tracking_area_update_accept->equivalent_plmns.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EMERGENCY_NUMBER_LIST_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->emergency_number_list.length + sizeof(tracking_area_update_accept->emergency_number_list.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EPS_NETWORK_FEATURE_SUPPORT_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->eps_network_feature_support.length + sizeof(tracking_area_update_accept->eps_network_feature_support.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_ADDITIONAL_UPDATE_RESULT_PRESENT)
+        size += sizeof(ogs_nas_additional_update_result_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_EXTENDED_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->t3412_extended_value.length + sizeof(tracking_area_update_accept->t3412_extended_value.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3324_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->t3324_value.length + sizeof(tracking_area_update_accept->t3324_value.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EXTENDED_DRX_PARAMETERS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->extended_drx_parameters.length + sizeof(tracking_area_update_accept->extended_drx_parameters.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_HEADER_COMPRESSION_CONFIGURATION_STATUS_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->header_compression_configuration_status.length + sizeof(tracking_area_update_accept->header_compression_configuration_status.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_DCN_ID_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->dcn_id.length + sizeof(tracking_area_update_accept->dcn_id.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_SMS_SERVICES_STATUS_PRESENT)
+        size += sizeof(ogs_nas_sms_services_status_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NON__NW_POLICIES_PRESENT)
+        size += sizeof(ogs_nas_non__nw_provided_policies_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3448_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->t3448_value.length + sizeof(tracking_area_update_accept->t3448_value.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NETWORK_POLICY_PRESENT)
+        size += sizeof(ogs_nas_network_policy_t);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3447_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->t3447_value.length + sizeof(tracking_area_update_accept->t3447_value.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EXTENDED_EMERGENCY_NUMBER_LIST_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->extended_emergency_number_list.length + sizeof(tracking_area_update_accept->extended_emergency_number_list.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_CIPHERING_KEY_DATA_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->ciphering_key_data.length + sizeof(tracking_area_update_accept->ciphering_key_data.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_accept->ue_radio_capability_id.length + sizeof(tracking_area_update_accept->ue_radio_capability_id.length);
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_tracking_area_update_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_tracking_area_update_reject_t *tracking_area_update_reject = &message->emm.tracking_area_update_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_emm_cause_t);
+
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_T3346_VALUE_PRESENT)
+        size += sizeof(uint8_t) + tracking_area_update_reject->t3346_value.length + sizeof(tracking_area_update_reject->t3346_value.length);
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_EXTENDED_EMM_CAUSE_PRESENT)
+        size += sizeof(ogs_nas_extended_emm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_extended_service_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_extended_service_request_t *extended_service_request = &message->emm.extended_service_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_service_type_t);
+    size += extended_service_request->m_tmsi.length + sizeof(extended_service_request->m_tmsi.length);
+
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_CSFB_RESPONSE_PRESENT)
+        size += sizeof(ogs_nas_csfb_response_t);
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_EPS_BEARER_CONTEXT_STATUS_PRESENT)
+        size += sizeof(uint8_t) + extended_service_request->eps_bearer_context_status.length + sizeof(extended_service_request->eps_bearer_context_status.length);
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_DEVICE_PROPERTIES_PRESENT)
+        size += sizeof(ogs_nas_device_properties_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_service_request(ogs_nas_eps_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_ksi_and_sequence_number_t);
+    size += sizeof(ogs_nas_short_mac_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_service_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_service_reject_t *service_reject = &message->emm.service_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_emm_cause_t);
+
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_T3346_VALUE_PRESENT)
+        size += sizeof(uint8_t) + service_reject->t3346_value.length + sizeof(service_reject->t3346_value.length);
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_T3448_VALUE_PRESENT)
+        size += sizeof(uint8_t) + service_reject->t3448_value.length + sizeof(service_reject->t3448_value.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_guti_reallocation_command(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_guti_reallocation_command_t *guti_reallocation_command = &message->emm.guti_reallocation_command;
+    int size = 0;
+
+    size += guti_reallocation_command->guti.length + sizeof(guti_reallocation_command->guti.length);
+
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_TAI_LIST_PRESENT)
+        size += sizeof(uint8_t) + guti_reallocation_command->tai_list.length + sizeof(guti_reallocation_command->tai_list.length);
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_DCN_ID_PRESENT)
+        size += sizeof(uint8_t) + guti_reallocation_command->dcn_id.length + sizeof(guti_reallocation_command->dcn_id.length);
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + guti_reallocation_command->ue_radio_capability_id.length + sizeof(guti_reallocation_command->ue_radio_capability_id.length);
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_authentication_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_authentication_request_t *authentication_request = &message->emm.authentication_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_key_set_identifier_t);
+    size += sizeof(ogs_nas_authentication_parameter_rand_t);
+    size += authentication_request->authentication_parameter_autn.length + sizeof(authentication_request->authentication_parameter_autn.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_authentication_response(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_authentication_response_t *authentication_response = &message->emm.authentication_response;
+    int size = 0;
+
+    size += authentication_response->authentication_response_parameter.length + sizeof(authentication_response->authentication_response_parameter.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_identity_request(ogs_nas_eps_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_identity_type_2_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_identity_response(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_identity_response_t *identity_response = &message->emm.identity_response;
+    int size = 0;
+
+    size += identity_response->mobile_identity.length + sizeof(identity_response->mobile_identity.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_authentication_failure(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_authentication_failure_t *authentication_failure = &message->emm.authentication_failure;
+    int size = 0;
+
+    size += sizeof(ogs_nas_emm_cause_t);
+
+    if (authentication_failure->presencemask & OGS_NAS_EPS_AUTHENTICATION_FAILURE_AUTHENTICATION_FAILURE_PARAMETER_PRESENT)
+        size += sizeof(uint8_t) + authentication_failure->authentication_failure_parameter.length + sizeof(authentication_failure->authentication_failure_parameter.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_security_mode_command(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_security_mode_command_t *security_mode_command = &message->emm.security_mode_command;
+    int size = 0;
+
+    size += sizeof(ogs_nas_security_algorithms_t);
+    size += sizeof(ogs_nas_key_set_identifier_t);
+    size += security_mode_command->replayed_ue_security_capabilities.length + sizeof(security_mode_command->replayed_ue_security_capabilities.length);
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_IMEISV_REQUEST_PRESENT)
+        size += sizeof(ogs_nas_imeisv_request_t);
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_REPLAYED_NONCEUE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_nonce_t);
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_NONCEMME_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_nonce_t);
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_HASHMME_PRESENT)
+        size += sizeof(uint8_t) + security_mode_command->hashmme.length + sizeof(security_mode_command->hashmme.length);
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_REPLAYED_UE_ADDITIONAL_SECURITY_CAPABILITY_PRESENT)
+        size += sizeof(uint8_t) + security_mode_command->replayed_ue_additional_security_capability.length + sizeof(security_mode_command->replayed_ue_additional_security_capability.length);
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_UE_RADIO_CAPABILITY_ID_REQUEST_PRESENT)
+        size += sizeof(ogs_nas_ue_radio_capability_id_request_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_security_mode_complete(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_security_mode_complete_t *security_mode_complete = &message->emm.security_mode_complete;
+    int size = 0;
+
+    if (security_mode_complete->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMPLETE_IMEISV_PRESENT)
+        size += sizeof(uint8_t) + security_mode_complete->imeisv.length + sizeof(security_mode_complete->imeisv.length);
+    if (security_mode_complete->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMPLETE_REPLAYED_NAS_MESSAGE_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + security_mode_complete->replayed_nas_message_container.length + sizeof(security_mode_complete->replayed_nas_message_container.length);
+    if (security_mode_complete->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMPLETE_UE_RADIO_CAPABILITY_ID_PRESENT)
+        size += sizeof(uint8_t) + security_mode_complete->ue_radio_capability_id.length + sizeof(security_mode_complete->ue_radio_capability_id.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_security_mode_reject(ogs_nas_eps_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_emm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_emm_status(ogs_nas_eps_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_emm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_emm_information(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_emm_information_t *emm_information = &message->emm.emm_information;
+    int size = 0;
+
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_FULL_NAME_FOR_NETWORK_PRESENT)
+        size += sizeof(uint8_t) + emm_information->full_name_for_network.length + sizeof(emm_information->full_name_for_network.length);
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_SHORT_NAME_FOR_NETWORK_PRESENT)
+        size += sizeof(uint8_t) + emm_information->short_name_for_network.length + sizeof(emm_information->short_name_for_network.length);
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_LOCAL_TIME_ZONE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_time_zone_t);
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_UNIVERSAL_TIME_AND_LOCAL_TIME_ZONE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_time_zone_and_time_t);
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_NETWORK_DAYLIGHT_SAVING_TIME_PRESENT)
+        size += sizeof(uint8_t) + emm_information->network_daylight_saving_time.length + sizeof(emm_information->network_daylight_saving_time.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_downlink_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_downlink_nas_transport_t *downlink_nas_transport = &message->emm.downlink_nas_transport;
+    int size = 0;
+
+    size += downlink_nas_transport->nas_message_container.length + sizeof(downlink_nas_transport->nas_message_container.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_uplink_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_uplink_nas_transport_t *uplink_nas_transport = &message->emm.uplink_nas_transport;
+    int size = 0;
+
+    size += uplink_nas_transport->nas_message_container.length + sizeof(uplink_nas_transport->nas_message_container.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_cs_service_notification(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_cs_service_notification_t *cs_service_notification = &message->emm.cs_service_notification;
+    int size = 0;
+
+    size += sizeof(ogs_nas_paging_identity_t);
+
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_CLI_PRESENT)
+        size += sizeof(uint8_t) + cs_service_notification->cli.length + sizeof(cs_service_notification->cli.length);
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_SS_CODE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_ss_code_t);
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_LCS_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_lcs_indicator_t);
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_LCS_CLIENT_IDENTITY_PRESENT)
+        size += sizeof(uint8_t) + cs_service_notification->lcs_client_identity.length + sizeof(cs_service_notification->lcs_client_identity.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_uplink_generic_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_uplink_generic_nas_transport_t *uplink_generic_nas_transport = &message->emm.uplink_generic_nas_transport;
+    int size = 0;
+
+    size += sizeof(ogs_nas_generic_message_container_type_t);
+    size += uplink_generic_nas_transport->generic_message_container.length + sizeof(uplink_generic_nas_transport->generic_message_container.length);
+
+    if (uplink_generic_nas_transport->presencemask & OGS_NAS_EPS_UPLINK_GENERIC_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + uplink_generic_nas_transport->additional_information.length + sizeof(uplink_generic_nas_transport->additional_information.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_downlink_generic_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_downlink_generic_nas_transport_t *downlink_generic_nas_transport = &message->emm.downlink_generic_nas_transport;
+    int size = 0;
+
+    size += sizeof(ogs_nas_generic_message_container_type_t);
+    size += downlink_generic_nas_transport->generic_message_container.length + sizeof(downlink_generic_nas_transport->generic_message_container.length);
+
+    if (downlink_generic_nas_transport->presencemask & OGS_NAS_EPS_DOWNLINK_GENERIC_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT)
+        size += sizeof(uint8_t) + downlink_generic_nas_transport->additional_information.length + sizeof(downlink_generic_nas_transport->additional_information.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_activate_default_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_default_eps_bearer_context_request_t *activate_default_eps_bearer_context_request = &message->esm.activate_default_eps_bearer_context_request;
+    int size = 0;
+
+    size += activate_default_eps_bearer_context_request->eps_qos.length + sizeof(activate_default_eps_bearer_context_request->eps_qos.length);
+    size += activate_default_eps_bearer_context_request->access_point_name.length + sizeof(activate_default_eps_bearer_context_request->access_point_name.length) + 1;
+    size += activate_default_eps_bearer_context_request->pdn_address.length + sizeof(activate_default_eps_bearer_context_request->pdn_address.length);
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_TRANSACTION_IDENTIFIER_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->transaction_identifier.length + sizeof(activate_default_eps_bearer_context_request->transaction_identifier.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_QOS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->negotiated_qos.length + sizeof(activate_default_eps_bearer_context_request->negotiated_qos.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_LLC_SAPI_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_llc_service_access_point_identifier_t);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_RADIO_PRIORITY_PRESENT)
+        size += sizeof(ogs_nas_radio_priority_t);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_PACKET_FLOW_IDENTIFIER_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->packet_flow_identifier.length + sizeof(activate_default_eps_bearer_context_request->packet_flow_identifier.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_APN_AMBR_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->apn_ambr.length + sizeof(activate_default_eps_bearer_context_request->apn_ambr.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_ESM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_esm_cause_t);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->protocol_configuration_options.length + sizeof(activate_default_eps_bearer_context_request->protocol_configuration_options.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_CONNECTIVITY_TYPE_PRESENT)
+        size += sizeof(ogs_nas_connectivity_type_t);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_wlan_offload_acceptability_t);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->nbifom_container.length + sizeof(activate_default_eps_bearer_context_request->nbifom_container.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->header_compression_configuration.length + sizeof(activate_default_eps_bearer_context_request->header_compression_configuration.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_CONTROL_PLANE_ONLY_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_control_plane_only_indication_t);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->extended_protocol_configuration_options.length + sizeof(activate_default_eps_bearer_context_request->extended_protocol_configuration_options.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_SERVING_PLMN_RATE_CONTROL_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->serving_plmn_rate_control.length + sizeof(activate_default_eps_bearer_context_request->serving_plmn_rate_control.length);
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_APN_AMBR_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_request->extended_apn_ambr.length + sizeof(activate_default_eps_bearer_context_request->extended_apn_ambr.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_activate_default_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_default_eps_bearer_context_accept_t *activate_default_eps_bearer_context_accept = &message->esm.activate_default_eps_bearer_context_accept;
+    int size = 0;
+
+    if (activate_default_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_accept->protocol_configuration_options.length + sizeof(activate_default_eps_bearer_context_accept->protocol_configuration_options.length);
+    if (activate_default_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_accept->extended_protocol_configuration_options.length + sizeof(activate_default_eps_bearer_context_accept->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_activate_default_eps_bearer_context_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_default_eps_bearer_context_reject_t *activate_default_eps_bearer_context_reject = &message->esm.activate_default_eps_bearer_context_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (activate_default_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_reject->protocol_configuration_options.length + sizeof(activate_default_eps_bearer_context_reject->protocol_configuration_options.length);
+    if (activate_default_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_default_eps_bearer_context_reject->extended_protocol_configuration_options.length + sizeof(activate_default_eps_bearer_context_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_activate_dedicated_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_dedicated_eps_bearer_context_request_t *activate_dedicated_eps_bearer_context_request = &message->esm.activate_dedicated_eps_bearer_context_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_linked_eps_bearer_identity_t);
+    size += activate_dedicated_eps_bearer_context_request->eps_qos.length + sizeof(activate_dedicated_eps_bearer_context_request->eps_qos.length);
+    size += activate_dedicated_eps_bearer_context_request->tft.length + sizeof(activate_dedicated_eps_bearer_context_request->tft.length);
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_TRANSACTION_IDENTIFIER_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->transaction_identifier.length + sizeof(activate_dedicated_eps_bearer_context_request->transaction_identifier.length);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_QOS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->negotiated_qos.length + sizeof(activate_dedicated_eps_bearer_context_request->negotiated_qos.length);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_LLC_SAPI_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_llc_service_access_point_identifier_t);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_RADIO_PRIORITY_PRESENT)
+        size += sizeof(ogs_nas_radio_priority_t);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_PACKET_FLOW_IDENTIFIER_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->packet_flow_identifier.length + sizeof(activate_dedicated_eps_bearer_context_request->packet_flow_identifier.length);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->protocol_configuration_options.length + sizeof(activate_dedicated_eps_bearer_context_request->protocol_configuration_options.length);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_wlan_offload_acceptability_t);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->nbifom_container.length + sizeof(activate_dedicated_eps_bearer_context_request->nbifom_container.length);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->extended_protocol_configuration_options.length + sizeof(activate_dedicated_eps_bearer_context_request->extended_protocol_configuration_options.length);
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_EPS_QOS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_request->extended_eps_qos.length + sizeof(activate_dedicated_eps_bearer_context_request->extended_eps_qos.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_activate_dedicated_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_dedicated_eps_bearer_context_accept_t *activate_dedicated_eps_bearer_context_accept = &message->esm.activate_dedicated_eps_bearer_context_accept;
+    int size = 0;
+
+    if (activate_dedicated_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_accept->protocol_configuration_options.length + sizeof(activate_dedicated_eps_bearer_context_accept->protocol_configuration_options.length);
+    if (activate_dedicated_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_accept->nbifom_container.length + sizeof(activate_dedicated_eps_bearer_context_accept->nbifom_container.length);
+    if (activate_dedicated_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_accept->extended_protocol_configuration_options.length + sizeof(activate_dedicated_eps_bearer_context_accept->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_activate_dedicated_eps_bearer_context_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_dedicated_eps_bearer_context_reject_t *activate_dedicated_eps_bearer_context_reject = &message->esm.activate_dedicated_eps_bearer_context_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (activate_dedicated_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_reject->protocol_configuration_options.length + sizeof(activate_dedicated_eps_bearer_context_reject->protocol_configuration_options.length);
+    if (activate_dedicated_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_reject->nbifom_container.length + sizeof(activate_dedicated_eps_bearer_context_reject->nbifom_container.length);
+    if (activate_dedicated_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + activate_dedicated_eps_bearer_context_reject->extended_protocol_configuration_options.length + sizeof(activate_dedicated_eps_bearer_context_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_modify_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_modify_eps_bearer_context_request_t *modify_eps_bearer_context_request = &message->esm.modify_eps_bearer_context_request;
+    int size = 0;
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NEW_EPS_QOS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->new_eps_qos.length + sizeof(modify_eps_bearer_context_request->new_eps_qos.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_TFT_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->tft.length + sizeof(modify_eps_bearer_context_request->tft.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NEW_QOS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->new_qos.length + sizeof(modify_eps_bearer_context_request->new_qos.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_LLC_SAPI_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_llc_service_access_point_identifier_t);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_RADIO_PRIORITY_PRESENT)
+        size += sizeof(ogs_nas_radio_priority_t);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_PACKET_FLOW_IDENTIFIER_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->packet_flow_identifier.length + sizeof(modify_eps_bearer_context_request->packet_flow_identifier.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_APN_AMBR_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->apn_ambr.length + sizeof(modify_eps_bearer_context_request->apn_ambr.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->protocol_configuration_options.length + sizeof(modify_eps_bearer_context_request->protocol_configuration_options.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_wlan_offload_acceptability_t);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->nbifom_container.length + sizeof(modify_eps_bearer_context_request->nbifom_container.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->header_compression_configuration.length + sizeof(modify_eps_bearer_context_request->header_compression_configuration.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->extended_protocol_configuration_options.length + sizeof(modify_eps_bearer_context_request->extended_protocol_configuration_options.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_APN_AMBR_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->extended_apn_ambr.length + sizeof(modify_eps_bearer_context_request->extended_apn_ambr.length);
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_EPS_QOS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_request->extended_eps_qos.length + sizeof(modify_eps_bearer_context_request->extended_eps_qos.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_modify_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_modify_eps_bearer_context_accept_t *modify_eps_bearer_context_accept = &message->esm.modify_eps_bearer_context_accept;
+    int size = 0;
+
+    if (modify_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_accept->protocol_configuration_options.length + sizeof(modify_eps_bearer_context_accept->protocol_configuration_options.length);
+    if (modify_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_accept->nbifom_container.length + sizeof(modify_eps_bearer_context_accept->nbifom_container.length);
+    if (modify_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_accept->extended_protocol_configuration_options.length + sizeof(modify_eps_bearer_context_accept->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_modify_eps_bearer_context_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_modify_eps_bearer_context_reject_t *modify_eps_bearer_context_reject = &message->esm.modify_eps_bearer_context_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (modify_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_reject->protocol_configuration_options.length + sizeof(modify_eps_bearer_context_reject->protocol_configuration_options.length);
+    if (modify_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_reject->nbifom_container.length + sizeof(modify_eps_bearer_context_reject->nbifom_container.length);
+    if (modify_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + modify_eps_bearer_context_reject->extended_protocol_configuration_options.length + sizeof(modify_eps_bearer_context_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_deactivate_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_deactivate_eps_bearer_context_request_t *deactivate_eps_bearer_context_request = &message->esm.deactivate_eps_bearer_context_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + deactivate_eps_bearer_context_request->protocol_configuration_options.length + sizeof(deactivate_eps_bearer_context_request->protocol_configuration_options.length);
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_T3396_VALUE_PRESENT)
+        size += sizeof(uint8_t) + deactivate_eps_bearer_context_request->t3396_value.length + sizeof(deactivate_eps_bearer_context_request->t3396_value.length);
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT)
+        size += sizeof(ogs_nas_wlan_offload_acceptability_t);
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + deactivate_eps_bearer_context_request->nbifom_container.length + sizeof(deactivate_eps_bearer_context_request->nbifom_container.length);
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + deactivate_eps_bearer_context_request->extended_protocol_configuration_options.length + sizeof(deactivate_eps_bearer_context_request->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_deactivate_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_deactivate_eps_bearer_context_accept_t *deactivate_eps_bearer_context_accept = &message->esm.deactivate_eps_bearer_context_accept;
+    int size = 0;
+
+    if (deactivate_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + deactivate_eps_bearer_context_accept->protocol_configuration_options.length + sizeof(deactivate_eps_bearer_context_accept->protocol_configuration_options.length);
+    if (deactivate_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + deactivate_eps_bearer_context_accept->extended_protocol_configuration_options.length + sizeof(deactivate_eps_bearer_context_accept->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_pdn_connectivity_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_connectivity_request_t *pdn_connectivity_request = &message->esm.pdn_connectivity_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_request_type_t);
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_ESM_INFORMATION_TRANSFER_FLAG_PRESENT)
+        size += sizeof(ogs_nas_esm_information_transfer_flag_t);
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_ACCESS_POINT_NAME_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_request->access_point_name.length + sizeof(pdn_connectivity_request->access_point_name.length) + 1;
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_request->protocol_configuration_options.length + sizeof(pdn_connectivity_request->protocol_configuration_options.length);
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_DEVICE_PROPERTIES_PRESENT)
+        size += sizeof(ogs_nas_device_properties_t);
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_request->nbifom_container.length + sizeof(pdn_connectivity_request->nbifom_container.length);
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_request->header_compression_configuration.length + sizeof(pdn_connectivity_request->header_compression_configuration.length);
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_request->extended_protocol_configuration_options.length + sizeof(pdn_connectivity_request->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_pdn_connectivity_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_connectivity_reject_t *pdn_connectivity_reject = &message->esm.pdn_connectivity_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_reject->protocol_configuration_options.length + sizeof(pdn_connectivity_reject->protocol_configuration_options.length);
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_reject->back_off_timer_value.length + sizeof(pdn_connectivity_reject->back_off_timer_value.length);
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_reject->re_attempt_indicator.length + sizeof(pdn_connectivity_reject->re_attempt_indicator.length);
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_reject->nbifom_container.length + sizeof(pdn_connectivity_reject->nbifom_container.length);
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_connectivity_reject->extended_protocol_configuration_options.length + sizeof(pdn_connectivity_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_pdn_disconnect_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_disconnect_request_t *pdn_disconnect_request = &message->esm.pdn_disconnect_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_linked_eps_bearer_identity_t);
+
+    if (pdn_disconnect_request->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_disconnect_request->protocol_configuration_options.length + sizeof(pdn_disconnect_request->protocol_configuration_options.length);
+    if (pdn_disconnect_request->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_disconnect_request->extended_protocol_configuration_options.length + sizeof(pdn_disconnect_request->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_pdn_disconnect_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_disconnect_reject_t *pdn_disconnect_reject = &message->esm.pdn_disconnect_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (pdn_disconnect_reject->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_disconnect_reject->protocol_configuration_options.length + sizeof(pdn_disconnect_reject->protocol_configuration_options.length);
+    if (pdn_disconnect_reject->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + pdn_disconnect_reject->extended_protocol_configuration_options.length + sizeof(pdn_disconnect_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_bearer_resource_allocation_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_allocation_request_t *bearer_resource_allocation_request = &message->esm.bearer_resource_allocation_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_linked_eps_bearer_identity_t);
+    size += bearer_resource_allocation_request->traffic_flow_aggregate.length + sizeof(bearer_resource_allocation_request->traffic_flow_aggregate.length);
+    size += bearer_resource_allocation_request->required_traffic_flow_qos.length + sizeof(bearer_resource_allocation_request->required_traffic_flow_qos.length);
+
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_request->protocol_configuration_options.length + sizeof(bearer_resource_allocation_request->protocol_configuration_options.length);
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_DEVICE_PROPERTIES_PRESENT)
+        size += sizeof(ogs_nas_device_properties_t);
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_request->nbifom_container.length + sizeof(bearer_resource_allocation_request->nbifom_container.length);
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_request->extended_protocol_configuration_options.length + sizeof(bearer_resource_allocation_request->extended_protocol_configuration_options.length);
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_EXTENDED_EPS_QOS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_request->extended_eps_qos.length + sizeof(bearer_resource_allocation_request->extended_eps_qos.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_bearer_resource_allocation_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_allocation_reject_t *bearer_resource_allocation_reject = &message->esm.bearer_resource_allocation_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_reject->protocol_configuration_options.length + sizeof(bearer_resource_allocation_reject->protocol_configuration_options.length);
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_reject->back_off_timer_value.length + sizeof(bearer_resource_allocation_reject->back_off_timer_value.length);
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_reject->re_attempt_indicator.length + sizeof(bearer_resource_allocation_reject->re_attempt_indicator.length);
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_reject->nbifom_container.length + sizeof(bearer_resource_allocation_reject->nbifom_container.length);
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_allocation_reject->extended_protocol_configuration_options.length + sizeof(bearer_resource_allocation_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_bearer_resource_modification_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_modification_request_t *bearer_resource_modification_request = &message->esm.bearer_resource_modification_request;
+    int size = 0;
+
+    size += sizeof(ogs_nas_linked_eps_bearer_identity_t);
+    size += bearer_resource_modification_request->traffic_flow_aggregate.length + sizeof(bearer_resource_modification_request->traffic_flow_aggregate.length);
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_REQUIRED_TRAFFIC_FLOW_QOS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_request->required_traffic_flow_qos.length + sizeof(bearer_resource_modification_request->required_traffic_flow_qos.length);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_ESM_CAUSE_PRESENT)
+        size += sizeof(uint8_t) + sizeof(ogs_nas_esm_cause_t);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_request->protocol_configuration_options.length + sizeof(bearer_resource_modification_request->protocol_configuration_options.length);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_DEVICE_PROPERTIES_PRESENT)
+        size += sizeof(ogs_nas_device_properties_t);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_request->nbifom_container.length + sizeof(bearer_resource_modification_request->nbifom_container.length);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_request->header_compression_configuration.length + sizeof(bearer_resource_modification_request->header_compression_configuration.length);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_request->extended_protocol_configuration_options.length + sizeof(bearer_resource_modification_request->extended_protocol_configuration_options.length);
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_EXTENDED_EPS_QOS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_request->extended_eps_qos.length + sizeof(bearer_resource_modification_request->extended_eps_qos.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_bearer_resource_modification_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_modification_reject_t *bearer_resource_modification_reject = &message->esm.bearer_resource_modification_reject;
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_reject->protocol_configuration_options.length + sizeof(bearer_resource_modification_reject->protocol_configuration_options.length);
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_BACK_OFF_TIMER_VALUE_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_reject->back_off_timer_value.length + sizeof(bearer_resource_modification_reject->back_off_timer_value.length);
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_RE_ATTEMPT_INDICATOR_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_reject->re_attempt_indicator.length + sizeof(bearer_resource_modification_reject->re_attempt_indicator.length);
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_NBIFOM_CONTAINER_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_reject->nbifom_container.length + sizeof(bearer_resource_modification_reject->nbifom_container.length);
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + bearer_resource_modification_reject->extended_protocol_configuration_options.length + sizeof(bearer_resource_modification_reject->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_esm_information_response(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_esm_information_response_t *esm_information_response = &message->esm.esm_information_response;
+    int size = 0;
+
+    if (esm_information_response->presencemask & OGS_NAS_EPS_ESM_INFORMATION_RESPONSE_ACCESS_POINT_NAME_PRESENT)
+        size += sizeof(uint8_t) + esm_information_response->access_point_name.length + sizeof(esm_information_response->access_point_name.length) + 1;
+    if (esm_information_response->presencemask & OGS_NAS_EPS_ESM_INFORMATION_RESPONSE_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + esm_information_response->protocol_configuration_options.length + sizeof(esm_information_response->protocol_configuration_options.length);
+    if (esm_information_response->presencemask & OGS_NAS_EPS_ESM_INFORMATION_RESPONSE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT)
+        size += sizeof(uint8_t) + esm_information_response->extended_protocol_configuration_options.length + sizeof(esm_information_response->extended_protocol_configuration_options.length);
+
+    return size;
+}
+
+static int ogs_nas_eps_size_esm_status(ogs_nas_eps_message_t *message)
+{
+    int size = 0;
+
+    size += sizeof(ogs_nas_esm_cause_t);
+
+    return size;
+}
+
+static int ogs_nas_emm_size(ogs_nas_eps_message_t *message)
+{
+    int size = sizeof(ogs_nas_emm_header_t);
+
+    if (message->emm.h.security_header_type >=
+            OGS_NAS_SECURITY_HEADER_FOR_SERVICE_REQUEST_MESSAGE)
+        return size + ogs_nas_eps_size_service_request(message);
+
+    switch (message->emm.h.message_type) {
+    case OGS_NAS_EPS_ATTACH_REQUEST:
+        size += ogs_nas_eps_size_attach_request(message);
+        break;
+    case OGS_NAS_EPS_ATTACH_ACCEPT:
+        size += ogs_nas_eps_size_attach_accept(message);
+        break;
+    case OGS_NAS_EPS_ATTACH_COMPLETE:
+        size += ogs_nas_eps_size_attach_complete(message);
+        break;
+    case OGS_NAS_EPS_ATTACH_REJECT:
+        size += ogs_nas_eps_size_attach_reject(message);
+        break;
+    case OGS_NAS_EPS_DETACH_REQUEST:
+        size += ogs_nas_eps_size_detach_request_to_ue(message);
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST:
+        size += ogs_nas_eps_size_tracking_area_update_request(message);
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT:
+        size += ogs_nas_eps_size_tracking_area_update_accept(message);
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT:
+        size += ogs_nas_eps_size_tracking_area_update_reject(message);
+        break;
+    case OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST:
+        size += ogs_nas_eps_size_extended_service_request(message);
+        break;
+    case OGS_NAS_EPS_SERVICE_REJECT:
+        size += ogs_nas_eps_size_service_reject(message);
+        break;
+    case OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND:
+        size += ogs_nas_eps_size_guti_reallocation_command(message);
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_REQUEST:
+        size += ogs_nas_eps_size_authentication_request(message);
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_RESPONSE:
+        size += ogs_nas_eps_size_authentication_response(message);
+        break;
+    case OGS_NAS_EPS_IDENTITY_REQUEST:
+        size += ogs_nas_eps_size_identity_request(message);
+        break;
+    case OGS_NAS_EPS_IDENTITY_RESPONSE:
+        size += ogs_nas_eps_size_identity_response(message);
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_FAILURE:
+        size += ogs_nas_eps_size_authentication_failure(message);
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_COMMAND:
+        size += ogs_nas_eps_size_security_mode_command(message);
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_COMPLETE:
+        size += ogs_nas_eps_size_security_mode_complete(message);
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_REJECT:
+        size += ogs_nas_eps_size_security_mode_reject(message);
+        break;
+    case OGS_NAS_EPS_EMM_STATUS:
+        size += ogs_nas_eps_size_emm_status(message);
+        break;
+    case OGS_NAS_EPS_EMM_INFORMATION:
+        size += ogs_nas_eps_size_emm_information(message);
+        break;
+    case OGS_NAS_EPS_DOWNLINK_NAS_TRANSPORT:
+        size += ogs_nas_eps_size_downlink_nas_transport(message);
+        break;
+    case OGS_NAS_EPS_UPLINK_NAS_TRANSPORT:
+        size += ogs_nas_eps_size_uplink_nas_transport(message);
+        break;
+    case OGS_NAS_EPS_CS_SERVICE_NOTIFICATION:
+        size += ogs_nas_eps_size_cs_service_notification(message);
+        break;
+    case OGS_NAS_EPS_UPLINK_GENERIC_NAS_TRANSPORT:
+        size += ogs_nas_eps_size_uplink_generic_nas_transport(message);
+        break;
+    case OGS_NAS_EPS_DOWNLINK_GENERIC_NAS_TRANSPORT:
+        size += ogs_nas_eps_size_downlink_generic_nas_transport(message);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+static int ogs_nas_esm_size(ogs_nas_eps_message_t *message)
+{
+    int size = sizeof(ogs_nas_esm_header_t);
+
+    switch (message->esm.h.message_type) {
+    case OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST:
+        size += ogs_nas_eps_size_activate_default_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT:
+        size += ogs_nas_eps_size_activate_default_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT:
+        size += ogs_nas_eps_size_activate_default_eps_bearer_context_reject(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST:
+        size += ogs_nas_eps_size_activate_dedicated_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT:
+        size += ogs_nas_eps_size_activate_dedicated_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT:
+        size += ogs_nas_eps_size_activate_dedicated_eps_bearer_context_reject(message);
+        break;
+    case OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST:
+        size += ogs_nas_eps_size_modify_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT:
+        size += ogs_nas_eps_size_modify_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT:
+        size += ogs_nas_eps_size_modify_eps_bearer_context_reject(message);
+        break;
+    case OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST:
+        size += ogs_nas_eps_size_deactivate_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT:
+        size += ogs_nas_eps_size_deactivate_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST:
+        size += ogs_nas_eps_size_pdn_connectivity_request(message);
+        break;
+    case OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT:
+        size += ogs_nas_eps_size_pdn_connectivity_reject(message);
+        break;
+    case OGS_NAS_EPS_PDN_DISCONNECT_REQUEST:
+        size += ogs_nas_eps_size_pdn_disconnect_request(message);
+        break;
+    case OGS_NAS_EPS_PDN_DISCONNECT_REJECT:
+        size += ogs_nas_eps_size_pdn_disconnect_reject(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST:
+        size += ogs_nas_eps_size_bearer_resource_allocation_request(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT:
+        size += ogs_nas_eps_size_bearer_resource_allocation_reject(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST:
+        size += ogs_nas_eps_size_bearer_resource_modification_request(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT:
+        size += ogs_nas_eps_size_bearer_resource_modification_reject(message);
+        break;
+    case OGS_NAS_EPS_ESM_INFORMATION_RESPONSE:
+        size += ogs_nas_eps_size_esm_information_response(message);
+        break;
+    case OGS_NAS_EPS_ESM_STATUS:
+        size += ogs_nas_eps_size_esm_status(message);
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
 ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
@@ -3241,11 +4416,14 @@ ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_emm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_emm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -3427,11 +4605,14 @@ ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_esm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_esm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
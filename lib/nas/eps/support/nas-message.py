@@ -111,6 +111,19 @@ def v_upper(v):
 def v_lower(v):
     return re.sub('3gpp', '', re.sub('\'', '_', re.sub('/', '_', re.sub('-', '_', re.sub(' ', '_', v)))).lower())
 
+def size_of_ie(k, ie):
+    t = type_list[ie["type"]]
+    if (t["format"] == "TV" or t["format"] == "T") and t["length"] == "1":
+        return "sizeof(ogs_nas_%s_t)" % v_lower(ie["type"])
+    elif t["format"] == "TV" or t["format"] == "V":
+        if t["length"] == "4":
+            return "3"
+        return "sizeof(ogs_nas_%s_t)" % v_lower(ie["type"])
+    size = "%s->%s.length + sizeof(%s->%s.length)" % (v_lower(k), v_lower(ie["value"]), v_lower(k), v_lower(ie["value"]))
+    if "extra_size" in t:
+        size += " + %d" % t["extra_size"]
+    return size
+
 def get_cells(cells):
     iei = cells[0].text.encode('ascii', 'ignore')
     value = re.sub("\s*$", "", re.sub("\s*\n*\s*\([^\)]*\)*", "", re.sub("'s", "", cells[1].text))).encode('ascii', 'ignore')
@@ -868,6 +881,94 @@ for (k, v) in sorted_msg_list:
 """)
 
 
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if len(msg_list[k]["ies"]) == 0:
+        continue
+    if k.find("FROM UE") != -1:
+        continue
+
+    f.write("static int ogs_nas_eps_size_%s(ogs_nas_eps_message_t *message)\n{\n" % v_lower(k))
+    used = [ies for ies in msg_list[k]["ies"] if ies["presence"] != "M" or size_of_ie(k, ies).find("->") != -1]
+    if len(used) == 0:
+        pass
+    elif float(msg_list[k]["type"]) < 192:
+        f.write("    ogs_nas_eps_%s_t *%s = &message->emm.%s;\n" % (v_lower(k), v_lower(k), v_lower(k)))
+    else:
+        f.write("    ogs_nas_eps_%s_t *%s = &message->esm.%s;\n" % (v_lower(k), v_lower(k), v_lower(k)))
+    f.write("    int size = 0;\n\n")
+
+    for ie in [ies for ies in msg_list[k]["ies"] if ies["presence"] == "M"]:
+        f.write("    size += %s;\n" % size_of_ie(k, ie))
+
+    if len([ies for ies in msg_list[k]["ies"] if ies["presence"] == "M"]) != 0 and \
+       len([ies for ies in msg_list[k]["ies"] if ies["presence"] == "O"]) != 0:
+        f.write("\n")
+
+    for ie in [ies for ies in msg_list[k]["ies"] if ies["presence"] == "O"]:
+        f.write("    if (%s->presencemask & OGS_NAS_EPS_%s_%s_PRESENT)\n" % (v_lower(k), v_upper(k), v_upper(ie["value"])))
+        if ie["length"] == "1" and (ie["format"] == "TV" or ie["format"] == "T"):
+            f.write("        size += %s;\n" % size_of_ie(k, ie))
+        else:
+            f.write("        size += sizeof(uint8_t) + %s;\n" % size_of_ie(k, ie))
+
+    f.write("""
+    return size;
+}
+
+""")
+
+f.write("""static int ogs_nas_emm_size(ogs_nas_eps_message_t *message)
+{
+    int size = sizeof(ogs_nas_emm_header_t);
+
+    if (message->emm.h.security_header_type >=
+            OGS_NAS_SECURITY_HEADER_FOR_SERVICE_REQUEST_MESSAGE)
+        return size + ogs_nas_eps_size_service_request(message);
+
+    switch (message->emm.h.message_type) {
+""")
+
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if float(msg_list[k]["type"]) < 192 and k.find("FROM UE") == -1 and k != "SERVICE REQUEST" and len(msg_list[k]["ies"]) != 0:
+        f.write("    case OGS_NAS_EPS_%s:\n" % v_upper(k))
+        f.write("        size += ogs_nas_eps_size_%s(message);\n" % v_lower(k))
+        f.write("        break;\n")
+
+f.write("""    default:
+        break;
+    }
+
+    return size;
+}
+
+static int ogs_nas_esm_size(ogs_nas_eps_message_t *message)
+{
+    int size = sizeof(ogs_nas_esm_header_t);
+
+    switch (message->esm.h.message_type) {
+""")
+
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if float(msg_list[k]["type"]) >= 192 and len(msg_list[k]["ies"]) != 0:
+        f.write("    case OGS_NAS_EPS_%s:\n" % v_upper(k))
+        f.write("        size += ogs_nas_eps_size_%s(message);\n" % v_lower(k))
+        f.write("        break;\n")
+
+f.write("""    default:
+        break;
+    }
+
+    return size;
+}
+
+""")
+
 f.write("""ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
@@ -877,11 +978,14 @@ f.write("""ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_emm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_emm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -940,11 +1044,14 @@ f.write("""ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message)
     ogs_assert(message);
 
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The buffer is sized for the message, so that it comes from
+     * the smallest cluster. */
+    size = ogs_nas_esm_size(message);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+size);
     ogs_assert(pkbuf);
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, size);
 
     size = sizeof(ogs_nas_esm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
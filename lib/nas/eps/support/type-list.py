@@ -78,3 +78,6 @@ type_list["Access point name"]["decode"] = \
 type_list["Access point name"]["encode"] = \
 "    target.length = ogs_fqdn_build(target.apn, access_point_name->apn, access_point_name->length);\n" \
 "    size = target.length + sizeof(target.length);\n\n"
+
+# ogs_fqdn_build() adds the length octet of the first label
+type_list["Access point name"]["extra_size"] = 1
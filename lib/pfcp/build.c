@@ -231,6 +231,81 @@ ogs_pkbuf_t *ogs_pfcp_up_build_association_setup_response(uint8_t type,
     return ogs_pfcp_build_msg(&pfcp_message);
 }
 
+ogs_pkbuf_t *ogs_pfcp_up_build_node_report_request(uint8_t type,
+        ogs_sockaddr_t *remote_gtp_u_peer)
+{
+    int rv;
+    ogs_pfcp_message_t pfcp_message;
+    ogs_pfcp_node_report_request_t *req = NULL;
+
+    ogs_pfcp_node_id_t node_id;
+    int node_id_len = 0;
+    ogs_pfcp_node_report_type_t node_report_type;
+    ogs_pfcp_remote_gtp_u_peer_t peer;
+    int peer_len = 0;
+
+    ogs_assert(remote_gtp_u_peer);
+
+    ogs_debug("Node Report Request");
+
+    req = &pfcp_message.pfcp_node_report_request;
+    memset(&pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+
+    ogs_pfcp_sockaddr_to_node_id(
+            ogs_pfcp_self()->pfcp_addr, ogs_pfcp_self()->pfcp_addr6,
+            ogs_app()->parameter.prefer_ipv4,
+            &node_id, &node_id_len);
+    req->node_id.presence = 1;
+    req->node_id.data = &node_id;
+    req->node_id.len = node_id_len;
+
+    node_report_type.value = 0;
+    node_report_type.user_plane_path_failure_report = 1;
+    req->node_report_type.presence = 1;
+    req->node_report_type.data = &node_report_type.value;
+    req->node_report_type.len = 1;
+
+    rv = ogs_pfcp_sockaddr_to_remote_gtp_u_peer(
+            remote_gtp_u_peer, &peer, &peer_len);
+    ogs_assert(rv == OGS_OK);
+    req->user_plane_path_failure_report.presence = 1;
+    req->user_plane_path_failure_report.remote_gtp_u_peer_.presence = 1;
+    req->user_plane_path_failure_report.remote_gtp_u_peer_.data = &peer;
+    req->user_plane_path_failure_report.remote_gtp_u_peer_.len = peer_len;
+
+    pfcp_message.h.type = type;
+    return ogs_pfcp_build_msg(&pfcp_message);
+}
+
+ogs_pkbuf_t *ogs_pfcp_cp_build_node_report_response(uint8_t type,
+        uint8_t cause)
+{
+    ogs_pfcp_message_t pfcp_message;
+    ogs_pfcp_node_report_response_t *rsp = NULL;
+
+    ogs_pfcp_node_id_t node_id;
+    int node_id_len = 0;
+
+    ogs_debug("Node Report Response");
+
+    rsp = &pfcp_message.pfcp_node_report_response;
+    memset(&pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+
+    ogs_pfcp_sockaddr_to_node_id(
+            ogs_pfcp_self()->pfcp_addr, ogs_pfcp_self()->pfcp_addr6,
+            ogs_app()->parameter.prefer_ipv4,
+            &node_id, &node_id_len);
+    rsp->node_id.presence = 1;
+    rsp->node_id.data = &node_id;
+    rsp->node_id.len = node_id_len;
+
+    rsp->cause.presence = 1;
+    rsp->cause.u8 = cause;
+
+    pfcp_message.h.type = type;
+    return ogs_pfcp_build_msg(&pfcp_message);
+}
+
 static struct {
     ogs_pfcp_f_teid_t f_teid;
     char dnn[OGS_MAX_DNN_LEN];
@@ -627,6 +702,56 @@ void ogs_pfcp_build_create_bar(
     message->bar_id.u8 = bar->id;
 }
 
+void ogs_pfcp_up_build_load_control_information(
+    ogs_pfcp_tlv_load_control_information_t *message)
+{
+    ogs_assert(message);
+
+    /* The UP function has not reported its load yet */
+    if (!ogs_pfcp_self()->load.sqn)
+        return;
+    if (!ogs_pfcp_self()->cp_function_features.load)
+        return;
+
+    message->presence = 1;
+    message->load_control_sequence_number.presence = 1;
+    message->load_control_sequence_number.u32 = ogs_pfcp_self()->load.sqn;
+    message->load_metric.presence = 1;
+    message->load_metric.u8 = ogs_pfcp_self()->load.metric;
+}
+
+/*
+ * The Overload Control Information is sent while the UP function
+ * is overloaded, and during one Period of Validity after the overload
+ * ends so that the CP function learns that the reduction is over.
+ */
+void ogs_pfcp_up_build_overload_control_information(
+    ogs_pfcp_tlv_overload_control_information_t *message)
+{
+    ogs_assert(message);
+
+    if (!ogs_pfcp_self()->overload.sqn)
+        return;
+    if (!ogs_pfcp_self()->cp_function_features.ovrl)
+        return;
+    if (!ogs_pfcp_self()->overload.metric &&
+        ogs_get_monotonic_time() >=
+            ogs_pfcp_self()->overload.updated + OGS_PFCP_OVERLOAD_VALIDITY)
+        return;
+
+    message->presence = 1;
+    message->overload_control_sequence_number.presence = 1;
+    message->overload_control_sequence_number.u32 =
+        ogs_pfcp_self()->overload.sqn;
+    message->overload_reduction_metric.presence = 1;
+    message->overload_reduction_metric.u8 = ogs_pfcp_self()->overload.metric;
+    message->period_of_validity.presence = 1;
+    message->period_of_validity.u8 =
+        ogs_pfcp_timer_from_time(OGS_PFCP_OVERLOAD_VALIDITY);
+    message->overload_control_information_flags.presence = 1;
+    message->overload_control_information_flags.u8 = OGS_PFCP_OCI_FLAGS_AOCI;
+}
+
 ogs_pkbuf_t *ogs_pfcp_build_session_report_request(
         uint8_t type, ogs_pfcp_user_plane_report_t *report)
 {
@@ -697,6 +822,11 @@ ogs_pkbuf_t *ogs_pfcp_build_session_report_request(
             report->error_indication.remote_f_teid_len;
     }
 
+    ogs_pfcp_up_build_load_control_information(
+            &req->load_control_information);
+    ogs_pfcp_up_build_overload_control_information(
+            &req->overload_control_information);
+
     pfcp_message.h.type = type;
     return ogs_pfcp_build_msg(&pfcp_message);
 }
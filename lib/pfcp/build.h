@@ -35,6 +35,11 @@ ogs_pkbuf_t *ogs_pfcp_up_build_association_setup_request(uint8_t type);
 ogs_pkbuf_t *ogs_pfcp_up_build_association_setup_response(uint8_t type,
         uint8_t cause);
 
+ogs_pkbuf_t *ogs_pfcp_up_build_node_report_request(uint8_t type,
+        ogs_sockaddr_t *remote_gtp_u_peer);
+ogs_pkbuf_t *ogs_pfcp_cp_build_node_report_response(uint8_t type,
+        uint8_t cause);
+
 void ogs_pfcp_pdrbuf_init(void);
 void ogs_pfcp_pdrbuf_clear(void);
 
@@ -63,6 +68,11 @@ void ogs_pfcp_build_create_urr(
 void ogs_pfcp_build_create_bar(
     ogs_pfcp_tlv_create_bar_t *message, ogs_pfcp_bar_t *bar);
 
+void ogs_pfcp_up_build_load_control_information(
+    ogs_pfcp_tlv_load_control_information_t *message);
+void ogs_pfcp_up_build_overload_control_information(
+    ogs_pfcp_tlv_overload_control_information_t *message);
+
 ogs_pkbuf_t *ogs_pfcp_build_session_report_request(
         uint8_t type, ogs_pfcp_user_plane_report_t *report);
 ogs_pkbuf_t *ogs_pfcp_build_session_report_response(
@@ -37,8 +37,54 @@ static OGS_POOL(ogs_pfcp_dev_pool, ogs_pfcp_dev_t);
 static OGS_POOL(ogs_pfcp_subnet_pool, ogs_pfcp_subnet_t);
 static OGS_POOL(ogs_pfcp_rule_pool, ogs_pfcp_rule_t);
 
+/* Forwarding entries at the index of the PDR pool */
+static ogs_pfcp_pdr_fwd_t *fwd_table;
+
+static struct {
+    ogs_metrics_t *bytes;
+    ogs_metrics_t *dropped;
+    ogs_metrics_t *report;
+    ogs_metrics_t *pending;
+} metrics;
+
+static const char *buffer_drop_name[OGS_PFCP_MAX_NUM_OF_BUFFER_DROP] = {
+    "budget",
+    "ue_limit",
+    "expired",
+    "removed",
+};
+
+static const char *buffer_drop_label(int index)
+{
+    return buffer_drop_name[index];
+}
+
+static int64_t buffer_bytes(void *data)
+{
+    return self.buffer.bytes;
+}
+
+static const char *report_result_name[OGS_PFCP_MAX_NUM_OF_REPORT_RESULT] = {
+    "queued",
+    "merged",
+    "suppressed",
+    "sent",
+    "throttled",
+};
+
+static const char *report_result_label(int index)
+{
+    return report_result_name[index];
+}
+
+static int64_t report_pending(void *data)
+{
+    return self.report.num_of_pending;
+}
+
 void ogs_pfcp_context_init(void)
 {
+    int rv;
     struct timeval tv;
     ogs_assert(context_initialized == 0);
 
@@ -69,6 +115,11 @@ void ogs_pfcp_context_init(void)
 
     ogs_pool_init(&ogs_pfcp_pdr_pool,
             ogs_app()->pool.sess * OGS_MAX_NUM_OF_PDR);
+    /* As the pool array, the table is mapped by the OS on first use */
+    rv = posix_memalign((void **)&fwd_table, sizeof(ogs_pfcp_pdr_fwd_t),
+            sizeof(ogs_pfcp_pdr_fwd_t) *
+            ogs_app()->pool.sess * OGS_MAX_NUM_OF_PDR);
+    ogs_assert(rv == 0);
     ogs_pool_init(&ogs_pfcp_far_pool,
             ogs_app()->pool.sess * OGS_MAX_NUM_OF_FAR);
     ogs_pool_init(&ogs_pfcp_urr_pool,
@@ -84,9 +135,26 @@ void ogs_pfcp_context_init(void)
     ogs_pool_init(&ogs_pfcp_dev_pool, OGS_MAX_NUM_OF_DEV);
     ogs_pool_init(&ogs_pfcp_subnet_pool, OGS_MAX_NUM_OF_SUBNET);
 
-    self.object_teid_hash = ogs_hash_make();
+    self.object_teid_hash = ogs_ihash_make(sizeof(uint32_t));
     self.far_f_teid_hash = ogs_hash_make();
-    self.far_teid_hash = ogs_hash_make();
+    self.far_teid_hash = ogs_ihash_make(sizeof(uint32_t));
+
+    metrics.bytes = ogs_metrics_add_collector("pfcp_buffered_bytes",
+            "Clusters held by the buffered downlink packets",
+            NULL, buffer_bytes, NULL);
+    metrics.dropped = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "pfcp_buffer_dropped_packets_total",
+            "Downlink packets dropped from the buffer by cause",
+            NULL, "cause", OGS_PFCP_MAX_NUM_OF_BUFFER_DROP,
+            buffer_drop_label);
+    metrics.report = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "pfcp_session_reports_total",
+            "Session Report Requests of the UP function by result",
+            NULL, "result", OGS_PFCP_MAX_NUM_OF_REPORT_RESULT,
+            report_result_label);
+    metrics.pending = ogs_metrics_add_collector("pfcp_session_reports_pending",
+            "Sessions with a queued Session Report Request",
+            NULL, report_pending, NULL);
 
     context_initialized = 1;
 }
@@ -96,11 +164,11 @@ void ogs_pfcp_context_final(void)
     ogs_assert(context_initialized == 1);
 
     ogs_assert(self.object_teid_hash);
-    ogs_hash_destroy(self.object_teid_hash);
+    ogs_ihash_destroy(self.object_teid_hash);
     ogs_assert(self.far_f_teid_hash);
     ogs_hash_destroy(self.far_f_teid_hash);
     ogs_assert(self.far_teid_hash);
-    ogs_hash_destroy(self.far_teid_hash);
+    ogs_ihash_destroy(self.far_teid_hash);
 
     ogs_pfcp_dev_remove_all();
     ogs_pfcp_subnet_remove_all();
@@ -111,6 +179,7 @@ void ogs_pfcp_context_final(void)
 
     ogs_pool_final(&ogs_pfcp_sess_pool);
     ogs_pool_final(&ogs_pfcp_pdr_pool);
+    free(fwd_table);
     ogs_pool_final(&ogs_pfcp_far_pool);
     ogs_pool_final(&ogs_pfcp_urr_pool);
     ogs_pool_final(&ogs_pfcp_qer_pool);
@@ -120,6 +189,12 @@ void ogs_pfcp_context_final(void)
 
     ogs_pool_final(&ogs_pfcp_node_pool);
 
+    if (metrics.bytes) ogs_metrics_remove(metrics.bytes);
+    if (metrics.dropped) ogs_metrics_remove(metrics.dropped);
+    if (metrics.report) ogs_metrics_remove(metrics.report);
+    if (metrics.pending) ogs_metrics_remove(metrics.pending);
+    memset(&metrics, 0, sizeof(metrics));
+
     context_initialized = 0;
 }
 
@@ -134,6 +209,10 @@ static int ogs_pfcp_context_prepare(void)
 
     self.tun_ifname = "ogstun";
 
+    self.report.window = ogs_time_from_msec(10);
+    self.report.rate = 5000;
+    self.report.burst = 500;
+
     return OGS_OK;
 }
 
@@ -649,13 +728,23 @@ ogs_pfcp_node_t *ogs_pfcp_node_new(ogs_sockaddr_t *sa_list)
 
     ogs_list_init(&node->gtpu_resource_list);
 
+    ogs_list_init(&node->report.pending_list);
+
     return node;
 }
 
 void ogs_pfcp_node_free(ogs_pfcp_node_t *node)
 {
+    ogs_lnode_t *lnode = NULL;
+
     ogs_assert(node);
 
+    while ((lnode = ogs_list_first(&node->report.pending_list))) {
+        ogs_pfcp_sess_t *sess =
+            ogs_container_of(lnode, ogs_pfcp_sess_t, report.lnode);
+        ogs_pfcp_up_report_cancel(sess);
+    }
+
     ogs_gtpu_resource_remove_all(&node->gtpu_resource_list);
 
     if (node->sock)
@@ -722,6 +811,228 @@ void ogs_pfcp_node_remove_all(ogs_list_t *list)
         ogs_pfcp_node_remove(list, node);
 }
 
+bool ogs_pfcp_node_overloaded(ogs_pfcp_node_t *node)
+{
+    ogs_assert(node);
+
+    if (!node->overload.received || !node->overload.metric)
+        return false;
+
+    /* Infinite Period of Validity */
+    if (!node->overload.expires)
+        return true;
+
+    return ogs_get_monotonic_time() < node->overload.expires;
+}
+
+/*
+ * Reject the share of new PFCP sessions given by the Overload Reduction
+ * Metric. The credit is spread evenly, so with a metric of 30, three out
+ * of every ten establishments are throttled.
+ */
+bool ogs_pfcp_node_throttled(ogs_pfcp_node_t *node)
+{
+    ogs_assert(node);
+
+    if (!ogs_pfcp_node_overloaded(node))
+        return false;
+
+    node->overload.throttle += node->overload.metric;
+    if (node->overload.throttle >= OGS_PFCP_METRIC_MAX) {
+        node->overload.throttle -= OGS_PFCP_METRIC_MAX;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * The UP function enters overload when the load metric reaches
+ * OVERLOAD_START and leaves it when the metric drops to OVERLOAD_STOP.
+ * In between, the CP function is asked to reduce the traffic
+ * in proportion to the load above OVERLOAD_STOP.
+ */
+#define OVERLOAD_START  90
+#define OVERLOAD_STOP   80
+
+void ogs_pfcp_up_update_load(uint8_t metric)
+{
+    uint8_t reduction = 0;
+
+    if (metric > OGS_PFCP_METRIC_MAX)
+        metric = OGS_PFCP_METRIC_MAX;
+
+    if (self.load.metric != metric) {
+        self.load.metric = metric;
+        self.load.sqn++;
+    }
+
+    if (metric >= OVERLOAD_START ||
+        (self.overload.metric && metric > OVERLOAD_STOP))
+        reduction = (metric - OVERLOAD_STOP) *
+            OGS_PFCP_METRIC_MAX / (OGS_PFCP_METRIC_MAX - OVERLOAD_STOP);
+
+    /*
+     * The CP function ignores a report with the same sequence number,
+     * so a new one is issued before the Period of Validity runs out.
+     */
+    if (self.overload.metric != reduction ||
+        (reduction && ogs_get_monotonic_time() >=
+            self.overload.updated + OGS_PFCP_OVERLOAD_VALIDITY / 2)) {
+        self.overload.metric = reduction;
+        self.overload.sqn++;
+        self.overload.updated = ogs_get_monotonic_time();
+    }
+}
+
+static void report_refill(ogs_pfcp_node_t *node, ogs_time_t now)
+{
+    int64_t max;
+    ogs_time_t elapsed;
+
+    max = (int64_t)ogs_max(self.report.burst, 1) * OGS_USEC_PER_SEC;
+    elapsed = now - node->report.refilled;
+    node->report.refilled = now;
+
+    if (elapsed >= max / self.report.rate)
+        node->report.tokens = max;
+    else
+        node->report.tokens = ogs_min(
+                node->report.tokens + elapsed * self.report.rate, max);
+}
+
+/*
+ * Queue the report of the session, or merge it into the queued one.
+ * The first report of each type is kept, as the CP function handles
+ * the type once for the whole session.
+ */
+ogs_pfcp_report_result_e ogs_pfcp_up_report_add(ogs_pfcp_node_t *node,
+        ogs_pfcp_sess_t *sess, ogs_pfcp_user_plane_report_t *report)
+{
+    ogs_pfcp_user_plane_report_t *pending = NULL;
+    ogs_pfcp_report_type_t type;
+    ogs_pfcp_report_result_e result;
+
+    ogs_assert(node);
+    ogs_assert(sess);
+    ogs_assert(report);
+
+    pending = &sess->report.pending;
+
+    if (!(report->type.value & ~sess->report.in_flight)) {
+        result = OGS_PFCP_REPORT_SUPPRESSED;
+        goto out;
+    }
+
+    type.value = report->type.value &
+        ~(pending->type.value | sess->report.in_flight);
+    if (type.downlink_data_report)
+        memcpy(&pending->downlink_data, &report->downlink_data,
+                sizeof(pending->downlink_data));
+    if (type.error_indication_report)
+        memcpy(&pending->error_indication, &report->error_indication,
+                sizeof(pending->error_indication));
+
+    if (pending->type.value) {
+        pending->type.value |= type.value;
+        result = OGS_PFCP_REPORT_MERGED;
+        goto out;
+    }
+
+    pending->type.value = type.value;
+
+    sess->report.node = node;
+    sess->report.queued = ogs_get_monotonic_time();
+    ogs_list_add(&node->report.pending_list, &sess->report.lnode);
+    self.report.num_of_pending++;
+
+    if (node->report.timer && node->report.timer->running == false)
+        ogs_timer_start(node->report.timer, self.report.window);
+
+    result = OGS_PFCP_REPORT_QUEUED;
+
+out:
+    ogs_metrics_vector_inc(metrics.report, result);
+    return result;
+}
+
+/*
+ * Send the reports queued for at least 'window' while the token bucket
+ * of the node allows. The timer of the node is set for the next report.
+ * Returns the number of the requests sent.
+ */
+int ogs_pfcp_up_report_flush(
+        ogs_pfcp_node_t *node, ogs_pfcp_up_report_send_f send)
+{
+    ogs_pfcp_sess_t *sess = NULL;
+    ogs_pfcp_user_plane_report_t report;
+    ogs_lnode_t *lnode = NULL;
+    ogs_time_t now, next = 0;
+    int n = 0;
+
+    ogs_assert(node);
+    ogs_assert(send);
+
+    now = ogs_get_monotonic_time();
+    if (self.report.rate)
+        report_refill(node, now);
+
+    while ((lnode = ogs_list_first(&node->report.pending_list))) {
+        sess = ogs_container_of(lnode, ogs_pfcp_sess_t, report.lnode);
+
+        if (now < sess->report.queued + self.report.window) {
+            next = sess->report.queued + self.report.window;
+            break;
+        }
+
+        if (self.report.rate) {
+            if (node->report.tokens < OGS_USEC_PER_SEC) {
+                next = now + (OGS_USEC_PER_SEC - node->report.tokens +
+                        self.report.rate - 1) / self.report.rate;
+                ogs_metrics_vector_inc(
+                        metrics.report, OGS_PFCP_REPORT_THROTTLED);
+                break;
+            }
+            node->report.tokens -= OGS_USEC_PER_SEC;
+        }
+
+        memcpy(&report, &sess->report.pending, sizeof(report));
+        ogs_pfcp_up_report_cancel(sess);
+        sess->report.in_flight = report.type.value;
+
+        send(sess, &report);
+        ogs_metrics_vector_inc(metrics.report, OGS_PFCP_REPORT_SENT);
+        n++;
+    }
+
+    if (next && node->report.timer)
+        ogs_timer_start(node->report.timer, next - now);
+
+    return n;
+}
+
+/* The response has been received or the request has timed out */
+void ogs_pfcp_up_report_done(ogs_pfcp_sess_t *sess)
+{
+    ogs_assert(sess);
+    sess->report.in_flight = 0;
+}
+
+void ogs_pfcp_up_report_cancel(ogs_pfcp_sess_t *sess)
+{
+    ogs_assert(sess);
+
+    if (sess->report.node) {
+        ogs_list_remove(&sess->report.node->report.pending_list,
+                &sess->report.lnode);
+        sess->report.node = NULL;
+        ogs_assert(self.report.num_of_pending);
+        self.report.num_of_pending--;
+    }
+
+    memset(&sess->report.pending, 0, sizeof(sess->report.pending));
+}
+
 ogs_gtpu_resource_t *ogs_pfcp_find_gtpu_resource(ogs_list_t *list,
         char *dnn, ogs_pfcp_interface_t source_interface)
 {
@@ -774,6 +1085,8 @@ void ogs_pfcp_setup_far_gtpu_node(ogs_pfcp_far_t *far)
         rv = ogs_gtp_connect(
                 ogs_gtp_self()->gtpu_sock, ogs_gtp_self()->gtpu_sock6, gnode);
         ogs_assert(rv == OGS_OK);
+
+        ogs_gtp_echo_add(gnode);
     }
 
     OGS_SETUP_GTP_NODE(far, gnode);
@@ -808,6 +1121,9 @@ void ogs_pfcp_setup_pdr_gtpu_node(ogs_pfcp_pdr_t *pdr)
 
 void ogs_pfcp_sess_clear(ogs_pfcp_sess_t *sess)
 {
+    ogs_pfcp_up_report_cancel(sess);
+    sess->report.in_flight = 0;
+
     ogs_pfcp_pdr_remove_all(sess);
     ogs_pfcp_far_remove_all(sess);
     ogs_pfcp_urr_remove_all(sess);
@@ -825,14 +1141,8 @@ static int precedence_compare(ogs_pfcp_pdr_t *pdr1, ogs_pfcp_pdr_t *pdr2)
         return 1;
 }
 
-ogs_pfcp_pdr_t *ogs_pfcp_pdr_add(ogs_pfcp_sess_t *sess)
+static void pdr_init(ogs_pfcp_sess_t *sess, ogs_pfcp_pdr_t *pdr)
 {
-    ogs_pfcp_pdr_t *pdr = NULL;
-
-    ogs_assert(sess);
-
-    ogs_pool_alloc(&ogs_pfcp_pdr_pool, &pdr);
-    ogs_assert(pdr);
     memset(pdr, 0, sizeof *pdr);
 
     pdr->obj.type = OGS_PFCP_OBJ_PDR_TYPE;
@@ -841,6 +1151,14 @@ ogs_pfcp_pdr_t *ogs_pfcp_pdr_add(ogs_pfcp_sess_t *sess)
     ogs_assert(pdr->index > 0 &&
             pdr->index <= ogs_app()->pool.sess * OGS_MAX_NUM_OF_PDR);
 
+    pdr->fwd = &fwd_table[pdr->index-1];
+    memset(pdr->fwd, 0, sizeof *pdr->fwd);
+    pdr->fwd->src_if = OGS_PFCP_INTERFACE_UNKNOWN;
+    pdr->fwd->dst_if = OGS_PFCP_INTERFACE_UNKNOWN;
+    pdr->fwd->fd = INVALID_SOCKET;
+    pdr->fwd->tun.fd4 = INVALID_SOCKET;
+    pdr->fwd->tun.fd6 = INVALID_SOCKET;
+
     ogs_pool_alloc(&sess->pdr_id_pool, &pdr->id_node);
     ogs_assert(pdr->id_node);
 
@@ -851,6 +1169,39 @@ ogs_pfcp_pdr_t *ogs_pfcp_pdr_add(ogs_pfcp_sess_t *sess)
 
     pdr->sess = sess;
     ogs_list_add(&sess->pdr_list, pdr);
+}
+
+ogs_pfcp_pdr_t *ogs_pfcp_pdr_add(ogs_pfcp_sess_t *sess)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+
+    ogs_assert(sess);
+
+    ogs_pool_alloc(&ogs_pfcp_pdr_pool, &pdr);
+    ogs_assert(pdr);
+
+    pdr_init(sess, pdr);
+
+    return pdr;
+}
+
+/*
+ * The TEID of the UP function is derived from the index of the PDR,
+ * so a restored PDR takes the index of the previous run.
+ */
+ogs_pfcp_pdr_t *ogs_pfcp_pdr_restore(ogs_pfcp_sess_t *sess, uint32_t index)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+
+    ogs_assert(sess);
+
+    ogs_pool_restore(&ogs_pfcp_pdr_pool, &pdr, index);
+    if (!pdr) {
+        ogs_error("PDR[%d] is not available", index);
+        return NULL;
+    }
+
+    pdr_init(sess, pdr);
 
     return pdr;
 }
@@ -892,21 +1243,18 @@ void ogs_pfcp_object_teid_hash_set(
     ogs_assert(pdr);
 
     if (pdr->hash.teid.len)
-        ogs_hash_set(self.object_teid_hash,
-                &pdr->hash.teid.key, pdr->hash.teid.len, NULL);
+        ogs_ihash_set(self.object_teid_hash, &pdr->hash.teid.key, NULL);
 
     pdr->hash.teid.key = pdr->f_teid.teid;
     pdr->hash.teid.len = sizeof(pdr->hash.teid.key);
 
     switch(type) {
     case OGS_PFCP_OBJ_PDR_TYPE:
-        ogs_hash_set(self.object_teid_hash,
-                &pdr->hash.teid.key, pdr->hash.teid.len, pdr);
+        ogs_ihash_set(self.object_teid_hash, &pdr->hash.teid.key, pdr);
         break;
     case OGS_PFCP_OBJ_SESS_TYPE:
         ogs_assert(pdr->sess);
-        ogs_hash_set(self.object_teid_hash,
-                &pdr->hash.teid.key, pdr->hash.teid.len, pdr->sess);
+        ogs_ihash_set(self.object_teid_hash, &pdr->hash.teid.key, pdr->sess);
         break;
     default:
         ogs_fatal("Unknown type [%d]", type);
@@ -916,8 +1264,8 @@ void ogs_pfcp_object_teid_hash_set(
 
 ogs_pfcp_object_t *ogs_pfcp_object_find_by_teid(uint32_t teid)
 {
-    return (ogs_pfcp_object_t *)ogs_hash_get(
-            self.object_teid_hash, &teid, sizeof(teid));
+    return (ogs_pfcp_object_t *)ogs_ihash_get(
+            self.object_teid_hash, &teid);
 }
 
 ogs_pfcp_pdr_t *ogs_pfcp_pdr_find_by_choose_id(
@@ -981,8 +1329,7 @@ void ogs_pfcp_pdr_remove(ogs_pfcp_pdr_t *pdr)
     ogs_pfcp_rule_remove_all(pdr);
 
     if (pdr->hash.teid.len)
-        ogs_hash_set(self.object_teid_hash,
-                &pdr->hash.teid.key, pdr->hash.teid.len, NULL);
+        ogs_ihash_set(self.object_teid_hash, &pdr->hash.teid.key, NULL);
 
     if (pdr->dnn)
         ogs_free(pdr->dnn);
@@ -1002,6 +1349,77 @@ void ogs_pfcp_pdr_remove_all(ogs_pfcp_sess_t *sess)
         ogs_pfcp_pdr_remove(pdr);
 }
 
+/*
+ * The TUN devices of the entry are kept, since they are set
+ * by the UPF from the UE IP address of the session.
+ */
+void ogs_pfcp_pdr_update_fwd(ogs_pfcp_pdr_t *pdr)
+{
+    ogs_pfcp_pdr_fwd_t *fwd = NULL;
+    ogs_pfcp_far_t *far = NULL;
+    ogs_gtp_node_t *gnode = NULL;
+
+    ogs_assert(pdr);
+    fwd = pdr->fwd;
+    ogs_assert(fwd);
+
+    fwd->src_if = pdr->src_if;
+    fwd->rule = ogs_list_first(&pdr->rule_list) != NULL;
+    fwd->qfi = pdr->qer ? pdr->qer->qfi : 0;
+
+    fwd->dst_if = OGS_PFCP_INTERFACE_UNKNOWN;
+    fwd->ohc = false;
+    fwd->gtpu = false;
+    fwd->teid = 0;
+    fwd->gnode = NULL;
+    fwd->fd = INVALID_SOCKET;
+    memset(&fwd->addr, 0, sizeof(fwd->addr));
+
+    far = pdr->far;
+    if (!far)
+        return;
+
+    fwd->dst_if = far->dst_if;
+    fwd->ohc = far->outer_header_creation.ip4 ||
+        far->outer_header_creation.ip6 ||
+        far->outer_header_creation.udp4 ||
+        far->outer_header_creation.udp6 ||
+        far->outer_header_creation.gtpu4 ||
+        far->outer_header_creation.gtpu6;
+
+    gnode = far->gnode;
+    if (!gnode || !gnode->sock)
+        return;
+
+    fwd->teid = far->outer_header_creation.teid;
+    fwd->gnode = gnode;
+    fwd->fd = gnode->sock->fd;
+    ogs_assert(ogs_sockaddr_len(&gnode->addr) <= sizeof(fwd->addr));
+    memcpy(&fwd->addr, &gnode->addr, ogs_sockaddr_len(&gnode->addr));
+
+    /* The packets held in the FAR are sent first by the slow path */
+    fwd->gtpu = (far->apply_action & OGS_PFCP_APPLY_ACTION_FORW) &&
+        far->buffer.num_of_packet == 0;
+}
+
+void ogs_pfcp_sess_update_fwd(ogs_pfcp_sess_t *sess)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+
+    ogs_assert(sess);
+    ogs_list_for_each(&sess->pdr_list, pdr)
+        ogs_pfcp_pdr_update_fwd(pdr);
+}
+
+static void far_update_fwd(ogs_pfcp_far_t *far)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+
+    ogs_list_for_each(&far->sess->pdr_list, pdr)
+        if (pdr->far == far)
+            ogs_pfcp_pdr_update_fwd(pdr);
+}
+
 ogs_pfcp_far_t *ogs_pfcp_far_add(ogs_pfcp_sess_t *sess)
 {
     ogs_pfcp_far_t *far = NULL;
@@ -1163,25 +1581,22 @@ void ogs_pfcp_far_teid_hash_set(ogs_pfcp_far_t *far)
     ogs_assert(far);
 
     if (far->hash.teid.len)
-        ogs_hash_set(self.far_teid_hash,
-                &far->hash.teid.key, far->hash.teid.len, NULL);
+        ogs_ihash_set(self.far_teid_hash, &far->hash.teid.key, NULL);
 
     far->hash.teid.key = far->outer_header_creation.teid;
     far->hash.teid.len = sizeof(far->hash.teid.key);
 
-    ogs_hash_set(self.far_teid_hash,
-            &far->hash.teid.key, far->hash.teid.len, far);
+    ogs_ihash_set(self.far_teid_hash, &far->hash.teid.key, far);
 }
 
 ogs_pfcp_far_t *ogs_pfcp_far_find_by_teid(uint32_t teid)
 {
-    return (ogs_pfcp_far_t *)ogs_hash_get(
-            self.far_teid_hash, &teid, sizeof(teid));
+    return (ogs_pfcp_far_t *)ogs_ihash_get(
+            self.far_teid_hash, &teid);
 }
 
 void ogs_pfcp_far_remove(ogs_pfcp_far_t *far)
 {
-    int i;
     ogs_pfcp_sess_t *sess = NULL;
 
     ogs_assert(far);
@@ -1194,8 +1609,7 @@ void ogs_pfcp_far_remove(ogs_pfcp_far_t *far)
         ogs_hash_set(self.far_f_teid_hash,
                 &far->hash.f_teid.key, far->hash.f_teid.len, NULL);
 
-    for (i = 0; i < far->num_of_buffered_packet; i++)
-        ogs_pkbuf_free(far->buffered_packet[i]);
+    ogs_pfcp_far_buffer_clear(far, OGS_PFCP_BUFFER_DROP_REMOVED);
 
     if (far->id_node)
         ogs_pool_free(&far->sess->far_id_pool, far->id_node);
@@ -1213,6 +1627,119 @@ void ogs_pfcp_far_remove_all(ogs_pfcp_sess_t *sess)
         ogs_pfcp_far_remove(far);
 }
 
+static void buffer_drop(ogs_pkbuf_t *pkbuf, ogs_pfcp_buffer_drop_e cause)
+{
+    ogs_metrics_vector_inc(metrics.dropped, cause);
+    ogs_pkbuf_free(pkbuf);
+}
+
+/*
+ * Takes the ownership of pkbuf. If the packet does not fit
+ * in the share of the session, it is dropped and OGS_ERROR is returned.
+ */
+int ogs_pfcp_far_buffer_add(ogs_pfcp_far_t *far, ogs_pkbuf_t *pkbuf)
+{
+    ogs_pfcp_sess_t *sess = NULL;
+    ogs_pfcp_bar_t *bar = NULL;
+    uint32_t size, limit, num_of_sess;
+    uint64_t budget;
+
+    ogs_assert(far);
+    sess = far->sess;
+    ogs_assert(sess);
+    ogs_assert(pkbuf);
+    ogs_assert(pkbuf->cluster);
+
+    size = pkbuf->cluster->size;
+    budget = ogs_app()->pool.buffer;
+
+    limit = OGS_MAX_NUM_OF_PACKET_BUFFER;
+    bar = sess->bar;
+    if (bar) {
+        if (bar->dl_buffering.packet_count)
+            limit = bar->dl_buffering.packet_count;
+        else if (bar->suggested_packet_count)
+            limit = bar->suggested_packet_count;
+    }
+
+    if (sess->buffer.num_of_packet >= limit) {
+        buffer_drop(pkbuf, OGS_PFCP_BUFFER_DROP_UE_LIMIT);
+        return OGS_ERROR;
+    }
+
+    num_of_sess = self.buffer.num_of_sess;
+    if (sess->buffer.num_of_packet == 0)
+        num_of_sess++;
+
+    if (sess->buffer.bytes + size > budget / num_of_sess) {
+        buffer_drop(pkbuf, OGS_PFCP_BUFFER_DROP_UE_LIMIT);
+        return OGS_ERROR;
+    }
+
+    if (self.buffer.bytes + size > budget) {
+        buffer_drop(pkbuf, OGS_PFCP_BUFFER_DROP_BUDGET);
+        return OGS_ERROR;
+    }
+
+    if (sess->buffer.num_of_packet == 0)
+        self.buffer.num_of_sess++;
+
+    sess->buffer.num_of_packet++;
+    sess->buffer.bytes += size;
+    self.buffer.bytes += size;
+
+    far->buffer.num_of_packet++;
+    ogs_list_add(&far->buffer.list, pkbuf);
+
+    if (far->buffer.num_of_packet == 1)
+        far_update_fwd(far);
+
+    return OGS_OK;
+}
+
+ogs_pkbuf_t *ogs_pfcp_far_buffer_remove(ogs_pfcp_far_t *far)
+{
+    ogs_pfcp_sess_t *sess = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_assert(far);
+    sess = far->sess;
+    ogs_assert(sess);
+
+    pkbuf = ogs_list_first(&far->buffer.list);
+    if (!pkbuf)
+        return NULL;
+
+    ogs_list_remove(&far->buffer.list, pkbuf);
+    far->buffer.num_of_packet--;
+
+    ogs_assert(sess->buffer.num_of_packet);
+    sess->buffer.num_of_packet--;
+    sess->buffer.bytes -= pkbuf->cluster->size;
+    self.buffer.bytes -= pkbuf->cluster->size;
+
+    if (sess->buffer.num_of_packet == 0) {
+        ogs_assert(self.buffer.num_of_sess);
+        self.buffer.num_of_sess--;
+    }
+
+    if (far->buffer.num_of_packet == 0)
+        far_update_fwd(far);
+
+    return pkbuf;
+}
+
+void ogs_pfcp_far_buffer_clear(
+        ogs_pfcp_far_t *far, ogs_pfcp_buffer_drop_e cause)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_assert(far);
+
+    while ((pkbuf = ogs_pfcp_far_buffer_remove(far)))
+        buffer_drop(pkbuf, cause);
+}
+
 ogs_pfcp_urr_t *ogs_pfcp_urr_add(ogs_pfcp_sess_t *sess)
 {
     ogs_pfcp_urr_t *urr = NULL;
@@ -1400,6 +1927,9 @@ void ogs_pfcp_bar_delete(ogs_pfcp_bar_t *bar)
     sess = bar->sess;
     ogs_assert(sess);
 
+    if (bar->dl_buffering.timer)
+        ogs_timer_delete(bar->dl_buffering.timer);
+
     if (bar->id_node)
         ogs_pool_free(&bar->sess->bar_id_pool, bar->id_node);
 
@@ -1409,6 +1939,60 @@ void ogs_pfcp_bar_delete(ogs_pfcp_bar_t *bar)
     sess->bar = NULL;
 }
 
+static void bar_dl_buffering_timeout(void *data)
+{
+    ogs_pfcp_bar_t *bar = data;
+    ogs_pfcp_sess_t *sess = NULL;
+    ogs_pfcp_far_t *far = NULL;
+
+    ogs_assert(bar);
+    sess = bar->sess;
+    ogs_assert(sess);
+
+    /*
+     * The DL Buffering Duration has expired.
+     * Drop what has been buffered, and report again on the next packet.
+     */
+    ogs_list_for_each(&sess->far_list, far) {
+        ogs_pfcp_far_buffer_clear(far, OGS_PFCP_BUFFER_DROP_EXPIRED);
+        far->buffer.reported = false;
+    }
+
+    bar->dl_buffering.packet_count = 0;
+}
+
+/*
+ * A zero duration leaves the buffering bounded by the packet count only.
+ * The timer is kept until the BAR is deleted, since it cannot be deleted
+ * from its own callback.
+ */
+void ogs_pfcp_bar_start_dl_buffering(ogs_pfcp_bar_t *bar, ogs_time_t duration)
+{
+    ogs_assert(bar);
+
+    if (duration == 0) {
+        if (bar->dl_buffering.timer)
+            ogs_timer_stop(bar->dl_buffering.timer);
+        return;
+    }
+
+    if (!bar->dl_buffering.timer) {
+        bar->dl_buffering.timer = ogs_timer_add(
+                ogs_app()->timer_mgr, bar_dl_buffering_timeout, bar);
+        ogs_assert(bar->dl_buffering.timer);
+    }
+    ogs_timer_start(bar->dl_buffering.timer, duration);
+}
+
+void ogs_pfcp_bar_stop_dl_buffering(ogs_pfcp_bar_t *bar)
+{
+    ogs_assert(bar);
+
+    if (bar->dl_buffering.timer)
+        ogs_timer_stop(bar->dl_buffering.timer);
+    bar->dl_buffering.packet_count = 0;
+}
+
 ogs_pfcp_rule_t *ogs_pfcp_rule_add(ogs_pfcp_pdr_t *pdr)
 {
     ogs_pfcp_rule_t *rule = NULL;
@@ -1615,6 +2199,57 @@ ogs_pfcp_ue_ip_t *ogs_pfcp_ue_ip_alloc(
     return ue_ip;
 }
 
+/*
+ * 'index' is the index of the address in the pool of the subnet,
+ * or 0 for a static IP. The subnet is found by its own DNN.
+ */
+ogs_pfcp_ue_ip_t *ogs_pfcp_ue_ip_restore(
+        int family, const char *dnn, uint8_t *addr, int index)
+{
+    ogs_pfcp_subnet_t *subnet = NULL;
+    ogs_pfcp_ue_ip_t *ue_ip = NULL;
+    size_t maxbytes = family == AF_INET ? OGS_IPV4_LEN : OGS_IPV6_LEN;
+
+    ogs_assert(dnn);
+    ogs_assert(addr);
+
+    ogs_list_for_each(&self.subnet_list, subnet) {
+        if ((subnet->family == AF_UNSPEC || subnet->family == family) &&
+            ogs_strcasecmp(subnet->dnn, dnn) == 0)
+            break;
+    }
+    if (!subnet) {
+        ogs_error("No subnet [family:%d, dnn:%s]", family, dnn);
+        return NULL;
+    }
+
+    if (index == 0) {
+        ue_ip = ogs_calloc(1, sizeof(ogs_pfcp_ue_ip_t));
+        ogs_assert(ue_ip);
+
+        ue_ip->subnet = subnet;
+        ue_ip->static_ip = true;
+        memcpy(ue_ip->addr, addr, maxbytes);
+
+        return ue_ip;
+    }
+
+    /* The range of the subnet may have been changed */
+    if (index < 0 || index > subnet->pool.size ||
+        memcmp(subnet->pool.array[index-1].addr, addr, maxbytes) != 0) {
+        ogs_error("UE IP is not in the subnet [family:%d, dnn:%s]",
+                family, dnn);
+        return NULL;
+    }
+
+    ogs_pool_restore(&subnet->pool, &ue_ip, index);
+    if (!ue_ip)
+        ogs_error("UE IP is already in use [family:%d, dnn:%s]",
+                family, dnn);
+
+    return ue_ip;
+}
+
 void ogs_pfcp_ue_ip_free(ogs_pfcp_ue_ip_t *ue_ip)
 {
     ogs_pfcp_subnet_t *subnet = NULL;
@@ -1776,6 +2411,17 @@ ogs_pfcp_subnet_t *ogs_pfcp_find_subnet_by_dnn(int family, const char *dnn)
     return subnet;
 }
 
+/* The PDRs and the UE IP pools can be allocated again */
+void ogs_pfcp_restore_done(void)
+{
+    ogs_pfcp_subnet_t *subnet = NULL;
+
+    ogs_pool_restore_done(&ogs_pfcp_pdr_pool);
+
+    ogs_list_for_each(&self.subnet_list, subnet)
+        ogs_pool_restore_done(&subnet->pool);
+}
+
 void ogs_pfcp_pool_init(ogs_pfcp_sess_t *sess)
 {
     int i;
@@ -39,6 +39,46 @@ extern "C" {
 #define OGS_MAX_NUM_OF_DEV      16
 #define OGS_MAX_NUM_OF_SUBNET   16
 
+/*
+ * Downlink buffering
+ *
+ * While the UE is paged, the UP function queues the downlink packets
+ * in the FAR. All sessions share one byte budget (ogs_app()->pool.buffer)
+ * which is counted in clusters, since a small packet pins a whole cluster.
+ * A session may use at most an equal share of the budget among the
+ * buffering sessions, and at most the Suggested Buffering Packets Count
+ * of its BAR.
+ */
+typedef enum {
+    OGS_PFCP_BUFFER_DROP_BUDGET = 0,    /* The byte budget is used up */
+    OGS_PFCP_BUFFER_DROP_UE_LIMIT,      /* Over the share of the session */
+    OGS_PFCP_BUFFER_DROP_EXPIRED,       /* DL Buffering Duration expired */
+    OGS_PFCP_BUFFER_DROP_REMOVED,       /* The FAR has been removed */
+
+    OGS_PFCP_MAX_NUM_OF_BUFFER_DROP,
+} ogs_pfcp_buffer_drop_e;
+
+/*
+ * Session Report Request of the UP function
+ *
+ * A report is not sent at once, but queued on the PFCP node of the session
+ * for 'window'. The reports of the same session in the meantime are merged
+ * into one request, so a burst of Error Indications or of downlink packets
+ * yields one request per session. The queue of a node is drained with
+ * a token bucket of 'rate' requests per second and 'burst' requests,
+ * so that a storm is spread out instead of flooding the CP function.
+ * A report type which is queued or waiting for its response is suppressed.
+ */
+typedef enum {
+    OGS_PFCP_REPORT_QUEUED = 0,         /* A new request is queued */
+    OGS_PFCP_REPORT_MERGED,             /* Merged into a queued request */
+    OGS_PFCP_REPORT_SUPPRESSED,         /* The CP function is handling it */
+    OGS_PFCP_REPORT_SENT,
+    OGS_PFCP_REPORT_THROTTLED,          /* The flush ran out of tokens */
+
+    OGS_PFCP_MAX_NUM_OF_REPORT_RESULT,
+} ogs_pfcp_report_result_e;
+
 typedef struct ogs_pfcp_node_s ogs_pfcp_node_t;
 
 typedef struct ogs_pfcp_context_s {
@@ -64,12 +104,37 @@ typedef struct ogs_pfcp_context_s {
     ogs_list_t      pfcp_peer_list; /* PFCP Node List */
     ogs_pfcp_node_t *pfcp_node;     /* Iterator for Peer round-robin */
 
+    /* Load/Overload Control Information reported by the UP function */
+    struct {
+        uint32_t    sqn;            /* Load Control Sequence Number */
+        uint8_t     metric;         /* Load Metric (0-100) */
+    } load;
+    struct {
+        uint32_t    sqn;            /* Overload Control Sequence Number */
+        uint8_t     metric;         /* Overload Reduction Metric (0-100) */
+        ogs_time_t  updated;        /* Time when the metric was changed */
+    } overload;
+
     ogs_list_t      dev_list;       /* Tun Device List */
     ogs_list_t      subnet_list;    /* UE Subnet List */
 
-    ogs_hash_t      *object_teid_hash; /* hash table for PFCP OBJ(TEID) */
+    ogs_ihash_t     *object_teid_hash; /* hash table for PFCP OBJ(TEID) */
     ogs_hash_t      *far_f_teid_hash;  /* hash table for FAR(TEID+ADDR) */
-    ogs_hash_t      *far_teid_hash; /* hash table for FAR(TEID) */
+    ogs_ihash_t     *far_teid_hash; /* hash table for FAR(TEID) */
+
+    /* Downlink packets buffered by the UP function */
+    struct {
+        uint64_t    bytes;          /* Clusters held by buffered packets */
+        uint32_t    num_of_sess;    /* Sessions with a buffered packet */
+    } buffer;
+
+    /* Session Report Requests of the UP function */
+    struct {
+        ogs_time_t  window;         /* Time to merge the reports */
+        uint32_t    rate;           /* Requests per second, 0: no limit */
+        uint32_t    burst;
+        uint32_t    num_of_pending; /* Sessions with a queued report */
+    } report;
 } ogs_pfcp_context_t;
 
 #define OGS_SETUP_PFCP_NODE(__cTX, __pNODE) \
@@ -110,6 +175,28 @@ typedef struct ogs_pfcp_node_s {
 
     ogs_pfcp_up_function_features_t up_function_features;
     int up_function_features_len;
+
+    /* Load/Overload Control Information received from the UP function */
+    struct {
+        bool        received;
+        uint32_t    sqn;
+        uint8_t     metric;
+    } load;
+    struct {
+        bool        received;
+        uint32_t    sqn;
+        uint8_t     metric;
+        ogs_time_t  expires;        /* End of the Period of Validity */
+        uint8_t     throttle;       /* Credit for rejecting establishments */
+    } overload;
+
+    /* Session Report Requests queued by the UP function */
+    struct {
+        ogs_list_t  pending_list;   /* In the order of queueing */
+        ogs_timer_t *timer;         /* Set by the UP function */
+        int64_t     tokens;         /* Requests x OGS_USEC_PER_SEC */
+        ogs_time_t  refilled;
+    } report;
 } ogs_pfcp_node_t;
 
 typedef enum {
@@ -133,9 +220,45 @@ typedef struct ogs_pfcp_urr_s ogs_pfcp_urr_t;
 typedef struct ogs_pfcp_qer_s ogs_pfcp_qer_t;
 typedef struct ogs_pfcp_bar_s ogs_pfcp_bar_t;
 
+/*
+ * Forwarding entry of a PDR
+ *
+ * The user plane forwards a packet with this cache line only, instead of
+ * going through the PDR, FAR, QER, GTP-U node and socket of the packet.
+ * It is a copy, so it is rebuilt with ogs_pfcp_sess_update_fwd()
+ * once the PFCP session is established or modified. Only the GTP-U node
+ * is shared, for the state of its path.
+ */
+typedef struct ogs_pfcp_pdr_fwd_s {
+    uint8_t                 src_if;     /* Source Interface of the PDR */
+    uint8_t                 dst_if;     /* Destination Interface of the FAR */
+    bool                    ohc;        /* Outer Header Creation in the FAR */
+    bool                    rule;       /* SDF Filter in the PDR */
+
+    /* Forward as a G-PDU without the FAR (FORW, nothing buffered) */
+    bool                    gtpu;
+    uint8_t                 qfi;        /* QFI of the QER for 5GC */
+    uint32_t                teid;       /* TEID of the Outer Header */
+
+    ogs_gtp_node_t          *gnode;
+    ogs_socket_t            fd;         /* GTP-U socket */
+    union {
+        struct sockaddr     sa;
+        struct sockaddr_in  sin;
+        struct sockaddr_in6 sin6;
+    } addr;                             /* GTP-U peer */
+
+    /* TUN device of the UE subnet, set by the UPF */
+    struct {
+        ogs_socket_t        fd4;
+        ogs_socket_t        fd6;
+    } tun;
+} __attribute__ ((aligned (64))) ogs_pfcp_pdr_fwd_t;
+
 typedef struct ogs_pfcp_pdr_s {
     ogs_pfcp_object_t       obj;
     uint32_t                index;
+    ogs_pfcp_pdr_fwd_t      *fwd;           /* Forwarding Entry */
 
     struct {
         struct {
@@ -156,6 +279,11 @@ typedef struct ogs_pfcp_pdr_s {
 
     ogs_pfcp_ue_ip_addr_t   ue_ip_addr;
     int                     ue_ip_addr_len;
+    uint8_t                 ue_ipv6_prefixlen;  /* 0 : Default /64 */
+
+    /* Framed-Route, Framed-IPv6-Route (family is 0 if not present) */
+    ogs_ipsubnet_t          ipv4_framed_route;
+    ogs_ipsubnet_t          ipv6_framed_route;
 
     ogs_pfcp_f_teid_t       f_teid;
     int                     f_teid_len;
@@ -211,8 +339,11 @@ typedef struct ogs_pfcp_far_s {
 
     ogs_pfcp_smreq_flags_t  smreq_flags;
 
-    uint32_t                num_of_buffered_packet;
-    ogs_pkbuf_t             *buffered_packet[OGS_MAX_NUM_OF_PACKET_BUFFER];
+    struct {
+        ogs_list_t          list;       /* Buffered Packet List */
+        uint32_t            num_of_packet;
+        bool                reported;   /* Downlink Data Report is sent */
+    } buffer;
 
     struct {
         bool prepared;
@@ -253,6 +384,15 @@ typedef struct ogs_pfcp_bar_s {
     uint8_t                 *id_node;      /* Pool-Node for ID */
     ogs_pfcp_bar_id_t       id;
 
+    /* Suggested Buffering Packets Count (0 : default) */
+    uint8_t                 suggested_packet_count;
+
+    /* Saved from the Update BAR of the PFCP Session Report Response */
+    struct {
+        ogs_timer_t         *timer;     /* DL Buffering Duration */
+        uint16_t            packet_count;
+    } dl_buffering;
+
     ogs_pfcp_sess_t         *sess;
 } ogs_pfcp_bar_t;
 
@@ -265,6 +405,20 @@ typedef struct ogs_pfcp_sess_s {
     ogs_list_t          qer_list;       /* QER List */
     ogs_pfcp_bar_t      *bar;           /* BAR Item */
 
+    struct {
+        uint32_t        num_of_packet;  /* Buffered in all FARs */
+        uint64_t        bytes;
+    } buffer;
+
+    /* Session Report Request of the UP function */
+    struct {
+        ogs_lnode_t     lnode;          /* Node of the pending list */
+        ogs_pfcp_node_t *node;          /* Queued on this node */
+        ogs_time_t      queued;
+        ogs_pfcp_user_plane_report_t pending;
+        uint8_t         in_flight;      /* Report types sent, no response */
+    } report;
+
     OGS_POOL(pdr_id_pool, uint8_t);
     OGS_POOL(far_id_pool, uint8_t);
     OGS_POOL(urr_id_pool, uint8_t);
@@ -349,6 +503,24 @@ ogs_pfcp_node_t *ogs_pfcp_node_find(
 void ogs_pfcp_node_remove(ogs_list_t *list, ogs_pfcp_node_t *node);
 void ogs_pfcp_node_remove_all(ogs_list_t *list);
 
+/* Period of Validity of the Overload Control Information we send */
+#define OGS_PFCP_OVERLOAD_VALIDITY ogs_time_from_sec(10)
+
+bool ogs_pfcp_node_overloaded(ogs_pfcp_node_t *node);
+bool ogs_pfcp_node_throttled(ogs_pfcp_node_t *node);
+
+void ogs_pfcp_up_update_load(uint8_t metric);
+
+typedef void (*ogs_pfcp_up_report_send_f)(
+        ogs_pfcp_sess_t *sess, ogs_pfcp_user_plane_report_t *report);
+
+ogs_pfcp_report_result_e ogs_pfcp_up_report_add(ogs_pfcp_node_t *node,
+        ogs_pfcp_sess_t *sess, ogs_pfcp_user_plane_report_t *report);
+int ogs_pfcp_up_report_flush(
+        ogs_pfcp_node_t *node, ogs_pfcp_up_report_send_f send);
+void ogs_pfcp_up_report_done(ogs_pfcp_sess_t *sess);
+void ogs_pfcp_up_report_cancel(ogs_pfcp_sess_t *sess);
+
 ogs_gtpu_resource_t *ogs_pfcp_find_gtpu_resource(ogs_list_t *list,
         char *dnn, ogs_pfcp_interface_t source_interface);
 void ogs_pfcp_setup_far_gtpu_node(ogs_pfcp_far_t *far);
@@ -357,6 +529,7 @@ void ogs_pfcp_setup_pdr_gtpu_node(ogs_pfcp_pdr_t *pdr);
 void ogs_pfcp_sess_clear(ogs_pfcp_sess_t *sess);
 
 ogs_pfcp_pdr_t *ogs_pfcp_pdr_add(ogs_pfcp_sess_t *sess);
+ogs_pfcp_pdr_t *ogs_pfcp_pdr_restore(ogs_pfcp_sess_t *sess, uint32_t index);
 ogs_pfcp_pdr_t *ogs_pfcp_pdr_find(
         ogs_pfcp_sess_t *sess, ogs_pfcp_pdr_id_t id);
 ogs_pfcp_pdr_t *ogs_pfcp_pdr_find_or_add(
@@ -377,6 +550,9 @@ void ogs_pfcp_pdr_associate_qer(ogs_pfcp_pdr_t *pdr, ogs_pfcp_qer_t *qer);
 void ogs_pfcp_pdr_remove(ogs_pfcp_pdr_t *pdr);
 void ogs_pfcp_pdr_remove_all(ogs_pfcp_sess_t *sess);
 
+void ogs_pfcp_pdr_update_fwd(ogs_pfcp_pdr_t *pdr);
+void ogs_pfcp_sess_update_fwd(ogs_pfcp_sess_t *sess);
+
 ogs_pfcp_far_t *ogs_pfcp_far_add(ogs_pfcp_sess_t *sess);
 ogs_pfcp_far_t *ogs_pfcp_far_find(
         ogs_pfcp_sess_t *sess, ogs_pfcp_far_id_t id);
@@ -392,6 +568,11 @@ ogs_pfcp_far_t *ogs_pfcp_far_find_by_teid(uint32_t teid);
 void ogs_pfcp_far_remove(ogs_pfcp_far_t *far);
 void ogs_pfcp_far_remove_all(ogs_pfcp_sess_t *sess);
 
+int ogs_pfcp_far_buffer_add(ogs_pfcp_far_t *far, ogs_pkbuf_t *pkbuf);
+ogs_pkbuf_t *ogs_pfcp_far_buffer_remove(ogs_pfcp_far_t *far);
+void ogs_pfcp_far_buffer_clear(
+        ogs_pfcp_far_t *far, ogs_pfcp_buffer_drop_e cause);
+
 ogs_pfcp_urr_t *ogs_pfcp_urr_add(ogs_pfcp_sess_t *sess);
 ogs_pfcp_urr_t *ogs_pfcp_urr_find(
         ogs_pfcp_sess_t *sess, ogs_pfcp_urr_id_t id);
@@ -410,6 +591,9 @@ void ogs_pfcp_qer_remove_all(ogs_pfcp_sess_t *sess);
 
 ogs_pfcp_bar_t *ogs_pfcp_bar_new(ogs_pfcp_sess_t *sess);
 void ogs_pfcp_bar_delete(ogs_pfcp_bar_t *bar);
+void ogs_pfcp_bar_start_dl_buffering(
+        ogs_pfcp_bar_t *bar, ogs_time_t duration);
+void ogs_pfcp_bar_stop_dl_buffering(ogs_pfcp_bar_t *bar);
 
 ogs_pfcp_rule_t *ogs_pfcp_rule_add(ogs_pfcp_pdr_t *pdr);
 ogs_pfcp_rule_t *ogs_pfcp_rule_find_by_sdf_filter_id(
@@ -420,6 +604,8 @@ void ogs_pfcp_rule_remove_all(ogs_pfcp_pdr_t *pdr);
 int ogs_pfcp_ue_pool_generate(void);
 ogs_pfcp_ue_ip_t *ogs_pfcp_ue_ip_alloc(
         int family, const char *dnn, uint8_t *addr);
+ogs_pfcp_ue_ip_t *ogs_pfcp_ue_ip_restore(
+        int family, const char *dnn, uint8_t *addr, int index);
 void ogs_pfcp_ue_ip_free(ogs_pfcp_ue_ip_t *ip);
 
 ogs_pfcp_dev_t *ogs_pfcp_dev_add(const char *ifname);
@@ -436,6 +622,13 @@ void ogs_pfcp_subnet_remove_all(void);
 ogs_pfcp_subnet_t *ogs_pfcp_find_subnet(int family);
 ogs_pfcp_subnet_t *ogs_pfcp_find_subnet_by_dnn(int family, const char *dnn);
 
+/*
+ * Warm restart : the PDRs and the UE IP addresses are restored with
+ * ogs_pfcp_pdr_restore() and ogs_pfcp_ue_ip_restore(), and then
+ * ogs_pfcp_restore_done() is called before anything is freed.
+ */
+void ogs_pfcp_restore_done(void);
+
 void ogs_pfcp_pool_init(ogs_pfcp_sess_t *sess);
 void ogs_pfcp_pool_final(ogs_pfcp_sess_t *sess);
 
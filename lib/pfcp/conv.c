@@ -398,3 +398,61 @@ int ogs_pfcp_outer_header_creation_to_ip(
 
     return OGS_OK;
 }
+
+int ogs_pfcp_sockaddr_to_remote_gtp_u_peer(ogs_sockaddr_t *addr,
+    ogs_pfcp_remote_gtp_u_peer_t *remote_gtp_u_peer, int *len)
+{
+    const int hdr_len = 1;
+
+    ogs_assert(addr);
+    ogs_assert(remote_gtp_u_peer);
+
+    memset(remote_gtp_u_peer, 0, sizeof *remote_gtp_u_peer);
+
+    if (addr->ogs_sa_family == AF_INET) {
+        remote_gtp_u_peer->ipv4 = 1;
+        remote_gtp_u_peer->addr = addr->sin.sin_addr.s_addr;
+        *len = OGS_IPV4_LEN + hdr_len;
+    } else if (addr->ogs_sa_family == AF_INET6) {
+        remote_gtp_u_peer->ipv6 = 1;
+        memcpy(remote_gtp_u_peer->addr6,
+                addr->sin6.sin6_addr.s6_addr, OGS_IPV6_LEN);
+        *len = OGS_IPV6_LEN + hdr_len;
+    } else
+        return OGS_ERROR;
+
+    return OGS_OK;
+}
+
+int ogs_pfcp_remote_gtp_u_peer_to_ip(
+    ogs_pfcp_remote_gtp_u_peer_t *remote_gtp_u_peer, int len, ogs_ip_t *ip)
+{
+    const int hdr_len = 1;
+
+    ogs_assert(remote_gtp_u_peer);
+    ogs_assert(ip);
+
+    memset(ip, 0, sizeof *ip);
+
+    if (remote_gtp_u_peer->ipv4 && remote_gtp_u_peer->ipv6) {
+        if (len < OGS_IPV4V6_LEN + hdr_len) return OGS_ERROR;
+        ip->ipv4 = 1;
+        ip->ipv6 = 1;
+        ip->addr = remote_gtp_u_peer->both.addr;
+        memcpy(ip->addr6, remote_gtp_u_peer->both.addr6, OGS_IPV6_LEN);
+        ip->len = OGS_IPV4V6_LEN;
+    } else if (remote_gtp_u_peer->ipv4) {
+        if (len < OGS_IPV4_LEN + hdr_len) return OGS_ERROR;
+        ip->ipv4 = 1;
+        ip->addr = remote_gtp_u_peer->addr;
+        ip->len = OGS_IPV4_LEN;
+    } else if (remote_gtp_u_peer->ipv6) {
+        if (len < OGS_IPV6_LEN + hdr_len) return OGS_ERROR;
+        ip->ipv6 = 1;
+        memcpy(ip->addr6, remote_gtp_u_peer->addr6, OGS_IPV6_LEN);
+        ip->len = OGS_IPV6_LEN;
+    } else
+        return OGS_ERROR;
+
+    return OGS_OK;
+}
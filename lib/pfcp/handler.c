@@ -136,10 +136,143 @@ void ogs_pfcp_up_handle_association_setup_response(
     }
 }
 
+void ogs_pfcp_cp_handle_node_report_request(
+        ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_node_report_request_t *req)
+{
+    char buf[OGS_ADDRSTRLEN], peer_buf[OGS_ADDRSTRLEN];
+    ogs_pfcp_node_report_type_t node_report_type;
+    ogs_pfcp_tlv_remote_gtp_u_peer_t *message = NULL;
+    ogs_pfcp_remote_gtp_u_peer_t peer;
+    ogs_ip_t ip;
+
+    ogs_assert(node);
+    ogs_assert(xact);
+    ogs_assert(req);
+
+    if (req->node_report_type.presence == 0 ||
+        req->node_report_type.len < 1) {
+        ogs_error("No Node Report Type");
+        ogs_pfcp_cp_send_node_report_response(xact,
+                OGS_PFCP_CAUSE_MANDATORY_IE_MISSING);
+        return;
+    }
+
+    node_report_type.value = *(uint8_t *)req->node_report_type.data;
+
+    message = &req->user_plane_path_failure_report.remote_gtp_u_peer_;
+    if (node_report_type.user_plane_path_failure_report &&
+        req->user_plane_path_failure_report.presence &&
+        message->presence) {
+        memset(&peer, 0, sizeof(peer));
+        memcpy(&peer, message->data,
+                ogs_min(message->len, sizeof(peer)));
+
+        if (ogs_pfcp_remote_gtp_u_peer_to_ip(
+                    &peer, message->len, &ip) == OGS_OK) {
+            if (ip.ipv4)
+                OGS_INET_NTOP(&ip.addr, peer_buf);
+            else
+                OGS_INET6_NTOP(ip.addr6, peer_buf);
+            ogs_warn("[%s] User Plane Path Failure to [%s]",
+                    OGS_ADDR(&node->addr, buf), peer_buf);
+        } else
+            ogs_error("Invalid Remote GTP-U Peer");
+    }
+
+    ogs_pfcp_cp_send_node_report_response(
+            xact, OGS_PFCP_CAUSE_REQUEST_ACCEPTED);
+}
+
+void ogs_pfcp_up_handle_node_report_response(
+        ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_node_report_response_t *rsp)
+{
+    ogs_assert(xact);
+    ogs_pfcp_xact_commit(xact);
+
+    ogs_assert(rsp);
+    if (rsp->cause.presence &&
+        rsp->cause.u8 != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
+        ogs_warn("Node Report Response Cause [%d]", rsp->cause.u8);
+}
+
+/*
+ * A report is only applied if its sequence number is newer
+ * than the last one received from the same node.
+ */
+#define SQN_NEWER(__sQN, __lAST) ((int32_t)((__sQN) - (__lAST)) > 0)
+
+void ogs_pfcp_cp_handle_load_control_information(ogs_pfcp_node_t *node,
+        ogs_pfcp_tlv_load_control_information_t *message)
+{
+    ogs_assert(node);
+    ogs_assert(message);
+
+    if (!message->presence)
+        return;
+    if (!message->load_control_sequence_number.presence ||
+        !message->load_metric.presence) {
+        ogs_error("Invalid Load Control Information");
+        return;
+    }
+
+    if (node->load.received &&
+        !SQN_NEWER(message->load_control_sequence_number.u32,
+            node->load.sqn))
+        return;
+
+    node->load.received = true;
+    node->load.sqn = message->load_control_sequence_number.u32;
+    node->load.metric = ogs_min(
+            message->load_metric.u8, OGS_PFCP_METRIC_MAX);
+
+    ogs_debug("Load Metric [%d] SQN[%d]", node->load.metric, node->load.sqn);
+}
+
+void ogs_pfcp_cp_handle_overload_control_information(ogs_pfcp_node_t *node,
+        ogs_pfcp_tlv_overload_control_information_t *message)
+{
+    ogs_time_t validity;
+
+    ogs_assert(node);
+    ogs_assert(message);
+
+    if (!message->presence)
+        return;
+    if (!message->overload_control_sequence_number.presence ||
+        !message->overload_reduction_metric.presence ||
+        !message->period_of_validity.presence) {
+        ogs_error("Invalid Overload Control Information");
+        return;
+    }
+
+    if (node->overload.received &&
+        !SQN_NEWER(message->overload_control_sequence_number.u32,
+            node->overload.sqn))
+        return;
+
+    node->overload.received = true;
+    node->overload.sqn = message->overload_control_sequence_number.u32;
+    node->overload.metric = ogs_min(
+            message->overload_reduction_metric.u8, OGS_PFCP_METRIC_MAX);
+
+    validity = ogs_pfcp_timer_to_time(message->period_of_validity.u8);
+    node->overload.expires = validity ?
+        ogs_get_monotonic_time() + validity : 0;
+
+    if (node->overload.metric)
+        ogs_warn("UPF overloaded : Reduction Metric [%d] SQN[%d]",
+                node->overload.metric, node->overload.sqn);
+    else
+        ogs_info("UPF overload ended : SQN[%d]", node->overload.sqn);
+}
+
 void ogs_pfcp_up_handle_pdr(
         ogs_pfcp_pdr_t *pdr, ogs_pkbuf_t *recvbuf,
         ogs_pfcp_user_plane_report_t *report)
 {
+    ogs_pfcp_pdr_fwd_t *fwd = NULL;
     ogs_pfcp_far_t *far = NULL;
     ogs_pkbuf_t *sendbuf = NULL;
     bool buffering;
@@ -148,9 +281,6 @@ void ogs_pfcp_up_handle_pdr(
     ogs_assert(pdr);
     ogs_assert(report);
 
-    far = pdr->far;
-    ogs_assert(far);
-
     memset(report, 0, sizeof(*report));
 
     sendbuf = ogs_pkbuf_copy(recvbuf);
@@ -161,6 +291,17 @@ void ogs_pfcp_up_handle_pdr(
         return;
     }
 
+    fwd = pdr->fwd;
+    ogs_assert(fwd);
+    if (fwd->gtpu && !fwd->gnode->path.down) {
+        /* Fast path : the FAR, QER and socket are not touched */
+        ogs_pfcp_send_g_pdu_fwd(fwd, sendbuf);
+        return;
+    }
+
+    far = pdr->far;
+    ogs_assert(far);
+
     buffering = false;
 
     if (!far->gnode) {
@@ -169,6 +310,25 @@ void ogs_pfcp_up_handle_pdr(
     } else {
         if (far->apply_action & OGS_PFCP_APPLY_ACTION_FORW) {
 
+            ogs_gtp_node_t *gnode = far->gnode;
+
+            if (gnode->path.down) {
+                /*
+                 * The GTP-U path has failed, and the SMF has been told
+                 * with one Node Report for the peer. Hold the packet
+                 * without a Downlink Data Report for each session.
+                 */
+                ogs_pfcp_far_buffer_add(far, sendbuf);
+                return;
+            }
+
+            /* The packets held while the path was down go first */
+            if (far->buffer.num_of_packet) {
+                ogs_pkbuf_t *pkbuf = NULL;
+                while ((pkbuf = ogs_pfcp_far_buffer_remove(far)))
+                    ogs_pfcp_send_g_pdu(pdr, pkbuf);
+            }
+
             /* Forward packet */
             ogs_pfcp_send_g_pdu(pdr, sendbuf);
 
@@ -183,18 +343,14 @@ void ogs_pfcp_up_handle_pdr(
     }
 
     if (buffering == true) {
-
-        if (far->num_of_buffered_packet == 0) {
+        if (far->buffer.reported == false) {
             /* Only the first time a packet is buffered,
              * it reports downlink notifications. */
             report->type.downlink_data_report = 1;
+            far->buffer.reported = true;
         }
 
-        if (far->num_of_buffered_packet < OGS_MAX_NUM_OF_PACKET_BUFFER) {
-            far->buffered_packet[far->num_of_buffered_packet++] = sendbuf;
-        } else {
-            ogs_pkbuf_free(sendbuf);
-        }
+        ogs_pfcp_far_buffer_add(far, sendbuf);
     }
 }
 
@@ -232,6 +388,89 @@ void ogs_pfcp_up_handle_error_indication(
     report->type.error_indication_report = 1;
 }
 
+/*
+ * 8.2.62 UE IP Address
+ *
+ * The IPv6 Prefix Delegation Bits and the IPv6 Prefix Length
+ * follow the IPv4/IPv6 addresses.
+ */
+static void handle_ue_ip_address(
+        ogs_pfcp_pdr_t *pdr, ogs_pfcp_tlv_ue_ip_address_t *message)
+{
+    uint8_t *data = NULL;
+    int offset;
+
+    ogs_assert(pdr);
+    ogs_assert(message);
+
+    memset(&pdr->ue_ip_addr, 0, sizeof(pdr->ue_ip_addr));
+    pdr->ue_ip_addr_len = 0;
+    pdr->ue_ipv6_prefixlen = 0;
+
+    if (message->presence == 0)
+        return;
+
+    data = message->data;
+    ogs_assert(data);
+
+    pdr->ue_ip_addr_len = ogs_min(message->len, sizeof(pdr->ue_ip_addr));
+    memcpy(&pdr->ue_ip_addr, data, pdr->ue_ip_addr_len);
+
+    offset = 1;
+    if (pdr->ue_ip_addr.ipv4)
+        offset += OGS_IPV4_LEN;
+    if (pdr->ue_ip_addr.ipv6)
+        offset += OGS_IPV6_LEN;
+
+    if (pdr->ue_ip_addr.ipv6d && offset < message->len) {
+        /* e.g. 3 bits of delegation => /61 */
+        if (data[offset] <= 64)
+            pdr->ue_ipv6_prefixlen = 64 - data[offset];
+        offset++;
+    }
+    if (pdr->ue_ip_addr.ip6pl && offset < message->len) {
+        if (data[offset] <= 128)
+            pdr->ue_ipv6_prefixlen = data[offset];
+    }
+}
+
+/*
+ * 8.2.109 Framed-Route, 8.2.111 Framed-IPv6-Route
+ *
+ * The value is encoded as the RADIUS attribute (RFC 2865, RFC 3162)
+ * e.g. "192.168.1.0/24 0.0.0.0 1". Only the prefix is used.
+ */
+static void handle_framed_route(ogs_ipsubnet_t *route, ogs_tlv_octet_t *message)
+{
+    char buf[OGS_ADDRSTRLEN+5];
+    char *mask_or_numbits = NULL, *p = NULL;
+
+    ogs_assert(route);
+    ogs_assert(message);
+
+    memset(route, 0, sizeof(*route));
+
+    if (message->presence == 0)
+        return;
+
+    ogs_assert(message->data);
+    ogs_cpystrn(buf, message->data, ogs_min(message->len, sizeof(buf)-1) + 1);
+
+    p = strchr(buf, ' ');
+    if (p)
+        *p = 0;
+    p = strchr(buf, '/');
+    if (p) {
+        *p = 0;
+        mask_or_numbits = p + 1;
+    }
+
+    if (ogs_ipsubnet(route, buf, mask_or_numbits) != OGS_OK) {
+        ogs_error("Invalid Framed-Route [%s]", buf);
+        memset(route, 0, sizeof(*route));
+    }
+}
+
 ogs_pfcp_pdr_t *ogs_pfcp_handle_create_pdr(ogs_pfcp_sess_t *sess,
         ogs_pfcp_tlv_create_pdr_t *message,
         uint8_t *cause_value, uint8_t *offending_ie_value)
@@ -410,14 +649,11 @@ ogs_pfcp_pdr_t *ogs_pfcp_handle_create_pdr(ogs_pfcp_sess_t *sess,
         pdr->qfi = message->pdi.qfi.u8;
     }
 
-    memset(&pdr->ue_ip_addr, 0, sizeof(pdr->ue_ip_addr));
-    pdr->ue_ip_addr_len = 0;
+    handle_ue_ip_address(pdr, &message->pdi.ue_ip_address);
 
-    if (message->pdi.ue_ip_address.presence) {
-        pdr->ue_ip_addr_len = message->pdi.ue_ip_address.len;
-        memcpy(&pdr->ue_ip_addr,
-                message->pdi.ue_ip_address.data, pdr->ue_ip_addr_len);
-    }
+    handle_framed_route(&pdr->ipv4_framed_route, &message->pdi.framed_route);
+    handle_framed_route(&pdr->ipv6_framed_route,
+            &message->pdi.framed_ipv6_route);
 
     memset(&pdr->outer_header_removal, 0, sizeof(pdr->outer_header_removal));
     pdr->outer_header_removal_len = 0;
@@ -642,6 +878,13 @@ ogs_pfcp_pdr_t *ogs_pfcp_handle_update_pdr(ogs_pfcp_sess_t *sess,
         if (message->pdi.qfi.presence) {
             pdr->qfi = message->pdi.qfi.u8;
         }
+
+        if (message->pdi.framed_route.presence)
+            handle_framed_route(&pdr->ipv4_framed_route,
+                    &message->pdi.framed_route);
+        if (message->pdi.framed_ipv6_route.presence)
+            handle_framed_route(&pdr->ipv6_framed_route,
+                    &message->pdi.framed_ipv6_route);
     }
 
     return pdr;
@@ -1007,9 +1250,103 @@ ogs_pfcp_bar_t *ogs_pfcp_handle_create_bar(ogs_pfcp_sess_t *sess,
 
     sess->bar->id = message->bar_id.u8;
 
+    if (message->suggested_buffering_packets_count.presence &&
+        message->suggested_buffering_packets_count.len) {
+        sess->bar->suggested_packet_count =
+            *(uint8_t *)message->suggested_buffering_packets_count.data;
+    }
+
     return sess->bar;
 }
 
+ogs_pfcp_bar_t *ogs_pfcp_handle_update_bar(ogs_pfcp_sess_t *sess,
+        ogs_pfcp_tlv_update_bar_session_modification_request_t *message,
+        uint8_t *cause_value, uint8_t *offending_ie_value)
+{
+    ogs_assert(message);
+    ogs_assert(sess);
+
+    if (message->presence == 0)
+        return NULL;
+
+    if (message->bar_id.presence == 0) {
+        ogs_error("No BAR-ID");
+        *cause_value = OGS_PFCP_CAUSE_MANDATORY_IE_MISSING;
+        *offending_ie_value = OGS_PFCP_BAR_ID_TYPE;
+        return NULL;
+    }
+
+    if (!sess->bar || sess->bar->id != message->bar_id.u8) {
+        ogs_error("[%p] Unknown BAR-ID[%d]", sess->bar, message->bar_id.u8);
+        *cause_value = OGS_PFCP_CAUSE_SESSION_CONTEXT_NOT_FOUND;
+        return NULL;
+    }
+
+    if (message->suggested_buffering_packets_count.presence &&
+        message->suggested_buffering_packets_count.len) {
+        sess->bar->suggested_packet_count =
+            *(uint8_t *)message->suggested_buffering_packets_count.data;
+    }
+
+    return sess->bar;
+}
+
+/*
+ * TS29.244 5.2.4.1 Downlink Data Report
+ *
+ * The CP function may ask the UP function to keep on buffering
+ * for the DL Buffering Duration, e.g. when the UE is not reachable,
+ * with at most the DL Buffering Suggested Packet Count.
+ * No further Downlink Data Report is sent during the duration.
+ * When it expires, the buffered packets are dropped.
+ */
+ogs_pfcp_bar_t *ogs_pfcp_handle_update_bar_report_response(
+        ogs_pfcp_sess_t *sess,
+        ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *message)
+{
+    ogs_pfcp_bar_t *bar = NULL;
+    ogs_time_t duration;
+
+    ogs_assert(message);
+    ogs_assert(sess);
+
+    if (message->presence == 0)
+        return NULL;
+
+    bar = sess->bar;
+    if (!bar || message->bar_id.presence == 0 ||
+            bar->id != message->bar_id.u8) {
+        ogs_error("[%p] Unknown BAR-ID[%d]", bar, message->bar_id.u8);
+        return NULL;
+    }
+
+    if (message->suggested_buffering_packets_count.presence &&
+        message->suggested_buffering_packets_count.len) {
+        bar->suggested_packet_count =
+            *(uint8_t *)message->suggested_buffering_packets_count.data;
+    }
+
+    if (message->dl_buffering_duration.presence &&
+        message->dl_buffering_duration.len) {
+        duration = ogs_pfcp_timer_to_time(
+                *(uint8_t *)message->dl_buffering_duration.data);
+        /* A zero or infinite duration is bounded by the packet count */
+        ogs_pfcp_bar_start_dl_buffering(bar, duration);
+    }
+
+    if (message->dl_buffering_suggested_packet_count.presence) {
+        ogs_tlv_octet_t *count = &message->dl_buffering_suggested_packet_count;
+        uint8_t *p = count->data;
+
+        if (count->len == 1)
+            bar->dl_buffering.packet_count = p[0];
+        else if (count->len == 2)
+            bar->dl_buffering.packet_count = (p[0] << 8) | p[1];
+    }
+
+    return bar;
+}
+
 bool ogs_pfcp_handle_remove_bar(ogs_pfcp_sess_t *sess,
         ogs_pfcp_tlv_remove_bar_t *message,
         uint8_t *cause_value, uint8_t *offending_ie_value)
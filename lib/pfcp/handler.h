@@ -45,6 +45,18 @@ void ogs_pfcp_up_handle_association_setup_response(
         ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
         ogs_pfcp_association_setup_response_t *req);
 
+void ogs_pfcp_cp_handle_node_report_request(
+        ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_node_report_request_t *req);
+void ogs_pfcp_up_handle_node_report_response(
+        ogs_pfcp_node_t *node, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_node_report_response_t *rsp);
+
+void ogs_pfcp_cp_handle_load_control_information(ogs_pfcp_node_t *node,
+        ogs_pfcp_tlv_load_control_information_t *message);
+void ogs_pfcp_cp_handle_overload_control_information(ogs_pfcp_node_t *node,
+        ogs_pfcp_tlv_overload_control_information_t *message);
+
 void ogs_pfcp_up_handle_pdr(
         ogs_pfcp_pdr_t *pdr, ogs_pkbuf_t *recvbuf,
         ogs_pfcp_user_plane_report_t *report);
@@ -90,6 +102,12 @@ bool ogs_pfcp_handle_remove_qer(ogs_pfcp_sess_t *sess,
 ogs_pfcp_bar_t *ogs_pfcp_handle_create_bar(ogs_pfcp_sess_t *sess,
         ogs_pfcp_tlv_create_bar_t *message,
         uint8_t *cause_value, uint8_t *offending_ie_value);
+ogs_pfcp_bar_t *ogs_pfcp_handle_update_bar(ogs_pfcp_sess_t *sess,
+        ogs_pfcp_tlv_update_bar_session_modification_request_t *message,
+        uint8_t *cause_value, uint8_t *offending_ie_value);
+ogs_pfcp_bar_t *ogs_pfcp_handle_update_bar_report_response(
+        ogs_pfcp_sess_t *sess,
+        ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *message);
 bool ogs_pfcp_handle_remove_bar(ogs_pfcp_sess_t *sess,
         ogs_pfcp_tlv_remove_bar_t *message,
         uint8_t *cause_value, uint8_t *offending_ie_value);
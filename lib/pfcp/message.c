@@ -20,7 +20,7 @@
 /*******************************************************************************
  * This file had been created by pfcp-tlv.py script v0.1.0
  * Please do not modify this file but regenerate it via script.
- * Created on: 2020-08-28 21:50:38.885547 by acetcom
+ * Created on: 2026-10-18 21:39:19.220434 by root
  * from 29244-g10.docx
  ******************************************************************************/
 
@@ -380,10 +380,10 @@ ogs_tlv_desc_t ogs_pfcp_tlv_desc_pfcpsrrsp_flags =
 
 ogs_tlv_desc_t ogs_pfcp_tlv_desc_sequence_number =
 {
-    OGS_TLV_VAR_STR,
+    OGS_TLV_UINT32,
     "Sequence Number",
     OGS_PFCP_SEQUENCE_NUMBER_TYPE,
-    0,
+    4,
     0,
     sizeof(ogs_pfcp_tlv_sequence_number_t),
     { NULL }
@@ -391,10 +391,10 @@ ogs_tlv_desc_t ogs_pfcp_tlv_desc_sequence_number =
 
 ogs_tlv_desc_t ogs_pfcp_tlv_desc_metric =
 {
-    OGS_TLV_VAR_STR,
+    OGS_TLV_UINT8,
     "Metric",
     OGS_PFCP_METRIC_TYPE,
-    0,
+    1,
     0,
     sizeof(ogs_pfcp_tlv_metric_t),
     { NULL }
@@ -402,10 +402,10 @@ ogs_tlv_desc_t ogs_pfcp_tlv_desc_metric =
 
 ogs_tlv_desc_t ogs_pfcp_tlv_desc_timer =
 {
-    OGS_TLV_VAR_STR,
+    OGS_TLV_UINT8,
     "Timer",
     OGS_PFCP_TIMER_TYPE,
-    0,
+    1,
     0,
     sizeof(ogs_pfcp_tlv_timer_t),
     { NULL }
@@ -853,10 +853,10 @@ ogs_tlv_desc_t ogs_pfcp_tlv_desc_qer_id =
 
 ogs_tlv_desc_t ogs_pfcp_tlv_desc_oci_flags =
 {
-    OGS_TLV_VAR_STR,
+    OGS_TLV_UINT8,
     "OCI Flags",
     OGS_PFCP_OCI_FLAGS_TYPE,
-    0,
+    1,
     0,
     sizeof(ogs_pfcp_tlv_oci_flags_t),
     { NULL }
@@ -2741,244 +2741,7153 @@ ogs_tlv_desc_t ogs_pfcp_msg_desc_pfcp_session_report_response =
 }};
 
 
-int ogs_pfcp_parse_msg(ogs_pfcp_message_t *pfcp_message, ogs_pkbuf_t *pkbuf)
+/* Direct encoder/decoder */
+#define TLV_MODE OGS_TLV_MODE_T2_L2
+#define TLV_HLEN 4
+
+static uint32_t tlv_length_ethernet_packet_filter(ogs_pfcp_tlv_ethernet_packet_filter_t *ie);
+static uint8_t *tlv_write_ethernet_packet_filter(uint8_t *pos, ogs_pfcp_tlv_ethernet_packet_filter_t *ie);
+static int tlv_read_ethernet_packet_filter(
+        ogs_pfcp_tlv_ethernet_packet_filter_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_pdi(ogs_pfcp_tlv_pdi_t *ie);
+static uint8_t *tlv_write_pdi(uint8_t *pos, ogs_pfcp_tlv_pdi_t *ie);
+static int tlv_read_pdi(
+        ogs_pfcp_tlv_pdi_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_pdr(ogs_pfcp_tlv_create_pdr_t *ie);
+static uint8_t *tlv_write_create_pdr(uint8_t *pos, ogs_pfcp_tlv_create_pdr_t *ie);
+static int tlv_read_create_pdr(
+        ogs_pfcp_tlv_create_pdr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_forwarding_parameters(ogs_pfcp_tlv_forwarding_parameters_t *ie);
+static uint8_t *tlv_write_forwarding_parameters(uint8_t *pos, ogs_pfcp_tlv_forwarding_parameters_t *ie);
+static int tlv_read_forwarding_parameters(
+        ogs_pfcp_tlv_forwarding_parameters_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_duplicating_parameters(ogs_pfcp_tlv_duplicating_parameters_t *ie);
+static uint8_t *tlv_write_duplicating_parameters(uint8_t *pos, ogs_pfcp_tlv_duplicating_parameters_t *ie);
+static int tlv_read_duplicating_parameters(
+        ogs_pfcp_tlv_duplicating_parameters_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_far(ogs_pfcp_tlv_create_far_t *ie);
+static uint8_t *tlv_write_create_far(uint8_t *pos, ogs_pfcp_tlv_create_far_t *ie);
+static int tlv_read_create_far(
+        ogs_pfcp_tlv_create_far_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_forwarding_parameters(ogs_pfcp_tlv_update_forwarding_parameters_t *ie);
+static uint8_t *tlv_write_update_forwarding_parameters(uint8_t *pos, ogs_pfcp_tlv_update_forwarding_parameters_t *ie);
+static int tlv_read_update_forwarding_parameters(
+        ogs_pfcp_tlv_update_forwarding_parameters_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_duplicating_parameters(ogs_pfcp_tlv_update_duplicating_parameters_t *ie);
+static uint8_t *tlv_write_update_duplicating_parameters(uint8_t *pos, ogs_pfcp_tlv_update_duplicating_parameters_t *ie);
+static int tlv_read_update_duplicating_parameters(
+        ogs_pfcp_tlv_update_duplicating_parameters_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_far(ogs_pfcp_tlv_update_far_t *ie);
+static uint8_t *tlv_write_update_far(uint8_t *pos, ogs_pfcp_tlv_update_far_t *ie);
+static int tlv_read_update_far(
+        ogs_pfcp_tlv_update_far_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_pfd_context(ogs_pfcp_tlv_pfd_context_t *ie);
+static uint8_t *tlv_write_pfd_context(uint8_t *pos, ogs_pfcp_tlv_pfd_context_t *ie);
+static int tlv_read_pfd_context(
+        ogs_pfcp_tlv_pfd_context_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_application_id_s_pfds(ogs_pfcp_tlv_application_id_s_pfds_t *ie);
+static uint8_t *tlv_write_application_id_s_pfds(uint8_t *pos, ogs_pfcp_tlv_application_id_s_pfds_t *ie);
+static int tlv_read_application_id_s_pfds(
+        ogs_pfcp_tlv_application_id_s_pfds_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_ethernet_traffic_information(ogs_pfcp_tlv_ethernet_traffic_information_t *ie);
+static uint8_t *tlv_write_ethernet_traffic_information(uint8_t *pos, ogs_pfcp_tlv_ethernet_traffic_information_t *ie);
+static int tlv_read_ethernet_traffic_information(
+        ogs_pfcp_tlv_ethernet_traffic_information_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_access_forwarding_action_information_1(ogs_pfcp_tlv_access_forwarding_action_information_1_t *ie);
+static uint8_t *tlv_write_access_forwarding_action_information_1(uint8_t *pos, ogs_pfcp_tlv_access_forwarding_action_information_1_t *ie);
+static int tlv_read_access_forwarding_action_information_1(
+        ogs_pfcp_tlv_access_forwarding_action_information_1_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_access_forwarding_action_information_2(ogs_pfcp_tlv_access_forwarding_action_information_2_t *ie);
+static uint8_t *tlv_write_access_forwarding_action_information_2(uint8_t *pos, ogs_pfcp_tlv_access_forwarding_action_information_2_t *ie);
+static int tlv_read_access_forwarding_action_information_2(
+        ogs_pfcp_tlv_access_forwarding_action_information_2_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_access_forwarding_action_information_1(ogs_pfcp_tlv_update_access_forwarding_action_information_1_t *ie);
+static uint8_t *tlv_write_update_access_forwarding_action_information_1(uint8_t *pos, ogs_pfcp_tlv_update_access_forwarding_action_information_1_t *ie);
+static int tlv_read_update_access_forwarding_action_information_1(
+        ogs_pfcp_tlv_update_access_forwarding_action_information_1_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_access_forwarding_action_information_2(ogs_pfcp_tlv_update_access_forwarding_action_information_2_t *ie);
+static uint8_t *tlv_write_update_access_forwarding_action_information_2(uint8_t *pos, ogs_pfcp_tlv_update_access_forwarding_action_information_2_t *ie);
+static int tlv_read_update_access_forwarding_action_information_2(
+        ogs_pfcp_tlv_update_access_forwarding_action_information_2_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_urr(ogs_pfcp_tlv_create_urr_t *ie);
+static uint8_t *tlv_write_create_urr(uint8_t *pos, ogs_pfcp_tlv_create_urr_t *ie);
+static int tlv_read_create_urr(
+        ogs_pfcp_tlv_create_urr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_qer(ogs_pfcp_tlv_create_qer_t *ie);
+static uint8_t *tlv_write_create_qer(uint8_t *pos, ogs_pfcp_tlv_create_qer_t *ie);
+static int tlv_read_create_qer(
+        ogs_pfcp_tlv_create_qer_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_created_pdr(ogs_pfcp_tlv_created_pdr_t *ie);
+static uint8_t *tlv_write_created_pdr(uint8_t *pos, ogs_pfcp_tlv_created_pdr_t *ie);
+static int tlv_read_created_pdr(
+        ogs_pfcp_tlv_created_pdr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_pdr(ogs_pfcp_tlv_update_pdr_t *ie);
+static uint8_t *tlv_write_update_pdr(uint8_t *pos, ogs_pfcp_tlv_update_pdr_t *ie);
+static int tlv_read_update_pdr(
+        ogs_pfcp_tlv_update_pdr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_bar_pfcp_session_report_response(ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *ie);
+static uint8_t *tlv_write_update_bar_pfcp_session_report_response(uint8_t *pos, ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *ie);
+static int tlv_read_update_bar_pfcp_session_report_response(
+        ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_urr(ogs_pfcp_tlv_update_urr_t *ie);
+static uint8_t *tlv_write_update_urr(uint8_t *pos, ogs_pfcp_tlv_update_urr_t *ie);
+static int tlv_read_update_urr(
+        ogs_pfcp_tlv_update_urr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_qer(ogs_pfcp_tlv_update_qer_t *ie);
+static uint8_t *tlv_write_update_qer(uint8_t *pos, ogs_pfcp_tlv_update_qer_t *ie);
+static int tlv_read_update_qer(
+        ogs_pfcp_tlv_update_qer_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_pdr(ogs_pfcp_tlv_remove_pdr_t *ie);
+static uint8_t *tlv_write_remove_pdr(uint8_t *pos, ogs_pfcp_tlv_remove_pdr_t *ie);
+static int tlv_read_remove_pdr(
+        ogs_pfcp_tlv_remove_pdr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_far(ogs_pfcp_tlv_remove_far_t *ie);
+static uint8_t *tlv_write_remove_far(uint8_t *pos, ogs_pfcp_tlv_remove_far_t *ie);
+static int tlv_read_remove_far(
+        ogs_pfcp_tlv_remove_far_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_urr(ogs_pfcp_tlv_remove_urr_t *ie);
+static uint8_t *tlv_write_remove_urr(uint8_t *pos, ogs_pfcp_tlv_remove_urr_t *ie);
+static int tlv_read_remove_urr(
+        ogs_pfcp_tlv_remove_urr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_qer(ogs_pfcp_tlv_remove_qer_t *ie);
+static uint8_t *tlv_write_remove_qer(uint8_t *pos, ogs_pfcp_tlv_remove_qer_t *ie);
+static int tlv_read_remove_qer(
+        ogs_pfcp_tlv_remove_qer_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_load_control_information(ogs_pfcp_tlv_load_control_information_t *ie);
+static uint8_t *tlv_write_load_control_information(uint8_t *pos, ogs_pfcp_tlv_load_control_information_t *ie);
+static int tlv_read_load_control_information(
+        ogs_pfcp_tlv_load_control_information_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_overload_control_information(ogs_pfcp_tlv_overload_control_information_t *ie);
+static uint8_t *tlv_write_overload_control_information(uint8_t *pos, ogs_pfcp_tlv_overload_control_information_t *ie);
+static int tlv_read_overload_control_information(
+        ogs_pfcp_tlv_overload_control_information_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_application_detection_information(ogs_pfcp_tlv_application_detection_information_t *ie);
+static uint8_t *tlv_write_application_detection_information(uint8_t *pos, ogs_pfcp_tlv_application_detection_information_t *ie);
+static int tlv_read_application_detection_information(
+        ogs_pfcp_tlv_application_detection_information_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_query_urr(ogs_pfcp_tlv_query_urr_t *ie);
+static uint8_t *tlv_write_query_urr(uint8_t *pos, ogs_pfcp_tlv_query_urr_t *ie);
+static int tlv_read_query_urr(
+        ogs_pfcp_tlv_query_urr_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_usage_report_session_modification_response(ogs_pfcp_tlv_usage_report_session_modification_response_t *ie);
+static uint8_t *tlv_write_usage_report_session_modification_response(uint8_t *pos, ogs_pfcp_tlv_usage_report_session_modification_response_t *ie);
+static int tlv_read_usage_report_session_modification_response(
+        ogs_pfcp_tlv_usage_report_session_modification_response_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_usage_report_session_deletion_response(ogs_pfcp_tlv_usage_report_session_deletion_response_t *ie);
+static uint8_t *tlv_write_usage_report_session_deletion_response(uint8_t *pos, ogs_pfcp_tlv_usage_report_session_deletion_response_t *ie);
+static int tlv_read_usage_report_session_deletion_response(
+        ogs_pfcp_tlv_usage_report_session_deletion_response_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_usage_report_session_report_request(ogs_pfcp_tlv_usage_report_session_report_request_t *ie);
+static uint8_t *tlv_write_usage_report_session_report_request(uint8_t *pos, ogs_pfcp_tlv_usage_report_session_report_request_t *ie);
+static int tlv_read_usage_report_session_report_request(
+        ogs_pfcp_tlv_usage_report_session_report_request_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_downlink_data_report(ogs_pfcp_tlv_downlink_data_report_t *ie);
+static uint8_t *tlv_write_downlink_data_report(uint8_t *pos, ogs_pfcp_tlv_downlink_data_report_t *ie);
+static int tlv_read_downlink_data_report(
+        ogs_pfcp_tlv_downlink_data_report_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_bar(ogs_pfcp_tlv_create_bar_t *ie);
+static uint8_t *tlv_write_create_bar(uint8_t *pos, ogs_pfcp_tlv_create_bar_t *ie);
+static int tlv_read_create_bar(
+        ogs_pfcp_tlv_create_bar_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_bar_session_modification_request(ogs_pfcp_tlv_update_bar_session_modification_request_t *ie);
+static uint8_t *tlv_write_update_bar_session_modification_request(uint8_t *pos, ogs_pfcp_tlv_update_bar_session_modification_request_t *ie);
+static int tlv_read_update_bar_session_modification_request(
+        ogs_pfcp_tlv_update_bar_session_modification_request_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_bar(ogs_pfcp_tlv_remove_bar_t *ie);
+static uint8_t *tlv_write_remove_bar(uint8_t *pos, ogs_pfcp_tlv_remove_bar_t *ie);
+static int tlv_read_remove_bar(
+        ogs_pfcp_tlv_remove_bar_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_error_indication_report(ogs_pfcp_tlv_error_indication_report_t *ie);
+static uint8_t *tlv_write_error_indication_report(uint8_t *pos, ogs_pfcp_tlv_error_indication_report_t *ie);
+static int tlv_read_error_indication_report(
+        ogs_pfcp_tlv_error_indication_report_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_user_plane_path_failure_report(ogs_pfcp_tlv_user_plane_path_failure_report_t *ie);
+static uint8_t *tlv_write_user_plane_path_failure_report(uint8_t *pos, ogs_pfcp_tlv_user_plane_path_failure_report_t *ie);
+static int tlv_read_user_plane_path_failure_report(
+        ogs_pfcp_tlv_user_plane_path_failure_report_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_traffic_endpoint(ogs_pfcp_tlv_create_traffic_endpoint_t *ie);
+static uint8_t *tlv_write_create_traffic_endpoint(uint8_t *pos, ogs_pfcp_tlv_create_traffic_endpoint_t *ie);
+static int tlv_read_create_traffic_endpoint(
+        ogs_pfcp_tlv_create_traffic_endpoint_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_created_traffic_endpoint(ogs_pfcp_tlv_created_traffic_endpoint_t *ie);
+static uint8_t *tlv_write_created_traffic_endpoint(uint8_t *pos, ogs_pfcp_tlv_created_traffic_endpoint_t *ie);
+static int tlv_read_created_traffic_endpoint(
+        ogs_pfcp_tlv_created_traffic_endpoint_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_traffic_endpoint(ogs_pfcp_tlv_remove_traffic_endpoint_t *ie);
+static uint8_t *tlv_write_remove_traffic_endpoint(uint8_t *pos, ogs_pfcp_tlv_remove_traffic_endpoint_t *ie);
+static int tlv_read_remove_traffic_endpoint(
+        ogs_pfcp_tlv_remove_traffic_endpoint_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_create_mar(ogs_pfcp_tlv_create_mar_t *ie);
+static uint8_t *tlv_write_create_mar(uint8_t *pos, ogs_pfcp_tlv_create_mar_t *ie);
+static int tlv_read_create_mar(
+        ogs_pfcp_tlv_create_mar_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_remove_mar(ogs_pfcp_tlv_remove_mar_t *ie);
+static uint8_t *tlv_write_remove_mar(uint8_t *pos, ogs_pfcp_tlv_remove_mar_t *ie);
+static int tlv_read_remove_mar(
+        ogs_pfcp_tlv_remove_mar_t *ie, uint8_t *pos, uint32_t length);
+static uint32_t tlv_length_update_mar(ogs_pfcp_tlv_update_mar_t *ie);
+static uint8_t *tlv_write_update_mar(uint8_t *pos, ogs_pfcp_tlv_update_mar_t *ie);
+static int tlv_read_update_mar(
+        ogs_pfcp_tlv_update_mar_t *ie, uint8_t *pos, uint32_t length);
+
+static uint32_t tlv_length_ethernet_packet_filter(ogs_pfcp_tlv_ethernet_packet_filter_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->ethernet_filter_id.presence)
+        length += TLV_HLEN + ie->ethernet_filter_id.len;
+    if (ie->ethernet_filter_properties.presence)
+        length += TLV_HLEN + ie->ethernet_filter_properties.len;
+    if (ie->mac_address.presence)
+        length += TLV_HLEN + ie->mac_address.len;
+    if (ie->ethertype.presence)
+        length += TLV_HLEN + ie->ethertype.len;
+    if (ie->c_tag.presence)
+        length += TLV_HLEN + ie->c_tag.len;
+    if (ie->s_tag.presence)
+        length += TLV_HLEN + ie->s_tag.len;
+    for (i = 0; i < 8 && ie->sdf_filter[i].presence; i++)
+        length += TLV_HLEN + ie->sdf_filter[i].len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_ethernet_packet_filter(uint8_t *pos, ogs_pfcp_tlv_ethernet_packet_filter_t *ie)
+{
+    int i;
+
+    if (ie->ethernet_filter_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_FILTER_ID_TYPE, 0, &ie->ethernet_filter_id);
+    if (ie->ethernet_filter_properties.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_FILTER_PROPERTIES_TYPE, 0, &ie->ethernet_filter_properties);
+    if (ie->mac_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAC_ADDRESS_TYPE, 0, &ie->mac_address);
+    if (ie->ethertype.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERTYPE_TYPE, 0, &ie->ethertype);
+    if (ie->c_tag.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_C_TAG_TYPE, 0, &ie->c_tag);
+    if (ie->s_tag.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_S_TAG_TYPE, 0, &ie->s_tag);
+    for (i = 0; i < 8 && ie->sdf_filter[i].presence; i++)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SDF_FILTER_TYPE, 0, &ie->sdf_filter[i]);
+
+    return pos;
+}
+
+static int tlv_read_ethernet_packet_filter(ogs_pfcp_tlv_ethernet_packet_filter_t *ie, uint8_t *pos, uint32_t length)
 {
-    int rv = OGS_ERROR;
-    ogs_pfcp_header_t *h = NULL;
-    uint16_t size = 0;
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
 
-    ogs_assert(pfcp_message);
-    ogs_assert(pkbuf);
-    ogs_assert(pkbuf->len);
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
 
-    h = (ogs_pfcp_header_t *)pkbuf->data;
-    ogs_assert(h);
-    
-    memset(pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+        switch (type) {
+        case OGS_PFCP_ETHERNET_FILTER_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethernet_filter_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_FILTER_PROPERTIES_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethernet_filter_properties, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MAC_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->mac_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERTYPE_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethertype, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_C_TAG_TYPE:
+            if (ogs_tlv_read_octet(&ie->c_tag, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_S_TAG_TYPE:
+            if (ogs_tlv_read_octet(&ie->s_tag, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SDF_FILTER_TYPE:
+            for (i = 0; i < 8 && ie->sdf_filter[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (ogs_tlv_read_octet(&ie->sdf_filter[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
 
-    if (h->seid_presence)
-        size = OGS_PFCP_HEADER_LEN;
-    else
-        size = OGS_PFCP_HEADER_LEN-OGS_PFCP_SEID_LEN;
+        pos += len;
+    }
 
-    ogs_assert(ogs_pkbuf_pull(pkbuf, size));
-    memcpy(&pfcp_message->h, pkbuf->data - size, size);
+    return OGS_OK;
+}
 
-    if (h->seid_presence) {
-        pfcp_message->h.seid = be64toh(pfcp_message->h.seid);
-    } else {
-        pfcp_message->h.sqn = pfcp_message->h.sqn_only;
-        pfcp_message->h.sqn_only = pfcp_message->h.sqn_only;
+static uint32_t tlv_length_pdi(ogs_pfcp_tlv_pdi_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->source_interface.presence)
+        length += TLV_HLEN + 1;
+    if (ie->local_f_teid.presence)
+        length += TLV_HLEN + ie->local_f_teid.len;
+    if (ie->network_instance.presence)
+        length += TLV_HLEN + ie->network_instance.len;
+    if (ie->ue_ip_address.presence)
+        length += TLV_HLEN + ie->ue_ip_address.len;
+    if (ie->traffic_endpoint_id.presence)
+        length += TLV_HLEN + ie->traffic_endpoint_id.len;
+    for (i = 0; i < 8 && ie->sdf_filter[i].presence; i++)
+        length += TLV_HLEN + ie->sdf_filter[i].len;
+    if (ie->application_id.presence)
+        length += TLV_HLEN + ie->application_id.len;
+    if (ie->ethernet_pdu_session_information.presence)
+        length += TLV_HLEN + ie->ethernet_pdu_session_information.len;
+    if (ie->ethernet_packet_filter.presence)
+        length += TLV_HLEN + tlv_length_ethernet_packet_filter(&ie->ethernet_packet_filter);
+    if (ie->qfi.presence)
+        length += TLV_HLEN + 1;
+    if (ie->framed_route.presence)
+        length += TLV_HLEN + ie->framed_route.len;
+    if (ie->framed_routing.presence)
+        length += TLV_HLEN + ie->framed_routing.len;
+    if (ie->framed_ipv6_route.presence)
+        length += TLV_HLEN + ie->framed_ipv6_route.len;
+    if (ie->source_interface_type.presence)
+        length += TLV_HLEN + ie->source_interface_type.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_pdi(uint8_t *pos, ogs_pfcp_tlv_pdi_t *ie)
+{
+    int i;
+
+    if (ie->source_interface.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_SOURCE_INTERFACE_TYPE, 0, &ie->source_interface);
+    if (ie->local_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_TEID_TYPE, 0, &ie->local_f_teid);
+    if (ie->network_instance.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NETWORK_INSTANCE_TYPE, 0, &ie->network_instance);
+    if (ie->ue_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UE_IP_ADDRESS_TYPE, 0, &ie->ue_ip_address);
+    if (ie->traffic_endpoint_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE, 0, &ie->traffic_endpoint_id);
+    for (i = 0; i < 8 && ie->sdf_filter[i].presence; i++)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SDF_FILTER_TYPE, 0, &ie->sdf_filter[i]);
+    if (ie->application_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_APPLICATION_ID_TYPE, 0, &ie->application_id);
+    if (ie->ethernet_pdu_session_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_PDU_SESSION_INFORMATION_TYPE, 0, &ie->ethernet_pdu_session_information);
+    if (ie->ethernet_packet_filter.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_PACKET_FILTER_TYPE, 0,
+                tlv_write_ethernet_packet_filter(pos + TLV_HLEN, &ie->ethernet_packet_filter));
+    if (ie->qfi.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_QFI_TYPE, 0, &ie->qfi);
+    if (ie->framed_route.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FRAMED_ROUTE_TYPE, 0, &ie->framed_route);
+    if (ie->framed_routing.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FRAMED_ROUTING_TYPE, 0, &ie->framed_routing);
+    if (ie->framed_ipv6_route.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FRAMED_IPV6_ROUTE_TYPE, 0, &ie->framed_ipv6_route);
+    if (ie->source_interface_type.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP__INTERFACE_TYPE_TYPE, 0, &ie->source_interface_type);
+
+    return pos;
+}
+
+static int tlv_read_pdi(ogs_pfcp_tlv_pdi_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_SOURCE_INTERFACE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->source_interface, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_TEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->local_f_teid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_NETWORK_INSTANCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->network_instance, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UE_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->ue_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->traffic_endpoint_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SDF_FILTER_TYPE:
+            for (i = 0; i < 8 && ie->sdf_filter[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (ogs_tlv_read_octet(&ie->sdf_filter[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_APPLICATION_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->application_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_PDU_SESSION_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethernet_pdu_session_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_PACKET_FILTER_TYPE:
+            if (tlv_read_ethernet_packet_filter(&ie->ethernet_packet_filter, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->ethernet_packet_filter.presence = 1;
+            break;
+        case OGS_PFCP_QFI_TYPE:
+            if (ogs_tlv_read_uint8(&ie->qfi, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FRAMED_ROUTE_TYPE:
+            if (ogs_tlv_read_octet(&ie->framed_route, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FRAMED_ROUTING_TYPE:
+            if (ogs_tlv_read_octet(&ie->framed_routing, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FRAMED_IPV6_ROUTE_TYPE:
+            if (ogs_tlv_read_octet(&ie->framed_ipv6_route, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP__INTERFACE_TYPE_TYPE:
+            if (ogs_tlv_read_octet(&ie->source_interface_type, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
     }
 
-    if (pkbuf->len == 0)
-        return OGS_OK;
+    return OGS_OK;
+}
 
-    switch(pfcp_message->h.type)
-    {
-        case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_heartbeat_request,
-                    &ogs_pfcp_msg_desc_pfcp_heartbeat_request, pkbuf, OGS_TLV_MODE_T2_L2);
+static uint32_t tlv_length_create_pdr(ogs_pfcp_tlv_create_pdr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->pdr_id.presence)
+        length += TLV_HLEN + 2;
+    if (ie->precedence.presence)
+        length += TLV_HLEN + 4;
+    if (ie->pdi.presence)
+        length += TLV_HLEN + tlv_length_pdi(&ie->pdi);
+    if (ie->outer_header_removal.presence)
+        length += TLV_HLEN + ie->outer_header_removal.len;
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->qer_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->activate_predefined_rules.presence)
+        length += TLV_HLEN + ie->activate_predefined_rules.len;
+    if (ie->activation_time.presence)
+        length += TLV_HLEN + ie->activation_time.len;
+    if (ie->deactivation_time.presence)
+        length += TLV_HLEN + ie->deactivation_time.len;
+    if (ie->mar_id.presence)
+        length += TLV_HLEN + ie->mar_id.len;
+    if (ie->packet_replication_and_detection_carry_on_information.presence)
+        length += TLV_HLEN + ie->packet_replication_and_detection_carry_on_information.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_pdr(uint8_t *pos, ogs_pfcp_tlv_create_pdr_t *ie)
+{
+    if (ie->pdr_id.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_PDR_ID_TYPE, 0, &ie->pdr_id);
+    if (ie->precedence.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_PRECEDENCE_TYPE, 0, &ie->precedence);
+    if (ie->pdi.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_PDI_TYPE, 0,
+                tlv_write_pdi(pos + TLV_HLEN, &ie->pdi));
+    if (ie->outer_header_removal.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_OUTER_HEADER_REMOVAL_TYPE, 0, &ie->outer_header_removal);
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->qer_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_ID_TYPE, 0, &ie->qer_id);
+    if (ie->activate_predefined_rules.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ACTIVATE_PREDEFINED_RULES_TYPE, 0, &ie->activate_predefined_rules);
+    if (ie->activation_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ACTIVATION_TIME_TYPE, 0, &ie->activation_time);
+    if (ie->deactivation_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DEACTIVATION_TIME_TYPE, 0, &ie->deactivation_time);
+    if (ie->mar_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAR_ID_TYPE, 0, &ie->mar_id);
+    if (ie->packet_replication_and_detection_carry_on_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PACKET_REPLICATION_AND_DETECTION_CARRY_ON_INFORMATION_TYPE, 0, &ie->packet_replication_and_detection_carry_on_information);
+
+    return pos;
+}
+
+static int tlv_read_create_pdr(ogs_pfcp_tlv_create_pdr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_PDR_ID_TYPE:
+            if (ogs_tlv_read_uint16(&ie->pdr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_HEARTBEAT_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_heartbeat_response,
-                    &ogs_pfcp_msg_desc_pfcp_heartbeat_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_PRECEDENCE_TYPE:
+            if (ogs_tlv_read_uint32(&ie->precedence, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_PFD_MANAGEMENT_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_pfd_management_request,
-                    &ogs_pfcp_msg_desc_pfcp_pfd_management_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_PDI_TYPE:
+            if (tlv_read_pdi(&ie->pdi, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->pdi.presence = 1;
             break;
-        case OGS_PFCP_PFD_MANAGEMENT_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_pfd_management_response,
-                    &ogs_pfcp_msg_desc_pfcp_pfd_management_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_OUTER_HEADER_REMOVAL_TYPE:
+            if (ogs_tlv_read_octet(&ie->outer_header_removal, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_association_setup_request,
-                    &ogs_pfcp_msg_desc_pfcp_association_setup_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_SETUP_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_association_setup_response,
-                    &ogs_pfcp_msg_desc_pfcp_association_setup_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_UPDATE_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_association_update_request,
-                    &ogs_pfcp_msg_desc_pfcp_association_update_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_QER_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_UPDATE_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_association_update_response,
-                    &ogs_pfcp_msg_desc_pfcp_association_update_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_ACTIVATE_PREDEFINED_RULES_TYPE:
+            if (ogs_tlv_read_octet(&ie->activate_predefined_rules, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_association_release_request,
-                    &ogs_pfcp_msg_desc_pfcp_association_release_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_ACTIVATION_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->activation_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_RELEASE_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_association_release_response,
-                    &ogs_pfcp_msg_desc_pfcp_association_release_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_DEACTIVATION_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->deactivation_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_VERSION_NOT_SUPPORTED_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_version_not_supported_response,
-                    &ogs_pfcp_msg_desc_pfcp_version_not_supported_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_MAR_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->mar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_node_report_request,
-                    &ogs_pfcp_msg_desc_pfcp_node_report_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_PACKET_REPLICATION_AND_DETECTION_CARRY_ON_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->packet_replication_and_detection_carry_on_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_node_report_response,
-                    &ogs_pfcp_msg_desc_pfcp_node_report_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
             break;
-        case OGS_PFCP_SESSION_SET_DELETION_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_set_deletion_request,
-                    &ogs_pfcp_msg_desc_pfcp_session_set_deletion_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_forwarding_parameters(ogs_pfcp_tlv_forwarding_parameters_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->destination_interface.presence)
+        length += TLV_HLEN + 1;
+    if (ie->network_instance.presence)
+        length += TLV_HLEN + ie->network_instance.len;
+    if (ie->redirect_information.presence)
+        length += TLV_HLEN + ie->redirect_information.len;
+    if (ie->outer_header_creation.presence)
+        length += TLV_HLEN + ie->outer_header_creation.len;
+    if (ie->transport_level_marking.presence)
+        length += TLV_HLEN + ie->transport_level_marking.len;
+    if (ie->forwarding_policy.presence)
+        length += TLV_HLEN + ie->forwarding_policy.len;
+    if (ie->header_enrichment.presence)
+        length += TLV_HLEN + ie->header_enrichment.len;
+    if (ie->linked_traffic_endpoint_id.presence)
+        length += TLV_HLEN + ie->linked_traffic_endpoint_id.len;
+    if (ie->proxying.presence)
+        length += TLV_HLEN + ie->proxying.len;
+    if (ie->destination_interface_type.presence)
+        length += TLV_HLEN + ie->destination_interface_type.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_forwarding_parameters(uint8_t *pos, ogs_pfcp_tlv_forwarding_parameters_t *ie)
+{
+    if (ie->destination_interface.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_DESTINATION_INTERFACE_TYPE, 0, &ie->destination_interface);
+    if (ie->network_instance.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NETWORK_INSTANCE_TYPE, 0, &ie->network_instance);
+    if (ie->redirect_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_REDIRECT_INFORMATION_TYPE, 0, &ie->redirect_information);
+    if (ie->outer_header_creation.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_OUTER_HEADER_CREATION_TYPE, 0, &ie->outer_header_creation);
+    if (ie->transport_level_marking.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE, 0, &ie->transport_level_marking);
+    if (ie->forwarding_policy.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FORWARDING_POLICY_TYPE, 0, &ie->forwarding_policy);
+    if (ie->header_enrichment.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_HEADER_ENRICHMENT_TYPE, 0, &ie->header_enrichment);
+    if (ie->linked_traffic_endpoint_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE, 0, &ie->linked_traffic_endpoint_id);
+    if (ie->proxying.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PROXYING_TYPE, 0, &ie->proxying);
+    if (ie->destination_interface_type.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP__INTERFACE_TYPE_TYPE, 0, &ie->destination_interface_type);
+
+    return pos;
+}
+
+static int tlv_read_forwarding_parameters(ogs_pfcp_tlv_forwarding_parameters_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_DESTINATION_INTERFACE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->destination_interface, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_SET_DELETION_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_set_deletion_response,
-                    &ogs_pfcp_msg_desc_pfcp_session_set_deletion_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_NETWORK_INSTANCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->network_instance, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_establishment_request,
-                    &ogs_pfcp_msg_desc_pfcp_session_establishment_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_REDIRECT_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->redirect_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_establishment_response,
-                    &ogs_pfcp_msg_desc_pfcp_session_establishment_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_OUTER_HEADER_CREATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->outer_header_creation, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_MODIFICATION_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_modification_request,
-                    &ogs_pfcp_msg_desc_pfcp_session_modification_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE:
+            if (ogs_tlv_read_octet(&ie->transport_level_marking, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_modification_response,
-                    &ogs_pfcp_msg_desc_pfcp_session_modification_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_FORWARDING_POLICY_TYPE:
+            if (ogs_tlv_read_octet(&ie->forwarding_policy, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_DELETION_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_deletion_request,
-                    &ogs_pfcp_msg_desc_pfcp_session_deletion_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_HEADER_ENRICHMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->header_enrichment, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_deletion_response,
-                    &ogs_pfcp_msg_desc_pfcp_session_deletion_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->linked_traffic_endpoint_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_report_request,
-                    &ogs_pfcp_msg_desc_pfcp_session_report_request, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_PROXYING_TYPE:
+            if (ogs_tlv_read_octet(&ie->proxying, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE:
-            rv = ogs_tlv_parse_msg(&pfcp_message->pfcp_session_report_response,
-                    &ogs_pfcp_msg_desc_pfcp_session_report_response, pkbuf, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP__INTERFACE_TYPE_TYPE:
+            if (ogs_tlv_read_octet(&ie->destination_interface_type, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
         default:
-            ogs_warn("Not implmeneted(type:%d)", pfcp_message->h.type);
+            ogs_warn("Unknown TLV type [%d]", type);
             break;
+        }
+
+        pos += len;
     }
 
-    return rv;
+    return OGS_OK;
 }
 
-ogs_pkbuf_t *ogs_pfcp_build_msg(ogs_pfcp_message_t *pfcp_message)
+static uint32_t tlv_length_duplicating_parameters(ogs_pfcp_tlv_duplicating_parameters_t *ie)
 {
-    ogs_pkbuf_t *pkbuf = NULL;
+    uint32_t length = 0;
 
-    ogs_assert(pfcp_message);
-    switch(pfcp_message->h.type)
-    {
-        case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_heartbeat_request,
-                    &pfcp_message->pfcp_heartbeat_request, OGS_TLV_MODE_T2_L2);
+    if (ie->destination_interface.presence)
+        length += TLV_HLEN + 1;
+    if (ie->outer_header_creation.presence)
+        length += TLV_HLEN + ie->outer_header_creation.len;
+    if (ie->transport_level_marking.presence)
+        length += TLV_HLEN + ie->transport_level_marking.len;
+    if (ie->forwarding_policy.presence)
+        length += TLV_HLEN + ie->forwarding_policy.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_duplicating_parameters(uint8_t *pos, ogs_pfcp_tlv_duplicating_parameters_t *ie)
+{
+    if (ie->destination_interface.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_DESTINATION_INTERFACE_TYPE, 0, &ie->destination_interface);
+    if (ie->outer_header_creation.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_OUTER_HEADER_CREATION_TYPE, 0, &ie->outer_header_creation);
+    if (ie->transport_level_marking.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE, 0, &ie->transport_level_marking);
+    if (ie->forwarding_policy.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FORWARDING_POLICY_TYPE, 0, &ie->forwarding_policy);
+
+    return pos;
+}
+
+static int tlv_read_duplicating_parameters(ogs_pfcp_tlv_duplicating_parameters_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_DESTINATION_INTERFACE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->destination_interface, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_HEARTBEAT_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_heartbeat_response,
-                    &pfcp_message->pfcp_heartbeat_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_OUTER_HEADER_CREATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->outer_header_creation, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_PFD_MANAGEMENT_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_pfd_management_request,
-                    &pfcp_message->pfcp_pfd_management_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE:
+            if (ogs_tlv_read_octet(&ie->transport_level_marking, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_PFD_MANAGEMENT_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_pfd_management_response,
-                    &pfcp_message->pfcp_pfd_management_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_FORWARDING_POLICY_TYPE:
+            if (ogs_tlv_read_octet(&ie->forwarding_policy, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_association_setup_request,
-                    &pfcp_message->pfcp_association_setup_request, OGS_TLV_MODE_T2_L2);
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
             break;
-        case OGS_PFCP_ASSOCIATION_SETUP_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_association_setup_response,
-                    &pfcp_message->pfcp_association_setup_response, OGS_TLV_MODE_T2_L2);
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_create_far(ogs_pfcp_tlv_create_far_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->apply_action.presence)
+        length += TLV_HLEN + 1;
+    if (ie->forwarding_parameters.presence)
+        length += TLV_HLEN + tlv_length_forwarding_parameters(&ie->forwarding_parameters);
+    if (ie->duplicating_parameters.presence)
+        length += TLV_HLEN + tlv_length_duplicating_parameters(&ie->duplicating_parameters);
+    if (ie->bar_id.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_far(uint8_t *pos, ogs_pfcp_tlv_create_far_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->apply_action.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_APPLY_ACTION_TYPE, 0, &ie->apply_action);
+    if (ie->forwarding_parameters.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_FORWARDING_PARAMETERS_TYPE, 0,
+                tlv_write_forwarding_parameters(pos + TLV_HLEN, &ie->forwarding_parameters));
+    if (ie->duplicating_parameters.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_DUPLICATING_PARAMETERS_TYPE, 0,
+                tlv_write_duplicating_parameters(pos + TLV_HLEN, &ie->duplicating_parameters));
+    if (ie->bar_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_BAR_ID_TYPE, 0, &ie->bar_id);
+
+    return pos;
+}
+
+static int tlv_read_create_far(ogs_pfcp_tlv_create_far_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_UPDATE_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_association_update_request,
-                    &pfcp_message->pfcp_association_update_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_APPLY_ACTION_TYPE:
+            if (ogs_tlv_read_uint8(&ie->apply_action, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_ASSOCIATION_UPDATE_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_association_update_response,
-                    &pfcp_message->pfcp_association_update_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_FORWARDING_PARAMETERS_TYPE:
+            if (tlv_read_forwarding_parameters(&ie->forwarding_parameters, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->forwarding_parameters.presence = 1;
             break;
-        case OGS_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_association_release_request,
-                    &pfcp_message->pfcp_association_release_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_DUPLICATING_PARAMETERS_TYPE:
+            if (tlv_read_duplicating_parameters(&ie->duplicating_parameters, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->duplicating_parameters.presence = 1;
             break;
-        case OGS_PFCP_ASSOCIATION_RELEASE_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_association_release_response,
-                    &pfcp_message->pfcp_association_release_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_BAR_ID_TYPE:
+            if (ogs_tlv_read_uint8(&ie->bar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_VERSION_NOT_SUPPORTED_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_version_not_supported_response,
-                    &pfcp_message->pfcp_version_not_supported_response, OGS_TLV_MODE_T2_L2);
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
             break;
-        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_node_report_request,
-                    &pfcp_message->pfcp_node_report_request, OGS_TLV_MODE_T2_L2);
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_forwarding_parameters(ogs_pfcp_tlv_update_forwarding_parameters_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->destination_interface.presence)
+        length += TLV_HLEN + 1;
+    if (ie->network_instance.presence)
+        length += TLV_HLEN + ie->network_instance.len;
+    if (ie->redirect_information.presence)
+        length += TLV_HLEN + ie->redirect_information.len;
+    if (ie->outer_header_creation.presence)
+        length += TLV_HLEN + ie->outer_header_creation.len;
+    if (ie->transport_level_marking.presence)
+        length += TLV_HLEN + ie->transport_level_marking.len;
+    if (ie->forwarding_policy.presence)
+        length += TLV_HLEN + ie->forwarding_policy.len;
+    if (ie->header_enrichment.presence)
+        length += TLV_HLEN + ie->header_enrichment.len;
+    if (ie->pfcpsmreq_flags.presence)
+        length += TLV_HLEN + 1;
+    if (ie->linked_traffic_endpoint_id.presence)
+        length += TLV_HLEN + ie->linked_traffic_endpoint_id.len;
+    if (ie->destination_interface_type.presence)
+        length += TLV_HLEN + ie->destination_interface_type.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_forwarding_parameters(uint8_t *pos, ogs_pfcp_tlv_update_forwarding_parameters_t *ie)
+{
+    if (ie->destination_interface.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_DESTINATION_INTERFACE_TYPE, 0, &ie->destination_interface);
+    if (ie->network_instance.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NETWORK_INSTANCE_TYPE, 0, &ie->network_instance);
+    if (ie->redirect_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_REDIRECT_INFORMATION_TYPE, 0, &ie->redirect_information);
+    if (ie->outer_header_creation.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_OUTER_HEADER_CREATION_TYPE, 0, &ie->outer_header_creation);
+    if (ie->transport_level_marking.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE, 0, &ie->transport_level_marking);
+    if (ie->forwarding_policy.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FORWARDING_POLICY_TYPE, 0, &ie->forwarding_policy);
+    if (ie->header_enrichment.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_HEADER_ENRICHMENT_TYPE, 0, &ie->header_enrichment);
+    if (ie->pfcpsmreq_flags.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PFCPSMREQ_FLAGS_TYPE, 0, &ie->pfcpsmreq_flags);
+    if (ie->linked_traffic_endpoint_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE, 0, &ie->linked_traffic_endpoint_id);
+    if (ie->destination_interface_type.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP__INTERFACE_TYPE_TYPE, 0, &ie->destination_interface_type);
+
+    return pos;
+}
+
+static int tlv_read_update_forwarding_parameters(ogs_pfcp_tlv_update_forwarding_parameters_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_DESTINATION_INTERFACE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->destination_interface, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_node_report_response,
-                    &pfcp_message->pfcp_node_report_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_NETWORK_INSTANCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->network_instance, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_SET_DELETION_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_set_deletion_request,
-                    &pfcp_message->pfcp_session_set_deletion_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_REDIRECT_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->redirect_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_SET_DELETION_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_set_deletion_response,
-                    &pfcp_message->pfcp_session_set_deletion_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_OUTER_HEADER_CREATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->outer_header_creation, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_establishment_request,
-                    &pfcp_message->pfcp_session_establishment_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE:
+            if (ogs_tlv_read_octet(&ie->transport_level_marking, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_establishment_response,
-                    &pfcp_message->pfcp_session_establishment_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_FORWARDING_POLICY_TYPE:
+            if (ogs_tlv_read_octet(&ie->forwarding_policy, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_MODIFICATION_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_modification_request,
-                    &pfcp_message->pfcp_session_modification_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_HEADER_ENRICHMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->header_enrichment, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_modification_response,
-                    &pfcp_message->pfcp_session_modification_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_PFCPSMREQ_FLAGS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->pfcpsmreq_flags, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_DELETION_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_deletion_request,
-                    &pfcp_message->pfcp_session_deletion_request, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->linked_traffic_endpoint_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_deletion_response,
-                    &pfcp_message->pfcp_session_deletion_response, OGS_TLV_MODE_T2_L2);
+        case OGS_PFCP__INTERFACE_TYPE_TYPE:
+            if (ogs_tlv_read_octet(&ie->destination_interface_type, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
-        case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_report_request,
-                    &pfcp_message->pfcp_session_report_request, OGS_TLV_MODE_T2_L2);
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
             break;
-        case OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE:
-            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_pfcp_session_report_response,
-                    &pfcp_message->pfcp_session_report_response, OGS_TLV_MODE_T2_L2);
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_duplicating_parameters(ogs_pfcp_tlv_update_duplicating_parameters_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->destination_interface.presence)
+        length += TLV_HLEN + 1;
+    if (ie->outer_header_creation.presence)
+        length += TLV_HLEN + ie->outer_header_creation.len;
+    if (ie->transport_level_marking.presence)
+        length += TLV_HLEN + ie->transport_level_marking.len;
+    if (ie->forwarding_policy.presence)
+        length += TLV_HLEN + ie->forwarding_policy.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_duplicating_parameters(uint8_t *pos, ogs_pfcp_tlv_update_duplicating_parameters_t *ie)
+{
+    if (ie->destination_interface.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_DESTINATION_INTERFACE_TYPE, 0, &ie->destination_interface);
+    if (ie->outer_header_creation.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_OUTER_HEADER_CREATION_TYPE, 0, &ie->outer_header_creation);
+    if (ie->transport_level_marking.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE, 0, &ie->transport_level_marking);
+    if (ie->forwarding_policy.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FORWARDING_POLICY_TYPE, 0, &ie->forwarding_policy);
+
+    return pos;
+}
+
+static int tlv_read_update_duplicating_parameters(ogs_pfcp_tlv_update_duplicating_parameters_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_DESTINATION_INTERFACE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->destination_interface, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OUTER_HEADER_CREATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->outer_header_creation, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TRANSPORT_LEVEL_MARKING_TYPE:
+            if (ogs_tlv_read_octet(&ie->transport_level_marking, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FORWARDING_POLICY_TYPE:
+            if (ogs_tlv_read_octet(&ie->forwarding_policy, pos, len) != OGS_OK)
+                return OGS_ERROR;
             break;
         default:
-            ogs_warn("Not implmeneted(type:%d)", pfcp_message->h.type);
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_far(ogs_pfcp_tlv_update_far_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->apply_action.presence)
+        length += TLV_HLEN + 1;
+    if (ie->update_forwarding_parameters.presence)
+        length += TLV_HLEN + tlv_length_update_forwarding_parameters(&ie->update_forwarding_parameters);
+    if (ie->update_duplicating_parameters.presence)
+        length += TLV_HLEN + tlv_length_update_duplicating_parameters(&ie->update_duplicating_parameters);
+    if (ie->bar_id.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_far(uint8_t *pos, ogs_pfcp_tlv_update_far_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->apply_action.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_APPLY_ACTION_TYPE, 0, &ie->apply_action);
+    if (ie->update_forwarding_parameters.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_FORWARDING_PARAMETERS_TYPE, 0,
+                tlv_write_update_forwarding_parameters(pos + TLV_HLEN, &ie->update_forwarding_parameters));
+    if (ie->update_duplicating_parameters.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_DUPLICATING_PARAMETERS_TYPE, 0,
+                tlv_write_update_duplicating_parameters(pos + TLV_HLEN, &ie->update_duplicating_parameters));
+    if (ie->bar_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_BAR_ID_TYPE, 0, &ie->bar_id);
+
+    return pos;
+}
+
+static int tlv_read_update_far(ogs_pfcp_tlv_update_far_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_APPLY_ACTION_TYPE:
+            if (ogs_tlv_read_uint8(&ie->apply_action, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UPDATE_FORWARDING_PARAMETERS_TYPE:
+            if (tlv_read_update_forwarding_parameters(&ie->update_forwarding_parameters, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_forwarding_parameters.presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_DUPLICATING_PARAMETERS_TYPE:
+            if (tlv_read_update_duplicating_parameters(&ie->update_duplicating_parameters, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_duplicating_parameters.presence = 1;
+            break;
+        case OGS_PFCP_BAR_ID_TYPE:
+            if (ogs_tlv_read_uint8(&ie->bar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_pfd_context(ogs_pfcp_tlv_pfd_context_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->pfd_contents.presence)
+        length += TLV_HLEN + ie->pfd_contents.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_pfd_context(uint8_t *pos, ogs_pfcp_tlv_pfd_context_t *ie)
+{
+    if (ie->pfd_contents.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PFD_CONTENTS_TYPE, 0, &ie->pfd_contents);
+
+    return pos;
+}
+
+static int tlv_read_pfd_context(ogs_pfcp_tlv_pfd_context_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_PFD_CONTENTS_TYPE:
+            if (ogs_tlv_read_octet(&ie->pfd_contents, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_application_id_s_pfds(ogs_pfcp_tlv_application_id_s_pfds_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->application_id.presence)
+        length += TLV_HLEN + ie->application_id.len;
+    if (ie->pfd_context.presence)
+        length += TLV_HLEN + tlv_length_pfd_context(&ie->pfd_context);
+
+    return length;
+}
+
+static uint8_t *tlv_write_application_id_s_pfds(uint8_t *pos, ogs_pfcp_tlv_application_id_s_pfds_t *ie)
+{
+    if (ie->application_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_APPLICATION_ID_TYPE, 0, &ie->application_id);
+    if (ie->pfd_context.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_PFD_CONTEXT_TYPE, 0,
+                tlv_write_pfd_context(pos + TLV_HLEN, &ie->pfd_context));
+
+    return pos;
+}
+
+static int tlv_read_application_id_s_pfds(ogs_pfcp_tlv_application_id_s_pfds_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_APPLICATION_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->application_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PFD_CONTEXT_TYPE:
+            if (tlv_read_pfd_context(&ie->pfd_context, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->pfd_context.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_ethernet_traffic_information(ogs_pfcp_tlv_ethernet_traffic_information_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->mac_addresses_detected.presence)
+        length += TLV_HLEN + ie->mac_addresses_detected.len;
+    if (ie->mac_addresses_removed.presence)
+        length += TLV_HLEN + ie->mac_addresses_removed.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_ethernet_traffic_information(uint8_t *pos, ogs_pfcp_tlv_ethernet_traffic_information_t *ie)
+{
+    if (ie->mac_addresses_detected.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAC_ADDRESSES_DETECTED_TYPE, 0, &ie->mac_addresses_detected);
+    if (ie->mac_addresses_removed.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAC_ADDRESSES_REMOVED_TYPE, 0, &ie->mac_addresses_removed);
+
+    return pos;
+}
+
+static int tlv_read_ethernet_traffic_information(ogs_pfcp_tlv_ethernet_traffic_information_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_MAC_ADDRESSES_DETECTED_TYPE:
+            if (ogs_tlv_read_octet(&ie->mac_addresses_detected, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MAC_ADDRESSES_REMOVED_TYPE:
+            if (ogs_tlv_read_octet(&ie->mac_addresses_removed, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_access_forwarding_action_information_1(ogs_pfcp_tlv_access_forwarding_action_information_1_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->weight.presence)
+        length += TLV_HLEN + ie->weight.len;
+    if (ie->priority.presence)
+        length += TLV_HLEN + ie->priority.len;
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_access_forwarding_action_information_1(uint8_t *pos, ogs_pfcp_tlv_access_forwarding_action_information_1_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->weight.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_WEIGHT_TYPE, 0, &ie->weight);
+    if (ie->priority.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PRIORITY_TYPE, 0, &ie->priority);
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+
+    return pos;
+}
+
+static int tlv_read_access_forwarding_action_information_1(ogs_pfcp_tlv_access_forwarding_action_information_1_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_WEIGHT_TYPE:
+            if (ogs_tlv_read_octet(&ie->weight, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PRIORITY_TYPE:
+            if (ogs_tlv_read_octet(&ie->priority, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_access_forwarding_action_information_2(ogs_pfcp_tlv_access_forwarding_action_information_2_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->weight.presence)
+        length += TLV_HLEN + ie->weight.len;
+    if (ie->priority.presence)
+        length += TLV_HLEN + ie->priority.len;
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_access_forwarding_action_information_2(uint8_t *pos, ogs_pfcp_tlv_access_forwarding_action_information_2_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->weight.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_WEIGHT_TYPE, 0, &ie->weight);
+    if (ie->priority.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PRIORITY_TYPE, 0, &ie->priority);
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+
+    return pos;
+}
+
+static int tlv_read_access_forwarding_action_information_2(ogs_pfcp_tlv_access_forwarding_action_information_2_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_WEIGHT_TYPE:
+            if (ogs_tlv_read_octet(&ie->weight, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PRIORITY_TYPE:
+            if (ogs_tlv_read_octet(&ie->priority, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_access_forwarding_action_information_1(ogs_pfcp_tlv_update_access_forwarding_action_information_1_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->weight.presence)
+        length += TLV_HLEN + ie->weight.len;
+    if (ie->priority.presence)
+        length += TLV_HLEN + ie->priority.len;
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_access_forwarding_action_information_1(uint8_t *pos, ogs_pfcp_tlv_update_access_forwarding_action_information_1_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->weight.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_WEIGHT_TYPE, 0, &ie->weight);
+    if (ie->priority.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PRIORITY_TYPE, 0, &ie->priority);
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+
+    return pos;
+}
+
+static int tlv_read_update_access_forwarding_action_information_1(ogs_pfcp_tlv_update_access_forwarding_action_information_1_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_WEIGHT_TYPE:
+            if (ogs_tlv_read_octet(&ie->weight, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PRIORITY_TYPE:
+            if (ogs_tlv_read_octet(&ie->priority, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_access_forwarding_action_information_2(ogs_pfcp_tlv_update_access_forwarding_action_information_2_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->weight.presence)
+        length += TLV_HLEN + ie->weight.len;
+    if (ie->priority.presence)
+        length += TLV_HLEN + ie->priority.len;
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_access_forwarding_action_information_2(uint8_t *pos, ogs_pfcp_tlv_update_access_forwarding_action_information_2_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->weight.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_WEIGHT_TYPE, 0, &ie->weight);
+    if (ie->priority.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PRIORITY_TYPE, 0, &ie->priority);
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+
+    return pos;
+}
+
+static int tlv_read_update_access_forwarding_action_information_2(ogs_pfcp_tlv_update_access_forwarding_action_information_2_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_WEIGHT_TYPE:
+            if (ogs_tlv_read_octet(&ie->weight, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PRIORITY_TYPE:
+            if (ogs_tlv_read_octet(&ie->priority, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_create_urr(ogs_pfcp_tlv_create_urr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->measurement_method.presence)
+        length += TLV_HLEN + 1;
+    if (ie->reporting_triggers.presence)
+        length += TLV_HLEN + 1;
+    if (ie->measurement_period.presence)
+        length += TLV_HLEN + ie->measurement_period.len;
+    if (ie->volume_threshold.presence)
+        length += TLV_HLEN + ie->volume_threshold.len;
+    if (ie->volume_quota.presence)
+        length += TLV_HLEN + ie->volume_quota.len;
+    if (ie->event_threshold.presence)
+        length += TLV_HLEN + ie->event_threshold.len;
+    if (ie->event_quota.presence)
+        length += TLV_HLEN + ie->event_quota.len;
+    if (ie->time_threshold.presence)
+        length += TLV_HLEN + ie->time_threshold.len;
+    if (ie->time_quota.presence)
+        length += TLV_HLEN + ie->time_quota.len;
+    if (ie->quota_holding_time.presence)
+        length += TLV_HLEN + ie->quota_holding_time.len;
+    if (ie->dropped_dl_traffic_threshold.presence)
+        length += TLV_HLEN + ie->dropped_dl_traffic_threshold.len;
+    if (ie->quota_validity_time.presence)
+        length += TLV_HLEN + ie->quota_validity_time.len;
+    if (ie->monitoring_time.presence)
+        length += TLV_HLEN + ie->monitoring_time.len;
+    if (ie->subsequent_volume_threshold.presence)
+        length += TLV_HLEN + ie->subsequent_volume_threshold.len;
+    if (ie->subsequent_time_threshold.presence)
+        length += TLV_HLEN + ie->subsequent_time_threshold.len;
+    if (ie->subsequent_volume_quota.presence)
+        length += TLV_HLEN + ie->subsequent_volume_quota.len;
+    if (ie->subsequent_time_quota.presence)
+        length += TLV_HLEN + ie->subsequent_time_quota.len;
+    if (ie->subsequent_event_threshold.presence)
+        length += TLV_HLEN + ie->subsequent_event_threshold.len;
+    if (ie->subsequent_event_quota.presence)
+        length += TLV_HLEN + ie->subsequent_event_quota.len;
+    if (ie->inactivity_detection_time.presence)
+        length += TLV_HLEN + ie->inactivity_detection_time.len;
+    if (ie->linked_urr_id.presence)
+        length += TLV_HLEN + ie->linked_urr_id.len;
+    if (ie->measurement_information.presence)
+        length += TLV_HLEN + ie->measurement_information.len;
+    if (ie->time_quota_mechanism.presence)
+        length += TLV_HLEN + ie->time_quota_mechanism.len;
+    if (ie->aggregated_urrs.presence)
+        length += TLV_HLEN + ie->aggregated_urrs.len;
+    if (ie->far_id_for_quota_action.presence)
+        length += TLV_HLEN + 4;
+    if (ie->ethernet_inactivity_timer.presence)
+        length += TLV_HLEN + ie->ethernet_inactivity_timer.len;
+    if (ie->additional_monitoring_time.presence)
+        length += TLV_HLEN + ie->additional_monitoring_time.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_urr(uint8_t *pos, ogs_pfcp_tlv_create_urr_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->measurement_method.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_MEASUREMENT_METHOD_TYPE, 0, &ie->measurement_method);
+    if (ie->reporting_triggers.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_REPORTING_TRIGGERS_TYPE, 0, &ie->reporting_triggers);
+    if (ie->measurement_period.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MEASUREMENT_PERIOD_TYPE, 0, &ie->measurement_period);
+    if (ie->volume_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_THRESHOLD_TYPE, 0, &ie->volume_threshold);
+    if (ie->volume_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_QUOTA_TYPE, 0, &ie->volume_quota);
+    if (ie->event_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_EVENT_THRESHOLD_TYPE, 0, &ie->event_threshold);
+    if (ie->event_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_EVENT_QUOTA_TYPE, 0, &ie->event_quota);
+    if (ie->time_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_THRESHOLD_TYPE, 0, &ie->time_threshold);
+    if (ie->time_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_QUOTA_TYPE, 0, &ie->time_quota);
+    if (ie->quota_holding_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUOTA_HOLDING_TIME_TYPE, 0, &ie->quota_holding_time);
+    if (ie->dropped_dl_traffic_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DROPPED_DL_TRAFFIC_THRESHOLD_TYPE, 0, &ie->dropped_dl_traffic_threshold);
+    if (ie->quota_validity_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUOTA_VALIDITY_TIME_TYPE, 0, &ie->quota_validity_time);
+    if (ie->monitoring_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MONITORING_TIME_TYPE, 0, &ie->monitoring_time);
+    if (ie->subsequent_volume_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_VOLUME_THRESHOLD_TYPE, 0, &ie->subsequent_volume_threshold);
+    if (ie->subsequent_time_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_TIME_THRESHOLD_TYPE, 0, &ie->subsequent_time_threshold);
+    if (ie->subsequent_volume_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_VOLUME_QUOTA_TYPE, 0, &ie->subsequent_volume_quota);
+    if (ie->subsequent_time_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_TIME_QUOTA_TYPE, 0, &ie->subsequent_time_quota);
+    if (ie->subsequent_event_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_EVENT_THRESHOLD_TYPE, 0, &ie->subsequent_event_threshold);
+    if (ie->subsequent_event_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_EVENT_QUOTA_TYPE, 0, &ie->subsequent_event_quota);
+    if (ie->inactivity_detection_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_INACTIVITY_DETECTION_TIME_TYPE, 0, &ie->inactivity_detection_time);
+    if (ie->linked_urr_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_LINKED_URR_ID_TYPE, 0, &ie->linked_urr_id);
+    if (ie->measurement_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MEASUREMENT_INFORMATION_TYPE, 0, &ie->measurement_information);
+    if (ie->time_quota_mechanism.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_QUOTA_MECHANISM_TYPE, 0, &ie->time_quota_mechanism);
+    if (ie->aggregated_urrs.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_AGGREGATED_URRS_TYPE, 0, &ie->aggregated_urrs);
+    if (ie->far_id_for_quota_action.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id_for_quota_action);
+    if (ie->ethernet_inactivity_timer.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_INACTIVITY_TIMER_TYPE, 0, &ie->ethernet_inactivity_timer);
+    if (ie->additional_monitoring_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ADDITIONAL_MONITORING_TIME_TYPE, 0, &ie->additional_monitoring_time);
+
+    return pos;
+}
+
+static int tlv_read_create_urr(ogs_pfcp_tlv_create_urr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MEASUREMENT_METHOD_TYPE:
+            if (ogs_tlv_read_uint8(&ie->measurement_method, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_REPORTING_TRIGGERS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->reporting_triggers, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MEASUREMENT_PERIOD_TYPE:
+            if (ogs_tlv_read_octet(&ie->measurement_period, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_EVENT_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->event_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_EVENT_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->event_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUOTA_HOLDING_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->quota_holding_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DROPPED_DL_TRAFFIC_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->dropped_dl_traffic_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUOTA_VALIDITY_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->quota_validity_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MONITORING_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->monitoring_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_VOLUME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_volume_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_TIME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_time_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_VOLUME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_volume_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_TIME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_time_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_EVENT_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_event_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_EVENT_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_event_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_INACTIVITY_DETECTION_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->inactivity_detection_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_LINKED_URR_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->linked_urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MEASUREMENT_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->measurement_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_QUOTA_MECHANISM_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_quota_mechanism, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_AGGREGATED_URRS_TYPE:
+            if (ogs_tlv_read_octet(&ie->aggregated_urrs, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id_for_quota_action, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_INACTIVITY_TIMER_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethernet_inactivity_timer, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ADDITIONAL_MONITORING_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->additional_monitoring_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_create_qer(ogs_pfcp_tlv_create_qer_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->qer_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->qer_correlation_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->gate_status.presence)
+        length += TLV_HLEN + 1;
+    if (ie->maximum_bitrate.presence)
+        length += TLV_HLEN + ie->maximum_bitrate.len;
+    if (ie->guaranteed_bitrate.presence)
+        length += TLV_HLEN + ie->guaranteed_bitrate.len;
+    if (ie->packet_rate.presence)
+        length += TLV_HLEN + ie->packet_rate.len;
+    if (ie->dl_flow_level_marking.presence)
+        length += TLV_HLEN + ie->dl_flow_level_marking.len;
+    if (ie->qos_flow_identifier.presence)
+        length += TLV_HLEN + 1;
+    if (ie->reflective_qos.presence)
+        length += TLV_HLEN + 1;
+    if (ie->paging_policy_indicator.presence)
+        length += TLV_HLEN + 1;
+    if (ie->averaging_window.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_qer(uint8_t *pos, ogs_pfcp_tlv_create_qer_t *ie)
+{
+    if (ie->qer_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_ID_TYPE, 0, &ie->qer_id);
+    if (ie->qer_correlation_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_CORRELATION_ID_TYPE, 0, &ie->qer_correlation_id);
+    if (ie->gate_status.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_GATE_STATUS_TYPE, 0, &ie->gate_status);
+    if (ie->maximum_bitrate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MBR_TYPE, 0, &ie->maximum_bitrate);
+    if (ie->guaranteed_bitrate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_GBR_TYPE, 0, &ie->guaranteed_bitrate);
+    if (ie->packet_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PACKET_RATE_TYPE, 0, &ie->packet_rate);
+    if (ie->dl_flow_level_marking.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DL_FLOW_LEVEL_MARKING_TYPE, 0, &ie->dl_flow_level_marking);
+    if (ie->qos_flow_identifier.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_QFI_TYPE, 0, &ie->qos_flow_identifier);
+    if (ie->reflective_qos.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_RQI_TYPE, 0, &ie->reflective_qos);
+    if (ie->paging_policy_indicator.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PAGING_POLICY_INDICATOR_TYPE, 0, &ie->paging_policy_indicator);
+    if (ie->averaging_window.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_AVERAGING_WINDOW_TYPE, 0, &ie->averaging_window);
+
+    return pos;
+}
+
+static int tlv_read_create_qer(ogs_pfcp_tlv_create_qer_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_QER_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QER_CORRELATION_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_correlation_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_GATE_STATUS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->gate_status, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MBR_TYPE:
+            if (ogs_tlv_read_octet(&ie->maximum_bitrate, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_GBR_TYPE:
+            if (ogs_tlv_read_octet(&ie->guaranteed_bitrate, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PACKET_RATE_TYPE:
+            if (ogs_tlv_read_octet(&ie->packet_rate, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DL_FLOW_LEVEL_MARKING_TYPE:
+            if (ogs_tlv_read_octet(&ie->dl_flow_level_marking, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QFI_TYPE:
+            if (ogs_tlv_read_uint8(&ie->qos_flow_identifier, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_RQI_TYPE:
+            if (ogs_tlv_read_uint8(&ie->reflective_qos, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PAGING_POLICY_INDICATOR_TYPE:
+            if (ogs_tlv_read_uint8(&ie->paging_policy_indicator, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_AVERAGING_WINDOW_TYPE:
+            if (ogs_tlv_read_uint32(&ie->averaging_window, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_created_pdr(ogs_pfcp_tlv_created_pdr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->pdr_id.presence)
+        length += TLV_HLEN + 2;
+    if (ie->local_f_teid.presence)
+        length += TLV_HLEN + ie->local_f_teid.len;
+    if (ie->ue_ip_address.presence)
+        length += TLV_HLEN + ie->ue_ip_address.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_created_pdr(uint8_t *pos, ogs_pfcp_tlv_created_pdr_t *ie)
+{
+    if (ie->pdr_id.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_PDR_ID_TYPE, 0, &ie->pdr_id);
+    if (ie->local_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_TEID_TYPE, 0, &ie->local_f_teid);
+    if (ie->ue_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UE_IP_ADDRESS_TYPE, 0, &ie->ue_ip_address);
+
+    return pos;
+}
+
+static int tlv_read_created_pdr(ogs_pfcp_tlv_created_pdr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_PDR_ID_TYPE:
+            if (ogs_tlv_read_uint16(&ie->pdr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_TEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->local_f_teid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UE_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->ue_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_pdr(ogs_pfcp_tlv_update_pdr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->pdr_id.presence)
+        length += TLV_HLEN + 2;
+    if (ie->outer_header_removal.presence)
+        length += TLV_HLEN + ie->outer_header_removal.len;
+    if (ie->precedence.presence)
+        length += TLV_HLEN + 4;
+    if (ie->pdi.presence)
+        length += TLV_HLEN + tlv_length_pdi(&ie->pdi);
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->qer_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->activate_predefined_rules.presence)
+        length += TLV_HLEN + ie->activate_predefined_rules.len;
+    if (ie->deactivate_predefined_rules.presence)
+        length += TLV_HLEN + ie->deactivate_predefined_rules.len;
+    if (ie->activation_time.presence)
+        length += TLV_HLEN + ie->activation_time.len;
+    if (ie->deactivation_time.presence)
+        length += TLV_HLEN + ie->deactivation_time.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_pdr(uint8_t *pos, ogs_pfcp_tlv_update_pdr_t *ie)
+{
+    if (ie->pdr_id.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_PDR_ID_TYPE, 0, &ie->pdr_id);
+    if (ie->outer_header_removal.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_OUTER_HEADER_REMOVAL_TYPE, 0, &ie->outer_header_removal);
+    if (ie->precedence.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_PRECEDENCE_TYPE, 0, &ie->precedence);
+    if (ie->pdi.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_PDI_TYPE, 0,
+                tlv_write_pdi(pos + TLV_HLEN, &ie->pdi));
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->qer_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_ID_TYPE, 0, &ie->qer_id);
+    if (ie->activate_predefined_rules.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ACTIVATE_PREDEFINED_RULES_TYPE, 0, &ie->activate_predefined_rules);
+    if (ie->deactivate_predefined_rules.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DEACTIVATE_PREDEFINED_RULES_TYPE, 0, &ie->deactivate_predefined_rules);
+    if (ie->activation_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ACTIVATION_TIME_TYPE, 0, &ie->activation_time);
+    if (ie->deactivation_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DEACTIVATION_TIME_TYPE, 0, &ie->deactivation_time);
+
+    return pos;
+}
+
+static int tlv_read_update_pdr(ogs_pfcp_tlv_update_pdr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_PDR_ID_TYPE:
+            if (ogs_tlv_read_uint16(&ie->pdr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OUTER_HEADER_REMOVAL_TYPE:
+            if (ogs_tlv_read_octet(&ie->outer_header_removal, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PRECEDENCE_TYPE:
+            if (ogs_tlv_read_uint32(&ie->precedence, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PDI_TYPE:
+            if (tlv_read_pdi(&ie->pdi, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->pdi.presence = 1;
+            break;
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QER_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ACTIVATE_PREDEFINED_RULES_TYPE:
+            if (ogs_tlv_read_octet(&ie->activate_predefined_rules, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DEACTIVATE_PREDEFINED_RULES_TYPE:
+            if (ogs_tlv_read_octet(&ie->deactivate_predefined_rules, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ACTIVATION_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->activation_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DEACTIVATION_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->deactivation_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_bar_pfcp_session_report_response(ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->bar_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->downlink_data_notification_delay.presence)
+        length += TLV_HLEN + ie->downlink_data_notification_delay.len;
+    if (ie->dl_buffering_duration.presence)
+        length += TLV_HLEN + ie->dl_buffering_duration.len;
+    if (ie->dl_buffering_suggested_packet_count.presence)
+        length += TLV_HLEN + ie->dl_buffering_suggested_packet_count.len;
+    if (ie->suggested_buffering_packets_count.presence)
+        length += TLV_HLEN + ie->suggested_buffering_packets_count.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_bar_pfcp_session_report_response(uint8_t *pos, ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *ie)
+{
+    if (ie->bar_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_BAR_ID_TYPE, 0, &ie->bar_id);
+    if (ie->downlink_data_notification_delay.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DOWNLINK_DATA_NOTIFICATION_DELAY_TYPE, 0, &ie->downlink_data_notification_delay);
+    if (ie->dl_buffering_duration.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DL_BUFFERING_DURATION_TYPE, 0, &ie->dl_buffering_duration);
+    if (ie->dl_buffering_suggested_packet_count.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DL_BUFFERING_SUGGESTED_PACKET_COUNT_TYPE, 0, &ie->dl_buffering_suggested_packet_count);
+    if (ie->suggested_buffering_packets_count.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUGGESTED_BUFFERING_PACKETS_COUNT_TYPE, 0, &ie->suggested_buffering_packets_count);
+
+    return pos;
+}
+
+static int tlv_read_update_bar_pfcp_session_report_response(ogs_pfcp_tlv_update_bar_pfcp_session_report_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_BAR_ID_TYPE:
+            if (ogs_tlv_read_uint8(&ie->bar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DOWNLINK_DATA_NOTIFICATION_DELAY_TYPE:
+            if (ogs_tlv_read_octet(&ie->downlink_data_notification_delay, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DL_BUFFERING_DURATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->dl_buffering_duration, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DL_BUFFERING_SUGGESTED_PACKET_COUNT_TYPE:
+            if (ogs_tlv_read_octet(&ie->dl_buffering_suggested_packet_count, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUGGESTED_BUFFERING_PACKETS_COUNT_TYPE:
+            if (ogs_tlv_read_octet(&ie->suggested_buffering_packets_count, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_urr(ogs_pfcp_tlv_update_urr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->measurement_method.presence)
+        length += TLV_HLEN + 1;
+    if (ie->reporting_triggers.presence)
+        length += TLV_HLEN + 1;
+    if (ie->measurement_period.presence)
+        length += TLV_HLEN + ie->measurement_period.len;
+    if (ie->volume_threshold.presence)
+        length += TLV_HLEN + ie->volume_threshold.len;
+    if (ie->volume_quota.presence)
+        length += TLV_HLEN + ie->volume_quota.len;
+    if (ie->time_threshold.presence)
+        length += TLV_HLEN + ie->time_threshold.len;
+    if (ie->time_quota.presence)
+        length += TLV_HLEN + ie->time_quota.len;
+    if (ie->event_threshold.presence)
+        length += TLV_HLEN + ie->event_threshold.len;
+    if (ie->event_quota.presence)
+        length += TLV_HLEN + ie->event_quota.len;
+    if (ie->quota_holding_time.presence)
+        length += TLV_HLEN + ie->quota_holding_time.len;
+    if (ie->dropped_dl_traffic_threshold.presence)
+        length += TLV_HLEN + ie->dropped_dl_traffic_threshold.len;
+    if (ie->quota_validity_time.presence)
+        length += TLV_HLEN + ie->quota_validity_time.len;
+    if (ie->monitoring_time.presence)
+        length += TLV_HLEN + ie->monitoring_time.len;
+    if (ie->subsequent_volume_threshold.presence)
+        length += TLV_HLEN + ie->subsequent_volume_threshold.len;
+    if (ie->subsequent_time_threshold.presence)
+        length += TLV_HLEN + ie->subsequent_time_threshold.len;
+    if (ie->subsequent_volume_quota.presence)
+        length += TLV_HLEN + ie->subsequent_volume_quota.len;
+    if (ie->subsequent_time_quota.presence)
+        length += TLV_HLEN + ie->subsequent_time_quota.len;
+    if (ie->subsequent_event_threshold.presence)
+        length += TLV_HLEN + ie->subsequent_event_threshold.len;
+    if (ie->subsequent_event_quota.presence)
+        length += TLV_HLEN + ie->subsequent_event_quota.len;
+    if (ie->inactivity_detection_time.presence)
+        length += TLV_HLEN + ie->inactivity_detection_time.len;
+    if (ie->linked_urr_id.presence)
+        length += TLV_HLEN + ie->linked_urr_id.len;
+    if (ie->measurement_information.presence)
+        length += TLV_HLEN + ie->measurement_information.len;
+    if (ie->time_quota_mechanism.presence)
+        length += TLV_HLEN + ie->time_quota_mechanism.len;
+    if (ie->aggregated_urrs.presence)
+        length += TLV_HLEN + ie->aggregated_urrs.len;
+    if (ie->far_id_for_quota_action.presence)
+        length += TLV_HLEN + 4;
+    if (ie->ethernet_inactivity_timer.presence)
+        length += TLV_HLEN + ie->ethernet_inactivity_timer.len;
+    if (ie->additional_monitoring_time.presence)
+        length += TLV_HLEN + ie->additional_monitoring_time.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_urr(uint8_t *pos, ogs_pfcp_tlv_update_urr_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->measurement_method.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_MEASUREMENT_METHOD_TYPE, 0, &ie->measurement_method);
+    if (ie->reporting_triggers.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_REPORTING_TRIGGERS_TYPE, 0, &ie->reporting_triggers);
+    if (ie->measurement_period.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MEASUREMENT_PERIOD_TYPE, 0, &ie->measurement_period);
+    if (ie->volume_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_THRESHOLD_TYPE, 0, &ie->volume_threshold);
+    if (ie->volume_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_QUOTA_TYPE, 0, &ie->volume_quota);
+    if (ie->time_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_THRESHOLD_TYPE, 0, &ie->time_threshold);
+    if (ie->time_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_QUOTA_TYPE, 0, &ie->time_quota);
+    if (ie->event_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_EVENT_THRESHOLD_TYPE, 0, &ie->event_threshold);
+    if (ie->event_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_EVENT_QUOTA_TYPE, 0, &ie->event_quota);
+    if (ie->quota_holding_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUOTA_HOLDING_TIME_TYPE, 0, &ie->quota_holding_time);
+    if (ie->dropped_dl_traffic_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DROPPED_DL_TRAFFIC_THRESHOLD_TYPE, 0, &ie->dropped_dl_traffic_threshold);
+    if (ie->quota_validity_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUOTA_VALIDITY_TIME_TYPE, 0, &ie->quota_validity_time);
+    if (ie->monitoring_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MONITORING_TIME_TYPE, 0, &ie->monitoring_time);
+    if (ie->subsequent_volume_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_VOLUME_THRESHOLD_TYPE, 0, &ie->subsequent_volume_threshold);
+    if (ie->subsequent_time_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_TIME_THRESHOLD_TYPE, 0, &ie->subsequent_time_threshold);
+    if (ie->subsequent_volume_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_VOLUME_QUOTA_TYPE, 0, &ie->subsequent_volume_quota);
+    if (ie->subsequent_time_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_TIME_QUOTA_TYPE, 0, &ie->subsequent_time_quota);
+    if (ie->subsequent_event_threshold.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_EVENT_THRESHOLD_TYPE, 0, &ie->subsequent_event_threshold);
+    if (ie->subsequent_event_quota.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUBSEQUENT_EVENT_QUOTA_TYPE, 0, &ie->subsequent_event_quota);
+    if (ie->inactivity_detection_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_INACTIVITY_DETECTION_TIME_TYPE, 0, &ie->inactivity_detection_time);
+    if (ie->linked_urr_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_LINKED_URR_ID_TYPE, 0, &ie->linked_urr_id);
+    if (ie->measurement_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MEASUREMENT_INFORMATION_TYPE, 0, &ie->measurement_information);
+    if (ie->time_quota_mechanism.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_QUOTA_MECHANISM_TYPE, 0, &ie->time_quota_mechanism);
+    if (ie->aggregated_urrs.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_AGGREGATED_URRS_TYPE, 0, &ie->aggregated_urrs);
+    if (ie->far_id_for_quota_action.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id_for_quota_action);
+    if (ie->ethernet_inactivity_timer.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_INACTIVITY_TIMER_TYPE, 0, &ie->ethernet_inactivity_timer);
+    if (ie->additional_monitoring_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ADDITIONAL_MONITORING_TIME_TYPE, 0, &ie->additional_monitoring_time);
+
+    return pos;
+}
+
+static int tlv_read_update_urr(ogs_pfcp_tlv_update_urr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MEASUREMENT_METHOD_TYPE:
+            if (ogs_tlv_read_uint8(&ie->measurement_method, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_REPORTING_TRIGGERS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->reporting_triggers, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MEASUREMENT_PERIOD_TYPE:
+            if (ogs_tlv_read_octet(&ie->measurement_period, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_EVENT_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->event_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_EVENT_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->event_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUOTA_HOLDING_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->quota_holding_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DROPPED_DL_TRAFFIC_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->dropped_dl_traffic_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUOTA_VALIDITY_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->quota_validity_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MONITORING_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->monitoring_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_VOLUME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_volume_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_TIME_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_time_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_VOLUME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_volume_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_TIME_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_time_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_EVENT_THRESHOLD_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_event_threshold, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUBSEQUENT_EVENT_QUOTA_TYPE:
+            if (ogs_tlv_read_octet(&ie->subsequent_event_quota, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_INACTIVITY_DETECTION_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->inactivity_detection_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_LINKED_URR_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->linked_urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MEASUREMENT_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->measurement_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_QUOTA_MECHANISM_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_quota_mechanism, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_AGGREGATED_URRS_TYPE:
+            if (ogs_tlv_read_octet(&ie->aggregated_urrs, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id_for_quota_action, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_INACTIVITY_TIMER_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethernet_inactivity_timer, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ADDITIONAL_MONITORING_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->additional_monitoring_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_qer(ogs_pfcp_tlv_update_qer_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->qer_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->qer_correlation_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->gate_status.presence)
+        length += TLV_HLEN + 1;
+    if (ie->maximum_bitrate.presence)
+        length += TLV_HLEN + ie->maximum_bitrate.len;
+    if (ie->guaranteed_bitrate.presence)
+        length += TLV_HLEN + ie->guaranteed_bitrate.len;
+    if (ie->packet_rate.presence)
+        length += TLV_HLEN + ie->packet_rate.len;
+    if (ie->dl_flow_level_marking.presence)
+        length += TLV_HLEN + ie->dl_flow_level_marking.len;
+    if (ie->qos_flow_identifier.presence)
+        length += TLV_HLEN + 1;
+    if (ie->reflective_qos.presence)
+        length += TLV_HLEN + 1;
+    if (ie->paging_policy_indicator.presence)
+        length += TLV_HLEN + 1;
+    if (ie->averaging_window.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_qer(uint8_t *pos, ogs_pfcp_tlv_update_qer_t *ie)
+{
+    if (ie->qer_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_ID_TYPE, 0, &ie->qer_id);
+    if (ie->qer_correlation_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_CORRELATION_ID_TYPE, 0, &ie->qer_correlation_id);
+    if (ie->gate_status.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_GATE_STATUS_TYPE, 0, &ie->gate_status);
+    if (ie->maximum_bitrate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MBR_TYPE, 0, &ie->maximum_bitrate);
+    if (ie->guaranteed_bitrate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_GBR_TYPE, 0, &ie->guaranteed_bitrate);
+    if (ie->packet_rate.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PACKET_RATE_TYPE, 0, &ie->packet_rate);
+    if (ie->dl_flow_level_marking.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DL_FLOW_LEVEL_MARKING_TYPE, 0, &ie->dl_flow_level_marking);
+    if (ie->qos_flow_identifier.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_QFI_TYPE, 0, &ie->qos_flow_identifier);
+    if (ie->reflective_qos.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_RQI_TYPE, 0, &ie->reflective_qos);
+    if (ie->paging_policy_indicator.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PAGING_POLICY_INDICATOR_TYPE, 0, &ie->paging_policy_indicator);
+    if (ie->averaging_window.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_AVERAGING_WINDOW_TYPE, 0, &ie->averaging_window);
+
+    return pos;
+}
+
+static int tlv_read_update_qer(ogs_pfcp_tlv_update_qer_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_QER_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QER_CORRELATION_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_correlation_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_GATE_STATUS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->gate_status, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_MBR_TYPE:
+            if (ogs_tlv_read_octet(&ie->maximum_bitrate, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_GBR_TYPE:
+            if (ogs_tlv_read_octet(&ie->guaranteed_bitrate, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PACKET_RATE_TYPE:
+            if (ogs_tlv_read_octet(&ie->packet_rate, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DL_FLOW_LEVEL_MARKING_TYPE:
+            if (ogs_tlv_read_octet(&ie->dl_flow_level_marking, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QFI_TYPE:
+            if (ogs_tlv_read_uint8(&ie->qos_flow_identifier, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_RQI_TYPE:
+            if (ogs_tlv_read_uint8(&ie->reflective_qos, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PAGING_POLICY_INDICATOR_TYPE:
+            if (ogs_tlv_read_uint8(&ie->paging_policy_indicator, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_AVERAGING_WINDOW_TYPE:
+            if (ogs_tlv_read_uint32(&ie->averaging_window, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_pdr(ogs_pfcp_tlv_remove_pdr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->pdr_id.presence)
+        length += TLV_HLEN + 2;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_pdr(uint8_t *pos, ogs_pfcp_tlv_remove_pdr_t *ie)
+{
+    if (ie->pdr_id.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_PDR_ID_TYPE, 0, &ie->pdr_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_pdr(ogs_pfcp_tlv_remove_pdr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_PDR_ID_TYPE:
+            if (ogs_tlv_read_uint16(&ie->pdr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_far(ogs_pfcp_tlv_remove_far_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->far_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_far(uint8_t *pos, ogs_pfcp_tlv_remove_far_t *ie)
+{
+    if (ie->far_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_FAR_ID_TYPE, 0, &ie->far_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_far(ogs_pfcp_tlv_remove_far_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_FAR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->far_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_urr(ogs_pfcp_tlv_remove_urr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_urr(uint8_t *pos, ogs_pfcp_tlv_remove_urr_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_urr(ogs_pfcp_tlv_remove_urr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_qer(ogs_pfcp_tlv_remove_qer_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->qer_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_qer(uint8_t *pos, ogs_pfcp_tlv_remove_qer_t *ie)
+{
+    if (ie->qer_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_QER_ID_TYPE, 0, &ie->qer_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_qer(ogs_pfcp_tlv_remove_qer_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_QER_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->qer_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_load_control_information(ogs_pfcp_tlv_load_control_information_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->load_control_sequence_number.presence)
+        length += TLV_HLEN + 4;
+    if (ie->load_metric.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *tlv_write_load_control_information(uint8_t *pos, ogs_pfcp_tlv_load_control_information_t *ie)
+{
+    if (ie->load_control_sequence_number.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_SEQUENCE_NUMBER_TYPE, 0, &ie->load_control_sequence_number);
+    if (ie->load_metric.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_METRIC_TYPE, 0, &ie->load_metric);
+
+    return pos;
+}
+
+static int tlv_read_load_control_information(ogs_pfcp_tlv_load_control_information_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_SEQUENCE_NUMBER_TYPE:
+            if (ogs_tlv_read_uint32(&ie->load_control_sequence_number, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_METRIC_TYPE:
+            if (ogs_tlv_read_uint8(&ie->load_metric, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_overload_control_information(ogs_pfcp_tlv_overload_control_information_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->overload_control_sequence_number.presence)
+        length += TLV_HLEN + 4;
+    if (ie->overload_reduction_metric.presence)
+        length += TLV_HLEN + 1;
+    if (ie->period_of_validity.presence)
+        length += TLV_HLEN + 1;
+    if (ie->overload_control_information_flags.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *tlv_write_overload_control_information(uint8_t *pos, ogs_pfcp_tlv_overload_control_information_t *ie)
+{
+    if (ie->overload_control_sequence_number.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_SEQUENCE_NUMBER_TYPE, 0, &ie->overload_control_sequence_number);
+    if (ie->overload_reduction_metric.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_METRIC_TYPE, 0, &ie->overload_reduction_metric);
+    if (ie->period_of_validity.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_TIMER_TYPE, 0, &ie->period_of_validity);
+    if (ie->overload_control_information_flags.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_OCI_FLAGS_TYPE, 0, &ie->overload_control_information_flags);
+
+    return pos;
+}
+
+static int tlv_read_overload_control_information(ogs_pfcp_tlv_overload_control_information_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_SEQUENCE_NUMBER_TYPE:
+            if (ogs_tlv_read_uint32(&ie->overload_control_sequence_number, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_METRIC_TYPE:
+            if (ogs_tlv_read_uint8(&ie->overload_reduction_metric, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIMER_TYPE:
+            if (ogs_tlv_read_uint8(&ie->period_of_validity, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OCI_FLAGS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->overload_control_information_flags, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_application_detection_information(ogs_pfcp_tlv_application_detection_information_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->application_id.presence)
+        length += TLV_HLEN + ie->application_id.len;
+    if (ie->application_instance_id.presence)
+        length += TLV_HLEN + ie->application_instance_id.len;
+    if (ie->flow_information.presence)
+        length += TLV_HLEN + ie->flow_information.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_application_detection_information(uint8_t *pos, ogs_pfcp_tlv_application_detection_information_t *ie)
+{
+    if (ie->application_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_APPLICATION_ID_TYPE, 0, &ie->application_id);
+    if (ie->application_instance_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_APPLICATION_INSTANCE_ID_TYPE, 0, &ie->application_instance_id);
+    if (ie->flow_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FLOW_INFORMATION_TYPE, 0, &ie->flow_information);
+
+    return pos;
+}
+
+static int tlv_read_application_detection_information(ogs_pfcp_tlv_application_detection_information_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_APPLICATION_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->application_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_APPLICATION_INSTANCE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->application_instance_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FLOW_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->flow_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_query_urr(ogs_pfcp_tlv_query_urr_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *tlv_write_query_urr(uint8_t *pos, ogs_pfcp_tlv_query_urr_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+
+    return pos;
+}
+
+static int tlv_read_query_urr(ogs_pfcp_tlv_query_urr_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_usage_report_session_modification_response(ogs_pfcp_tlv_usage_report_session_modification_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->ur_seqn.presence)
+        length += TLV_HLEN + ie->ur_seqn.len;
+    if (ie->usage_report_trigger.presence)
+        length += TLV_HLEN + ie->usage_report_trigger.len;
+    if (ie->start_time.presence)
+        length += TLV_HLEN + ie->start_time.len;
+    if (ie->end_time.presence)
+        length += TLV_HLEN + ie->end_time.len;
+    if (ie->volume_measurement.presence)
+        length += TLV_HLEN + ie->volume_measurement.len;
+    if (ie->duration_measurement.presence)
+        length += TLV_HLEN + ie->duration_measurement.len;
+    if (ie->time_of_first_packet.presence)
+        length += TLV_HLEN + ie->time_of_first_packet.len;
+    if (ie->time_of_last_packet.presence)
+        length += TLV_HLEN + ie->time_of_last_packet.len;
+    if (ie->usage_information.presence)
+        length += TLV_HLEN + ie->usage_information.len;
+    if (ie->query_urr_reference.presence)
+        length += TLV_HLEN + ie->query_urr_reference.len;
+    if (ie->ethernet_traffic_information.presence)
+        length += TLV_HLEN + tlv_length_ethernet_traffic_information(&ie->ethernet_traffic_information);
+
+    return length;
+}
+
+static uint8_t *tlv_write_usage_report_session_modification_response(uint8_t *pos, ogs_pfcp_tlv_usage_report_session_modification_response_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->ur_seqn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UR_SEQN_TYPE, 0, &ie->ur_seqn);
+    if (ie->usage_report_trigger.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USAGE_REPORT_TRIGGER_TYPE, 0, &ie->usage_report_trigger);
+    if (ie->start_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_START_TIME_TYPE, 0, &ie->start_time);
+    if (ie->end_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_END_TIME_TYPE, 0, &ie->end_time);
+    if (ie->volume_measurement.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_MEASUREMENT_TYPE, 0, &ie->volume_measurement);
+    if (ie->duration_measurement.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DURATION_MEASUREMENT_TYPE, 0, &ie->duration_measurement);
+    if (ie->time_of_first_packet.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_OF_FIRST_PACKET_TYPE, 0, &ie->time_of_first_packet);
+    if (ie->time_of_last_packet.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_OF_LAST_PACKET_TYPE, 0, &ie->time_of_last_packet);
+    if (ie->usage_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USAGE_INFORMATION_TYPE, 0, &ie->usage_information);
+    if (ie->query_urr_reference.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUERY_URR_REFERENCE_TYPE, 0, &ie->query_urr_reference);
+    if (ie->ethernet_traffic_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_TRAFFIC_INFORMATION_TYPE, 0,
+                tlv_write_ethernet_traffic_information(pos + TLV_HLEN, &ie->ethernet_traffic_information));
+
+    return pos;
+}
+
+static int tlv_read_usage_report_session_modification_response(ogs_pfcp_tlv_usage_report_session_modification_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UR_SEQN_TYPE:
+            if (ogs_tlv_read_octet(&ie->ur_seqn, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USAGE_REPORT_TRIGGER_TYPE:
+            if (ogs_tlv_read_octet(&ie->usage_report_trigger, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_START_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->start_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_END_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->end_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_MEASUREMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_measurement, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DURATION_MEASUREMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->duration_measurement, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_OF_FIRST_PACKET_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_of_first_packet, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_OF_LAST_PACKET_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_of_last_packet, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USAGE_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->usage_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUERY_URR_REFERENCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->query_urr_reference, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_TRAFFIC_INFORMATION_TYPE:
+            if (tlv_read_ethernet_traffic_information(&ie->ethernet_traffic_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->ethernet_traffic_information.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_usage_report_session_deletion_response(ogs_pfcp_tlv_usage_report_session_deletion_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->ur_seqn.presence)
+        length += TLV_HLEN + ie->ur_seqn.len;
+    if (ie->usage_report_trigger.presence)
+        length += TLV_HLEN + ie->usage_report_trigger.len;
+    if (ie->start_time.presence)
+        length += TLV_HLEN + ie->start_time.len;
+    if (ie->end_time.presence)
+        length += TLV_HLEN + ie->end_time.len;
+    if (ie->volume_measurement.presence)
+        length += TLV_HLEN + ie->volume_measurement.len;
+    if (ie->duration_measurement.presence)
+        length += TLV_HLEN + ie->duration_measurement.len;
+    if (ie->time_of_first_packet.presence)
+        length += TLV_HLEN + ie->time_of_first_packet.len;
+    if (ie->time_of_last_packet.presence)
+        length += TLV_HLEN + ie->time_of_last_packet.len;
+    if (ie->usage_information.presence)
+        length += TLV_HLEN + ie->usage_information.len;
+    if (ie->ethernet_traffic_information.presence)
+        length += TLV_HLEN + tlv_length_ethernet_traffic_information(&ie->ethernet_traffic_information);
+
+    return length;
+}
+
+static uint8_t *tlv_write_usage_report_session_deletion_response(uint8_t *pos, ogs_pfcp_tlv_usage_report_session_deletion_response_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->ur_seqn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UR_SEQN_TYPE, 0, &ie->ur_seqn);
+    if (ie->usage_report_trigger.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USAGE_REPORT_TRIGGER_TYPE, 0, &ie->usage_report_trigger);
+    if (ie->start_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_START_TIME_TYPE, 0, &ie->start_time);
+    if (ie->end_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_END_TIME_TYPE, 0, &ie->end_time);
+    if (ie->volume_measurement.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_MEASUREMENT_TYPE, 0, &ie->volume_measurement);
+    if (ie->duration_measurement.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DURATION_MEASUREMENT_TYPE, 0, &ie->duration_measurement);
+    if (ie->time_of_first_packet.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_OF_FIRST_PACKET_TYPE, 0, &ie->time_of_first_packet);
+    if (ie->time_of_last_packet.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_OF_LAST_PACKET_TYPE, 0, &ie->time_of_last_packet);
+    if (ie->usage_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USAGE_INFORMATION_TYPE, 0, &ie->usage_information);
+    if (ie->ethernet_traffic_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_TRAFFIC_INFORMATION_TYPE, 0,
+                tlv_write_ethernet_traffic_information(pos + TLV_HLEN, &ie->ethernet_traffic_information));
+
+    return pos;
+}
+
+static int tlv_read_usage_report_session_deletion_response(ogs_pfcp_tlv_usage_report_session_deletion_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UR_SEQN_TYPE:
+            if (ogs_tlv_read_octet(&ie->ur_seqn, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USAGE_REPORT_TRIGGER_TYPE:
+            if (ogs_tlv_read_octet(&ie->usage_report_trigger, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_START_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->start_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_END_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->end_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_MEASUREMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_measurement, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DURATION_MEASUREMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->duration_measurement, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_OF_FIRST_PACKET_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_of_first_packet, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_OF_LAST_PACKET_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_of_last_packet, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USAGE_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->usage_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_TRAFFIC_INFORMATION_TYPE:
+            if (tlv_read_ethernet_traffic_information(&ie->ethernet_traffic_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->ethernet_traffic_information.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_usage_report_session_report_request(ogs_pfcp_tlv_usage_report_session_report_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->urr_id.presence)
+        length += TLV_HLEN + 4;
+    if (ie->ur_seqn.presence)
+        length += TLV_HLEN + ie->ur_seqn.len;
+    if (ie->usage_report_trigger.presence)
+        length += TLV_HLEN + ie->usage_report_trigger.len;
+    if (ie->start_time.presence)
+        length += TLV_HLEN + ie->start_time.len;
+    if (ie->end_time.presence)
+        length += TLV_HLEN + ie->end_time.len;
+    if (ie->volume_measurement.presence)
+        length += TLV_HLEN + ie->volume_measurement.len;
+    if (ie->duration_measurement.presence)
+        length += TLV_HLEN + ie->duration_measurement.len;
+    if (ie->application_detection_information.presence)
+        length += TLV_HLEN + tlv_length_application_detection_information(&ie->application_detection_information);
+    if (ie->ue_ip_address.presence)
+        length += TLV_HLEN + ie->ue_ip_address.len;
+    if (ie->network_instance.presence)
+        length += TLV_HLEN + ie->network_instance.len;
+    if (ie->time_of_first_packet.presence)
+        length += TLV_HLEN + ie->time_of_first_packet.len;
+    if (ie->time_of_last_packet.presence)
+        length += TLV_HLEN + ie->time_of_last_packet.len;
+    if (ie->usage_information.presence)
+        length += TLV_HLEN + ie->usage_information.len;
+    if (ie->query_urr_reference.presence)
+        length += TLV_HLEN + ie->query_urr_reference.len;
+    if (ie->event_time_stamp.presence)
+        length += TLV_HLEN + ie->event_time_stamp.len;
+    if (ie->ethernet_traffic_information.presence)
+        length += TLV_HLEN + tlv_length_ethernet_traffic_information(&ie->ethernet_traffic_information);
+
+    return length;
+}
+
+static uint8_t *tlv_write_usage_report_session_report_request(uint8_t *pos, ogs_pfcp_tlv_usage_report_session_report_request_t *ie)
+{
+    if (ie->urr_id.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_URR_ID_TYPE, 0, &ie->urr_id);
+    if (ie->ur_seqn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UR_SEQN_TYPE, 0, &ie->ur_seqn);
+    if (ie->usage_report_trigger.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USAGE_REPORT_TRIGGER_TYPE, 0, &ie->usage_report_trigger);
+    if (ie->start_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_START_TIME_TYPE, 0, &ie->start_time);
+    if (ie->end_time.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_END_TIME_TYPE, 0, &ie->end_time);
+    if (ie->volume_measurement.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_VOLUME_MEASUREMENT_TYPE, 0, &ie->volume_measurement);
+    if (ie->duration_measurement.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DURATION_MEASUREMENT_TYPE, 0, &ie->duration_measurement);
+    if (ie->application_detection_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_APPLICATION_DETECTION_INFORMATION_TYPE, 0,
+                tlv_write_application_detection_information(pos + TLV_HLEN, &ie->application_detection_information));
+    if (ie->ue_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UE_IP_ADDRESS_TYPE, 0, &ie->ue_ip_address);
+    if (ie->network_instance.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NETWORK_INSTANCE_TYPE, 0, &ie->network_instance);
+    if (ie->time_of_first_packet.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_OF_FIRST_PACKET_TYPE, 0, &ie->time_of_first_packet);
+    if (ie->time_of_last_packet.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TIME_OF_LAST_PACKET_TYPE, 0, &ie->time_of_last_packet);
+    if (ie->usage_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USAGE_INFORMATION_TYPE, 0, &ie->usage_information);
+    if (ie->query_urr_reference.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUERY_URR_REFERENCE_TYPE, 0, &ie->query_urr_reference);
+    if (ie->event_time_stamp.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_EVENT_TIME_STAMP_TYPE, 0, &ie->event_time_stamp);
+    if (ie->ethernet_traffic_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_TRAFFIC_INFORMATION_TYPE, 0,
+                tlv_write_ethernet_traffic_information(pos + TLV_HLEN, &ie->ethernet_traffic_information));
+
+    return pos;
+}
+
+static int tlv_read_usage_report_session_report_request(ogs_pfcp_tlv_usage_report_session_report_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_URR_ID_TYPE:
+            if (ogs_tlv_read_uint32(&ie->urr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UR_SEQN_TYPE:
+            if (ogs_tlv_read_octet(&ie->ur_seqn, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USAGE_REPORT_TRIGGER_TYPE:
+            if (ogs_tlv_read_octet(&ie->usage_report_trigger, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_START_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->start_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_END_TIME_TYPE:
+            if (ogs_tlv_read_octet(&ie->end_time, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_VOLUME_MEASUREMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->volume_measurement, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DURATION_MEASUREMENT_TYPE:
+            if (ogs_tlv_read_octet(&ie->duration_measurement, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_APPLICATION_DETECTION_INFORMATION_TYPE:
+            if (tlv_read_application_detection_information(&ie->application_detection_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->application_detection_information.presence = 1;
+            break;
+        case OGS_PFCP_UE_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->ue_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_NETWORK_INSTANCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->network_instance, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_OF_FIRST_PACKET_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_of_first_packet, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TIME_OF_LAST_PACKET_TYPE:
+            if (ogs_tlv_read_octet(&ie->time_of_last_packet, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USAGE_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->usage_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUERY_URR_REFERENCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->query_urr_reference, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_EVENT_TIME_STAMP_TYPE:
+            if (ogs_tlv_read_octet(&ie->event_time_stamp, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_TRAFFIC_INFORMATION_TYPE:
+            if (tlv_read_ethernet_traffic_information(&ie->ethernet_traffic_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->ethernet_traffic_information.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_downlink_data_report(ogs_pfcp_tlv_downlink_data_report_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->pdr_id.presence)
+        length += TLV_HLEN + 2;
+    if (ie->downlink_data_service_information.presence)
+        length += TLV_HLEN + ie->downlink_data_service_information.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_downlink_data_report(uint8_t *pos, ogs_pfcp_tlv_downlink_data_report_t *ie)
+{
+    if (ie->pdr_id.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_PDR_ID_TYPE, 0, &ie->pdr_id);
+    if (ie->downlink_data_service_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DOWNLINK_DATA_SERVICE_INFORMATION_TYPE, 0, &ie->downlink_data_service_information);
+
+    return pos;
+}
+
+static int tlv_read_downlink_data_report(ogs_pfcp_tlv_downlink_data_report_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_PDR_ID_TYPE:
+            if (ogs_tlv_read_uint16(&ie->pdr_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DOWNLINK_DATA_SERVICE_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->downlink_data_service_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_create_bar(ogs_pfcp_tlv_create_bar_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->bar_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->downlink_data_notification_delay.presence)
+        length += TLV_HLEN + ie->downlink_data_notification_delay.len;
+    if (ie->suggested_buffering_packets_count.presence)
+        length += TLV_HLEN + ie->suggested_buffering_packets_count.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_bar(uint8_t *pos, ogs_pfcp_tlv_create_bar_t *ie)
+{
+    if (ie->bar_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_BAR_ID_TYPE, 0, &ie->bar_id);
+    if (ie->downlink_data_notification_delay.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DOWNLINK_DATA_NOTIFICATION_DELAY_TYPE, 0, &ie->downlink_data_notification_delay);
+    if (ie->suggested_buffering_packets_count.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUGGESTED_BUFFERING_PACKETS_COUNT_TYPE, 0, &ie->suggested_buffering_packets_count);
+
+    return pos;
+}
+
+static int tlv_read_create_bar(ogs_pfcp_tlv_create_bar_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_BAR_ID_TYPE:
+            if (ogs_tlv_read_uint8(&ie->bar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DOWNLINK_DATA_NOTIFICATION_DELAY_TYPE:
+            if (ogs_tlv_read_octet(&ie->downlink_data_notification_delay, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUGGESTED_BUFFERING_PACKETS_COUNT_TYPE:
+            if (ogs_tlv_read_octet(&ie->suggested_buffering_packets_count, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_bar_session_modification_request(ogs_pfcp_tlv_update_bar_session_modification_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->bar_id.presence)
+        length += TLV_HLEN + 1;
+    if (ie->downlink_data_notification_delay.presence)
+        length += TLV_HLEN + ie->downlink_data_notification_delay.len;
+    if (ie->suggested_buffering_packets_count.presence)
+        length += TLV_HLEN + ie->suggested_buffering_packets_count.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_bar_session_modification_request(uint8_t *pos, ogs_pfcp_tlv_update_bar_session_modification_request_t *ie)
+{
+    if (ie->bar_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_BAR_ID_TYPE, 0, &ie->bar_id);
+    if (ie->downlink_data_notification_delay.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_DOWNLINK_DATA_NOTIFICATION_DELAY_TYPE, 0, &ie->downlink_data_notification_delay);
+    if (ie->suggested_buffering_packets_count.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SUGGESTED_BUFFERING_PACKETS_COUNT_TYPE, 0, &ie->suggested_buffering_packets_count);
+
+    return pos;
+}
+
+static int tlv_read_update_bar_session_modification_request(ogs_pfcp_tlv_update_bar_session_modification_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_BAR_ID_TYPE:
+            if (ogs_tlv_read_uint8(&ie->bar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DOWNLINK_DATA_NOTIFICATION_DELAY_TYPE:
+            if (ogs_tlv_read_octet(&ie->downlink_data_notification_delay, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SUGGESTED_BUFFERING_PACKETS_COUNT_TYPE:
+            if (ogs_tlv_read_octet(&ie->suggested_buffering_packets_count, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_bar(ogs_pfcp_tlv_remove_bar_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->bar_id.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_bar(uint8_t *pos, ogs_pfcp_tlv_remove_bar_t *ie)
+{
+    if (ie->bar_id.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_BAR_ID_TYPE, 0, &ie->bar_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_bar(ogs_pfcp_tlv_remove_bar_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_BAR_ID_TYPE:
+            if (ogs_tlv_read_uint8(&ie->bar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_error_indication_report(ogs_pfcp_tlv_error_indication_report_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->remote_f_teid.presence)
+        length += TLV_HLEN + ie->remote_f_teid.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_error_indication_report(uint8_t *pos, ogs_pfcp_tlv_error_indication_report_t *ie)
+{
+    if (ie->remote_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_TEID_TYPE, 0, &ie->remote_f_teid);
+
+    return pos;
+}
+
+static int tlv_read_error_indication_report(ogs_pfcp_tlv_error_indication_report_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_F_TEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->remote_f_teid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_user_plane_path_failure_report(ogs_pfcp_tlv_user_plane_path_failure_report_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->remote_gtp_u_peer_.presence)
+        length += TLV_HLEN + ie->remote_gtp_u_peer_.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_user_plane_path_failure_report(uint8_t *pos, ogs_pfcp_tlv_user_plane_path_failure_report_t *ie)
+{
+    if (ie->remote_gtp_u_peer_.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_REMOTE_GTP_U_PEER_TYPE, 0, &ie->remote_gtp_u_peer_);
+
+    return pos;
+}
+
+static int tlv_read_user_plane_path_failure_report(ogs_pfcp_tlv_user_plane_path_failure_report_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_REMOTE_GTP_U_PEER_TYPE:
+            if (ogs_tlv_read_octet(&ie->remote_gtp_u_peer_, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_create_traffic_endpoint(ogs_pfcp_tlv_create_traffic_endpoint_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->traffic_endpoint_id.presence)
+        length += TLV_HLEN + ie->traffic_endpoint_id.len;
+    if (ie->local_f_teid.presence)
+        length += TLV_HLEN + ie->local_f_teid.len;
+    if (ie->network_instance.presence)
+        length += TLV_HLEN + ie->network_instance.len;
+    if (ie->ue_ip_address.presence)
+        length += TLV_HLEN + ie->ue_ip_address.len;
+    if (ie->ethernet_pdu_session_information.presence)
+        length += TLV_HLEN + ie->ethernet_pdu_session_information.len;
+    if (ie->framed_route.presence)
+        length += TLV_HLEN + ie->framed_route.len;
+    if (ie->framed_routing.presence)
+        length += TLV_HLEN + ie->framed_routing.len;
+    if (ie->framed_ipv6_route.presence)
+        length += TLV_HLEN + ie->framed_ipv6_route.len;
+    if (ie->qfi.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_traffic_endpoint(uint8_t *pos, ogs_pfcp_tlv_create_traffic_endpoint_t *ie)
+{
+    if (ie->traffic_endpoint_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE, 0, &ie->traffic_endpoint_id);
+    if (ie->local_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_TEID_TYPE, 0, &ie->local_f_teid);
+    if (ie->network_instance.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NETWORK_INSTANCE_TYPE, 0, &ie->network_instance);
+    if (ie->ue_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UE_IP_ADDRESS_TYPE, 0, &ie->ue_ip_address);
+    if (ie->ethernet_pdu_session_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ETHERNET_PDU_SESSION_INFORMATION_TYPE, 0, &ie->ethernet_pdu_session_information);
+    if (ie->framed_route.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FRAMED_ROUTE_TYPE, 0, &ie->framed_route);
+    if (ie->framed_routing.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FRAMED_ROUTING_TYPE, 0, &ie->framed_routing);
+    if (ie->framed_ipv6_route.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FRAMED_IPV6_ROUTE_TYPE, 0, &ie->framed_ipv6_route);
+    if (ie->qfi.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_QFI_TYPE, 0, &ie->qfi);
+
+    return pos;
+}
+
+static int tlv_read_create_traffic_endpoint(ogs_pfcp_tlv_create_traffic_endpoint_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->traffic_endpoint_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_TEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->local_f_teid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_NETWORK_INSTANCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->network_instance, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UE_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->ue_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ETHERNET_PDU_SESSION_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->ethernet_pdu_session_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FRAMED_ROUTE_TYPE:
+            if (ogs_tlv_read_octet(&ie->framed_route, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FRAMED_ROUTING_TYPE:
+            if (ogs_tlv_read_octet(&ie->framed_routing, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FRAMED_IPV6_ROUTE_TYPE:
+            if (ogs_tlv_read_octet(&ie->framed_ipv6_route, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QFI_TYPE:
+            if (ogs_tlv_read_uint8(&ie->qfi, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_created_traffic_endpoint(ogs_pfcp_tlv_created_traffic_endpoint_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->traffic_endpoint_id.presence)
+        length += TLV_HLEN + ie->traffic_endpoint_id.len;
+    if (ie->local_f_teid.presence)
+        length += TLV_HLEN + ie->local_f_teid.len;
+    if (ie->ue_ip_address.presence)
+        length += TLV_HLEN + ie->ue_ip_address.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_created_traffic_endpoint(uint8_t *pos, ogs_pfcp_tlv_created_traffic_endpoint_t *ie)
+{
+    if (ie->traffic_endpoint_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE, 0, &ie->traffic_endpoint_id);
+    if (ie->local_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_TEID_TYPE, 0, &ie->local_f_teid);
+    if (ie->ue_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UE_IP_ADDRESS_TYPE, 0, &ie->ue_ip_address);
+
+    return pos;
+}
+
+static int tlv_read_created_traffic_endpoint(ogs_pfcp_tlv_created_traffic_endpoint_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->traffic_endpoint_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_TEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->local_f_teid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UE_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->ue_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_traffic_endpoint(ogs_pfcp_tlv_remove_traffic_endpoint_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->traffic_endpoint_id.presence)
+        length += TLV_HLEN + ie->traffic_endpoint_id.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_traffic_endpoint(uint8_t *pos, ogs_pfcp_tlv_remove_traffic_endpoint_t *ie)
+{
+    if (ie->traffic_endpoint_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE, 0, &ie->traffic_endpoint_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_traffic_endpoint(ogs_pfcp_tlv_remove_traffic_endpoint_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_TRAFFIC_ENDPOINT_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->traffic_endpoint_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_create_mar(ogs_pfcp_tlv_create_mar_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->mar_id.presence)
+        length += TLV_HLEN + ie->mar_id.len;
+    if (ie->steering_functionality.presence)
+        length += TLV_HLEN + ie->steering_functionality.len;
+    if (ie->steering_mode.presence)
+        length += TLV_HLEN + ie->steering_mode.len;
+    if (ie->access_forwarding_action_information_1.presence)
+        length += TLV_HLEN + tlv_length_access_forwarding_action_information_1(&ie->access_forwarding_action_information_1);
+    if (ie->access_forwarding_action_information_2.presence)
+        length += TLV_HLEN + tlv_length_access_forwarding_action_information_2(&ie->access_forwarding_action_information_2);
+
+    return length;
+}
+
+static uint8_t *tlv_write_create_mar(uint8_t *pos, ogs_pfcp_tlv_create_mar_t *ie)
+{
+    if (ie->mar_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAR_ID_TYPE, 0, &ie->mar_id);
+    if (ie->steering_functionality.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_STEERING_FUNCTIONALITY_TYPE, 0, &ie->steering_functionality);
+    if (ie->steering_mode.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_STEERING_MODE_TYPE, 0, &ie->steering_mode);
+    if (ie->access_forwarding_action_information_1.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_1_TYPE, 0,
+                tlv_write_access_forwarding_action_information_1(pos + TLV_HLEN, &ie->access_forwarding_action_information_1));
+    if (ie->access_forwarding_action_information_2.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_2_TYPE, 0,
+                tlv_write_access_forwarding_action_information_2(pos + TLV_HLEN, &ie->access_forwarding_action_information_2));
+
+    return pos;
+}
+
+static int tlv_read_create_mar(ogs_pfcp_tlv_create_mar_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_MAR_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->mar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_STEERING_FUNCTIONALITY_TYPE:
+            if (ogs_tlv_read_octet(&ie->steering_functionality, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_STEERING_MODE_TYPE:
+            if (ogs_tlv_read_octet(&ie->steering_mode, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_1_TYPE:
+            if (tlv_read_access_forwarding_action_information_1(&ie->access_forwarding_action_information_1, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->access_forwarding_action_information_1.presence = 1;
+            break;
+        case OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_2_TYPE:
+            if (tlv_read_access_forwarding_action_information_2(&ie->access_forwarding_action_information_2, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->access_forwarding_action_information_2.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_remove_mar(ogs_pfcp_tlv_remove_mar_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->mar_id.presence)
+        length += TLV_HLEN + ie->mar_id.len;
+
+    return length;
+}
+
+static uint8_t *tlv_write_remove_mar(uint8_t *pos, ogs_pfcp_tlv_remove_mar_t *ie)
+{
+    if (ie->mar_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAR_ID_TYPE, 0, &ie->mar_id);
+
+    return pos;
+}
+
+static int tlv_read_remove_mar(ogs_pfcp_tlv_remove_mar_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_MAR_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->mar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t tlv_length_update_mar(ogs_pfcp_tlv_update_mar_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->mar_id.presence)
+        length += TLV_HLEN + ie->mar_id.len;
+    if (ie->steering_functionality.presence)
+        length += TLV_HLEN + ie->steering_functionality.len;
+    if (ie->steering_mode.presence)
+        length += TLV_HLEN + ie->steering_mode.len;
+    if (ie->update_access_forwarding_action_information_1.presence)
+        length += TLV_HLEN + tlv_length_update_access_forwarding_action_information_1(&ie->update_access_forwarding_action_information_1);
+    if (ie->update_access_forwarding_action_information_2.presence)
+        length += TLV_HLEN + tlv_length_update_access_forwarding_action_information_2(&ie->update_access_forwarding_action_information_2);
+    if (ie->access_forwarding_action_information_1.presence)
+        length += TLV_HLEN + tlv_length_access_forwarding_action_information_1(&ie->access_forwarding_action_information_1);
+    if (ie->access_forwarding_action_information_2.presence)
+        length += TLV_HLEN + tlv_length_access_forwarding_action_information_2(&ie->access_forwarding_action_information_2);
+
+    return length;
+}
+
+static uint8_t *tlv_write_update_mar(uint8_t *pos, ogs_pfcp_tlv_update_mar_t *ie)
+{
+    if (ie->mar_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_MAR_ID_TYPE, 0, &ie->mar_id);
+    if (ie->steering_functionality.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_STEERING_FUNCTIONALITY_TYPE, 0, &ie->steering_functionality);
+    if (ie->steering_mode.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_STEERING_MODE_TYPE, 0, &ie->steering_mode);
+    if (ie->update_access_forwarding_action_information_1.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_ACCESS_FORWARDING_ACTION_INFORMATION_1_TYPE, 0,
+                tlv_write_update_access_forwarding_action_information_1(pos + TLV_HLEN, &ie->update_access_forwarding_action_information_1));
+    if (ie->update_access_forwarding_action_information_2.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_ACCESS_FORWARDING_ACTION_INFORMATION_2_TYPE, 0,
+                tlv_write_update_access_forwarding_action_information_2(pos + TLV_HLEN, &ie->update_access_forwarding_action_information_2));
+    if (ie->access_forwarding_action_information_1.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_1_TYPE, 0,
+                tlv_write_access_forwarding_action_information_1(pos + TLV_HLEN, &ie->access_forwarding_action_information_1));
+    if (ie->access_forwarding_action_information_2.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_2_TYPE, 0,
+                tlv_write_access_forwarding_action_information_2(pos + TLV_HLEN, &ie->access_forwarding_action_information_2));
+
+    return pos;
+}
+
+static int tlv_read_update_mar(ogs_pfcp_tlv_update_mar_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_MAR_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->mar_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_STEERING_FUNCTIONALITY_TYPE:
+            if (ogs_tlv_read_octet(&ie->steering_functionality, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_STEERING_MODE_TYPE:
+            if (ogs_tlv_read_octet(&ie->steering_mode, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UPDATE_ACCESS_FORWARDING_ACTION_INFORMATION_1_TYPE:
+            if (tlv_read_update_access_forwarding_action_information_1(&ie->update_access_forwarding_action_information_1, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_access_forwarding_action_information_1.presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_ACCESS_FORWARDING_ACTION_INFORMATION_2_TYPE:
+            if (tlv_read_update_access_forwarding_action_information_2(&ie->update_access_forwarding_action_information_2, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_access_forwarding_action_information_2.presence = 1;
+            break;
+        case OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_1_TYPE:
+            if (tlv_read_access_forwarding_action_information_1(&ie->access_forwarding_action_information_1, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->access_forwarding_action_information_1.presence = 1;
+            break;
+        case OGS_PFCP_ACCESS_FORWARDING_ACTION_INFORMATION_2_TYPE:
+            if (tlv_read_access_forwarding_action_information_2(&ie->access_forwarding_action_information_2, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->access_forwarding_action_information_2.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_heartbeat_request(ogs_pfcp_heartbeat_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->recovery_time_stamp.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_heartbeat_request(uint8_t *pos, ogs_pfcp_heartbeat_request_t *ie)
+{
+    if (ie->recovery_time_stamp.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_RECOVERY_TIME_STAMP_TYPE, 0, &ie->recovery_time_stamp);
+
+    return pos;
+}
+
+static int msg_read_pfcp_heartbeat_request(ogs_pfcp_heartbeat_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_RECOVERY_TIME_STAMP_TYPE:
+            if (ogs_tlv_read_uint32(&ie->recovery_time_stamp, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_heartbeat_response(ogs_pfcp_heartbeat_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->recovery_time_stamp.presence)
+        length += TLV_HLEN + 4;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_heartbeat_response(uint8_t *pos, ogs_pfcp_heartbeat_response_t *ie)
+{
+    if (ie->recovery_time_stamp.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_RECOVERY_TIME_STAMP_TYPE, 0, &ie->recovery_time_stamp);
+
+    return pos;
+}
+
+static int msg_read_pfcp_heartbeat_response(ogs_pfcp_heartbeat_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_RECOVERY_TIME_STAMP_TYPE:
+            if (ogs_tlv_read_uint32(&ie->recovery_time_stamp, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_pfd_management_request(ogs_pfcp_pfd_management_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->application_id_s_pfds.presence)
+        length += TLV_HLEN + tlv_length_application_id_s_pfds(&ie->application_id_s_pfds);
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_pfd_management_request(uint8_t *pos, ogs_pfcp_pfd_management_request_t *ie)
+{
+    if (ie->application_id_s_pfds.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_APPLICATION_ID_S_PFDS_TYPE, 0,
+                tlv_write_application_id_s_pfds(pos + TLV_HLEN, &ie->application_id_s_pfds));
+
+    return pos;
+}
+
+static int msg_read_pfcp_pfd_management_request(ogs_pfcp_pfd_management_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_APPLICATION_ID_S_PFDS_TYPE:
+            if (tlv_read_application_id_s_pfds(&ie->application_id_s_pfds, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->application_id_s_pfds.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_pfd_management_response(ogs_pfcp_pfd_management_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_pfd_management_response(uint8_t *pos, ogs_pfcp_pfd_management_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+
+    return pos;
+}
+
+static int msg_read_pfcp_pfd_management_response(ogs_pfcp_pfd_management_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_association_setup_request(ogs_pfcp_association_setup_request_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->recovery_time_stamp.presence)
+        length += TLV_HLEN + 4;
+    if (ie->up_function_features.presence)
+        length += TLV_HLEN + ie->up_function_features.len;
+    if (ie->cp_function_features.presence)
+        length += TLV_HLEN + 1;
+    for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++)
+        length += TLV_HLEN + ie->user_plane_ip_resource_information[i].len;
+    if (ie->ue_ip_address_pool_identity.presence)
+        length += TLV_HLEN + ie->ue_ip_address_pool_identity.len;
+    if (ie->alternative_smf_ip_address.presence)
+        length += TLV_HLEN + ie->alternative_smf_ip_address.len;
+    if (ie->smf_set_id.presence)
+        length += TLV_HLEN + ie->smf_set_id.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_association_setup_request(uint8_t *pos, ogs_pfcp_association_setup_request_t *ie)
+{
+    int i;
+
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->recovery_time_stamp.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_RECOVERY_TIME_STAMP_TYPE, 0, &ie->recovery_time_stamp);
+    if (ie->up_function_features.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UP_FUNCTION_FEATURES_TYPE, 0, &ie->up_function_features);
+    if (ie->cp_function_features.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CP_FUNCTION_FEATURES_TYPE, 0, &ie->cp_function_features);
+    for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USER_PLANE_IP_RESOURCE_INFORMATION_TYPE, 0, &ie->user_plane_ip_resource_information[i]);
+    if (ie->ue_ip_address_pool_identity.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UE_IP_ADDRESS_TYPE, 0, &ie->ue_ip_address_pool_identity);
+    if (ie->alternative_smf_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE, 0, &ie->alternative_smf_ip_address);
+    if (ie->smf_set_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_SMF_SET_ID_TYPE, 0, &ie->smf_set_id);
+
+    return pos;
+}
+
+static int msg_read_pfcp_association_setup_request(ogs_pfcp_association_setup_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_RECOVERY_TIME_STAMP_TYPE:
+            if (ogs_tlv_read_uint32(&ie->recovery_time_stamp, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_octet(&ie->up_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cp_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_PLANE_IP_RESOURCE_INFORMATION_TYPE:
+            for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (ogs_tlv_read_octet(&ie->user_plane_ip_resource_information[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UE_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->ue_ip_address_pool_identity, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->alternative_smf_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_SMF_SET_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->smf_set_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_association_setup_response(ogs_pfcp_association_setup_response_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->recovery_time_stamp.presence)
+        length += TLV_HLEN + 4;
+    if (ie->up_function_features.presence)
+        length += TLV_HLEN + ie->up_function_features.len;
+    if (ie->cp_function_features.presence)
+        length += TLV_HLEN + 1;
+    for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++)
+        length += TLV_HLEN + ie->user_plane_ip_resource_information[i].len;
+    if (ie->alternative_smf_ip_address.presence)
+        length += TLV_HLEN + ie->alternative_smf_ip_address.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_association_setup_response(uint8_t *pos, ogs_pfcp_association_setup_response_t *ie)
+{
+    int i;
+
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->recovery_time_stamp.presence)
+        pos = ogs_tlv_write_uint32(pos, TLV_MODE,
+                OGS_PFCP_RECOVERY_TIME_STAMP_TYPE, 0, &ie->recovery_time_stamp);
+    if (ie->up_function_features.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UP_FUNCTION_FEATURES_TYPE, 0, &ie->up_function_features);
+    if (ie->cp_function_features.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CP_FUNCTION_FEATURES_TYPE, 0, &ie->cp_function_features);
+    for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USER_PLANE_IP_RESOURCE_INFORMATION_TYPE, 0, &ie->user_plane_ip_resource_information[i]);
+    if (ie->alternative_smf_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE, 0, &ie->alternative_smf_ip_address);
+
+    return pos;
+}
+
+static int msg_read_pfcp_association_setup_response(ogs_pfcp_association_setup_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_RECOVERY_TIME_STAMP_TYPE:
+            if (ogs_tlv_read_uint32(&ie->recovery_time_stamp, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_octet(&ie->up_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cp_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_PLANE_IP_RESOURCE_INFORMATION_TYPE:
+            for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (ogs_tlv_read_octet(&ie->user_plane_ip_resource_information[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->alternative_smf_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_association_update_request(ogs_pfcp_association_update_request_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->up_function_features.presence)
+        length += TLV_HLEN + ie->up_function_features.len;
+    if (ie->cp_function_features.presence)
+        length += TLV_HLEN + 1;
+    if (ie->pfcp_association_release_request.presence)
+        length += TLV_HLEN + ie->pfcp_association_release_request.len;
+    if (ie->graceful_release_period.presence)
+        length += TLV_HLEN + ie->graceful_release_period.len;
+    for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++)
+        length += TLV_HLEN + ie->user_plane_ip_resource_information[i].len;
+    if (ie->pfcpaureq_flags.presence)
+        length += TLV_HLEN + 1;
+    if (ie->alternative_smf_ip_address.presence)
+        length += TLV_HLEN + ie->alternative_smf_ip_address.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_association_update_request(uint8_t *pos, ogs_pfcp_association_update_request_t *ie)
+{
+    int i;
+
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->up_function_features.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UP_FUNCTION_FEATURES_TYPE, 0, &ie->up_function_features);
+    if (ie->cp_function_features.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CP_FUNCTION_FEATURES_TYPE, 0, &ie->cp_function_features);
+    if (ie->pfcp_association_release_request.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE, 0, &ie->pfcp_association_release_request);
+    if (ie->graceful_release_period.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_GRACEFUL_RELEASE_PERIOD_TYPE, 0, &ie->graceful_release_period);
+    for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USER_PLANE_IP_RESOURCE_INFORMATION_TYPE, 0, &ie->user_plane_ip_resource_information[i]);
+    if (ie->pfcpaureq_flags.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PFCPAUREQ_FLAGS_TYPE, 0, &ie->pfcpaureq_flags);
+    if (ie->alternative_smf_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE, 0, &ie->alternative_smf_ip_address);
+
+    return pos;
+}
+
+static int msg_read_pfcp_association_update_request(ogs_pfcp_association_update_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_octet(&ie->up_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cp_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
+            if (ogs_tlv_read_octet(&ie->pfcp_association_release_request, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_GRACEFUL_RELEASE_PERIOD_TYPE:
+            if (ogs_tlv_read_octet(&ie->graceful_release_period, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_PLANE_IP_RESOURCE_INFORMATION_TYPE:
+            for (i = 0; i < 4 && ie->user_plane_ip_resource_information[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (ogs_tlv_read_octet(&ie->user_plane_ip_resource_information[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PFCPAUREQ_FLAGS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->pfcpaureq_flags, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->alternative_smf_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_association_update_response(ogs_pfcp_association_update_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->up_function_features.presence)
+        length += TLV_HLEN + ie->up_function_features.len;
+    if (ie->cp_function_features.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_association_update_response(uint8_t *pos, ogs_pfcp_association_update_response_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->up_function_features.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UP_FUNCTION_FEATURES_TYPE, 0, &ie->up_function_features);
+    if (ie->cp_function_features.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CP_FUNCTION_FEATURES_TYPE, 0, &ie->cp_function_features);
+
+    return pos;
+}
+
+static int msg_read_pfcp_association_update_response(ogs_pfcp_association_update_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_octet(&ie->up_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CP_FUNCTION_FEATURES_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cp_function_features, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_association_release_request(ogs_pfcp_association_release_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_association_release_request(uint8_t *pos, ogs_pfcp_association_release_request_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+
+    return pos;
+}
+
+static int msg_read_pfcp_association_release_request(ogs_pfcp_association_release_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_association_release_response(ogs_pfcp_association_release_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_association_release_response(uint8_t *pos, ogs_pfcp_association_release_response_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+
+    return pos;
+}
+
+static int msg_read_pfcp_association_release_response(ogs_pfcp_association_release_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_version_not_supported_response(ogs_pfcp_version_not_supported_response_t *ie)
+{
+    uint32_t length = 0;
+
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_version_not_supported_response(uint8_t *pos, ogs_pfcp_version_not_supported_response_t *ie)
+{
+    return pos;
+}
+
+static int msg_read_pfcp_version_not_supported_response(ogs_pfcp_version_not_supported_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_node_report_request(ogs_pfcp_node_report_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->node_report_type.presence)
+        length += TLV_HLEN + ie->node_report_type.len;
+    if (ie->user_plane_path_failure_report.presence)
+        length += TLV_HLEN + tlv_length_user_plane_path_failure_report(&ie->user_plane_path_failure_report);
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_node_report_request(uint8_t *pos, ogs_pfcp_node_report_request_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->node_report_type.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_REPORT_TYPE_TYPE, 0, &ie->node_report_type);
+    if (ie->user_plane_path_failure_report.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_USER_PLANE_PATH_FAILURE_REPORT_TYPE, 0,
+                tlv_write_user_plane_path_failure_report(pos + TLV_HLEN, &ie->user_plane_path_failure_report));
+
+    return pos;
+}
+
+static int msg_read_pfcp_node_report_request(ogs_pfcp_node_report_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_NODE_REPORT_TYPE_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_report_type, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_PLANE_PATH_FAILURE_REPORT_TYPE:
+            if (tlv_read_user_plane_path_failure_report(&ie->user_plane_path_failure_report, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->user_plane_path_failure_report.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_node_report_response(ogs_pfcp_node_report_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_node_report_response(uint8_t *pos, ogs_pfcp_node_report_response_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+
+    return pos;
+}
+
+static int msg_read_pfcp_node_report_response(ogs_pfcp_node_report_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_set_deletion_request(ogs_pfcp_session_set_deletion_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->sgw_c_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_c_fq_csid.len;
+    if (ie->pgw_c_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_c_fq_csid.len;
+    if (ie->sgw_u_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_u_fq_csid.len;
+    if (ie->pgw_u_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_u_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_set_deletion_request(uint8_t *pos, ogs_pfcp_session_set_deletion_request_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->sgw_c_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->sgw_c_fq_csid);
+    if (ie->pgw_c_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->pgw_c_fq_csid);
+    if (ie->sgw_u_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->sgw_u_fq_csid);
+    if (ie->pgw_u_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->pgw_u_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->twan_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->epdg_fq_csid);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_set_deletion_request(ogs_pfcp_session_set_deletion_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FQ_CSID_TYPE:
+            if (ogs_tlv_read_octet(&ie->sgw_c_fq_csid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_set_deletion_response(ogs_pfcp_session_set_deletion_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_set_deletion_response(uint8_t *pos, ogs_pfcp_session_set_deletion_response_t *ie)
+{
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_set_deletion_response(ogs_pfcp_session_set_deletion_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_establishment_request(ogs_pfcp_session_establishment_request_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cp_f_seid.presence)
+        length += TLV_HLEN + ie->cp_f_seid.len;
+    for (i = 0; i < 8 && ie->create_pdr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_pdr(&ie->create_pdr[i]);
+    for (i = 0; i < 8 && ie->create_far[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_far(&ie->create_far[i]);
+    for (i = 0; i < 2 && ie->create_urr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_urr(&ie->create_urr[i]);
+    for (i = 0; i < 4 && ie->create_qer[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_qer(&ie->create_qer[i]);
+    if (ie->create_bar.presence)
+        length += TLV_HLEN + tlv_length_create_bar(&ie->create_bar);
+    if (ie->create_traffic_endpoint.presence)
+        length += TLV_HLEN + tlv_length_create_traffic_endpoint(&ie->create_traffic_endpoint);
+    if (ie->pdn_type.presence)
+        length += TLV_HLEN + 1;
+    if (ie->sgw_c_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_c_fq_csid.len;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->pgw_c_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_c_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->user_plane_inactivity_timer.presence)
+        length += TLV_HLEN + ie->user_plane_inactivity_timer.len;
+    if (ie->user_id.presence)
+        length += TLV_HLEN + ie->user_id.len;
+    if (ie->trace_information.presence)
+        length += TLV_HLEN + ie->trace_information.len;
+    if (ie->apn_dnn.presence)
+        length += TLV_HLEN + ie->apn_dnn.len;
+    if (ie->create_mar.presence)
+        length += TLV_HLEN + tlv_length_create_mar(&ie->create_mar);
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_establishment_request(uint8_t *pos, ogs_pfcp_session_establishment_request_t *ie)
+{
+    int i;
+
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cp_f_seid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_SEID_TYPE, 0, &ie->cp_f_seid);
+    for (i = 0; i < 8 && ie->create_pdr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_PDR_TYPE, 0,
+                tlv_write_create_pdr(pos + TLV_HLEN, &ie->create_pdr[i]));
+    for (i = 0; i < 8 && ie->create_far[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_FAR_TYPE, 0,
+                tlv_write_create_far(pos + TLV_HLEN, &ie->create_far[i]));
+    for (i = 0; i < 2 && ie->create_urr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_URR_TYPE, 0,
+                tlv_write_create_urr(pos + TLV_HLEN, &ie->create_urr[i]));
+    for (i = 0; i < 4 && ie->create_qer[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_QER_TYPE, 0,
+                tlv_write_create_qer(pos + TLV_HLEN, &ie->create_qer[i]));
+    if (ie->create_bar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_BAR_TYPE, 0,
+                tlv_write_create_bar(pos + TLV_HLEN, &ie->create_bar));
+    if (ie->create_traffic_endpoint.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_TRAFFIC_ENDPOINT_TYPE, 0,
+                tlv_write_create_traffic_endpoint(pos + TLV_HLEN, &ie->create_traffic_endpoint));
+    if (ie->pdn_type.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PDN_TYPE_TYPE, 0, &ie->pdn_type);
+    if (ie->sgw_c_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->sgw_c_fq_csid);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->pgw_c_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->pgw_c_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->epdg_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->twan_fq_csid);
+    if (ie->user_plane_inactivity_timer.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USER_PLANE_INACTIVITY_TIMER_TYPE, 0, &ie->user_plane_inactivity_timer);
+    if (ie->user_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USER_ID_TYPE, 0, &ie->user_id);
+    if (ie->trace_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRACE_INFORMATION_TYPE, 0, &ie->trace_information);
+    if (ie->apn_dnn.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_APN_DNN_TYPE, 0, &ie->apn_dnn);
+    if (ie->create_mar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_MAR_TYPE, 0,
+                tlv_write_create_mar(pos + TLV_HLEN, &ie->create_mar));
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_establishment_request(ogs_pfcp_session_establishment_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_SEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->cp_f_seid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CREATE_PDR_TYPE:
+            for (i = 0; i < 8 && ie->create_pdr[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_pdr(&ie->create_pdr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_pdr[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_FAR_TYPE:
+            for (i = 0; i < 8 && ie->create_far[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_far(&ie->create_far[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_far[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_URR_TYPE:
+            for (i = 0; i < 2 && ie->create_urr[i].presence; i++);
+            if (i == 2) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_urr(&ie->create_urr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_urr[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_QER_TYPE:
+            for (i = 0; i < 4 && ie->create_qer[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_qer(&ie->create_qer[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_qer[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_BAR_TYPE:
+            if (tlv_read_create_bar(&ie->create_bar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_bar.presence = 1;
+            break;
+        case OGS_PFCP_CREATE_TRAFFIC_ENDPOINT_TYPE:
+            if (tlv_read_create_traffic_endpoint(&ie->create_traffic_endpoint, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_traffic_endpoint.presence = 1;
+            break;
+        case OGS_PFCP_PDN_TYPE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->pdn_type, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FQ_CSID_TYPE:
+            if (ogs_tlv_read_octet(&ie->sgw_c_fq_csid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_PLANE_INACTIVITY_TIMER_TYPE:
+            if (ogs_tlv_read_octet(&ie->user_plane_inactivity_timer, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->user_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TRACE_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->trace_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_APN_DNN_TYPE:
+            if (ogs_tlv_read_octet(&ie->apn_dnn, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CREATE_MAR_TYPE:
+            if (tlv_read_create_mar(&ie->create_mar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_mar.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_establishment_response(ogs_pfcp_session_establishment_response_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+    if (ie->up_f_seid.presence)
+        length += TLV_HLEN + ie->up_f_seid.len;
+    for (i = 0; i < 8 && ie->created_pdr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_created_pdr(&ie->created_pdr[i]);
+    if (ie->load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->load_control_information);
+    if (ie->overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->overload_control_information);
+    if (ie->sgw_u_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_u_fq_csid.len;
+    if (ie->pgw_u_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_u_fq_csid.len;
+    if (ie->failed_rule_id.presence)
+        length += TLV_HLEN + ie->failed_rule_id.len;
+    if (ie->created_traffic_endpoint.presence)
+        length += TLV_HLEN + tlv_length_created_traffic_endpoint(&ie->created_traffic_endpoint);
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_establishment_response(uint8_t *pos, ogs_pfcp_session_establishment_response_t *ie)
+{
+    int i;
+
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+    if (ie->up_f_seid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_SEID_TYPE, 0, &ie->up_f_seid);
+    for (i = 0; i < 8 && ie->created_pdr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATED_PDR_TYPE, 0,
+                tlv_write_created_pdr(pos + TLV_HLEN, &ie->created_pdr[i]));
+    if (ie->load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->load_control_information));
+    if (ie->overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->overload_control_information));
+    if (ie->sgw_u_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->sgw_u_fq_csid);
+    if (ie->pgw_u_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->pgw_u_fq_csid);
+    if (ie->failed_rule_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FAILED_RULE_ID_TYPE, 0, &ie->failed_rule_id);
+    if (ie->created_traffic_endpoint.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATED_TRAFFIC_ENDPOINT_TYPE, 0,
+                tlv_write_created_traffic_endpoint(pos + TLV_HLEN, &ie->created_traffic_endpoint));
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_establishment_response(ogs_pfcp_session_establishment_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_SEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->up_f_seid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CREATED_PDR_TYPE:
+            for (i = 0; i < 8 && ie->created_pdr[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_created_pdr(&ie->created_pdr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->created_pdr[i].presence = 1;
+            break;
+        case OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_load_control_information(&ie->load_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->load_control_information.presence = 1;
+            break;
+        case OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_overload_control_information(&ie->overload_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->overload_control_information.presence = 1;
+            break;
+        case OGS_PFCP_FQ_CSID_TYPE:
+            if (ogs_tlv_read_octet(&ie->sgw_u_fq_csid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_FAILED_RULE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->failed_rule_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CREATED_TRAFFIC_ENDPOINT_TYPE:
+            if (tlv_read_created_traffic_endpoint(&ie->created_traffic_endpoint, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->created_traffic_endpoint.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_modification_request(ogs_pfcp_session_modification_request_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->cp_f_seid.presence)
+        length += TLV_HLEN + ie->cp_f_seid.len;
+    for (i = 0; i < 8 && ie->remove_pdr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_remove_pdr(&ie->remove_pdr[i]);
+    for (i = 0; i < 8 && ie->remove_far[i].presence; i++)
+        length += TLV_HLEN + tlv_length_remove_far(&ie->remove_far[i]);
+    for (i = 0; i < 2 && ie->remove_urr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_remove_urr(&ie->remove_urr[i]);
+    for (i = 0; i < 4 && ie->remove_qer[i].presence; i++)
+        length += TLV_HLEN + tlv_length_remove_qer(&ie->remove_qer[i]);
+    if (ie->remove_bar.presence)
+        length += TLV_HLEN + tlv_length_remove_bar(&ie->remove_bar);
+    if (ie->remove_traffic_endpoint.presence)
+        length += TLV_HLEN + tlv_length_remove_traffic_endpoint(&ie->remove_traffic_endpoint);
+    for (i = 0; i < 8 && ie->create_pdr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_pdr(&ie->create_pdr[i]);
+    for (i = 0; i < 8 && ie->create_far[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_far(&ie->create_far[i]);
+    for (i = 0; i < 2 && ie->create_urr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_urr(&ie->create_urr[i]);
+    for (i = 0; i < 4 && ie->create_qer[i].presence; i++)
+        length += TLV_HLEN + tlv_length_create_qer(&ie->create_qer[i]);
+    if (ie->create_bar.presence)
+        length += TLV_HLEN + tlv_length_create_bar(&ie->create_bar);
+    if (ie->create_traffic_endpoint.presence)
+        length += TLV_HLEN + tlv_length_create_traffic_endpoint(&ie->create_traffic_endpoint);
+    for (i = 0; i < 8 && ie->update_pdr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_update_pdr(&ie->update_pdr[i]);
+    for (i = 0; i < 8 && ie->update_far[i].presence; i++)
+        length += TLV_HLEN + tlv_length_update_far(&ie->update_far[i]);
+    for (i = 0; i < 2 && ie->update_urr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_update_urr(&ie->update_urr[i]);
+    for (i = 0; i < 4 && ie->update_qer[i].presence; i++)
+        length += TLV_HLEN + tlv_length_update_qer(&ie->update_qer[i]);
+    if (ie->update_bar.presence)
+        length += TLV_HLEN + tlv_length_update_bar_session_modification_request(&ie->update_bar);
+    if (ie->update_traffic_endpoint.presence)
+        length += TLV_HLEN + ie->update_traffic_endpoint.len;
+    if (ie->pfcpsmreq_flags.presence)
+        length += TLV_HLEN + 1;
+    if (ie->query_urr.presence)
+        length += TLV_HLEN + tlv_length_query_urr(&ie->query_urr);
+    if (ie->pgw_c_fq_csid.presence)
+        length += TLV_HLEN + ie->pgw_c_fq_csid.len;
+    if (ie->sgw_c_fq_csid.presence)
+        length += TLV_HLEN + ie->sgw_c_fq_csid.len;
+    if (ie->mme_fq_csid.presence)
+        length += TLV_HLEN + ie->mme_fq_csid.len;
+    if (ie->epdg_fq_csid.presence)
+        length += TLV_HLEN + ie->epdg_fq_csid.len;
+    if (ie->twan_fq_csid.presence)
+        length += TLV_HLEN + ie->twan_fq_csid.len;
+    if (ie->user_plane_inactivity_timer.presence)
+        length += TLV_HLEN + ie->user_plane_inactivity_timer.len;
+    if (ie->query_urr_reference.presence)
+        length += TLV_HLEN + ie->query_urr_reference.len;
+    if (ie->trace_information.presence)
+        length += TLV_HLEN + ie->trace_information.len;
+    if (ie->remove_mar.presence)
+        length += TLV_HLEN + tlv_length_remove_mar(&ie->remove_mar);
+    if (ie->update_mar.presence)
+        length += TLV_HLEN + tlv_length_update_mar(&ie->update_mar);
+    if (ie->create_mar.presence)
+        length += TLV_HLEN + tlv_length_create_mar(&ie->create_mar);
+    if (ie->node_id.presence)
+        length += TLV_HLEN + ie->node_id.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_modification_request(uint8_t *pos, ogs_pfcp_session_modification_request_t *ie)
+{
+    int i;
+
+    if (ie->cp_f_seid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_SEID_TYPE, 0, &ie->cp_f_seid);
+    for (i = 0; i < 8 && ie->remove_pdr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_PDR_TYPE, 0,
+                tlv_write_remove_pdr(pos + TLV_HLEN, &ie->remove_pdr[i]));
+    for (i = 0; i < 8 && ie->remove_far[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_FAR_TYPE, 0,
+                tlv_write_remove_far(pos + TLV_HLEN, &ie->remove_far[i]));
+    for (i = 0; i < 2 && ie->remove_urr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_URR_TYPE, 0,
+                tlv_write_remove_urr(pos + TLV_HLEN, &ie->remove_urr[i]));
+    for (i = 0; i < 4 && ie->remove_qer[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_QER_TYPE, 0,
+                tlv_write_remove_qer(pos + TLV_HLEN, &ie->remove_qer[i]));
+    if (ie->remove_bar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_BAR_TYPE, 0,
+                tlv_write_remove_bar(pos + TLV_HLEN, &ie->remove_bar));
+    if (ie->remove_traffic_endpoint.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_TRAFFIC_ENDPOINT_TYPE, 0,
+                tlv_write_remove_traffic_endpoint(pos + TLV_HLEN, &ie->remove_traffic_endpoint));
+    for (i = 0; i < 8 && ie->create_pdr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_PDR_TYPE, 0,
+                tlv_write_create_pdr(pos + TLV_HLEN, &ie->create_pdr[i]));
+    for (i = 0; i < 8 && ie->create_far[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_FAR_TYPE, 0,
+                tlv_write_create_far(pos + TLV_HLEN, &ie->create_far[i]));
+    for (i = 0; i < 2 && ie->create_urr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_URR_TYPE, 0,
+                tlv_write_create_urr(pos + TLV_HLEN, &ie->create_urr[i]));
+    for (i = 0; i < 4 && ie->create_qer[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_QER_TYPE, 0,
+                tlv_write_create_qer(pos + TLV_HLEN, &ie->create_qer[i]));
+    if (ie->create_bar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_BAR_TYPE, 0,
+                tlv_write_create_bar(pos + TLV_HLEN, &ie->create_bar));
+    if (ie->create_traffic_endpoint.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_TRAFFIC_ENDPOINT_TYPE, 0,
+                tlv_write_create_traffic_endpoint(pos + TLV_HLEN, &ie->create_traffic_endpoint));
+    for (i = 0; i < 8 && ie->update_pdr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_PDR_TYPE, 0,
+                tlv_write_update_pdr(pos + TLV_HLEN, &ie->update_pdr[i]));
+    for (i = 0; i < 8 && ie->update_far[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_FAR_TYPE, 0,
+                tlv_write_update_far(pos + TLV_HLEN, &ie->update_far[i]));
+    for (i = 0; i < 2 && ie->update_urr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_URR_TYPE, 0,
+                tlv_write_update_urr(pos + TLV_HLEN, &ie->update_urr[i]));
+    for (i = 0; i < 4 && ie->update_qer[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_QER_TYPE, 0,
+                tlv_write_update_qer(pos + TLV_HLEN, &ie->update_qer[i]));
+    if (ie->update_bar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_BAR_SESSION_MODIFICATION_REQUEST_TYPE, 0,
+                tlv_write_update_bar_session_modification_request(pos + TLV_HLEN, &ie->update_bar));
+    if (ie->update_traffic_endpoint.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_TRAFFIC_ENDPOINT_TYPE, 0, &ie->update_traffic_endpoint);
+    if (ie->pfcpsmreq_flags.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PFCPSMREQ_FLAGS_TYPE, 0, &ie->pfcpsmreq_flags);
+    if (ie->query_urr.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_QUERY_URR_TYPE, 0,
+                tlv_write_query_urr(pos + TLV_HLEN, &ie->query_urr));
+    if (ie->pgw_c_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->pgw_c_fq_csid);
+    if (ie->sgw_c_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->sgw_c_fq_csid);
+    if (ie->mme_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->mme_fq_csid);
+    if (ie->epdg_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->epdg_fq_csid);
+    if (ie->twan_fq_csid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FQ_CSID_TYPE, 0, &ie->twan_fq_csid);
+    if (ie->user_plane_inactivity_timer.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_USER_PLANE_INACTIVITY_TIMER_TYPE, 0, &ie->user_plane_inactivity_timer);
+    if (ie->query_urr_reference.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_QUERY_URR_REFERENCE_TYPE, 0, &ie->query_urr_reference);
+    if (ie->trace_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_TRACE_INFORMATION_TYPE, 0, &ie->trace_information);
+    if (ie->remove_mar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_REMOVE_MAR_TYPE, 0,
+                tlv_write_remove_mar(pos + TLV_HLEN, &ie->remove_mar));
+    if (ie->update_mar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_MAR_TYPE, 0,
+                tlv_write_update_mar(pos + TLV_HLEN, &ie->update_mar));
+    if (ie->create_mar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATE_MAR_TYPE, 0,
+                tlv_write_create_mar(pos + TLV_HLEN, &ie->create_mar));
+    if (ie->node_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_NODE_ID_TYPE, 0, &ie->node_id);
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_modification_request(ogs_pfcp_session_modification_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_F_SEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->cp_f_seid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_REMOVE_PDR_TYPE:
+            for (i = 0; i < 8 && ie->remove_pdr[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_remove_pdr(&ie->remove_pdr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_pdr[i].presence = 1;
+            break;
+        case OGS_PFCP_REMOVE_FAR_TYPE:
+            for (i = 0; i < 8 && ie->remove_far[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_remove_far(&ie->remove_far[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_far[i].presence = 1;
+            break;
+        case OGS_PFCP_REMOVE_URR_TYPE:
+            for (i = 0; i < 2 && ie->remove_urr[i].presence; i++);
+            if (i == 2) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_remove_urr(&ie->remove_urr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_urr[i].presence = 1;
+            break;
+        case OGS_PFCP_REMOVE_QER_TYPE:
+            for (i = 0; i < 4 && ie->remove_qer[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_remove_qer(&ie->remove_qer[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_qer[i].presence = 1;
+            break;
+        case OGS_PFCP_REMOVE_BAR_TYPE:
+            if (tlv_read_remove_bar(&ie->remove_bar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_bar.presence = 1;
+            break;
+        case OGS_PFCP_REMOVE_TRAFFIC_ENDPOINT_TYPE:
+            if (tlv_read_remove_traffic_endpoint(&ie->remove_traffic_endpoint, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_traffic_endpoint.presence = 1;
+            break;
+        case OGS_PFCP_CREATE_PDR_TYPE:
+            for (i = 0; i < 8 && ie->create_pdr[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_pdr(&ie->create_pdr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_pdr[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_FAR_TYPE:
+            for (i = 0; i < 8 && ie->create_far[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_far(&ie->create_far[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_far[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_URR_TYPE:
+            for (i = 0; i < 2 && ie->create_urr[i].presence; i++);
+            if (i == 2) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_urr(&ie->create_urr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_urr[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_QER_TYPE:
+            for (i = 0; i < 4 && ie->create_qer[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_create_qer(&ie->create_qer[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_qer[i].presence = 1;
+            break;
+        case OGS_PFCP_CREATE_BAR_TYPE:
+            if (tlv_read_create_bar(&ie->create_bar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_bar.presence = 1;
+            break;
+        case OGS_PFCP_CREATE_TRAFFIC_ENDPOINT_TYPE:
+            if (tlv_read_create_traffic_endpoint(&ie->create_traffic_endpoint, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_traffic_endpoint.presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_PDR_TYPE:
+            for (i = 0; i < 8 && ie->update_pdr[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_update_pdr(&ie->update_pdr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_pdr[i].presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_FAR_TYPE:
+            for (i = 0; i < 8 && ie->update_far[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_update_far(&ie->update_far[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_far[i].presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_URR_TYPE:
+            for (i = 0; i < 2 && ie->update_urr[i].presence; i++);
+            if (i == 2) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_update_urr(&ie->update_urr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_urr[i].presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_QER_TYPE:
+            for (i = 0; i < 4 && ie->update_qer[i].presence; i++);
+            if (i == 4) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_update_qer(&ie->update_qer[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_qer[i].presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_BAR_SESSION_MODIFICATION_REQUEST_TYPE:
+            if (tlv_read_update_bar_session_modification_request(&ie->update_bar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_bar.presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_TRAFFIC_ENDPOINT_TYPE:
+            if (ogs_tlv_read_octet(&ie->update_traffic_endpoint, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PFCPSMREQ_FLAGS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->pfcpsmreq_flags, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUERY_URR_TYPE:
+            if (tlv_read_query_urr(&ie->query_urr, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->query_urr.presence = 1;
+            break;
+        case OGS_PFCP_FQ_CSID_TYPE:
+            if (ogs_tlv_read_octet(&ie->pgw_c_fq_csid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_USER_PLANE_INACTIVITY_TIMER_TYPE:
+            if (ogs_tlv_read_octet(&ie->user_plane_inactivity_timer, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_QUERY_URR_REFERENCE_TYPE:
+            if (ogs_tlv_read_octet(&ie->query_urr_reference, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_TRACE_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->trace_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_REMOVE_MAR_TYPE:
+            if (tlv_read_remove_mar(&ie->remove_mar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->remove_mar.presence = 1;
+            break;
+        case OGS_PFCP_UPDATE_MAR_TYPE:
+            if (tlv_read_update_mar(&ie->update_mar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_mar.presence = 1;
+            break;
+        case OGS_PFCP_CREATE_MAR_TYPE:
+            if (tlv_read_create_mar(&ie->create_mar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->create_mar.presence = 1;
+            break;
+        case OGS_PFCP_NODE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->node_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_modification_response(ogs_pfcp_session_modification_response_t *ie)
+{
+    uint32_t length = 0;
+    int i;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+    for (i = 0; i < 8 && ie->created_pdr[i].presence; i++)
+        length += TLV_HLEN + tlv_length_created_pdr(&ie->created_pdr[i]);
+    if (ie->load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->load_control_information);
+    if (ie->overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->overload_control_information);
+    if (ie->usage_report.presence)
+        length += TLV_HLEN + tlv_length_usage_report_session_modification_response(&ie->usage_report);
+    if (ie->failed_rule_id.presence)
+        length += TLV_HLEN + ie->failed_rule_id.len;
+    if (ie->additional_usage_reports_information.presence)
+        length += TLV_HLEN + ie->additional_usage_reports_information.len;
+    if (ie->created_updated_traffic_endpoint.presence)
+        length += TLV_HLEN + tlv_length_created_traffic_endpoint(&ie->created_updated_traffic_endpoint);
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_modification_response(uint8_t *pos, ogs_pfcp_session_modification_response_t *ie)
+{
+    int i;
+
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+    for (i = 0; i < 8 && ie->created_pdr[i].presence; i++)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATED_PDR_TYPE, 0,
+                tlv_write_created_pdr(pos + TLV_HLEN, &ie->created_pdr[i]));
+    if (ie->load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->load_control_information));
+    if (ie->overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->overload_control_information));
+    if (ie->usage_report.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_USAGE_REPORT_SESSION_MODIFICATION_RESPONSE_TYPE, 0,
+                tlv_write_usage_report_session_modification_response(pos + TLV_HLEN, &ie->usage_report));
+    if (ie->failed_rule_id.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_FAILED_RULE_ID_TYPE, 0, &ie->failed_rule_id);
+    if (ie->additional_usage_reports_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ADDITIONAL_USAGE_REPORTS_INFORMATION_TYPE, 0, &ie->additional_usage_reports_information);
+    if (ie->created_updated_traffic_endpoint.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_CREATED_TRAFFIC_ENDPOINT_TYPE, 0,
+                tlv_write_created_traffic_endpoint(pos + TLV_HLEN, &ie->created_updated_traffic_endpoint));
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_modification_response(ogs_pfcp_session_modification_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+    int i;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CREATED_PDR_TYPE:
+            for (i = 0; i < 8 && ie->created_pdr[i].presence; i++);
+            if (i == 8) {
+                ogs_fatal("Multiple of the same type TLV need more room");
+                ogs_assert_if_reached();
+                break;
+            }
+            if (tlv_read_created_pdr(&ie->created_pdr[i], pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->created_pdr[i].presence = 1;
+            break;
+        case OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_load_control_information(&ie->load_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->load_control_information.presence = 1;
+            break;
+        case OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_overload_control_information(&ie->overload_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->overload_control_information.presence = 1;
+            break;
+        case OGS_PFCP_USAGE_REPORT_SESSION_MODIFICATION_RESPONSE_TYPE:
+            if (tlv_read_usage_report_session_modification_response(&ie->usage_report, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->usage_report.presence = 1;
+            break;
+        case OGS_PFCP_FAILED_RULE_ID_TYPE:
+            if (ogs_tlv_read_octet(&ie->failed_rule_id, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ADDITIONAL_USAGE_REPORTS_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->additional_usage_reports_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_CREATED_TRAFFIC_ENDPOINT_TYPE:
+            if (tlv_read_created_traffic_endpoint(&ie->created_updated_traffic_endpoint, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->created_updated_traffic_endpoint.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_deletion_request(ogs_pfcp_session_deletion_request_t *ie)
+{
+    uint32_t length = 0;
+
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_deletion_request(uint8_t *pos, ogs_pfcp_session_deletion_request_t *ie)
+{
+    return pos;
+}
+
+static int msg_read_pfcp_session_deletion_request(ogs_pfcp_session_deletion_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_deletion_response(ogs_pfcp_session_deletion_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+    if (ie->load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->load_control_information);
+    if (ie->overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->overload_control_information);
+    if (ie->usage_report.presence)
+        length += TLV_HLEN + tlv_length_usage_report_session_deletion_response(&ie->usage_report);
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_deletion_response(uint8_t *pos, ogs_pfcp_session_deletion_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+    if (ie->load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->load_control_information));
+    if (ie->overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->overload_control_information));
+    if (ie->usage_report.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_USAGE_REPORT_SESSION_DELETION_RESPONSE_TYPE, 0,
+                tlv_write_usage_report_session_deletion_response(pos + TLV_HLEN, &ie->usage_report));
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_deletion_response(ogs_pfcp_session_deletion_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_load_control_information(&ie->load_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->load_control_information.presence = 1;
+            break;
+        case OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_overload_control_information(&ie->overload_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->overload_control_information.presence = 1;
+            break;
+        case OGS_PFCP_USAGE_REPORT_SESSION_DELETION_RESPONSE_TYPE:
+            if (tlv_read_usage_report_session_deletion_response(&ie->usage_report, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->usage_report.presence = 1;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_report_request(ogs_pfcp_session_report_request_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->report_type.presence)
+        length += TLV_HLEN + 1;
+    if (ie->downlink_data_report.presence)
+        length += TLV_HLEN + tlv_length_downlink_data_report(&ie->downlink_data_report);
+    if (ie->usage_report.presence)
+        length += TLV_HLEN + tlv_length_usage_report_session_report_request(&ie->usage_report);
+    if (ie->error_indication_report.presence)
+        length += TLV_HLEN + tlv_length_error_indication_report(&ie->error_indication_report);
+    if (ie->load_control_information.presence)
+        length += TLV_HLEN + tlv_length_load_control_information(&ie->load_control_information);
+    if (ie->overload_control_information.presence)
+        length += TLV_HLEN + tlv_length_overload_control_information(&ie->overload_control_information);
+    if (ie->additional_usage_reports_information.presence)
+        length += TLV_HLEN + ie->additional_usage_reports_information.len;
+    if (ie->pfcpsrreq_flags.presence)
+        length += TLV_HLEN + 1;
+    if (ie->old_cp_f_seid.presence)
+        length += TLV_HLEN + ie->old_cp_f_seid.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_report_request(uint8_t *pos, ogs_pfcp_session_report_request_t *ie)
+{
+    if (ie->report_type.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_REPORT_TYPE_TYPE, 0, &ie->report_type);
+    if (ie->downlink_data_report.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_DOWNLINK_DATA_REPORT_TYPE, 0,
+                tlv_write_downlink_data_report(pos + TLV_HLEN, &ie->downlink_data_report));
+    if (ie->usage_report.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_USAGE_REPORT_SESSION_REPORT_REQUEST_TYPE, 0,
+                tlv_write_usage_report_session_report_request(pos + TLV_HLEN, &ie->usage_report));
+    if (ie->error_indication_report.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_ERROR_INDICATION_REPORT_TYPE, 0,
+                tlv_write_error_indication_report(pos + TLV_HLEN, &ie->error_indication_report));
+    if (ie->load_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_load_control_information(pos + TLV_HLEN, &ie->load_control_information));
+    if (ie->overload_control_information.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE, 0,
+                tlv_write_overload_control_information(pos + TLV_HLEN, &ie->overload_control_information));
+    if (ie->additional_usage_reports_information.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ADDITIONAL_USAGE_REPORTS_INFORMATION_TYPE, 0, &ie->additional_usage_reports_information);
+    if (ie->pfcpsrreq_flags.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PFCPSRREQ_FLAGS_TYPE, 0, &ie->pfcpsrreq_flags);
+    if (ie->old_cp_f_seid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_SEID_TYPE, 0, &ie->old_cp_f_seid);
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_report_request(ogs_pfcp_session_report_request_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_REPORT_TYPE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->report_type, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_DOWNLINK_DATA_REPORT_TYPE:
+            if (tlv_read_downlink_data_report(&ie->downlink_data_report, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->downlink_data_report.presence = 1;
+            break;
+        case OGS_PFCP_USAGE_REPORT_SESSION_REPORT_REQUEST_TYPE:
+            if (tlv_read_usage_report_session_report_request(&ie->usage_report, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->usage_report.presence = 1;
+            break;
+        case OGS_PFCP_ERROR_INDICATION_REPORT_TYPE:
+            if (tlv_read_error_indication_report(&ie->error_indication_report, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->error_indication_report.presence = 1;
+            break;
+        case OGS_PFCP_LOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_load_control_information(&ie->load_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->load_control_information.presence = 1;
+            break;
+        case OGS_PFCP_OVERLOAD_CONTROL_INFORMATION_TYPE:
+            if (tlv_read_overload_control_information(&ie->overload_control_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->overload_control_information.presence = 1;
+            break;
+        case OGS_PFCP_ADDITIONAL_USAGE_REPORTS_INFORMATION_TYPE:
+            if (ogs_tlv_read_octet(&ie->additional_usage_reports_information, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_PFCPSRREQ_FLAGS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->pfcpsrreq_flags, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_SEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->old_cp_f_seid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+static uint32_t msg_length_pfcp_session_report_response(ogs_pfcp_session_report_response_t *ie)
+{
+    uint32_t length = 0;
+
+    if (ie->cause.presence)
+        length += TLV_HLEN + 1;
+    if (ie->offending_ie.presence)
+        length += TLV_HLEN + 2;
+    if (ie->update_bar.presence)
+        length += TLV_HLEN + tlv_length_update_bar_pfcp_session_report_response(&ie->update_bar);
+    if (ie->pfcpsrrsp_flags.presence)
+        length += TLV_HLEN + 1;
+    if (ie->cp_f_seid.presence)
+        length += TLV_HLEN + ie->cp_f_seid.len;
+    if (ie->n4_u_f_teid.presence)
+        length += TLV_HLEN + ie->n4_u_f_teid.len;
+    if (ie->alternative_smf_ip_address.presence)
+        length += TLV_HLEN + ie->alternative_smf_ip_address.len;
+
+    return length;
+}
+
+static uint8_t *msg_write_pfcp_session_report_response(uint8_t *pos, ogs_pfcp_session_report_response_t *ie)
+{
+    if (ie->cause.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_CAUSE_TYPE, 0, &ie->cause);
+    if (ie->offending_ie.presence)
+        pos = ogs_tlv_write_uint16(pos, TLV_MODE,
+                OGS_PFCP_OFFENDING_IE_TYPE, 0, &ie->offending_ie);
+    if (ie->update_bar.presence)
+        pos = ogs_tlv_write_group(pos, TLV_MODE,
+                OGS_PFCP_UPDATE_BAR_PFCP_SESSION_REPORT_RESPONSE_TYPE, 0,
+                tlv_write_update_bar_pfcp_session_report_response(pos + TLV_HLEN, &ie->update_bar));
+    if (ie->pfcpsrrsp_flags.presence)
+        pos = ogs_tlv_write_uint8(pos, TLV_MODE,
+                OGS_PFCP_PFCPSRRSP_FLAGS_TYPE, 0, &ie->pfcpsrrsp_flags);
+    if (ie->cp_f_seid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_SEID_TYPE, 0, &ie->cp_f_seid);
+    if (ie->n4_u_f_teid.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_F_TEID_TYPE, 0, &ie->n4_u_f_teid);
+    if (ie->alternative_smf_ip_address.presence)
+        pos = ogs_tlv_write_octet(pos, TLV_MODE,
+                OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE, 0, &ie->alternative_smf_ip_address);
+
+    return pos;
+}
+
+static int msg_read_pfcp_session_report_response(ogs_pfcp_session_report_response_t *ie, uint8_t *pos, uint32_t length)
+{
+    uint8_t *end = pos + length;
+    uint16_t type, len;
+    uint8_t instance;
+
+    while (pos < end) {
+        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);
+        if (!pos)
+            return OGS_ERROR;
+
+        switch (type) {
+        case OGS_PFCP_CAUSE_TYPE:
+            if (ogs_tlv_read_uint8(&ie->cause, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_OFFENDING_IE_TYPE:
+            if (ogs_tlv_read_uint16(&ie->offending_ie, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_UPDATE_BAR_PFCP_SESSION_REPORT_RESPONSE_TYPE:
+            if (tlv_read_update_bar_pfcp_session_report_response(&ie->update_bar, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            ie->update_bar.presence = 1;
+            break;
+        case OGS_PFCP_PFCPSRRSP_FLAGS_TYPE:
+            if (ogs_tlv_read_uint8(&ie->pfcpsrrsp_flags, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_SEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->cp_f_seid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_F_TEID_TYPE:
+            if (ogs_tlv_read_octet(&ie->n4_u_f_teid, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        case OGS_PFCP_ALTERNATIVE_SMF_IP_ADDRESS_TYPE:
+            if (ogs_tlv_read_octet(&ie->alternative_smf_ip_address, pos, len) != OGS_OK)
+                return OGS_ERROR;
+            break;
+        default:
+            ogs_warn("Unknown TLV type [%d]", type);
+            break;
+        }
+
+        pos += len;
+    }
+
+    return OGS_OK;
+}
+
+int ogs_pfcp_parse_msg(ogs_pfcp_message_t *pfcp_message, ogs_pkbuf_t *pkbuf)
+{
+    int rv = OGS_ERROR;
+    ogs_pfcp_header_t *h = NULL;
+    uint16_t size = 0;
+
+    ogs_assert(pfcp_message);
+    ogs_assert(pkbuf);
+    ogs_assert(pkbuf->len);
+
+    h = (ogs_pfcp_header_t *)pkbuf->data;
+    ogs_assert(h);
+    
+    memset(pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+
+    if (h->seid_presence)
+        size = OGS_PFCP_HEADER_LEN;
+    else
+        size = OGS_PFCP_HEADER_LEN-OGS_PFCP_SEID_LEN;
+
+    ogs_assert(ogs_pkbuf_pull(pkbuf, size));
+    memcpy(&pfcp_message->h, pkbuf->data - size, size);
+
+    if (h->seid_presence) {
+        pfcp_message->h.seid = be64toh(pfcp_message->h.seid);
+    } else {
+        pfcp_message->h.sqn = pfcp_message->h.sqn_only;
+        pfcp_message->h.sqn_only = pfcp_message->h.sqn_only;
+    }
+
+    if (pkbuf->len == 0)
+        return OGS_OK;
+
+    switch(pfcp_message->h.type)
+    {
+        case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
+            rv = msg_read_pfcp_heartbeat_request(&pfcp_message->pfcp_heartbeat_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_HEARTBEAT_RESPONSE_TYPE:
+            rv = msg_read_pfcp_heartbeat_response(&pfcp_message->pfcp_heartbeat_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_PFD_MANAGEMENT_REQUEST_TYPE:
+            rv = msg_read_pfcp_pfd_management_request(&pfcp_message->pfcp_pfd_management_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_PFD_MANAGEMENT_RESPONSE_TYPE:
+            rv = msg_read_pfcp_pfd_management_response(&pfcp_message->pfcp_pfd_management_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
+            rv = msg_read_pfcp_association_setup_request(&pfcp_message->pfcp_association_setup_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_ASSOCIATION_SETUP_RESPONSE_TYPE:
+            rv = msg_read_pfcp_association_setup_response(&pfcp_message->pfcp_association_setup_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_ASSOCIATION_UPDATE_REQUEST_TYPE:
+            rv = msg_read_pfcp_association_update_request(&pfcp_message->pfcp_association_update_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_ASSOCIATION_UPDATE_RESPONSE_TYPE:
+            rv = msg_read_pfcp_association_update_response(&pfcp_message->pfcp_association_update_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
+            rv = msg_read_pfcp_association_release_request(&pfcp_message->pfcp_association_release_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_ASSOCIATION_RELEASE_RESPONSE_TYPE:
+            rv = msg_read_pfcp_association_release_response(&pfcp_message->pfcp_association_release_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_VERSION_NOT_SUPPORTED_RESPONSE_TYPE:
+            rv = msg_read_pfcp_version_not_supported_response(&pfcp_message->pfcp_version_not_supported_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            rv = msg_read_pfcp_node_report_request(&pfcp_message->pfcp_node_report_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
+            rv = msg_read_pfcp_node_report_response(&pfcp_message->pfcp_node_report_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_SET_DELETION_REQUEST_TYPE:
+            rv = msg_read_pfcp_session_set_deletion_request(&pfcp_message->pfcp_session_set_deletion_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_SET_DELETION_RESPONSE_TYPE:
+            rv = msg_read_pfcp_session_set_deletion_response(&pfcp_message->pfcp_session_set_deletion_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE:
+            rv = msg_read_pfcp_session_establishment_request(&pfcp_message->pfcp_session_establishment_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
+            rv = msg_read_pfcp_session_establishment_response(&pfcp_message->pfcp_session_establishment_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_REQUEST_TYPE:
+            rv = msg_read_pfcp_session_modification_request(&pfcp_message->pfcp_session_modification_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
+            rv = msg_read_pfcp_session_modification_response(&pfcp_message->pfcp_session_modification_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_DELETION_REQUEST_TYPE:
+            rv = msg_read_pfcp_session_deletion_request(&pfcp_message->pfcp_session_deletion_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
+            rv = msg_read_pfcp_session_deletion_response(&pfcp_message->pfcp_session_deletion_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
+            rv = msg_read_pfcp_session_report_request(&pfcp_message->pfcp_session_report_request,
+                    pkbuf->data, pkbuf->len);
+            break;
+        case OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE:
+            rv = msg_read_pfcp_session_report_response(&pfcp_message->pfcp_session_report_response,
+                    pkbuf->data, pkbuf->len);
+            break;
+        default:
+            ogs_warn("Not implmeneted(type:%d)", pfcp_message->h.type);
+            break;
+    }
+
+    return rv;
+}
+
+ogs_pkbuf_t *ogs_pfcp_build_msg(ogs_pfcp_message_t *pfcp_message)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+    uint8_t *pos = NULL;
+    uint32_t length = 0;
+
+    ogs_assert(pfcp_message);
+    switch(pfcp_message->h.type)
+    {
+        case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
+            length = msg_length_pfcp_heartbeat_request(
+                    &pfcp_message->pfcp_heartbeat_request);
+            break;
+        case OGS_PFCP_HEARTBEAT_RESPONSE_TYPE:
+            length = msg_length_pfcp_heartbeat_response(
+                    &pfcp_message->pfcp_heartbeat_response);
+            break;
+        case OGS_PFCP_PFD_MANAGEMENT_REQUEST_TYPE:
+            length = msg_length_pfcp_pfd_management_request(
+                    &pfcp_message->pfcp_pfd_management_request);
+            break;
+        case OGS_PFCP_PFD_MANAGEMENT_RESPONSE_TYPE:
+            length = msg_length_pfcp_pfd_management_response(
+                    &pfcp_message->pfcp_pfd_management_response);
+            break;
+        case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
+            length = msg_length_pfcp_association_setup_request(
+                    &pfcp_message->pfcp_association_setup_request);
+            break;
+        case OGS_PFCP_ASSOCIATION_SETUP_RESPONSE_TYPE:
+            length = msg_length_pfcp_association_setup_response(
+                    &pfcp_message->pfcp_association_setup_response);
+            break;
+        case OGS_PFCP_ASSOCIATION_UPDATE_REQUEST_TYPE:
+            length = msg_length_pfcp_association_update_request(
+                    &pfcp_message->pfcp_association_update_request);
+            break;
+        case OGS_PFCP_ASSOCIATION_UPDATE_RESPONSE_TYPE:
+            length = msg_length_pfcp_association_update_response(
+                    &pfcp_message->pfcp_association_update_response);
+            break;
+        case OGS_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
+            length = msg_length_pfcp_association_release_request(
+                    &pfcp_message->pfcp_association_release_request);
+            break;
+        case OGS_PFCP_ASSOCIATION_RELEASE_RESPONSE_TYPE:
+            length = msg_length_pfcp_association_release_response(
+                    &pfcp_message->pfcp_association_release_response);
+            break;
+        case OGS_PFCP_VERSION_NOT_SUPPORTED_RESPONSE_TYPE:
+            length = msg_length_pfcp_version_not_supported_response(
+                    &pfcp_message->pfcp_version_not_supported_response);
+            break;
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            length = msg_length_pfcp_node_report_request(
+                    &pfcp_message->pfcp_node_report_request);
+            break;
+        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
+            length = msg_length_pfcp_node_report_response(
+                    &pfcp_message->pfcp_node_report_response);
+            break;
+        case OGS_PFCP_SESSION_SET_DELETION_REQUEST_TYPE:
+            length = msg_length_pfcp_session_set_deletion_request(
+                    &pfcp_message->pfcp_session_set_deletion_request);
+            break;
+        case OGS_PFCP_SESSION_SET_DELETION_RESPONSE_TYPE:
+            length = msg_length_pfcp_session_set_deletion_response(
+                    &pfcp_message->pfcp_session_set_deletion_response);
+            break;
+        case OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE:
+            length = msg_length_pfcp_session_establishment_request(
+                    &pfcp_message->pfcp_session_establishment_request);
+            break;
+        case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
+            length = msg_length_pfcp_session_establishment_response(
+                    &pfcp_message->pfcp_session_establishment_response);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_REQUEST_TYPE:
+            length = msg_length_pfcp_session_modification_request(
+                    &pfcp_message->pfcp_session_modification_request);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
+            length = msg_length_pfcp_session_modification_response(
+                    &pfcp_message->pfcp_session_modification_response);
+            break;
+        case OGS_PFCP_SESSION_DELETION_REQUEST_TYPE:
+            length = msg_length_pfcp_session_deletion_request(
+                    &pfcp_message->pfcp_session_deletion_request);
+            break;
+        case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
+            length = msg_length_pfcp_session_deletion_response(
+                    &pfcp_message->pfcp_session_deletion_response);
+            break;
+        case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
+            length = msg_length_pfcp_session_report_request(
+                    &pfcp_message->pfcp_session_report_request);
+            break;
+        case OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE:
+            length = msg_length_pfcp_session_report_response(
+                    &pfcp_message->pfcp_session_report_response);
+            break;
+        default:
+            ogs_warn("Not implmeneted(type:%d)", pfcp_message->h.type);
+            return NULL;
+    }
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_TLV_MAX_HEADROOM+length);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_reserve(pkbuf, OGS_TLV_MAX_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length);
+
+    switch(pfcp_message->h.type)
+    {
+        case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
+            pos = msg_write_pfcp_heartbeat_request(pkbuf->data,
+                    &pfcp_message->pfcp_heartbeat_request);
+            break;
+        case OGS_PFCP_HEARTBEAT_RESPONSE_TYPE:
+            pos = msg_write_pfcp_heartbeat_response(pkbuf->data,
+                    &pfcp_message->pfcp_heartbeat_response);
+            break;
+        case OGS_PFCP_PFD_MANAGEMENT_REQUEST_TYPE:
+            pos = msg_write_pfcp_pfd_management_request(pkbuf->data,
+                    &pfcp_message->pfcp_pfd_management_request);
+            break;
+        case OGS_PFCP_PFD_MANAGEMENT_RESPONSE_TYPE:
+            pos = msg_write_pfcp_pfd_management_response(pkbuf->data,
+                    &pfcp_message->pfcp_pfd_management_response);
+            break;
+        case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
+            pos = msg_write_pfcp_association_setup_request(pkbuf->data,
+                    &pfcp_message->pfcp_association_setup_request);
+            break;
+        case OGS_PFCP_ASSOCIATION_SETUP_RESPONSE_TYPE:
+            pos = msg_write_pfcp_association_setup_response(pkbuf->data,
+                    &pfcp_message->pfcp_association_setup_response);
+            break;
+        case OGS_PFCP_ASSOCIATION_UPDATE_REQUEST_TYPE:
+            pos = msg_write_pfcp_association_update_request(pkbuf->data,
+                    &pfcp_message->pfcp_association_update_request);
+            break;
+        case OGS_PFCP_ASSOCIATION_UPDATE_RESPONSE_TYPE:
+            pos = msg_write_pfcp_association_update_response(pkbuf->data,
+                    &pfcp_message->pfcp_association_update_response);
+            break;
+        case OGS_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
+            pos = msg_write_pfcp_association_release_request(pkbuf->data,
+                    &pfcp_message->pfcp_association_release_request);
+            break;
+        case OGS_PFCP_ASSOCIATION_RELEASE_RESPONSE_TYPE:
+            pos = msg_write_pfcp_association_release_response(pkbuf->data,
+                    &pfcp_message->pfcp_association_release_response);
+            break;
+        case OGS_PFCP_VERSION_NOT_SUPPORTED_RESPONSE_TYPE:
+            pos = msg_write_pfcp_version_not_supported_response(pkbuf->data,
+                    &pfcp_message->pfcp_version_not_supported_response);
+            break;
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            pos = msg_write_pfcp_node_report_request(pkbuf->data,
+                    &pfcp_message->pfcp_node_report_request);
+            break;
+        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
+            pos = msg_write_pfcp_node_report_response(pkbuf->data,
+                    &pfcp_message->pfcp_node_report_response);
+            break;
+        case OGS_PFCP_SESSION_SET_DELETION_REQUEST_TYPE:
+            pos = msg_write_pfcp_session_set_deletion_request(pkbuf->data,
+                    &pfcp_message->pfcp_session_set_deletion_request);
+            break;
+        case OGS_PFCP_SESSION_SET_DELETION_RESPONSE_TYPE:
+            pos = msg_write_pfcp_session_set_deletion_response(pkbuf->data,
+                    &pfcp_message->pfcp_session_set_deletion_response);
+            break;
+        case OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE:
+            pos = msg_write_pfcp_session_establishment_request(pkbuf->data,
+                    &pfcp_message->pfcp_session_establishment_request);
+            break;
+        case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
+            pos = msg_write_pfcp_session_establishment_response(pkbuf->data,
+                    &pfcp_message->pfcp_session_establishment_response);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_REQUEST_TYPE:
+            pos = msg_write_pfcp_session_modification_request(pkbuf->data,
+                    &pfcp_message->pfcp_session_modification_request);
+            break;
+        case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
+            pos = msg_write_pfcp_session_modification_response(pkbuf->data,
+                    &pfcp_message->pfcp_session_modification_response);
+            break;
+        case OGS_PFCP_SESSION_DELETION_REQUEST_TYPE:
+            pos = msg_write_pfcp_session_deletion_request(pkbuf->data,
+                    &pfcp_message->pfcp_session_deletion_request);
+            break;
+        case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
+            pos = msg_write_pfcp_session_deletion_response(pkbuf->data,
+                    &pfcp_message->pfcp_session_deletion_response);
+            break;
+        case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
+            pos = msg_write_pfcp_session_report_request(pkbuf->data,
+                    &pfcp_message->pfcp_session_report_request);
+            break;
+        case OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE:
+            pos = msg_write_pfcp_session_report_response(pkbuf->data,
+                    &pfcp_message->pfcp_session_report_response);
+            break;
+        default:
+            ogs_assert_if_reached();
             break;
     }
+    ogs_assert(pos == pkbuf->data + length);
 
     return pkbuf;
 }
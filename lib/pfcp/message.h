@@ -20,7 +20,7 @@
 /*******************************************************************************
  * This file had been created by pfcp-tlv.py script v0.1.0
  * Please do not modify this file but regenerate it via script.
- * Created on: 2020-08-28 21:50:38.876204 by acetcom
+ * Created on: 2026-10-18 21:39:19.191845 by root
  * from 29244-g10.docx
  ******************************************************************************/
 
@@ -513,9 +513,9 @@ typedef ogs_tlv_octet_t ogs_pfcp_tlv_dl_buffering_duration_t;
 typedef ogs_tlv_octet_t ogs_pfcp_tlv_dl_buffering_suggested_packet_count_t;
 typedef ogs_tlv_uint8_t ogs_pfcp_tlv_pfcpsmreq_flags_t;
 typedef ogs_tlv_uint8_t ogs_pfcp_tlv_pfcpsrrsp_flags_t;
-typedef ogs_tlv_octet_t ogs_pfcp_tlv_sequence_number_t;
-typedef ogs_tlv_octet_t ogs_pfcp_tlv_metric_t;
-typedef ogs_tlv_octet_t ogs_pfcp_tlv_timer_t;
+typedef ogs_tlv_uint32_t ogs_pfcp_tlv_sequence_number_t;
+typedef ogs_tlv_uint8_t ogs_pfcp_tlv_metric_t;
+typedef ogs_tlv_uint8_t ogs_pfcp_tlv_timer_t;
 typedef ogs_tlv_uint16_t ogs_pfcp_tlv_pdr_id_t;
 typedef ogs_tlv_octet_t ogs_pfcp_tlv_f_seid_t;
 typedef ogs_tlv_octet_t ogs_pfcp_tlv_node_id_t;
@@ -556,7 +556,7 @@ typedef ogs_tlv_octet_t ogs_pfcp_tlv_activate_predefined_rules_t;
 typedef ogs_tlv_octet_t ogs_pfcp_tlv_deactivate_predefined_rules_t;
 typedef ogs_tlv_uint32_t ogs_pfcp_tlv_far_id_t;
 typedef ogs_tlv_uint32_t ogs_pfcp_tlv_qer_id_t;
-typedef ogs_tlv_octet_t ogs_pfcp_tlv_oci_flags_t;
+typedef ogs_tlv_uint8_t ogs_pfcp_tlv_oci_flags_t;
 typedef ogs_tlv_octet_t ogs_pfcp_tlv_pfcp_association_release_request_t;
 typedef ogs_tlv_octet_t ogs_pfcp_tlv_graceful_release_period_t;
 typedef ogs_tlv_uint8_t ogs_pfcp_tlv_pdn_type_t;
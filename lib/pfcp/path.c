@@ -260,6 +260,55 @@ void ogs_pfcp_up_send_association_setup_response(ogs_pfcp_xact_t *xact,
     ogs_expect(rv == OGS_OK);
 }
 
+void ogs_pfcp_up_send_node_report_request(ogs_pfcp_node_t *node,
+        ogs_sockaddr_t *remote_gtp_u_peer,
+        void (*cb)(ogs_pfcp_xact_t *xact, void *data))
+{
+    int rv;
+    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_pfcp_header_t h;
+    ogs_pfcp_xact_t *xact = NULL;
+
+    ogs_assert(node);
+    ogs_assert(remote_gtp_u_peer);
+
+    memset(&h, 0, sizeof(ogs_pfcp_header_t));
+    h.type = OGS_PFCP_NODE_REPORT_REQUEST_TYPE;
+    h.seid = 0;
+
+    pkbuf = ogs_pfcp_up_build_node_report_request(h.type, remote_gtp_u_peer);
+    ogs_expect_or_return(pkbuf);
+
+    xact = ogs_pfcp_xact_local_create(node, &h, pkbuf, cb, node);
+    ogs_expect_or_return(xact);
+
+    rv = ogs_pfcp_xact_commit(xact);
+    ogs_expect(rv == OGS_OK);
+}
+
+void ogs_pfcp_cp_send_node_report_response(ogs_pfcp_xact_t *xact,
+        uint8_t cause)
+{
+    int rv;
+    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_pfcp_header_t h;
+
+    ogs_assert(xact);
+
+    memset(&h, 0, sizeof(ogs_pfcp_header_t));
+    h.type = OGS_PFCP_NODE_REPORT_RESPONSE_TYPE;
+    h.seid = 0;
+
+    pkbuf = ogs_pfcp_cp_build_node_report_response(h.type, cause);
+    ogs_expect_or_return(pkbuf);
+
+    rv = ogs_pfcp_xact_update_tx(xact, &h, pkbuf);
+    ogs_expect_or_return(rv == OGS_OK);
+
+    rv = ogs_pfcp_xact_commit(xact);
+    ogs_expect(rv == OGS_OK);
+}
+
 void ogs_pfcp_send_g_pdu(ogs_pfcp_pdr_t *pdr, ogs_pkbuf_t *sendbuf)
 {
     ogs_gtp_node_t *gnode = NULL;
@@ -299,6 +348,27 @@ void ogs_pfcp_send_g_pdu(ogs_pfcp_pdr_t *pdr, ogs_pkbuf_t *sendbuf)
     ogs_gtp_send_user_plane(gnode, &gtp_hdesc, &ext_hdesc, sendbuf);
 }
 
+/* Only the forwarding entry of the PDR is read */
+void ogs_pfcp_send_g_pdu_fwd(ogs_pfcp_pdr_fwd_t *fwd, ogs_pkbuf_t *sendbuf)
+{
+    ogs_gtp_header_t gtp_hdesc;
+    ogs_gtp_extension_header_t ext_hdesc;
+
+    ogs_assert(fwd);
+    ogs_assert(fwd->gtpu);
+    ogs_assert(sendbuf);
+
+    memset(&gtp_hdesc, 0, sizeof(gtp_hdesc));
+    memset(&ext_hdesc, 0, sizeof(ext_hdesc));
+
+    gtp_hdesc.type = OGS_GTPU_MSGTYPE_GPDU;
+    gtp_hdesc.teid = fwd->teid;
+    ext_hdesc.qos_flow_identifier = fwd->qfi;
+
+    ogs_gtp_send_user_plane_to(fwd->fd, (ogs_sockaddr_t *)&fwd->addr,
+            &gtp_hdesc, &ext_hdesc, sendbuf);
+}
+
 void ogs_pfcp_send_end_marker(ogs_pfcp_pdr_t *pdr)
 {
     ogs_gtp_node_t *gnode = NULL;
@@ -341,17 +411,29 @@ void ogs_pfcp_send_end_marker(ogs_pfcp_pdr_t *pdr)
 void ogs_pfcp_send_buffered_packet(ogs_pfcp_pdr_t *pdr)
 {
     ogs_pfcp_far_t *far = NULL;
-    int i;
+    ogs_pkbuf_t *pkbuf = NULL;
 
     ogs_assert(pdr);
     far = pdr->far;
 
+    /* Held until the GTP-U path is up again */
+    if (far && far->gnode &&
+        ((ogs_gtp_node_t *)far->gnode)->path.down)
+        return;
+
     if (far && far->gnode) {
         if (far->apply_action & OGS_PFCP_APPLY_ACTION_FORW) {
-            for (i = 0; i < far->num_of_buffered_packet; i++) {
-                ogs_pfcp_send_g_pdu(pdr, far->buffered_packet[i]);
+            if (far->buffer.num_of_packet) {
+                ogs_gtp_send_batch_start();
+                while ((pkbuf = ogs_pfcp_far_buffer_remove(far)))
+                    ogs_pfcp_send_g_pdu(pdr, pkbuf);
+                ogs_gtp_send_batch_flush();
             }
-            far->num_of_buffered_packet = 0;
+            far->buffer.reported = false;
+
+            /* The UE is reachable again */
+            if (far->sess && far->sess->bar)
+                ogs_pfcp_bar_stop_dl_buffering(far->sess->bar);
         }
     }
 }
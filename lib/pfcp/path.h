@@ -78,7 +78,14 @@ void ogs_pfcp_up_send_association_setup_request(ogs_pfcp_node_t *node,
 void ogs_pfcp_up_send_association_setup_response(ogs_pfcp_xact_t *xact,
         uint8_t cause);
 
+void ogs_pfcp_up_send_node_report_request(ogs_pfcp_node_t *node,
+        ogs_sockaddr_t *remote_gtp_u_peer,
+        void (*cb)(ogs_pfcp_xact_t *xact, void *data));
+void ogs_pfcp_cp_send_node_report_response(ogs_pfcp_xact_t *xact,
+        uint8_t cause);
+
 void ogs_pfcp_send_g_pdu(ogs_pfcp_pdr_t *pdr, ogs_pkbuf_t *sendbuf);
+void ogs_pfcp_send_g_pdu_fwd(ogs_pfcp_pdr_fwd_t *fwd, ogs_pkbuf_t *sendbuf);
 void ogs_pfcp_send_end_marker(ogs_pfcp_pdr_t *pdr);
 
 void ogs_pfcp_send_buffered_packet(ogs_pfcp_pdr_t *pdr);
@@ -414,6 +414,9 @@ type_list["Destination Interface"]["size"] = 1              # Type 42
 type_list["Apply Action"]["size"] = 1                       # Type 44
 type_list["PFCPSMReq-Flags"]["size"] = 1                    # Type 49
 type_list["PFCPSRRsp-Flags"]["size"] = 1                    # Type 50
+type_list["Sequence Number"]["size"] = 4                    # Type 52
+type_list["Metric"]["size"] = 1                             # Type 53
+type_list["Timer"]["size"] = 1                              # Type 55
 type_list["PDR ID"]["size"] = 2                             # Type 56
 type_list["Measurement Method"]["size"] = 1                 # Type 62
 type_list["URR ID"]["size"] = 4                             # Type 81
@@ -422,6 +425,7 @@ type_list["CP Function Features"]["size"] = 1               # Type 89
 type_list["Recovery Time Stamp"]["size"] = 4                # Type 96
 type_list["FAR ID"]["size"] = 4                             # Type 108
 type_list["QER ID"]["size"] = 4                             # Type 109
+type_list["OCI Flags"]["size"] = 1                          # Type 110
 type_list["PDN Type"]["size"] = 1                           # Type 113
 type_list["RQI"]["size"] = 1                                # Type 123
 type_list["QFI"]["size"] = 1                                # Type 124
@@ -674,6 +678,161 @@ for (k, v) in sorted_msg_list:
         f.write("}};\n\n")
 f.write("\n")
 
+def ie_fields(ies):
+    fields = []
+    for ies in ies:
+        field = { "name" : v_lower(ies["ie_value"]), \
+                "type" : ies["ie_type"], "more" : 0 }
+        if type_list[ies["ie_type"]]["max_tlv_more"] != "0":
+            field["more"] = int(ies["tlv_more"])+1
+        fields.append(field)
+    return fields
+
+def ie_kind(k):
+    if k in group_list.keys():
+        return "group"
+    if "size" in type_list[k]:
+        return { 1 : "uint8", 2 : "uint16", 3 : "uint24", 4 : "uint32" }[type_list[k]["size"]]
+    return "octet"
+
+def ie_length(field, ref):
+    kind = ie_kind(field["type"])
+    if kind == "group":
+        return "TLV_HLEN + tlv_length_%s(&%s)" % (v_lower(field["type"]), ref)
+    elif kind == "octet":
+        return "TLV_HLEN + %s.len" % ref
+    else:
+        return "TLV_HLEN + %d" % type_list[field["type"]]["size"]
+
+def ie_write(field, ref, indent):
+    kind = ie_kind(field["type"])
+    if kind == "group":
+        return "pos = ogs_tlv_write_group(pos, TLV_MODE,\n" + indent + \
+            "        OGS_PFCP_%s_TYPE, 0,\n" % v_upper(field["type"]) + indent + \
+            "        tlv_write_%s(pos + TLV_HLEN, &%s));\n" % (v_lower(field["type"]), ref)
+    return "pos = ogs_tlv_write_%s(pos, TLV_MODE,\n" % kind + indent + \
+        "        OGS_PFCP_%s_TYPE, 0, &%s);\n" % (v_upper(field["type"]), ref)
+
+def ie_read(field, ref, indent):
+    kind = ie_kind(field["type"])
+    if kind == "group":
+        return indent + "if (tlv_read_%s(&%s, pos, len) != OGS_OK)\n" % (v_lower(field["type"]), ref) + \
+            indent + "    return OGS_ERROR;\n" + \
+            indent + "%s.presence = 1;\n" % ref
+    return indent + "if (ogs_tlv_read_%s(&%s, pos, len) != OGS_OK)\n" % (kind, ref) + \
+        indent + "    return OGS_ERROR;\n"
+
+def output_codec(f, prefix, name, ctype, fields):
+    more = len([field for field in fields if field["more"]]) != 0
+
+    f.write("static uint32_t %s_length_%s(%s *ie)\n" % (prefix, name, ctype))
+    f.write("{\n")
+    f.write("    uint32_t length = 0;\n")
+    if more:
+        f.write("    int i;\n")
+    f.write("\n")
+    for field in fields:
+        ref = "ie->" + field["name"]
+        if field["more"]:
+            f.write("    for (i = 0; i < %d && %s[i].presence; i++)\n" % (field["more"], ref))
+            f.write("        length += %s;\n" % ie_length(field, ref + "[i]"))
+        else:
+            f.write("    if (%s.presence)\n" % ref)
+            f.write("        length += %s;\n" % ie_length(field, ref))
+    f.write("\n")
+    f.write("    return length;\n")
+    f.write("}\n\n")
+
+    f.write("static uint8_t *%s_write_%s(uint8_t *pos, %s *ie)\n" % (prefix, name, ctype))
+    f.write("{\n")
+    if more:
+        f.write("    int i;\n\n")
+    for field in fields:
+        ref = "ie->" + field["name"]
+        if field["more"]:
+            f.write("    for (i = 0; i < %d && %s[i].presence; i++)\n" % (field["more"], ref))
+            f.write("        " + ie_write(field, ref + "[i]", "        "))
+        else:
+            f.write("    if (%s.presence)\n" % ref)
+            f.write("        " + ie_write(field, ref, "        "))
+    if len(fields):
+        f.write("\n")
+    f.write("    return pos;\n")
+    f.write("}\n\n")
+
+    f.write("static int %s_read_%s(%s *ie, uint8_t *pos, uint32_t length)\n" % (prefix, name, ctype))
+    f.write("{\n")
+    f.write("    uint8_t *end = pos + length;\n")
+    f.write("    uint16_t type, len;\n")
+    f.write("    uint8_t instance;\n")
+    if more:
+        f.write("    int i;\n")
+    f.write("\n")
+    f.write("    while (pos < end) {\n")
+    f.write("        pos = ogs_tlv_get_header(pos, end, TLV_MODE, &type, &len, &instance);\n")
+    f.write("        if (!pos)\n")
+    f.write("            return OGS_ERROR;\n")
+    f.write("\n")
+    f.write("        switch (type) {\n")
+    types = []
+    for field in fields:
+        # The first IE of the same type gets the value
+        if field["type"] in types:
+            continue
+        types.append(field["type"])
+        ref = "ie->" + field["name"]
+        f.write("        case OGS_PFCP_%s_TYPE:\n" % v_upper(field["type"]))
+        if field["more"]:
+            f.write("            for (i = 0; i < %d && %s[i].presence; i++);\n" % (field["more"], ref))
+            f.write("            if (i == %d) {\n" % field["more"])
+            f.write("                ogs_fatal(\"Multiple of the same type TLV need more room\");\n")
+            f.write("                ogs_assert_if_reached();\n")
+            f.write("                break;\n")
+            f.write("            }\n")
+            f.write(ie_read(field, ref + "[i]", "            "))
+        else:
+            f.write(ie_read(field, ref, "            "))
+        f.write("            break;\n")
+    f.write("        default:\n")
+    f.write("            ogs_warn(\"Unknown TLV type [%d]\", type);\n")
+    f.write("            break;\n")
+    f.write("        }\n")
+    f.write("\n")
+    f.write("        pos += len;\n")
+    f.write("    }\n")
+    f.write("\n")
+    f.write("    return OGS_OK;\n")
+    f.write("}\n\n")
+
+# Group IEs which can be reached from the messages
+used_group_list = []
+def use_group(fields):
+    for field in fields:
+        if field["type"] in group_list.keys() and field["type"] not in used_group_list:
+            used_group_list.append(field["type"])
+            use_group(ie_fields(group_list[field["type"]]["ies"]))
+for (k, v) in sorted_msg_list:
+    if "ies" in msg_list[k]:
+        use_group(ie_fields(msg_list[k]["ies"]))
+
+f.write("/* Direct encoder/decoder */\n")
+f.write("#define TLV_MODE OGS_TLV_MODE_T2_L2\n")
+f.write("#define TLV_HLEN 4\n\n")
+for (k, v) in sorted_group_list:
+    if k not in used_group_list:
+        continue
+    f.write("static uint32_t tlv_length_%s(ogs_pfcp_tlv_%s_t *ie);\n" % (v_lower(k), v_lower(k)))
+    f.write("static uint8_t *tlv_write_%s(uint8_t *pos, ogs_pfcp_tlv_%s_t *ie);\n" % (v_lower(k), v_lower(k)))
+    f.write("static int tlv_read_%s(\n        ogs_pfcp_tlv_%s_t *ie, uint8_t *pos, uint32_t length);\n" % (v_lower(k), v_lower(k)))
+f.write("\n")
+for (k, v) in sorted_group_list:
+    if k not in used_group_list:
+        continue
+    output_codec(f, "tlv", v_lower(k), "ogs_pfcp_tlv_%s_t" % v_lower(k), ie_fields(group_list[k]["ies"]))
+for (k, v) in sorted_msg_list:
+    if "ies" in msg_list[k]:
+        output_codec(f, "msg", v_lower(k), "ogs_%s_t" % v_lower(k), ie_fields(msg_list[k]["ies"]))
+
 f.write("""int ogs_pfcp_parse_msg(ogs_pfcp_message_t *pfcp_message, ogs_pkbuf_t *pkbuf)
 {
     int rv = OGS_ERROR;
@@ -713,8 +872,8 @@ f.write("""int ogs_pfcp_parse_msg(ogs_pfcp_message_t *pfcp_message, ogs_pkbuf_t
 for (k, v) in sorted_msg_list:
     if "ies" in msg_list[k]:
         f.write("        case OGS_%s_TYPE:\n" % v_upper(k))
-        f.write("            rv = ogs_tlv_parse_msg(&pfcp_message->%s,\n" % v_lower(k))
-        f.write("                    &ogs_pfcp_msg_desc_%s, pkbuf, OGS_TLV_MODE_T2_L2);\n" % v_lower(k))
+        f.write("            rv = msg_read_%s(&pfcp_message->%s,\n" % (v_lower(k), v_lower(k)))
+        f.write("                    pkbuf->data, pkbuf->len);\n")
         f.write("            break;\n")
 f.write("""        default:
             ogs_warn("Not implmeneted(type:%d)", pfcp_message->h.type);
@@ -729,6 +888,8 @@ f.write("""        default:
 f.write("""ogs_pkbuf_t *ogs_pfcp_build_msg(ogs_pfcp_message_t *pfcp_message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
+    uint8_t *pos = NULL;
+    uint32_t length = 0;
 
     ogs_assert(pfcp_message);
     switch(pfcp_message->h.type)
@@ -737,13 +898,33 @@ f.write("""ogs_pkbuf_t *ogs_pfcp_build_msg(ogs_pfcp_message_t *pfcp_message)
 for (k, v) in sorted_msg_list:
     if "ies" in msg_list[k]:
         f.write("        case OGS_%s_TYPE:\n" % v_upper(k))
-        f.write("            pkbuf = ogs_tlv_build_msg(&ogs_pfcp_msg_desc_%s,\n" % v_lower(k))
-        f.write("                    &pfcp_message->%s, OGS_TLV_MODE_T2_L2);\n" % v_lower(k))
+        f.write("            length = msg_length_%s(\n" % v_lower(k))
+        f.write("                    &pfcp_message->%s);\n" % v_lower(k))
         f.write("            break;\n")
 f.write("""        default:
             ogs_warn("Not implmeneted(type:%d)", pfcp_message->h.type);
+            return NULL;
+    }
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_TLV_MAX_HEADROOM+length);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_reserve(pkbuf, OGS_TLV_MAX_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length);
+
+    switch(pfcp_message->h.type)
+    {
+""")
+for (k, v) in sorted_msg_list:
+    if "ies" in msg_list[k]:
+        f.write("        case OGS_%s_TYPE:\n" % v_upper(k))
+        f.write("            pos = msg_write_%s(pkbuf->data,\n" % v_lower(k))
+        f.write("                    &pfcp_message->%s);\n" % v_lower(k))
+        f.write("            break;\n")
+f.write("""        default:
+            ogs_assert_if_reached();
             break;
     }
+    ogs_assert(pos == pkbuf->data + length);
 
     return pkbuf;
 }
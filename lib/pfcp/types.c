@@ -403,3 +403,54 @@ int16_t ogs_pfcp_parse_bitrate(
 
     return size;
 }
+
+uint8_t ogs_pfcp_timer_from_time(ogs_time_t time)
+{
+    ogs_pfcp_timer_t timer;
+    uint64_t sec = ogs_time_sec(time);
+
+    memset(&timer, 0, sizeof(timer));
+
+    if (sec <= 2 * 31) {
+        timer.unit = OGS_PFCP_TIMER_UNIT_2SEC;
+        timer.value = (sec + 1) / 2;
+    } else if (sec <= 60 * 31) {
+        timer.unit = OGS_PFCP_TIMER_UNIT_1MIN;
+        timer.value = (sec + 59) / 60;
+    } else if (sec <= 10 * 60 * 31) {
+        timer.unit = OGS_PFCP_TIMER_UNIT_10MIN;
+        timer.value = (sec + 599) / 600;
+    } else if (sec <= 3600 * 31) {
+        timer.unit = OGS_PFCP_TIMER_UNIT_1HOUR;
+        timer.value = (sec + 3599) / 3600;
+    } else if (sec <= 10 * 3600 * 31) {
+        timer.unit = OGS_PFCP_TIMER_UNIT_10HOUR;
+        timer.value = (sec + 35999) / 36000;
+    } else {
+        timer.unit = OGS_PFCP_TIMER_UNIT_INFINITE;
+    }
+
+    return timer.octet;
+}
+
+ogs_time_t ogs_pfcp_timer_to_time(uint8_t octet)
+{
+    ogs_pfcp_timer_t timer;
+
+    timer.octet = octet;
+
+    switch (timer.unit) {
+    case OGS_PFCP_TIMER_UNIT_2SEC:
+        return ogs_time_from_sec(timer.value * 2);
+    case OGS_PFCP_TIMER_UNIT_10MIN:
+        return ogs_time_from_sec(timer.value * 10 * 60);
+    case OGS_PFCP_TIMER_UNIT_1HOUR:
+        return ogs_time_from_sec(timer.value * 3600);
+    case OGS_PFCP_TIMER_UNIT_10HOUR:
+        return ogs_time_from_sec(timer.value * 10 * 3600);
+    case OGS_PFCP_TIMER_UNIT_INFINITE:
+        return 0;
+    default:
+        return ogs_time_from_sec(timer.value * 60);
+    }
+}
@@ -917,6 +917,57 @@ ED4(uint8_t     spare:5;,
     };
 } __attribute__ ((packed)) ogs_pfcp_smreq_flags_t;
 
+/*
+ * Metric IE (Type 53)
+ *
+ * The Metric shall be encoded as an Unsigned Integer in the range 0 to 100.
+ */
+#define OGS_PFCP_METRIC_MAX                                 100
+
+/*
+ * Timer IE (Type 55)
+ *
+ * Bits 6 to 8 defines the timer value unit for the timer as follows:
+ * Bits
+ * 8 7 6
+ * 0 0 0 value is incremented in multiples of 2 seconds
+ * 0 0 1 value is incremented in multiples of 1 minute
+ * 0 1 0 value is incremented in multiples of 10 minutes
+ * 0 1 1 value is incremented in multiples of 1 hour
+ * 1 0 0 value is incremented in multiples of 10 hours
+ * 1 1 1 value indicates that the timer is infinite
+ *
+ * Other values shall be interpreted as multiples of 1 minute.
+ * Bits 5 to 1 represent the binary coded timer value.
+ */
+#define OGS_PFCP_TIMER_UNIT_2SEC                            0
+#define OGS_PFCP_TIMER_UNIT_1MIN                            1
+#define OGS_PFCP_TIMER_UNIT_10MIN                           2
+#define OGS_PFCP_TIMER_UNIT_1HOUR                           3
+#define OGS_PFCP_TIMER_UNIT_10HOUR                          4
+#define OGS_PFCP_TIMER_UNIT_INFINITE                        7
+typedef struct ogs_pfcp_timer_s {
+    union {
+        struct {
+ED2(uint8_t     unit:3;,
+    uint8_t     value:5;)
+        };
+        uint8_t octet;
+    };
+} __attribute__ ((packed)) ogs_pfcp_timer_t;
+
+uint8_t ogs_pfcp_timer_from_time(ogs_time_t time);
+/* Returns 0 if the timer is infinite */
+ogs_time_t ogs_pfcp_timer_to_time(uint8_t timer);
+
+/*
+ * OCI Flags IE (Type 110)
+ *
+ * Bit 1 – AOCI: Associate OCI with Node ID
+ * Bit 2 to 8 Spare, for future use and set to 0.
+ */
+#define OGS_PFCP_OCI_FLAGS_AOCI                             1
+
 typedef struct ogs_pfcp_user_plane_report_s {
     ogs_pfcp_report_type_t type;
     struct {
@@ -930,6 +981,56 @@ typedef struct ogs_pfcp_user_plane_report_s {
     } error_indication;
 } ogs_pfcp_user_plane_report_t;
 
+/*
+ * 8.2.69 Node Report Type
+ *
+ * Bit 1 – UPFR (User Plane Path Failure Report): when set to 1,
+ *         this indicates a User Plane Path Failure Report.
+ * Bit 2 to 8 – Spare, for future use and set to 0.
+ */
+typedef struct ogs_pfcp_node_report_type_s {
+    union {
+        struct {
+ED2(uint8_t     spare:7;,
+    uint8_t     user_plane_path_failure_report:1;)
+        };
+        uint8_t value;
+    };
+} __attribute__ ((packed)) ogs_pfcp_node_report_type_t;
+
+/*
+ * 8.2.70 Remote GTP-U Peer
+ *
+ * The following flags are coded within Octet 5:
+ *
+ * - Bit 1 – V6: If this bit is set to "1", then the IPv6 address field
+ *   shall be present in the Remote GTP-U Peer,
+ *   otherwise the IPv6 address field shall not be present.
+ * - Bit 2 – V4: If this bit is set to "1", then the IPv4 address field
+ *   shall be present in the Remote GTP-U Peer,
+ *   otherwise the IPv4 address field shall not be present.
+ * - Bit 3 – DI: If this bit is set to "1", then the Destination Interface
+ *   field shall be present.
+ * - Bit 4 – NI: If this bit is set to "1", then the Network Instance field
+ *   shall be present.
+ * - Bit 5 to 8: Spare, for future use and set to 0.
+ */
+typedef struct ogs_pfcp_remote_gtp_u_peer_s {
+ED5(uint8_t     spare:4;,
+    uint8_t     ni:1;,
+    uint8_t     di:1;,
+    uint8_t     ipv4:1;,
+    uint8_t     ipv6:1;)
+    union {
+        uint32_t addr;
+        uint8_t addr6[OGS_IPV6_LEN];
+        struct {
+            uint32_t addr;
+            uint8_t addr6[OGS_IPV6_LEN];
+        } both;
+    };
+} __attribute__ ((packed)) ogs_pfcp_remote_gtp_u_peer_t;
+
 #ifdef __cplusplus
 }
 #endif
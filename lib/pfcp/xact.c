@@ -35,6 +35,12 @@ static uint32_t g_xact_id = 0;
 
 static OGS_POOL(pool, ogs_pfcp_xact_t);
 
+static struct {
+    ogs_metrics_t *rx, *tx;
+    ogs_metrics_t *retransmit, *timeout;
+    ogs_metrics_t *xact;
+} metrics;
+
 static ogs_pfcp_xact_stage_t ogs_pfcp_xact_get_stage(
         uint8_t type, uint32_t sqn);
 static int ogs_pfcp_xact_delete(ogs_pfcp_xact_t *xact);
@@ -51,6 +57,21 @@ int ogs_pfcp_xact_init(void)
 
     g_xact_id = 0;
 
+    metrics.rx = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "pfcp_messages_received_total",
+            "PFCP messages received by type", NULL, "type", 256, NULL);
+    metrics.tx = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "pfcp_messages_sent_total",
+            "PFCP messages sent by type", NULL, "type", 256, NULL);
+    metrics.retransmit = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "pfcp_retransmissions_total",
+            "PFCP messages sent again on timeout or duplicated request",
+            NULL);
+    metrics.timeout = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "pfcp_response_timeouts_total",
+            "PFCP requests given up without a response", NULL);
+    metrics.xact = ogs_metrics_add_pool(&pool, "pfcp_xact");
+
     ogs_pfcp_xact_initialized = 1;
 
     return OGS_OK;
@@ -60,6 +81,13 @@ void ogs_pfcp_xact_final(void)
 {
     ogs_assert(ogs_pfcp_xact_initialized == 1);
 
+    if (metrics.rx) ogs_metrics_remove(metrics.rx);
+    if (metrics.tx) ogs_metrics_remove(metrics.tx);
+    if (metrics.retransmit) ogs_metrics_remove(metrics.retransmit);
+    if (metrics.timeout) ogs_metrics_remove(metrics.timeout);
+    if (metrics.xact) ogs_metrics_remove(metrics.xact);
+    memset(&metrics, 0, sizeof(metrics));
+
     ogs_pool_final(&pool);
 
     ogs_pfcp_xact_initialized = 0;
@@ -279,6 +307,8 @@ int ogs_pfcp_xact_update_tx(ogs_pfcp_xact_t *xact,
     xact->seq[xact->step].type = h->type;
     xact->seq[xact->step].pkbuf = pkbuf;
 
+    ogs_metrics_vector_inc(metrics.tx, h->type);
+
     /* Step */
     xact->step++;
 
@@ -333,6 +363,7 @@ int ogs_pfcp_xact_update_rx(ogs_pfcp_xact_t *xact, uint8_t type)
                             OGS_PORT(&xact->node->addr));
                     rv = ogs_pfcp_sendto(xact->node, pkbuf);
                     ogs_expect(rv == OGS_OK);
+                    ogs_metrics_inc(metrics.retransmit);
                 } else {
                     ogs_warn("[%d] %s Request Duplicated. Discard!"
                             " for step %d type %d peer [%s]:%d",
@@ -399,6 +430,7 @@ int ogs_pfcp_xact_update_rx(ogs_pfcp_xact_t *xact, uint8_t type)
                             OGS_PORT(&xact->node->addr));
                     rv = ogs_pfcp_sendto(xact->node, pkbuf);
                     ogs_expect(rv == OGS_OK);
+                    ogs_metrics_inc(metrics.retransmit);
                 } else {
                     ogs_warn("[%d] %s Request Duplicated. Discard!"
                             " for step %d type %d peer [%s]:%d",
@@ -608,7 +640,9 @@ static void response_timeout(void *data)
             ogs_error("ogs_pfcp_sendto() failed");
             goto out;
         }
+        ogs_metrics_inc(metrics.retransmit);
     } else {
+        ogs_metrics_inc(metrics.timeout);
         ogs_warn("[%d] %s No Reponse. Give up! "
                 "for step %d type %d peer [%s]:%d",
                 xact->xid,
@@ -690,6 +724,8 @@ int ogs_pfcp_xact_receive(
     ogs_assert(node);
     ogs_assert(h);
 
+    ogs_metrics_vector_inc(metrics.rx, h->type);
+
     new = ogs_pfcp_xact_find_by_xid(
             node, h->type, OGS_PFCP_SQN_TO_XID(h->sqn));
     if (!new)
@@ -730,6 +766,7 @@ static ogs_pfcp_xact_stage_t ogs_pfcp_xact_get_stage(uint8_t type, uint32_t xid)
     case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
     case OGS_PFCP_ASSOCIATION_UPDATE_REQUEST_TYPE:
     case OGS_PFCP_ASSOCIATION_RELEASE_REQUEST_TYPE:
+    case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
     case OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE:
     case OGS_PFCP_SESSION_MODIFICATION_REQUEST_TYPE:
     case OGS_PFCP_SESSION_DELETION_REQUEST_TYPE:
@@ -741,6 +778,7 @@ static ogs_pfcp_xact_stage_t ogs_pfcp_xact_get_stage(uint8_t type, uint32_t xid)
     case OGS_PFCP_ASSOCIATION_UPDATE_RESPONSE_TYPE:
     case OGS_PFCP_ASSOCIATION_RELEASE_RESPONSE_TYPE:
     case OGS_PFCP_VERSION_NOT_SUPPORTED_RESPONSE_TYPE:
+    case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
     case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
     case OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE:
     case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
@@ -48,6 +48,7 @@ typedef struct connection_s {
 
     ogs_timer_t *timer;
     CURL *easy;
+    ogs_time_t start;
 
     char error[CURL_ERROR_SIZE];
 
@@ -59,6 +60,12 @@ static OGS_POOL(client_pool, ogs_sbi_client_t);
 static OGS_POOL(sockinfo_pool, sockinfo_t);
 static OGS_POOL(connection_pool, connection_t);
 
+static struct {
+    ogs_metrics_t *latency;
+    ogs_metrics_t *error, *timeout;
+    ogs_metrics_t *connection;
+} metrics;
+
 static size_t write_cb(void *contents, size_t size, size_t nmemb, void *data);
 static size_t header_cb(void *ptr, size_t size, size_t nmemb, void *data);
 static int sock_cb(CURL *e, curl_socket_t s, int what, void *cbp, void *sockp);
@@ -67,6 +74,11 @@ static void multi_timer_expired(void *data);
 static void connection_timer_expired(void *data);
 static void connection_remove_all(ogs_sbi_client_t *client);
 
+static const int64_t latency_bucket[] = {
+    500, 1000, 2500, 5000, 10000, 25000, 50000,
+    100000, 250000, 500000, 1000000, 2500000, 5000000
+};
+
 void ogs_sbi_client_init(int num_of_sockinfo_pool, int num_of_connection_pool)
 {
     curl_global_init(CURL_GLOBAL_DEFAULT);
@@ -77,9 +89,28 @@ void ogs_sbi_client_init(int num_of_sockinfo_pool, int num_of_connection_pool)
     ogs_pool_init(&sockinfo_pool, num_of_sockinfo_pool);
     ogs_pool_init(&connection_pool, num_of_connection_pool);
 
+    metrics.latency = ogs_metrics_add_histogram(
+            "sbi_client_request_duration_microseconds",
+            "Time from sending an SBI request to receiving the response",
+            NULL, latency_bucket, OGS_ARRAY_SIZE(latency_bucket));
+    metrics.error = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "sbi_client_errors_total",
+            "SBI requests failed in the HTTP client", NULL);
+    metrics.timeout = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "sbi_client_timeouts_total",
+            "SBI requests discarded after the connection deadline", NULL);
+    metrics.connection = ogs_metrics_add_pool(
+            &connection_pool, "sbi_connection");
 }
+
 void ogs_sbi_client_final(void)
 {
+    if (metrics.latency) ogs_metrics_remove(metrics.latency);
+    if (metrics.error) ogs_metrics_remove(metrics.error);
+    if (metrics.timeout) ogs_metrics_remove(metrics.timeout);
+    if (metrics.connection) ogs_metrics_remove(metrics.connection);
+    memset(&metrics, 0, sizeof(metrics));
+
     ogs_pool_final(&client_pool);
     ogs_pool_final(&sockinfo_pool);
     ogs_pool_final(&connection_pool);
@@ -253,6 +284,7 @@ static connection_t *connection_add(
     conn->client = client;
     conn->client_cb = client_cb;
     conn->data = data;
+    conn->start = ogs_get_monotonic_time();
 
     conn->method = ogs_strdup(request->h.method);
 
@@ -394,6 +426,8 @@ static void connection_timer_expired(void *data)
     conn = data;
     ogs_assert(conn);
 
+    ogs_metrics_inc(metrics.timeout);
+
     connection_remove(conn);
 }
 
@@ -431,6 +465,9 @@ static void check_multi_info(ogs_sbi_client_t *client)
 
             res = resource->data.result;
             if (res == CURLE_OK) {
+                ogs_metrics_observe(metrics.latency,
+                        ogs_get_monotonic_time() - conn->start);
+
                 response = ogs_sbi_response_new();
                 ogs_assert(response);
 
@@ -461,8 +498,10 @@ static void check_multi_info(ogs_sbi_client_t *client)
 
                 ogs_assert(conn->client_cb);
                 conn->client_cb(response, conn->data);
-            } else
+            } else {
+                ogs_metrics_inc(metrics.error);
                 ogs_warn("[%d] %s", res, conn->error);
+            }
 
             connection_remove(conn);
             break;
@@ -152,6 +152,7 @@ int ogs_sbi_context_parse_config(const char *local, const char *remote)
                         const char *advertise[OGS_MAX_NUM_OF_HOSTNAME];
                         const char *key = NULL;
                         const char *pem = NULL;
+                        int num_of_worker = 0;
 
                         uint16_t port = self.http_port;
                         const char *dev = NULL;
@@ -239,6 +240,14 @@ int ogs_sbi_context_parse_config(const char *local, const char *remote)
                                 }
                             } else if (!strcmp(sbi_key, "dev")) {
                                 dev = ogs_yaml_iter_value(&sbi_iter);
+                            } else if (!strcmp(sbi_key, "worker")) {
+                                const char *v = ogs_yaml_iter_value(&sbi_iter);
+                                if (v) num_of_worker = atoi(v);
+                                if (num_of_worker < 0) {
+                                    ogs_warn("Ignore worker(%d)",
+                                            num_of_worker);
+                                    num_of_worker = 0;
+                                }
                             } else if (!strcmp(sbi_key, "tls")) {
                                 ogs_yaml_iter_t tls_iter;
                                 ogs_yaml_iter_recurse(&sbi_iter, &tls_iter);
@@ -304,6 +313,7 @@ int ogs_sbi_context_parse_config(const char *local, const char *remote)
 
                             if (key) server->tls.key = key;
                             if (pem) server->tls.pem = pem;
+                            server->num_of_worker = num_of_worker;
                         }
                         node6 = ogs_list_first(&list6);
                         if (node6) {
@@ -317,6 +327,7 @@ int ogs_sbi_context_parse_config(const char *local, const char *remote)
 
                             if (key) server->tls.key = key;
                             if (pem) server->tls.pem = pem;
+                            server->num_of_worker = num_of_worker;
                         }
 
                         if (addr)
@@ -26,6 +26,9 @@
 static OGS_POOL(request_pool, ogs_sbi_request_t);
 static OGS_POOL(response_pool, ogs_sbi_response_t);
 
+/* The SBI server workers allocate them in their own threads */
+static ogs_thread_mutex_t pool_mutex;
+
 static char *build_json(ogs_sbi_message_t *message);
 static int parse_json(ogs_sbi_message_t *message,
         char *content_type, char *json);
@@ -46,12 +49,16 @@ void ogs_sbi_message_init(int num_of_request_pool, int num_of_response_pool)
 {
     ogs_pool_init(&request_pool, num_of_request_pool);
     ogs_pool_init(&response_pool, num_of_response_pool);
+
+    ogs_thread_mutex_init(&pool_mutex);
 }
 
 void ogs_sbi_message_final(void)
 {
     ogs_pool_final(&request_pool);
     ogs_pool_final(&response_pool);
+
+    ogs_thread_mutex_destroy(&pool_mutex);
 }
 
 void ogs_sbi_message_free(ogs_sbi_message_t *message)
@@ -166,7 +173,9 @@ ogs_sbi_request_t *ogs_sbi_request_new(void)
 {
     ogs_sbi_request_t *request = NULL;
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&request_pool, &request);
+    ogs_thread_mutex_unlock(&pool_mutex);
     if (!request) return NULL;
     memset(request, 0, sizeof(ogs_sbi_request_t));
 
@@ -180,7 +189,9 @@ ogs_sbi_response_t *ogs_sbi_response_new(void)
 {
     ogs_sbi_response_t *response = NULL;
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&response_pool, &response);
+    ogs_thread_mutex_unlock(&pool_mutex);
     ogs_assert(response);
     memset(response, 0, sizeof(ogs_sbi_response_t));
 
@@ -200,7 +211,9 @@ void ogs_sbi_request_free(ogs_sbi_request_t *request)
     ogs_sbi_header_free(&request->h);
     http_message_free(&request->http);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&request_pool, request);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
 void ogs_sbi_response_free(ogs_sbi_response_t *response)
@@ -213,7 +226,9 @@ void ogs_sbi_response_free(ogs_sbi_response_t *response)
     ogs_sbi_header_free(&response->h);
     http_message_free(&response->http);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&response_pool, response);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
 ogs_sbi_request_t *ogs_sbi_build_request(ogs_sbi_message_t *message)
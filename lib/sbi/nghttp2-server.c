@@ -26,6 +26,23 @@
 
 #define USE_SEND_DATA_WITH_NO_COPY 1
 
+/*
+ * Output buffer
+ *
+ * The frames are coalesced in the pkbufs of the write queue, and
+ * session_flush() writes the queue with sendmsg() until the socket
+ * would block. A partly written pkbuf is pulled by the written length.
+ * The write poll is armed only while data is pending.
+ */
+#define OGS_SBI_WRITE_BUFFER_LEN    OGS_MAX_SDU_LEN
+#define OGS_SBI_MAX_NUM_OF_IOV      16
+
+#if defined(MSG_NOSIGNAL)
+#define OGS_SBI_SEND_FLAGS          MSG_NOSIGNAL
+#else
+#define OGS_SBI_SEND_FLAGS          0
+#endif
+
 static void server_init(int num_of_session_pool, int num_of_stream_pool);
 static void server_final(void);
 
@@ -54,6 +71,8 @@ struct h2_settings {
     bool enable_push;
 };
 
+typedef struct ogs_sbi_worker_s ogs_sbi_worker_t;
+
 typedef struct ogs_sbi_session_s {
     ogs_lnode_t             lnode;
 
@@ -68,6 +87,7 @@ typedef struct ogs_sbi_session_s {
     ogs_list_t              write_queue;
 
     ogs_sbi_server_t        *server;
+    ogs_sbi_worker_t        *worker;
     ogs_list_t              stream_list;
     int32_t                 last_stream_id;
 
@@ -79,37 +99,96 @@ typedef struct ogs_sbi_stream_s {
 
     int32_t                 stream_id;
     ogs_sbi_request_t       *request;
+    ogs_sbi_response_t      *response;
+    size_t                  offset; /* Content already in DATA frames */
+
+    /*
+     * The stream is kept until the response is sent even if
+     * the session is closed, since the NF thread has it.
+     */
+    bool                    pending;
 
     ogs_sbi_session_t       *session;
+    ogs_sbi_worker_t        *worker;
 } ogs_sbi_stream_t;
 
+/*
+ * Worker
+ *
+ * A worker accepts the connections of its listener and owns the sessions
+ * and the streams on them. Without worker threads, one worker runs
+ * in the NF thread on ogs_app()->pollset.
+ *
+ * With worker threads, the completed request is queued to the NF thread,
+ * which is woken up through a socket pair added to ogs_app()->pollset.
+ * The response is queued back to the worker of the stream, which is
+ * woken up with ogs_pollset_notify(). A notification is written only
+ * if the previous one has not been handled yet.
+ */
+struct ogs_sbi_worker_s {
+    ogs_sbi_server_t        *server;
+
+    ogs_thread_t            *thread;
+    ogs_pollset_t           *pollset;
+
+    ogs_socknode_t          node;   /* SO_REUSEPORT listener */
+    ogs_sock_t              *sock;
+    ogs_poll_t              *poll;
+
+    ogs_list_t              session_list;
+    OGS_POOL(session_pool, ogs_sbi_session_t);
+    OGS_POOL(stream_pool, ogs_sbi_stream_t);
+
+    struct {
+        ogs_queue_t         *queue;
+        ogs_socket_t        fd[2];
+        ogs_poll_t          *poll;
+        int                 notified;
+    } request;                      /* To the NF thread */
+
+    struct {
+        ogs_queue_t         *queue;
+        int                 notified;
+    } response;                     /* From the NF thread */
+};
+
 static void session_remove(ogs_sbi_session_t *sbi_sess);
-static void session_remove_all(ogs_sbi_server_t *server);
+static void session_remove_all(ogs_sbi_worker_t *worker);
 
 static void stream_remove(ogs_sbi_stream_t *stream);
+static void stream_free(ogs_sbi_stream_t *stream);
+static void stream_send_response(
+        ogs_sbi_stream_t *stream, ogs_sbi_response_t *response);
 
 static void accept_handler(short when, ogs_socket_t fd, void *data);
 static void recv_handler(short when, ogs_socket_t fd, void *data);
+static void request_handler(short when, ogs_socket_t fd, void *data);
+
+static int worker_init(ogs_sbi_worker_t *worker, ogs_sbi_server_t *server);
+static void worker_final(ogs_sbi_worker_t *worker);
+static void worker_main(void *data);
 
 static int session_set_callbacks(ogs_sbi_session_t *sbi_sess);
 static int session_send_preface(ogs_sbi_session_t *sbi_sess);
 static int session_send(ogs_sbi_session_t *sbi_sess);
 static void session_write_to_buffer(
-        ogs_sbi_session_t *sbi_sess, ogs_pkbuf_t *pkbuf);
+        ogs_sbi_session_t *sbi_sess, const uint8_t *data, size_t len);
+static void session_flush(ogs_sbi_session_t *sbi_sess);
 
-static OGS_POOL(session_pool, ogs_sbi_session_t);
-static OGS_POOL(stream_pool, ogs_sbi_stream_t);
+/* Size of the session/stream pools of each worker */
+static int max_num_of_session;
+static int max_num_of_stream;
+
+static OGS_THREAD_LOCAL ogs_sbi_worker_t *current_worker;
 
 static void server_init(int num_of_session_pool, int num_of_stream_pool)
 {
-    ogs_pool_init(&session_pool, num_of_session_pool);
-    ogs_pool_init(&stream_pool, num_of_stream_pool);
+    max_num_of_session = num_of_session_pool;
+    max_num_of_stream = num_of_stream_pool;
 }
 
 static void server_final(void)
 {
-    ogs_pool_final(&stream_pool);
-    ogs_pool_final(&session_pool);
 }
 
 static int server_start(ogs_sbi_server_t *server,
@@ -119,10 +198,17 @@ static int server_start(ogs_sbi_server_t *server,
     ogs_sock_t *sock = NULL;
     ogs_sockaddr_t *addr = NULL;
     char *hostname = NULL;
+    ogs_sbi_worker_t *worker = NULL;
+    int i, num_of_worker;
 
     addr = server->node.addr;
     ogs_assert(addr);
 
+    ogs_assert(server->num_of_worker >= 0);
+    num_of_worker = ogs_max(server->num_of_worker, 1);
+
+    server->node.reuse_port = (server->num_of_worker > 0);
+
     sock = ogs_tcp_server(&server->node);
     if (!sock) {
         ogs_error("Cannot start SBI server");
@@ -132,10 +218,27 @@ static int server_start(ogs_sbi_server_t *server,
     /* Setup callback function */
     server->cb = cb;
 
-    /* Setup poll for server listening socket */
-    server->node.poll = ogs_pollset_add(ogs_app()->pollset,
-            OGS_POLLIN, sock->fd, accept_handler, server);
-    ogs_assert(server->node.poll);
+    worker = ogs_calloc(num_of_worker, sizeof(ogs_sbi_worker_t));
+    ogs_assert(worker);
+    server->worker = worker;
+
+    for (i = 0; i < num_of_worker; i++) {
+        if (worker_init(&worker[i], server) != OGS_OK) {
+            ogs_error("Cannot start SBI worker[%d]", i);
+            while (i--)
+                worker_final(&worker[i]);
+            ogs_free(worker);
+            server->worker = NULL;
+            ogs_sock_destroy(sock);
+            server->node.sock = NULL;
+            return OGS_ERROR;
+        }
+    }
+
+    for (i = 0; i < server->num_of_worker; i++) {
+        worker[i].thread = ogs_thread_create(worker_main, &worker[i]);
+        ogs_assert(worker[i].thread);
+    }
 
     hostname = ogs_gethostname(addr);
     if (hostname)
@@ -143,21 +246,215 @@ static int server_start(ogs_sbi_server_t *server,
     else
         ogs_info("nghttp2_server() [%s]:%d",
                 OGS_ADDR(addr, buf), OGS_PORT(addr));
+    if (server->num_of_worker)
+        ogs_info("nghttp2_server() with %d workers", server->num_of_worker);
 
     return OGS_OK;
 }
 
 static void server_stop(ogs_sbi_server_t *server)
 {
+    ogs_sbi_worker_t *worker = NULL;
+    int i;
+
     ogs_assert(server);
 
-    if (server->node.poll)
-        ogs_pollset_remove(server->node.poll);
+    worker = server->worker;
+    if (worker) {
+        for (i = 0; i < server->num_of_worker; i++) {
+            ogs_assert(worker[i].thread);
+            ogs_queue_term(worker[i].response.queue);
+            ogs_pollset_notify(worker[i].pollset);
+        }
+        for (i = 0; i < server->num_of_worker; i++)
+            ogs_thread_destroy(worker[i].thread);
+
+        for (i = 0; i < ogs_max(server->num_of_worker, 1); i++)
+            worker_final(&worker[i]);
+
+        ogs_free(worker);
+        server->worker = NULL;
+    }
 
-    if (server->node.sock)
+    if (server->node.sock) {
         ogs_sock_destroy(server->node.sock);
+        server->node.sock = NULL;
+    }
+}
+
+static int worker_init(ogs_sbi_worker_t *worker, ogs_sbi_server_t *server)
+{
+    ogs_sockaddr_t local;
+    socklen_t addrlen;
+    int rv;
+
+    ogs_assert(worker);
+    ogs_assert(server);
+    ogs_assert(server->node.sock);
 
-    session_remove_all(server);
+    worker->server = server;
+
+    if (server->num_of_worker == 0) {
+        worker->pollset = ogs_app()->pollset;
+    } else {
+        worker->pollset = ogs_pollset_create(ogs_app()->pool.socket);
+        ogs_assert(worker->pollset);
+    }
+
+    if (worker == server->worker) {
+        /* The first worker uses the listener of the server */
+        worker->sock = server->node.sock;
+    } else {
+        /* The others listen on the same address, e.g. if port 0 */
+        addrlen = sizeof(local);
+        memset(&local, 0, sizeof(local));
+        rv = getsockname(server->node.sock->fd, &local.sa, &addrlen);
+        ogs_assert(rv == 0);
+
+        ogs_copyaddrinfo(&worker->node.addr, &local);
+        worker->node.reuse_port = true;
+
+        worker->sock = ogs_tcp_server(&worker->node);
+        if (!worker->sock) {
+            ogs_freeaddrinfo(worker->node.addr);
+            ogs_pollset_destroy(worker->pollset);
+            return OGS_ERROR;
+        }
+    }
+
+    worker->poll = ogs_pollset_add(worker->pollset,
+            OGS_POLLIN, worker->sock->fd, accept_handler, worker);
+    ogs_assert(worker->poll);
+
+    ogs_list_init(&worker->session_list);
+    ogs_pool_init(&worker->session_pool, max_num_of_session);
+    ogs_pool_init(&worker->stream_pool, max_num_of_stream);
+
+    if (server->num_of_worker) {
+        /* A stream is in a queue at most once */
+        worker->request.queue = ogs_queue_create(max_num_of_stream);
+        ogs_assert(worker->request.queue);
+        worker->response.queue = ogs_queue_create(max_num_of_stream);
+        ogs_assert(worker->response.queue);
+
+        rv = ogs_socketpair(AF_SOCKPAIR, SOCK_STREAM, 0, worker->request.fd);
+        ogs_assert(rv == OGS_OK);
+        rv = ogs_nonblocking(worker->request.fd[1]);
+        ogs_assert(rv == OGS_OK);
+
+        worker->request.poll = ogs_pollset_add(ogs_app()->pollset,
+                OGS_POLLIN, worker->request.fd[0], request_handler, worker);
+        ogs_assert(worker->request.poll);
+    }
+
+    return OGS_OK;
+}
+
+static void worker_final(ogs_sbi_worker_t *worker)
+{
+    ogs_sbi_stream_t *stream = NULL;
+    int i;
+
+    ogs_assert(worker);
+
+    ogs_pollset_remove(worker->poll);
+    if (worker->node.sock) {
+        ogs_sock_destroy(worker->node.sock);
+        ogs_freeaddrinfo(worker->node.addr);
+    }
+
+    session_remove_all(worker);
+
+    if (worker->request.queue) {
+        ogs_pollset_remove(worker->request.poll);
+        ogs_closesocket(worker->request.fd[0]);
+        ogs_closesocket(worker->request.fd[1]);
+
+        ogs_queue_destroy(worker->request.queue);
+        ogs_queue_destroy(worker->response.queue);
+    }
+
+    /* The streams queued or kept by the NF thread */
+    for (i = 1; i <= ogs_pool_size(&worker->stream_pool); i++) {
+        stream = ogs_pool_find(&worker->stream_pool, i);
+        if (stream)
+            stream_free(stream);
+    }
+
+    ogs_pool_final(&worker->stream_pool);
+    ogs_pool_final(&worker->session_pool);
+
+    if (worker->pollset != ogs_app()->pollset)
+        ogs_pollset_destroy(worker->pollset);
+}
+
+static void worker_main(void *data)
+{
+    ogs_sbi_worker_t *worker = data;
+    ogs_sbi_stream_t *stream = NULL;
+    ogs_sbi_response_t *response = NULL;
+    int rv;
+
+    ogs_assert(worker);
+    current_worker = worker;
+
+    for ( ;; ) {
+        ogs_pollset_poll(worker->pollset, OGS_INFINITE_TIME);
+
+        __atomic_store_n(&worker->response.notified, 0, __ATOMIC_RELEASE);
+
+        for ( ;; ) {
+            rv = ogs_queue_trypop(worker->response.queue, (void**)&stream);
+            ogs_assert(rv != OGS_ERROR);
+
+            if (rv == OGS_DONE)
+                return;
+
+            if (rv == OGS_RETRY)
+                break;
+
+            ogs_assert(stream);
+            response = stream->response;
+            ogs_assert(response);
+            stream->response = NULL;
+
+            stream_send_response(stream, response);
+        }
+    }
+}
+
+/* Called in the NF thread for the requests from a worker thread */
+static void request_handler(short when, ogs_socket_t fd, void *data)
+{
+    ogs_sbi_worker_t *worker = data;
+    ogs_sbi_server_t *server = NULL;
+    ogs_sbi_stream_t *stream = NULL;
+    char buf[64];
+    int rv;
+
+    ogs_assert(worker);
+    server = worker->server;
+    ogs_assert(server);
+    ogs_assert(server->cb);
+
+    while (ogs_recv(fd, buf, sizeof(buf), 0) == sizeof(buf))
+        ;
+
+    __atomic_store_n(&worker->request.notified, 0, __ATOMIC_RELEASE);
+
+    for ( ;; ) {
+        rv = ogs_queue_trypop(worker->request.queue, (void**)&stream);
+        if (rv != OGS_OK)
+            break;
+
+        ogs_assert(stream);
+        if (server->cb(stream->request, stream) != OGS_OK) {
+            ogs_warn("server callback error");
+            ogs_sbi_server_send_error(stream,
+                    OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR, NULL,
+                    "server callback error", NULL);
+        }
+    }
 }
 
 static void add_header(nghttp2_nv *nv, const char *key, const char *value)
@@ -244,6 +541,8 @@ static ssize_t response_read_callback(nghttp2_session *session,
 
     ogs_sbi_response_t *response = NULL;
     ogs_sbi_stream_t *stream = NULL;
+    size_t len;
+    bool eof;
 
     ogs_assert(session);
 
@@ -259,13 +558,25 @@ static ssize_t response_read_callback(nghttp2_session *session,
 
     ogs_assert(response->http.content);
     ogs_assert(response->http.content_length);
+    ogs_assert(stream->offset < response->http.content_length);
+
+    /*
+     * The flow control window can be smaller than the content,
+     * and then the rest is sent in the next DATA frame.
+     */
+    len = ogs_min(length, response->http.content_length - stream->offset);
+    eof = (stream->offset + len == response->http.content_length);
 
 #if USE_SEND_DATA_WITH_NO_COPY
     *data_flags |= NGHTTP2_DATA_FLAG_NO_COPY;
 #else
-    memcpy(buf, response->http.content, response->http.content_length);
+    memcpy(buf, response->http.content + stream->offset, len);
+    stream->offset += len;
 #endif
 
+    if (!eof)
+        return len;
+
     *data_flags |= NGHTTP2_DATA_FLAG_EOF;
 
 #if USE_SEND_DATA_WITH_NO_COPY
@@ -279,11 +590,35 @@ static ssize_t response_read_callback(nghttp2_session *session,
     }
 #endif
 
-    return response->http.content_length;
+    return len;
 }
 
 static void server_send_response(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
+{
+    ogs_sbi_worker_t *worker = NULL;
+
+    ogs_assert(stream);
+    worker = stream->worker;
+    ogs_assert(worker);
+    ogs_assert(response);
+
+    if (worker->thread && worker != current_worker) {
+        ogs_assert(!stream->response);
+        stream->response = response;
+
+        ogs_assert(ogs_queue_push(worker->response.queue, stream) == OGS_OK);
+        if (__atomic_exchange_n(
+                    &worker->response.notified, 1, __ATOMIC_ACQ_REL) == 0)
+            ogs_pollset_notify(worker->pollset);
+        return;
+    }
+
+    stream_send_response(stream, response);
+}
+
+static void stream_send_response(
+        ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
     ogs_sock_t *sock = NULL;
@@ -298,10 +633,18 @@ static void server_send_response(
     char clen[128];
 
     ogs_assert(stream);
+    ogs_assert(response);
+
+    stream->pending = false;
+
     sbi_sess = stream->session;
-    ogs_assert(sbi_sess);
+    if (!sbi_sess) {
+        ogs_debug("STREAM closed before the response");
+        ogs_sbi_response_free(response);
+        stream_free(stream);
+        return;
+    }
     ogs_assert(sbi_sess->session);
-    ogs_assert(response);
 
     sock = sbi_sess->sock;
     ogs_assert(sock);
@@ -368,35 +711,41 @@ static void server_send_response(
                 sbi_sess->session, NGHTTP2_FLAG_NONE, stream->stream_id, rv);
     }
 
+    /*
+     * The DATA frame can be deferred by the flow control,
+     * so the response is freed when the stream is closed.
+     */
+    ogs_assert(!stream->response);
+    stream->response = response;
+
+    ogs_free(nva);
+
     if (session_send(sbi_sess) != OGS_OK) {
         ogs_error("session_send() failed");
         session_remove(sbi_sess);
     }
-
-    ogs_sbi_response_free(response);
-    ogs_free(nva);
 }
 
 static ogs_sbi_server_t *server_from_stream(ogs_sbi_stream_t *stream)
 {
-    ogs_sbi_session_t *sbi_sess = NULL;
-
     ogs_assert(stream);
-    sbi_sess = stream->session;
-    ogs_assert(sbi_sess);
-    ogs_assert(sbi_sess->server);
+    ogs_assert(stream->worker);
+    ogs_assert(stream->worker->server);
 
-    return sbi_sess->server;
+    return stream->worker->server;
 }
 
 static ogs_sbi_stream_t *stream_add(
         ogs_sbi_session_t *sbi_sess, int32_t stream_id)
 {
     ogs_sbi_stream_t *stream = NULL;
+    ogs_sbi_worker_t *worker = NULL;
 
     ogs_assert(sbi_sess);
+    worker = sbi_sess->worker;
+    ogs_assert(worker);
 
-    ogs_pool_alloc(&stream_pool, &stream);
+    ogs_pool_alloc(&worker->stream_pool, &stream);
     ogs_assert(stream);
     memset(stream, 0, sizeof(ogs_sbi_stream_t));
 
@@ -407,6 +756,9 @@ static ogs_sbi_stream_t *stream_add(
     sbi_sess->last_stream_id = stream_id;
 
     stream->session = sbi_sess;
+    stream->worker = worker;
+
+    ogs_list_add(&sbi_sess->stream_list, stream);
 
     return stream;
 }
@@ -420,11 +772,29 @@ static void stream_remove(ogs_sbi_stream_t *stream)
     ogs_assert(sbi_sess);
 
     ogs_list_remove(&sbi_sess->stream_list, stream);
+    stream->session = NULL;
+
+    if (stream->pending)
+        return;
+
+    stream_free(stream);
+}
+
+static void stream_free(ogs_sbi_stream_t *stream)
+{
+    ogs_sbi_worker_t *worker = NULL;
+
+    ogs_assert(stream);
+    worker = stream->worker;
+    ogs_assert(worker);
 
     ogs_assert(stream->request);
     ogs_sbi_request_free(stream->request);
 
-    ogs_pool_free(&stream_pool, stream);
+    if (stream->response)
+        ogs_sbi_response_free(stream->response);
+
+    ogs_pool_free(&worker->stream_pool, stream);
 }
 
 static void stream_remove_all(ogs_sbi_session_t *sbi_sess)
@@ -438,39 +808,40 @@ static void stream_remove_all(ogs_sbi_session_t *sbi_sess)
 }
 
 static ogs_sbi_session_t *session_add(
-        ogs_sbi_server_t *server, ogs_sock_t *sock)
+        ogs_sbi_worker_t *worker, ogs_sock_t *sock)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
 
-    ogs_assert(server);
+    ogs_assert(worker);
     ogs_assert(sock);
 
-    ogs_pool_alloc(&session_pool, &sbi_sess);
+    ogs_pool_alloc(&worker->session_pool, &sbi_sess);
     ogs_assert(sbi_sess);
     memset(sbi_sess, 0, sizeof(ogs_sbi_session_t));
 
-    sbi_sess->server = server;
+    sbi_sess->server = worker->server;
+    sbi_sess->worker = worker;
     sbi_sess->sock = sock;
 
     sbi_sess->addr = ogs_calloc(1, sizeof(ogs_sockaddr_t));
     ogs_assert(sbi_sess->addr);
     memcpy(sbi_sess->addr, &sock->remote_addr, sizeof(ogs_sockaddr_t));
 
-    ogs_list_add(&server->session_list, sbi_sess);
+    ogs_list_add(&worker->session_list, sbi_sess);
 
     return sbi_sess;
 }
 
 static void session_remove(ogs_sbi_session_t *sbi_sess)
 {
-    ogs_sbi_server_t *server = NULL;
+    ogs_sbi_worker_t *worker = NULL;
     ogs_pkbuf_t *pkbuf = NULL, *next_pkbuf = NULL;
 
     ogs_assert(sbi_sess);
-    server = sbi_sess->server;
-    ogs_assert(server);
+    worker = sbi_sess->worker;
+    ogs_assert(worker);
 
-    ogs_list_remove(&server->session_list, sbi_sess);
+    ogs_list_remove(&worker->session_list, sbi_sess);
 
     stream_remove_all(sbi_sess);
 
@@ -489,22 +860,22 @@ static void session_remove(ogs_sbi_session_t *sbi_sess)
     ogs_assert(sbi_sess->sock);
     ogs_sock_destroy(sbi_sess->sock);
 
-    ogs_pool_free(&session_pool, sbi_sess);
+    ogs_pool_free(&worker->session_pool, sbi_sess);
 }
 
-static void session_remove_all(ogs_sbi_server_t *server)
+static void session_remove_all(ogs_sbi_worker_t *worker)
 {
     ogs_sbi_session_t *sbi_sess = NULL, *next_sbi_sess = NULL;
 
-    ogs_assert(server);
+    ogs_assert(worker);
 
-    ogs_list_for_each_safe(&server->session_list, next_sbi_sess, sbi_sess)
+    ogs_list_for_each_safe(&worker->session_list, next_sbi_sess, sbi_sess)
         session_remove(sbi_sess);
 }
 
 static void accept_handler(short when, ogs_socket_t fd, void *data)
 {
-    ogs_sbi_server_t *server = data;
+    ogs_sbi_worker_t *worker = data;
     ogs_sbi_session_t *sbi_sess = NULL;
     ogs_sock_t *sock = NULL;
     ogs_sock_t *new = NULL;
@@ -514,7 +885,7 @@ static void accept_handler(short when, ogs_socket_t fd, void *data)
     ogs_assert(data);
     ogs_assert(fd != INVALID_SOCKET);
 
-    sock = server->node.sock;
+    sock = worker->sock;
 
     new = ogs_sock_accept(sock);
     if (!new) {
@@ -531,10 +902,10 @@ static void accept_handler(short when, ogs_socket_t fd, void *data)
         return;
     }
 
-    sbi_sess = session_add(server, new);
+    sbi_sess = session_add(worker, new);
     ogs_assert(sbi_sess);
 
-    sbi_sess->poll.read = ogs_pollset_add(ogs_app()->pollset,
+    sbi_sess->poll.read = ogs_pollset_add(worker->pollset,
         OGS_POLLIN, new->fd, recv_handler, sbi_sess);
     ogs_assert(sbi_sess->poll.read);
 
@@ -574,6 +945,13 @@ static void recv_handler(short when, ogs_socket_t fd, void *data)
             ogs_error("nghttp2_session_mem_recv() failed (%d:%s)",
                         (int)readlen, nghttp2_strerror((int)readlen));
             session_remove(sbi_sess);
+        } else if (session_send(sbi_sess) != OGS_OK) {
+            /*
+             * Frames queued by the received ones, e.g. SETTINGS ACK,
+             * and the DATA frames resumed by WINDOW_UPDATE
+             */
+            ogs_error("session_send() failed");
+            session_remove(sbi_sess);
         }
     } else {
         if (n < 0) {
@@ -691,6 +1069,7 @@ static int on_frame_recv(nghttp2_session *session,
     ogs_sbi_session_t *sbi_sess = user_data;
 
     ogs_sbi_server_t *server = NULL;
+    ogs_sbi_worker_t *worker = NULL;
     ogs_sbi_stream_t *stream = NULL;
     ogs_sbi_request_t *request = NULL;
 
@@ -698,6 +1077,8 @@ static int on_frame_recv(nghttp2_session *session,
     server = sbi_sess->server;
     ogs_assert(server);
     ogs_assert(server->cb);
+    worker = sbi_sess->worker;
+    ogs_assert(worker);
 
     ogs_assert(session);
     ogs_assert(frame);
@@ -768,6 +1149,30 @@ static int on_frame_recv(nghttp2_session *session,
                 ogs_debug("%s", request->http.content);
             }
 
+            stream->pending = true;
+
+            if (server->worker_cb) {
+                rv = server->worker_cb(request, stream);
+                if (rv == OGS_OK)
+                    break;
+                if (rv != OGS_DONE) {
+                    ogs_warn("server callback error");
+                    ogs_sbi_server_send_error(stream,
+                            OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR, NULL,
+                            "server callback error", NULL);
+                    return 0;
+                }
+            }
+
+            if (worker->thread) {
+                ogs_assert(ogs_queue_push(
+                            worker->request.queue, stream) == OGS_OK);
+                if (__atomic_exchange_n(&worker->request.notified,
+                            1, __ATOMIC_ACQ_REL) == 0)
+                    ogs_send(worker->request.fd[1], "", 1, 0);
+                break;
+            }
+
             if (server->cb(request, stream) != OGS_OK) {
                 ogs_warn("server callback error");
                 ogs_sbi_server_send_error(stream,
@@ -1103,7 +1508,6 @@ static int on_send_data(nghttp2_session *session, nghttp2_frame *frame,
 
     ogs_sbi_response_t *response = NULL;
     ogs_sbi_stream_t *stream = NULL;
-    ogs_pkbuf_t *pkbuf = NULL;
     size_t padlen = 0;
 
     ogs_assert(session);
@@ -1127,26 +1531,25 @@ static int on_send_data(nghttp2_session *session, nghttp2_frame *frame,
     ogs_assert(framehd);
     ogs_assert(length);
 
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
-    ogs_assert(pkbuf);
-    ogs_pkbuf_put_data(pkbuf, framehd, 9);
+    session_write_to_buffer(sbi_sess, framehd, 9);
 
     padlen = frame->data.padlen;
 
     if (padlen > 0) {
-        ogs_pkbuf_put_u8(pkbuf, padlen-1);
+        uint8_t padlen_octet = padlen-1;
+        session_write_to_buffer(sbi_sess, &padlen_octet, 1);
     }
 
-    ogs_pkbuf_put_data(pkbuf,
-            response->http.content, response->http.content_length);
+    ogs_assert(stream->offset + length <= response->http.content_length);
+    session_write_to_buffer(sbi_sess,
+            (const uint8_t *)response->http.content + stream->offset, length);
+    stream->offset += length;
 
     if (padlen > 0) {
-        memset(pkbuf->tail, 0, padlen-1);
-        ogs_pkbuf_put(pkbuf, padlen-1);
+        static const uint8_t padding[256];
+        session_write_to_buffer(sbi_sess, padding, padlen-1);
     }
 
-    session_write_to_buffer(sbi_sess, pkbuf);
-
     return 0;
 }
 #else
@@ -1157,8 +1560,6 @@ static ssize_t send_callback(nghttp2_session *session, const uint8_t *data,
     ogs_sock_t *sock = NULL;
     ogs_socket_t fd = INVALID_SOCKET;
 
-    ogs_pkbuf_t *pkbuf = NULL;
-
     ogs_assert(sbi_sess);
     sock = sbi_sess->sock;
     ogs_assert(sock);
@@ -1168,11 +1569,7 @@ static ssize_t send_callback(nghttp2_session *session, const uint8_t *data,
     ogs_assert(data);
     ogs_assert(length);
 
-    pkbuf = ogs_pkbuf_alloc(NULL, length);
-    ogs_assert(pkbuf);
-    ogs_pkbuf_put_data(pkbuf, data, length);
-
-    session_write_to_buffer(sbi_sess, pkbuf);
+    session_write_to_buffer(sbi_sess, data, length);
 
     return length;
 }
@@ -1180,9 +1577,7 @@ static ssize_t send_callback(nghttp2_session *session, const uint8_t *data,
 
 static int session_send(ogs_sbi_session_t *sbi_sess)
 {
-#if USE_SEND_DATA_WITH_NO_COPY
-    ogs_pkbuf_t *pkbuf = NULL;
-#else
+#if !USE_SEND_DATA_WITH_NO_COPY
     int rv;
 #endif
 
@@ -1205,11 +1600,7 @@ static int session_send(ogs_sbi_session_t *sbi_sess)
             break;
         }
 
-        pkbuf = ogs_pkbuf_alloc(NULL, data_len);
-        ogs_assert(pkbuf);
-        ogs_pkbuf_put_data(pkbuf, data, data_len);
-
-        session_write_to_buffer(sbi_sess, pkbuf);
+        session_write_to_buffer(sbi_sess, data, data_len);
     }
 #else
     rv = nghttp2_session_send(sbi_sess->session);
@@ -1220,40 +1611,57 @@ static int session_send(ogs_sbi_session_t *sbi_sess)
     }
 #endif
 
+    session_flush(sbi_sess);
+
     return OGS_OK;
 }
 
 static void session_write_callback(short when, ogs_socket_t fd, void *data)
 {
     ogs_sbi_session_t *sbi_sess = data;
+
+    ogs_assert(sbi_sess);
+
+    session_flush(sbi_sess);
+}
+
+static void session_write_to_buffer(
+        ogs_sbi_session_t *sbi_sess, const uint8_t *data, size_t len)
+{
     ogs_pkbuf_t *pkbuf = NULL;
+    size_t n;
 
     ogs_assert(sbi_sess);
+    ogs_assert(data);
 
-    if (ogs_list_empty(&sbi_sess->write_queue) == true) {
-        ogs_assert(sbi_sess->poll.write);
-        ogs_pollset_remove(sbi_sess->poll.write);
-        sbi_sess->poll.write = NULL;
-        return;
-    }
+    pkbuf = ogs_list_last(&sbi_sess->write_queue);
 
-    pkbuf = ogs_list_first(&sbi_sess->write_queue);
-    ogs_assert(pkbuf);
-    ogs_list_remove(&sbi_sess->write_queue, pkbuf);
+    while (len) {
+        if (!pkbuf || ogs_pkbuf_tailroom(pkbuf) == 0) {
+            pkbuf = ogs_pkbuf_alloc(NULL,
+                    ogs_max(len, OGS_SBI_WRITE_BUFFER_LEN));
+            ogs_assert(pkbuf);
+            ogs_list_add(&sbi_sess->write_queue, pkbuf);
+        }
 
-    ogs_send(fd, pkbuf->data, pkbuf->len, 0);
-    ogs_log_hexdump(OGS_LOG_DEBUG, pkbuf->data, pkbuf->len);
+        n = ogs_min(len, ogs_pkbuf_tailroom(pkbuf));
+        ogs_pkbuf_put_data(pkbuf, data, n);
 
-    ogs_pkbuf_free(pkbuf);
+        data += n;
+        len -= n;
+    }
 }
 
-static void session_write_to_buffer(
-        ogs_sbi_session_t *sbi_sess, ogs_pkbuf_t *pkbuf)
+static void session_flush(ogs_sbi_session_t *sbi_sess)
 {
     ogs_sock_t *sock = NULL;
     ogs_socket_t fd = INVALID_SOCKET;
 
-    ogs_assert(pkbuf);
+    struct iovec iov[OGS_SBI_MAX_NUM_OF_IOV];
+    struct msghdr msg;
+    ogs_pkbuf_t *pkbuf = NULL, *next_pkbuf = NULL;
+    ssize_t sent;
+    int n;
 
     ogs_assert(sbi_sess);
     sock = sbi_sess->sock;
@@ -1261,9 +1669,61 @@ static void session_write_to_buffer(
     fd = sock->fd;
     ogs_assert(fd != INVALID_SOCKET);
 
-    ogs_list_add(&sbi_sess->write_queue, pkbuf);
+    while (ogs_list_first(&sbi_sess->write_queue)) {
+        n = 0;
+        ogs_list_for_each(&sbi_sess->write_queue, pkbuf) {
+            iov[n].iov_base = pkbuf->data;
+            iov[n].iov_len = pkbuf->len;
+            if (++n == OGS_SBI_MAX_NUM_OF_IOV)
+                break;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = n;
+
+        sent = sendmsg(fd, &msg, OGS_SBI_SEND_FLAGS);
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == OGS_EAGAIN) {
+                if (!sbi_sess->poll.write)
+                    sbi_sess->poll.write = ogs_pollset_add(
+                            sbi_sess->worker->pollset, OGS_POLLOUT, fd,
+                            session_write_callback, sbi_sess);
+                return;
+            }
 
-    if (!sbi_sess->poll.write)
-        sbi_sess->poll.write = ogs_pollset_add(ogs_app()->pollset,
-            OGS_POLLOUT, fd, session_write_callback, sbi_sess);
+            /*
+             * The session is removed when the read handler
+             * sees the connection closed.
+             */
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "sendmsg() failed");
+            ogs_list_for_each_safe(
+                    &sbi_sess->write_queue, next_pkbuf, pkbuf) {
+                ogs_list_remove(&sbi_sess->write_queue, pkbuf);
+                ogs_pkbuf_free(pkbuf);
+            }
+            break;
+        }
+
+        ogs_list_for_each_safe(&sbi_sess->write_queue, next_pkbuf, pkbuf) {
+            if (sent < pkbuf->len) {
+                /* Partial write */
+                ogs_pkbuf_pull(pkbuf, sent);
+                break;
+            }
+
+            sent -= pkbuf->len;
+            ogs_list_remove(&sbi_sess->write_queue, pkbuf);
+            ogs_pkbuf_free(pkbuf);
+        }
+    }
+
+    if (sbi_sess->poll.write) {
+        ogs_pollset_remove(sbi_sess->poll.write);
+        sbi_sess->poll.write = NULL;
+    }
 }
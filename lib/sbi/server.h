@@ -42,7 +42,23 @@ typedef struct ogs_sbi_server_s {
     int (*cb)(ogs_sbi_request_t *request, void *data);
     ogs_list_t      session_list;
 
+    /*
+     * Worker threads
+     *
+     * If num_of_worker is set, each worker thread has its own SO_REUSEPORT
+     * listener and runs the HTTP/2 sessions accepted on it. The request is
+     * passed to 'cb' in the NF thread, and the response is sent back
+     * by the worker which owns the stream.
+     *
+     * 'worker_cb' is called in the worker thread before, so it must be
+     * thread-safe. It returns OGS_DONE to pass the request to 'cb',
+     * e.g. if the request needs the state of the NF.
+     */
+    int             num_of_worker;
+    int (*worker_cb)(ogs_sbi_request_t *request, void *data);
+
     void            *mhd; /* Used by MHD */
+    void            *worker; /* Used by nghttp2 */
 } ogs_sbi_server_t;
 
 typedef struct ogs_sbi_server_actions_s {
@@ -26,6 +26,7 @@
 #include "nsmf-handler.h"
 #include "nnssf-handler.h"
 #include "nas-security.h"
+#include "checkpoint.h"
 
 void amf_state_initial(ogs_fsm_t *s, amf_event_t *e)
 {
@@ -357,6 +358,7 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
                 e->amf_ue = amf_ue;
                 e->sbi.message = &sbi_message;;
 
+                amf_checkpoint_mark(amf_ue);
                 ogs_fsm_dispatch(&amf_ue->sm, e);
             } else {
                 ogs_error("UE(amf_ue) Context has already been removed");
@@ -411,6 +413,8 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
             e->sess = sess;
             e->sbi.message = &sbi_message;;
 
+            amf_checkpoint_mark(amf_ue);
+
             SWITCH(sbi_message.h.resource.component[2])
             CASE(OGS_SBI_RESOURCE_NAME_MODIFY)
                 amf_nsmf_pdusession_handle_update_sm_context(
@@ -785,6 +789,7 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
         e->amf_ue = amf_ue;
         e->nas.message = &nas_message;
 
+        amf_checkpoint_mark(amf_ue);
         ogs_fsm_dispatch(&amf_ue->sm, e);
 
         ogs_pkbuf_free(pkbuf);
@@ -794,6 +799,7 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
         ogs_assert(amf_ue);
         ogs_assert(OGS_FSM_STATE(&amf_ue->sm));
 
+        amf_checkpoint_mark(amf_ue);
         ogs_fsm_dispatch(&amf_ue->sm, e);
         break;
 
@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "amf-sm.h"
+#include "checkpoint.h"
+
+#define AMF_CHECKPOINT_VERSION          1
+#define AMF_CHECKPOINT_SLOT_SIZE        4096
+
+/*
+ * The NAS messages sent after the last flush are lost by a crash.
+ * The UE discards a NAS message with a DL NAS COUNT it has already seen,
+ * so the restored DL NAS COUNT is moved forward.
+ */
+#define AMF_CHECKPOINT_DL_COUNT_MARGIN  16
+
+static ogs_checkpoint_t *checkpoint = NULL;
+
+static void encode_session(
+        ogs_checkpoint_cursor_t *cursor, ogs_session_t *session)
+{
+    ogs_session_t copy = *session;
+
+    ogs_checkpoint_put_string(cursor, session->name);
+    copy.name = NULL;
+    OGS_CHECKPOINT_PUT(cursor, copy);
+}
+
+static int decode_session(
+        ogs_checkpoint_cursor_t *cursor, ogs_session_t *session)
+{
+    char *name = ogs_checkpoint_get_string(cursor);
+    if (!name)
+        return OGS_ERROR;
+
+    OGS_CHECKPOINT_GET(cursor, *session);
+    session->name = name;
+
+    return OGS_OK;
+}
+
+/*
+ * Only a UE in 5GMM-REGISTERED is kept. It is restored in CM-IDLE.
+ * A UE in the middle of a procedure is not worth it,
+ * since it will register again.
+ *
+ * The NF instances are not kept. The UDM, the PCF and the SMF of
+ * the sessions are discovered again on the next request.
+ */
+static int encode_ue(int index, void *buf, size_t size, void *data)
+{
+    amf_ue_t *amf_ue = NULL;
+    amf_sess_t *sess = NULL;
+    ogs_checkpoint_cursor_t cursor;
+    uint32_t m_tmsi_index;
+    uint8_t guami_index, num_of_sess = 0, nhcc;
+    int i, j;
+
+    amf_ue = amf_ue_find_by_teid(index);
+    if (!amf_ue)
+        return 0;
+
+    if (!OGS_FSM_CHECK(&amf_ue->sm, gmm_state_registered) ||
+        !SECURITY_CONTEXT_IS_VALID(amf_ue) ||
+        !amf_ue->supi || !amf_ue->current.m_tmsi || !amf_ue->guami)
+        return 0;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, size);
+
+    ogs_checkpoint_put_string(&cursor, amf_ue->supi);
+    ogs_checkpoint_put_string(&cursor, amf_ue->suci);
+    ogs_checkpoint_put_string(&cursor, amf_ue->pei);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nas_mobile_identity_suci);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->masked_imeisv);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->masked_imeisv_len);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->imeisv_bcd);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nas_mobile_identity_imeisv);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->num_of_msisdn);
+    for (i = 0; i < amf_ue->num_of_msisdn; i++)
+        ogs_checkpoint_put_string(&cursor, amf_ue->msisdn[i]);
+
+    guami_index = amf_ue->guami - amf_self()->served_guami;
+    m_tmsi_index = ogs_pool_index(&amf_self()->m_tmsi, amf_ue->current.m_tmsi);
+    OGS_CHECKPOINT_PUT(&cursor, guami_index);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->current.guti);
+    OGS_CHECKPOINT_PUT(&cursor, m_tmsi_index);
+
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nr_tai);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nr_cgi);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->ue_location_timestamp);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->last_visited_plmn_id);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->ue_usage_setting);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->requested_nssai);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->allowed_nssai);
+    ogs_checkpoint_put_string(&cursor, amf_ue->policy_association_id);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->gmm_capability);
+
+    /* Security Context */
+    nhcc = amf_ue->nhcc;
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nas.access_type);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nas.data);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->ue_security_capability);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->ue_network_capability);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->abba);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->abba_len);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->kamf);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->knas_int);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->knas_enc);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->dl_count);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->ul_count.i32);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->kgnb);
+    OGS_CHECKPOINT_PUT(&cursor, nhcc);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->nh);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->selected_enc_algorithm);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->selected_int_algorithm);
+
+    /* SubscribedInfo */
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->ue_ambr);
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->num_of_slice);
+    for (i = 0; i < amf_ue->num_of_slice; i++) {
+        ogs_slice_data_t *slice = &amf_ue->slice[i];
+
+        OGS_CHECKPOINT_PUT(&cursor, slice->s_nssai);
+        OGS_CHECKPOINT_PUT(&cursor, slice->default_indicator);
+        OGS_CHECKPOINT_PUT(&cursor, slice->context_identifier);
+        OGS_CHECKPOINT_PUT(&cursor, slice->num_of_session);
+        for (j = 0; j < slice->num_of_session; j++)
+            encode_session(&cursor, &slice->session[j]);
+    }
+    OGS_CHECKPOINT_PUT(&cursor, amf_ue->am_policy_control_features);
+
+    /* The sessions established in the SMF */
+    ogs_list_for_each(&amf_ue->sess_list, sess)
+        if (SESSION_CONTEXT_IN_SMF(sess) && sess->dnn) num_of_sess++;
+
+    OGS_CHECKPOINT_PUT(&cursor, num_of_sess);
+    ogs_list_for_each(&amf_ue->sess_list, sess) {
+        if (!SESSION_CONTEXT_IN_SMF(sess) || !sess->dnn)
+            continue;
+
+        OGS_CHECKPOINT_PUT(&cursor, sess->psi);
+        OGS_CHECKPOINT_PUT(&cursor, sess->pti);
+        ogs_checkpoint_put_string(&cursor, sess->sm_context_ref);
+        ogs_checkpoint_put_string(&cursor, sess->dnn);
+        OGS_CHECKPOINT_PUT(&cursor, sess->s_nssai);
+        OGS_CHECKPOINT_PUT(&cursor, sess->mapped_hplmn);
+    }
+
+    if (cursor.overflow) {
+        ogs_error("[%s] Cannot checkpoint the UE", amf_ue->supi);
+        return 0;
+    }
+
+    return cursor.pos - (uint8_t *)buf;
+}
+
+/*
+ * A UE that cannot be decoded stays in 5GMM-DEREGISTERED,
+ * and is removed by amf_checkpoint_open() once the pools are restored.
+ */
+static int decode_ue(int index, const void *buf, size_t length, void *data)
+{
+    amf_ue_t *amf_ue = NULL;
+    amf_sess_t *sess = NULL;
+    ogs_checkpoint_cursor_t cursor;
+    uint32_t m_tmsi_index;
+    uint8_t guami_index, num_of_sess, nhcc;
+    char *supi = NULL;
+    int i, j, num_of_msisdn, num_of_slice;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, length);
+
+    /*
+     * amf_ue_set_supi() does not remove the other UE with the same SUPI,
+     * so it is checked here.
+     */
+    supi = ogs_checkpoint_get_string(&cursor);
+    if (!supi)
+        return OGS_ERROR;
+    if (amf_ue_find_by_supi(supi)) {
+        ogs_warn("[%s] Duplicated checkpoint", supi);
+        ogs_free(supi);
+        return OGS_ERROR;
+    }
+
+    amf_ue = amf_ue_restore(index);
+    if (!amf_ue) {
+        ogs_free(supi);
+        return OGS_ERROR;
+    }
+
+    amf_ue_set_supi(amf_ue, supi);
+    ogs_free(supi);
+
+    amf_ue->suci = ogs_checkpoint_get_string(&cursor);
+    if (amf_ue->suci)
+        ogs_hash_set(amf_self()->suci_hash,
+                amf_ue->suci, strlen(amf_ue->suci), amf_ue);
+    amf_ue->pei = ogs_checkpoint_get_string(&cursor);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nas_mobile_identity_suci);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->masked_imeisv);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->masked_imeisv_len);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->imeisv_bcd);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nas_mobile_identity_imeisv);
+    OGS_CHECKPOINT_GET(&cursor, num_of_msisdn);
+    if (cursor.overflow ||
+        num_of_msisdn < 0 || num_of_msisdn > OGS_MAX_NUM_OF_MSISDN)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_msisdn; i++) {
+        char *msisdn = ogs_checkpoint_get_string(&cursor);
+        if (!msisdn)
+            return OGS_ERROR;
+        amf_ue->msisdn[amf_ue->num_of_msisdn++] = msisdn;
+    }
+
+    OGS_CHECKPOINT_GET(&cursor, guami_index);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->current.guti);
+    OGS_CHECKPOINT_GET(&cursor, m_tmsi_index);
+    if (cursor.overflow || guami_index >= amf_self()->num_of_served_guami)
+        return OGS_ERROR;
+    amf_ue->guami = &amf_self()->served_guami[guami_index];
+
+    ogs_pool_restore(&amf_self()->m_tmsi,
+            &amf_ue->current.m_tmsi, m_tmsi_index);
+    if (!amf_ue->current.m_tmsi)
+        return OGS_ERROR;
+    if (*(amf_ue->current.m_tmsi) != amf_ue->current.guti.m_tmsi) {
+        ogs_warn("[%s] M-TMSI mismatch", amf_ue->supi);
+        return OGS_ERROR;
+    }
+    ogs_hash_set(amf_self()->guti_ue_hash,
+            &amf_ue->current.guti, sizeof(ogs_nas_5gs_guti_t), amf_ue);
+
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nr_tai);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nr_cgi);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->ue_location_timestamp);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->last_visited_plmn_id);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->ue_usage_setting);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->requested_nssai);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->allowed_nssai);
+    amf_ue->policy_association_id = ogs_checkpoint_get_string(&cursor);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->gmm_capability);
+
+    /* Security Context */
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nas.access_type);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nas.data);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->ue_security_capability);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->ue_network_capability);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->abba);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->abba_len);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->kamf);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->knas_int);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->knas_enc);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->dl_count);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->ul_count.i32);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->kgnb);
+    OGS_CHECKPOINT_GET(&cursor, nhcc);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->nh);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->selected_enc_algorithm);
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->selected_int_algorithm);
+    amf_ue->nhcc = nhcc;
+    amf_ue->dl_count = (amf_ue->dl_count +
+            AMF_CHECKPOINT_DL_COUNT_MARGIN) & 0xffffff; /* Use 24bit */
+
+    /* SubscribedInfo */
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->ue_ambr);
+    OGS_CHECKPOINT_GET(&cursor, num_of_slice);
+    if (cursor.overflow ||
+        num_of_slice < 0 || num_of_slice > OGS_MAX_NUM_OF_SLICE)
+        return OGS_ERROR;
+    amf_ue->num_of_slice = num_of_slice;
+    for (i = 0; i < num_of_slice; i++) {
+        ogs_slice_data_t *slice = &amf_ue->slice[i];
+        int num_of_session;
+
+        OGS_CHECKPOINT_GET(&cursor, slice->s_nssai);
+        OGS_CHECKPOINT_GET(&cursor, slice->default_indicator);
+        OGS_CHECKPOINT_GET(&cursor, slice->context_identifier);
+        OGS_CHECKPOINT_GET(&cursor, num_of_session);
+        if (cursor.overflow ||
+            num_of_session < 0 || num_of_session > OGS_MAX_NUM_OF_SESS)
+            return OGS_ERROR;
+        for (j = 0; j < num_of_session; j++) {
+            if (decode_session(&cursor,
+                    &slice->session[slice->num_of_session]) != OGS_OK)
+                return OGS_ERROR;
+            slice->num_of_session++;
+        }
+    }
+    OGS_CHECKPOINT_GET(&cursor, amf_ue->am_policy_control_features);
+
+    OGS_CHECKPOINT_GET(&cursor, num_of_sess);
+    for (i = 0; i < num_of_sess; i++) {
+        uint8_t psi;
+
+        OGS_CHECKPOINT_GET(&cursor, psi);
+        if (cursor.overflow ||
+            psi == OGS_NAS_PDU_SESSION_IDENTITY_UNASSIGNED ||
+            amf_sess_find_by_psi(amf_ue, psi))
+            return OGS_ERROR;
+
+        sess = amf_sess_add(amf_ue, psi);
+        ogs_assert(sess);
+
+        OGS_CHECKPOINT_GET(&cursor, sess->pti);
+        sess->sm_context_ref = ogs_checkpoint_get_string(&cursor);
+        sess->dnn = ogs_checkpoint_get_string(&cursor);
+        OGS_CHECKPOINT_GET(&cursor, sess->s_nssai);
+        OGS_CHECKPOINT_GET(&cursor, sess->mapped_hplmn);
+        if (!sess->sm_context_ref || !sess->dnn)
+            return OGS_ERROR;
+    }
+    if (cursor.overflow)
+        return OGS_ERROR;
+
+    amf_ue->security_context_available = 1;
+    OGS_FSM_TRAN(&amf_ue->sm, gmm_state_registered);
+
+    return OGS_OK;
+}
+
+int amf_checkpoint_open(void)
+{
+    amf_ue_t *amf_ue = NULL, *next = NULL;
+    amf_m_tmsi_t *m_tmsi = NULL;
+    size_t m_tmsi_size;
+    int rv, count;
+
+    if (!amf_self()->checkpoint.path)
+        return amf_m_tmsi_pool_generate();
+
+    /* The M-TMSI pool is kept in the user area */
+    m_tmsi_size = sizeof(amf_m_tmsi_t) * ogs_app()->max.ue;
+
+    checkpoint = ogs_checkpoint_open(amf_self()->checkpoint.path,
+            "amf", AMF_CHECKPOINT_VERSION, m_tmsi_size,
+            AMF_CHECKPOINT_SLOT_SIZE, ogs_app()->max.ue);
+    if (!checkpoint)
+        return OGS_ERROR;
+    ogs_checkpoint_set_sync(checkpoint, amf_self()->checkpoint.sync);
+
+    m_tmsi = ogs_checkpoint_user(checkpoint);
+
+    /* A generated M-TMSI is never 0 */
+    if (ogs_checkpoint_restored(checkpoint) == false || m_tmsi[0] == 0) {
+        rv = amf_m_tmsi_pool_generate();
+        if (rv != OGS_OK) return rv;
+
+        memcpy(m_tmsi, amf_self()->m_tmsi.array, m_tmsi_size);
+        return OGS_OK;
+    }
+
+    /* The GUTIs of the previous run are still in use */
+    memcpy(amf_self()->m_tmsi.array, m_tmsi, m_tmsi_size);
+
+    count = ogs_checkpoint_restore(checkpoint, decode_ue, NULL);
+    amf_ue_restore_done();
+
+    ogs_list_for_each_safe(&amf_self()->amf_ue_list, next, amf_ue) {
+        if (!OGS_FSM_CHECK(&amf_ue->sm, gmm_state_registered))
+            amf_ue_remove(amf_ue);
+    }
+
+    ogs_info("%d UEs restored from '%s'",
+            count, amf_self()->checkpoint.path);
+
+    return OGS_OK;
+}
+
+void amf_checkpoint_close(void)
+{
+    if (!checkpoint)
+        return;
+
+    amf_checkpoint_flush();
+
+    ogs_checkpoint_close(checkpoint);
+    checkpoint = NULL;
+}
+
+void amf_checkpoint_mark(amf_ue_t *amf_ue)
+{
+    ogs_assert(amf_ue);
+
+    if (checkpoint)
+        ogs_checkpoint_mark(checkpoint, amf_ue_index(amf_ue));
+}
+
+void amf_checkpoint_flush(void)
+{
+    if (checkpoint)
+        ogs_checkpoint_flush(checkpoint, encode_ue, NULL);
+}
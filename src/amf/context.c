@@ -18,6 +18,7 @@
  */
 
 #include "ngap-path.h"
+#include "checkpoint.h"
 
 static amf_context_t self;
 
@@ -60,6 +61,9 @@ void amf_context_init(void)
     ogs_pool_init(&amf_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&ran_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&amf_sess_pool, ogs_app()->pool.sess);
+    ogs_pool_set_trim(&amf_ue_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&ran_ue_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&amf_sess_pool, ogs_app()->pool.trim);
     ogs_pool_init(&self.m_tmsi, ogs_app()->max.ue);
 
     ogs_list_init(&self.gnb_list);
@@ -71,6 +75,19 @@ void amf_context_init(void)
     self.suci_hash = ogs_hash_make();
     self.supi_hash = ogs_hash_make();
 
+    self.metrics.registration_request = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "amf_registration_requests_total",
+            "Registration requests received", NULL);
+    self.metrics.registration_complete = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "amf_registration_complete_total",
+            "Registration procedures completed", NULL);
+    self.metrics.registration_reject = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "amf_registration_rejects_total",
+            "Registration rejects sent", NULL);
+    self.metrics.gnb = ogs_metrics_add_pool(&amf_gnb_pool, "amf_gnb");
+    self.metrics.ue = ogs_metrics_add_pool(&amf_ue_pool, "amf_ue");
+    self.metrics.sess = ogs_metrics_add_pool(&amf_sess_pool, "amf_sess");
+
     context_initialized = 1;
 }
 
@@ -93,6 +110,16 @@ void amf_context_final(void)
     ogs_assert(self.supi_hash);
     ogs_hash_destroy(self.supi_hash);
 
+    if (self.metrics.registration_request)
+        ogs_metrics_remove(self.metrics.registration_request);
+    if (self.metrics.registration_complete)
+        ogs_metrics_remove(self.metrics.registration_complete);
+    if (self.metrics.registration_reject)
+        ogs_metrics_remove(self.metrics.registration_reject);
+    if (self.metrics.gnb) ogs_metrics_remove(self.metrics.gnb);
+    if (self.metrics.ue) ogs_metrics_remove(self.metrics.ue);
+    if (self.metrics.sess) ogs_metrics_remove(self.metrics.sess);
+
     ogs_pool_final(&self.m_tmsi);
     ogs_pool_final(&amf_sess_pool);
     ogs_pool_final(&amf_ue_pool);
@@ -112,6 +139,7 @@ static int amf_context_prepare(void)
     self.nf_type = OpenAPI_nf_type_AMF;
 
     self.relative_capacity = 0xff;
+    self.overload.t3346 = 60;
 
     self.ngap_port = OGS_NGAP_SCTP_PORT;
 
@@ -197,6 +225,48 @@ int amf_context_parse_config(void)
                 if (!strcmp(amf_key, "relative_capacity")) {
                     const char *v = ogs_yaml_iter_value(&amf_iter);
                     if (v) self.relative_capacity = atoi(v);
+                } else if (!strcmp(amf_key, "overload")) {
+                    ogs_yaml_iter_t overload_iter;
+                    ogs_yaml_iter_recurse(&amf_iter, &overload_iter);
+
+                    while (ogs_yaml_iter_next(&overload_iter)) {
+                        const char *overload_key =
+                            ogs_yaml_iter_key(&overload_iter);
+                        const char *v = ogs_yaml_iter_value(&overload_iter);
+                        ogs_assert(overload_key);
+                        if (!strcmp(overload_key, "queue")) {
+                            if (v) self.overload.queue = atoi(v);
+                        } else if (!strcmp(overload_key, "latency")) {
+                            if (v) self.overload.latency =
+                                ogs_time_from_msec(atoll(v));
+                        } else if (!strcmp(overload_key, "pool")) {
+                            if (v) self.overload.pool = atoi(v);
+                        } else if (!strcmp(overload_key, "t3346")) {
+                            int t3346 = v ? atoi(v) : 0;
+                            if (t3346 > 0)
+                                self.overload.t3346 = t3346;
+                            else
+                                ogs_warn("Ignore t3346(%d)", t3346);
+                        } else
+                            ogs_warn("unknown key `%s`", overload_key);
+                    }
+                } else if (!strcmp(amf_key, "checkpoint")) {
+                    ogs_yaml_iter_t checkpoint_iter;
+                    ogs_yaml_iter_recurse(&amf_iter, &checkpoint_iter);
+
+                    while (ogs_yaml_iter_next(&checkpoint_iter)) {
+                        const char *checkpoint_key =
+                            ogs_yaml_iter_key(&checkpoint_iter);
+                        const char *v = ogs_yaml_iter_value(&checkpoint_iter);
+                        ogs_assert(checkpoint_key);
+                        if (!strcmp(checkpoint_key, "path")) {
+                            self.checkpoint.path = v;
+                        } else if (!strcmp(checkpoint_key, "sync")) {
+                            if (v) self.checkpoint.sync =
+                                ogs_time_from_msec(atoll(v));
+                        } else
+                            ogs_warn("unknown key `%s`", checkpoint_key);
+                    }
                 } else if (!strcmp(amf_key, "ngap")) {
                     ogs_yaml_iter_t ngap_array, ngap_iter;
                     ogs_yaml_iter_recurse(&amf_iter, &ngap_array);
@@ -850,6 +920,8 @@ amf_gnb_t *amf_gnb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     }
 
     ogs_list_init(&gnb->ran_ue_list);
+    gnb->ran_ue_ngap_id_hash = ogs_hash_make();
+    ogs_assert(gnb->ran_ue_ngap_id_hash);
 
     ogs_hash_set(self.gnb_addr_hash,
             gnb->sctp.addr, sizeof(ogs_sockaddr_t), gnb);
@@ -885,6 +957,10 @@ void amf_gnb_remove(amf_gnb_t *gnb)
             gnb->sctp.addr, sizeof(ogs_sockaddr_t), NULL);
     ogs_hash_set(self.gnb_id_hash, &gnb->gnb_id, sizeof(gnb->gnb_id), NULL);
 
+    ogs_assert(gnb->ran_ue_ngap_id_hash);
+    ogs_hash_destroy(gnb->ran_ue_ngap_id_hash);
+    gnb->ran_ue_ngap_id_hash = NULL;
+
     ogs_sctp_flush_and_destroy(&gnb->sctp);
 
     ogs_pool_free(&amf_gnb_pool, gnb);
@@ -941,6 +1017,54 @@ int amf_gnb_sock_type(ogs_sock_t *sock)
 }
 
 /** ran_ue_context handling function */
+static void ran_ue_ngap_id_hash_set(ran_ue_t *ran_ue)
+{
+    amf_gnb_t *gnb = NULL;
+
+    ogs_assert(ran_ue);
+    gnb = ran_ue->gnb;
+    ogs_assert(gnb);
+    ogs_assert(gnb->ran_ue_ngap_id_hash);
+
+    if (ran_ue->ran_ue_ngap_id == INVALID_UE_NGAP_ID)
+        return;
+
+    ogs_hash_set(gnb->ran_ue_ngap_id_hash, &ran_ue->ran_ue_ngap_id,
+            sizeof(ran_ue->ran_ue_ngap_id), ran_ue);
+}
+
+static void ran_ue_ngap_id_hash_clear(ran_ue_t *ran_ue)
+{
+    amf_gnb_t *gnb = NULL;
+
+    ogs_assert(ran_ue);
+    gnb = ran_ue->gnb;
+    ogs_assert(gnb);
+
+    /*
+     * If the gNB was removed (e.g. SCTP connection refused)
+     * before the release of its UE contexts is completed,
+     * the hash table has already been destroyed.
+     */
+    if (!gnb->ran_ue_ngap_id_hash)
+        return;
+
+    if (ran_ue->ran_ue_ngap_id == INVALID_UE_NGAP_ID)
+        return;
+
+    /*
+     * The gNB may reuse a RAN-UE-NGAP-ID while the old context
+     * is still waiting to be released. In this case, the hash already
+     * points to the newer context and must be kept as it is.
+     */
+    if (ogs_hash_get(gnb->ran_ue_ngap_id_hash, &ran_ue->ran_ue_ngap_id,
+                sizeof(ran_ue->ran_ue_ngap_id)) != ran_ue)
+        return;
+
+    ogs_hash_set(gnb->ran_ue_ngap_id_hash, &ran_ue->ran_ue_ngap_id,
+            sizeof(ran_ue->ran_ue_ngap_id), NULL);
+}
+
 ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id)
 {
     ran_ue_t *ran_ue = NULL;
@@ -973,6 +1097,7 @@ ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id)
     ran_ue->gnb = gnb;
 
     ogs_list_add(&gnb->ran_ue_list, ran_ue);
+    ran_ue_ngap_id_hash_set(ran_ue);
 
     stats_add_ran_ue();
 
@@ -984,6 +1109,7 @@ void ran_ue_remove(ran_ue_t *ran_ue)
     ogs_assert(ran_ue);
     ogs_assert(ran_ue->gnb);
 
+    ran_ue_ngap_id_hash_clear(ran_ue);
     ogs_list_remove(&ran_ue->gnb->ran_ue_list, ran_ue);
 
     ogs_assert(ran_ue->t_ng_holding);
@@ -994,33 +1120,43 @@ void ran_ue_remove(ran_ue_t *ran_ue)
     stats_remove_ran_ue();
 }
 
-void ran_ue_switch_to_gnb(ran_ue_t *ran_ue, amf_gnb_t *new_gnb)
+void ran_ue_switch_to_gnb(ran_ue_t *ran_ue,
+        amf_gnb_t *new_gnb, uint32_t new_ran_ue_ngap_id)
 {
     ogs_assert(ran_ue);
     ogs_assert(ran_ue->gnb);
     ogs_assert(new_gnb);
 
-    /* Remove from the old gnb */
+    /* Remove from the old gnb with the old RAN-UE-NGAP-ID */
+    ran_ue_ngap_id_hash_clear(ran_ue);
     ogs_list_remove(&ran_ue->gnb->ran_ue_list, ran_ue);
 
     /* Add to the new gnb */
     ogs_list_add(&new_gnb->ran_ue_list, ran_ue);
 
-    /* Switch to gnb */
+    /* Switch to gnb with the RAN-UE-NGAP-ID allocated by the new gnb */
     ran_ue->gnb = new_gnb;
+    ran_ue->ran_ue_ngap_id = new_ran_ue_ngap_id;
+    ran_ue_ngap_id_hash_set(ran_ue);
+}
+
+void ran_ue_set_ran_ue_ngap_id(ran_ue_t *ran_ue, uint32_t ran_ue_ngap_id)
+{
+    ogs_assert(ran_ue);
+
+    ran_ue_ngap_id_hash_clear(ran_ue);
+    ran_ue->ran_ue_ngap_id = ran_ue_ngap_id;
+    ran_ue_ngap_id_hash_set(ran_ue);
 }
 
 ran_ue_t *ran_ue_find_by_ran_ue_ngap_id(
         amf_gnb_t *gnb, uint32_t ran_ue_ngap_id)
 {
-    ran_ue_t *ran_ue = NULL;
-    
-    ogs_list_for_each(&gnb->ran_ue_list, ran_ue) {
-        if (ran_ue_ngap_id == ran_ue->ran_ue_ngap_id)
-            break;
-    }
+    ogs_assert(gnb);
+    ogs_assert(gnb->ran_ue_ngap_id_hash);
 
-    return ran_ue;
+    return (ran_ue_t *)ogs_hash_get(gnb->ran_ue_ngap_id_hash,
+            &ran_ue_ngap_id, sizeof(ran_ue_ngap_id));
 }
 
 ran_ue_t *ran_ue_find(uint32_t index)
@@ -1084,16 +1220,8 @@ void amf_ue_confirm_guti(amf_ue_t *amf_ue)
     amf_ue->next.m_tmsi = NULL;
 }
 
-amf_ue_t *amf_ue_add(ran_ue_t *ran_ue)
+static void amf_ue_init(amf_ue_t *amf_ue)
 {
-    amf_gnb_t *gnb = NULL;
-    amf_ue_t *amf_ue = NULL;
-
-    ogs_assert(ran_ue);
-    gnb = ran_ue->gnb;
-    ogs_assert(gnb);
-
-    ogs_pool_alloc(&amf_ue_pool, &amf_ue);
     ogs_assert(amf_ue);
     memset(amf_ue, 0, sizeof *amf_ue);
 
@@ -1134,6 +1262,21 @@ amf_ue_t *amf_ue_add(ran_ue_t *ran_ue)
     amf_ue_fsm_init(amf_ue);
 
     ogs_list_add(&self.amf_ue_list, amf_ue);
+}
+
+amf_ue_t *amf_ue_add(ran_ue_t *ran_ue)
+{
+    amf_gnb_t *gnb = NULL;
+    amf_ue_t *amf_ue = NULL;
+
+    ogs_assert(ran_ue);
+    gnb = ran_ue->gnb;
+    ogs_assert(gnb);
+
+    ogs_pool_alloc(&amf_ue_pool, &amf_ue);
+    ogs_assert(amf_ue);
+
+    amf_ue_init(amf_ue);
 
     ogs_info("[Added] Number of AMF-UEs is now %d",
             ogs_list_count(&self.amf_ue_list));
@@ -1141,12 +1284,42 @@ amf_ue_t *amf_ue_add(ran_ue_t *ran_ue)
     return amf_ue;
 }
 
+/*
+ * Warm restart : the UE is added at its index of the previous run.
+ * amf_ue_restore_done() must be called once all the UEs are restored.
+ */
+amf_ue_t *amf_ue_restore(uint32_t index)
+{
+    amf_ue_t *amf_ue = NULL;
+
+    ogs_pool_restore(&amf_ue_pool, &amf_ue, index);
+    if (!amf_ue) {
+        ogs_error("Cannot restore AMF-UE [INDEX:%d]", index);
+        return NULL;
+    }
+
+    amf_ue_init(amf_ue);
+
+    return amf_ue;
+}
+
+void amf_ue_restore_done(void)
+{
+    ogs_pool_restore_done(&amf_ue_pool);
+    ogs_pool_restore_done(&self.m_tmsi);
+
+    ogs_info("[Restored] Number of AMF-UEs is now %d",
+            ogs_list_count(&self.amf_ue_list));
+}
+
 void amf_ue_remove(amf_ue_t *amf_ue)
 {
     int i;
 
     ogs_assert(amf_ue);
 
+    amf_checkpoint_mark(amf_ue);
+
     ogs_list_remove(&self.amf_ue_list, amf_ue);
 
     amf_ue_fsm_fini(amf_ue);
@@ -1270,6 +1443,12 @@ amf_ue_t *amf_ue_find_by_teid(uint32_t teid)
     return ogs_pool_find(&amf_ue_pool, teid);
 }
 
+uint32_t amf_ue_index(amf_ue_t *amf_ue)
+{
+    ogs_assert(amf_ue);
+    return ogs_pool_index(&amf_ue_pool, amf_ue);
+}
+
 amf_ue_t *amf_ue_find_by_suci(char *suci)
 {
     ogs_assert(suci);
@@ -1601,6 +1780,8 @@ void amf_sess_remove(amf_sess_t *sess)
     ogs_assert(sess);
     ogs_assert(sess->amf_ue);
 
+    amf_checkpoint_mark(sess->amf_ue);
+
     ogs_list_remove(&sess->amf_ue->sess_list, sess);
 
     /* Free SBI object memory */
@@ -1879,6 +2060,83 @@ int amf_m_tmsi_free(amf_m_tmsi_t *m_tmsi)
     return OGS_OK;
 }
 
+/* Usage of the fullest UE/session pool in 1/100 of a percent */
+static int overload_pool_usage(void)
+{
+    int usage = 0;
+
+#define POOL_USAGE(__pOOL) \
+    (int)((uint64_t)ogs_pool_used(__pOOL) * 10000 / ogs_pool_size(__pOOL))
+    usage = ogs_max(usage, POOL_USAGE(&amf_ue_pool));
+    usage = ogs_max(usage, POOL_USAGE(&ran_ue_pool));
+    usage = ogs_max(usage, POOL_USAGE(&amf_sess_pool));
+#undef POOL_USAGE
+
+    return usage;
+}
+
+/*
+ * Called once per iteration of the main loop with the number of events
+ * found in the queue and the longest time one of them has waited.
+ *
+ * Overload Stop is sent only when every value has fallen below
+ * OVERLOAD_LOW_WATERMARK percent of its watermark, so that the gNBs
+ * are not flooded with Overload Start/Stop around a watermark.
+ */
+#define OVERLOAD_LOW_WATERMARK 80
+
+void amf_overload_check(unsigned int num_of_event, ogs_time_t latency)
+{
+    int usage;
+    amf_gnb_t *gnb = NULL;
+
+    if (!self.overload.queue && !self.overload.latency && !self.overload.pool)
+        return;
+
+    usage = overload_pool_usage();
+
+#define OVERLOAD_ABOVE(__vALUE, __wATERMARK, __pERCENT) \
+    ((__wATERMARK) != 0 && \
+     (uint64_t)(__vALUE) * 100 >= (uint64_t)(__wATERMARK) * (__pERCENT))
+#define OVERLOAD(__pERCENT) \
+    (OVERLOAD_ABOVE(num_of_event, self.overload.queue, __pERCENT) || \
+     OVERLOAD_ABOVE(latency, self.overload.latency, __pERCENT) || \
+     OVERLOAD_ABOVE(usage, self.overload.pool * 100, __pERCENT))
+
+    if (self.overload.active == false) {
+        if (!OVERLOAD(100)) return;
+        self.overload.active = true;
+    } else {
+        if (OVERLOAD(OVERLOAD_LOW_WATERMARK)) return;
+        self.overload.active = false;
+    }
+
+#undef OVERLOAD
+#undef OVERLOAD_ABOVE
+
+    ogs_warn("Overload %s [QUEUE:%u LATENCY:%lldms POOL:%d.%02d%%]",
+            self.overload.active ? "start" : "stop", num_of_event,
+            (long long)ogs_time_to_msec(latency), usage / 100, usage % 100);
+
+    ogs_list_for_each(&self.gnb_list, gnb) {
+        if (!gnb->state.ng_setup_success)
+            continue;
+
+        if (self.overload.active)
+            ngap_send_overload_start(gnb);
+        else
+            ngap_send_overload_stop(gnb);
+    }
+}
+
+/* Spread between the half and the whole of the configured value */
+int amf_overload_t3346(void)
+{
+    int t3346 = self.overload.t3346;
+
+    return t3346 / 2 + ogs_random32() % (t3346 - t3346 / 2 + 1);
+}
+
 uint8_t amf_selected_int_algorithm(amf_ue_t *amf_ue)
 {
     int i;
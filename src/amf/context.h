@@ -93,6 +93,35 @@ typedef struct amf_context_s {
     /* NGSetupResponse */
     uint8_t         relative_capacity;
 
+    /*
+     * Overload control
+     *
+     * Overload Start is sent to all gNBs once any watermark is reached,
+     * and Overload Stop once all of them are below the low watermark.
+     * In between, Registration/Service Requests in an InitialUEMessage
+     * are rejected with 5GMM cause #22 and T3346. 0 disables a watermark.
+     */
+    struct {
+        unsigned int queue;     /* Events waiting in the event queue */
+        ogs_time_t latency;     /* Time an event has waited in the queue */
+        int pool;               /* Percentage of UE/session contexts in use */
+        int t3346;              /* Maximum back-off timer(seconds) */
+
+        bool active;            /* Overload Start has been sent */
+    } overload;
+
+    /*
+     * Warm restart
+     *
+     * The registered UEs are checkpointed in 'path' after each
+     * iteration of the event loop and restored at the next start.
+     * The file is msync()-ed every 'sync', if set.
+     */
+    struct {
+        const char *path;
+        ogs_time_t sync;
+    } checkpoint;
+
     /* Generator for unique identification */
     uint64_t        amf_ue_ngap_id; /* amf_ue_ngap_id generator */
 
@@ -112,6 +141,13 @@ typedef struct amf_context_s {
     ogs_list_t      ngap_list;      /* AMF NGAP IPv4 Server List */
     ogs_list_t      ngap_list6;     /* AMF NGAP IPv6 Server List */
 
+    struct {
+        ogs_metrics_t *registration_request;
+        ogs_metrics_t *registration_complete;
+        ogs_metrics_t *registration_reject;
+
+        ogs_metrics_t *gnb, *ue, *sess;
+    } metrics;
 } amf_context_t;
 
 typedef struct amf_gnb_s {
@@ -145,6 +181,7 @@ typedef struct amf_gnb_s {
     ogs_pkbuf_t     *ng_reset_ack; /* Reset message */
 
     ogs_list_t      ran_ue_list;
+    ogs_hash_t      *ran_ue_ngap_id_hash;   /* hash table for RAN-UE-NGAP-ID */
 
 } amf_gnb_t;
 
@@ -593,7 +630,9 @@ int amf_gnb_sock_type(ogs_sock_t *sock);
 
 ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id);
 void ran_ue_remove(ran_ue_t *ran_ue);
-void ran_ue_switch_to_gnb(ran_ue_t *ran_ue, amf_gnb_t *new_gnb);
+void ran_ue_switch_to_gnb(ran_ue_t *ran_ue,
+        amf_gnb_t *new_gnb, uint32_t new_ran_ue_ngap_id);
+void ran_ue_set_ran_ue_ngap_id(ran_ue_t *ran_ue, uint32_t ran_ue_ngap_id);
 ran_ue_t *ran_ue_find_by_ran_ue_ngap_id(
         amf_gnb_t *gnb, uint32_t ran_ue_ngap_id);
 ran_ue_t *ran_ue_find(uint32_t index);
@@ -606,12 +645,15 @@ void amf_ue_confirm_guti(amf_ue_t *amf_ue);
 amf_ue_t *amf_ue_add(ran_ue_t *ran_ue);
 void amf_ue_remove(amf_ue_t *amf_ue);
 void amf_ue_remove_all(void);
+amf_ue_t *amf_ue_restore(uint32_t index);
+void amf_ue_restore_done(void);
 
 void amf_ue_fsm_init(amf_ue_t *amf_ue);
 void amf_ue_fsm_fini(amf_ue_t *amf_ue);
 
 amf_ue_t *amf_ue_find_by_guti(ogs_nas_5gs_guti_t *nas_guti);
 amf_ue_t *amf_ue_find_by_teid(uint32_t teid);
+uint32_t amf_ue_index(amf_ue_t *amf_ue);
 amf_ue_t *amf_ue_find_by_suci(char *suci);
 amf_ue_t *amf_ue_find_by_supi(char *supi);
 
@@ -707,6 +749,9 @@ int amf_m_tmsi_pool_generate(void);
 amf_m_tmsi_t *amf_m_tmsi_alloc(void);
 int amf_m_tmsi_free(amf_m_tmsi_t *tmsi);
 
+void amf_overload_check(unsigned int num_of_event, ogs_time_t latency);
+int amf_overload_t3346(void);
+
 uint8_t amf_selected_int_algorithm(amf_ue_t *amf_ue);
 uint8_t amf_selected_enc_algorithm(amf_ue_t *amf_ue);
 
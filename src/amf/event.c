@@ -41,6 +41,8 @@ amf_event_t *amf_event_new(amf_event_e id)
     memset(e, 0, sizeof(*e));
 
     e->id = id;
+    if (amf_self()->overload.latency)
+        e->timestamp = ogs_get_monotonic_time();
 
     return e;
 }
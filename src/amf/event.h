@@ -99,6 +99,8 @@ typedef struct amf_event_s {
     amf_bearer_t *bearer;
 
     ogs_timer_t *timer;
+
+    ogs_time_t timestamp;   /* Set only if overload.latency is configured */
 } amf_event_t;
 
 void amf_event_init(void);
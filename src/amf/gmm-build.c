@@ -256,6 +256,40 @@ ogs_pkbuf_t *gmm_build_service_reject(
     return ogs_nas_5gs_plain_encode(&message);
 }
 
+ogs_pkbuf_t *gmm_build_congestion_reject(uint8_t message_type, int t3346)
+{
+    ogs_nas_5gs_message_t message;
+
+    ogs_debug("    Congestion[%d] T3346[%d]", message_type, t3346);
+
+    memset(&message, 0, sizeof(message));
+    message.gmm.h.extended_protocol_discriminator =
+        OGS_NAS_EXTENDED_PROTOCOL_DISCRIMINATOR_5GMM;
+    message.gmm.h.message_type = message_type;
+
+    switch (message_type) {
+    case OGS_NAS_5GS_REGISTRATION_REJECT:
+        message.gmm.registration_reject.gmm_cause = OGS_5GMM_CAUSE_CONGESTION;
+        message.gmm.registration_reject.presencemask |=
+            OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_PRESENT;
+        ogs_nas_gprs_timer_2_from_sec(
+                &message.gmm.registration_reject.t3346_value, t3346);
+        break;
+    case OGS_NAS_5GS_SERVICE_REJECT:
+        message.gmm.service_reject.gmm_cause = OGS_5GMM_CAUSE_CONGESTION;
+        message.gmm.service_reject.presencemask |=
+            OGS_NAS_5GS_SERVICE_REJECT_T3346_VALUE_PRESENT;
+        ogs_nas_gprs_timer_2_from_sec(
+                &message.gmm.service_reject.t3346_value, t3346);
+        break;
+    default:
+        ogs_error("Invalid message type[%d]", message_type);
+        return NULL;
+    }
+
+    return ogs_nas_5gs_plain_encode(&message);
+}
+
 ogs_pkbuf_t *gmm_build_de_registration_accept(amf_ue_t *amf_ue)
 {
     ogs_nas_5gs_message_t message;
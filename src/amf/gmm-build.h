@@ -32,6 +32,7 @@ ogs_pkbuf_t *gmm_build_registration_reject(ogs_nas_5gmm_cause_t gmm_cause);
 ogs_pkbuf_t *gmm_build_service_accept(amf_ue_t *amf_ue);
 ogs_pkbuf_t *gmm_build_service_reject(
         amf_ue_t *amf_ue, ogs_nas_5gmm_cause_t gmm_cause);
+ogs_pkbuf_t *gmm_build_congestion_reject(uint8_t message_type, int t3346);
 
 ogs_pkbuf_t *gmm_build_de_registration_accept(amf_ue_t *amf_ue);
 
@@ -48,6 +48,8 @@ int gmm_handle_registration_request(amf_ue_t *amf_ue,
     ran_ue = ran_ue_cycle(amf_ue->ran_ue);
     ogs_assert(ran_ue);
 
+    ogs_metrics_inc(amf_self()->metrics.registration_request);
+
     ogs_assert(registration_request);
     registration_type = &registration_request->registration_type;
     ogs_assert(registration_type);
@@ -937,6 +937,7 @@ void gmm_state_initial_context_setup(ogs_fsm_t *s, amf_event_t *e)
         switch (nas_message->gmm.h.message_type) {
         case OGS_NAS_5GS_REGISTRATION_COMPLETE:
             ogs_info("[%s] Registration complete", amf_ue->supi);
+            ogs_metrics_inc(amf_self()->metrics.registration_complete);
 
             CLEAR_AMF_UE_TIMER(amf_ue->t3550);
 
@@ -19,6 +19,7 @@
 
 #include "sbi-path.h"
 #include "ngap-path.h"
+#include "checkpoint.h"
 
 static ogs_thread_t *thread;
 static void amf_main(void *data);
@@ -38,7 +39,7 @@ int amf_initialize()
     rv = amf_context_parse_config();
     if (rv != OGS_OK) return rv;
 
-    rv = amf_m_tmsi_pool_generate();
+    rv = amf_checkpoint_open();
     if (rv != OGS_OK) return rv;
 
     rv = ogs_log_config_domain(
@@ -89,6 +90,9 @@ void amf_terminate(void)
     ogs_thread_destroy(thread);
     ogs_timer_delete(t_termination_holding);
 
+    /* The UEs are kept for the next start */
+    amf_checkpoint_close();
+
     ngap_close();
     amf_sbi_close();
 
@@ -101,6 +105,8 @@ void amf_terminate(void)
 static void amf_main(void *data)
 {
     ogs_fsm_t amf_sm;
+    unsigned int num_of_event;
+    ogs_time_t latency;
     int rv;
 
     ogs_fsm_create(&amf_sm, amf_state_initial, amf_state_final);
@@ -123,6 +129,9 @@ static void amf_main(void *data)
          */
         ogs_timer_mgr_expire(ogs_app()->timer_mgr);
 
+        num_of_event = ogs_queue_size(ogs_app()->queue);
+        latency = 0;
+
         for ( ;; ) {
             amf_event_t *e = NULL;
 
@@ -136,9 +145,16 @@ static void amf_main(void *data)
                 break;
 
             ogs_assert(e);
+            if (e->timestamp)
+                latency = ogs_max(latency,
+                        ogs_get_monotonic_time() - e->timestamp);
+
             ogs_fsm_dispatch(&amf_sm, e);
             amf_event_free(e);
         }
+
+        amf_overload_check(num_of_event, latency);
+        amf_checkpoint_flush();
     }
 done:
 
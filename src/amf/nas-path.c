@@ -155,6 +155,8 @@ void nas_5gs_send_registration_reject(
 
     ogs_warn("[%s] Registration reject [%d]", amf_ue->suci, gmm_cause);
 
+    ogs_metrics_inc(amf_self()->metrics.registration_reject);
+
     gmmbuf = gmm_build_registration_reject(gmm_cause);
     ogs_expect_or_return(gmmbuf);
 
@@ -241,6 +243,35 @@ void nas_5gs_send_service_reject(
     ogs_expect(rv == OGS_OK);
 }
 
+void nas_5gs_send_congestion_reject(ran_ue_t *ran_ue, uint8_t message_type)
+{
+    int rv;
+    ogs_pkbuf_t *gmmbuf = NULL, *ngapbuf = NULL;
+
+    ogs_assert(ran_ue);
+
+    ogs_warn("Overload: reject [RAN_UE_NGAP_ID:%d AMF_UE_NGAP_ID:%lld]",
+            ran_ue->ran_ue_ngap_id, (long long)ran_ue->amf_ue_ngap_id);
+
+    if (message_type == OGS_NAS_5GS_REGISTRATION_REJECT)
+        ogs_metrics_inc(amf_self()->metrics.registration_reject);
+
+    gmmbuf = gmm_build_congestion_reject(message_type, amf_overload_t3346());
+    ogs_expect_or_return(gmmbuf);
+
+    ngapbuf = ngap_build_downlink_nas_transport(ran_ue, gmmbuf, false, false);
+    ogs_expect_or_return(ngapbuf);
+
+    rv = ngap_send_to_ran_ue(ran_ue, ngapbuf);
+    ogs_expect_or_return(rv == OGS_OK);
+
+    ngap_send_ran_ue_context_release_command(ran_ue,
+            NGAP_Cause_PR_misc, NGAP_CauseMisc_control_processing_overload,
+            ran_ue->amf_ue ?
+                NGAP_UE_CTX_REL_NG_REMOVE_AND_UNLINK :
+                NGAP_UE_CTX_REL_NG_CONTEXT_REMOVE, 0);
+}
+
 void nas_5gs_send_de_registration_accept(amf_ue_t *amf_ue)
 {
     ran_ue_t *ran_ue = NULL;
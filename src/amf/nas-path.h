@@ -39,6 +39,7 @@ void nas_5gs_send_registration_reject(
 void nas_5gs_send_service_accept(amf_ue_t *amf_ue);
 void nas_5gs_send_service_reject(
         amf_ue_t *amf_ue, ogs_nas_5gmm_cause_t gmm_cause);
+void nas_5gs_send_congestion_reject(ran_ue_t *ran_ue, uint8_t message_type);
 
 void nas_5gs_send_de_registration_accept(amf_ue_t *amf_ue);
 
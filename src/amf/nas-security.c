@@ -18,6 +18,7 @@
  */
 
 #include "nas-security.h"
+#include "checkpoint.h"
 
 #define NAS_SECURITY_DOWNLINK_DIRECTION 1
 #define NAS_SECURITY_UPLINK_DIRECTION 0
@@ -108,6 +109,7 @@ ogs_pkbuf_t *nas_5gs_security_encode(
 
     /* increase dl_count */
     amf_ue->dl_count = (amf_ue->dl_count + 1) & 0xffffff; /* Use 24bit */
+    amf_checkpoint_mark(amf_ue);
 
     /* encode all security header */
     ogs_assert(ogs_pkbuf_push(new, 6));
@@ -367,9 +367,7 @@ ogs_pkbuf_t *ngap_build_downlink_nas_transport(
     *RAN_UE_NGAP_ID = ran_ue->ran_ue_ngap_id;
 
     NAS_PDU->size = gmmbuf->len;
-    NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
-    memcpy(NAS_PDU->buf, gmmbuf->data, NAS_PDU->size);
-    ogs_pkbuf_free(gmmbuf);
+    NAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
 
     if (ue_ambr && (amf_ue->ue_ambr.downlink || amf_ue->ue_ambr.uplink)) {
         ogs_assert(amf_ue);
@@ -729,9 +727,7 @@ ogs_pkbuf_t *ngap_ue_build_initial_context_setup_request(
         NAS_PDU = &ie->value.choice.NAS_PDU;
 
         NAS_PDU->size = gmmbuf->len;
-        NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
-        memcpy(NAS_PDU->buf, gmmbuf->data, NAS_PDU->size);
-        ogs_pkbuf_free(gmmbuf);
+        NAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
     }
 
     return ogs_ngap_encode(&pdu);
@@ -857,9 +853,7 @@ ogs_pkbuf_t *ngap_sess_build_initial_context_setup_request(
             ogs_assert(nAS_PDU);
 
             nAS_PDU->size = gmmbuf->len;
-            nAS_PDU->buf = CALLOC(nAS_PDU->size, sizeof(uint8_t));
-            memcpy(nAS_PDU->buf, gmmbuf->data, nAS_PDU->size);
-            ogs_pkbuf_free(gmmbuf);
+            nAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
         }
 
         PDUSessionItem->pDUSessionID = sess->psi;
@@ -1169,9 +1163,7 @@ ogs_pkbuf_t *ngap_ue_build_pdu_session_resource_setup_request(
         NAS_PDU = &ie->value.choice.NAS_PDU;
 
         NAS_PDU->size = gmmbuf->len;
-        NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
-        memcpy(NAS_PDU->buf, gmmbuf->data, NAS_PDU->size);
-        ogs_pkbuf_free(gmmbuf);
+        NAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
     }
 
     ogs_list_for_each(&amf_ue->sess_list, sess) {
@@ -1310,10 +1302,7 @@ ogs_pkbuf_t *ngap_sess_build_pdu_session_resource_setup_request(
         PDUSessionItem->pDUSessionNAS_PDU =
             pDUSessionNAS_PDU = CALLOC(1, sizeof(NGAP_NAS_PDU_t));
         pDUSessionNAS_PDU->size = gmmbuf->len;
-        pDUSessionNAS_PDU->buf =
-            CALLOC(pDUSessionNAS_PDU->size, sizeof(uint8_t));
-        memcpy(pDUSessionNAS_PDU->buf, gmmbuf->data, pDUSessionNAS_PDU->size);
-        ogs_pkbuf_free(gmmbuf);
+        pDUSessionNAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
     }
 
     s_NSSAI = &PDUSessionItem->s_NSSAI;
@@ -1420,9 +1409,7 @@ ogs_pkbuf_t *ngap_build_pdu_session_resource_modify_request(
 
     PDUSessionItem->nAS_PDU = nAS_PDU = CALLOC(1, sizeof(NGAP_NAS_PDU_t));
     nAS_PDU->size = gmmbuf->len;
-    nAS_PDU->buf = CALLOC(nAS_PDU->size, sizeof(uint8_t));
-    memcpy(nAS_PDU->buf, gmmbuf->data, nAS_PDU->size);
-    ogs_pkbuf_free(gmmbuf);
+    nAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
 
     transfer = &PDUSessionItem->pDUSessionResourceModifyRequestTransfer;
     transfer->size = n2smbuf->len;
@@ -1514,9 +1501,7 @@ ogs_pkbuf_t *ngap_build_pdu_session_resource_release_command(
         NAS_PDU = &ie->value.choice.NAS_PDU;
 
         NAS_PDU->size = gmmbuf->len;
-        NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
-        memcpy(NAS_PDU->buf, gmmbuf->data, NAS_PDU->size);
-        ogs_pkbuf_free(gmmbuf);
+        NAS_PDU->buf = ogs_pkbuf_to_mem(gmmbuf);
     }
 
     ie = CALLOC(1, sizeof(NGAP_PDUSessionResourceReleaseCommandIEs_t));
@@ -1664,6 +1649,68 @@ ogs_pkbuf_t *ngap_build_downlink_ran_configuration_transfer(
     return ogs_ngap_encode(&pdu);
 }
 
+ogs_pkbuf_t *ngap_build_overload_start(NGAP_OverloadAction_t action)
+{
+    NGAP_NGAP_PDU_t pdu;
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+    NGAP_OverloadStart_t *OverloadStart = NULL;
+
+    NGAP_OverloadStartIEs_t *ie = NULL;
+    NGAP_OverloadResponse_t *OverloadResponse = NULL;
+
+    ogs_debug("OverloadStart");
+    ogs_debug("    Action[%d]", (int)action);
+
+    memset(&pdu, 0, sizeof (NGAP_NGAP_PDU_t));
+    pdu.present = NGAP_NGAP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(NGAP_InitiatingMessage_t));
+    ogs_assert(pdu.choice.initiatingMessage);
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode = NGAP_ProcedureCode_id_OverloadStart;
+    initiatingMessage->criticality = NGAP_Criticality_ignore;
+    initiatingMessage->value.present =
+        NGAP_InitiatingMessage__value_PR_OverloadStart;
+
+    OverloadStart = &initiatingMessage->value.choice.OverloadStart;
+
+    ie = CALLOC(1, sizeof(NGAP_OverloadStartIEs_t));
+    ogs_assert(ie);
+    ASN_SEQUENCE_ADD(&OverloadStart->protocolIEs, ie);
+
+    ie->id = NGAP_ProtocolIE_ID_id_AMFOverloadResponse;
+    ie->criticality = NGAP_Criticality_reject;
+    ie->value.present = NGAP_OverloadStartIEs__value_PR_OverloadResponse;
+
+    OverloadResponse = &ie->value.choice.OverloadResponse;
+
+    OverloadResponse->present = NGAP_OverloadResponse_PR_overloadAction;
+    OverloadResponse->choice.overloadAction = action;
+
+    return ogs_ngap_encode(&pdu);
+}
+
+ogs_pkbuf_t *ngap_build_overload_stop(void)
+{
+    NGAP_NGAP_PDU_t pdu;
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+
+    ogs_debug("OverloadStop");
+
+    memset(&pdu, 0, sizeof (NGAP_NGAP_PDU_t));
+    pdu.present = NGAP_NGAP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(NGAP_InitiatingMessage_t));
+    ogs_assert(pdu.choice.initiatingMessage);
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode = NGAP_ProcedureCode_id_OverloadStop;
+    initiatingMessage->criticality = NGAP_Criticality_reject;
+    initiatingMessage->value.present =
+        NGAP_InitiatingMessage__value_PR_OverloadStop;
+
+    return ogs_ngap_encode(&pdu);
+}
+
 ogs_pkbuf_t *ngap_build_path_switch_ack(amf_ue_t *amf_ue)
 {
     int i;
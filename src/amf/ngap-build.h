@@ -58,6 +58,9 @@ ogs_pkbuf_t *ngap_build_paging(amf_ue_t *amf_ue);
 ogs_pkbuf_t *ngap_build_downlink_ran_configuration_transfer(
     NGAP_SONConfigurationTransfer_t *transfer);
 
+ogs_pkbuf_t *ngap_build_overload_start(NGAP_OverloadAction_t action);
+ogs_pkbuf_t *ngap_build_overload_stop(void);
+
 ogs_pkbuf_t *ngap_build_path_switch_ack(amf_ue_t *amf_ue);
 
 ogs_pkbuf_t *ngap_build_handover_request(ran_ue_t *target_ue);
@@ -97,6 +97,61 @@ static bool maximum_number_of_gnbs_is_reached(void)
     return number_of_gnbs_online >= ogs_app()->max.gnb;
 }
 
+static uint8_t overload_reject_type(ran_ue_t *ran_ue, NGAP_NAS_PDU_t *nasPdu)
+{
+    ogs_nas_5gmm_header_t *h = NULL;
+    ogs_nas_5gs_registration_type_t *registration_type = NULL;
+    amf_ue_t *amf_ue = NULL;
+    size_t offset = 0;
+
+    ogs_assert(ran_ue);
+    ogs_assert(nasPdu);
+
+    amf_ue = ran_ue->amf_ue;
+
+    if (nasPdu->size < sizeof(ogs_nas_5gmm_header_t))
+        return 0;
+
+    h = (ogs_nas_5gmm_header_t *)nasPdu->buf;
+    if (h->extended_protocol_discriminator !=
+            OGS_NAS_EXTENDED_PROTOCOL_DISCRIMINATOR_5GMM)
+        return 0;
+
+    switch (h->security_header_type) {
+    case OGS_NAS_SECURITY_HEADER_PLAIN_NAS_MESSAGE:
+        break;
+    case OGS_NAS_SECURITY_HEADER_INTEGRITY_PROTECTED:
+    case OGS_NAS_SECURITY_HEADER_INTEGRITY_PROTECTED_AND_CIPHERED:
+        offset = sizeof(ogs_nas_5gs_security_header_t);
+        break;
+    default:
+        return 0;
+    }
+
+    if (nasPdu->size < offset + sizeof(ogs_nas_5gmm_header_t) + 1)
+        return 0;
+
+    h = (ogs_nas_5gmm_header_t *)(nasPdu->buf + offset);
+    if (h->extended_protocol_discriminator !=
+            OGS_NAS_EXTENDED_PROTOCOL_DISCRIMINATOR_5GMM)
+        return 0;
+
+    switch (h->message_type) {
+    case OGS_NAS_5GS_REGISTRATION_REQUEST:
+        registration_type = (ogs_nas_5gs_registration_type_t *)
+            (nasPdu->buf + offset + sizeof(ogs_nas_5gmm_header_t));
+        if (registration_type->value == OGS_NAS_5GS_REGISTRATION_TYPE_EMERGENCY)
+            return 0;
+        return OGS_NAS_5GS_REGISTRATION_REJECT;
+    case OGS_NAS_5GS_SERVICE_REQUEST:
+        if (amf_ue && amf_ue->t3513.pkbuf)
+            return 0;
+        return OGS_NAS_5GS_SERVICE_REJECT;
+    default:
+        return 0;
+    }
+}
+
 void ngap_handle_ng_setup_request(amf_gnb_t *gnb, ogs_ngap_message_t *message)
 {
     char buf[OGS_ADDRSTRLEN];
@@ -318,6 +373,9 @@ void ngap_handle_ng_setup_request(amf_gnb_t *gnb, ogs_ngap_message_t *message)
 
     gnb->state.ng_setup_success = true;
     ngap_send_ng_setup_response(gnb);
+
+    if (amf_self()->overload.active)
+        ngap_send_overload_start(gnb);
 }
 
 void ngap_handle_initial_ue_message(amf_gnb_t *gnb, ogs_ngap_message_t *message)
@@ -489,6 +547,14 @@ void ngap_handle_initial_ue_message(amf_gnb_t *gnb, ogs_ngap_message_t *message)
         }
     }
 
+    if (amf_self()->overload.active) {
+        uint8_t message_type = overload_reject_type(ran_ue, NAS_PDU);
+        if (message_type) {
+            nas_5gs_send_congestion_reject(ran_ue, message_type);
+            return;
+        }
+    }
+
     ngap_send_to_nas(ran_ue, NGAP_ProcedureCode_id_InitialUEMessage, NAS_PDU);
 }
 
@@ -2050,11 +2116,8 @@ void ngap_handle_path_switch_request(
     ogs_info("    [OLD] TAC[%d] CellID[0x%llx]",
         amf_ue->nr_tai.tac.v, (long long)amf_ue->nr_cgi.cell_id);
 
-    /* Update RAN-UE-NGAP-ID */
-    ran_ue->ran_ue_ngap_id = *RAN_UE_NGAP_ID;
-
-    /* Change ran_ue to the NEW gNB */
-    ran_ue_switch_to_gnb(ran_ue, gnb);
+    /* Change ran_ue to the NEW gNB and update RAN-UE-NGAP-ID */
+    ran_ue_switch_to_gnb(ran_ue, gnb, *RAN_UE_NGAP_ID);
 
     if (!UserLocationInformation) {
         ogs_error("No UserLocationInformation");
@@ -2598,7 +2661,7 @@ void ngap_handle_handover_request_ack(
         return;
     }
 
-    target_ue->ran_ue_ngap_id = *RAN_UE_NGAP_ID;
+    ran_ue_set_ran_ue_ngap_id(target_ue, *RAN_UE_NGAP_ID);
 
     source_ue = target_ue->source_ue;
     if (!source_ue) {
@@ -438,6 +438,36 @@ void ngap_send_downlink_ran_configuration_transfer(
     ogs_expect(rv == OGS_OK);
 }
 
+void ngap_send_overload_start(amf_gnb_t *gnb)
+{
+    int rv;
+    ogs_pkbuf_t *ngapbuf = NULL;
+
+    ogs_assert(gnb);
+
+    /* Emergency registration and paging responses are still accepted */
+    ngapbuf = ngap_build_overload_start(
+        NGAP_OverloadAction_permit_emergency_sessions_and_mobile_terminated_services_only);
+    ogs_expect_or_return(ngapbuf);
+
+    rv = ngap_send_to_gnb(gnb, ngapbuf, NGAP_NON_UE_SIGNALLING);
+    ogs_expect(rv == OGS_OK);
+}
+
+void ngap_send_overload_stop(amf_gnb_t *gnb)
+{
+    int rv;
+    ogs_pkbuf_t *ngapbuf = NULL;
+
+    ogs_assert(gnb);
+
+    ngapbuf = ngap_build_overload_stop();
+    ogs_expect_or_return(ngapbuf);
+
+    rv = ngap_send_to_gnb(gnb, ngapbuf, NGAP_NON_UE_SIGNALLING);
+    ogs_expect(rv == OGS_OK);
+}
+
 void ngap_send_path_switch_ack(amf_sess_t *sess)
 {
     int rv;
@@ -70,6 +70,9 @@ void ngap_send_pdu_resource_setup_request(
 void ngap_send_downlink_ran_configuration_transfer(
         amf_gnb_t *target_gnb, NGAP_SONConfigurationTransfer_t *transfer);
 
+void ngap_send_overload_start(amf_gnb_t *gnb);
+void ngap_send_overload_stop(amf_gnb_t *gnb);
+
 void ngap_send_path_switch_ack(amf_sess_t *sess);
 
 void ngap_send_handover_request(amf_ue_t *amf_ue);
@@ -535,6 +535,51 @@ ogs_pkbuf_t *emm_build_service_reject(
     return ogs_nas_eps_plain_encode(&message);
 }
 
+/*
+ * Attach/TAU/Service Reject with EMM cause #22(Congestion) and T3346,
+ * built before the UE context is known, so it is never protected.
+ */
+ogs_pkbuf_t *emm_build_congestion_reject(uint8_t message_type, int t3346)
+{
+    ogs_nas_eps_message_t message;
+
+    ogs_debug("    Congestion[%d] T3346[%d]", message_type, t3346);
+
+    memset(&message, 0, sizeof(message));
+    message.emm.h.protocol_discriminator = OGS_NAS_PROTOCOL_DISCRIMINATOR_EMM;
+    message.emm.h.message_type = message_type;
+
+    switch (message_type) {
+    case OGS_NAS_EPS_ATTACH_REJECT:
+        message.emm.attach_reject.emm_cause = EMM_CAUSE_CONGESTION;
+        message.emm.attach_reject.presencemask |=
+            OGS_NAS_EPS_ATTACH_REJECT_T3346_VALUE_PRESENT;
+        ogs_nas_gprs_timer_2_from_sec(
+                &message.emm.attach_reject.t3346_value, t3346);
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT:
+        message.emm.tracking_area_update_reject.emm_cause =
+            EMM_CAUSE_CONGESTION;
+        message.emm.tracking_area_update_reject.presencemask |=
+            OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_T3346_VALUE_PRESENT;
+        ogs_nas_gprs_timer_2_from_sec(
+                &message.emm.tracking_area_update_reject.t3346_value, t3346);
+        break;
+    case OGS_NAS_EPS_SERVICE_REJECT:
+        message.emm.service_reject.emm_cause = EMM_CAUSE_CONGESTION;
+        message.emm.service_reject.presencemask |=
+            OGS_NAS_EPS_SERVICE_REJECT_T3346_VALUE_PRESENT;
+        ogs_nas_gprs_timer_2_from_sec(
+                &message.emm.service_reject.t3346_value, t3346);
+        break;
+    default:
+        ogs_error("Invalid message type[%d]", message_type);
+        return NULL;
+    }
+
+    return ogs_nas_eps_plain_encode(&message);
+}
+
 ogs_pkbuf_t *emm_build_cs_service_notification(mme_ue_t *mme_ue)
 {
     ogs_nas_eps_message_t message;
@@ -46,6 +46,8 @@ ogs_pkbuf_t *emm_build_tau_reject(
 ogs_pkbuf_t *emm_build_service_reject(
         ogs_nas_emm_cause_t emm_cause, mme_ue_t *mme_ue);
 
+ogs_pkbuf_t *emm_build_congestion_reject(uint8_t message_type, int t3346);
+
 ogs_pkbuf_t *emm_build_cs_service_notification(mme_ue_t *mme_ue);
 ogs_pkbuf_t *emm_build_downlink_nas_transport(
         mme_ue_t *mme_ue, uint8_t *buffer, uint8_t length);
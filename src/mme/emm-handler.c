@@ -54,6 +54,8 @@ int emm_handle_attach_request(mme_ue_t *mme_ue,
     enb_ue = enb_ue_cycle(mme_ue->enb_ue);
     ogs_assert(enb_ue);
 
+    ogs_metrics_inc(mme_self()->metrics.attach_request);
+
     ogs_assert(esm_message_container);
     ogs_assert(esm_message_container->length);
 
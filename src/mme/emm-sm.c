@@ -956,6 +956,7 @@ void emm_state_initial_context_setup(ogs_fsm_t *s, mme_event_t *e)
         switch (message->emm.h.message_type) {
         case OGS_NAS_EPS_ATTACH_COMPLETE:
             ogs_info("[%s] Attach complete", mme_ue->imsi_bcd);
+            ogs_metrics_inc(mme_self()->metrics.attach_complete);
 
             CLEAR_MME_UE_TIMER(mme_ue->t3450);
 
@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mme-sm.h"
+#include "mme-checkpoint.h"
+
+#define MME_CHECKPOINT_VERSION          1
+#define MME_CHECKPOINT_SLOT_SIZE        2048
+
+/*
+ * The NAS messages sent after the last flush are lost by a crash.
+ * The UE discards a NAS message with a DL NAS COUNT it has already seen,
+ * so the restored DL NAS COUNT is moved forward.
+ */
+#define MME_CHECKPOINT_DL_COUNT_MARGIN  16
+
+static ogs_checkpoint_t *checkpoint = NULL;
+
+static bool bearer_is_active(mme_bearer_t *bearer)
+{
+    return OGS_FSM_CHECK(&bearer->sm, esm_state_active);
+}
+
+static void encode_sess(ogs_checkpoint_cursor_t *cursor, mme_sess_t *sess)
+{
+    mme_bearer_t *bearer = NULL;
+    uint8_t num_of_bearer = 0;
+    uint16_t tft_len;
+
+    ogs_list_for_each(&sess->bearer_list, bearer)
+        if (bearer_is_active(bearer)) num_of_bearer++;
+
+    OGS_CHECKPOINT_PUT(cursor, sess->pti);
+    ogs_checkpoint_put_string(cursor, sess->session->name);
+    OGS_CHECKPOINT_PUT(cursor, num_of_bearer);
+
+    /* The default bearer is the first one */
+    ogs_list_for_each(&sess->bearer_list, bearer) {
+        if (!bearer_is_active(bearer))
+            continue;
+
+        OGS_CHECKPOINT_PUT(cursor, bearer->ebi);
+        OGS_CHECKPOINT_PUT(cursor, bearer->sgw_s1u_teid);
+        OGS_CHECKPOINT_PUT(cursor, bearer->sgw_s1u_ip);
+        OGS_CHECKPOINT_PUT(cursor, bearer->qos);
+
+        tft_len = bearer->tft.data ? bearer->tft.len : 0;
+        OGS_CHECKPOINT_PUT(cursor, tft_len);
+        if (tft_len)
+            ogs_checkpoint_put(cursor, bearer->tft.data, tft_len);
+    }
+}
+
+/*
+ * Only a UE in EMM-REGISTERED with a PDN connection is kept.
+ * It is restored in ECM-IDLE. A UE in the middle of a procedure
+ * is not worth it, since it will attach again.
+ */
+static int encode_ue(int index, void *buf, size_t size, void *data)
+{
+    mme_ue_t *mme_ue = NULL;
+    mme_sess_t *sess = NULL;
+    ogs_checkpoint_cursor_t cursor;
+    ogs_session_t session;
+    uint32_t m_tmsi_index;
+    uint8_t num_of_sess = 0;
+    uint8_t nhcc;
+    int i;
+
+    mme_ue = mme_ue_find_by_teid(index);
+    if (!mme_ue)
+        return 0;
+
+    if (!OGS_FSM_CHECK(&mme_ue->sm, emm_state_registered) ||
+        !SECURITY_CONTEXT_IS_VALID(mme_ue) ||
+        !MME_UE_HAVE_IMSI(mme_ue) || !mme_ue->current.m_tmsi)
+        return 0;
+
+    ogs_list_for_each(&mme_ue->sess_list, sess) {
+        mme_bearer_t *default_bearer = mme_default_bearer_in_sess(sess);
+        if (sess->session && default_bearer &&
+            bearer_is_active(default_bearer))
+            num_of_sess++;
+    }
+    if (!num_of_sess)
+        return 0;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, size);
+
+    /* The SGW is found again by its address */
+    ogs_assert(mme_ue->gnode);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->gnode->addr.sin6);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->sgw_s11_teid);
+
+    ogs_checkpoint_put_string(&cursor, mme_ue->imsi_bcd);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->imeisv);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->imeisv_len);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->masked_imeisv);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->masked_imeisv_len);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->imeisv_bcd);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->nas_mobile_identity_imeisv);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->msisdn);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->msisdn_len);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->msisdn_bcd);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->a_msisdn);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->a_msisdn_len);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->a_msisdn_bcd);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->p_tmsi);
+
+    m_tmsi_index = ogs_pool_index(&mme_self()->m_tmsi, mme_ue->current.m_tmsi);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->current.guti);
+    OGS_CHECKPOINT_PUT(&cursor, m_tmsi_index);
+
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->tai);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->e_cgi);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->last_visited_plmn_id);
+
+    /* Security Context */
+    nhcc = mme_ue->nhcc;
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->nas_eps.ksi);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->ue_network_capability);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->ms_network_capability);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->ue_additional_security_capability);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->kasme);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->knas_int);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->knas_enc);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->dl_count);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->ul_count.i32);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->kenb);
+    OGS_CHECKPOINT_PUT(&cursor, nhcc);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->nh);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->selected_enc_algorithm);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->selected_int_algorithm);
+
+    /* HSS Info */
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->ambr);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->context_identifier);
+    OGS_CHECKPOINT_PUT(&cursor, mme_ue->num_of_session);
+    for (i = 0; i < mme_ue->num_of_session; i++) {
+        session = mme_ue->session[i];
+        ogs_checkpoint_put_string(&cursor, session.name);
+        session.name = NULL;
+        OGS_CHECKPOINT_PUT(&cursor, session);
+    }
+
+    /* ESM Info */
+    OGS_CHECKPOINT_PUT(&cursor, num_of_sess);
+    ogs_list_for_each(&mme_ue->sess_list, sess) {
+        mme_bearer_t *default_bearer = mme_default_bearer_in_sess(sess);
+        if (sess->session && default_bearer &&
+            bearer_is_active(default_bearer))
+            encode_sess(&cursor, sess);
+    }
+
+    if (cursor.overflow) {
+        ogs_error("[%s] Cannot checkpoint the UE", mme_ue->imsi_bcd);
+        return 0;
+    }
+
+    return cursor.pos - (uint8_t *)buf;
+}
+
+static int decode_sess(ogs_checkpoint_cursor_t *cursor, mme_ue_t *mme_ue)
+{
+    mme_sess_t *sess = NULL;
+    mme_bearer_t *bearer = NULL;
+    uint8_t pti, num_of_bearer;
+    uint16_t tft_len;
+    char *apn = NULL;
+    int i;
+
+    OGS_CHECKPOINT_GET(cursor, pti);
+    apn = ogs_checkpoint_get_string(cursor);
+    OGS_CHECKPOINT_GET(cursor, num_of_bearer);
+    if (cursor->overflow || !apn ||
+        pti == OGS_NAS_PROCEDURE_TRANSACTION_IDENTITY_UNASSIGNED ||
+        num_of_bearer == 0 ||
+        num_of_bearer > MAX_EPS_BEARER_ID - MIN_EPS_BEARER_ID + 1) {
+        if (apn)
+            ogs_free(apn);
+        return OGS_ERROR;
+    }
+
+    sess = mme_sess_add(mme_ue, pti);
+    ogs_assert(sess);
+    sess->session = mme_session_find_by_apn(mme_ue, apn);
+    ogs_free(apn);
+    if (!sess->session)
+        return OGS_ERROR;
+
+    bearer = mme_default_bearer_in_sess(sess);
+    for (i = 0; i < num_of_bearer; i++) {
+        if (i > 0)
+            bearer = mme_bearer_add(sess);
+        ogs_assert(bearer);
+
+        OGS_CHECKPOINT_GET(cursor, bearer->ebi);
+        OGS_CHECKPOINT_GET(cursor, bearer->sgw_s1u_teid);
+        OGS_CHECKPOINT_GET(cursor, bearer->sgw_s1u_ip);
+        OGS_CHECKPOINT_GET(cursor, bearer->qos);
+
+        OGS_CHECKPOINT_GET(cursor, tft_len);
+        if (cursor->overflow || tft_len > cursor->end - cursor->pos)
+            return OGS_ERROR;
+        if (tft_len) {
+            bearer->tft.presence = 1;
+            bearer->tft.len = tft_len;
+            bearer->tft.data = ogs_calloc(tft_len, sizeof(uint8_t));
+            ogs_assert(bearer->tft.data);
+            ogs_checkpoint_get(cursor, bearer->tft.data, tft_len);
+        }
+
+        if (bearer->ebi < MIN_EPS_BEARER_ID || bearer->ebi > MAX_EPS_BEARER_ID)
+            return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
+
+static void restore_ebi(mme_ue_t *mme_ue)
+{
+    mme_sess_t *sess = NULL;
+    mme_bearer_t *bearer = NULL;
+
+    /* The bearers take the EBIs of the previous run */
+    mme_ebi_pool_clear(mme_ue);
+    ogs_list_for_each(&mme_ue->sess_list, sess) {
+        ogs_list_for_each(&sess->bearer_list, bearer) {
+            ogs_pool_restore(&mme_ue->ebi_pool, &bearer->ebi_node,
+                    bearer->ebi - MIN_EPS_BEARER_ID + 1);
+            ogs_assert(bearer->ebi_node);
+            ogs_assert(*(bearer->ebi_node) == bearer->ebi);
+
+            OGS_FSM_TRAN(&bearer->sm, esm_state_active);
+        }
+    }
+    ogs_pool_restore_done(&mme_ue->ebi_pool);
+}
+
+/*
+ * A UE that cannot be decoded stays in EMM-DEREGISTERED,
+ * and is removed by mme_checkpoint_open() once the pools are restored.
+ */
+static int decode_ue(int index, const void *buf, size_t length, void *data)
+{
+    mme_ue_t *mme_ue = NULL;
+    mme_sgw_t *sgw = NULL;
+    ogs_checkpoint_cursor_t cursor;
+    ogs_sockaddr_t addr;
+    ogs_session_t session;
+    uint32_t m_tmsi_index;
+    uint8_t num_of_sess;
+    uint8_t nhcc;
+    char *imsi_bcd = NULL;
+    int i, num_of_session;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, length);
+
+    memset(&addr, 0, sizeof(addr));
+    OGS_CHECKPOINT_GET(&cursor, addr.sin6);
+    ogs_list_for_each(&mme_self()->sgw_list, sgw) {
+        if (ogs_sockaddr_is_equal(&sgw->gnode->addr, &addr))
+            break;
+    }
+    if (!sgw) {
+        ogs_warn("No SGW for the checkpoint [TEID:%d]", index);
+        return OGS_ERROR;
+    }
+
+    mme_ue = mme_ue_restore(index, sgw->gnode);
+    if (!mme_ue)
+        return OGS_ERROR;
+
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->sgw_s11_teid);
+
+    /*
+     * mme_ue_set_imsi() would remove the other UE with the same IMSI,
+     * which cannot be done before mme_ue_restore_done().
+     */
+    imsi_bcd = ogs_checkpoint_get_string(&cursor);
+    if (!imsi_bcd)
+        return OGS_ERROR;
+    if (mme_ue_find_by_imsi_bcd(imsi_bcd)) {
+        ogs_warn("[%s] Duplicated checkpoint", imsi_bcd);
+        ogs_free(imsi_bcd);
+        return OGS_ERROR;
+    }
+    mme_ue_set_imsi(mme_ue, imsi_bcd);
+    ogs_free(imsi_bcd);
+
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->imeisv);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->imeisv_len);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->masked_imeisv);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->masked_imeisv_len);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->imeisv_bcd);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->nas_mobile_identity_imeisv);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->msisdn);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->msisdn_len);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->msisdn_bcd);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->a_msisdn);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->a_msisdn_len);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->a_msisdn_bcd);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->p_tmsi);
+
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->current.guti);
+    OGS_CHECKPOINT_GET(&cursor, m_tmsi_index);
+    if (cursor.overflow)
+        return OGS_ERROR;
+
+    ogs_pool_restore(&mme_self()->m_tmsi,
+            &mme_ue->current.m_tmsi, m_tmsi_index);
+    if (!mme_ue->current.m_tmsi)
+        return OGS_ERROR;
+    if (*(mme_ue->current.m_tmsi) != mme_ue->current.guti.m_tmsi) {
+        ogs_warn("[%s] M-TMSI mismatch", mme_ue->imsi_bcd);
+        return OGS_ERROR;
+    }
+    ogs_ihash_set(mme_self()->guti_ue_hash, &mme_ue->current.guti, mme_ue);
+
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->tai);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->e_cgi);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->last_visited_plmn_id);
+
+    /* Security Context */
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->nas_eps.ksi);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->ue_network_capability);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->ms_network_capability);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->ue_additional_security_capability);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->kasme);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->knas_int);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->knas_enc);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->dl_count);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->ul_count.i32);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->kenb);
+    OGS_CHECKPOINT_GET(&cursor, nhcc);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->nh);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->selected_enc_algorithm);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->selected_int_algorithm);
+    mme_ue->nhcc = nhcc;
+    mme_ue->dl_count = (mme_ue->dl_count +
+            MME_CHECKPOINT_DL_COUNT_MARGIN) & 0xffffff; /* Use 24bit */
+
+    /* HSS Info */
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->ambr);
+    OGS_CHECKPOINT_GET(&cursor, mme_ue->context_identifier);
+    OGS_CHECKPOINT_GET(&cursor, num_of_session);
+    if (cursor.overflow ||
+        num_of_session < 0 || num_of_session > OGS_MAX_NUM_OF_SESS)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_session; i++) {
+        char *name = ogs_checkpoint_get_string(&cursor);
+        if (!name)
+            return OGS_ERROR;
+        OGS_CHECKPOINT_GET(&cursor, session);
+        session.name = name;
+        mme_ue->session[mme_ue->num_of_session++] = session;
+    }
+
+    /* ESM Info */
+    OGS_CHECKPOINT_GET(&cursor, num_of_sess);
+    if (cursor.overflow || num_of_sess == 0)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_sess; i++) {
+        if (decode_sess(&cursor, mme_ue) != OGS_OK)
+            return OGS_ERROR;
+    }
+    if (cursor.overflow)
+        return OGS_ERROR;
+
+    restore_ebi(mme_ue);
+
+    mme_ue->security_context_available = 1;
+    OGS_FSM_TRAN(&mme_ue->sm, emm_state_registered);
+
+    return OGS_OK;
+}
+
+int mme_checkpoint_open(void)
+{
+    mme_ue_t *mme_ue = NULL, *next = NULL;
+    mme_m_tmsi_t *m_tmsi = NULL;
+    size_t m_tmsi_size;
+    int rv, count;
+
+    if (!mme_self()->checkpoint.path)
+        return mme_m_tmsi_pool_generate();
+
+    /* The M-TMSI pool is kept in the user area */
+    m_tmsi_size = sizeof(mme_m_tmsi_t) * ogs_app()->max.ue;
+
+    checkpoint = ogs_checkpoint_open(mme_self()->checkpoint.path,
+            "mme", MME_CHECKPOINT_VERSION, m_tmsi_size,
+            MME_CHECKPOINT_SLOT_SIZE, ogs_app()->max.ue);
+    if (!checkpoint)
+        return OGS_ERROR;
+    ogs_checkpoint_set_sync(checkpoint, mme_self()->checkpoint.sync);
+
+    m_tmsi = ogs_checkpoint_user(checkpoint);
+
+    /* A generated M-TMSI is never 0 */
+    if (ogs_checkpoint_restored(checkpoint) == false || m_tmsi[0] == 0) {
+        rv = mme_m_tmsi_pool_generate();
+        if (rv != OGS_OK) return rv;
+
+        memcpy(m_tmsi, mme_self()->m_tmsi.array, m_tmsi_size);
+        return OGS_OK;
+    }
+
+    /* The GUTIs of the previous run are still in use */
+    memcpy(mme_self()->m_tmsi.array, m_tmsi, m_tmsi_size);
+
+    count = ogs_checkpoint_restore(checkpoint, decode_ue, NULL);
+    mme_ue_restore_done();
+
+    ogs_list_for_each_safe(&mme_self()->mme_ue_list, next, mme_ue) {
+        if (!OGS_FSM_CHECK(&mme_ue->sm, emm_state_registered))
+            mme_ue_remove(mme_ue);
+    }
+
+    ogs_info("%d UEs restored from '%s'",
+            count, mme_self()->checkpoint.path);
+
+    return OGS_OK;
+}
+
+void mme_checkpoint_close(void)
+{
+    if (!checkpoint)
+        return;
+
+    mme_checkpoint_flush();
+
+    ogs_checkpoint_close(checkpoint);
+    checkpoint = NULL;
+}
+
+void mme_checkpoint_mark(mme_ue_t *mme_ue)
+{
+    ogs_assert(mme_ue);
+
+    if (checkpoint)
+        ogs_checkpoint_mark(checkpoint, mme_ue->mme_s11_teid);
+}
+
+void mme_checkpoint_flush(void)
+{
+    if (checkpoint)
+        ogs_checkpoint_flush(checkpoint, encode_ue, NULL);
+}
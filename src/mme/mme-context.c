@@ -26,9 +26,13 @@
 #include "s1ap-path.h"
 #include "s1ap-handler.h"
 #include "mme-sm.h"
+#include "mme-checkpoint.h"
 
 #define MAX_CELL_PER_ENB            8
 
+/* IMSI length followed by the zero-padded IMSI */
+#define IMSI_HASH_KEY_LEN           (1 + OGS_MAX_IMSI_LEN)
+
 static mme_context_t self;
 static ogs_diam_config_t g_diam_conf;
 
@@ -57,6 +61,17 @@ static void stats_remove_enb_ue(void);
 static void stats_add_mme_session(void);
 static void stats_remove_mme_session(void);
 
+static void imsi_hash_key(uint8_t *key, uint8_t *imsi, int imsi_len)
+{
+    ogs_assert(key);
+    ogs_assert(imsi);
+    ogs_assert(imsi_len > 0 && imsi_len <= OGS_MAX_IMSI_LEN);
+
+    memset(key, 0, IMSI_HASH_KEY_LEN);
+    key[0] = imsi_len;
+    memcpy(key+1, imsi, imsi_len);
+}
+
 void mme_context_init()
 {
     ogs_assert(context_initialized == 0);
@@ -97,15 +112,29 @@ void mme_context_init()
     ogs_pool_init(&enb_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&mme_sess_pool, ogs_app()->pool.sess);
     ogs_pool_init(&mme_bearer_pool, ogs_app()->pool.bearer);
+    ogs_pool_set_trim(&mme_ue_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&enb_ue_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&mme_sess_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&mme_bearer_pool, ogs_app()->pool.trim);
     ogs_pool_init(&self.m_tmsi, ogs_app()->max.ue);
 
     self.enb_addr_hash = ogs_hash_make();
     self.enb_id_hash = ogs_hash_make();
-    self.imsi_ue_hash = ogs_hash_make();
-    self.guti_ue_hash = ogs_hash_make();
+    self.imsi_ue_hash = ogs_ihash_make(IMSI_HASH_KEY_LEN);
+    self.guti_ue_hash = ogs_ihash_make(sizeof(ogs_nas_eps_guti_t));
 
     ogs_list_init(&self.mme_ue_list);
 
+    self.metrics.attach_request = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "mme_attach_requests_total", "Attach requests received", NULL);
+    self.metrics.attach_complete = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "mme_attach_complete_total", "Attach procedures completed", NULL);
+    self.metrics.attach_reject = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "mme_attach_rejects_total", "Attach rejects sent", NULL);
+    self.metrics.enb = ogs_metrics_add_pool(&mme_enb_pool, "mme_enb");
+    self.metrics.ue = ogs_metrics_add_pool(&mme_ue_pool, "mme_ue");
+    self.metrics.sess = ogs_metrics_add_pool(&mme_sess_pool, "mme_sess");
+
     context_initialized = 1;
 }
 
@@ -127,9 +156,19 @@ void mme_context_final()
     ogs_hash_destroy(self.enb_id_hash);
 
     ogs_assert(self.imsi_ue_hash);
-    ogs_hash_destroy(self.imsi_ue_hash);
+    ogs_ihash_destroy(self.imsi_ue_hash);
     ogs_assert(self.guti_ue_hash);
-    ogs_hash_destroy(self.guti_ue_hash);
+    ogs_ihash_destroy(self.guti_ue_hash);
+
+    if (self.metrics.attach_request)
+        ogs_metrics_remove(self.metrics.attach_request);
+    if (self.metrics.attach_complete)
+        ogs_metrics_remove(self.metrics.attach_complete);
+    if (self.metrics.attach_reject)
+        ogs_metrics_remove(self.metrics.attach_reject);
+    if (self.metrics.enb) ogs_metrics_remove(self.metrics.enb);
+    if (self.metrics.ue) ogs_metrics_remove(self.metrics.ue);
+    if (self.metrics.sess) ogs_metrics_remove(self.metrics.sess);
 
     ogs_pool_final(&self.m_tmsi);
     ogs_pool_final(&mme_bearer_pool);
@@ -155,6 +194,7 @@ mme_context_t *mme_self(void)
 static int mme_context_prepare(void)
 {
     self.relative_capacity = 0xff;
+    self.overload.t3346 = 60;
 
     self.s1ap_port = OGS_S1AP_SCTP_PORT;
     self.sgsap_port = OGS_SGSAP_SCTP_PORT;
@@ -404,6 +444,48 @@ int mme_context_parse_config()
                 } else if (!strcmp(mme_key, "relative_capacity")) {
                     const char *v = ogs_yaml_iter_value(&mme_iter);
                     if (v) self.relative_capacity = atoi(v);
+                } else if (!strcmp(mme_key, "overload")) {
+                    ogs_yaml_iter_t overload_iter;
+                    ogs_yaml_iter_recurse(&mme_iter, &overload_iter);
+
+                    while (ogs_yaml_iter_next(&overload_iter)) {
+                        const char *overload_key =
+                            ogs_yaml_iter_key(&overload_iter);
+                        const char *v = ogs_yaml_iter_value(&overload_iter);
+                        ogs_assert(overload_key);
+                        if (!strcmp(overload_key, "queue")) {
+                            if (v) self.overload.queue = atoi(v);
+                        } else if (!strcmp(overload_key, "latency")) {
+                            if (v) self.overload.latency =
+                                ogs_time_from_msec(atoll(v));
+                        } else if (!strcmp(overload_key, "pool")) {
+                            if (v) self.overload.pool = atoi(v);
+                        } else if (!strcmp(overload_key, "t3346")) {
+                            int t3346 = v ? atoi(v) : 0;
+                            if (t3346 > 0)
+                                self.overload.t3346 = t3346;
+                            else
+                                ogs_warn("Ignore t3346(%d)", t3346);
+                        } else
+                            ogs_warn("unknown key `%s`", overload_key);
+                    }
+                } else if (!strcmp(mme_key, "checkpoint")) {
+                    ogs_yaml_iter_t checkpoint_iter;
+                    ogs_yaml_iter_recurse(&mme_iter, &checkpoint_iter);
+
+                    while (ogs_yaml_iter_next(&checkpoint_iter)) {
+                        const char *checkpoint_key =
+                            ogs_yaml_iter_key(&checkpoint_iter);
+                        const char *v = ogs_yaml_iter_value(&checkpoint_iter);
+                        ogs_assert(checkpoint_key);
+                        if (!strcmp(checkpoint_key, "path")) {
+                            self.checkpoint.path = v;
+                        } else if (!strcmp(checkpoint_key, "sync")) {
+                            if (v) self.checkpoint.sync =
+                                ogs_time_from_msec(atoll(v));
+                        } else
+                            ogs_warn("unknown key `%s`", checkpoint_key);
+                    }
                 } else if (!strcmp(mme_key, "s1ap")) {
                     ogs_yaml_iter_t s1ap_array, s1ap_iter;
                     ogs_yaml_iter_recurse(&mme_iter, &s1ap_array);
@@ -1783,6 +1865,8 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     }
 
     ogs_list_init(&enb->enb_ue_list);
+    enb->enb_ue_s1ap_id_hash = ogs_hash_make();
+    ogs_assert(enb->enb_ue_s1ap_id_hash);
 
     ogs_hash_set(self.enb_addr_hash,
             enb->sctp.addr, sizeof(ogs_sockaddr_t), enb);
@@ -1818,6 +1902,10 @@ int mme_enb_remove(mme_enb_t *enb)
             enb->sctp.addr, sizeof(ogs_sockaddr_t), NULL);
     ogs_hash_set(self.enb_id_hash, &enb->enb_id, sizeof(enb->enb_id), NULL);
 
+    ogs_assert(enb->enb_ue_s1ap_id_hash);
+    ogs_hash_destroy(enb->enb_ue_s1ap_id_hash);
+    enb->enb_ue_s1ap_id_hash = NULL;
+
     /*
      * CHECK:
      *
@@ -1885,6 +1973,54 @@ int mme_enb_sock_type(ogs_sock_t *sock)
 }
 
 /** enb_ue_context handling function */
+static void enb_ue_s1ap_id_hash_set(enb_ue_t *enb_ue)
+{
+    mme_enb_t *enb = NULL;
+
+    ogs_assert(enb_ue);
+    enb = enb_ue->enb;
+    ogs_assert(enb);
+    ogs_assert(enb->enb_ue_s1ap_id_hash);
+
+    if (enb_ue->enb_ue_s1ap_id == INVALID_UE_S1AP_ID)
+        return;
+
+    ogs_hash_set(enb->enb_ue_s1ap_id_hash, &enb_ue->enb_ue_s1ap_id,
+            sizeof(enb_ue->enb_ue_s1ap_id), enb_ue);
+}
+
+static void enb_ue_s1ap_id_hash_clear(enb_ue_t *enb_ue)
+{
+    mme_enb_t *enb = NULL;
+
+    ogs_assert(enb_ue);
+    enb = enb_ue->enb;
+    ogs_assert(enb);
+
+    /*
+     * If the eNB was removed (e.g. SCTP connection refused)
+     * before the release of its UE contexts is completed,
+     * the hash table has already been destroyed.
+     */
+    if (!enb->enb_ue_s1ap_id_hash)
+        return;
+
+    if (enb_ue->enb_ue_s1ap_id == INVALID_UE_S1AP_ID)
+        return;
+
+    /*
+     * The eNB may reuse an ENB-UE-S1AP-ID while the old context
+     * is still waiting to be released. In this case, the hash already
+     * points to the newer context and must be kept as it is.
+     */
+    if (ogs_hash_get(enb->enb_ue_s1ap_id_hash, &enb_ue->enb_ue_s1ap_id,
+                sizeof(enb_ue->enb_ue_s1ap_id)) != enb_ue)
+        return;
+
+    ogs_hash_set(enb->enb_ue_s1ap_id_hash, &enb_ue->enb_ue_s1ap_id,
+            sizeof(enb_ue->enb_ue_s1ap_id), NULL);
+}
+
 enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id)
 {
     enb_ue_t *enb_ue = NULL;
@@ -1917,6 +2053,7 @@ enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id)
     enb_ue->enb = enb;
 
     ogs_list_add(&enb->enb_ue_list, enb_ue);
+    enb_ue_s1ap_id_hash_set(enb_ue);
 
     stats_add_enb_ue();
 
@@ -1931,6 +2068,7 @@ void enb_ue_remove(enb_ue_t *enb_ue)
     enb = enb_ue->enb;
     ogs_assert(enb);
 
+    enb_ue_s1ap_id_hash_clear(enb_ue);
     ogs_list_remove(&enb->enb_ue_list, enb_ue);
 
     ogs_assert(enb_ue->t_s1_holding);
@@ -1941,33 +2079,43 @@ void enb_ue_remove(enb_ue_t *enb_ue)
     stats_remove_enb_ue();
 }
 
-void enb_ue_switch_to_enb(enb_ue_t *enb_ue, mme_enb_t *new_enb)
+void enb_ue_switch_to_enb(enb_ue_t *enb_ue,
+        mme_enb_t *new_enb, uint32_t new_enb_ue_s1ap_id)
 {
     ogs_assert(enb_ue);
     ogs_assert(enb_ue->enb);
     ogs_assert(new_enb);
 
-    /* Remove from the old enb */
+    /* Remove from the old enb with the old ENB-UE-S1AP-ID */
+    enb_ue_s1ap_id_hash_clear(enb_ue);
     ogs_list_remove(&enb_ue->enb->enb_ue_list, enb_ue);
 
     /* Add to the new enb */
     ogs_list_add(&new_enb->enb_ue_list, enb_ue);
 
-    /* Switch to enb */
+    /* Switch to enb with the ENB-UE-S1AP-ID allocated by the new enb */
     enb_ue->enb = new_enb;
+    enb_ue->enb_ue_s1ap_id = new_enb_ue_s1ap_id;
+    enb_ue_s1ap_id_hash_set(enb_ue);
+}
+
+void enb_ue_set_enb_ue_s1ap_id(enb_ue_t *enb_ue, uint32_t enb_ue_s1ap_id)
+{
+    ogs_assert(enb_ue);
+
+    enb_ue_s1ap_id_hash_clear(enb_ue);
+    enb_ue->enb_ue_s1ap_id = enb_ue_s1ap_id;
+    enb_ue_s1ap_id_hash_set(enb_ue);
 }
 
 enb_ue_t *enb_ue_find_by_enb_ue_s1ap_id(
         mme_enb_t *enb, uint32_t enb_ue_s1ap_id)
 {
-    enb_ue_t *enb_ue = NULL;
-    
-    ogs_list_for_each(&enb->enb_ue_list, enb_ue) {
-        if (enb_ue_s1ap_id == enb_ue->enb_ue_s1ap_id)
-            break;
-    }
+    ogs_assert(enb);
+    ogs_assert(enb->enb_ue_s1ap_id_hash);
 
-    return enb_ue;
+    return (enb_ue_t *)ogs_hash_get(enb->enb_ue_s1ap_id_hash,
+            &enb_ue_s1ap_id, sizeof(enb_ue_s1ap_id));
 }
 
 enb_ue_t *enb_ue_find(uint32_t index)
@@ -2024,8 +2172,7 @@ void mme_ue_confirm_guti(mme_ue_t *mme_ue)
     if (mme_ue->current.m_tmsi) {
         /* MME has a VALID GUTI
          * As such, we need to remove previous GUTI in hash table */
-        ogs_hash_set(self.guti_ue_hash,
-                &mme_ue->current.guti, sizeof(ogs_nas_eps_guti_t), NULL);
+        ogs_ihash_set(self.guti_ue_hash, &mme_ue->current.guti, NULL);
         ogs_assert(mme_m_tmsi_free(mme_ue->current.m_tmsi) == OGS_OK);
     }
 
@@ -2035,8 +2182,7 @@ void mme_ue_confirm_guti(mme_ue_t *mme_ue)
             &mme_ue->next.guti, sizeof(ogs_nas_eps_guti_t));
 
     /* Hashing Current GUTI */
-    ogs_hash_set(self.guti_ue_hash,
-            &mme_ue->current.guti, sizeof(ogs_nas_eps_guti_t), mme_ue);
+    ogs_ihash_set(self.guti_ue_hash, &mme_ue->current.guti, mme_ue);
 
     /* Clear Next GUTI */
     mme_ue->next.m_tmsi = NULL;
@@ -2078,19 +2224,13 @@ static mme_sgw_t *selected_sgw_node(mme_sgw_t *current, enb_ue_t *enb_ue)
     return next ? next : ogs_list_first(&mme_self()->sgw_list);
 }
 
-mme_ue_t *mme_ue_add(enb_ue_t *enb_ue)
+static void mme_ue_init(mme_ue_t *mme_ue, ogs_gtp_node_t *gnode)
 {
-    mme_enb_t *enb = NULL;
-    mme_ue_t *mme_ue = NULL;
-
     char buf[OGS_ADDRSTRLEN];
 
-    ogs_assert(enb_ue);
-    enb = enb_ue->enb;
-    ogs_assert(enb);
-
-    ogs_pool_alloc(&mme_ue_pool, &mme_ue);
     ogs_assert(mme_ue);
+    ogs_assert(gnode);
+
     memset(mme_ue, 0, sizeof *mme_ue);
 
     mme_ebi_pool_init(mme_ue);
@@ -2101,17 +2241,8 @@ mme_ue_t *mme_ue_add(enb_ue_t *enb_ue)
     ogs_assert(mme_ue->mme_s11_teid > 0 &&
             mme_ue->mme_s11_teid <= ogs_app()->max.ue);
 
-    /*
-     * When used for the first time, if last node is set,
-     * the search is performed from the first SGW in a round-robin manner.
-     */
-    if (mme_self()->sgw == NULL)
-        mme_self()->sgw = ogs_list_last(&mme_self()->sgw_list);
-
     /* setup GTP path with selected SGW */
-    mme_self()->sgw = selected_sgw_node(mme_self()->sgw, enb_ue);
-    ogs_assert(mme_self()->sgw);
-    OGS_SETUP_GTP_NODE(mme_ue, mme_self()->sgw->gnode);
+    OGS_SETUP_GTP_NODE(mme_ue, gnode);
     ogs_debug("UE using SGW on IP[%s]", OGS_ADDR(&mme_ue->gnode->addr, buf));
 
     /* Clear VLR */
@@ -2138,6 +2269,31 @@ mme_ue_t *mme_ue_add(enb_ue_t *enb_ue)
     mme_ue_fsm_init(mme_ue);
 
     ogs_list_add(&self.mme_ue_list, mme_ue);
+}
+
+mme_ue_t *mme_ue_add(enb_ue_t *enb_ue)
+{
+    mme_enb_t *enb = NULL;
+    mme_ue_t *mme_ue = NULL;
+
+    ogs_assert(enb_ue);
+    enb = enb_ue->enb;
+    ogs_assert(enb);
+
+    ogs_pool_alloc(&mme_ue_pool, &mme_ue);
+    ogs_assert(mme_ue);
+
+    /*
+     * When used for the first time, if last node is set,
+     * the search is performed from the first SGW in a round-robin manner.
+     */
+    if (mme_self()->sgw == NULL)
+        mme_self()->sgw = ogs_list_last(&mme_self()->sgw_list);
+
+    mme_self()->sgw = selected_sgw_node(mme_self()->sgw, enb_ue);
+    ogs_assert(mme_self()->sgw);
+
+    mme_ue_init(mme_ue, mme_self()->sgw->gnode);
 
     ogs_info("[Added] Number of MME-UEs is now %d",
             ogs_list_count(&self.mme_ue_list));
@@ -2145,24 +2301,60 @@ mme_ue_t *mme_ue_add(enb_ue_t *enb_ue)
     return mme_ue;
 }
 
+/*
+ * Warm restart : the UE is added with the S11 TEID of the previous run,
+ * which is its index in the pool. mme_ue_restore_done() must be called
+ * once all the UEs are restored.
+ */
+mme_ue_t *mme_ue_restore(uint32_t mme_s11_teid, ogs_gtp_node_t *gnode)
+{
+    mme_ue_t *mme_ue = NULL;
+
+    ogs_assert(gnode);
+
+    ogs_pool_restore(&mme_ue_pool, &mme_ue, mme_s11_teid);
+    if (!mme_ue) {
+        ogs_error("Cannot restore MME-UE [TEID:%d]", mme_s11_teid);
+        return NULL;
+    }
+
+    mme_ue_init(mme_ue, gnode);
+    ogs_assert(mme_ue->mme_s11_teid == mme_s11_teid);
+
+    return mme_ue;
+}
+
+void mme_ue_restore_done(void)
+{
+    ogs_pool_restore_done(&mme_ue_pool);
+    ogs_pool_restore_done(&self.m_tmsi);
+
+    ogs_info("[Restored] Number of MME-UEs is now %d",
+            ogs_list_count(&self.mme_ue_list));
+}
+
 void mme_ue_remove(mme_ue_t *mme_ue)
 {
     ogs_assert(mme_ue);
 
+    mme_checkpoint_mark(mme_ue);
+
     ogs_list_remove(&self.mme_ue_list, mme_ue);
 
     mme_ue_fsm_fini(mme_ue);
 
     if (mme_ue->current.m_tmsi) {
-        ogs_hash_set(self.guti_ue_hash,
-                &mme_ue->current.guti, sizeof(ogs_nas_eps_guti_t), NULL);
+        ogs_ihash_set(self.guti_ue_hash, &mme_ue->current.guti, NULL);
         ogs_assert(mme_m_tmsi_free(mme_ue->current.m_tmsi) == OGS_OK);
     }
     if (mme_ue->next.m_tmsi) {
         ogs_assert(mme_m_tmsi_free(mme_ue->next.m_tmsi) == OGS_OK);
     }
-    if (mme_ue->imsi_len != 0)
-        ogs_hash_set(self.imsi_ue_hash, mme_ue->imsi, mme_ue->imsi_len, NULL);
+    if (mme_ue->imsi_len != 0) {
+        uint8_t key[IMSI_HASH_KEY_LEN];
+        imsi_hash_key(key, mme_ue->imsi, mme_ue->imsi_len);
+        ogs_ihash_set(self.imsi_ue_hash, key, NULL);
+    }
     
     /* Clear the saved PDN Connectivity Request */
     OGS_NAS_CLEAR_DATA(&mme_ue->pdn_connectivity_request);
@@ -2248,17 +2440,19 @@ mme_ue_t *mme_ue_find_by_imsi_bcd(char *imsi_bcd)
 
 mme_ue_t *mme_ue_find_by_imsi(uint8_t *imsi, int imsi_len)
 {
+    uint8_t key[IMSI_HASH_KEY_LEN];
+
     ogs_assert(imsi && imsi_len);
 
-    return (mme_ue_t *)ogs_hash_get(self.imsi_ue_hash, imsi, imsi_len);
+    imsi_hash_key(key, imsi, imsi_len);
+    return (mme_ue_t *)ogs_ihash_get(self.imsi_ue_hash, key);
 }
 
 mme_ue_t *mme_ue_find_by_guti(ogs_nas_eps_guti_t *guti)
 {
     ogs_assert(guti);
 
-    return (mme_ue_t *)ogs_hash_get(
-            self.guti_ue_hash, guti, sizeof(ogs_nas_eps_guti_t));
+    return (mme_ue_t *)ogs_ihash_get(self.guti_ue_hash, guti);
 }
 
 mme_ue_t *mme_ue_find_by_teid(uint32_t teid)
@@ -2436,6 +2630,7 @@ mme_ue_t *mme_ue_find_by_message(ogs_nas_eps_message_t *message)
 int mme_ue_set_imsi(mme_ue_t *mme_ue, char *imsi_bcd)
 {
     mme_ue_t *old_mme_ue = NULL;
+    uint8_t key[IMSI_HASH_KEY_LEN];
     ogs_assert(mme_ue && imsi_bcd);
 
     ogs_cpystrn(mme_ue->imsi_bcd, imsi_bcd, OGS_MAX_IMSI_BCD_LEN+1);
@@ -2461,7 +2656,8 @@ int mme_ue_set_imsi(mme_ue_t *mme_ue, char *imsi_bcd)
         }
     }
 
-    ogs_hash_set(self.imsi_ue_hash, mme_ue->imsi, mme_ue->imsi_len, mme_ue);
+    imsi_hash_key(key, mme_ue->imsi, mme_ue->imsi_len);
+    ogs_ihash_set(self.imsi_ue_hash, key, mme_ue);
 
     return OGS_OK;
 }
@@ -3184,6 +3380,87 @@ void mme_ebi_pool_clear(mme_ue_t *mme_ue)
     mme_ebi_pool_init(mme_ue);
 }
 
+/* Usage of the fullest UE/session pool in 1/100 of a percent */
+static int overload_pool_usage(void)
+{
+    int usage = 0;
+
+#define POOL_USAGE(__pOOL) \
+    (int)((uint64_t)ogs_pool_used(__pOOL) * 10000 / ogs_pool_size(__pOOL))
+    usage = ogs_max(usage, POOL_USAGE(&mme_ue_pool));
+    usage = ogs_max(usage, POOL_USAGE(&enb_ue_pool));
+    usage = ogs_max(usage, POOL_USAGE(&mme_sess_pool));
+    usage = ogs_max(usage, POOL_USAGE(&mme_bearer_pool));
+#undef POOL_USAGE
+
+    return usage;
+}
+
+/*
+ * Called once per iteration of the main loop with the number of events
+ * found in the queue and the longest time one of them has waited.
+ *
+ * OverloadStop is sent only when every value has fallen below
+ * OVERLOAD_LOW_WATERMARK percent of its watermark, so that the eNBs
+ * are not flooded with OverloadStart/OverloadStop around a watermark.
+ */
+#define OVERLOAD_LOW_WATERMARK 80
+
+void mme_overload_check(unsigned int num_of_event, ogs_time_t latency)
+{
+    int usage;
+    mme_enb_t *enb = NULL;
+
+    if (!self.overload.queue && !self.overload.latency && !self.overload.pool)
+        return;
+
+    usage = overload_pool_usage();
+
+#define OVERLOAD_ABOVE(__vALUE, __wATERMARK, __pERCENT) \
+    ((__wATERMARK) != 0 && \
+     (uint64_t)(__vALUE) * 100 >= (uint64_t)(__wATERMARK) * (__pERCENT))
+#define OVERLOAD(__pERCENT) \
+    (OVERLOAD_ABOVE(num_of_event, self.overload.queue, __pERCENT) || \
+     OVERLOAD_ABOVE(latency, self.overload.latency, __pERCENT) || \
+     OVERLOAD_ABOVE(usage, self.overload.pool * 100, __pERCENT))
+
+    if (self.overload.active == false) {
+        if (!OVERLOAD(100)) return;
+        self.overload.active = true;
+    } else {
+        if (OVERLOAD(OVERLOAD_LOW_WATERMARK)) return;
+        self.overload.active = false;
+    }
+
+#undef OVERLOAD
+#undef OVERLOAD_ABOVE
+
+    ogs_warn("Overload %s [QUEUE:%u LATENCY:%lldms POOL:%d.%02d%%]",
+            self.overload.active ? "start" : "stop", num_of_event,
+            (long long)ogs_time_to_msec(latency), usage / 100, usage % 100);
+
+    ogs_list_for_each(&self.enb_list, enb) {
+        if (!enb->state.s1_setup_success)
+            continue;
+
+        if (self.overload.active)
+            s1ap_send_overload_start(enb);
+        else
+            s1ap_send_overload_stop(enb);
+    }
+}
+
+/*
+ * T3346 is drawn between the half and the whole of the configured value
+ * so that the rejected UEs do not come back at the same time.
+ */
+int mme_overload_t3346(void)
+{
+    int t3346 = self.overload.t3346;
+
+    return t3346 / 2 + ogs_random32() % (t3346 - t3346 / 2 + 1);
+}
+
 uint8_t mme_selected_int_algorithm(mme_ue_t *mme_ue)
 {
     int i;
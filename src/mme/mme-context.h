@@ -131,6 +131,35 @@ typedef struct mme_context_s {
     /* S1SetupResponse */
     uint8_t         relative_capacity;
 
+    /*
+     * Overload control
+     *
+     * OverloadStart is sent to all eNBs once any watermark is reached,
+     * and OverloadStop once all of them are below the low watermark.
+     * In between, Attach/TAU/Service Requests in an InitialUEMessage
+     * are rejected with EMM cause #22 and T3346. 0 disables a watermark.
+     */
+    struct {
+        unsigned int queue;     /* Events waiting in the event queue */
+        ogs_time_t latency;     /* Time an event has waited in the queue */
+        int pool;               /* Percentage of UE/session contexts in use */
+        int t3346;              /* Maximum back-off timer(seconds) */
+
+        bool active;            /* OverloadStart has been sent */
+    } overload;
+
+    /*
+     * Warm restart
+     *
+     * The registered UEs are checkpointed in 'path' after each
+     * iteration of the event loop and restored at the next start.
+     * The file is msync()-ed every 'sync', if set.
+     */
+    struct {
+        const char *path;
+        ogs_time_t sync;
+    } checkpoint;
+
     /* Generator for unique identification */
     uint32_t        mme_ue_s1ap_id;         /* mme_ue_s1ap_id generator */
 
@@ -141,9 +170,16 @@ typedef struct mme_context_s {
 
     ogs_hash_t      *enb_addr_hash;         /* hash table for ENB Address */
     ogs_hash_t      *enb_id_hash;           /* hash table for ENB-ID */
-    ogs_hash_t      *imsi_ue_hash;          /* hash table (IMSI : MME_UE) */
-    ogs_hash_t      *guti_ue_hash;          /* hash table (GUTI : MME_UE) */
+    ogs_ihash_t     *imsi_ue_hash;          /* hash table (IMSI : MME_UE) */
+    ogs_ihash_t     *guti_ue_hash;          /* hash table (GUTI : MME_UE) */
 
+    struct {
+        ogs_metrics_t *attach_request;
+        ogs_metrics_t *attach_complete;
+        ogs_metrics_t *attach_reject;
+
+        ogs_metrics_t *enb, *ue, *sess;
+    } metrics;
 } mme_context_t;
 
 typedef struct mme_sgw_s {
@@ -217,6 +253,7 @@ typedef struct mme_enb_s {
     ogs_pkbuf_t     *s1_reset_ack; /* Reset message */
 
     ogs_list_t      enb_ue_list;
+    ogs_hash_t      *enb_ue_s1ap_id_hash;   /* hash table for ENB-UE-S1AP-ID */
 
 } mme_enb_t;
 
@@ -681,7 +718,9 @@ int mme_enb_sock_type(ogs_sock_t *sock);
 
 enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id);
 void enb_ue_remove(enb_ue_t *enb_ue);
-void enb_ue_switch_to_enb(enb_ue_t *enb_ue, mme_enb_t *new_enb);
+void enb_ue_switch_to_enb(enb_ue_t *enb_ue,
+        mme_enb_t *new_enb, uint32_t new_enb_ue_s1ap_id);
+void enb_ue_set_enb_ue_s1ap_id(enb_ue_t *enb_ue, uint32_t enb_ue_s1ap_id);
 enb_ue_t *enb_ue_find_by_enb_ue_s1ap_id(
         mme_enb_t *enb, uint32_t enb_ue_s1ap_id);
 enb_ue_t *enb_ue_find(uint32_t index);
@@ -693,6 +732,8 @@ void mme_ue_confirm_guti(mme_ue_t *mme_ue);
 
 mme_ue_t *mme_ue_add(enb_ue_t *enb_ue);
 void mme_ue_remove(mme_ue_t *mme_ue);
+mme_ue_t *mme_ue_restore(uint32_t mme_s11_teid, ogs_gtp_node_t *gnode);
+void mme_ue_restore_done(void);
 void mme_ue_remove_all(void);
 
 void mme_ue_fsm_init(mme_ue_t *mme_ue);
@@ -806,6 +847,9 @@ void mme_ebi_pool_init(mme_ue_t *mme_ue);
 void mme_ebi_pool_final(mme_ue_t *mme_ue);
 void mme_ebi_pool_clear(mme_ue_t *mme_ue);
 
+void mme_overload_check(unsigned int num_of_event, ogs_time_t latency);
+int mme_overload_t3346(void);
+
 uint8_t mme_selected_int_algorithm(mme_ue_t *mme_ue);
 uint8_t mme_selected_enc_algorithm(mme_ue_t *mme_ue);
 
@@ -39,6 +39,8 @@ mme_event_t *mme_event_new(mme_event_e id)
     memset(e, 0, sizeof(*e));
 
     e->id = id;
+    if (mme_self()->overload.latency)
+        e->timestamp = ogs_get_monotonic_time();
 
     return e;
 }
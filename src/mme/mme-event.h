@@ -92,6 +92,8 @@ typedef struct mme_event_s {
     mme_bearer_t *bearer;
 
     ogs_timer_t *timer;
+
+    ogs_time_t timestamp;   /* Set only if overload.latency is configured */
 } mme_event_t;
 
 void mme_event_term(void);
@@ -29,6 +29,7 @@
 #include "s1ap-path.h"
 #include "sgsap-path.h"
 #include "mme-gtp-path.h"
+#include "mme-checkpoint.h"
 
 static ogs_thread_t *thread;
 static void mme_main(void *data);
@@ -55,7 +56,7 @@ int mme_initialize()
             ogs_app()->logger.domain, ogs_app()->logger.level);
     if (rv != OGS_OK) return rv;
 
-    rv = mme_m_tmsi_pool_generate();
+    rv = mme_checkpoint_open();
     if (rv != OGS_OK) return rv;
 
     rv = mme_fd_init();
@@ -86,6 +87,9 @@ void mme_terminate(void)
 
     ogs_thread_destroy(thread);
 
+    /* The UEs are kept for the next start */
+    mme_checkpoint_close();
+
     mme_gtp_close();
     sgsap_close();
     s1ap_close();
@@ -102,6 +106,8 @@ void mme_terminate(void)
 static void mme_main(void *data)
 {
     ogs_fsm_t mme_sm;
+    unsigned int num_of_event;
+    ogs_time_t latency;
     int rv;
 
     ogs_fsm_create(&mme_sm, mme_state_initial, mme_state_final);
@@ -124,6 +130,9 @@ static void mme_main(void *data)
          */
         ogs_timer_mgr_expire(ogs_app()->timer_mgr);
 
+        num_of_event = ogs_queue_size(ogs_app()->queue);
+        latency = 0;
+
         for ( ;; ) {
             mme_event_t *e = NULL;
 
@@ -137,9 +146,16 @@ static void mme_main(void *data)
                 break;
 
             ogs_assert(e);
+            if (e->timestamp)
+                latency = ogs_max(latency,
+                        ogs_get_monotonic_time() - e->timestamp);
+
             ogs_fsm_dispatch(&mme_sm, e);
             mme_event_free(e);
         }
+
+        mme_overload_check(num_of_event, latency);
+        mme_checkpoint_flush();
     }
 done:
 
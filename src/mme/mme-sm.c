@@ -33,6 +33,7 @@
 #include "mme-fd-path.h"
 #include "mme-s6a-handler.h"
 #include "mme-path.h"
+#include "mme-checkpoint.h"
 
 /* 3GPP TS 29.272 Annex A; Table !.a:
  * Mapping from S6a error codes to NAS Cause Codes */
@@ -343,6 +344,7 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         e->mme_ue = mme_ue;
         e->nas_message = &nas_message;
 
+        mme_checkpoint_mark(mme_ue);
         ogs_fsm_dispatch(&mme_ue->sm, e);
         if (OGS_FSM_CHECK(&mme_ue->sm, emm_state_exception)) {
             mme_send_delete_session_or_mme_ue_context_release(mme_ue);
@@ -355,6 +357,7 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         ogs_assert(mme_ue);
         ogs_assert(OGS_FSM_STATE(&mme_ue->sm));
 
+        mme_checkpoint_mark(mme_ue);
         ogs_fsm_dispatch(&mme_ue->sm, e);
         break;
 
@@ -385,6 +388,7 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         e->bearer = bearer;
         e->nas_message = &nas_message;
 
+        mme_checkpoint_mark(mme_ue);
         ogs_fsm_dispatch(&bearer->sm, e);
         if (OGS_FSM_CHECK(&bearer->sm, esm_state_bearer_deactivated)) {
             if (default_bearer->ebi == bearer->ebi) {
@@ -422,6 +426,7 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         ogs_assert(bearer);
         ogs_assert(OGS_FSM_STATE(&bearer->sm));
 
+        mme_checkpoint_mark(bearer->mme_ue);
         ogs_fsm_dispatch(&bearer->sm, e);
         break;
 
@@ -433,6 +438,8 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         s6a_message = (ogs_diam_s6a_message_t *)s6abuf->data;
         ogs_assert(s6a_message);
 
+        mme_checkpoint_mark(mme_ue);
+
         if (s6a_message->result_code != ER_DIAMETER_SUCCESS) {
             enb_ue_t *enb_ue = NULL;
 
@@ -547,6 +554,8 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
             gnode = mme_ue->gnode;
             ogs_assert(gnode);
 
+            mme_checkpoint_mark(mme_ue);
+
         } else {
             gnode = e->gnode;
             ogs_assert(gnode);
@@ -142,6 +142,8 @@ void nas_eps_send_attach_reject(mme_ue_t *mme_ue,
     ogs_debug("[%s] Attach reject", mme_ue->imsi_bcd);
     ogs_debug("    Cause[%d]", emm_cause);
 
+    ogs_metrics_inc(mme_self()->metrics.attach_reject);
+
     sess = mme_sess_first(mme_ue);
     if (sess) {
         esmbuf = esm_build_pdn_connectivity_reject(sess, esm_cause);
@@ -540,6 +542,35 @@ void nas_eps_send_service_reject(mme_ue_t *mme_ue,
     ogs_expect(rv == OGS_OK);
 }
 
+void nas_eps_send_congestion_reject(enb_ue_t *enb_ue, uint8_t message_type)
+{
+    int rv;
+    ogs_pkbuf_t *emmbuf = NULL, *s1apbuf = NULL;
+
+    ogs_assert(enb_ue);
+
+    ogs_warn("Overload: reject [ENB_UE_S1AP_ID:%d MME_UE_S1AP_ID:%d]",
+            enb_ue->enb_ue_s1ap_id, enb_ue->mme_ue_s1ap_id);
+
+    if (message_type == OGS_NAS_EPS_ATTACH_REJECT)
+        ogs_metrics_inc(mme_self()->metrics.attach_reject);
+
+    emmbuf = emm_build_congestion_reject(message_type, mme_overload_t3346());
+    ogs_expect_or_return(emmbuf);
+
+    s1apbuf = s1ap_build_downlink_nas_transport(enb_ue, emmbuf);
+    ogs_expect_or_return(s1apbuf);
+
+    rv = s1ap_send_to_enb_ue(enb_ue, s1apbuf);
+    ogs_expect_or_return(rv == OGS_OK);
+
+    s1ap_send_ue_context_release_command(enb_ue,
+            S1AP_Cause_PR_misc, S1AP_CauseMisc_control_processing_overload,
+            enb_ue->mme_ue ?
+                S1AP_UE_CTX_REL_S1_REMOVE_AND_UNLINK :
+                S1AP_UE_CTX_REL_S1_CONTEXT_REMOVE, 0);
+}
+
 void nas_eps_send_cs_service_notification(mme_ue_t *mme_ue)
 {
     int rv;
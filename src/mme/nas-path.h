@@ -67,6 +67,8 @@ void nas_eps_send_tau_reject(mme_ue_t *mme_ue, ogs_nas_esm_cause_t emm_cause);
 void nas_eps_send_service_reject(
         mme_ue_t *mme_ue, ogs_nas_emm_cause_t emm_cause);
 
+void nas_eps_send_congestion_reject(enb_ue_t *enb_ue, uint8_t message_type);
+
 void nas_eps_send_cs_service_notification(mme_ue_t *mme_ue);
 void nas_eps_send_downlink_nas_transport(
         mme_ue_t *mme_ue, uint8_t *buffer, uint8_t length);
@@ -18,6 +18,7 @@
  */
 
 #include "nas-security.h"
+#include "mme-checkpoint.h"
 
 #define NAS_SECURITY_BEARER 0
 #define NAS_SECURITY_DOWNLINK_DIRECTION 1
@@ -106,6 +107,7 @@ ogs_pkbuf_t *nas_eps_security_encode(
 
     /* increase dl_count */
     mme_ue->dl_count = (mme_ue->dl_count + 1) & 0xffffff; /* Use 24bit */
+    mme_checkpoint_mark(mme_ue);
 
     /* encode all security header */
     ogs_assert(ogs_pkbuf_push(new, 5));
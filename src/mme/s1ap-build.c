@@ -253,9 +253,7 @@ ogs_pkbuf_t *s1ap_build_downlink_nas_transport(
     *ENB_UE_S1AP_ID = enb_ue->enb_ue_s1ap_id;
 
     NAS_PDU->size = emmbuf->len;
-    NAS_PDU->buf = CALLOC(NAS_PDU->size, sizeof(uint8_t));
-    memcpy(NAS_PDU->buf, emmbuf->data, NAS_PDU->size);
-    ogs_pkbuf_free(emmbuf);
+    NAS_PDU->buf = ogs_pkbuf_to_mem(emmbuf);
 
     return ogs_s1ap_encode(&pdu);
 }
@@ -454,10 +452,8 @@ ogs_pkbuf_t *s1ap_build_initial_context_setup_request(
             if (emmbuf && emmbuf->len) {
                 nasPdu = (S1AP_NAS_PDU_t *)CALLOC(1, sizeof(S1AP_NAS_PDU_t));
                 nasPdu->size = emmbuf->len;
-                nasPdu->buf = CALLOC(nasPdu->size, sizeof(uint8_t));
-                memcpy(nasPdu->buf, emmbuf->data, nasPdu->size);
+                nasPdu->buf = ogs_pkbuf_to_mem(emmbuf);
                 e_rab->nAS_PDU = nasPdu;
-                ogs_pkbuf_free(emmbuf);
 
                 /* Since Tracking area update accept is used only once,
                  * set emmbuf to NULL as shown below */
@@ -965,9 +961,7 @@ ogs_pkbuf_t *s1ap_build_e_rab_setup_request(
 
     nasPdu = &e_rab->nAS_PDU;
     nasPdu->size = esmbuf->len;
-    nasPdu->buf = CALLOC(nasPdu->size, sizeof(uint8_t));
-    memcpy(nasPdu->buf, esmbuf->data, nasPdu->size);
-    ogs_pkbuf_free(esmbuf);
+    nasPdu->buf = ogs_pkbuf_to_mem(esmbuf);
 
     return ogs_s1ap_encode(&pdu);
 }
@@ -1093,9 +1087,7 @@ ogs_pkbuf_t *s1ap_build_e_rab_modify_request(
 
     nasPdu = &e_rab->nAS_PDU;
     nasPdu->size = esmbuf->len;
-    nasPdu->buf = CALLOC(nasPdu->size, sizeof(uint8_t));
-    memcpy(nasPdu->buf, esmbuf->data, nasPdu->size);
-    ogs_pkbuf_free(esmbuf);
+    nasPdu->buf = ogs_pkbuf_to_mem(esmbuf);
 
     return ogs_s1ap_encode(&pdu);
 }
@@ -1223,9 +1215,7 @@ ogs_pkbuf_t *s1ap_build_e_rab_release_command(
             bearer->ebi, group, (int)cause);
 
     nasPdu->size = esmbuf->len;
-    nasPdu->buf = CALLOC(nasPdu->size, sizeof(uint8_t));
-    memcpy(nasPdu->buf, esmbuf->data, nasPdu->size);
-    ogs_pkbuf_free(esmbuf);
+    nasPdu->buf = ogs_pkbuf_to_mem(esmbuf);
 
     return ogs_s1ap_encode(&pdu);
 }
@@ -1493,6 +1483,67 @@ ogs_pkbuf_t *s1ap_build_mme_configuration_transfer(
     return ogs_s1ap_encode(&pdu);
 }
 
+ogs_pkbuf_t *s1ap_build_overload_start(S1AP_OverloadAction_t action)
+{
+    S1AP_S1AP_PDU_t pdu;
+    S1AP_InitiatingMessage_t *initiatingMessage = NULL;
+    S1AP_OverloadStart_t *OverloadStart = NULL;
+
+    S1AP_OverloadStartIEs_t *ie = NULL;
+    S1AP_OverloadResponse_t *OverloadResponse = NULL;
+
+    ogs_debug("OverloadStart");
+    ogs_debug("    Action[%d]", (int)action);
+
+    memset(&pdu, 0, sizeof (S1AP_S1AP_PDU_t));
+    pdu.present = S1AP_S1AP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(S1AP_InitiatingMessage_t));
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode = S1AP_ProcedureCode_id_OverloadStart;
+    initiatingMessage->criticality = S1AP_Criticality_ignore;
+    initiatingMessage->value.present =
+        S1AP_InitiatingMessage__value_PR_OverloadStart;
+
+    OverloadStart = &initiatingMessage->value.choice.OverloadStart;
+
+    ie = CALLOC(1, sizeof(S1AP_OverloadStartIEs_t));
+    ASN_SEQUENCE_ADD(&OverloadStart->protocolIEs, ie);
+
+    ie->id = S1AP_ProtocolIE_ID_id_OverloadResponse;
+    ie->criticality = S1AP_Criticality_reject;
+    ie->value.present = S1AP_OverloadStartIEs__value_PR_OverloadResponse;
+
+    OverloadResponse = &ie->value.choice.OverloadResponse;
+
+    OverloadResponse->present = S1AP_OverloadResponse_PR_overloadAction;
+    OverloadResponse->choice.overloadAction = action;
+
+    return ogs_s1ap_encode(&pdu);
+}
+
+ogs_pkbuf_t *s1ap_build_overload_stop(void)
+{
+    S1AP_S1AP_PDU_t pdu;
+    S1AP_InitiatingMessage_t *initiatingMessage = NULL;
+
+    ogs_debug("OverloadStop");
+
+    memset(&pdu, 0, sizeof (S1AP_S1AP_PDU_t));
+    pdu.present = S1AP_S1AP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(S1AP_InitiatingMessage_t));
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode = S1AP_ProcedureCode_id_OverloadStop;
+    initiatingMessage->criticality = S1AP_Criticality_reject;
+    initiatingMessage->value.present =
+        S1AP_InitiatingMessage__value_PR_OverloadStop;
+
+    /* The GUMMEI List is omitted: the overload is over for all of them */
+
+    return ogs_s1ap_encode(&pdu);
+}
+
 ogs_pkbuf_t *s1ap_build_path_switch_ack(mme_ue_t *mme_ue)
 {
     S1AP_S1AP_PDU_t pdu;
@@ -56,6 +56,9 @@ ogs_pkbuf_t *s1ap_build_paging(
 ogs_pkbuf_t *s1ap_build_mme_configuration_transfer(
     S1AP_SONConfigurationTransfer_t *son_configuration_transfer);
 
+ogs_pkbuf_t *s1ap_build_overload_start(S1AP_OverloadAction_t action);
+ogs_pkbuf_t *s1ap_build_overload_stop(void);
+
 ogs_pkbuf_t *s1ap_build_path_switch_ack(mme_ue_t *mme_ue);
 ogs_pkbuf_t *s1ap_build_path_switch_failure(
     uint32_t enb_ue_s1ap_id, uint32_t mme_ue_s1ap_id,
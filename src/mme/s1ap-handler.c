@@ -64,6 +64,69 @@ static bool maximum_number_of_enbs_is_reached(void)
     return number_of_enbs_online >= ogs_app()->max.gnb;
 }
 
+/*
+ * Returns the reject to send for the NAS message in an InitialUEMessage
+ * while the MME is overloaded, or 0 if the message is accepted.
+ *
+ * Only the NAS headers are read. Emergency attach, paging responses and
+ * the other EMM messages(e.g. Detach Request) go through.
+ */
+static uint8_t overload_reject_type(enb_ue_t *enb_ue, S1AP_NAS_PDU_t *nasPdu)
+{
+    ogs_nas_emm_header_t *h = NULL;
+    ogs_nas_eps_attach_type_t *attach_type = NULL;
+    mme_ue_t *mme_ue = NULL;
+    size_t offset = 0;
+
+    ogs_assert(enb_ue);
+    ogs_assert(nasPdu);
+
+    mme_ue = enb_ue->mme_ue;
+
+    if (nasPdu->size < sizeof(ogs_nas_emm_header_t))
+        return 0;
+
+    h = (ogs_nas_emm_header_t *)nasPdu->buf;
+    switch (h->security_header_type) {
+    case OGS_NAS_SECURITY_HEADER_PLAIN_NAS_MESSAGE:
+        break;
+    case OGS_NAS_SECURITY_HEADER_FOR_SERVICE_REQUEST_MESSAGE:
+        if (mme_ue && mme_ue->t3413.pkbuf)
+            return 0;
+        return OGS_NAS_EPS_SERVICE_REJECT;
+    case OGS_NAS_SECURITY_HEADER_INTEGRITY_PROTECTED:
+    case OGS_NAS_SECURITY_HEADER_INTEGRITY_PROTECTED_AND_CIPHERED:
+        offset = sizeof(ogs_nas_eps_security_header_t);
+        break;
+    default:
+        return 0;
+    }
+
+    if (nasPdu->size < offset + sizeof(ogs_nas_emm_header_t) + 1)
+        return 0;
+
+    h = (ogs_nas_emm_header_t *)(nasPdu->buf + offset);
+    if (h->protocol_discriminator != OGS_NAS_PROTOCOL_DISCRIMINATOR_EMM)
+        return 0;
+
+    switch (h->message_type) {
+    case OGS_NAS_EPS_ATTACH_REQUEST:
+        attach_type = (ogs_nas_eps_attach_type_t *)
+            (nasPdu->buf + offset + sizeof(ogs_nas_emm_header_t));
+        if (attach_type->value == OGS_NAS_ATTACH_TYPE_EPS_ERMERGENCY_ATTACH)
+            return 0;
+        return OGS_NAS_EPS_ATTACH_REJECT;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST:
+        return OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT;
+    case OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST:
+        if (mme_ue && mme_ue->t3413.pkbuf)
+            return 0;
+        return OGS_NAS_EPS_SERVICE_REJECT;
+    default:
+        return 0;
+    }
+}
+
 void s1ap_handle_s1_setup_request(mme_enb_t *enb, ogs_s1ap_message_t *message)
 {
     char buf[OGS_ADDRSTRLEN];
@@ -188,6 +251,9 @@ void s1ap_handle_s1_setup_request(mme_enb_t *enb, ogs_s1ap_message_t *message)
 
     enb->state.s1_setup_success = true;
     s1ap_send_s1_setup_response(enb);
+
+    if (mme_self()->overload.active)
+        s1ap_send_overload_start(enb);
 }
 
 void s1ap_handle_initial_ue_message(mme_enb_t *enb, ogs_s1ap_message_t *message)
@@ -359,6 +425,14 @@ void s1ap_handle_initial_ue_message(mme_enb_t *enb, ogs_s1ap_message_t *message)
         enb_ue->enb_ue_s1ap_id, enb_ue->mme_ue_s1ap_id,
         enb_ue->saved.tai.tac, enb_ue->saved.e_cgi.cell_id);
 
+    if (mme_self()->overload.active) {
+        uint8_t message_type = overload_reject_type(enb_ue, NAS_PDU);
+        if (message_type) {
+            nas_eps_send_congestion_reject(enb_ue, message_type);
+            return;
+        }
+    }
+
     s1ap_send_to_nas(enb_ue,
             S1AP_ProcedureCode_id_initialUEMessage, NAS_PDU);
 }
@@ -1685,11 +1759,8 @@ void s1ap_handle_path_switch_request(
             ogs_plmn_id_hexdump(&mme_ue->e_cgi.plmn_id),
             mme_ue->e_cgi.cell_id);
 
-    /* Update ENB-UE-S1AP-ID */
-    enb_ue->enb_ue_s1ap_id = *ENB_UE_S1AP_ID;
-
-    /* Change enb_ue to the NEW eNB */
-    enb_ue_switch_to_enb(enb_ue, enb);
+    /* Change enb_ue to the NEW eNB and update ENB-UE-S1AP-ID */
+    enb_ue_switch_to_enb(enb_ue, enb, *ENB_UE_S1AP_ID);
 
     ogs_info("    NEW ENB_UE_S1AP_ID[%d] MME_UE_S1AP_ID[%d]",
             enb_ue->enb_ue_s1ap_id, enb_ue->mme_ue_s1ap_id);
@@ -2153,7 +2224,7 @@ void s1ap_handle_handover_request_ack(
     ogs_debug("    Target : ENB_UE_S1AP_ID[%d] MME_UE_S1AP_ID[%d]",
             target_ue->enb_ue_s1ap_id, target_ue->mme_ue_s1ap_id);
 
-    target_ue->enb_ue_s1ap_id = *ENB_UE_S1AP_ID;
+    enb_ue_set_enb_ue_s1ap_id(target_ue, *ENB_UE_S1AP_ID);
 
     for (i = 0; i < E_RABAdmittedList->list.count; i++) {
         S1AP_E_RABAdmittedItemIEs_t *item = NULL;
@@ -374,6 +374,36 @@ void s1ap_send_mme_configuration_transfer(
     ogs_expect(rv == OGS_OK);
 }
 
+void s1ap_send_overload_start(mme_enb_t *enb)
+{
+    int rv;
+    ogs_pkbuf_t *s1apbuf = NULL;
+
+    ogs_assert(enb);
+
+    /* Emergency attach and paging responses are still accepted */
+    s1apbuf = s1ap_build_overload_start(
+        S1AP_OverloadAction_permit_emergency_sessions_and_mobile_terminated_services_only);
+    ogs_expect_or_return(s1apbuf);
+
+    rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
+    ogs_expect(rv == OGS_OK);
+}
+
+void s1ap_send_overload_stop(mme_enb_t *enb)
+{
+    int rv;
+    ogs_pkbuf_t *s1apbuf = NULL;
+
+    ogs_assert(enb);
+
+    s1apbuf = s1ap_build_overload_stop();
+    ogs_expect_or_return(s1apbuf);
+
+    rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
+    ogs_expect(rv == OGS_OK);
+}
+
 void s1ap_send_e_rab_modification_confirm(mme_ue_t *mme_ue)
 {
     int rv;
@@ -62,6 +62,9 @@ void s1ap_send_mme_configuration_transfer(
         mme_enb_t *target_enb,
         S1AP_SONConfigurationTransfer_t *SONConfigurationTransfer);
 
+void s1ap_send_overload_start(mme_enb_t *enb);
+void s1ap_send_overload_stop(mme_enb_t *enb);
+
 void s1ap_send_e_rab_modification_confirm(mme_ue_t *mme_ue);
 
 void s1ap_send_path_switch_ack(mme_ue_t *mme_ue);
@@ -34,6 +34,8 @@ pcrf_context_t *pcrf_self(void)
 
 void pcrf_context_init(void)
 {
+    int i;
+
     ogs_assert(context_initialized == 0);
 
     /* Initial FreeDiameter Config */
@@ -47,22 +49,26 @@ void pcrf_context_init(void)
     ogs_log_install_domain(&__ogs_dbi_domain, "dbi", ogs_core()->log.level);
     ogs_log_install_domain(&__pcrf_log_domain, "pcrf", ogs_core()->log.level);
 
-    ogs_thread_mutex_init(&self.db_lock);
-
-    ogs_thread_mutex_init(&self.hash_lock);
-    self.ip_hash = ogs_hash_make();
+    for (i = 0; i < PCRF_NUM_OF_IP_HASH_STRIPE; i++) {
+        ogs_thread_mutex_init(&self.ip_hash[i].lock);
+        self.ip_hash[i].hash = ogs_hash_make();
+        ogs_assert(self.ip_hash[i].hash);
+    }
 
     context_initialized = 1;
 }
 
 void pcrf_context_final(void)
 {
+    int i;
+
     ogs_assert(context_initialized == 1);
-    ogs_assert(self.ip_hash);
-    ogs_hash_destroy(self.ip_hash);
-    ogs_thread_mutex_destroy(&self.hash_lock);
 
-    ogs_thread_mutex_destroy(&self.db_lock);
+    for (i = 0; i < PCRF_NUM_OF_IP_HASH_STRIPE; i++) {
+        ogs_assert(self.ip_hash[i].hash);
+        ogs_hash_destroy(self.ip_hash[i].hash);
+        ogs_thread_mutex_destroy(&self.ip_hash[i].lock);
+    }
 
     context_initialized = 0;
 }
@@ -273,7 +279,6 @@ int pcrf_db_qos_data(
     ogs_assert(apn);
     ogs_assert(session_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
@@ -284,58 +289,72 @@ int pcrf_db_qos_data(
     rv = ogs_dbi_session_data(supi, &s_nssai, apn, session_data);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
 
-void pcrf_sess_set_ipv4(const void *key, uint8_t *sid)
+/*
+ * The stripe is selected by the upper bits of the hash value,
+ * since the lower bits select the bucket in the hash table of the stripe.
+ */
+static pcrf_ip_hash_t *ip_hash_stripe(const void *key, int klen)
 {
-    ogs_assert(self.ip_hash);
-
-    ogs_thread_mutex_lock(&self.hash_lock);
-
-    ogs_hash_set(self.ip_hash, key, OGS_IPV4_LEN, sid);
+    unsigned int hash = ogs_hashfunc_default(key, &klen);
 
-    ogs_thread_mutex_unlock(&self.hash_lock);
+    return &self.ip_hash[
+        ((hash * 2654435769U) >> 16) % PCRF_NUM_OF_IP_HASH_STRIPE];
 }
-void pcrf_sess_set_ipv6(const void *key, uint8_t *sid)
+
+static void sess_set(const void *key, int klen, uint8_t *sid)
 {
-    ogs_assert(self.ip_hash);
+    pcrf_ip_hash_t *ip_hash = NULL;
+
+    ogs_assert(key);
+
+    ip_hash = ip_hash_stripe(key, klen);
+    ogs_assert(ip_hash->hash);
 
-    ogs_thread_mutex_lock(&self.hash_lock);
+    ogs_thread_mutex_lock(&ip_hash->lock);
 
-    ogs_hash_set(self.ip_hash, key, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3, sid);
+    ogs_hash_set(ip_hash->hash, key, klen, sid);
 
-    ogs_thread_mutex_unlock(&self.hash_lock);
+    ogs_thread_mutex_unlock(&ip_hash->lock);
 }
 
-uint8_t *pcrf_sess_find_by_ipv4(const void *key)
+static uint8_t *sess_find(const void *key, int klen)
 {
+    pcrf_ip_hash_t *ip_hash = NULL;
     uint8_t *sid = NULL;
+
     ogs_assert(key);
 
-    ogs_thread_mutex_lock(&self.hash_lock);
+    ip_hash = ip_hash_stripe(key, klen);
+    ogs_assert(ip_hash->hash);
 
-    sid = (uint8_t *)ogs_hash_get(self.ip_hash, key, OGS_IPV4_LEN);
+    ogs_thread_mutex_lock(&ip_hash->lock);
+
+    sid = (uint8_t *)ogs_hash_get(ip_hash->hash, key, klen);
+
+    ogs_thread_mutex_unlock(&ip_hash->lock);
 
-    ogs_thread_mutex_unlock(&self.hash_lock);
-    
     return sid;
 }
 
-uint8_t *pcrf_sess_find_by_ipv6(const void *key)
+void pcrf_sess_set_ipv4(const void *key, uint8_t *sid)
 {
-    uint8_t *sid = NULL;
-    ogs_assert(key);
-
-    ogs_thread_mutex_lock(&self.hash_lock);
-
-    sid = (uint8_t *)ogs_hash_get(
-            self.ip_hash, key, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3);
-
-    ogs_thread_mutex_unlock(&self.hash_lock);
+    sess_set(key, OGS_IPV4_LEN, sid);
+}
+void pcrf_sess_set_ipv6(const void *key, uint8_t *sid)
+{
+    sess_set(key, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3, sid);
+}
 
-    return sid;
+uint8_t *pcrf_sess_find_by_ipv4(const void *key)
+{
+    return sess_find(key, OGS_IPV4_LEN);
 }
 
+uint8_t *pcrf_sess_find_by_ipv6(const void *key)
+{
+    return sess_find(key, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3);
+}
@@ -37,14 +37,25 @@ extern int __pcrf_log_domain;
 typedef struct fd_config_s fd_config_t;
 struct session;
 
+/*
+ * The Gx and Rx requests are handled by the worker threads of freeDiameter.
+ * The hash table for Gx Framed IPv4/IPv6 is split into stripes,
+ * each with its own lock, so that the threads rarely wait for each other.
+ * The database is queried through the client pool of ogs-dbi.
+ */
+#define PCRF_NUM_OF_IP_HASH_STRIPE 64
+
+typedef struct pcrf_ip_hash_s {
+    ogs_hash_t          *hash;
+    ogs_thread_mutex_t  lock;
+} __attribute__ ((aligned (64))) pcrf_ip_hash_t;
+
 typedef struct pcrf_context_s {
     const char          *diam_conf_path;  /* PCRF Diameter conf path */
     ogs_diam_config_t   *diam_config;     /* PCRF Diameter config */
 
-    ogs_thread_mutex_t  db_lock;
-
-    ogs_hash_t          *ip_hash; /* hash table for Gx Frame IPv4/IPv6 */
-    ogs_thread_mutex_t  hash_lock;
+    /* hash table for Gx Frame IPv4/IPv6 */
+    pcrf_ip_hash_t      ip_hash[PCRF_NUM_OF_IP_HASH_STRIPE];
 } pcrf_context_t;
 
 void pcrf_context_init(void);
@@ -37,6 +37,8 @@ int pcrf_initialize(void)
 
     rv = ogs_dbi_init(ogs_app()->db_uri);
     if (rv != OGS_OK) return rv;
+    rv = ogs_dbi_pool_init();
+    if (rv != OGS_OK) return rv;
 
     rv = pcrf_fd_init();
     if (rv != OGS_OK) return OGS_ERROR;
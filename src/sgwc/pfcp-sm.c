@@ -248,6 +248,11 @@ void sgwc_pfcp_state_associated(ogs_fsm_t *s, sgwc_event_t *e)
                 sess, xact, &message->pfcp_session_report_request);
             break;
 
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            ogs_pfcp_cp_handle_node_report_request(node, xact,
+                    &message->pfcp_node_report_request);
+            break;
+
         default:
             ogs_error("Not implemented PFCP message type[%d]",
                     message->h.type);
@@ -44,7 +44,7 @@ void sgwu_context_init(void)
     ogs_list_init(&self.sess_list);
     ogs_pool_init(&sgwu_sess_pool, ogs_app()->pool.sess);
 
-    self.sess_hash = ogs_hash_make();
+    self.sess_hash = ogs_ihash_make(sizeof(uint64_t));
 
     context_initialized = 1;
 }
@@ -56,7 +56,7 @@ void sgwu_context_final(void)
     sgwu_sess_remove_all();
 
     ogs_assert(self.sess_hash);
-    ogs_hash_destroy(self.sess_hash);
+    ogs_ihash_destroy(self.sess_hash);
 
     ogs_pool_final(&sgwu_sess_pool);
 
@@ -106,6 +106,8 @@ int sgwu_context_parse_config(void)
                 ogs_assert(sgwu_key);
                 if (!strcmp(sgwu_key, "gtpu")) {
                     /* handle config in gtp library */
+                } else if (!strcmp(sgwu_key, "echo")) {
+                    /* handle config in gtp library */
                 } else if (!strcmp(sgwu_key, "pfcp")) {
                     /* handle config in pfcp library */
                 } else
@@ -137,8 +139,7 @@ sgwu_sess_t *sgwu_sess_add(ogs_pfcp_f_seid_t *cp_f_seid)
 
     sess->sgwu_sxa_seid = sess->index;
     sess->sgwc_sxa_seid = cp_f_seid->seid;
-    ogs_hash_set(self.sess_hash, &sess->sgwc_sxa_seid,
-            sizeof(sess->sgwc_sxa_seid), sess);
+    ogs_ihash_set(self.sess_hash, &sess->sgwc_sxa_seid, sess);
 
     ogs_info("UE F-SEID[CP:0x%lx UP:0x%lx]",
         (long)sess->sgwu_sxa_seid, (long)sess->sgwc_sxa_seid);
@@ -158,8 +159,7 @@ int sgwu_sess_remove(sgwu_sess_t *sess)
     ogs_list_remove(&self.sess_list, sess);
     ogs_pfcp_sess_clear(&sess->pfcp);
 
-    ogs_hash_set(self.sess_hash, &sess->sgwc_sxa_seid,
-            sizeof(sess->sgwc_sxa_seid), NULL);
+    ogs_ihash_set(self.sess_hash, &sess->sgwc_sxa_seid, NULL);
 
     ogs_pfcp_pool_final(&sess->pfcp);
 
@@ -188,7 +188,7 @@ sgwu_sess_t *sgwu_sess_find(uint32_t index)
 
 sgwu_sess_t *sgwu_sess_find_by_cp_seid(uint64_t seid)
 {
-    return (sgwu_sess_t *)ogs_hash_get(self.sess_hash, &seid, sizeof(seid));
+    return (sgwu_sess_t *)ogs_ihash_get(self.sess_hash, &seid);
 }
 
 sgwu_sess_t *sgwu_sess_find_by_up_seid(uint64_t seid)
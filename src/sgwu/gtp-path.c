@@ -24,17 +24,14 @@
 
 static ogs_pkbuf_pool_t *packet_pool = NULL;
 
-static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+static void gtpv1_u_handle(
+        ogs_socket_t fd, ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from)
 {
     int len;
-    ssize_t size;
     char buf[OGS_ADDRSTRLEN];
 
     sgwu_sess_t *sess = NULL;
 
-    ogs_pkbuf_t *pkbuf = NULL;
-    ogs_sockaddr_t from;
-
     ogs_gtp_header_t *gtp_h = NULL;
     ogs_pfcp_user_plane_report_t report;
 
@@ -42,21 +39,8 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     uint8_t qfi;
 
     ogs_assert(fd != INVALID_SOCKET);
-
-    pkbuf = ogs_pkbuf_alloc(packet_pool, OGS_MAX_PKT_LEN);
-    ogs_assert(pkbuf);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_PKT_LEN);
-
-    size = ogs_recvfrom(fd, pkbuf->data, pkbuf->len, 0, &from);
-    if (size <= 0) {
-        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
-                "ogs_recv() failed");
-        goto cleanup;
-    }
-
-    ogs_pkbuf_trim(pkbuf, size);
-
     ogs_assert(pkbuf);
+    ogs_assert(from);
     ogs_assert(pkbuf->len);
 
     gtp_h = (ogs_gtp_header_t *)pkbuf->data;
@@ -69,15 +53,15 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     if (gtp_h->type == OGS_GTPU_MSGTYPE_ECHO_REQ) {
         ogs_pkbuf_t *echo_rsp;
 
-        ogs_debug("[RECV] Echo Request from [%s]", OGS_ADDR(&from, buf));
+        ogs_debug("[RECV] Echo Request from [%s]", OGS_ADDR(from, buf));
         echo_rsp = ogs_gtp_handle_echo_req(pkbuf);
         if (echo_rsp) {
             ssize_t sent;
 
             /* Echo reply */
-            ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(&from, buf));
+            ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(from, buf));
 
-            sent = ogs_sendto(fd, echo_rsp->data, echo_rsp->len, 0, &from);
+            sent = ogs_sendto(fd, echo_rsp->data, echo_rsp->len, 0, from);
             if (sent < 0 || sent != echo_rsp->len) {
                 ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
                         "ogs_sendto() failed");
@@ -87,10 +71,16 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         goto cleanup;
     }
 
+    if (gtp_h->type == OGS_GTPU_MSGTYPE_ECHO_RSP) {
+        ogs_debug("[RECV] Echo Response from [%s]", OGS_ADDR(from, buf));
+        ogs_gtp_echo_handle_response(pkbuf, from);
+        goto cleanup;
+    }
+
     teid = be32toh(gtp_h->teid);
 
     ogs_debug("[RECV] GPU-U Type [%d] from [%s] : TEID[0x%x]",
-            gtp_h->type, OGS_ADDR(&from, buf), teid);
+            gtp_h->type, OGS_ADDR(from, buf), teid);
 
     qfi = 0;
     if (gtp_h->flags & OGS_GTPU_FLAGS_E) {
@@ -227,6 +217,67 @@ cleanup:
     ogs_pkbuf_free(pkbuf);
 }
 
+static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+{
+    ogs_pkbuf_t *pkbuf[OGS_MAX_NUM_OF_MMSG];
+    ogs_sockaddr_t from[OGS_MAX_NUM_OF_MMSG];
+    int i, n, received = 0;
+
+    ogs_assert(fd != INVALID_SOCKET);
+
+    ogs_gtp_send_batch_start();
+
+    while (received < OGS_POLL_BUDGET) {
+        for (i = 0; i < OGS_MAX_NUM_OF_MMSG; i++) {
+            pkbuf[i] = ogs_pkbuf_alloc(packet_pool, OGS_MAX_PKT_LEN);
+            ogs_assert(pkbuf[i]);
+            ogs_pkbuf_put(pkbuf[i], OGS_MAX_PKT_LEN);
+        }
+
+        n = ogs_recvmmsg(fd, pkbuf, from, OGS_MAX_NUM_OF_MMSG);
+        if (n < 0 && ogs_socket_errno != OGS_EAGAIN)
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_recvmmsg() failed");
+
+        for (i = 0; i < n; i++) {
+            /* Drop a zero-length datagram */
+            if (pkbuf[i]->len == 0) {
+                ogs_pkbuf_free(pkbuf[i]);
+                continue;
+            }
+            gtpv1_u_handle(fd, pkbuf[i], &from[i]);
+        }
+        for (i = ogs_max(n, 0); i < OGS_MAX_NUM_OF_MMSG; i++)
+            ogs_pkbuf_free(pkbuf[i]);
+
+        if (n <= 0)
+            break;
+
+        received += n;
+
+        /* A short read has emptied the socket queue */
+        if (n < OGS_MAX_NUM_OF_MMSG)
+            break;
+    }
+
+    ogs_gtp_send_batch_flush();
+
+    if (received >= OGS_POLL_BUDGET)
+        ogs_pollset_continue(ogs_app()->pollset);
+}
+
+/*
+ * Only the failure of a path is reported to the SGW-C, with one Node Report
+ * for the peer instead of a Session Report for each session on the path.
+ */
+static void gtp_path_changed(ogs_gtp_node_t *gnode)
+{
+    ogs_assert(gnode);
+
+    if (gnode->path.down)
+        sgwu_pfcp_send_node_report_request(gnode);
+}
+
 int sgwu_gtp_init(void)
 {
     ogs_pkbuf_config_t config;
@@ -259,16 +310,21 @@ int sgwu_gtp_open(void)
             ogs_gtp_self()->gtpu_sock6 = sock;
 
         node->poll = ogs_pollset_add(ogs_app()->pollset,
-                OGS_POLLIN, sock->fd, _gtpv1_u_recv_cb, sock);
+                OGS_POLLIN|OGS_POLLET, sock->fd, _gtpv1_u_recv_cb, sock);
         ogs_assert(node->poll);
     }
 
     OGS_SETUP_GTPU_SERVER;
 
+    if (ogs_gtp_echo_open(gtp_path_changed) != OGS_OK)
+        return OGS_ERROR;
+
     return OGS_OK;
 }
 
 void sgwu_gtp_close(void)
 {
+    ogs_gtp_echo_close();
+
     ogs_socknode_remove_all(&ogs_gtp_self()->gtpu_list);
 }
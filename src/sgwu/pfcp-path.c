@@ -278,3 +278,33 @@ void sgwu_pfcp_send_session_report_request(
     rv = ogs_pfcp_xact_commit(xact);
     ogs_expect(rv == OGS_OK);
 }
+
+static void node_timeout(ogs_pfcp_xact_t *xact, void *data)
+{
+    uint8_t type;
+
+    ogs_assert(xact);
+    type = xact->seq[0].type;
+
+    switch (type) {
+    case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+        ogs_error("No PFCP node report response");
+        break;
+    default:
+        ogs_error("Not implemented [type:%d]", type);
+        break;
+    }
+}
+
+void sgwu_pfcp_send_node_report_request(ogs_gtp_node_t *gnode)
+{
+    ogs_pfcp_node_t *node = NULL;
+
+    ogs_assert(gnode);
+
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_peer_list, node) {
+        if (OGS_FSM_CHECK(&node->sm, sgwu_pfcp_state_associated))
+            ogs_pfcp_up_send_node_report_request(
+                    node, &gnode->addr, node_timeout);
+    }
+}
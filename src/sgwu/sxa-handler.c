@@ -145,6 +145,9 @@ void sgwu_sxa_handle_session_establishment_request(
         }
     }
 
+    /* Rebuild the Forwarding Entries of the PDRs */
+    ogs_pfcp_sess_update_fwd(&sess->pfcp);
+
     /* Send Buffered Packet to gNB */
     ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
         if (pdr->src_if == OGS_PFCP_INTERFACE_CORE) { /* Downlink */
@@ -279,6 +282,11 @@ void sgwu_sxa_handle_session_modification_request(
     if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
         goto cleanup;
 
+    ogs_pfcp_handle_update_bar(&sess->pfcp, &req->update_bar,
+            &cause_value, &offending_ie_value);
+    if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
+        goto cleanup;
+
     ogs_pfcp_handle_remove_bar(&sess->pfcp, &req->remove_bar,
             &cause_value, &offending_ie_value);
     if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
@@ -350,6 +358,9 @@ void sgwu_sxa_handle_session_modification_request(
         }
     }
 
+    /* Rebuild the Forwarding Entries of the PDRs */
+    ogs_pfcp_sess_update_fwd(&sess->pfcp);
+
     /* Send Buffered Packet to gNB */
     ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
         if (pdr->src_if == OGS_PFCP_INTERFACE_CORE) { /* Downlink */
@@ -426,4 +437,7 @@ void sgwu_sxa_handle_session_report_response(
         ogs_error("Cause request not accepted[%d]", cause_value);
         return;
     }
+
+    ogs_pfcp_handle_update_bar_report_response(
+            &sess->pfcp, &rsp->update_bar);
 }
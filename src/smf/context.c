@@ -55,9 +55,16 @@ void smf_context_init(void)
     ogs_log_install_domain(&__smf_log_domain, "smf", ogs_core()->log.level);
     ogs_log_install_domain(&__gsm_log_domain, "gsm", ogs_core()->log.level);
 
+    /* Setup CP Function Features */
+    ogs_pfcp_self()->cp_function_features.load = 1;
+    ogs_pfcp_self()->cp_function_features.ovrl = 1;
+
     ogs_pool_init(&smf_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&smf_sess_pool, ogs_app()->pool.sess);
     ogs_pool_init(&smf_bearer_pool, ogs_app()->pool.bearer);
+    ogs_pool_set_trim(&smf_ue_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&smf_sess_pool, ogs_app()->pool.trim);
+    ogs_pool_set_trim(&smf_bearer_pool, ogs_app()->pool.trim);
 
     ogs_pool_init(&smf_pf_pool, ogs_app()->pool.bearer * OGS_MAX_NUM_OF_PF);
 
@@ -67,6 +74,10 @@ void smf_context_init(void)
     self.ipv6_hash = ogs_hash_make();
     self.n1n2message_hash = ogs_hash_make();
 
+    self.metrics.ue = ogs_metrics_add_pool(&smf_ue_pool, "smf_ue");
+    self.metrics.sess = ogs_metrics_add_pool(&smf_sess_pool, "smf_sess");
+    self.metrics.bearer = ogs_metrics_add_pool(&smf_bearer_pool, "smf_bearer");
+
     context_initialized = 1;
 }
 
@@ -87,6 +98,10 @@ void smf_context_final(void)
     ogs_assert(self.n1n2message_hash);
     ogs_hash_destroy(self.n1n2message_hash);
 
+    if (self.metrics.ue) ogs_metrics_remove(self.metrics.ue);
+    if (self.metrics.sess) ogs_metrics_remove(self.metrics.sess);
+    if (self.metrics.bearer) ogs_metrics_remove(self.metrics.bearer);
+
     ogs_pool_final(&smf_ue_pool);
     ogs_pool_final(&smf_bearer_pool);
     ogs_pool_final(&smf_sess_pool);
@@ -876,47 +891,79 @@ static bool compare_ue_info(ogs_pfcp_node_t *node, smf_sess_t *sess)
     return false;
 }
 
+/*
+ * An overloaded UPF is only chosen if every candidate is overloaded.
+ * Otherwise the UPF with the lowest Load Metric wins. Ties are broken
+ * in round-robin order from the current position, so UPFs which do not
+ * report their load are still selected in turn.
+ */
+static bool upf_node_less_loaded(
+        ogs_pfcp_node_t *node, ogs_pfcp_node_t *best)
+{
+    bool overloaded, best_overloaded;
+
+    if (!best)
+        return true;
+
+    overloaded = ogs_pfcp_node_overloaded(node);
+    best_overloaded = ogs_pfcp_node_overloaded(best);
+    if (overloaded != best_overloaded)
+        return best_overloaded;
+
+    return node->load.metric < best->load.metric;
+}
+
+static ogs_pfcp_node_t *least_loaded_upf_node(
+        ogs_pfcp_node_t *current, smf_sess_t *sess, bool check_ue_info)
+{
+    ogs_pfcp_node_t *node, *best = NULL;
+
+    ogs_assert(current);
+    ogs_assert(sess);
+
+    node = current;
+    do {
+        /* cyclic search from the next of current position */
+        node = ogs_list_next(node);
+        if (!node)
+            node = ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
+        ogs_assert(node);
+
+        if (!OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated))
+            continue;
+        if (check_ue_info == true && compare_ue_info(node, sess) == false)
+            continue;
+
+        if (upf_node_less_loaded(node, best) == true)
+            best = node;
+    } while (node != current);
+
+    return best;
+}
+
 static ogs_pfcp_node_t *selected_upf_node(
         ogs_pfcp_node_t *current, smf_sess_t *sess)
 {
-    ogs_pfcp_node_t *next, *node;
+    ogs_pfcp_node_t *node;
 
     ogs_assert(current);
     ogs_assert(sess);
 
-    /* continue search from current position */
-    next = ogs_list_next(current);
-    for (node = next; node; node = ogs_list_next(node)) {
-        if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated) &&
-            compare_ue_info(node, sess) == true) return node;
-    }
-    /* cyclic search from top to current position */
-    for (node = ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
-            node != next; node = ogs_list_next(node)) {
-        if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated) &&
-            compare_ue_info(node, sess) == true) return node;
-    }
+    node = least_loaded_upf_node(current, sess, true);
+    if (node)
+        return node;
 
     if (ogs_app()->parameter.no_pfcp_rr_select == 0) {
-        /* continue search from current position */
-        next = ogs_list_next(current);
-        for (node = next; node; node = ogs_list_next(node)) {
-            if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated))
-                return node;
-        }
-        /* cyclic search from top to current position */
-        for (node = ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
-                node != next; node = ogs_list_next(node)) {
-            if (OGS_FSM_CHECK(&node->sm, smf_pfcp_state_associated))
-                return node;
-        }
+        node = least_loaded_upf_node(current, sess, false);
+        if (node)
+            return node;
     }
 
     ogs_error("No UPFs are PFCP associated that are suited to RR");
     return ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
 }
 
-void smf_sess_select_upf(smf_sess_t *sess)
+bool smf_sess_select_upf(smf_sess_t *sess)
 {
     char buf[OGS_ADDRSTRLEN];
 
@@ -937,6 +984,15 @@ void smf_sess_select_upf(smf_sess_t *sess)
     OGS_SETUP_PFCP_NODE(sess, ogs_pfcp_self()->pfcp_node);
     ogs_debug("UE using UPF on IP[%s]",
             OGS_ADDR(&ogs_pfcp_self()->pfcp_node->addr, buf));
+
+    /* Every candidate is overloaded */
+    if (ogs_pfcp_node_throttled(sess->pfcp_node) == true) {
+        ogs_warn("UPF[%s] overloaded : new session throttled",
+                OGS_ADDR(&sess->pfcp_node->addr, buf));
+        return false;
+    }
+
+    return true;
 }
 
 smf_sess_t *smf_sess_add_by_apn(smf_ue_t *smf_ue, char *apn)
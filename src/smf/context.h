@@ -80,6 +80,10 @@ typedef struct smf_context_s {
 #define SMF_UE_IS_LAST_SESSION(__sMF) \
      ((__sMF) && (ogs_list_count(&(__sMF)->sess_list)) == 1)
     ogs_list_t      smf_ue_list;
+
+    struct {
+        ogs_metrics_t *ue, *sess, *bearer;
+    } metrics;
 } smf_context_t;
 
 typedef struct smf_ue_s {
@@ -344,7 +348,7 @@ smf_sess_t *smf_sess_add_by_apn(smf_ue_t *smf_ue, char *apn);
 smf_sess_t *smf_sess_add_by_sbi_message(ogs_sbi_message_t *message);
 smf_sess_t *smf_sess_add_by_psi(smf_ue_t *smf_ue, uint8_t psi);
 
-void smf_sess_select_upf(smf_sess_t *sess);
+bool smf_sess_select_upf(smf_sess_t *sess);
 void smf_sess_set_ue_ip(smf_sess_t *sess);
 void smf_sess_set_paging_n1n2message_location(
         smf_sess_t *sess, char *n1n2message_location);
@@ -799,6 +799,18 @@ void smf_n4_handle_session_report_request(
     ogs_assert(sess);
     report_type.value = pfcp_req->report_type.u8;
 
+    /*
+     * The UPF merges the reports of a session into one request,
+     * so each trigger of the Report Type is handled.
+     */
+    if (!report_type.downlink_data_report &&
+        !report_type.error_indication_report) {
+        ogs_error("Not supported Report Type[%d]", report_type.value);
+        smf_pfcp_send_session_report_response(
+                pfcp_xact, sess, OGS_PFCP_CAUSE_SYSTEM_FAILURE);
+        return;
+    }
+
     if (report_type.downlink_data_report) {
         ogs_pfcp_downlink_data_service_information_t *info = NULL;
         uint8_t paging_policy_indication_value = 0;
@@ -857,14 +869,20 @@ void smf_n4_handle_session_report_request(
 
         if (!pdr || !qos_flow) {
             ogs_error("No Context [%p:%p]", pdr, qos_flow);
-            ogs_pfcp_send_error_message(pfcp_xact, 0,
-                    OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE,
-                    cause_value, 0);
+            if (!report_type.error_indication_report) {
+                ogs_pfcp_send_error_message(pfcp_xact, 0,
+                        OGS_PFCP_SESSION_REPORT_RESPONSE_TYPE,
+                        cause_value, 0);
+                return;
+            }
+            report_type.downlink_data_report = 0;
         }
+    }
 
-        smf_pfcp_send_session_report_response(
-                pfcp_xact, sess, OGS_PFCP_CAUSE_REQUEST_ACCEPTED);
+    smf_pfcp_send_session_report_response(
+            pfcp_xact, sess, OGS_PFCP_CAUSE_REQUEST_ACCEPTED);
 
+    if (report_type.downlink_data_report) {
         if (sess->paging.ue_requested_pdu_session_establishment_done == true) {
             smf_n1_n2_message_transfer_param_t param;
 
@@ -879,29 +897,21 @@ void smf_n4_handle_session_report_request(
 
             smf_namf_comm_send_n1_n2_message_transfer(sess, &param);
         }
+    }
 
-    } else if (report_type.error_indication_report) {
+    if (report_type.error_indication_report) {
         smf_ue_t *smf_ue = sess->smf_ue;
         smf_sess_t *error_indication_session = NULL;
         ogs_assert(smf_ue);
 
-        smf_pfcp_send_session_report_response(
-                pfcp_xact, sess, OGS_PFCP_CAUSE_REQUEST_ACCEPTED);
-
         error_indication_session = smf_sess_find_by_error_indication_report(
                 smf_ue, &pfcp_req->error_indication_report);
 
-        if (!error_indication_session) return;
-
-        smf_5gc_pfcp_send_session_modification_request(
-                error_indication_session, NULL,
-                OGS_PFCP_MODIFY_DL_ONLY|OGS_PFCP_MODIFY_DEACTIVATE|
-                OGS_PFCP_MODIFY_ERROR_INDICATION,
-                0);
-
-    } else {
-        ogs_error("Not supported Report Type[%d]", report_type.value);
-        smf_pfcp_send_session_report_response(
-                pfcp_xact, sess, OGS_PFCP_CAUSE_SYSTEM_FAILURE);
+        if (error_indication_session)
+            smf_5gc_pfcp_send_session_modification_request(
+                    error_indication_session, NULL,
+                    OGS_PFCP_MODIFY_DL_ONLY|OGS_PFCP_MODIFY_DEACTIVATE|
+                    OGS_PFCP_MODIFY_ERROR_INDICATION,
+                    0);
     }
 }
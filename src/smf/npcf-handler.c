@@ -362,7 +362,18 @@ bool smf_npcf_smpolicycontrol_handle_create(
      *********************************************************************/
 
     /* Select UPF based on UE Location Information */
-    smf_sess_select_upf(sess);
+    if (smf_sess_select_upf(sess) == false) {
+        strerror = ogs_msprintf("[%s:%d] UPF overloaded",
+                smf_ue->supi, sess->psi);
+        ogs_assert(strerror);
+
+        ogs_error("%s", strerror);
+        ogs_sbi_server_send_error(stream,
+                OGS_SBI_HTTP_STATUS_SERVICE_UNAVAILABLE,
+                recvmsg, strerror, NULL);
+        ogs_free(strerror);
+        return false;
+    }
 
     /* Check if selected UPF is associated with SMF */
     ogs_assert(sess->pfcp_node);
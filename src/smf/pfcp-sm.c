@@ -213,6 +213,11 @@ void smf_pfcp_state_associated(ogs_fsm_t *s, smf_event_t *e)
                 break;
             }
 
+            ogs_pfcp_cp_handle_load_control_information(node,
+                    &message->pfcp_session_establishment_response.load_control_information);
+            ogs_pfcp_cp_handle_overload_control_information(node,
+                    &message->pfcp_session_establishment_response.overload_control_information);
+
             if (xact->epc)
                 smf_epc_n4_handle_session_establishment_response(
                     sess, xact, &message->pfcp_session_establishment_response);
@@ -227,6 +232,11 @@ void smf_pfcp_state_associated(ogs_fsm_t *s, smf_event_t *e)
                 break;
             }
 
+            ogs_pfcp_cp_handle_load_control_information(node,
+                    &message->pfcp_session_modification_response.load_control_information);
+            ogs_pfcp_cp_handle_overload_control_information(node,
+                    &message->pfcp_session_modification_response.overload_control_information);
+
             if (xact->epc)
                 smf_epc_n4_handle_session_modification_response(
                     sess, xact, &message->pfcp_session_modification_response);
@@ -241,6 +251,11 @@ void smf_pfcp_state_associated(ogs_fsm_t *s, smf_event_t *e)
                 break;
             }
 
+            ogs_pfcp_cp_handle_load_control_information(node,
+                    &message->pfcp_session_deletion_response.load_control_information);
+            ogs_pfcp_cp_handle_overload_control_information(node,
+                    &message->pfcp_session_deletion_response.overload_control_information);
+
             if (xact->epc)
                 smf_epc_n4_handle_session_deletion_response(
                     sess, xact, &message->pfcp_session_deletion_response);
@@ -255,10 +270,20 @@ void smf_pfcp_state_associated(ogs_fsm_t *s, smf_event_t *e)
                 break;
             }
 
+            ogs_pfcp_cp_handle_load_control_information(node,
+                    &message->pfcp_session_report_request.load_control_information);
+            ogs_pfcp_cp_handle_overload_control_information(node,
+                    &message->pfcp_session_report_request.overload_control_information);
+
             smf_n4_handle_session_report_request(
                 sess, xact, &message->pfcp_session_report_request);
             break;
 
+        case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+            ogs_pfcp_cp_handle_node_report_request(node, xact,
+                    &message->pfcp_node_report_request);
+            break;
+
         default:
             ogs_error("Not implemented PFCP message type[%d]",
                     message->h.type);
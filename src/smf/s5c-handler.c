@@ -135,7 +135,12 @@ void smf_s5c_handle_create_session_request(
     memcpy(&sess->e_cgi, &uli.e_cgi, sizeof(sess->e_cgi));
 
     /* Select PGW based on UE Location Information */
-    smf_sess_select_upf(sess);
+    if (smf_sess_select_upf(sess) == false) {
+        ogs_gtp_send_error_message(xact, sess->sgw_s5c_teid,
+                OGS_GTP_CREATE_SESSION_RESPONSE_TYPE,
+                OGS_GTP_CAUSE_NO_RESOURCES_AVAILABLE);
+        return;
+    }
 
     /* Check if selected PGW is associated with SMF */
     ogs_assert(sess->pfcp_node);
@@ -0,0 +1,468 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "context.h"
+#include "pfcp-path.h"
+#include "gtp-offload.h"
+#include "checkpoint.h"
+
+#define UPF_CHECKPOINT_VERSION          1
+#define UPF_CHECKPOINT_SLOT_SIZE        2048
+
+static ogs_checkpoint_t *checkpoint = NULL;
+
+static void encode_ue_ip(
+        ogs_checkpoint_cursor_t *cursor, ogs_pfcp_ue_ip_t *ue_ip)
+{
+    int32_t index = -1; /* No UE IP */
+
+    if (ue_ip)
+        index = ue_ip->static_ip ? 0 :
+            ogs_pool_index(&ue_ip->subnet->pool, ue_ip);
+
+    OGS_CHECKPOINT_PUT(cursor, index);
+    if (ue_ip) {
+        ogs_checkpoint_put_string(cursor, ue_ip->subnet->dnn);
+        OGS_CHECKPOINT_PUT(cursor, ue_ip->addr);
+    }
+}
+
+static void encode_pdr(ogs_checkpoint_cursor_t *cursor, ogs_pfcp_pdr_t *pdr)
+{
+    ogs_pfcp_object_t *obj = NULL;
+    ogs_pfcp_rule_t *rule = NULL;
+    ogs_pfcp_far_id_t far_id = pdr->far ? pdr->far->id : 0;
+    ogs_pfcp_urr_id_t urr_id = pdr->urr ? pdr->urr->id : 0;
+    ogs_pfcp_qer_id_t qer_id = pdr->qer ? pdr->qer->id : 0;
+    uint8_t hash_type = OGS_PFCP_OBJ_BASE; /* Not in the TEID hash */
+    uint8_t num_of_rule = ogs_list_count(&pdr->rule_list);
+
+    if (pdr->hash.teid.len) {
+        obj = ogs_pfcp_object_find_by_teid(pdr->hash.teid.key);
+        if (obj == &pdr->obj)
+            hash_type = OGS_PFCP_OBJ_PDR_TYPE;
+        else if (obj == &pdr->sess->obj)
+            hash_type = OGS_PFCP_OBJ_SESS_TYPE;
+    }
+
+    OGS_CHECKPOINT_PUT(cursor, pdr->index);
+    OGS_CHECKPOINT_PUT(cursor, pdr->id);
+    OGS_CHECKPOINT_PUT(cursor, pdr->precedence);
+    OGS_CHECKPOINT_PUT(cursor, pdr->src_if);
+    ogs_checkpoint_put_string(cursor, pdr->dnn);
+    OGS_CHECKPOINT_PUT(cursor, pdr->ue_ip_addr);
+    OGS_CHECKPOINT_PUT(cursor, pdr->ue_ip_addr_len);
+    OGS_CHECKPOINT_PUT(cursor, pdr->ue_ipv6_prefixlen);
+    OGS_CHECKPOINT_PUT(cursor, pdr->ipv4_framed_route);
+    OGS_CHECKPOINT_PUT(cursor, pdr->ipv6_framed_route);
+    OGS_CHECKPOINT_PUT(cursor, pdr->f_teid);
+    OGS_CHECKPOINT_PUT(cursor, pdr->f_teid_len);
+    OGS_CHECKPOINT_PUT(cursor, pdr->chid);
+    OGS_CHECKPOINT_PUT(cursor, pdr->choose_id);
+    OGS_CHECKPOINT_PUT(cursor, pdr->outer_header_removal);
+    OGS_CHECKPOINT_PUT(cursor, pdr->outer_header_removal_len);
+    OGS_CHECKPOINT_PUT(cursor, pdr->qfi);
+    OGS_CHECKPOINT_PUT(cursor, far_id);
+    OGS_CHECKPOINT_PUT(cursor, urr_id);
+    OGS_CHECKPOINT_PUT(cursor, qer_id);
+    OGS_CHECKPOINT_PUT(cursor, hash_type);
+
+    OGS_CHECKPOINT_PUT(cursor, num_of_rule);
+    ogs_list_for_each(&pdr->rule_list, rule) {
+        OGS_CHECKPOINT_PUT(cursor, rule->flags);
+        OGS_CHECKPOINT_PUT(cursor, rule->ipfw);
+        OGS_CHECKPOINT_PUT(cursor, rule->sdf_filter_id);
+    }
+}
+
+/*
+ * The rules of the session are kept as they are in the context,
+ * so the downlink packets find the session by the UE IP address and
+ * the uplink packets by the TEID as soon as the UPF is up again.
+ * The buffered packets and the Downlink Data Report are not kept.
+ */
+static int encode_sess(int index, void *buf, size_t size, void *data)
+{
+    upf_sess_t *sess = NULL;
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_pfcp_far_t *far = NULL;
+    ogs_pfcp_urr_t *urr = NULL;
+    ogs_pfcp_qer_t *qer = NULL;
+    ogs_pfcp_bar_t *bar = NULL;
+    ogs_checkpoint_cursor_t cursor;
+    uint8_t num_of_far, num_of_urr, num_of_qer, num_of_pdr, has_bar;
+
+    sess = upf_sess_find(index);
+    if (!sess || !sess->pfcp_node || !ogs_list_first(&sess->pfcp.pdr_list))
+        return 0;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, size);
+
+    /* The SMF is found again by its address */
+    OGS_CHECKPOINT_PUT(&cursor, sess->pfcp_node->addr.sin6);
+    OGS_CHECKPOINT_PUT(&cursor, sess->smf_n4_seid);
+
+    encode_ue_ip(&cursor, sess->ipv4);
+    encode_ue_ip(&cursor, sess->ipv6);
+
+    bar = sess->pfcp.bar;
+    has_bar = bar != NULL;
+    OGS_CHECKPOINT_PUT(&cursor, has_bar);
+    if (bar) {
+        OGS_CHECKPOINT_PUT(&cursor, bar->id);
+        OGS_CHECKPOINT_PUT(&cursor, bar->suggested_packet_count);
+    }
+
+    num_of_far = ogs_list_count(&sess->pfcp.far_list);
+    OGS_CHECKPOINT_PUT(&cursor, num_of_far);
+    ogs_list_for_each(&sess->pfcp.far_list, far) {
+        OGS_CHECKPOINT_PUT(&cursor, far->id);
+        OGS_CHECKPOINT_PUT(&cursor, far->apply_action);
+        OGS_CHECKPOINT_PUT(&cursor, far->dst_if);
+        OGS_CHECKPOINT_PUT(&cursor, far->outer_header_creation);
+        OGS_CHECKPOINT_PUT(&cursor, far->outer_header_creation_len);
+    }
+
+    num_of_urr = ogs_list_count(&sess->pfcp.urr_list);
+    OGS_CHECKPOINT_PUT(&cursor, num_of_urr);
+    ogs_list_for_each(&sess->pfcp.urr_list, urr)
+        OGS_CHECKPOINT_PUT(&cursor, urr->id);
+
+    num_of_qer = ogs_list_count(&sess->pfcp.qer_list);
+    OGS_CHECKPOINT_PUT(&cursor, num_of_qer);
+    ogs_list_for_each(&sess->pfcp.qer_list, qer) {
+        OGS_CHECKPOINT_PUT(&cursor, qer->id);
+        OGS_CHECKPOINT_PUT(&cursor, qer->gate_status);
+        OGS_CHECKPOINT_PUT(&cursor, qer->mbr);
+        OGS_CHECKPOINT_PUT(&cursor, qer->gbr);
+        OGS_CHECKPOINT_PUT(&cursor, qer->qfi);
+    }
+
+    /* In the order of the precedence */
+    num_of_pdr = ogs_list_count(&sess->pfcp.pdr_list);
+    OGS_CHECKPOINT_PUT(&cursor, num_of_pdr);
+    ogs_list_for_each(&sess->pfcp.pdr_list, pdr)
+        encode_pdr(&cursor, pdr);
+
+    if (cursor.overflow) {
+        ogs_error("[UP:0x%lx] Cannot checkpoint the session",
+                (long)sess->upf_n4_seid);
+        return 0;
+    }
+
+    return cursor.pos - (uint8_t *)buf;
+}
+
+static int decode_ue_ip(ogs_checkpoint_cursor_t *cursor,
+        int family, ogs_pfcp_ue_ip_t **ue_ip)
+{
+    int32_t index;
+    uint32_t addr[4];
+    char *dnn = NULL;
+
+    OGS_CHECKPOINT_GET(cursor, index);
+    if (cursor->overflow)
+        return OGS_ERROR;
+    if (index < 0)
+        return OGS_OK;
+
+    dnn = ogs_checkpoint_get_string(cursor);
+    OGS_CHECKPOINT_GET(cursor, addr);
+    if (!cursor->overflow)
+        *ue_ip = ogs_pfcp_ue_ip_restore(
+                family, dnn ? dnn : "", (uint8_t *)addr, index);
+    if (dnn)
+        ogs_free(dnn);
+
+    return *ue_ip ? OGS_OK : OGS_ERROR;
+}
+
+static ogs_pfcp_pdr_t *decode_pdr(
+        ogs_checkpoint_cursor_t *cursor, upf_sess_t *sess, uint8_t *hash_type)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_pfcp_rule_t *rule = NULL;
+    ogs_pfcp_far_id_t far_id;
+    ogs_pfcp_urr_id_t urr_id;
+    ogs_pfcp_qer_id_t qer_id;
+    uint32_t index;
+    uint8_t num_of_rule;
+    int i;
+
+    OGS_CHECKPOINT_GET(cursor, index);
+    if (cursor->overflow)
+        return NULL;
+
+    pdr = ogs_pfcp_pdr_restore(&sess->pfcp, index);
+    if (!pdr)
+        return NULL;
+
+    OGS_CHECKPOINT_GET(cursor, pdr->id);
+    OGS_CHECKPOINT_GET(cursor, pdr->precedence);
+    OGS_CHECKPOINT_GET(cursor, pdr->src_if);
+    pdr->dnn = ogs_checkpoint_get_string(cursor);
+    OGS_CHECKPOINT_GET(cursor, pdr->ue_ip_addr);
+    OGS_CHECKPOINT_GET(cursor, pdr->ue_ip_addr_len);
+    OGS_CHECKPOINT_GET(cursor, pdr->ue_ipv6_prefixlen);
+    OGS_CHECKPOINT_GET(cursor, pdr->ipv4_framed_route);
+    OGS_CHECKPOINT_GET(cursor, pdr->ipv6_framed_route);
+    OGS_CHECKPOINT_GET(cursor, pdr->f_teid);
+    OGS_CHECKPOINT_GET(cursor, pdr->f_teid_len);
+    OGS_CHECKPOINT_GET(cursor, pdr->chid);
+    OGS_CHECKPOINT_GET(cursor, pdr->choose_id);
+    OGS_CHECKPOINT_GET(cursor, pdr->outer_header_removal);
+    OGS_CHECKPOINT_GET(cursor, pdr->outer_header_removal_len);
+    OGS_CHECKPOINT_GET(cursor, pdr->qfi);
+    OGS_CHECKPOINT_GET(cursor, far_id);
+    OGS_CHECKPOINT_GET(cursor, urr_id);
+    OGS_CHECKPOINT_GET(cursor, qer_id);
+    OGS_CHECKPOINT_GET(cursor, *hash_type);
+
+    OGS_CHECKPOINT_GET(cursor, num_of_rule);
+    if (cursor->overflow || num_of_rule > OGS_MAX_NUM_OF_RULE)
+        return NULL;
+
+    for (i = 0; i < num_of_rule; i++) {
+        rule = ogs_pfcp_rule_add(pdr);
+        ogs_assert(rule);
+
+        OGS_CHECKPOINT_GET(cursor, rule->flags);
+        OGS_CHECKPOINT_GET(cursor, rule->ipfw);
+        OGS_CHECKPOINT_GET(cursor, rule->sdf_filter_id);
+    }
+
+    if (far_id) {
+        pdr->far = ogs_pfcp_far_find(&sess->pfcp, far_id);
+        if (!pdr->far) return NULL;
+    }
+    if (urr_id) {
+        pdr->urr = ogs_pfcp_urr_find(&sess->pfcp, urr_id);
+        if (!pdr->urr) return NULL;
+    }
+    if (qer_id) {
+        pdr->qer = ogs_pfcp_qer_find(&sess->pfcp, qer_id);
+        if (!pdr->qer) return NULL;
+    }
+
+    return pdr;
+}
+
+/*
+ * A session that cannot be decoded has no PFCP node,
+ * and is removed by upf_checkpoint_open() once the pools are restored.
+ * The hashes are only set for a session that is decoded.
+ */
+static int decode_sess(int index, const void *buf, size_t length, void *data)
+{
+    upf_sess_t *sess = NULL;
+    ogs_pfcp_node_t *node = NULL;
+    ogs_pfcp_pdr_t *pdr[OGS_MAX_NUM_OF_PDR];
+    ogs_pfcp_far_t *far = NULL;
+    ogs_pfcp_urr_t *urr = NULL;
+    ogs_pfcp_qer_t *qer = NULL;
+    ogs_pfcp_bar_t *bar = NULL;
+    ogs_checkpoint_cursor_t cursor;
+    ogs_sockaddr_t addr;
+    uint64_t smf_n4_seid;
+    uint8_t num_of_far, num_of_urr, num_of_qer, num_of_pdr, has_bar;
+    uint8_t hash_type[OGS_MAX_NUM_OF_PDR];
+    int i;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, length);
+
+    memset(&addr, 0, sizeof(addr));
+    OGS_CHECKPOINT_GET(&cursor, addr.sin6);
+    OGS_CHECKPOINT_GET(&cursor, smf_n4_seid);
+    if (cursor.overflow)
+        return OGS_ERROR;
+
+    /* upf_sess_remove() would take the SEID out of the hash */
+    if (upf_sess_find_by_cp_seid(smf_n4_seid)) {
+        ogs_warn("[CP:0x%lx] Duplicated checkpoint", (long)smf_n4_seid);
+        return OGS_ERROR;
+    }
+
+    sess = upf_sess_restore(index, smf_n4_seid);
+    if (!sess)
+        return OGS_ERROR;
+
+    if (decode_ue_ip(&cursor, AF_INET, &sess->ipv4) != OGS_OK ||
+        decode_ue_ip(&cursor, AF_INET6, &sess->ipv6) != OGS_OK)
+        return OGS_ERROR;
+
+    OGS_CHECKPOINT_GET(&cursor, has_bar);
+    if (has_bar) {
+        bar = ogs_pfcp_bar_new(&sess->pfcp);
+        ogs_assert(bar);
+        OGS_CHECKPOINT_GET(&cursor, bar->id);
+        OGS_CHECKPOINT_GET(&cursor, bar->suggested_packet_count);
+    }
+
+    OGS_CHECKPOINT_GET(&cursor, num_of_far);
+    if (cursor.overflow || num_of_far > OGS_MAX_NUM_OF_FAR)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_far; i++) {
+        far = ogs_pfcp_far_add(&sess->pfcp);
+        ogs_assert(far);
+        OGS_CHECKPOINT_GET(&cursor, far->id);
+        OGS_CHECKPOINT_GET(&cursor, far->apply_action);
+        OGS_CHECKPOINT_GET(&cursor, far->dst_if);
+        OGS_CHECKPOINT_GET(&cursor, far->outer_header_creation);
+        OGS_CHECKPOINT_GET(&cursor, far->outer_header_creation_len);
+    }
+
+    OGS_CHECKPOINT_GET(&cursor, num_of_urr);
+    if (cursor.overflow || num_of_urr > OGS_MAX_NUM_OF_URR)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_urr; i++) {
+        urr = ogs_pfcp_urr_add(&sess->pfcp);
+        ogs_assert(urr);
+        OGS_CHECKPOINT_GET(&cursor, urr->id);
+    }
+
+    OGS_CHECKPOINT_GET(&cursor, num_of_qer);
+    if (cursor.overflow || num_of_qer > OGS_MAX_NUM_OF_QER)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_qer; i++) {
+        qer = ogs_pfcp_qer_add(&sess->pfcp);
+        ogs_assert(qer);
+        OGS_CHECKPOINT_GET(&cursor, qer->id);
+        OGS_CHECKPOINT_GET(&cursor, qer->gate_status);
+        OGS_CHECKPOINT_GET(&cursor, qer->mbr);
+        OGS_CHECKPOINT_GET(&cursor, qer->gbr);
+        OGS_CHECKPOINT_GET(&cursor, qer->qfi);
+    }
+
+    OGS_CHECKPOINT_GET(&cursor, num_of_pdr);
+    if (cursor.overflow || num_of_pdr == 0 || num_of_pdr > OGS_MAX_NUM_OF_PDR)
+        return OGS_ERROR;
+    for (i = 0; i < num_of_pdr; i++) {
+        pdr[i] = decode_pdr(&cursor, sess, &hash_type[i]);
+        if (!pdr[i])
+            return OGS_ERROR;
+    }
+    if (cursor.overflow)
+        return OGS_ERROR;
+
+    node = upf_pfcp_node_restore(&addr);
+    if (!node) {
+        ogs_warn("[UP:0x%lx] No PFCP socket for the SMF",
+                (long)sess->upf_n4_seid);
+        return OGS_ERROR;
+    }
+
+    if (sess->ipv4)
+        ogs_ihash_set(upf_self()->ipv4_hash, sess->ipv4->addr, sess);
+    if (sess->ipv6)
+        ogs_ihash_set(upf_self()->ipv6_hash, sess->ipv6->addr, sess);
+
+    ogs_list_for_each(&sess->pfcp.far_list, far) {
+        ogs_pfcp_setup_far_gtpu_node(far);
+        if (far->gnode)
+            ogs_pfcp_far_f_teid_hash_set(far);
+    }
+
+    for (i = 0; i < num_of_pdr; i++) {
+        if (hash_type[i] != OGS_PFCP_OBJ_BASE)
+            ogs_pfcp_object_teid_hash_set(hash_type[i], pdr[i]);
+    }
+
+    upf_sess_set_route(sess);
+    upf_sess_update_fwd(sess);
+    upf_gtp_offload_update(sess);
+
+    OGS_SETUP_PFCP_NODE(sess, node);
+
+    return OGS_OK;
+}
+
+int upf_checkpoint_open(void)
+{
+    upf_sess_t *sess = NULL, *next = NULL;
+    uint32_t *pfcp_started = NULL;
+    int count;
+
+    if (!upf_self()->checkpoint.path)
+        return OGS_OK;
+
+    /* The Recovery Time Stamp is kept in the user area */
+    checkpoint = ogs_checkpoint_open(upf_self()->checkpoint.path,
+            "upf", UPF_CHECKPOINT_VERSION, sizeof(*pfcp_started),
+            UPF_CHECKPOINT_SLOT_SIZE, ogs_app()->pool.sess);
+    if (!checkpoint)
+        return OGS_ERROR;
+    ogs_checkpoint_set_sync(checkpoint, upf_self()->checkpoint.sync);
+
+    pfcp_started = ogs_checkpoint_user(checkpoint);
+
+    if (ogs_checkpoint_restored(checkpoint) == false || *pfcp_started == 0) {
+        *pfcp_started = ogs_pfcp_self()->pfcp_started;
+        return OGS_OK;
+    }
+
+    count = ogs_checkpoint_restore(checkpoint, decode_sess, NULL);
+    upf_sess_restore_done();
+    ogs_pfcp_restore_done();
+
+    ogs_list_for_each_safe(&upf_self()->sess_list, next, sess) {
+        if (!sess->pfcp_node)
+            upf_sess_remove(sess);
+    }
+
+    /*
+     * The SMF takes a new Recovery Time Stamp in the PFCP Association
+     * as a restart of the UPF which has lost its sessions. The sessions
+     * are still there, so the UPF keeps the Recovery Time Stamp.
+     */
+    if (count)
+        ogs_pfcp_self()->pfcp_started = *pfcp_started;
+    else
+        *pfcp_started = ogs_pfcp_self()->pfcp_started;
+
+    ogs_info("%d sessions restored from '%s'",
+            count, upf_self()->checkpoint.path);
+
+    return OGS_OK;
+}
+
+void upf_checkpoint_close(void)
+{
+    if (!checkpoint)
+        return;
+
+    upf_checkpoint_flush();
+
+    ogs_checkpoint_close(checkpoint);
+    checkpoint = NULL;
+}
+
+void upf_checkpoint_mark(upf_sess_t *sess)
+{
+    ogs_assert(sess);
+
+    if (checkpoint)
+        ogs_checkpoint_mark(checkpoint, sess->index);
+}
+
+void upf_checkpoint_flush(void)
+{
+    if (checkpoint)
+        ogs_checkpoint_flush(checkpoint, encode_sess, NULL);
+}
@@ -17,7 +17,11 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <sys/resource.h>
+
 #include "context.h"
+#include "gtp-offload.h"
+#include "checkpoint.h"
 
 static upf_context_t self;
 
@@ -27,6 +31,13 @@ static OGS_POOL(upf_sess_pool, upf_sess_t);
 
 static int context_initialized = 0;
 
+static void route_remove_all(upf_sess_t *sess);
+
+static int64_t load_metric(void *data)
+{
+    return ogs_pfcp_self()->load.metric;
+}
+
 void upf_context_init(void)
 {
     ogs_assert(context_initialized == 0);
@@ -43,10 +54,17 @@ void upf_context_init(void)
 
     ogs_list_init(&self.sess_list);
     ogs_pool_init(&upf_sess_pool, ogs_app()->pool.sess);
+    ogs_pool_set_trim(&upf_sess_pool, ogs_app()->pool.trim);
+
+    self.sess_hash = ogs_ihash_make(sizeof(uint64_t));
+    self.ipv4_hash = ogs_ihash_make(OGS_IPV4_LEN);
+    self.ipv6_hash = ogs_ihash_make(OGS_IPV6_DEFAULT_PREFIX_LEN >> 3);
+    self.ipv4_route = ogs_lpm_make(OGS_IPV4_LEN);
+    self.ipv6_route = ogs_lpm_make(OGS_IPV6_LEN);
 
-    self.sess_hash = ogs_hash_make();
-    self.ipv4_hash = ogs_hash_make();
-    self.ipv6_hash = ogs_hash_make();
+    self.metrics.sess = ogs_metrics_add_pool(&upf_sess_pool, "upf_sess");
+    self.metrics.load = ogs_metrics_add_collector("upf_load_percent",
+            "Load Metric reported to the SMF", NULL, load_metric, NULL);
 
     context_initialized = 1;
 }
@@ -58,11 +76,18 @@ void upf_context_final(void)
     upf_sess_remove_all();
 
     ogs_assert(self.sess_hash);
-    ogs_hash_destroy(self.sess_hash);
+    ogs_ihash_destroy(self.sess_hash);
     ogs_assert(self.ipv4_hash);
-    ogs_hash_destroy(self.ipv4_hash);
+    ogs_ihash_destroy(self.ipv4_hash);
     ogs_assert(self.ipv6_hash);
-    ogs_hash_destroy(self.ipv6_hash);
+    ogs_ihash_destroy(self.ipv6_hash);
+    ogs_assert(self.ipv4_route);
+    ogs_lpm_destroy(self.ipv4_route);
+    ogs_assert(self.ipv6_route);
+    ogs_lpm_destroy(self.ipv6_route);
+
+    if (self.metrics.sess) ogs_metrics_remove(self.metrics.sess);
+    if (self.metrics.load) ogs_metrics_remove(self.metrics.load);
 
     ogs_pool_final(&upf_sess_pool);
 
@@ -116,10 +141,61 @@ int upf_context_parse_config(void)
                 ogs_assert(upf_key);
                 if (!strcmp(upf_key, "gtpu")) {
                     /* handle config in gtp library */
+                } else if (!strcmp(upf_key, "echo")) {
+                    /* handle config in gtp library */
                 } else if (!strcmp(upf_key, "pfcp")) {
                     /* handle config in pfcp library */
                 } else if (!strcmp(upf_key, "subnet")) {
                     /* handle config in pfcp library */
+                } else if (!strcmp(upf_key, "offload")) {
+                    ogs_yaml_iter_t offload_iter;
+                    ogs_yaml_iter_recurse(&upf_iter, &offload_iter);
+                    while (ogs_yaml_iter_next(&offload_iter)) {
+                        const char *offload_key =
+                            ogs_yaml_iter_key(&offload_iter);
+                        ogs_assert(offload_key);
+                        if (!strcmp(offload_key, "dev")) {
+                            self.offload_dev =
+                                ogs_yaml_iter_value(&offload_iter);
+                        } else
+                            ogs_warn("unknown key `%s`", offload_key);
+                    }
+                } else if (!strcmp(upf_key, "checkpoint")) {
+                    ogs_yaml_iter_t checkpoint_iter;
+                    ogs_yaml_iter_recurse(&upf_iter, &checkpoint_iter);
+
+                    while (ogs_yaml_iter_next(&checkpoint_iter)) {
+                        const char *checkpoint_key =
+                            ogs_yaml_iter_key(&checkpoint_iter);
+                        const char *v = ogs_yaml_iter_value(&checkpoint_iter);
+                        ogs_assert(checkpoint_key);
+                        if (!strcmp(checkpoint_key, "path")) {
+                            self.checkpoint.path = v;
+                        } else if (!strcmp(checkpoint_key, "sync")) {
+                            if (v) self.checkpoint.sync =
+                                ogs_time_from_msec(atoll(v));
+                        } else
+                            ogs_warn("unknown key `%s`", checkpoint_key);
+                    }
+                } else if (!strcmp(upf_key, "report")) {
+                    ogs_yaml_iter_t report_iter;
+                    ogs_yaml_iter_recurse(&upf_iter, &report_iter);
+
+                    while (ogs_yaml_iter_next(&report_iter)) {
+                        const char *report_key =
+                            ogs_yaml_iter_key(&report_iter);
+                        const char *v = ogs_yaml_iter_value(&report_iter);
+                        ogs_assert(report_key);
+                        if (!strcmp(report_key, "window")) {
+                            if (v) ogs_pfcp_self()->report.window =
+                                ogs_time_from_msec(atoll(v));
+                        } else if (!strcmp(report_key, "rate")) {
+                            if (v) ogs_pfcp_self()->report.rate = atoi(v);
+                        } else if (!strcmp(report_key, "burst")) {
+                            if (v) ogs_pfcp_self()->report.burst = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", report_key);
+                    }
                 } else
                     ogs_warn("unknown key `%s`", upf_key);
             }
@@ -132,14 +208,8 @@ int upf_context_parse_config(void)
     return OGS_OK;
 }
 
-upf_sess_t *upf_sess_add(ogs_pfcp_f_seid_t *cp_f_seid)
+static void upf_sess_init(upf_sess_t *sess, uint64_t smf_n4_seid)
 {
-    upf_sess_t *sess = NULL;
-
-    ogs_assert(cp_f_seid);
-
-    ogs_pool_alloc(&upf_sess_pool, &sess);
-    ogs_assert(sess);
     memset(sess, 0, sizeof *sess);
 
     ogs_pfcp_pool_init(&sess->pfcp);
@@ -148,11 +218,22 @@ upf_sess_t *upf_sess_add(ogs_pfcp_f_seid_t *cp_f_seid)
     ogs_assert(sess->index > 0 && sess->index <= ogs_app()->pool.sess);
 
     sess->upf_n4_seid = sess->index;
-    sess->smf_n4_seid = cp_f_seid->seid;
-    ogs_hash_set(self.sess_hash, &sess->smf_n4_seid,
-            sizeof(sess->smf_n4_seid), sess);
+    sess->smf_n4_seid = smf_n4_seid;
+    ogs_ihash_set(self.sess_hash, &sess->smf_n4_seid, sess);
 
     ogs_list_add(&self.sess_list, sess);
+}
+
+upf_sess_t *upf_sess_add(ogs_pfcp_f_seid_t *cp_f_seid)
+{
+    upf_sess_t *sess = NULL;
+
+    ogs_assert(cp_f_seid);
+
+    ogs_pool_alloc(&upf_sess_pool, &sess);
+    ogs_assert(sess);
+
+    upf_sess_init(sess, cp_f_seid->seid);
 
     ogs_info("[Added] Number of UPF-Sessions is now %d",
             ogs_list_count(&self.sess_list));
@@ -160,23 +241,63 @@ upf_sess_t *upf_sess_add(ogs_pfcp_f_seid_t *cp_f_seid)
     return sess;
 }
 
+/*
+ * Warm restart : the UPF SEID is the index of the session,
+ * so a restored session takes the index of the previous run.
+ * No session can be allocated or freed until upf_sess_restore_done().
+ */
+upf_sess_t *upf_sess_restore(uint32_t index, uint64_t smf_n4_seid)
+{
+    upf_sess_t *sess = NULL;
+
+    ogs_pool_restore(&upf_sess_pool, &sess, index);
+    if (!sess)
+        return NULL;
+
+    upf_sess_init(sess, smf_n4_seid);
+
+    return sess;
+}
+
+void upf_sess_restore_done(void)
+{
+    ogs_pool_restore_done(&upf_sess_pool);
+}
+
 int upf_sess_remove(upf_sess_t *sess)
 {
+    ogs_pfcp_xact_t *xact = NULL;
+
     ogs_assert(sess);
 
+    upf_checkpoint_mark(sess);
+
+    /*
+     * A Session Report Request may still be waiting for its response.
+     * Disown it so that its timeout does not touch the freed session.
+     */
+    if (sess->pfcp_node) {
+        ogs_list_for_each(&sess->pfcp_node->local_list, xact) {
+            if (xact->data == sess)
+                xact->data = NULL;
+        }
+    }
+
     ogs_list_remove(&self.sess_list, sess);
+
+    upf_gtp_offload_remove(sess);
     ogs_pfcp_sess_clear(&sess->pfcp);
 
-    ogs_hash_set(self.sess_hash, &sess->smf_n4_seid,
-            sizeof(sess->smf_n4_seid), NULL);
+    ogs_ihash_set(self.sess_hash, &sess->smf_n4_seid, NULL);
+
+    route_remove_all(sess);
 
     if (sess->ipv4) {
-        ogs_hash_set(self.ipv4_hash, sess->ipv4->addr, OGS_IPV4_LEN, NULL);
+        ogs_ihash_set(self.ipv4_hash, sess->ipv4->addr, NULL);
         ogs_pfcp_ue_ip_free(sess->ipv4);
     }
     if (sess->ipv6) {
-        ogs_hash_set(self.ipv6_hash,
-                sess->ipv6->addr, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3, NULL);
+        ogs_ihash_set(self.ipv6_hash, sess->ipv6->addr, NULL);
         ogs_pfcp_ue_ip_free(sess->ipv6);
     }
 
@@ -207,7 +328,7 @@ upf_sess_t *upf_sess_find(uint32_t index)
 
 upf_sess_t *upf_sess_find_by_cp_seid(uint64_t seid)
 {
-    return (upf_sess_t *)ogs_hash_get(self.sess_hash, &seid, sizeof(seid));
+    return (upf_sess_t *)ogs_ihash_get(self.sess_hash, &seid);
 }
 
 upf_sess_t *upf_sess_find_by_up_seid(uint64_t seid)
@@ -217,16 +338,27 @@ upf_sess_t *upf_sess_find_by_up_seid(uint64_t seid)
 
 upf_sess_t *upf_sess_find_by_ipv4(uint32_t addr)
 {
+    upf_sess_t *sess = NULL;
+
     ogs_assert(self.ipv4_hash);
-    return (upf_sess_t *)ogs_hash_get(self.ipv4_hash, &addr, OGS_IPV4_LEN);
+    sess = ogs_ihash_get(self.ipv4_hash, &addr);
+    if (!sess)
+        sess = ogs_lpm_lookup(self.ipv4_route, &addr);
+
+    return sess;
 }
 
 upf_sess_t *upf_sess_find_by_ipv6(uint32_t *addr6)
 {
+    upf_sess_t *sess = NULL;
+
     ogs_assert(self.ipv6_hash);
     ogs_assert(addr6);
-    return (upf_sess_t *)ogs_hash_get(
-            self.ipv6_hash, addr6, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3);
+    sess = ogs_ihash_get(self.ipv6_hash, addr6);
+    if (!sess)
+        sess = ogs_lpm_lookup(self.ipv6_route, addr6);
+
+    return sess;
 }
 
 upf_sess_t *upf_sess_add_by_message(ogs_pfcp_message_t *message)
@@ -269,13 +401,11 @@ void upf_sess_set_ue_ip(upf_sess_t *sess,
     ogs_assert(ue_ip);
 
     if (sess->ipv4) {
-        ogs_hash_set(self.ipv4_hash,
-                sess->ipv4->addr, OGS_IPV4_LEN, NULL);
+        ogs_ihash_set(self.ipv4_hash, sess->ipv4->addr, NULL);
         ogs_pfcp_ue_ip_free(sess->ipv4);
     }
     if (sess->ipv6) {
-        ogs_hash_set(self.ipv6_hash,
-                sess->ipv6->addr, OGS_IPV6_DEFAULT_PREFIX_LEN >> 3, NULL);
+        ogs_ihash_set(self.ipv6_hash, sess->ipv6->addr, NULL);
         ogs_pfcp_ue_ip_free(sess->ipv6);
     }
 
@@ -285,7 +415,7 @@ void upf_sess_set_ue_ip(upf_sess_t *sess,
             sess->ipv4 = ogs_pfcp_ue_ip_alloc(
                     AF_INET, pdr->dnn, (uint8_t *)&(ue_ip->addr));
             ogs_assert(sess->ipv4);
-            ogs_hash_set(self.ipv4_hash, sess->ipv4->addr, OGS_IPV4_LEN, sess);
+            ogs_ihash_set(self.ipv4_hash, sess->ipv4->addr, sess);
         } else {
             ogs_warn("Cannot support PDN-Type[%d], [IPv4:%d IPv6:%d DNN:%s]",
                 session_type, ue_ip->ipv4, ue_ip->ipv6,
@@ -295,8 +425,7 @@ void upf_sess_set_ue_ip(upf_sess_t *sess,
         if (ue_ip->ipv6 || pdr->dnn) {
             sess->ipv6 = ogs_pfcp_ue_ip_alloc(AF_INET6, pdr->dnn, ue_ip->addr6);
             ogs_assert(sess->ipv6);
-            ogs_hash_set(self.ipv6_hash, sess->ipv6->addr,
-                    OGS_IPV6_DEFAULT_PREFIX_LEN >> 3, sess);
+            ogs_ihash_set(self.ipv6_hash, sess->ipv6->addr, sess);
         } else {
             ogs_warn("Cannot support PDN-Type[%d], [IPv4:%d IPv6:%d DNN:%s]",
                 session_type, ue_ip->ipv4, ue_ip->ipv6,
@@ -307,7 +436,7 @@ void upf_sess_set_ue_ip(upf_sess_t *sess,
             sess->ipv4 = ogs_pfcp_ue_ip_alloc(
                     AF_INET, pdr->dnn, (uint8_t *)&(ue_ip->both.addr));
             ogs_assert(sess->ipv4);
-            ogs_hash_set(self.ipv4_hash, sess->ipv4->addr, OGS_IPV4_LEN, sess);
+            ogs_ihash_set(self.ipv4_hash, sess->ipv4->addr, sess);
         } else {
             ogs_warn("Cannot support PDN-Type[%d], [IPv4:%d IPv6:%d DNN:%s]",
                 session_type, ue_ip->ipv4, ue_ip->ipv6,
@@ -318,8 +447,7 @@ void upf_sess_set_ue_ip(upf_sess_t *sess,
             sess->ipv6 = ogs_pfcp_ue_ip_alloc(
                     AF_INET6, pdr->dnn, ue_ip->both.addr6);
             ogs_assert(sess->ipv6);
-            ogs_hash_set(self.ipv6_hash, sess->ipv6->addr,
-                    OGS_IPV6_DEFAULT_PREFIX_LEN >> 3, sess);
+            ogs_ihash_set(self.ipv6_hash, sess->ipv6->addr, sess);
         } else {
             ogs_warn("Cannot support PDN-Type[%d], [IPv4:%d IPv6:%d DNN:%s]",
                 session_type, ue_ip->ipv4, ue_ip->ipv6,
@@ -338,3 +466,161 @@ void upf_sess_set_ue_ip(upf_sess_t *sess,
         sess->ipv4 ? OGS_INET_NTOP(&sess->ipv4->addr, buf1) : "",
         sess->ipv6 ? OGS_INET6_NTOP(&sess->ipv6->addr, buf2) : "");
 }
+
+static ogs_lpm_t *route_table(int family)
+{
+    return family == AF_INET ? self.ipv4_route : self.ipv6_route;
+}
+
+static uint8_t subnet_prefixlen(ogs_ipsubnet_t *subnet)
+{
+    int i, n = subnet->family == AF_INET ? 1 : 4;
+    uint32_t mask;
+    uint8_t len = 0;
+
+    for (i = 0; i < n; i++)
+        for (mask = subnet->mask[i]; mask; mask &= mask - 1)
+            len++;
+
+    return len;
+}
+
+static void route_add(upf_sess_t *sess,
+        int family, uint32_t *addr, uint8_t prefixlen)
+{
+    upf_sess_route_t *route = NULL;
+    int i, len = family == AF_INET ? OGS_IPV4_LEN : OGS_IPV6_LEN;
+
+    for (i = 0; i < sess->num_of_route; i++) {
+        route = &sess->route[i];
+        if (route->family == family && route->prefixlen == prefixlen &&
+            memcmp(route->addr, addr, len) == 0)
+            return;
+    }
+
+    if (sess->num_of_route >= UPF_MAX_NUM_OF_ROUTE) {
+        ogs_warn("Too many routes [%d]", sess->num_of_route);
+        return;
+    }
+
+    route = &sess->route[sess->num_of_route++];
+    memset(route, 0, sizeof(*route));
+    route->family = family;
+    memcpy(route->addr, addr, len);
+    route->prefixlen = prefixlen;
+
+    ogs_lpm_set(route_table(family), route->addr, prefixlen, sess);
+}
+
+static void route_remove_all(upf_sess_t *sess)
+{
+    upf_sess_route_t *route = NULL;
+    ogs_lpm_t *table = NULL;
+    int i;
+
+    for (i = 0; i < sess->num_of_route; i++) {
+        route = &sess->route[i];
+        table = route_table(route->family);
+
+        /* Another session may have taken over the route */
+        if (ogs_lpm_get(table, route->addr, route->prefixlen) == sess)
+            ogs_lpm_set(table, route->addr, route->prefixlen, NULL);
+    }
+
+    sess->num_of_route = 0;
+}
+
+void upf_sess_set_route(upf_sess_t *sess)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_ipsubnet_t *subnet = NULL;
+
+    ogs_assert(sess);
+
+    route_remove_all(sess);
+
+    ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
+        subnet = &pdr->ipv4_framed_route;
+        if (subnet->family)
+            route_add(sess, subnet->family,
+                    subnet->sub, subnet_prefixlen(subnet));
+
+        subnet = &pdr->ipv6_framed_route;
+        if (subnet->family)
+            route_add(sess, subnet->family,
+                    subnet->sub, subnet_prefixlen(subnet));
+
+        /* Delegated prefix other than the default /64 */
+        if (pdr->ue_ipv6_prefixlen && sess->ipv6 &&
+            pdr->ue_ipv6_prefixlen != OGS_IPV6_DEFAULT_PREFIX_LEN)
+            route_add(sess, AF_INET6,
+                    sess->ipv6->addr, pdr->ue_ipv6_prefixlen);
+    }
+}
+
+/*
+ * The forwarding entries of the PDRs are copies, so they are rebuilt
+ * once the session is established, modified or restored.
+ * The uplink to the Core goes to the TUN device of the UE subnet.
+ */
+void upf_sess_update_fwd(upf_sess_t *sess)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_socket_t fd4 = INVALID_SOCKET, fd6 = INVALID_SOCKET;
+
+    ogs_assert(sess);
+
+    if (sess->ipv4 && sess->ipv4->subnet) {
+        ogs_assert(sess->ipv4->subnet->dev);
+        fd4 = sess->ipv4->subnet->dev->fd;
+    }
+    if (sess->ipv6 && sess->ipv6->subnet) {
+        ogs_assert(sess->ipv6->subnet->dev);
+        fd6 = sess->ipv6->subnet->dev->fd;
+    }
+
+    ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
+        pdr->fwd->tun.fd4 = fd4;
+        pdr->fwd->tun.fd6 = fd6;
+        ogs_pfcp_pdr_update_fwd(pdr);
+    }
+}
+
+/*
+ * The Load Metric reported to the SMF is the higher of the session
+ * occupancy and the CPU usage of the UPF. The packet forwarding runs
+ * in the same process, so the CPU usage tracks the data plane load.
+ * The CPU usage is sampled at most once per second.
+ */
+#define LOAD_SAMPLE_INTERVAL ogs_time_from_sec(1)
+
+void upf_update_load(void)
+{
+    ogs_time_t now = ogs_get_monotonic_time();
+    uint8_t sess_load;
+
+    if (now - self.load.sampled >= LOAD_SAMPLE_INTERVAL) {
+        struct rusage usage;
+        ogs_time_t cpu_time;
+
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            cpu_time =
+                ogs_time_from_sec(usage.ru_utime.tv_sec +
+                        usage.ru_stime.tv_sec) +
+                usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+
+            if (self.load.sampled)
+                self.load.cpu = ogs_min(OGS_PFCP_METRIC_MAX,
+                        (cpu_time - self.load.cpu_time) *
+                            OGS_PFCP_METRIC_MAX / (now - self.load.sampled));
+
+            self.load.cpu_time = cpu_time;
+            self.load.sampled = now;
+        }
+    }
+
+    sess_load = ogs_pool_used(&upf_sess_pool) *
+        OGS_PFCP_METRIC_MAX / upf_sess_pool.size;
+
+    ogs_pfcp_up_update_load(ogs_max(sess_load, self.load.cpu));
+}
@@ -46,13 +46,48 @@ extern int __upf_log_domain;
 #define OGS_LOG_DOMAIN __upf_log_domain
 
 typedef struct upf_context_s {
-    ogs_hash_t      *sess_hash;     /* hash table (F-SEID) */
-    ogs_hash_t      *ipv4_hash;     /* hash table (IPv4 Address) */
-    ogs_hash_t      *ipv6_hash;     /* hash table (IPv6 Address) */
+    ogs_ihash_t     *sess_hash;     /* hash table (F-SEID) */
+    ogs_ihash_t     *ipv4_hash;     /* hash table (IPv4 Address) */
+    ogs_ihash_t     *ipv6_hash;     /* hash table (IPv6 Address) */
+    ogs_lpm_t       *ipv4_route;    /* LPM table (Framed Route) */
+    ogs_lpm_t       *ipv6_route;    /* LPM table (Framed Route, IPv6 Prefix) */
 
     ogs_list_t      sess_list;
+
+    const char      *offload_dev;   /* Kernel GTP device for offload */
+
+    /*
+     * Warm restart
+     *
+     * The sessions are checkpointed in 'path' after each
+     * iteration of the event loop and restored at the next start.
+     * The file is msync()-ed every 'sync', if set.
+     */
+    struct {
+        const char *path;
+        ogs_time_t sync;
+    } checkpoint;
+
+    struct {
+        ogs_time_t  sampled;        /* Time of the last CPU sample */
+        ogs_time_t  cpu_time;       /* CPU time used until the sample */
+        uint8_t     cpu;            /* CPU usage in percent */
+    } load;
+
+    struct {
+        ogs_metrics_t *sess;
+        ogs_metrics_t *load;
+    } metrics;
 } upf_context_t;
 
+#define UPF_MAX_NUM_OF_ROUTE 8
+
+typedef struct upf_sess_route_s {
+    int             family;
+    uint32_t        addr[4];
+    uint8_t         prefixlen;
+} upf_sess_route_t;
+
 #define UPF_SESS(pfcp_sess) ogs_container_of(pfcp_sess, upf_sess_t, pfcp)
 typedef struct upf_sess_s {
     ogs_lnode_t     lnode;
@@ -67,6 +102,19 @@ typedef struct upf_sess_s {
     ogs_pfcp_ue_ip_t *ipv4;
     ogs_pfcp_ue_ip_t *ipv6;
 
+    /* Framed Routes and Delegated IPv6 Prefix in the LPM tables */
+    upf_sess_route_t route[UPF_MAX_NUM_OF_ROUTE];
+    int             num_of_route;
+
+    /* PDP context in the kernel GTP device */
+    struct {
+        bool        active;
+        uint32_t    i_teid;
+        uint32_t    o_teid;
+        uint32_t    peer;               /* Network byte order */
+        uint32_t    ue;                 /* Network byte order */
+    } offload;
+
     char            *gx_sid;            /* Gx Session ID */
     ogs_pfcp_node_t *pfcp_node;
 } upf_sess_t;
@@ -80,6 +128,8 @@ int upf_context_parse_config(void);
 upf_sess_t *upf_sess_add_by_message(ogs_pfcp_message_t *message);
 
 upf_sess_t *upf_sess_add(ogs_pfcp_f_seid_t *f_seid);
+upf_sess_t *upf_sess_restore(uint32_t index, uint64_t smf_n4_seid);
+void upf_sess_restore_done(void);
 int upf_sess_remove(upf_sess_t *sess);
 void upf_sess_remove_all(void);
 upf_sess_t *upf_sess_find(uint32_t index);
@@ -90,6 +140,10 @@ upf_sess_t *upf_sess_find_by_ipv6(uint32_t *addr6);
 
 void upf_sess_set_ue_ip(upf_sess_t *sess,
         uint8_t session_type, ogs_pfcp_pdr_t *pdr);
+void upf_sess_set_route(upf_sess_t *sess);
+void upf_sess_update_fwd(upf_sess_t *sess);
+
+void upf_update_load(void);
 
 #ifdef __cplusplus
 }
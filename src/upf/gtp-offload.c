@@ -0,0 +1,503 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Kernel GTP offload
+ *
+ * The Linux GTP module (drivers/net/gtp.c) is given the IPv4 GTP-U socket
+ * of the UPF. A T-PDU whose TEID matches a PDP context is decapsulated in
+ * the kernel and routed to N6. A downlink packet routed to the device is
+ * encapsulated with the PDP context of its destination address. Anything
+ * else, including Echo and unknown TEIDs, is still delivered to the
+ * socket, so the offloaded and the userspace sessions share the port.
+ *
+ * A session is offloaded only while its rules are a plain tunnel: one
+ * uplink PDR from ACCESS to CORE and one downlink PDR from CORE to ACCESS
+ * with GTP-U/IPv4 outer header creation, both forwarding only, without
+ * SDF filter, QER or URR, and an IPv4-only UE. The PDP context and a /32
+ * route to the UE on the device are removed as soon as a modification
+ * breaks one of these conditions (e.g. buffering while the UE is idle)
+ * or the session is deleted.
+ *
+ * The device is configured with rtnetlink and the PDP contexts with the
+ * "gtp" generic netlink family.
+ */
+
+#include "gtp-offload.h"
+
+#if HAVE_LINUX_GTP_H
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/genetlink.h>
+#include <linux/if_link.h>
+#include <linux/gtp.h>
+
+#define NL_BUFSIZE 1024
+
+static struct {
+    ogs_socket_t rtnl;
+    ogs_socket_t genl;
+    uint16_t family;            /* "gtp" generic netlink family */
+    unsigned int ifindex;
+    uint32_t seq;
+} nl;
+
+static struct nlmsghdr *nl_msg_init(void *buf, uint16_t type, uint16_t flags)
+{
+    struct nlmsghdr *h = buf;
+
+    memset(buf, 0, NL_BUFSIZE);
+    h->nlmsg_len = NLMSG_LENGTH(0);
+    h->nlmsg_type = type;
+    h->nlmsg_flags = NLM_F_REQUEST | flags;
+
+    return h;
+}
+
+static void *nl_put(struct nlmsghdr *h, size_t len)
+{
+    void *data = (char *)h + NLMSG_ALIGN(h->nlmsg_len);
+
+    ogs_assert(NLMSG_ALIGN(h->nlmsg_len) + NLMSG_ALIGN(len) <= NL_BUFSIZE);
+    h->nlmsg_len = NLMSG_ALIGN(h->nlmsg_len) + NLMSG_ALIGN(len);
+
+    return data;
+}
+
+static struct nlattr *nl_attr_put(struct nlmsghdr *h,
+        uint16_t type, const void *data, size_t len)
+{
+    struct nlattr *nla = nl_put(h, NLA_HDRLEN + len);
+
+    nla->nla_type = type;
+    nla->nla_len = NLA_HDRLEN + len;
+    if (len)
+        memcpy((char *)nla + NLA_HDRLEN, data, len);
+
+    return nla;
+}
+
+static void nl_attr_put_u32(struct nlmsghdr *h, uint16_t type, uint32_t v)
+{
+    nl_attr_put(h, type, &v, sizeof(v));
+}
+
+static void nl_attr_nest_end(struct nlmsghdr *h, struct nlattr *nest)
+{
+    nest->nla_len = (char *)h + h->nlmsg_len - (char *)nest;
+}
+
+/*
+ * Send a request and wait for its acknowledgement, or for its answer if
+ * reply is given. Returns OGS_ERROR with errno set on a netlink error.
+ */
+static int nl_talk(ogs_socket_t fd, struct nlmsghdr *h, void *reply)
+{
+    char buf[NL_BUFSIZE];
+    struct nlmsghdr *r = NULL;
+    struct sockaddr_nl sa;
+    ssize_t size;
+
+    memset(&sa, 0, sizeof sa);
+    sa.nl_family = AF_NETLINK;
+
+    h->nlmsg_seq = ++nl.seq;
+    if (!reply)
+        h->nlmsg_flags |= NLM_F_ACK;
+
+    if (sendto(fd, h, h->nlmsg_len, 0,
+                (struct sockaddr *)&sa, sizeof sa) < 0)
+        return OGS_ERROR;
+
+    for ( ;; ) {
+        size = recv(fd, buf, sizeof buf, 0);
+        if (size < 0)
+            return OGS_ERROR;
+
+        for (r = (struct nlmsghdr *)buf; NLMSG_OK(r, size);
+                r = NLMSG_NEXT(r, size)) {
+            if (r->nlmsg_seq != h->nlmsg_seq)
+                continue;
+
+            if (r->nlmsg_type == NLMSG_ERROR) {
+                struct nlmsgerr *err = NLMSG_DATA(r);
+                if (err->error == 0)
+                    return OGS_OK;
+
+                errno = -err->error;
+                return OGS_ERROR;
+            }
+
+            if (reply) {
+                memcpy(reply, r, ogs_min(r->nlmsg_len, NL_BUFSIZE));
+                return OGS_OK;
+            }
+        }
+    }
+}
+
+static ogs_socket_t nl_open(int protocol)
+{
+    ogs_socket_t fd;
+    struct sockaddr_nl sa;
+
+    fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, protocol);
+    if (fd == INVALID_SOCKET)
+        return INVALID_SOCKET;
+
+    memset(&sa, 0, sizeof sa);
+    sa.nl_family = AF_NETLINK;
+    if (bind(fd, (struct sockaddr *)&sa, sizeof sa) < 0) {
+        ogs_closesocket(fd);
+        return INVALID_SOCKET;
+    }
+
+    return fd;
+}
+
+static int link_delete(const char *dev)
+{
+    char buf[NL_BUFSIZE];
+    struct nlmsghdr *h = NULL;
+    struct ifinfomsg *ifi = NULL;
+
+    h = nl_msg_init(buf, RTM_DELLINK, 0);
+    ifi = nl_put(h, sizeof *ifi);
+    ifi->ifi_family = AF_UNSPEC;
+    nl_attr_put(h, IFLA_IFNAME, dev, strlen(dev) + 1);
+
+    return nl_talk(nl.rtnl, h, NULL);
+}
+
+static int link_create(const char *dev, ogs_socket_t fd1)
+{
+    char buf[NL_BUFSIZE];
+    struct nlmsghdr *h = NULL;
+    struct ifinfomsg *ifi = NULL;
+    struct nlattr *linkinfo = NULL, *data = NULL;
+
+    h = nl_msg_init(buf, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL);
+    ifi = nl_put(h, sizeof *ifi);
+    ifi->ifi_family = AF_UNSPEC;
+    ifi->ifi_flags = IFF_UP;
+    ifi->ifi_change = IFF_UP;
+
+    nl_attr_put(h, IFLA_IFNAME, dev, strlen(dev) + 1);
+    linkinfo = nl_attr_put(h, IFLA_LINKINFO, NULL, 0);
+    nl_attr_put(h, IFLA_INFO_KIND, "gtp", strlen("gtp"));
+    data = nl_attr_put(h, IFLA_INFO_DATA, NULL, 0);
+    nl_attr_put_u32(h, IFLA_GTP_FD1, fd1);
+    nl_attr_nest_end(h, data);
+    nl_attr_nest_end(h, linkinfo);
+
+    return nl_talk(nl.rtnl, h, NULL);
+}
+
+static int family_resolve(void)
+{
+    char buf[NL_BUFSIZE], reply[NL_BUFSIZE];
+    struct nlmsghdr *h = NULL;
+    struct genlmsghdr *g = NULL;
+    struct nlattr *nla = NULL;
+    int len;
+
+    h = nl_msg_init(buf, GENL_ID_CTRL, 0);
+    g = nl_put(h, GENL_HDRLEN);
+    g->cmd = CTRL_CMD_GETFAMILY;
+    g->version = 1;
+    nl_attr_put(h, CTRL_ATTR_FAMILY_NAME, "gtp", strlen("gtp") + 1);
+
+    if (nl_talk(nl.genl, h, reply) != OGS_OK)
+        return OGS_ERROR;
+
+    h = (struct nlmsghdr *)reply;
+    len = h->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN);
+    nla = (struct nlattr *)((char *)NLMSG_DATA(h) + GENL_HDRLEN);
+    while (len >= NLA_HDRLEN && nla->nla_len >= NLA_HDRLEN &&
+            nla->nla_len <= len) {
+        if ((nla->nla_type & NLA_TYPE_MASK) == CTRL_ATTR_FAMILY_ID) {
+            memcpy(&nl.family, (char *)nla + NLA_HDRLEN, sizeof nl.family);
+            return OGS_OK;
+        }
+
+        len -= NLA_ALIGN(nla->nla_len);
+        nla = (struct nlattr *)((char *)nla + NLA_ALIGN(nla->nla_len));
+    }
+
+    errno = ENOENT;
+    return OGS_ERROR;
+}
+
+static int pdp_command(uint8_t cmd, upf_sess_t *sess)
+{
+    char buf[NL_BUFSIZE];
+    struct nlmsghdr *h = NULL;
+    struct genlmsghdr *g = NULL;
+
+    h = nl_msg_init(buf, nl.family,
+            cmd == GTP_CMD_NEWPDP ? NLM_F_CREATE | NLM_F_EXCL : 0);
+    g = nl_put(h, GENL_HDRLEN);
+    g->cmd = cmd;
+    g->version = 0;
+
+    nl_attr_put_u32(h, GTPA_LINK, nl.ifindex);
+    nl_attr_put_u32(h, GTPA_VERSION, GTP_V1);
+    nl_attr_put_u32(h, GTPA_I_TEI, sess->offload.i_teid);
+    if (cmd == GTP_CMD_NEWPDP) {
+        nl_attr_put_u32(h, GTPA_O_TEI, sess->offload.o_teid);
+        nl_attr_put_u32(h, GTPA_PEER_ADDRESS, sess->offload.peer);
+        nl_attr_put_u32(h, GTPA_MS_ADDRESS, sess->offload.ue);
+    }
+
+    return nl_talk(nl.genl, h, NULL);
+}
+
+static int route_command(uint16_t type, uint32_t ue)
+{
+    char buf[NL_BUFSIZE];
+    struct nlmsghdr *h = NULL;
+    struct rtmsg *rtm = NULL;
+
+    h = nl_msg_init(buf, type,
+            type == RTM_NEWROUTE ? NLM_F_CREATE | NLM_F_REPLACE : 0);
+    rtm = nl_put(h, sizeof *rtm);
+    rtm->rtm_family = AF_INET;
+    rtm->rtm_dst_len = 32;
+    rtm->rtm_table = RT_TABLE_MAIN;
+    rtm->rtm_protocol = RTPROT_STATIC;
+    rtm->rtm_scope = RT_SCOPE_LINK;
+    rtm->rtm_type = RTN_UNICAST;
+
+    nl_attr_put(h, RTA_DST, &ue, sizeof(ue));
+    nl_attr_put_u32(h, RTA_OIF, nl.ifindex);
+
+    return nl_talk(nl.rtnl, h, NULL);
+}
+
+int upf_gtp_offload_open(ogs_sock_t *sock)
+{
+    int rv;
+    const char *dev = upf_self()->offload_dev;
+
+    ogs_assert(dev);
+
+    if (!sock) {
+        ogs_error("Kernel GTP offload needs an IPv4 GTP-U address");
+        return OGS_ERROR;
+    }
+
+    nl.rtnl = nl_open(NETLINK_ROUTE);
+    nl.genl = nl_open(NETLINK_GENERIC);
+    if (nl.rtnl == INVALID_SOCKET || nl.genl == INVALID_SOCKET) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                "netlink socket() failed");
+        goto err;
+    }
+
+    rv = link_create(dev, sock->fd);
+    if (rv != OGS_OK && errno == EEXIST) {
+        /* Left behind by a previous run */
+        ogs_warn("Replace GTP device [%s]", dev);
+        rv = link_delete(dev);
+        if (rv == OGS_OK)
+            rv = link_create(dev, sock->fd);
+    }
+    if (rv != OGS_OK) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "Cannot create GTP device [%s]", dev);
+        goto err;
+    }
+
+    nl.ifindex = if_nametoindex(dev);
+    if (!nl.ifindex) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "No GTP device [%s]", dev);
+        goto err;
+    }
+
+    if (family_resolve() != OGS_OK) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "No GTP generic netlink family");
+        goto err;
+    }
+
+    ogs_info("gtp_offload() [%s] ifindex:%d", dev, nl.ifindex);
+
+    return OGS_OK;
+
+err:
+    upf_gtp_offload_close();
+    return OGS_ERROR;
+}
+
+void upf_gtp_offload_close(void)
+{
+    if (nl.ifindex)
+        link_delete(upf_self()->offload_dev);
+    nl.ifindex = 0;
+
+    if (nl.rtnl > 0)
+        ogs_closesocket(nl.rtnl);
+    nl.rtnl = INVALID_SOCKET;
+
+    if (nl.genl > 0)
+        ogs_closesocket(nl.genl);
+    nl.genl = INVALID_SOCKET;
+}
+
+static bool sess_offloadable(upf_sess_t *sess,
+        uint32_t *i_teid, uint32_t *o_teid, uint32_t *peer)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_pfcp_far_t *far = NULL;
+    ogs_pfcp_pdr_t *ul = NULL, *dl = NULL;
+
+    if (!sess->ipv4 || sess->ipv6 || sess->num_of_route)
+        return false;
+
+    ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
+        far = pdr->far;
+        if (!far || pdr->qer || pdr->urr || ogs_list_first(&pdr->rule_list))
+            return false;
+        if (far->apply_action != OGS_PFCP_APPLY_ACTION_FORW)
+            return false;
+
+        if (pdr->src_if == OGS_PFCP_INTERFACE_ACCESS && !ul &&
+            far->dst_if == OGS_PFCP_INTERFACE_CORE &&
+            pdr->f_teid_len && pdr->f_teid.ipv4 &&
+            !far->outer_header_creation_len)
+            ul = pdr;
+        else if (pdr->src_if == OGS_PFCP_INTERFACE_CORE && !dl &&
+            far->dst_if == OGS_PFCP_INTERFACE_ACCESS &&
+            far->outer_header_creation.gtpu4)
+            dl = pdr;
+        else
+            return false;
+    }
+
+    if (!ul || !dl)
+        return false;
+
+    *i_teid = ul->f_teid.teid;
+    *o_teid = dl->far->outer_header_creation.teid;
+    *peer = dl->far->outer_header_creation.addr;
+
+    return true;
+}
+
+void upf_gtp_offload_update(upf_sess_t *sess)
+{
+    uint32_t i_teid, o_teid, peer;
+    char buf[OGS_ADDRSTRLEN];
+
+    ogs_assert(sess);
+
+    if (!nl.ifindex)
+        return;
+
+    if (!sess_offloadable(sess, &i_teid, &o_teid, &peer)) {
+        upf_gtp_offload_remove(sess);
+        return;
+    }
+
+    if (sess->offload.active) {
+        if (sess->offload.i_teid == i_teid &&
+            sess->offload.o_teid == o_teid && sess->offload.peer == peer)
+            return;
+
+        upf_gtp_offload_remove(sess);
+    }
+
+    sess->offload.i_teid = i_teid;
+    sess->offload.o_teid = o_teid;
+    sess->offload.peer = peer;
+    sess->offload.ue = sess->ipv4->addr[0];
+
+    if (pdp_command(GTP_CMD_NEWPDP, sess) != OGS_OK) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "Cannot offload UE[%s] TEID[0x%x]",
+                OGS_INET_NTOP(&sess->offload.ue, buf), i_teid);
+        return;
+    }
+
+    if (route_command(RTM_NEWROUTE, sess->offload.ue) != OGS_OK) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "Cannot route UE[%s] to GTP device",
+                OGS_INET_NTOP(&sess->offload.ue, buf));
+        pdp_command(GTP_CMD_DELPDP, sess);
+        return;
+    }
+
+    sess->offload.active = true;
+
+    ogs_debug("[Offloaded] UE[%s] TEID[0x%x:0x%x]",
+            OGS_INET_NTOP(&sess->offload.ue, buf), i_teid, o_teid);
+}
+
+void upf_gtp_offload_remove(upf_sess_t *sess)
+{
+    char buf[OGS_ADDRSTRLEN];
+
+    ogs_assert(sess);
+
+    if (!sess->offload.active)
+        return;
+
+    sess->offload.active = false;
+
+    /* Everything is gone with the device */
+    if (!nl.ifindex)
+        return;
+
+    if (route_command(RTM_DELROUTE, sess->offload.ue) != OGS_OK)
+        ogs_log_message(OGS_LOG_WARN, ogs_errno,
+                "Cannot remove the route of UE[%s]",
+                OGS_INET_NTOP(&sess->offload.ue, buf));
+    if (pdp_command(GTP_CMD_DELPDP, sess) != OGS_OK)
+        ogs_log_message(OGS_LOG_WARN, ogs_errno,
+                "Cannot remove the PDP context of UE[%s]",
+                OGS_INET_NTOP(&sess->offload.ue, buf));
+
+    ogs_debug("[Withdrawn] UE[%s] TEID[0x%x:0x%x]",
+            OGS_INET_NTOP(&sess->offload.ue, buf),
+            sess->offload.i_teid, sess->offload.o_teid);
+}
+
+#else /* HAVE_LINUX_GTP_H */
+
+int upf_gtp_offload_open(ogs_sock_t *sock)
+{
+    ogs_error("Kernel GTP offload is not supported on this platform");
+    return OGS_ERROR;
+}
+
+void upf_gtp_offload_close(void)
+{
+}
+
+void upf_gtp_offload_update(upf_sess_t *sess)
+{
+}
+
+void upf_gtp_offload_remove(upf_sess_t *sess)
+{
+}
+
+#endif /* HAVE_LINUX_GTP_H */
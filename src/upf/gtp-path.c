@@ -37,6 +37,7 @@
 
 #include "event.h"
 #include "gtp-path.h"
+#include "gtp-offload.h"
 #include "pfcp-path.h"
 #include "rule-match.h"
 
@@ -44,54 +45,94 @@
 
 static ogs_pkbuf_pool_t *packet_pool = NULL;
 
+#define UPF_UPLINK          0
+#define UPF_DOWNLINK        1
+
+static struct {
+    ogs_metrics_t *packets, *bytes, *dropped;
+} metrics;
+
+static const char *direction_name(int index)
+{
+    return index == UPF_UPLINK ? "uplink" : "downlink";
+}
+
+/* Why a packet was dropped. The direction is implied by the cause */
+typedef enum {
+    UPF_DROP_MALFORMED = 0,     /* Bad GTP-U version or header */
+    UPF_DROP_UNKNOWN_TEID,
+    UPF_DROP_NO_UPLINK_PDR,
+    UPF_DROP_NO_SUBNET,
+    UPF_DROP_TUN_WRITE,
+    UPF_DROP_NO_SESSION,        /* No session for the UE IP address */
+    UPF_DROP_NO_DOWNLINK_PDR,
+
+    MAX_NUM_OF_UPF_DROP,
+} upf_drop_cause_e;
+
+static const char *drop_cause_name(int index)
+{
+    static const char *name[MAX_NUM_OF_UPF_DROP] = {
+        "malformed",
+        "unknown_teid",
+        "no_uplink_pdr",
+        "no_subnet",
+        "tun_write",
+        "no_session",
+        "no_downlink_pdr",
+    };
+
+    ogs_assert(index >= 0 && index < MAX_NUM_OF_UPF_DROP);
+    return name[index];
+}
+
 static void upf_gtp_handle_multicast(ogs_pkbuf_t *recvbuf);
 
-static void _gtpv1_tun_recv_cb(short when, ogs_socket_t fd, void *data)
+static int gtpv1_tun_recv(ogs_socket_t fd)
 {
+    int rv = OGS_OK;
     ogs_pkbuf_t *recvbuf = NULL;
 
     upf_sess_t *sess = NULL;
     ogs_pfcp_pdr_t *pdr = NULL;
     ogs_pfcp_pdr_t *fallback_pdr = NULL;
-    ogs_pfcp_far_t *far = NULL;
+    ogs_pfcp_pdr_fwd_t *fwd = NULL;
     ogs_pfcp_user_plane_report_t report;
 
     recvbuf = ogs_tun_read(fd, packet_pool);
-    if (!recvbuf) {
-        ogs_warn("ogs_tun_read() failed");
-        return;
-    }
+    if (!recvbuf)
+        return OGS_DONE;
+
+    ogs_metrics_vector_inc(metrics.packets, UPF_DOWNLINK);
+    ogs_metrics_add_n(metrics.bytes, UPF_DOWNLINK, recvbuf->len);
 
     sess = upf_sess_find_by_ue_ip_address(recvbuf);
-    if (!sess)
+    if (!sess) {
+        ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_NO_SESSION);
         goto cleanup;
+    }
 
     ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
-        far = pdr->far;
-        ogs_assert(far);
+        fwd = pdr->fwd;
+        ogs_assert(fwd);
 
         /* Check if PDR is Downlink */
-        if (pdr->src_if != OGS_PFCP_INTERFACE_CORE)
+        if (fwd->src_if != OGS_PFCP_INTERFACE_CORE)
             continue;
 
         /* Save the Fallback PDR : Lowest precedence downlink PDR */
         fallback_pdr = pdr;
 
         /* Check if FAR is Downlink */
-        if (far->dst_if != OGS_PFCP_INTERFACE_ACCESS)
+        if (fwd->dst_if != OGS_PFCP_INTERFACE_ACCESS)
             continue;
 
         /* Check if Outer header creation */
-        if (far->outer_header_creation.ip4 == 0 &&
-            far->outer_header_creation.ip6 == 0 &&
-            far->outer_header_creation.udp4 == 0 &&
-            far->outer_header_creation.udp6 == 0 &&
-            far->outer_header_creation.gtpu4 == 0 &&
-            far->outer_header_creation.gtpu6 == 0)
+        if (fwd->ohc == false)
             continue;
 
         /* Check if Rule List in PDR */
-        if (ogs_list_first(&pdr->rule_list) &&
+        if (fwd->rule &&
             ogs_pfcp_pdr_rule_find_by_packet(pdr, recvbuf) == NULL)
             continue;
 
@@ -104,7 +145,8 @@ static void _gtpv1_tun_recv_cb(short when, ogs_socket_t fd, void *data)
     if (!pdr) {
         if (ogs_app()->parameter.multicast) {
             upf_gtp_handle_multicast(recvbuf);
-        }
+        } else
+            ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_NO_DOWNLINK_PDR);
         goto cleanup;
     }
 
@@ -119,24 +161,38 @@ static void _gtpv1_tun_recv_cb(short when, ogs_socket_t fd, void *data)
         if (pdr->qer && pdr->qer->qfi)
             report.downlink_data.qfi = pdr->qer->qfi; /* for 5GC */
 
-        upf_pfcp_send_session_report_request(sess, &report);
+        upf_pfcp_report_session(sess, &report);
     }
 
 cleanup:
     ogs_pkbuf_free(recvbuf);
+    return rv;
 }
 
-static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+static void _gtpv1_tun_recv_cb(short when, ogs_socket_t fd, void *data)
+{
+    int i;
+
+    ogs_gtp_send_batch_start();
+
+    for (i = 0; i < OGS_POLL_BUDGET; i++)
+        if (gtpv1_tun_recv(fd) != OGS_OK)
+            break;
+
+    ogs_gtp_send_batch_flush();
+
+    if (i == OGS_POLL_BUDGET)
+        ogs_pollset_continue(ogs_app()->pollset);
+}
+
+static void gtpv1_u_handle(
+        ogs_socket_t fd, ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *from)
 {
     int len;
-    ssize_t size;
     char buf[OGS_ADDRSTRLEN];
 
     upf_sess_t *sess = NULL;
 
-    ogs_pkbuf_t *pkbuf = NULL;
-    ogs_sockaddr_t from;
-
     ogs_gtp_header_t *gtp_h = NULL;
     ogs_pfcp_user_plane_report_t report;
 
@@ -144,43 +200,30 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     uint8_t qfi;
 
     ogs_assert(fd != INVALID_SOCKET);
-
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_PKT_LEN);
-    ogs_assert(pkbuf);
-    ogs_pkbuf_reserve(pkbuf, OGS_TUN_MAX_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_PKT_LEN-OGS_TUN_MAX_HEADROOM);
-
-    size = ogs_recvfrom(fd, pkbuf->data, pkbuf->len, 0, &from);
-    if (size <= 0) {
-        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
-                "ogs_recv() failed");
-        goto cleanup;
-    }
-
-    ogs_pkbuf_trim(pkbuf, size);
-
     ogs_assert(pkbuf);
+    ogs_assert(from);
     ogs_assert(pkbuf->len);
 
     gtp_h = (ogs_gtp_header_t *)pkbuf->data;
     if (gtp_h->version != OGS_GTP_VERSION_1) {
         ogs_error("[DROP] Invalid GTPU version [%d]", gtp_h->version);
         ogs_log_hexdump(OGS_LOG_ERROR, pkbuf->data, pkbuf->len);
+        ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_MALFORMED);
         goto cleanup;
     }
 
     if (gtp_h->type == OGS_GTPU_MSGTYPE_ECHO_REQ) {
         ogs_pkbuf_t *echo_rsp;
 
-        ogs_debug("[RECV] Echo Request from [%s]", OGS_ADDR(&from, buf));
+        ogs_debug("[RECV] Echo Request from [%s]", OGS_ADDR(from, buf));
         echo_rsp = ogs_gtp_handle_echo_req(pkbuf);
         if (echo_rsp) {
             ssize_t sent;
 
             /* Echo reply */
-            ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(&from, buf));
+            ogs_debug("[SEND] Echo Response to [%s]", OGS_ADDR(from, buf));
 
-            sent = ogs_sendto(fd, echo_rsp->data, echo_rsp->len, 0, &from);
+            sent = ogs_sendto(fd, echo_rsp->data, echo_rsp->len, 0, from);
             if (sent < 0 || sent != echo_rsp->len) {
                 ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
                         "ogs_sendto() failed");
@@ -190,10 +233,16 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         goto cleanup;
     }
 
+    if (gtp_h->type == OGS_GTPU_MSGTYPE_ECHO_RSP) {
+        ogs_debug("[RECV] Echo Response from [%s]", OGS_ADDR(from, buf));
+        ogs_gtp_echo_handle_response(pkbuf, from);
+        goto cleanup;
+    }
+
     teid = be32toh(gtp_h->teid);
 
     ogs_debug("[RECV] GPU-U Type [%d] from [%s] : TEID[0x%x]",
-            gtp_h->type, OGS_ADDR(&from, buf), teid);
+            gtp_h->type, OGS_ADDR(from, buf), teid);
 
     qfi = 0;
     if (gtp_h->flags & OGS_GTPU_FLAGS_E) {
@@ -224,6 +273,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
     if (len < 0) {
         ogs_error("[DROP] Cannot decode GTPU packet");
         ogs_log_hexdump(OGS_LOG_ERROR, pkbuf->data, pkbuf->len);
+        ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_MALFORMED);
         goto cleanup;
     }
     ogs_assert(ogs_pkbuf_pull(pkbuf, len));
@@ -243,7 +293,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
                 sess = UPF_SESS(far->sess);
                 ogs_assert(sess);
 
-                upf_pfcp_send_session_report_request(sess, &report);
+                upf_pfcp_report_session(sess, &report);
             }
 
         } else {
@@ -256,17 +306,20 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         ogs_pfcp_object_t *pfcp_object = NULL;
         ogs_pfcp_sess_t *pfcp_sess = NULL;
         ogs_pfcp_pdr_t *pdr = NULL;
+        ogs_pfcp_pdr_fwd_t *fwd = NULL;
         ogs_pfcp_far_t *far = NULL;
-
-        ogs_pfcp_subnet_t *subnet = NULL;
-        ogs_pfcp_dev_t *dev = NULL;
+        ogs_socket_t tun_fd = INVALID_SOCKET;
 
         ip_h = (struct ip *)pkbuf->data;
         ogs_assert(ip_h);
 
+        ogs_metrics_vector_inc(metrics.packets, UPF_UPLINK);
+        ogs_metrics_add_n(metrics.bytes, UPF_UPLINK, pkbuf->len);
+
         pfcp_object = ogs_pfcp_object_find_by_teid(teid);
         if (!pfcp_object) {
             /* TODO : Send Error Indication */
+            ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_UNKNOWN_TEID);
             goto cleanup;
         }
 
@@ -304,6 +357,8 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
 
             if (!pdr) {
                 /* TODO : Send Error Indication */
+                ogs_metrics_vector_inc(
+                        metrics.dropped, UPF_DROP_NO_UPLINK_PDR);
                 goto cleanup;
             }
 
@@ -314,49 +369,45 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
         }
 
         ogs_assert(pdr);
-        ogs_assert(pdr->sess);
-        ogs_assert(pdr->sess->obj.type == OGS_PFCP_OBJ_SESS_TYPE);
+        fwd = pdr->fwd;
+        ogs_assert(fwd);
 
-        sess = UPF_SESS(pdr->sess);
-        ogs_assert(sess);
-
-        far = pdr->far;
-        ogs_assert(far);
-
-        if (far->dst_if == OGS_PFCP_INTERFACE_CORE) {
-            if (ip_h->ip_v == 4 && sess->ipv4)
-                subnet = sess->ipv4->subnet;
-            else if (ip_h->ip_v == 6 && sess->ipv6)
-                subnet = sess->ipv6->subnet;
+        if (fwd->dst_if == OGS_PFCP_INTERFACE_CORE) {
+            if (ip_h->ip_v == 4)
+                tun_fd = fwd->tun.fd4;
+            else if (ip_h->ip_v == 6)
+                tun_fd = fwd->tun.fd6;
 
-            if (!subnet) {
-#if 0 /* It's redundant log message */
-                ogs_error("[DROP] Cannot find subnet V:%d, IPv4:%p, IPv6:%p",
-                        ip_h->ip_v, sess->ipv4, sess->ipv6);
-                ogs_log_hexdump(OGS_LOG_ERROR, pkbuf->data, pkbuf->len);
-#endif
+            if (tun_fd == INVALID_SOCKET) {
+                ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_NO_SUBNET);
                 goto cleanup;
             }
 
-            dev = subnet->dev;
-            ogs_assert(dev);
-            if (ogs_tun_write(dev->fd, pkbuf) != OGS_OK)
+            if (ogs_tun_write(tun_fd, pkbuf) != OGS_OK) {
                 ogs_warn("ogs_tun_write() failed");
+                ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_TUN_WRITE);
+            }
 
-        } else if (far->dst_if == OGS_PFCP_INTERFACE_ACCESS) {
+        } else if (fwd->dst_if == OGS_PFCP_INTERFACE_ACCESS) {
             ogs_pfcp_up_handle_pdr(pdr, pkbuf, &report);
 
             if (report.type.downlink_data_report) {
+                ogs_assert(pdr->sess);
+                sess = UPF_SESS(pdr->sess);
+                ogs_assert(sess);
+
                 ogs_error("Indirect Data Fowarding Buffered");
 
                 report.downlink_data.pdr_id = pdr->id;
                 if (pdr->qer && pdr->qer->qfi)
                     report.downlink_data.qfi = pdr->qer->qfi; /* for 5GC */
 
-                upf_pfcp_send_session_report_request(sess, &report);
+                upf_pfcp_report_session(sess, &report);
             }
 
-        } else if (far->dst_if == OGS_PFCP_INTERFACE_CP_FUNCTION) {
+        } else if (fwd->dst_if == OGS_PFCP_INTERFACE_CP_FUNCTION) {
+            far = pdr->far;
+            ogs_assert(far);
 
             if (!far->gnode) {
                 ogs_error("No Outer Header Creation in FAR");
@@ -374,7 +425,7 @@ static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
             ogs_assert(report.type.downlink_data_report == 0);
 
         } else {
-            ogs_fatal("Not implemented : FAR-DST_IF[%d]", far->dst_if);
+            ogs_fatal("Not implemented : FAR-DST_IF[%d]", fwd->dst_if);
             ogs_assert_if_reached();
         }
     } else {
@@ -386,6 +437,69 @@ cleanup:
     ogs_pkbuf_free(pkbuf);
 }
 
+static void _gtpv1_u_recv_cb(short when, ogs_socket_t fd, void *data)
+{
+    ogs_pkbuf_t *pkbuf[OGS_MAX_NUM_OF_MMSG];
+    ogs_sockaddr_t from[OGS_MAX_NUM_OF_MMSG];
+    int i, n, received = 0;
+
+    ogs_assert(fd != INVALID_SOCKET);
+
+    ogs_gtp_send_batch_start();
+
+    while (received < OGS_POLL_BUDGET) {
+        for (i = 0; i < OGS_MAX_NUM_OF_MMSG; i++) {
+            pkbuf[i] = ogs_pkbuf_alloc(NULL, OGS_MAX_PKT_LEN);
+            ogs_assert(pkbuf[i]);
+            ogs_pkbuf_reserve(pkbuf[i], OGS_TUN_MAX_HEADROOM);
+            ogs_pkbuf_put(pkbuf[i], OGS_MAX_PKT_LEN-OGS_TUN_MAX_HEADROOM);
+        }
+
+        n = ogs_recvmmsg(fd, pkbuf, from, OGS_MAX_NUM_OF_MMSG);
+        if (n < 0 && ogs_socket_errno != OGS_EAGAIN)
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_recvmmsg() failed");
+
+        for (i = 0; i < n; i++) {
+            /* Drop a zero-length datagram */
+            if (pkbuf[i]->len == 0) {
+                ogs_metrics_vector_inc(metrics.dropped, UPF_DROP_MALFORMED);
+                ogs_pkbuf_free(pkbuf[i]);
+                continue;
+            }
+            gtpv1_u_handle(fd, pkbuf[i], &from[i]);
+        }
+        for (i = ogs_max(n, 0); i < OGS_MAX_NUM_OF_MMSG; i++)
+            ogs_pkbuf_free(pkbuf[i]);
+
+        if (n <= 0)
+            break;
+
+        received += n;
+
+        /* A short read has emptied the socket queue */
+        if (n < OGS_MAX_NUM_OF_MMSG)
+            break;
+    }
+
+    ogs_gtp_send_batch_flush();
+
+    if (received >= OGS_POLL_BUDGET)
+        ogs_pollset_continue(ogs_app()->pollset);
+}
+
+
+/*
+ * Only the failure of a path is reported to the SMF, with one Node Report
+ * for the peer instead of a Session Report for each session on the path.
+ */
+static void gtp_path_changed(ogs_gtp_node_t *gnode)
+{
+    ogs_assert(gnode);
+
+    if (gnode->path.down)
+        upf_pfcp_send_node_report_request(gnode);
+}
 
 int upf_gtp_init(void)
 {
@@ -396,11 +510,27 @@ int upf_gtp_init(void)
 
     packet_pool = ogs_pkbuf_pool_create(&config);
 
+    metrics.packets = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "upf_packets_total", "User plane packets by direction",
+            NULL, "direction", 2, direction_name);
+    metrics.bytes = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "upf_bytes_total", "User plane bytes of the inner IP packets",
+            NULL, "direction", 2, direction_name);
+    metrics.dropped = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "upf_dropped_packets_total",
+            "User plane packets dropped by the UPF by cause",
+            NULL, "cause", MAX_NUM_OF_UPF_DROP, drop_cause_name);
+
     return OGS_OK;
 }
 
 void upf_gtp_final(void)
 {
+    if (metrics.packets) ogs_metrics_remove(metrics.packets);
+    if (metrics.bytes) ogs_metrics_remove(metrics.bytes);
+    if (metrics.dropped) ogs_metrics_remove(metrics.dropped);
+    memset(&metrics, 0, sizeof(metrics));
+
     ogs_pkbuf_pool_destroy(packet_pool);
 }
 
@@ -422,12 +552,19 @@ int upf_gtp_open(void)
             ogs_gtp_self()->gtpu_sock6 = sock;
 
         node->poll = ogs_pollset_add(ogs_app()->pollset,
-                OGS_POLLIN, sock->fd, _gtpv1_u_recv_cb, sock);
+                OGS_POLLIN|OGS_POLLET, sock->fd, _gtpv1_u_recv_cb, sock);
         ogs_assert(node->poll);
     }
 
     OGS_SETUP_GTPU_SERVER;
 
+    if (ogs_gtp_echo_open(gtp_path_changed) != OGS_OK)
+        return OGS_ERROR;
+
+    if (upf_self()->offload_dev &&
+        upf_gtp_offload_open(ogs_gtp_self()->gtpu_sock) != OGS_OK)
+        return OGS_ERROR;
+
     /* NOTE : tun device can be created via following command.
      *
      * $ sudo ip tuntap add name ogstun mode tun
@@ -448,7 +585,7 @@ int upf_gtp_open(void)
         }
 
         dev->poll = ogs_pollset_add(ogs_app()->pollset,
-                OGS_POLLIN, dev->fd, _gtpv1_tun_recv_cb, NULL);
+                OGS_POLLIN|OGS_POLLET, dev->fd, _gtpv1_tun_recv_cb, NULL);
         ogs_assert(dev->poll);
     }
 
@@ -483,6 +620,11 @@ void upf_gtp_close(void)
 {
     ogs_pfcp_dev_t *dev = NULL;
 
+    ogs_gtp_echo_close();
+
+    if (upf_self()->offload_dev)
+        upf_gtp_offload_close();
+
     ogs_socknode_remove_all(&ogs_gtp_self()->gtpu_list);
 
     ogs_list_for_each(&ogs_pfcp_self()->dev_list, dev) {
@@ -20,6 +20,7 @@
 #include "context.h"
 #include "gtp-path.h"
 #include "pfcp-path.h"
+#include "checkpoint.h"
 
 static ogs_thread_t *thread;
 static void upf_main(void *data);
@@ -62,6 +63,10 @@ int upf_initialize()
     rv = upf_gtp_open();
     if (rv != OGS_OK) return rv;
 
+    /* The sessions are restored on the GTP-U and PFCP sockets */
+    rv = upf_checkpoint_open();
+    if (rv != OGS_OK) return rv;
+
     thread = ogs_thread_create(upf_main, NULL);
     if (!thread) return OGS_ERROR;
 
@@ -78,6 +83,9 @@ void upf_terminate(void)
 
     ogs_thread_destroy(thread);
 
+    /* The sessions are kept for the next start */
+    upf_checkpoint_close();
+
     upf_pfcp_close();
     upf_gtp_close();
 
@@ -133,6 +141,8 @@ static void upf_main(void *data)
             ogs_fsm_dispatch(&upf_sm, e);
             upf_event_free(e);
         }
+
+        upf_checkpoint_flush();
     }
 done:
 
@@ -67,6 +67,13 @@ ogs_pkbuf_t *upf_n4_build_session_establishment_response(uint8_t type,
         ogs_pfcp_build_created_pdr(&rsp->created_pdr[i], i, created_pdr[i]);
     }
 
+    /* Load/Overload Control Information */
+    upf_update_load();
+    ogs_pfcp_up_build_load_control_information(
+            &rsp->load_control_information);
+    ogs_pfcp_up_build_overload_control_information(
+            &rsp->overload_control_information);
+
     pfcp_message.h.type = type;
     pkbuf = ogs_pfcp_build_msg(&pfcp_message);
 
@@ -100,6 +107,13 @@ ogs_pkbuf_t *upf_n4_build_session_modification_response(uint8_t type,
         ogs_pfcp_build_created_pdr(&rsp->created_pdr[i], i, created_pdr[i]);
     }
 
+    /* Load/Overload Control Information */
+    upf_update_load();
+    ogs_pfcp_up_build_load_control_information(
+            &rsp->load_control_information);
+    ogs_pfcp_up_build_overload_control_information(
+            &rsp->overload_control_information);
+
     pfcp_message.h.type = type;
     pkbuf = ogs_pfcp_build_msg(&pfcp_message);
 
@@ -123,6 +137,13 @@ ogs_pkbuf_t *upf_n4_build_session_deletion_response(uint8_t type,
     rsp->cause.presence = 1;
     rsp->cause.u8 = OGS_PFCP_CAUSE_REQUEST_ACCEPTED;
 
+    /* Load/Overload Control Information */
+    upf_update_load();
+    ogs_pfcp_up_build_load_control_information(
+            &rsp->load_control_information);
+    ogs_pfcp_up_build_overload_control_information(
+            &rsp->overload_control_information);
+
     pfcp_message.h.type = type;
     return ogs_pfcp_build_msg(&pfcp_message);
 }
@@ -20,7 +20,9 @@
 #include "context.h"
 #include "pfcp-path.h"
 #include "gtp-path.h"
+#include "gtp-offload.h"
 #include "n4-handler.h"
+#include "checkpoint.h"
 
 void upf_n4_handle_session_establishment_request(
         upf_sess_t *sess, ogs_pfcp_xact_t *xact, 
@@ -49,6 +51,8 @@ void upf_n4_handle_session_establishment_request(
         return;
     }
 
+    upf_checkpoint_mark(sess);
+
     for (i = 0; i < OGS_MAX_NUM_OF_PDR; i++) {
         created_pdr[i] = ogs_pfcp_handle_create_pdr(&sess->pfcp,
                 &req->create_pdr[i], &cause_value, &offending_ie_value);
@@ -150,6 +154,12 @@ void upf_n4_handle_session_establishment_request(
         }
     }
 
+    /* Setup Framed Route & Delegated IPv6 Prefix */
+    upf_sess_set_route(sess);
+
+    /* Rebuild the Forwarding Entries of the PDRs */
+    upf_sess_update_fwd(sess);
+
     /* Send Buffered Packet to gNB/SGW */
     ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
         if (pdr->src_if == OGS_PFCP_INTERFACE_CORE) { /* Downlink */
@@ -157,6 +167,9 @@ void upf_n4_handle_session_establishment_request(
         }
     }
 
+    /* Install or withdraw the session in the kernel GTP device */
+    upf_gtp_offload_update(sess);
+
     upf_pfcp_send_session_establishment_response(
             xact, sess, created_pdr, num_of_created_pdr);
     return;
@@ -195,6 +208,8 @@ void upf_n4_handle_session_modification_request(
         return;
     }
 
+    upf_checkpoint_mark(sess);
+
     for (i = 0; i < OGS_MAX_NUM_OF_PDR; i++) {
         created_pdr[i] = ogs_pfcp_handle_create_pdr(&sess->pfcp,
                 &req->create_pdr[i], &cause_value, &offending_ie_value);
@@ -292,6 +307,11 @@ void upf_n4_handle_session_modification_request(
     if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
         goto cleanup;
 
+    ogs_pfcp_handle_update_bar(&sess->pfcp, &req->update_bar,
+            &cause_value, &offending_ie_value);
+    if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
+        goto cleanup;
+
     ogs_pfcp_handle_remove_bar(&sess->pfcp, &req->remove_bar,
             &cause_value, &offending_ie_value);
     if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
@@ -363,6 +383,12 @@ void upf_n4_handle_session_modification_request(
         }
     }
 
+    /* Setup Framed Route & Delegated IPv6 Prefix */
+    upf_sess_set_route(sess);
+
+    /* Rebuild the Forwarding Entries of the PDRs */
+    upf_sess_update_fwd(sess);
+
     /* Send Buffered Packet to gNB/SGW */
     ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
         if (pdr->src_if == OGS_PFCP_INTERFACE_CORE) { /* Downlink */
@@ -370,11 +396,15 @@ void upf_n4_handle_session_modification_request(
         }
     }
 
+    /* Install or withdraw the session in the kernel GTP device */
+    upf_gtp_offload_update(sess);
+
     upf_pfcp_send_session_modification_response(
             xact, sess, created_pdr, num_of_created_pdr);
     return;
 
 cleanup:
+    upf_gtp_offload_remove(sess);
     ogs_pfcp_sess_clear(&sess->pfcp);
     ogs_pfcp_send_error_message(xact, sess ? sess->smf_n4_seid : 0,
             OGS_PFCP_SESSION_MODIFICATION_RESPONSE_TYPE,
@@ -423,7 +453,8 @@ void upf_n4_handle_session_report_response(
     if (!sess) {
         ogs_warn("No Context");
         cause_value = OGS_PFCP_CAUSE_SESSION_CONTEXT_NOT_FOUND;
-    }
+    } else
+        ogs_pfcp_up_report_done(&sess->pfcp);
 
     if (rsp->cause.presence) {
         if (rsp->cause.u8 != OGS_PFCP_CAUSE_REQUEST_ACCEPTED) {
@@ -439,4 +470,7 @@ void upf_n4_handle_session_report_response(
         ogs_error("Cause request not accepted[%d]", cause_value);
         return;
     }
+
+    ogs_pfcp_handle_update_bar_report_response(
+            &sess->pfcp, &rsp->update_bar);
 }
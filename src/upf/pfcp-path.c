@@ -165,6 +165,35 @@ void upf_pfcp_close(void)
     ogs_socknode_remove_all(&ogs_pfcp_self()->pfcp_list6);
 }
 
+/*
+ * The SMF of a restored session has not associated yet.
+ * Its node is added as if a message was received from it.
+ */
+ogs_pfcp_node_t *upf_pfcp_node_restore(ogs_sockaddr_t *addr)
+{
+    ogs_pfcp_node_t *node = NULL;
+    ogs_sock_t *sock = NULL;
+
+    ogs_assert(addr);
+
+    node = ogs_pfcp_node_find(&ogs_pfcp_self()->pfcp_peer_list, addr);
+    if (node)
+        return node;
+
+    sock = addr->ogs_sa_family == AF_INET6 ?
+        ogs_pfcp_self()->pfcp_sock6 : ogs_pfcp_self()->pfcp_sock;
+    if (!sock)
+        return NULL;
+
+    node = ogs_pfcp_node_add(&ogs_pfcp_self()->pfcp_peer_list, addr);
+    ogs_assert(node);
+
+    node->sock = sock;
+    pfcp_node_fsm_init(node, false);
+
+    return node;
+}
+
 void upf_pfcp_send_session_establishment_response(
         ogs_pfcp_xact_t *xact, upf_sess_t *sess,
         ogs_pfcp_pdr_t *created_pdr[], int num_of_created_pdr)
@@ -249,6 +278,9 @@ static void sess_timeout(ogs_pfcp_xact_t *xact, void *data)
     switch (type) {
     case OGS_PFCP_SESSION_REPORT_REQUEST_TYPE:
         ogs_error("No PFCP session report response");
+        /* NULL if the session was removed in the meantime */
+        if (data)
+            ogs_pfcp_up_report_done(&((upf_sess_t *)data)->pfcp);
         break;
     default:
         ogs_error("Not implemented [type:%d]", type);
@@ -281,3 +313,59 @@ void upf_pfcp_send_session_report_request(
     rv = ogs_pfcp_xact_commit(xact);
     ogs_expect(rv == OGS_OK);
 }
+
+/*
+ * The report is merged with the other reports of the session and sent
+ * by upf_pfcp_flush_session_report() from the timer of the PFCP node.
+ */
+void upf_pfcp_report_session(
+        upf_sess_t *sess, ogs_pfcp_user_plane_report_t *report)
+{
+    ogs_assert(sess);
+    ogs_assert(sess->pfcp_node);
+    ogs_assert(report);
+
+    ogs_pfcp_up_report_add(sess->pfcp_node, &sess->pfcp, report);
+}
+
+static void send_session_report(
+        ogs_pfcp_sess_t *pfcp_sess, ogs_pfcp_user_plane_report_t *report)
+{
+    upf_pfcp_send_session_report_request(UPF_SESS(pfcp_sess), report);
+}
+
+void upf_pfcp_flush_session_report(ogs_pfcp_node_t *node)
+{
+    ogs_assert(node);
+    ogs_pfcp_up_report_flush(node, send_session_report);
+}
+
+static void node_timeout(ogs_pfcp_xact_t *xact, void *data)
+{
+    uint8_t type;
+
+    ogs_assert(xact);
+    type = xact->seq[0].type;
+
+    switch (type) {
+    case OGS_PFCP_NODE_REPORT_REQUEST_TYPE:
+        ogs_error("No PFCP node report response");
+        break;
+    default:
+        ogs_error("Not implemented [type:%d]", type);
+        break;
+    }
+}
+
+void upf_pfcp_send_node_report_request(ogs_gtp_node_t *gnode)
+{
+    ogs_pfcp_node_t *node = NULL;
+
+    ogs_assert(gnode);
+
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_peer_list, node) {
+        if (OGS_FSM_CHECK(&node->sm, upf_pfcp_state_associated))
+            ogs_pfcp_up_send_node_report_request(
+                    node, &gnode->addr, node_timeout);
+    }
+}
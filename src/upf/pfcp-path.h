@@ -29,6 +29,8 @@ extern "C" {
 int upf_pfcp_open(void);
 void upf_pfcp_close(void);
 
+ogs_pfcp_node_t *upf_pfcp_node_restore(ogs_sockaddr_t *addr);
+
 void upf_pfcp_send_session_establishment_response(
         ogs_pfcp_xact_t *xact, upf_sess_t *sess,
         ogs_pfcp_pdr_t *created_pdr[], int num_of_created_pdr);
@@ -41,6 +43,12 @@ void upf_pfcp_send_session_deletion_response(ogs_pfcp_xact_t *xact,
 void upf_pfcp_send_session_report_request(
         upf_sess_t *sess, ogs_pfcp_user_plane_report_t *report);
 
+void upf_pfcp_report_session(
+        upf_sess_t *sess, ogs_pfcp_user_plane_report_t *report);
+void upf_pfcp_flush_session_report(ogs_pfcp_node_t *node);
+
+void upf_pfcp_send_node_report_request(ogs_gtp_node_t *gnode);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,9 @@ void upf_pfcp_state_initial(ogs_fsm_t *s, upf_event_t *e)
     node->t_no_heartbeat = ogs_timer_add(ogs_app()->timer_mgr,
             upf_timer_no_heartbeat, node);
     ogs_assert(node->t_no_heartbeat);
+    node->report.timer = ogs_timer_add(ogs_app()->timer_mgr,
+            upf_timer_session_report, node);
+    ogs_assert(node->report.timer);
 
     OGS_FSM_TRAN(s, &upf_pfcp_state_will_associate);
 }
@@ -63,6 +66,8 @@ void upf_pfcp_state_final(ogs_fsm_t *s, upf_event_t *e)
     ogs_assert(node);
 
     ogs_timer_delete(node->t_no_heartbeat);
+    ogs_timer_delete(node->report.timer);
+    node->report.timer = NULL;
 }
 
 void upf_pfcp_state_will_associate(ogs_fsm_t *s, upf_event_t *e)
@@ -112,6 +117,9 @@ void upf_pfcp_state_will_associate(ogs_fsm_t *s, upf_event_t *e)
 
             ogs_pfcp_up_send_association_setup_request(node, node_timeout);
             break;
+        case UPF_TIMER_SESSION_REPORT:
+            /* Reports are kept until the node is associated again */
+            break;
         default:
             ogs_error("Unknown timer[%s:%d]",
                     upf_timer_get_name(e->timer_id), e->timer_id);
@@ -173,10 +181,13 @@ void upf_pfcp_state_associated(ogs_fsm_t *s, upf_event_t *e)
         ogs_info("PFCP associated");
         ogs_timer_start(node->t_no_heartbeat,
                 ogs_app()->time.message.pfcp.no_heartbeat_duration);
+        if (ogs_list_first(&node->report.pending_list))
+            ogs_timer_start(node->report.timer, 0);
         break;
     case OGS_FSM_EXIT_SIG:
         ogs_info("PFCP de-associated");
         ogs_timer_stop(node->t_no_heartbeat);
+        ogs_timer_stop(node->report.timer);
         break;
     case UPF_EVT_N4_MESSAGE:
         message = e->pfcp_message;
@@ -228,6 +239,10 @@ void upf_pfcp_state_associated(ogs_fsm_t *s, upf_event_t *e)
             upf_n4_handle_session_report_response(
                 sess, xact, &message->pfcp_session_report_response);
             break;
+        case OGS_PFCP_NODE_REPORT_RESPONSE_TYPE:
+            ogs_pfcp_up_handle_node_report_response(node, xact,
+                    &message->pfcp_node_report_response);
+            break;
         default:
             ogs_error("Not implemented PFCP message type[%d]",
                     message->h.type);
@@ -243,6 +258,9 @@ void upf_pfcp_state_associated(ogs_fsm_t *s, upf_event_t *e)
 
             ogs_pfcp_send_heartbeat_request(node, node_timeout);
             break;
+        case UPF_TIMER_SESSION_REPORT:
+            upf_pfcp_flush_session_report(node);
+            break;
         default:
             ogs_error("Unknown timer[%s:%d]",
                     upf_timer_get_name(e->timer_id), e->timer_id);
@@ -28,6 +28,8 @@ const char *upf_timer_get_name(upf_timer_e id)
         return "UPF_TIMER_ASSOCIATION";
     case UPF_TIMER_NO_HEARTBEAT:
         return "UPF_TIMER_NO_HEARTBEAT";
+    case UPF_TIMER_SESSION_REPORT:
+        return "UPF_TIMER_SESSION_REPORT";
     default: 
        break;
     }
@@ -61,3 +63,8 @@ void upf_timer_no_heartbeat(void *data)
 {
     timer_send_event(UPF_TIMER_NO_HEARTBEAT, data);
 }
+
+void upf_timer_session_report(void *data)
+{
+    timer_send_event(UPF_TIMER_SESSION_REPORT, data);
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#include <unistd.h>
+
+/*
+ * Warm restart of 1M UE contexts.
+ *
+ * The UE looks like a registered mme_ue_t with one PDN connection :
+ * identity, GUTI, security context, subscription and one bearer.
+ * The restore takes the UE back at the same pool index and rebuilds
+ * the IMSI and GUTI hashes, as the MME does at startup.
+ */
+#define CHECKPOINT_NUM_OF_UE    1000000
+#define CHECKPOINT_SLOT_SIZE    1024
+
+typedef struct bench_ue_s {
+    uint8_t imsi[8];
+    struct {
+        uint8_t plmn_id[3];
+        uint16_t mme_gid;
+        uint8_t mme_code;
+        uint32_t m_tmsi;
+    } guti;
+
+    uint8_t kasme[32];
+    uint8_t knas_int[16];
+    uint8_t knas_enc[16];
+    uint8_t nh[32];
+    uint32_t dl_count;
+    uint32_t ul_count;
+
+    uint64_t ambr[2];
+    char apn[16];
+    uint8_t session[160];
+
+    uint8_t ebi;
+    uint32_t sgw_s1u_teid;
+    uint8_t sgw_s1u_ip[24];
+    uint8_t qos[40];
+} bench_ue_t;
+
+static OGS_POOL(bench_ue_pool, bench_ue_t);
+static ogs_ihash_t *imsi_hash;
+static ogs_ihash_t *guti_hash;
+static int encoded_length;
+
+static int encode(int index, void *buf, size_t size, void *data)
+{
+    bench_ue_t *ue = ogs_pool_find(&bench_ue_pool, index);
+    ogs_checkpoint_cursor_t cursor;
+
+    if (!ue)
+        return 0;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, size);
+    OGS_CHECKPOINT_PUT(&cursor, ue->imsi);
+    OGS_CHECKPOINT_PUT(&cursor, ue->guti);
+    OGS_CHECKPOINT_PUT(&cursor, ue->kasme);
+    OGS_CHECKPOINT_PUT(&cursor, ue->knas_int);
+    OGS_CHECKPOINT_PUT(&cursor, ue->knas_enc);
+    OGS_CHECKPOINT_PUT(&cursor, ue->nh);
+    OGS_CHECKPOINT_PUT(&cursor, ue->dl_count);
+    OGS_CHECKPOINT_PUT(&cursor, ue->ul_count);
+    OGS_CHECKPOINT_PUT(&cursor, ue->ambr);
+    OGS_CHECKPOINT_PUT(&cursor, ue->apn);
+    OGS_CHECKPOINT_PUT(&cursor, ue->session);
+    OGS_CHECKPOINT_PUT(&cursor, ue->ebi);
+    OGS_CHECKPOINT_PUT(&cursor, ue->sgw_s1u_teid);
+    OGS_CHECKPOINT_PUT(&cursor, ue->sgw_s1u_ip);
+    OGS_CHECKPOINT_PUT(&cursor, ue->qos);
+    if (cursor.overflow)
+        return -1;
+
+    encoded_length = cursor.pos - (uint8_t *)buf;
+    return encoded_length;
+}
+
+static int decode(int index, const void *buf, size_t length, void *data)
+{
+    bench_ue_t *ue = NULL;
+    ogs_checkpoint_cursor_t cursor;
+
+    ogs_pool_restore(&bench_ue_pool, &ue, index);
+    if (!ue)
+        return OGS_ERROR;
+    memset(ue, 0, sizeof(*ue));
+
+    ogs_checkpoint_cursor_init(&cursor, buf, length);
+    OGS_CHECKPOINT_GET(&cursor, ue->imsi);
+    OGS_CHECKPOINT_GET(&cursor, ue->guti);
+    OGS_CHECKPOINT_GET(&cursor, ue->kasme);
+    OGS_CHECKPOINT_GET(&cursor, ue->knas_int);
+    OGS_CHECKPOINT_GET(&cursor, ue->knas_enc);
+    OGS_CHECKPOINT_GET(&cursor, ue->nh);
+    OGS_CHECKPOINT_GET(&cursor, ue->dl_count);
+    OGS_CHECKPOINT_GET(&cursor, ue->ul_count);
+    OGS_CHECKPOINT_GET(&cursor, ue->ambr);
+    OGS_CHECKPOINT_GET(&cursor, ue->apn);
+    OGS_CHECKPOINT_GET(&cursor, ue->session);
+    OGS_CHECKPOINT_GET(&cursor, ue->ebi);
+    OGS_CHECKPOINT_GET(&cursor, ue->sgw_s1u_teid);
+    OGS_CHECKPOINT_GET(&cursor, ue->sgw_s1u_ip);
+    OGS_CHECKPOINT_GET(&cursor, ue->qos);
+    if (cursor.overflow) {
+        ogs_pool_free(&bench_ue_pool, ue);
+        return OGS_ERROR;
+    }
+
+    ogs_ihash_set(imsi_hash, ue->imsi, ue);
+    ogs_ihash_set(guti_hash, &ue->guti, ue);
+
+    return OGS_OK;
+}
+
+static void bench_ue_remove_all(void)
+{
+    bench_ue_t *ue = NULL;
+    int i;
+
+    for (i = 1; i <= CHECKPOINT_NUM_OF_UE; i++) {
+        ue = ogs_pool_find(&bench_ue_pool, i);
+        if (ue)
+            ogs_pool_free(&bench_ue_pool, ue);
+    }
+}
+
+static void checkpoint_bench_restart(abts_case *tc, void *data)
+{
+    ogs_checkpoint_t *cp = NULL;
+    bench_ue_t *ue = NULL;
+    ogs_time_t start, full, incremental, open, restore;
+    char path[64];
+    uint64_t imsi;
+    int i, n;
+
+    /* A file in the page cache of a disk is stalled by its writeback */
+    ogs_snprintf(path, sizeof(path), "%s/ogs-checkpoint-bench-%d",
+            access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp",
+            (int)getpid());
+    unlink(path);
+
+    ogs_pool_init(&bench_ue_pool, CHECKPOINT_NUM_OF_UE);
+
+    cp = ogs_checkpoint_open(path, "bench", 1,
+            0, CHECKPOINT_SLOT_SIZE, CHECKPOINT_NUM_OF_UE);
+    ABTS_PTR_NOTNULL(tc, cp);
+
+    for (i = 0; i < CHECKPOINT_NUM_OF_UE; i++) {
+        ogs_pool_alloc(&bench_ue_pool, &ue);
+        ogs_assert(ue);
+        memset(ue, 0, sizeof(*ue));
+
+        imsi = 1010000000000ULL + i;
+        ogs_uint64_to_buffer(imsi, sizeof(ue->imsi), ue->imsi);
+        ue->guti.mme_gid = 2;
+        ue->guti.mme_code = 1;
+        ue->guti.m_tmsi = 0xc0000000 | i;
+        memset(ue->kasme, i, sizeof(ue->kasme));
+        strcpy(ue->apn, "internet");
+        ue->ebi = 5;
+        ue->sgw_s1u_teid = i + 1;
+
+        ogs_checkpoint_mark(cp, ogs_pool_index(&bench_ue_pool, ue));
+    }
+
+    start = ogs_get_monotonic_time();
+    n = ogs_checkpoint_flush(cp, encode, NULL);
+    full = ogs_get_monotonic_time() - start;
+    ABTS_INT_EQUAL(tc, CHECKPOINT_NUM_OF_UE, n);
+
+    /* A burst of signalling changes 1% of the UEs */
+    for (i = 0; i < CHECKPOINT_NUM_OF_UE / 100; i++) {
+        ue = ogs_pool_find(&bench_ue_pool, (i * 7919) %
+                CHECKPOINT_NUM_OF_UE + 1);
+        ogs_assert(ue);
+        ue->dl_count++;
+        ogs_checkpoint_mark(cp, ogs_pool_index(&bench_ue_pool, ue));
+    }
+
+    start = ogs_get_monotonic_time();
+    n = ogs_checkpoint_flush(cp, encode, NULL);
+    incremental = ogs_get_monotonic_time() - start;
+    ABTS_INT_EQUAL(tc, CHECKPOINT_NUM_OF_UE / 100, n);
+
+    ogs_checkpoint_close(cp);
+    bench_ue_remove_all();
+    ogs_pool_final(&bench_ue_pool);
+
+    /* Restart */
+    ogs_pool_init(&bench_ue_pool, CHECKPOINT_NUM_OF_UE);
+    imsi_hash = ogs_ihash_make(sizeof(ue->imsi));
+    ogs_assert(imsi_hash);
+    guti_hash = ogs_ihash_make(sizeof(ue->guti));
+    ogs_assert(guti_hash);
+
+    start = ogs_get_monotonic_time();
+    cp = ogs_checkpoint_open(path, "bench", 1,
+            0, CHECKPOINT_SLOT_SIZE, CHECKPOINT_NUM_OF_UE);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ABTS_TRUE(tc, ogs_checkpoint_restored(cp));
+    open = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    n = ogs_checkpoint_restore(cp, decode, NULL);
+    ogs_pool_restore_done(&bench_ue_pool);
+    restore = ogs_get_monotonic_time() - start;
+    ABTS_INT_EQUAL(tc, CHECKPOINT_NUM_OF_UE, n);
+    ABTS_INT_EQUAL(tc, CHECKPOINT_NUM_OF_UE, ogs_ihash_count(imsi_hash));
+    ABTS_INT_EQUAL(tc, CHECKPOINT_NUM_OF_UE, ogs_ihash_count(guti_hash));
+
+    ue = ogs_pool_find(&bench_ue_pool, 7920);
+    ABTS_PTR_NOTNULL(tc, ue);
+    ABTS_INT_EQUAL(tc, 7920, ue->sgw_s1u_teid);
+    ABTS_INT_EQUAL(tc, 1, ue->dl_count);
+    ABTS_STR_EQUAL(tc, "internet", ue->apn);
+
+    ogs_checkpoint_close(cp);
+    unlink(path);
+
+    ogs_ihash_destroy(imsi_hash);
+    ogs_ihash_destroy(guti_hash);
+    bench_ue_remove_all();
+    ogs_pool_final(&bench_ue_pool);
+
+    abts_log_message("%d UEs of %d bytes : full checkpoint %lld ms, "
+            "1%% incremental %lld ms",
+            CHECKPOINT_NUM_OF_UE, encoded_length,
+            (long long)ogs_time_to_msec(full),
+            (long long)ogs_time_to_msec(incremental));
+    abts_log_message("%d UEs restored in %lld ms (open %lld ms) : "
+            "%.1f us per UE",
+            n, (long long)ogs_time_to_msec(open + restore),
+            (long long)ogs_time_to_msec(open),
+            (double)(open + restore) / n);
+}
+
+abts_suite *test_checkpoint_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, checkpoint_bench_restart, NULL);
+
+    return suite;
+}
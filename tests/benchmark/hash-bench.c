@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+/*
+ * ogs_hash_t cannot hold more than 65535 entries with the default
+ * pkbuf configuration since its bucket array must fit in a 1MB cluster.
+ */
+#define HASH_NUM_OF_ENTRY   60000
+#define IHASH_NUM_OF_ENTRY  1000000
+
+/* Visit every key exactly once in a cache-unfriendly order */
+#define NEXT_INDEX(__i, __n) (((__i) + 7919) % (__n))
+
+typedef struct bench_ops_s {
+    const char *name;
+    void *(*make)(void);
+    void (*destroy)(void *h);
+    void (*set)(void *h, uint32_t *key, void *val);
+    void *(*get)(void *h, uint32_t *key);
+} bench_ops_t;
+
+static void *hash_make(void)
+{
+    return ogs_hash_make();
+}
+static void hash_destroy(void *h)
+{
+    ogs_hash_destroy(h);
+}
+static void hash_set(void *h, uint32_t *key, void *val)
+{
+    /* ogs_hash_t keeps the pointer to the key */
+    ogs_hash_set(h, key, sizeof(*key), val);
+}
+static void *hash_get(void *h, uint32_t *key)
+{
+    return ogs_hash_get(h, key, sizeof(*key));
+}
+
+static void *ihash_make(void)
+{
+    return ogs_ihash_make(sizeof(uint32_t));
+}
+static void ihash_destroy(void *h)
+{
+    ogs_ihash_destroy(h);
+}
+static void ihash_set(void *h, uint32_t *key, void *val)
+{
+    ogs_ihash_set(h, key, val);
+}
+static void *ihash_get(void *h, uint32_t *key)
+{
+    return ogs_ihash_get(h, key);
+}
+
+static bench_ops_t hash_ops = {
+    "ogs_hash", hash_make, hash_destroy, hash_set, hash_get };
+static bench_ops_t ihash_ops = {
+    "ogs_ihash", ihash_make, ihash_destroy, ihash_set, ihash_get };
+
+static void run_bench(abts_case *tc, bench_ops_t *ops, int n)
+{
+    void *h = NULL;
+    uint32_t *keys = NULL;
+    ogs_time_t start, t, insert, lookup, remove, insert_max = 0;
+    int i, j, found = 0;
+
+    keys = malloc(sizeof(*keys) * n);
+    ogs_assert(keys);
+
+    /* TEIDs are allocated sequentially from the pool index */
+    for (i = 0; i < n; i++)
+        keys[i] = i + 1;
+
+    h = ops->make();
+    ABTS_PTR_NOTNULL(tc, h);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++)
+        ops->set(h, &keys[i], &keys[i]);
+    insert = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0, j = 0; i < n; i++, j = NEXT_INDEX(j, n)) {
+        if (ops->get(h, &keys[j]) == &keys[j])
+            found++;
+    }
+    lookup = ogs_get_monotonic_time() - start;
+    ABTS_INT_EQUAL(tc, n, found);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++)
+        ops->set(h, &keys[i], NULL);
+    remove = ogs_get_monotonic_time() - start;
+
+    ops->destroy(h);
+
+    /* The longest single insert shows the stall caused by resizing */
+    h = ops->make();
+    ABTS_PTR_NOTNULL(tc, h);
+
+    for (i = 0; i < n; i++) {
+        t = ogs_get_monotonic_time();
+        ops->set(h, &keys[i], &keys[i]);
+        t = ogs_get_monotonic_time() - t;
+        if (t > insert_max)
+            insert_max = t;
+    }
+
+    ops->destroy(h);
+    free(keys);
+
+    abts_log_message("%-10s %8d entries : insert %6.1f ns (max %5lld us), "
+            "lookup %6.1f ns, remove %6.1f ns",
+            ops->name, n,
+            (double)insert * 1000 / n, (long long)insert_max,
+            (double)lookup * 1000 / n, (double)remove * 1000 / n);
+}
+
+static void hash_bench(abts_case *tc, void *data)
+{
+    run_bench(tc, &hash_ops, HASH_NUM_OF_ENTRY);
+}
+
+static void ihash_bench(abts_case *tc, void *data)
+{
+    run_bench(tc, &ihash_ops, HASH_NUM_OF_ENTRY);
+    run_bench(tc, &ihash_ops, IHASH_NUM_OF_ENTRY);
+}
+
+abts_suite *test_hash_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, hash_bench, NULL);
+    abts_run_test(suite, ihash_bench, NULL);
+
+    return suite;
+}
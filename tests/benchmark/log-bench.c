@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#define LOG_NUM_OF_PACKET   10000000
+
+/*
+ * The debug message of the GTP-U receive path in UPF/SGW-U
+ * with the core domain at the default INFO level.
+ */
+static void log_bench_disabled(abts_case *tc, void *data)
+{
+    ogs_sockaddr_t from;
+    char buf[OGS_ADDRSTRLEN];
+    int domain_id = ogs_log_get_domain_id("core");
+    int core_level = ogs_log_get_domain_level(domain_id);
+    ogs_time_t start, eager, gated;
+    uint32_t teid;
+    int i;
+
+    memset(&from, 0, sizeof(from));
+    from.ogs_sa_family = AF_INET;
+    from.sin.sin_addr.s_addr = htobe32(0x0a2d0001);
+    from.ogs_sin_port = htobe16(2152);
+
+    ogs_log_set_domain_level(domain_id, OGS_LOG_INFO);
+
+    /* Arguments are evaluated before the level is checked */
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < LOG_NUM_OF_PACKET; i++) {
+        teid = i;
+        ogs_log_printf(OGS_LOG_DEBUG, OGS_LOG_DOMAIN,
+                0, __FILE__, __LINE__, OGS_FUNC, 0,
+                "[RECV] GPU-U Type [%d] from [%s] : TEID[0x%x]",
+                255, OGS_ADDR(&from, buf), teid);
+    }
+    eager = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < LOG_NUM_OF_PACKET; i++) {
+        teid = i;
+        ogs_debug("[RECV] GPU-U Type [%d] from [%s] : TEID[0x%x]",
+                255, OGS_ADDR(&from, buf), teid);
+    }
+    gated = ogs_get_monotonic_time() - start;
+
+    ogs_log_set_domain_level(domain_id, core_level);
+
+    abts_log_message("disabled ogs_debug() %8d packets : "
+            "eager %6.2f ns, gated %6.2f ns",
+            LOG_NUM_OF_PACKET,
+            (double)eager * 1000 / LOG_NUM_OF_PACKET,
+            (double)gated * 1000 / LOG_NUM_OF_PACKET);
+}
+
+abts_suite *test_log_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, log_bench_disabled, NULL);
+
+    return suite;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#define LPM_NUM_OF_SESSION  1000000
+
+/* Visit every key exactly once in a cache-unfriendly order */
+#define NEXT_INDEX(__i, __n) (((__i) + 7919) % (__n))
+
+/*
+ * Each session owns one prefix.
+ * The address of the prefix is spread over the key space
+ * with a multiplicative hash so that the trie is not a simple chain.
+ */
+static void make_prefix(uint8_t *key, int klen, int i)
+{
+    uint32_t v = (uint32_t)i * 2654435761U;
+
+    memset(key, 0, klen);
+    if (klen == OGS_IPV4_LEN) {
+        v = htobe32(v);
+        memcpy(key, &v, sizeof(v));
+    } else {
+        /* 2001:db8::/32 + 32 bits of session number */
+        key[0] = 0x20; key[1] = 0x01; key[2] = 0x0d; key[3] = 0xb8;
+        key[4] = v >> 24; key[5] = v >> 16; key[6] = v >> 8; key[7] = v;
+    }
+}
+
+/* Odd sessions use 'prefixlen2' so that a lookup may probe two lengths */
+static void run_bench(abts_case *tc, const char *name,
+        int klen, uint8_t prefixlen, uint8_t prefixlen2, int n)
+{
+    ogs_lpm_t *lpm = NULL;
+    uint8_t key[OGS_LPM_MAX_KEY_LEN];
+    ogs_time_t start, insert, lookup, remove;
+    int i, j, found = 0;
+
+    lpm = ogs_lpm_make(klen);
+    ABTS_PTR_NOTNULL(tc, lpm);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        make_prefix(key, klen, i);
+        ogs_lpm_set(lpm, key, (i % 2) ? prefixlen2 : prefixlen,
+                (void *)(uintptr_t)(i+1));
+    }
+    insert = ogs_get_monotonic_time() - start;
+
+    /* Key count can be less than n if the hash maps two sessions together */
+    ABTS_TRUE(tc, ogs_lpm_count(lpm) <= n);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0, j = 0; i < n; i++, j = NEXT_INDEX(j, n)) {
+        make_prefix(key, klen, j);
+        /* Lookup a host address inside the prefix */
+        if (((j % 2) ? prefixlen2 : prefixlen) < klen * 8)
+            key[klen-1] |= 0x01;
+        if (ogs_lpm_lookup(lpm, key))
+            found++;
+    }
+    lookup = ogs_get_monotonic_time() - start;
+    ABTS_INT_EQUAL(tc, n, found);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        make_prefix(key, klen, i);
+        ogs_lpm_set(lpm, key, (i % 2) ? prefixlen2 : prefixlen, NULL);
+    }
+    remove = ogs_get_monotonic_time() - start;
+    ABTS_INT_EQUAL(tc, 0, ogs_lpm_count(lpm));
+
+    ogs_lpm_destroy(lpm);
+
+    abts_log_message("%-12s %8d prefixes : insert %6.1f ns, "
+            "lookup %6.1f ns, remove %6.1f ns",
+            name, n,
+            (double)insert * 1000 / n,
+            (double)lookup * 1000 / n, (double)remove * 1000 / n);
+}
+
+static void lpm_bench_ipv4(abts_case *tc, void *data)
+{
+    run_bench(tc, "IPv4 /32", OGS_IPV4_LEN, 32, 32, LPM_NUM_OF_SESSION);
+    run_bench(tc, "IPv4 /32+/29", OGS_IPV4_LEN, 32, 29, LPM_NUM_OF_SESSION);
+}
+
+static void lpm_bench_ipv6(abts_case *tc, void *data)
+{
+    run_bench(tc, "IPv6 /64", OGS_IPV6_LEN, 64, 64, LPM_NUM_OF_SESSION);
+    run_bench(tc, "IPv6 /64+/56", OGS_IPV6_LEN, 64, 56, LPM_NUM_OF_SESSION);
+}
+
+abts_suite *test_lpm_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, lpm_bench_ipv4, NULL);
+    abts_run_test(suite, lpm_bench_ipv6, NULL);
+
+    return suite;
+}
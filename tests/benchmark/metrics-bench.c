@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#define METRICS_NUM_OF_UPDATE   10000000
+#define METRICS_NUM_OF_THREAD   4
+
+static ogs_metrics_t *counter, *vector, *histogram;
+
+static void update_main(void *data)
+{
+    int i;
+
+    for (i = 0; i < METRICS_NUM_OF_UPDATE; i++)
+        ogs_metrics_inc(counter);
+}
+
+static void metrics_bench_update(abts_case *tc, void *data)
+{
+    int64_t bucket[8] = { 100, 200, 500, 1000, 2000, 5000, 10000, 50000 };
+    ogs_thread_t *thread[METRICS_NUM_OF_THREAD];
+    ogs_time_t start, inc, vinc, observe, threaded;
+    int i;
+
+    counter = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "bench_total", "Benchmark counter", NULL);
+    ABTS_PTR_NOTNULL(tc, counter);
+    vector = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "bench_messages_total", "Benchmark vector", NULL,
+            "type", 256, NULL);
+    ABTS_PTR_NOTNULL(tc, vector);
+    histogram = ogs_metrics_add_histogram("bench_latency_microseconds",
+            "Benchmark histogram", NULL, bucket, 8);
+    ABTS_PTR_NOTNULL(tc, histogram);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < METRICS_NUM_OF_UPDATE; i++)
+        ogs_metrics_inc(counter);
+    inc = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < METRICS_NUM_OF_UPDATE; i++)
+        ogs_metrics_vector_inc(vector, i & 0xff);
+    vinc = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < METRICS_NUM_OF_UPDATE; i++)
+        ogs_metrics_observe(histogram, i & 0xffff);
+    observe = ogs_get_monotonic_time() - start;
+
+    /* Each thread writes its own shard */
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < METRICS_NUM_OF_THREAD; i++)
+        thread[i] = ogs_thread_create(update_main, NULL);
+    for (i = 0; i < METRICS_NUM_OF_THREAD; i++)
+        ogs_thread_destroy(thread[i]);
+    threaded = ogs_get_monotonic_time() - start;
+
+    ABTS_INT_EQUAL(tc, (METRICS_NUM_OF_THREAD + 1) * METRICS_NUM_OF_UPDATE,
+            ogs_metrics_value(counter, 0));
+
+    ogs_metrics_remove(counter);
+    ogs_metrics_remove(vector);
+    ogs_metrics_remove(histogram);
+
+    abts_log_message("%d updates : counter %5.2f ns, vector %5.2f ns, "
+            "histogram %5.2f ns, %d threads %5.2f ns",
+            METRICS_NUM_OF_UPDATE,
+            (double)inc * 1000 / METRICS_NUM_OF_UPDATE,
+            (double)vinc * 1000 / METRICS_NUM_OF_UPDATE,
+            (double)observe * 1000 / METRICS_NUM_OF_UPDATE,
+            METRICS_NUM_OF_THREAD,
+            (double)threaded * 1000 / METRICS_NUM_OF_UPDATE);
+}
+
+abts_suite *test_metrics_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, metrics_bench_update, NULL);
+
+    return suite;
+}
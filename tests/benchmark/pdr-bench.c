@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-pfcp.h"
+#include "core/abts.h"
+
+/*
+ * Forwarding decision of a downlink packet in the UPF with 1M sessions.
+ *
+ * The PDR of the packet is found, as the TEID hash or the UE IP address
+ * would do, and the TEID, QFI, socket and peer of the G-PDU are taken :
+ *
+ * - pointer : from the objects of the PFCP session as before,
+ *             PDR -> FAR -> GTP-U node -> socket and PDR -> QER
+ * - fwd     : from the forwarding entry of the PDR,
+ *             built by ogs_pfcp_pdr_update_fwd() from the same objects
+ */
+#define PDR_NUM_OF_SESS     1000000
+#define PDR_NUM_OF_GNB      256
+#define PDR_NUM_OF_ROUND    4
+
+/* Visit every session exactly once in a cache-unfriendly order */
+#define NEXT_INDEX(__i, __n) (((__i) + 7919) % (__n))
+
+static OGS_POOL(bench_pdr_pool, ogs_pfcp_pdr_t);
+static OGS_POOL(bench_far_pool, ogs_pfcp_far_t);
+static OGS_POOL(bench_qer_pool, ogs_pfcp_qer_t);
+static ogs_pfcp_pdr_fwd_t *bench_fwd;
+
+static ogs_pfcp_pdr_t **bench_pdr;
+static ogs_sock_t bench_sock;
+static ogs_gtp_node_t bench_gnb[PDR_NUM_OF_GNB];
+
+static uint64_t g_pdu_sum(uint32_t teid, uint8_t qfi,
+        ogs_socket_t fd, struct sockaddr_in *sin)
+{
+    return teid + qfi + fd + sin->sin_addr.s_addr;
+}
+
+/* gtpv1_tun_recv(), ogs_pfcp_up_handle_pdr() and ogs_pfcp_send_g_pdu() */
+static uint64_t decide_by_pointer(ogs_pfcp_pdr_t *pdr)
+{
+    ogs_pfcp_far_t *far = pdr->far;
+    ogs_gtp_node_t *gnode = NULL;
+    uint8_t qfi = 0;
+
+    if (pdr->src_if != OGS_PFCP_INTERFACE_CORE ||
+        far->dst_if != OGS_PFCP_INTERFACE_ACCESS ||
+        far->outer_header_creation.gtpu4 == 0)
+        return 0;
+
+    gnode = far->gnode;
+    if (!gnode ||
+        (far->apply_action & OGS_PFCP_APPLY_ACTION_FORW) == 0 ||
+        gnode->path.down || far->buffer.num_of_packet)
+        return 0;
+
+    if (pdr->qer && pdr->qer->qfi)
+        qfi = pdr->qer->qfi;
+
+    return g_pdu_sum(far->outer_header_creation.teid, qfi,
+            gnode->sock->fd, &gnode->addr.sin);
+}
+
+static uint64_t decide_by_fwd(ogs_pfcp_pdr_t *pdr)
+{
+    ogs_pfcp_pdr_fwd_t *fwd = pdr->fwd;
+
+    if (fwd->src_if != OGS_PFCP_INTERFACE_CORE ||
+        fwd->dst_if != OGS_PFCP_INTERFACE_ACCESS ||
+        fwd->ohc == false)
+        return 0;
+
+    if (!fwd->gtpu || fwd->gnode->path.down)
+        return 0;
+
+    return g_pdu_sum(fwd->teid, fwd->qfi, fwd->fd, &fwd->addr.sin);
+}
+
+static ogs_time_t run(uint64_t (*decide)(ogs_pfcp_pdr_t *pdr), uint64_t *sum)
+{
+    ogs_time_t start;
+    int i, j, round;
+
+    *sum = 0;
+
+    start = ogs_get_monotonic_time();
+    for (round = 0; round < PDR_NUM_OF_ROUND; round++)
+        for (i = 0, j = round; i < PDR_NUM_OF_SESS;
+                i++, j = NEXT_INDEX(j, PDR_NUM_OF_SESS))
+            *sum += decide(bench_pdr[j]);
+
+    return ogs_get_monotonic_time() - start;
+}
+
+static void pdr_bench_layout(abts_case *tc, void *data)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_pfcp_far_t *far = NULL;
+    ogs_pfcp_qer_t *qer = NULL;
+    ogs_time_t pointer, fwd;
+    uint64_t pointer_sum, fwd_sum;
+    int i, rv;
+
+    ogs_pool_init(&bench_pdr_pool, PDR_NUM_OF_SESS);
+    ogs_pool_init(&bench_far_pool, PDR_NUM_OF_SESS);
+    ogs_pool_init(&bench_qer_pool, PDR_NUM_OF_SESS);
+
+    rv = posix_memalign((void **)&bench_fwd, sizeof(ogs_pfcp_pdr_fwd_t),
+            sizeof(ogs_pfcp_pdr_fwd_t) * PDR_NUM_OF_SESS);
+    ogs_assert(rv == 0);
+    bench_pdr = calloc(PDR_NUM_OF_SESS, sizeof(*bench_pdr));
+    ogs_assert(bench_pdr);
+
+    memset(&bench_sock, 0, sizeof(bench_sock));
+    bench_sock.fd = 3;
+
+    for (i = 0; i < PDR_NUM_OF_GNB; i++) {
+        memset(&bench_gnb[i], 0, sizeof(bench_gnb[i]));
+        bench_gnb[i].sock = &bench_sock;
+        bench_gnb[i].addr.sin.sin_family = AF_INET;
+        bench_gnb[i].addr.sin.sin_addr.s_addr = htobe32(0x0a000001 + i);
+    }
+
+    /* The packets to one gNB are held since its path is down */
+    bench_gnb[0].path.down = true;
+
+    for (i = 0; i < PDR_NUM_OF_SESS; i++) {
+        ogs_pool_alloc(&bench_pdr_pool, &pdr);
+        ogs_assert(pdr);
+        memset(pdr, 0, sizeof *pdr);
+        ogs_pool_alloc(&bench_far_pool, &far);
+        ogs_assert(far);
+        memset(far, 0, sizeof *far);
+        ogs_pool_alloc(&bench_qer_pool, &qer);
+        ogs_assert(qer);
+        memset(qer, 0, sizeof *qer);
+
+        far->dst_if = OGS_PFCP_INTERFACE_ACCESS;
+        far->apply_action = OGS_PFCP_APPLY_ACTION_FORW;
+        far->outer_header_creation.gtpu4 = 1;
+        far->outer_header_creation.teid = i + 1;
+        far->gnode = &bench_gnb[i % PDR_NUM_OF_GNB];
+
+        /* EPC bearers have no QFI */
+        qer->qfi = i % 10;
+
+        pdr->src_if = OGS_PFCP_INTERFACE_CORE;
+        pdr->far = far;
+        pdr->qer = qer;
+        pdr->fwd = &bench_fwd[i];
+        ogs_pfcp_pdr_update_fwd(pdr);
+
+        bench_pdr[i] = pdr;
+    }
+
+    pointer = run(decide_by_pointer, &pointer_sum);
+    fwd = run(decide_by_fwd, &fwd_sum);
+
+    /* Both layouts take the same decision */
+    ABTS_TRUE(tc, pointer_sum != 0);
+    ABTS_TRUE(tc, pointer_sum == fwd_sum);
+
+    for (i = 0; i < PDR_NUM_OF_SESS; i++) {
+        pdr = bench_pdr[i];
+        ogs_pool_free(&bench_qer_pool, pdr->qer);
+        ogs_pool_free(&bench_far_pool, pdr->far);
+        ogs_pool_free(&bench_pdr_pool, pdr);
+    }
+
+    free(bench_pdr);
+    free(bench_fwd);
+    ogs_pool_final(&bench_qer_pool);
+    ogs_pool_final(&bench_far_pool);
+    ogs_pool_final(&bench_pdr_pool);
+
+    abts_log_message("%d sessions x %d : pointer %5.1f ns, "
+            "fwd %5.1f ns per packet (%d bytes)",
+            PDR_NUM_OF_SESS, PDR_NUM_OF_ROUND,
+            (double)pointer * 1000 / (PDR_NUM_OF_SESS * PDR_NUM_OF_ROUND),
+            (double)fwd * 1000 / (PDR_NUM_OF_SESS * PDR_NUM_OF_ROUND),
+            (int)sizeof(ogs_pfcp_pdr_fwd_t));
+}
+
+abts_suite *test_pdr_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, pdr_bench_layout, NULL);
+
+    return suite;
+}
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-app.h"
+#include "ogs-sbi.h"
+#include "core/abts.h"
+
+#include <netinet/tcp.h>
+#include <nghttp2/nghttp2.h>
+
+/*
+ * Responses per second of the SBI server over h2c.
+ *
+ * The server runs on the pollset of this thread, or on its worker threads.
+ * Each plain nghttp2 client in another thread keeps 'concurrency'
+ * GET requests in flight on its own connection, so the client does not
+ * use the SBI library it measures.
+ */
+#define SBI_BENCH_NUM_OF_REQUEST    100000
+#define SBI_BENCH_BODY_LEN          1024
+#define SBI_BENCH_MAX_NUM_OF_CLIENT 8
+
+typedef struct sbi_bench_client_s {
+    uint16_t port;
+    int concurrency;
+    int num_of_request;
+
+    ogs_socket_t fd;
+    nghttp2_session *session;
+
+    int submitted;
+    int completed;
+    bool failed;
+    int done;
+} sbi_bench_client_t;
+
+static char *body;
+
+/* Also used as the thread-safe callback of the workers */
+static int server_cb(ogs_sbi_request_t *request, void *data)
+{
+    ogs_sbi_stream_t *stream = data;
+    ogs_sbi_response_t *response = NULL;
+
+    response = ogs_sbi_response_new();
+    ogs_assert(response);
+
+    response->status = OGS_SBI_HTTP_STATUS_OK;
+    ogs_sbi_header_set(response->http.headers,
+            OGS_SBI_CONTENT_TYPE, OGS_SBI_CONTENT_JSON_TYPE);
+    response->http.content = ogs_strdup(body);
+    ogs_assert(response->http.content);
+    response->http.content_length = SBI_BENCH_BODY_LEN;
+
+    ogs_sbi_server_send_response(stream, response);
+
+    return OGS_OK;
+}
+
+static ssize_t client_send(nghttp2_session *session, const uint8_t *data,
+        size_t length, int flags, void *user_data)
+{
+    sbi_bench_client_t *client = user_data;
+    size_t written = 0;
+    ssize_t n;
+
+    while (written < length) {
+        n = send(client->fd, data + written, length - written, 0);
+        if (n <= 0)
+            return NGHTTP2_ERR_CALLBACK_FAILURE;
+        written += n;
+    }
+
+    return length;
+}
+
+static int client_stream_close(nghttp2_session *session, int32_t stream_id,
+        uint32_t error_code, void *user_data)
+{
+    sbi_bench_client_t *client = user_data;
+
+    if (error_code != NGHTTP2_NO_ERROR)
+        client->failed = true;
+    client->completed++;
+
+    return 0;
+}
+
+static int client_connect(sbi_bench_client_t *client)
+{
+    struct sockaddr_in sin;
+    int on = 1;
+
+    client->fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (client->fd == INVALID_SOCKET)
+        return OGS_ERROR;
+
+    setsockopt(client->fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_port = htobe16(client->port);
+    sin.sin_addr.s_addr = htobe32(INADDR_LOOPBACK);
+
+    if (connect(client->fd, (struct sockaddr *)&sin, sizeof(sin)) != 0)
+        return OGS_ERROR;
+
+    return OGS_OK;
+}
+
+static void client_main(void *data)
+{
+    sbi_bench_client_t *client = data;
+    nghttp2_session_callbacks *callbacks = NULL;
+    uint8_t buf[16384];
+    ssize_t n;
+
+#define NV(__nAME, __vALUE) \
+    { (uint8_t *)__nAME, (uint8_t *)__vALUE, \
+        sizeof(__nAME) - 1, sizeof(__vALUE) - 1, NGHTTP2_NV_FLAG_NONE }
+    const nghttp2_nv hdrs[] = {
+        NV(":method", "GET"),
+        NV(":scheme", "http"),
+        NV(":authority", "127.0.0.1"),
+        NV(":path", "/nudm-sdm/v2/imsi-001010000000001/am-data"),
+    };
+#undef NV
+
+    if (client_connect(client) != OGS_OK) {
+        client->failed = true;
+        goto done;
+    }
+
+    ogs_assert(nghttp2_session_callbacks_new(&callbacks) == 0);
+    nghttp2_session_callbacks_set_send_callback(callbacks, client_send);
+    nghttp2_session_callbacks_set_on_stream_close_callback(
+            callbacks, client_stream_close);
+    ogs_assert(nghttp2_session_client_new(
+            &client->session, callbacks, client) == 0);
+    nghttp2_session_callbacks_del(callbacks);
+
+    nghttp2_submit_settings(client->session, NGHTTP2_FLAG_NONE, NULL, 0);
+
+    while (client->completed < client->num_of_request && !client->failed) {
+        while (client->submitted < client->num_of_request &&
+                client->submitted - client->completed < client->concurrency) {
+            if (nghttp2_submit_request(client->session, NULL,
+                        hdrs, OGS_ARRAY_SIZE(hdrs), NULL, NULL) < 0) {
+                client->failed = true;
+                break;
+            }
+            client->submitted++;
+        }
+
+        if (nghttp2_session_send(client->session) != 0) {
+            client->failed = true;
+            break;
+        }
+
+        n = recv(client->fd, buf, sizeof(buf), 0);
+        if (n <= 0 ||
+            nghttp2_session_mem_recv(client->session, buf, n) != n) {
+            client->failed = true;
+            break;
+        }
+    }
+
+    nghttp2_session_del(client->session);
+
+done:
+    if (client->fd != INVALID_SOCKET)
+        ogs_closesocket(client->fd);
+
+    __atomic_store_n(&client->done, 1, __ATOMIC_RELEASE);
+}
+
+static void sbi_bench_run(abts_case *tc,
+        int num_of_worker, bool worker_cb, int num_of_client, int concurrency)
+{
+    ogs_sockaddr_t *addr = NULL;
+    ogs_sbi_server_t *server = NULL;
+    ogs_thread_t *thread[SBI_BENCH_MAX_NUM_OF_CLIENT];
+    sbi_bench_client_t client[SBI_BENCH_MAX_NUM_OF_CLIENT];
+    ogs_sockaddr_t local;
+    socklen_t addrlen = sizeof(local.sin);
+    ogs_time_t start, elapsed;
+    int i, done, completed = 0;
+    bool failed = false;
+    int rv;
+
+    ogs_assert(num_of_client <= SBI_BENCH_MAX_NUM_OF_CLIENT);
+
+    rv = ogs_getaddrinfo(&addr, AF_INET, "127.0.0.1", 0, 0);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    server = ogs_sbi_server_add(addr);
+    ABTS_PTR_NOTNULL(tc, server);
+    ogs_freeaddrinfo(addr);
+
+    server->num_of_worker = num_of_worker;
+    if (worker_cb)
+        server->worker_cb = server_cb;
+
+    rv = ogs_sbi_server_start_all(server_cb);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    memset(&local, 0, sizeof(local));
+    rv = getsockname(server->node.sock->fd, &local.sa, &addrlen);
+    ABTS_INT_EQUAL(tc, 0, rv);
+
+    memset(client, 0, sizeof(client));
+    for (i = 0; i < num_of_client; i++) {
+        client[i].fd = INVALID_SOCKET;
+        client[i].port = OGS_PORT(&local);
+        client[i].concurrency = concurrency;
+        client[i].num_of_request = SBI_BENCH_NUM_OF_REQUEST / num_of_client;
+    }
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < num_of_client; i++) {
+        thread[i] = ogs_thread_create(client_main, &client[i]);
+        ABTS_PTR_NOTNULL(tc, thread[i]);
+    }
+
+    do {
+        ogs_pollset_poll(ogs_app()->pollset, ogs_time_from_msec(10));
+
+        done = 0;
+        for (i = 0; i < num_of_client; i++)
+            done += __atomic_load_n(&client[i].done, __ATOMIC_ACQUIRE);
+    } while (done < num_of_client);
+
+    elapsed = ogs_get_monotonic_time() - start;
+
+    for (i = 0; i < num_of_client; i++) {
+        ogs_thread_destroy(thread[i]);
+        ABTS_INT_EQUAL(tc, client[i].num_of_request, client[i].completed);
+        completed += client[i].completed;
+        failed |= client[i].failed;
+    }
+    ABTS_TRUE(tc, failed == false);
+
+    ogs_sbi_server_stop_all();
+    ogs_sbi_server_remove_all();
+
+    abts_log_message("%d responses of %d bytes, %d workers%s, "
+            "%d connections x %d streams : %d/sec",
+            completed, SBI_BENCH_BODY_LEN,
+            num_of_worker, worker_cb ? " (worker_cb)" : "",
+            num_of_client, concurrency,
+            (int)((double)completed * OGS_USEC_PER_SEC / elapsed));
+}
+
+static void sbi_bench_h2c(abts_case *tc, void *data)
+{
+    ogs_pollset_t *pollset = ogs_app()->pollset;
+    uint64_t pool_nf = ogs_app()->pool.nf;
+    uint64_t pool_socket = ogs_app()->pool.socket;
+
+    /* Also the capacity of the pollset of each worker */
+    ogs_app()->pool.socket = 64;
+    ogs_app()->pollset = ogs_pollset_create(ogs_app()->pool.socket);
+    ogs_assert(ogs_app()->pollset);
+    ogs_app()->pool.nf = 1;
+
+    body = ogs_malloc(SBI_BENCH_BODY_LEN + 1);
+    ogs_assert(body);
+    memset(body, 'x', SBI_BENCH_BODY_LEN);
+    body[SBI_BENCH_BODY_LEN] = 0;
+
+    ogs_sbi_message_init(1024, 1024);
+    ogs_sbi_server_init(16, 1024);
+
+    sbi_bench_run(tc, 0, false, 1, 1);
+    sbi_bench_run(tc, 0, false, 1, 100);
+    sbi_bench_run(tc, 0, false, 4, 100);
+    sbi_bench_run(tc, 4, false, 4, 100);
+    sbi_bench_run(tc, 4, true, 4, 100);
+
+    ogs_sbi_server_final();
+    ogs_sbi_message_final();
+
+    ogs_free(body);
+
+    ogs_pollset_destroy(ogs_app()->pollset);
+    ogs_app()->pollset = pollset;
+    ogs_app()->pool.nf = pool_nf;
+    ogs_app()->pool.socket = pool_socket;
+}
+
+abts_suite *test_sbi_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, sbi_bench_h2c, NULL);
+
+    return suite;
+}
@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-gtp.h"
+#include "ogs-pfcp.h"
+#include "core/abts.h"
+
+#define TLV_NUM_OF_ITERATION    100000
+
+/*
+ * PFCP Session Establishment Request of a session
+ * with 8 PDRs, 8 FARs, 4 QERs and 2 URRs
+ */
+#define NUM_OF_PDR  8
+#define NUM_OF_QER  4
+#define NUM_OF_URR  2
+
+static uint8_t node_id[] = { 0x00, 10, 45, 0, 1 };
+static uint8_t f_seid[] = {
+    0x02, 0, 0, 0, 0, 0, 0, 0, 1, 10, 45, 0, 1 };
+static uint8_t f_teid[] = { 0x01, 0, 0, 0, 1, 10, 11, 0, 7 };
+static uint8_t ue_ip[] = { 0x02, 10, 45, 0, 2 };
+static uint8_t dnn[] = { 8, 'i', 'n', 't', 'e', 'r', 'n', 'e', 't' };
+static uint8_t sdf_filter[] = {
+    0x01, 0x00, 0x00, 29, 'p', 'e', 'r', 'm', 'i', 't', ' ',
+    'o', 'u', 't', ' ', 'i', 'p', ' ', 'f', 'r', 'o', 'm', ' ',
+    'a', 'n', 'y', ' ', 't', 'o', ' ', 'a', 'n', 'y' };
+static uint8_t outer_header_removal[] = { 0x00 };
+static uint8_t outer_header_creation[] = {
+    0x01, 0x00, 0, 0, 0, 9, 10, 12, 0, 1 };
+static uint8_t mbr[] = { 0, 0, 0, 0x27, 0x10, 0, 0, 0, 0x4e, 0x20 };
+static uint8_t volume_threshold[] = {
+    0x01, 0, 0, 0, 0, 0x40, 0, 0, 0 };
+
+static void pfcp_session_establishment_request(ogs_pfcp_message_t *message)
+{
+    ogs_pfcp_session_establishment_request_t *req = NULL;
+    int i;
+
+    memset(message, 0, sizeof(*message));
+    message->h.type = OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE;
+    req = &message->pfcp_session_establishment_request;
+
+    req->node_id.presence = 1;
+    req->node_id.data = node_id;
+    req->node_id.len = sizeof(node_id);
+    req->cp_f_seid.presence = 1;
+    req->cp_f_seid.data = f_seid;
+    req->cp_f_seid.len = sizeof(f_seid);
+
+    for (i = 0; i < NUM_OF_PDR; i++) {
+        ogs_pfcp_tlv_create_pdr_t *pdr = &req->create_pdr[i];
+        ogs_pfcp_tlv_create_far_t *far = &req->create_far[i];
+
+        pdr->presence = 1;
+        pdr->pdr_id.presence = 1;
+        pdr->pdr_id.u16 = i + 1;
+        pdr->precedence.presence = 1;
+        pdr->precedence.u32 = 0xff - i;
+        pdr->pdi.presence = 1;
+        pdr->pdi.source_interface.presence = 1;
+        pdr->pdi.source_interface.u8 = i % 2;
+        pdr->pdi.network_instance.presence = 1;
+        pdr->pdi.network_instance.data = dnn;
+        pdr->pdi.network_instance.len = sizeof(dnn);
+        pdr->pdi.local_f_teid.presence = 1;
+        pdr->pdi.local_f_teid.data = f_teid;
+        pdr->pdi.local_f_teid.len = sizeof(f_teid);
+        pdr->pdi.ue_ip_address.presence = 1;
+        pdr->pdi.ue_ip_address.data = ue_ip;
+        pdr->pdi.ue_ip_address.len = sizeof(ue_ip);
+        pdr->pdi.sdf_filter[0].presence = 1;
+        pdr->pdi.sdf_filter[0].data = sdf_filter;
+        pdr->pdi.sdf_filter[0].len = sizeof(sdf_filter);
+        pdr->pdi.sdf_filter[1].presence = 1;
+        pdr->pdi.sdf_filter[1].data = sdf_filter;
+        pdr->pdi.sdf_filter[1].len = sizeof(sdf_filter);
+        pdr->pdi.qfi.presence = 1;
+        pdr->pdi.qfi.u8 = 1;
+        pdr->outer_header_removal.presence = 1;
+        pdr->outer_header_removal.data = outer_header_removal;
+        pdr->outer_header_removal.len = sizeof(outer_header_removal);
+        pdr->far_id.presence = 1;
+        pdr->far_id.u32 = i + 1;
+        pdr->qer_id.presence = 1;
+        pdr->qer_id.u32 = i % NUM_OF_QER + 1;
+
+        far->presence = 1;
+        far->far_id.presence = 1;
+        far->far_id.u32 = i + 1;
+        far->apply_action.presence = 1;
+        far->apply_action.u8 = OGS_PFCP_APPLY_ACTION_FORW;
+        far->forwarding_parameters.presence = 1;
+        far->forwarding_parameters.destination_interface.presence = 1;
+        far->forwarding_parameters.destination_interface.u8 = (i + 1) % 2;
+        far->forwarding_parameters.network_instance.presence = 1;
+        far->forwarding_parameters.network_instance.data = dnn;
+        far->forwarding_parameters.network_instance.len = sizeof(dnn);
+        far->forwarding_parameters.outer_header_creation.presence = 1;
+        far->forwarding_parameters.outer_header_creation.data =
+            outer_header_creation;
+        far->forwarding_parameters.outer_header_creation.len =
+            sizeof(outer_header_creation);
+    }
+
+    for (i = 0; i < NUM_OF_QER; i++) {
+        ogs_pfcp_tlv_create_qer_t *qer = &req->create_qer[i];
+
+        qer->presence = 1;
+        qer->qer_id.presence = 1;
+        qer->qer_id.u32 = i + 1;
+        qer->gate_status.presence = 1;
+        qer->gate_status.u8 = 0;
+        qer->maximum_bitrate.presence = 1;
+        qer->maximum_bitrate.data = mbr;
+        qer->maximum_bitrate.len = sizeof(mbr);
+        qer->qos_flow_identifier.presence = 1;
+        qer->qos_flow_identifier.u8 = i + 1;
+    }
+
+    for (i = 0; i < NUM_OF_URR; i++) {
+        ogs_pfcp_tlv_create_urr_t *urr = &req->create_urr[i];
+
+        urr->presence = 1;
+        urr->urr_id.presence = 1;
+        urr->urr_id.u32 = i + 1;
+        urr->measurement_method.presence = 1;
+        urr->measurement_method.u8 = 0x02;
+        urr->reporting_triggers.presence = 1;
+        urr->reporting_triggers.u8 = 0x01;
+        urr->volume_threshold.presence = 1;
+        urr->volume_threshold.data = volume_threshold;
+        urr->volume_threshold.len = sizeof(volume_threshold);
+    }
+
+    req->pdn_type.presence = 1;
+    req->pdn_type.u8 = OGS_PDU_SESSION_TYPE_IPV4;
+}
+
+static void pfcp_push_header(ogs_pkbuf_t *pkbuf, uint8_t type)
+{
+    ogs_pfcp_header_t *h = NULL;
+
+    h = (ogs_pfcp_header_t *)ogs_pkbuf_push(pkbuf, OGS_PFCP_HEADER_LEN);
+    ogs_assert(h);
+    memset(h, 0, OGS_PFCP_HEADER_LEN);
+    h->version = 1;
+    h->seid_presence = 1;
+    h->type = type;
+    h->length = htobe16(pkbuf->len - 4);
+}
+
+static void tlv_bench_pfcp(abts_case *tc, void *data)
+{
+    static ogs_pfcp_message_t template, message;
+    ogs_pfcp_session_establishment_request_t *req =
+        &message.pfcp_session_establishment_request;
+    ogs_pkbuf_t *pkbuf = NULL, *pkbuf2 = NULL;
+    ogs_time_t start, desc_build, direct_build, desc_parse, direct_parse;
+    int i, rv, n = TLV_NUM_OF_ITERATION;
+
+    pfcp_session_establishment_request(&template);
+
+    /* Both encoders give the same octets */
+    memcpy(&message, &template, sizeof(message));
+    pkbuf = ogs_tlv_build_msg(
+            &ogs_pfcp_msg_desc_pfcp_session_establishment_request,
+            &message.pfcp_session_establishment_request, OGS_TLV_MODE_T2_L2);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+    memcpy(&message, &template, sizeof(message));
+    pkbuf2 = ogs_pfcp_build_msg(&message);
+    ABTS_PTR_NOTNULL(tc, pkbuf2);
+    ABTS_INT_EQUAL(tc, pkbuf->len, pkbuf2->len);
+    ABTS_TRUE(tc, memcmp(pkbuf->data, pkbuf2->data, pkbuf->len) == 0);
+    ogs_pkbuf_free(pkbuf2);
+
+    /*
+     * The descriptor engine converts the integers of the structure
+     * into network byte order, so the structure is copied before
+     * each build for both encoders.
+     */
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        memcpy(&message, &template, sizeof(message));
+        pkbuf2 = ogs_tlv_build_msg(
+            &ogs_pfcp_msg_desc_pfcp_session_establishment_request,
+            &message.pfcp_session_establishment_request, OGS_TLV_MODE_T2_L2);
+        ogs_pkbuf_free(pkbuf2);
+    }
+    desc_build = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        memcpy(&message, &template, sizeof(message));
+        pkbuf2 = ogs_pfcp_build_msg(&message);
+        ogs_pkbuf_free(pkbuf2);
+    }
+    direct_build = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        memset(&message, 0, sizeof(message));
+        rv = ogs_tlv_parse_msg(&message.pfcp_session_establishment_request,
+            &ogs_pfcp_msg_desc_pfcp_session_establishment_request,
+            pkbuf, OGS_TLV_MODE_T2_L2);
+        ogs_assert(rv == OGS_OK);
+    }
+    desc_parse = ogs_get_monotonic_time() - start;
+
+    pfcp_push_header(pkbuf, OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        /* ogs_pfcp_parse_msg() clears the message and pulls the header */
+        rv = ogs_pfcp_parse_msg(&message, pkbuf);
+        ogs_assert(rv == OGS_OK);
+        ogs_assert(ogs_pkbuf_push(pkbuf, OGS_PFCP_HEADER_LEN));
+    }
+    direct_parse = ogs_get_monotonic_time() - start;
+
+    ABTS_INT_EQUAL(tc, 1, req->create_pdr[NUM_OF_PDR-1].presence);
+    ABTS_INT_EQUAL(tc, NUM_OF_PDR, req->create_pdr[NUM_OF_PDR-1].pdr_id.u16);
+    ABTS_INT_EQUAL(tc, 1, req->create_pdr[0].pdi.sdf_filter[1].presence);
+    ABTS_INT_EQUAL(tc, 1, req->create_far[NUM_OF_PDR-1].
+            forwarding_parameters.outer_header_creation.presence);
+    ABTS_INT_EQUAL(tc, NUM_OF_QER, req->create_qer[NUM_OF_QER-1].qer_id.u32);
+    ABTS_INT_EQUAL(tc, 1, req->create_urr[NUM_OF_URR-1].presence);
+
+    abts_log_message("PFCP Session Establishment Request (%d bytes) : "
+            "build %6.1f ns -> %6.1f ns, parse %6.1f ns -> %6.1f ns",
+            pkbuf->len - OGS_PFCP_HEADER_LEN,
+            (double)desc_build * 1000 / n, (double)direct_build * 1000 / n,
+            (double)desc_parse * 1000 / n, (double)direct_parse * 1000 / n);
+
+    ogs_pkbuf_free(pkbuf);
+}
+
+static uint8_t imsi[] = { 0x55, 0x15, 0x30, 0x11, 0x34, 0x00, 0x10, 0xf4 };
+static uint8_t msisdn[] = { 0x94, 0x71, 0x52, 0x76, 0x00, 0x41 };
+static uint8_t uli[] = {
+    0x18, 0x55, 0xf5, 0x01, 0x10, 0x22, 0x55, 0xf5, 0x01, 0x00, 0x01, 0x9d,
+    0x01 };
+static uint8_t plmn_id[] = { 0x55, 0xf5, 0x01 };
+static uint8_t s11_f_teid[] = { 0x8a, 0x80, 0x00, 0x00, 0x84, 10, 50, 54, 10 };
+static uint8_t s5_f_teid[] = { 0x87, 0x00, 0x00, 0x00, 0x00, 10, 50, 54, 37 };
+static uint8_t apn[] = { 8, 'i', 'n', 't', 'e', 'r', 'n', 'e', 't' };
+static uint8_t paa[] = { 0x01, 0, 0, 0, 0 };
+static uint8_t ambr[] = { 0, 0, 0x03, 0xe8, 0, 0, 0x07, 0xd0 };
+static uint8_t bearer_qos[] = {
+    0x45, 0x05, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+static void gtp_create_session_request(ogs_gtp_message_t *message)
+{
+    ogs_gtp_create_session_request_t *req = NULL;
+
+    memset(message, 0, sizeof(*message));
+    message->h.type = OGS_GTP_CREATE_SESSION_REQUEST_TYPE;
+    req = &message->create_session_request;
+
+    req->imsi.presence = 1;
+    req->imsi.data = imsi;
+    req->imsi.len = sizeof(imsi);
+    req->msisdn.presence = 1;
+    req->msisdn.data = msisdn;
+    req->msisdn.len = sizeof(msisdn);
+    req->user_location_information.presence = 1;
+    req->user_location_information.data = uli;
+    req->user_location_information.len = sizeof(uli);
+    req->serving_network.presence = 1;
+    req->serving_network.data = plmn_id;
+    req->serving_network.len = sizeof(plmn_id);
+    req->rat_type.presence = 1;
+    req->rat_type.u8 = OGS_GTP_RAT_TYPE_EUTRAN;
+    req->sender_f_teid_for_control_plane.presence = 1;
+    req->sender_f_teid_for_control_plane.data = s11_f_teid;
+    req->sender_f_teid_for_control_plane.len = sizeof(s11_f_teid);
+    req->pgw_s5_s8_address_for_control_plane_or_pmip.presence = 1;
+    req->pgw_s5_s8_address_for_control_plane_or_pmip.data = s5_f_teid;
+    req->pgw_s5_s8_address_for_control_plane_or_pmip.len = sizeof(s5_f_teid);
+    req->access_point_name.presence = 1;
+    req->access_point_name.data = apn;
+    req->access_point_name.len = sizeof(apn);
+    req->selection_mode.presence = 1;
+    req->selection_mode.u8 = 0xfc;
+    req->pdn_type.presence = 1;
+    req->pdn_type.u8 = OGS_PDU_SESSION_TYPE_IPV4;
+    req->pdn_address_allocation.presence = 1;
+    req->pdn_address_allocation.data = paa;
+    req->pdn_address_allocation.len = sizeof(paa);
+    req->maximum_apn_restriction.presence = 1;
+    req->maximum_apn_restriction.u8 = OGS_GTP_APN_NO_RESTRICTION;
+    req->aggregate_maximum_bit_rate.presence = 1;
+    req->aggregate_maximum_bit_rate.data = ambr;
+    req->aggregate_maximum_bit_rate.len = sizeof(ambr);
+    req->bearer_contexts_to_be_created.presence = 1;
+    req->bearer_contexts_to_be_created.eps_bearer_id.presence = 1;
+    req->bearer_contexts_to_be_created.eps_bearer_id.u8 = 5;
+    req->bearer_contexts_to_be_created.bearer_level_qos.presence = 1;
+    req->bearer_contexts_to_be_created.bearer_level_qos.data = bearer_qos;
+    req->bearer_contexts_to_be_created.bearer_level_qos.len =
+        sizeof(bearer_qos);
+}
+
+static void tlv_bench_gtp(abts_case *tc, void *data)
+{
+    static ogs_gtp_message_t template, message;
+    ogs_pkbuf_t *pkbuf = NULL, *pkbuf2 = NULL;
+    ogs_gtp_header_t *h = NULL;
+    ogs_time_t start, desc_build, direct_build, desc_parse, direct_parse;
+    int i, rv, n = TLV_NUM_OF_ITERATION;
+
+    gtp_create_session_request(&template);
+
+    memcpy(&message, &template, sizeof(message));
+    pkbuf = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_session_request,
+            &message.create_session_request, OGS_TLV_MODE_T1_L2_I1);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+    memcpy(&message, &template, sizeof(message));
+    pkbuf2 = ogs_gtp_build_msg(&message);
+    ABTS_PTR_NOTNULL(tc, pkbuf2);
+    ABTS_INT_EQUAL(tc, pkbuf->len, pkbuf2->len);
+    ABTS_TRUE(tc, memcmp(pkbuf->data, pkbuf2->data, pkbuf->len) == 0);
+    ogs_pkbuf_free(pkbuf2);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        memcpy(&message, &template, sizeof(message));
+        pkbuf2 = ogs_tlv_build_msg(&ogs_gtp_tlv_desc_create_session_request,
+                &message.create_session_request, OGS_TLV_MODE_T1_L2_I1);
+        ogs_pkbuf_free(pkbuf2);
+    }
+    desc_build = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        memcpy(&message, &template, sizeof(message));
+        pkbuf2 = ogs_gtp_build_msg(&message);
+        ogs_pkbuf_free(pkbuf2);
+    }
+    direct_build = ogs_get_monotonic_time() - start;
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        memset(&message, 0, sizeof(message));
+        rv = ogs_tlv_parse_msg(&message.create_session_request,
+                &ogs_gtp_tlv_desc_create_session_request,
+                pkbuf, OGS_TLV_MODE_T1_L2_I1);
+        ogs_assert(rv == OGS_OK);
+    }
+    desc_parse = ogs_get_monotonic_time() - start;
+
+    h = (ogs_gtp_header_t *)ogs_pkbuf_push(pkbuf, OGS_GTPV2C_HEADER_LEN);
+    ogs_assert(h);
+    memset(h, 0, OGS_GTPV2C_HEADER_LEN);
+    h->version = 2;
+    h->teid_presence = 1;
+    h->type = OGS_GTP_CREATE_SESSION_REQUEST_TYPE;
+    h->length = htobe16(pkbuf->len - 4);
+
+    start = ogs_get_monotonic_time();
+    for (i = 0; i < n; i++) {
+        rv = ogs_gtp_parse_msg(&message, pkbuf);
+        ogs_assert(rv == OGS_OK);
+    }
+    direct_parse = ogs_get_monotonic_time() - start;
+
+    ABTS_INT_EQUAL(tc, 5, message.create_session_request.
+            bearer_contexts_to_be_created.eps_bearer_id.u8);
+
+    abts_log_message("GTPv2-C Create Session Request (%d bytes) : "
+            "build %6.1f ns -> %6.1f ns, parse %6.1f ns -> %6.1f ns",
+            pkbuf->len - OGS_GTPV2C_HEADER_LEN,
+            (double)desc_build * 1000 / n, (double)direct_build * 1000 / n,
+            (double)desc_parse * 1000 / n, (double)direct_parse * 1000 / n);
+
+    ogs_pkbuf_free(pkbuf);
+}
+
+abts_suite *test_tlv_bench(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, tlv_bench_pfcp, NULL);
+    abts_run_test(suite, tlv_bench_gtp, NULL);
+
+    return suite;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-common.h"
+
+static int bucket_index(int64_t value)
+{
+    int msb, shift, index;
+
+    if (value < TEST_HISTOGRAM_SUB)
+        return value < 0 ? 0 : value;
+
+    msb = 63 - __builtin_clzll((uint64_t)value);
+    shift = msb - TEST_HISTOGRAM_SUB_BITS;
+    index = (shift + 1) * TEST_HISTOGRAM_SUB +
+        (int)((value >> shift) - TEST_HISTOGRAM_SUB);
+
+    return ogs_min(index, TEST_HISTOGRAM_BUCKET - 1);
+}
+
+/* Largest value which falls into the bucket */
+static int64_t bucket_value(int index)
+{
+    int shift;
+    int64_t mantissa;
+
+    if (index < TEST_HISTOGRAM_SUB)
+        return index;
+
+    shift = index / TEST_HISTOGRAM_SUB - 1;
+    mantissa = index % TEST_HISTOGRAM_SUB + TEST_HISTOGRAM_SUB;
+
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void test_histogram_add(test_histogram_t *histogram, int64_t value)
+{
+    ogs_assert(histogram);
+
+    if (!histogram->count || value < histogram->min)
+        histogram->min = value;
+    if (value > histogram->max)
+        histogram->max = value;
+
+    histogram->count++;
+    histogram->sum += value;
+    histogram->bucket[bucket_index(value)]++;
+}
+
+int64_t test_histogram_percentile(test_histogram_t *histogram, double percent)
+{
+    uint64_t target, sum = 0;
+    int i;
+
+    ogs_assert(histogram);
+
+    if (!histogram->count)
+        return 0;
+
+    target = (uint64_t)(histogram->count * percent / 100.0 + 0.5);
+    if (target == 0)
+        target = 1;
+
+    for (i = 0; i < TEST_HISTOGRAM_BUCKET; i++) {
+        sum += histogram->bucket[i];
+        if (sum >= target)
+            return ogs_min(bucket_value(i), histogram->max);
+    }
+
+    return histogram->max;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_COMMON_HISTOGRAM_H
+#define TEST_COMMON_HISTOGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Log-linear histogram for latency measurement in the load tools.
+ * Each power of two is split into 16 buckets, so a percentile is
+ * reported within 1/16 of the true value.
+ */
+#define TEST_HISTOGRAM_SUB_BITS     4
+#define TEST_HISTOGRAM_SUB          (1 << TEST_HISTOGRAM_SUB_BITS)
+#define TEST_HISTOGRAM_BUCKET       (TEST_HISTOGRAM_SUB * 40)
+
+typedef struct test_histogram_s {
+    uint64_t count;
+    int64_t min, max, sum;
+    uint64_t bucket[TEST_HISTOGRAM_BUCKET];
+} test_histogram_t;
+
+void test_histogram_add(test_histogram_t *histogram, int64_t value);
+int64_t test_histogram_percentile(test_histogram_t *histogram, double percent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_COMMON_HISTOGRAM_H */
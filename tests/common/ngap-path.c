@@ -24,19 +24,29 @@ void testngap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf)
     int rv;
     ogs_ngap_message_t message;
 
+    ogs_assert(test_ue);
+    ogs_assert(pkbuf);
+
+    rv = ogs_ngap_decode(&message, pkbuf);
+    ogs_assert(rv == OGS_OK);
+
+    testngap_dispatch(test_ue, &message);
+
+    ogs_ngap_free(&message);
+    ogs_pkbuf_free(pkbuf);
+}
+
+void testngap_dispatch(test_ue_t *test_ue, ogs_ngap_message_t *message)
+{
     NGAP_NGAP_PDU_t *pdu = NULL;
     NGAP_InitiatingMessage_t *initiatingMessage = NULL;
     NGAP_SuccessfulOutcome_t *successfulOutcome = NULL;
     NGAP_UnsuccessfulOutcome_t *unsuccessfulOutcome = NULL;
 
     ogs_assert(test_ue);
-    ogs_assert(pkbuf);
+    ogs_assert(message);
 
-    rv = ogs_ngap_decode(&message, pkbuf);
-    ogs_assert(rv == OGS_OK);
-
-    pdu = &message;
-    ogs_assert(pdu);
+    pdu = message;
 
     switch (pdu->present) {
     case NGAP_NGAP_PDU_PR_initiatingMessage:
@@ -75,6 +85,8 @@ void testngap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf)
             break;
         case NGAP_ProcedureCode_id_ErrorIndication:
         case NGAP_ProcedureCode_id_Paging:
+        case NGAP_ProcedureCode_id_OverloadStart:
+        case NGAP_ProcedureCode_id_OverloadStop:
             /* Nothing */
             break;
         default:
@@ -133,9 +145,6 @@ void testngap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf)
         ogs_error("Not implemented(choice:%d)", pdu->present);
         break;
     }
-
-    ogs_ngap_free(&message);
-    ogs_pkbuf_free(pkbuf);
 }
 
 void testngap_send_to_nas(test_ue_t *test_ue, NGAP_NAS_PDU_t *nasPdu)
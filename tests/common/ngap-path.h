@@ -25,6 +25,7 @@ extern "C" {
 #endif
 
 void testngap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf);
+void testngap_dispatch(test_ue_t *test_ue, ogs_ngap_message_t *message);
 void testngap_send_to_nas(test_ue_t *test_ue, NGAP_NAS_PDU_t *nasPdu);
 
 #ifdef __cplusplus
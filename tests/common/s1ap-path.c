@@ -24,18 +24,27 @@ void tests1ap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf)
     int rv;
     ogs_s1ap_message_t message;
 
+    ogs_assert(pkbuf);
+
+    rv = ogs_s1ap_decode(&message, pkbuf);
+    ogs_assert(rv == OGS_OK);
+
+    tests1ap_dispatch(test_ue, &message);
+
+    ogs_s1ap_free(&message);
+    ogs_pkbuf_free(pkbuf);
+}
+
+void tests1ap_dispatch(test_ue_t *test_ue, ogs_s1ap_message_t *message)
+{
     S1AP_S1AP_PDU_t *pdu = NULL;
     S1AP_InitiatingMessage_t *initiatingMessage = NULL;
     S1AP_SuccessfulOutcome_t *successfulOutcome = NULL;
     S1AP_UnsuccessfulOutcome_t *unsuccessfulOutcome = NULL;
 
-    ogs_assert(pkbuf);
-
-    rv = ogs_s1ap_decode(&message, pkbuf);
-    ogs_assert(rv == OGS_OK);
+    ogs_assert(message);
 
-    pdu = &message;
-    ogs_assert(pdu);
+    pdu = message;
 
     switch (pdu->present) {
     case S1AP_S1AP_PDU_PR_initiatingMessage:
@@ -79,6 +88,9 @@ void tests1ap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf)
             break;
         case S1AP_ProcedureCode_id_ErrorIndication:
             break;
+        case S1AP_ProcedureCode_id_OverloadStart:
+        case S1AP_ProcedureCode_id_OverloadStop:
+            break;
         default:
             ogs_error("Not implemented(choice:%d, proc:%d)",
                     pdu->present, (int)initiatingMessage->procedureCode);
@@ -136,9 +148,6 @@ void tests1ap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf)
         ogs_error("Not implemented(choice:%d)", pdu->present);
         break;
     }
-
-    ogs_s1ap_free(&message);
-    ogs_pkbuf_free(pkbuf);
 }
 
 void tests1ap_send_to_nas(test_ue_t *test_ue, S1AP_NAS_PDU_t *nasPdu)
@@ -25,6 +25,7 @@ extern "C" {
 #endif
 
 void tests1ap_recv(test_ue_t *test_ue, ogs_pkbuf_t *pkbuf);
+void tests1ap_dispatch(test_ue_t *test_ue, ogs_s1ap_message_t *message);
 void tests1ap_send_to_nas(test_ue_t *test_ue, S1AP_NAS_PDU_t *nasPdu);
 
 #ifdef __cplusplus
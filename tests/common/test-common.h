@@ -45,6 +45,7 @@ extern "C" {
 #include "common/context.h"
 #include "common/sctp.h"
 #include "common/gtpu.h"
+#include "common/histogram.h"
 #include "common/application.h"
 #include "common/gmm-build.h"
 #include "common/gmm-handler.h"
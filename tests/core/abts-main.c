@@ -37,6 +37,10 @@ abts_suite *test_poll(abts_suite *suite);
 abts_suite *test_tlv(abts_suite *suite);
 abts_suite *test_fsm(abts_suite *suite);
 abts_suite *test_hash(abts_suite *suite);
+abts_suite *test_ihash(abts_suite *suite);
+abts_suite *test_lpm(abts_suite *suite);
+abts_suite *test_metrics(abts_suite *suite);
+abts_suite *test_checkpoint(abts_suite *suite);
 abts_suite *test_uuid(abts_suite *suite);
 
 const struct testlist {
@@ -59,6 +63,10 @@ const struct testlist {
     {test_tlv},
     {test_fsm},
     {test_hash},
+    {test_ihash},
+    {test_lpm},
+    {test_metrics},
+    {test_checkpoint},
     {test_uuid},
     {NULL},
 };
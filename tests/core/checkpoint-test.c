@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#include <unistd.h>
+
+#define NUM_OF_SLOT 16
+#define SLOT_SIZE   64
+
+typedef struct {
+    uint32_t value;
+    char *name;
+} context_t;
+
+static context_t *context[NUM_OF_SLOT+1];
+static int num_of_encode;
+static char path[64];
+
+static int encode(int index, void *buf, size_t size, void *data)
+{
+    ogs_checkpoint_cursor_t cursor;
+
+    num_of_encode++;
+
+    if (!context[index])
+        return 0;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, size);
+    OGS_CHECKPOINT_PUT(&cursor, context[index]->value);
+    ogs_checkpoint_put_string(&cursor, context[index]->name);
+    if (cursor.overflow)
+        return -1;
+
+    return cursor.pos - (uint8_t *)buf;
+}
+
+static int decode(int index, const void *buf, size_t length, void *data)
+{
+    abts_case *tc = data;
+    ogs_checkpoint_cursor_t cursor;
+    uint32_t value;
+    char *name;
+
+    ogs_checkpoint_cursor_init(&cursor, buf, length);
+    OGS_CHECKPOINT_GET(&cursor, value);
+    name = ogs_checkpoint_get_string(&cursor);
+    ABTS_TRUE(tc, cursor.overflow == false);
+    ABTS_INT_EQUAL(tc, length, cursor.pos - (uint8_t *)buf);
+
+    /* The context of slot 5 is rejected by the decoder */
+    if (index == 5) {
+        ogs_free(name);
+        return OGS_ERROR;
+    }
+
+    ABTS_PTR_EQUAL(tc, NULL, context[index]);
+    context[index] = ogs_calloc(1, sizeof(context_t));
+    ogs_assert(context[index]);
+    context[index]->value = value;
+    context[index]->name = name;
+
+    return OGS_OK;
+}
+
+static void context_set(int index, uint32_t value, const char *name)
+{
+    if (!context[index]) {
+        context[index] = ogs_calloc(1, sizeof(context_t));
+        ogs_assert(context[index]);
+    }
+    context[index]->value = value;
+    if (context[index]->name)
+        ogs_free(context[index]->name);
+    context[index]->name = name ? ogs_strdup(name) : NULL;
+}
+
+static void context_remove(int index)
+{
+    if (context[index]) {
+        if (context[index]->name)
+            ogs_free(context[index]->name);
+        ogs_free(context[index]);
+        context[index] = NULL;
+    }
+}
+
+static void context_remove_all(void)
+{
+    int i;
+
+    for (i = 1; i <= NUM_OF_SLOT; i++)
+        context_remove(i);
+}
+
+static void test1_func(abts_case *tc, void *data)
+{
+    ogs_checkpoint_t *cp = NULL;
+    uint32_t *user = NULL;
+    int n;
+
+    unlink(path);
+
+    cp = ogs_checkpoint_open(path, "test", 1,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ABTS_TRUE(tc, ogs_checkpoint_restored(cp) == false);
+
+    user = ogs_checkpoint_user(cp);
+    ABTS_INT_EQUAL(tc, 0, *user);
+    *user = 0x12345678;
+
+    context_set(1, 1, "first");
+    context_set(5, 5, "fifth");
+    context_set(8, 8, NULL);
+    context_set(NUM_OF_SLOT, NUM_OF_SLOT, "last");
+
+    /* A context changed twice is encoded once */
+    ogs_checkpoint_mark(cp, 1);
+    ogs_checkpoint_mark(cp, 5);
+    ogs_checkpoint_mark(cp, 1);
+    ogs_checkpoint_mark(cp, 8);
+    ogs_checkpoint_mark(cp, NUM_OF_SLOT);
+
+    num_of_encode = 0;
+    n = ogs_checkpoint_flush(cp, encode, NULL);
+    ABTS_INT_EQUAL(tc, 4, n);
+    ABTS_INT_EQUAL(tc, 4, num_of_encode);
+
+    n = ogs_checkpoint_flush(cp, encode, NULL);
+    ABTS_INT_EQUAL(tc, 0, n);
+
+    /* The slot of a removed context is erased */
+    context_remove(8);
+    ogs_checkpoint_mark(cp, 8);
+    context_set(1, 100, "updated");
+    ogs_checkpoint_mark(cp, 1);
+
+    /* A context that does not fit is not saved */
+    context_set(2, 2, "0123456789012345678901234567890123456789"
+            "0123456789012345678901234567890123456789");
+    ogs_checkpoint_mark(cp, 2);
+
+    n = ogs_checkpoint_flush(cp, encode, NULL);
+    ABTS_INT_EQUAL(tc, 3, n);
+
+    ogs_checkpoint_close(cp);
+    context_remove_all();
+
+    /* Restart */
+    cp = ogs_checkpoint_open(path, "test", 1,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ABTS_TRUE(tc, ogs_checkpoint_restored(cp) == true);
+
+    user = ogs_checkpoint_user(cp);
+    ABTS_INT_EQUAL(tc, 0x12345678, *user);
+
+    n = ogs_checkpoint_restore(cp, decode, tc);
+    ABTS_INT_EQUAL(tc, 2, n);
+
+    ABTS_PTR_NOTNULL(tc, context[1]);
+    ABTS_INT_EQUAL(tc, 100, context[1]->value);
+    ABTS_STR_EQUAL(tc, "updated", context[1]->name);
+    ABTS_PTR_EQUAL(tc, NULL, context[2]);
+    ABTS_PTR_EQUAL(tc, NULL, context[5]);
+    ABTS_PTR_EQUAL(tc, NULL, context[8]);
+    ABTS_PTR_NOTNULL(tc, context[NUM_OF_SLOT]);
+    ABTS_INT_EQUAL(tc, NUM_OF_SLOT, context[NUM_OF_SLOT]->value);
+    ABTS_STR_EQUAL(tc, "last", context[NUM_OF_SLOT]->name);
+
+    ogs_checkpoint_close(cp);
+    context_remove_all();
+
+    /* The slot rejected by the decoder was erased */
+    cp = ogs_checkpoint_open(path, "test", 1,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT);
+    ABTS_PTR_NOTNULL(tc, cp);
+    n = ogs_checkpoint_restore(cp, decode, tc);
+    ABTS_INT_EQUAL(tc, 2, n);
+    ogs_checkpoint_close(cp);
+    context_remove_all();
+
+    unlink(path);
+}
+
+static void test2_func(abts_case *tc, void *data)
+{
+    ogs_checkpoint_t *cp = NULL;
+    FILE *fp = NULL;
+    int n;
+
+    unlink(path);
+
+    cp = ogs_checkpoint_open(path, "test", 1,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ogs_checkpoint_set_sync(cp, ogs_time_from_msec(10));
+
+    context_set(3, 3, "third");
+    context_set(4, 4, "fourth");
+    ogs_checkpoint_mark(cp, 3);
+    ogs_checkpoint_mark(cp, 4);
+    n = ogs_checkpoint_flush(cp, encode, NULL);
+    ABTS_INT_EQUAL(tc, 2, n);
+
+    ogs_checkpoint_close(cp);
+    context_remove_all();
+
+    /* Corrupt the data of the first slot */
+    fp = fopen(path, "r+b");
+    ABTS_PTR_NOTNULL(tc, fp);
+    {
+        uint8_t buf[SLOT_SIZE*8];
+        size_t size;
+        int i;
+
+        size = fread(buf, 1, sizeof(buf), fp);
+        ABTS_INT_EQUAL(tc, sizeof(buf), size);
+        for (i = 0; i + 5 <= sizeof(buf); i++) {
+            if (memcmp(&buf[i], "third", 5) == 0) {
+                buf[i] = 'T';
+                break;
+            }
+        }
+        ABTS_TRUE(tc, i + 5 <= sizeof(buf));
+        fseek(fp, 0, SEEK_SET);
+        ABTS_INT_EQUAL(tc, sizeof(buf), fwrite(buf, 1, sizeof(buf), fp));
+    }
+    fclose(fp);
+
+    cp = ogs_checkpoint_open(path, "test", 1,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ABTS_TRUE(tc, ogs_checkpoint_restored(cp) == true);
+    n = ogs_checkpoint_restore(cp, decode, tc);
+    ABTS_INT_EQUAL(tc, 1, n);
+    ABTS_PTR_EQUAL(tc, NULL, context[3]);
+    ABTS_PTR_NOTNULL(tc, context[4]);
+    ogs_checkpoint_close(cp);
+    context_remove_all();
+
+    /* Another version starts empty */
+    cp = ogs_checkpoint_open(path, "test", 2,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ABTS_TRUE(tc, ogs_checkpoint_restored(cp) == false);
+    n = ogs_checkpoint_restore(cp, decode, tc);
+    ABTS_INT_EQUAL(tc, 0, n);
+    ogs_checkpoint_close(cp);
+
+    /* So does another number of slots */
+    cp = ogs_checkpoint_open(path, "test", 2,
+            sizeof(uint32_t), SLOT_SIZE, NUM_OF_SLOT * 2);
+    ABTS_PTR_NOTNULL(tc, cp);
+    ABTS_TRUE(tc, ogs_checkpoint_restored(cp) == false);
+    ogs_checkpoint_close(cp);
+
+    unlink(path);
+}
+
+abts_suite *test_checkpoint(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    ogs_snprintf(path, sizeof(path),
+            "/tmp/ogs-checkpoint-test-%d", (int)getpid());
+
+    abts_run_test(suite, test1_func, NULL);
+    abts_run_test(suite, test2_func, NULL);
+
+    return suite;
+}
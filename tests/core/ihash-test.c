@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#define NUM_OF_ENTRY 100000
+
+static void ihash_test1(abts_case *tc, void *data)
+{
+    ogs_ihash_t *h = NULL;
+    uint32_t teid;
+
+    h = ogs_ihash_make(sizeof(teid));
+    ABTS_PTR_NOTNULL(tc, h);
+
+    teid = 1;
+    ogs_ihash_set(h, &teid, "one");
+    teid = 2;
+    ogs_ihash_set(h, &teid, "two");
+    ABTS_INT_EQUAL(tc, 2, ogs_ihash_count(h));
+
+    /* The key is copied */
+    teid = 1;
+    ABTS_STR_EQUAL(tc, "one", ogs_ihash_get(h, &teid));
+    teid = 2;
+    ABTS_STR_EQUAL(tc, "two", ogs_ihash_get(h, &teid));
+    teid = 3;
+    ABTS_PTR_EQUAL(tc, NULL, ogs_ihash_get(h, &teid));
+
+    /* Overwrite */
+    teid = 1;
+    ogs_ihash_set(h, &teid, "ONE");
+    ABTS_STR_EQUAL(tc, "ONE", ogs_ihash_get(h, &teid));
+    ABTS_INT_EQUAL(tc, 2, ogs_ihash_count(h));
+
+    /* Delete */
+    ogs_ihash_set(h, &teid, NULL);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_ihash_get(h, &teid));
+    ABTS_INT_EQUAL(tc, 1, ogs_ihash_count(h));
+
+    /* Delete non-existent key */
+    teid = 3;
+    ogs_ihash_set(h, &teid, NULL);
+    ABTS_INT_EQUAL(tc, 1, ogs_ihash_count(h));
+
+    ogs_ihash_clear(h);
+    ABTS_INT_EQUAL(tc, 0, ogs_ihash_count(h));
+    teid = 2;
+    ABTS_PTR_EQUAL(tc, NULL, ogs_ihash_get(h, &teid));
+
+    ogs_ihash_destroy(h);
+}
+
+static void ihash_test2(abts_case *tc, void *data)
+{
+    ogs_ihash_t *h = NULL;
+    uint64_t seid;
+    int i;
+
+    h = ogs_ihash_make(sizeof(seid));
+    ABTS_PTR_NOTNULL(tc, h);
+
+    /* Grow several times while some entries are removed */
+    for (i = 1; i <= NUM_OF_ENTRY; i++) {
+        seid = (uint64_t)i << 32 | i;
+        ogs_ihash_set(h, &seid, (void *)(uintptr_t)i);
+
+        if ((i % 3) == 0) {
+            seid = (uint64_t)(i-1) << 32 | (i-1);
+            ogs_ihash_set(h, &seid, NULL);
+        }
+    }
+    ABTS_INT_EQUAL(tc, NUM_OF_ENTRY - NUM_OF_ENTRY/3, ogs_ihash_count(h));
+
+    for (i = 1; i <= NUM_OF_ENTRY; i++) {
+        void *val = NULL;
+
+        seid = (uint64_t)i << 32 | i;
+        val = ogs_ihash_get(h, &seid);
+        if ((i % 3) == 2)
+            ABTS_PTR_EQUAL(tc, NULL, val);
+        else
+            ABTS_PTR_EQUAL(tc, (void *)(uintptr_t)i, val);
+    }
+
+    for (i = 1; i <= NUM_OF_ENTRY; i++) {
+        seid = (uint64_t)i << 32 | i;
+        ogs_ihash_set(h, &seid, NULL);
+    }
+    ABTS_INT_EQUAL(tc, 0, ogs_ihash_count(h));
+
+    ogs_ihash_destroy(h);
+}
+
+static void ihash_test3(abts_case *tc, void *data)
+{
+    ogs_ihash_t *h = NULL;
+    uint8_t addr6[OGS_IHASH_MAX_KEY_LEN];
+    int i;
+
+    h = ogs_ihash_make(sizeof(addr6));
+    ABTS_PTR_NOTNULL(tc, h);
+
+    memset(addr6, 0, sizeof(addr6));
+    addr6[0] = 0x20;
+    addr6[1] = 0x01;
+
+    for (i = 0; i < 1024; i++) {
+        addr6[15] = i & 0xff;
+        addr6[8] = i >> 8;
+        ogs_ihash_set(h, addr6, (void *)(uintptr_t)(i+1));
+    }
+
+    for (i = 0; i < 1024; i++) {
+        addr6[15] = i & 0xff;
+        addr6[8] = i >> 8;
+        ABTS_PTR_EQUAL(tc, (void *)(uintptr_t)(i+1), ogs_ihash_get(h, addr6));
+    }
+
+    /* The prefix differs from all the stored keys */
+    addr6[0] = 0x21;
+    ABTS_PTR_EQUAL(tc, NULL, ogs_ihash_get(h, addr6));
+
+    ogs_ihash_destroy(h);
+}
+
+abts_suite *test_ihash(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, ihash_test1, NULL);
+    abts_run_test(suite, ihash_test2, NULL);
+    abts_run_test(suite, ihash_test3, NULL);
+
+    return suite;
+}
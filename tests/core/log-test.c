@@ -103,11 +103,52 @@ static void test_basic(abts_case *tc, void *data)
 #endif
 }
 
+static int evaluated;
+
+static const char *evaluate(void)
+{
+    evaluated++;
+    return "evaluated";
+}
+
+static void test_lazy(abts_case *tc, void *data)
+{
+    int domain_id = ogs_log_get_domain_id("core");
+    int core_level = ogs_log_get_domain_level(domain_id);
+
+    ogs_log_set_domain_level(domain_id, OGS_LOG_ERROR);
+    ABTS_INT_EQUAL(tc, OGS_LOG_ERROR, ogs_log_domain_level[domain_id]);
+    ABTS_TRUE(tc, ogs_log_enabled(OGS_LOG_ERROR, domain_id));
+    ABTS_TRUE(tc, !ogs_log_enabled(OGS_LOG_WARN, domain_id));
+
+    evaluated = 0;
+    ogs_warn("%s", evaluate());
+    ogs_info("%s", evaluate());
+    ogs_debug("%s", evaluate());
+    ogs_trace("%s", evaluate());
+    ogs_log_print(OGS_LOG_DEBUG, "%s", evaluate());
+    ABTS_INT_EQUAL(tc, 0, evaluated);
+
+    ogs_log_set_mask_level("core", OGS_LOG_NONE);
+    ABTS_INT_EQUAL(tc, OGS_LOG_NONE, ogs_log_domain_level[domain_id]);
+    ogs_error("%s", evaluate());
+    ABTS_INT_EQUAL(tc, 0, evaluated);
+
+    ogs_log_config_domain("core", "trace");
+    ABTS_INT_EQUAL(tc, OGS_LOG_TRACE, ogs_log_domain_level[domain_id]);
+    ABTS_INT_EQUAL(tc, OGS_LOG_COMPILE_LEVEL >= OGS_LOG_TRACE,
+            ogs_log_enabled(OGS_LOG_TRACE, domain_id));
+
+    ogs_log_set_domain_level(domain_id, core_level);
+    ABTS_INT_EQUAL(tc, core_level, ogs_log_domain_level[domain_id]);
+}
+
 abts_suite *test_log(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
 
     abts_run_test(suite, test_basic, NULL);
+    abts_run_test(suite, test_lazy, NULL);
 
     return suite;
 }
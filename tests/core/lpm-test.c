@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+static uint32_t ipv4(const char *str)
+{
+    struct in_addr addr;
+    ogs_assert(inet_pton(AF_INET, str, &addr) == 1);
+    return addr.s_addr;
+}
+
+static void lpm_test1(abts_case *tc, void *data)
+{
+    ogs_lpm_t *lpm = NULL;
+    uint32_t addr;
+
+    lpm = ogs_lpm_make(OGS_IPV4_LEN);
+    ABTS_PTR_NOTNULL(tc, lpm);
+
+    addr = ipv4("10.45.0.0");
+    ogs_lpm_set(lpm, &addr, 16, "10.45/16");
+    addr = ipv4("10.45.1.0");
+    ogs_lpm_set(lpm, &addr, 24, "10.45.1/24");
+    addr = ipv4("10.45.1.7");
+    ogs_lpm_set(lpm, &addr, 32, "10.45.1.7/32");
+    addr = ipv4("10.46.0.0");
+    ogs_lpm_set(lpm, &addr, 16, "10.46/16");
+    ABTS_INT_EQUAL(tc, 4, ogs_lpm_count(lpm));
+
+    addr = ipv4("10.45.1.7");
+    ABTS_STR_EQUAL(tc, "10.45.1.7/32", ogs_lpm_lookup(lpm, &addr));
+    addr = ipv4("10.45.1.8");
+    ABTS_STR_EQUAL(tc, "10.45.1/24", ogs_lpm_lookup(lpm, &addr));
+    addr = ipv4("10.45.2.1");
+    ABTS_STR_EQUAL(tc, "10.45/16", ogs_lpm_lookup(lpm, &addr));
+    addr = ipv4("10.46.255.255");
+    ABTS_STR_EQUAL(tc, "10.46/16", ogs_lpm_lookup(lpm, &addr));
+    addr = ipv4("10.47.0.1");
+    ABTS_PTR_EQUAL(tc, NULL, ogs_lpm_lookup(lpm, &addr));
+
+    /* The host part of the key is ignored */
+    addr = ipv4("10.45.1.99");
+    ABTS_STR_EQUAL(tc, "10.45.1/24", ogs_lpm_get(lpm, &addr, 24));
+    ABTS_PTR_EQUAL(tc, NULL, ogs_lpm_get(lpm, &addr, 23));
+
+    /* Remove the middle prefix */
+    addr = ipv4("10.45.1.0");
+    ogs_lpm_set(lpm, &addr, 24, NULL);
+    ABTS_INT_EQUAL(tc, 3, ogs_lpm_count(lpm));
+    addr = ipv4("10.45.1.8");
+    ABTS_STR_EQUAL(tc, "10.45/16", ogs_lpm_lookup(lpm, &addr));
+    addr = ipv4("10.45.1.7");
+    ABTS_STR_EQUAL(tc, "10.45.1.7/32", ogs_lpm_lookup(lpm, &addr));
+
+    /* 10.46/16 still matches after 10.45/16 is removed */
+    addr = ipv4("10.45.0.0");
+    ogs_lpm_set(lpm, &addr, 16, NULL);
+    addr = ipv4("10.45.1.8");
+    ABTS_PTR_EQUAL(tc, NULL, ogs_lpm_lookup(lpm, &addr));
+    addr = ipv4("10.46.0.1");
+    ABTS_STR_EQUAL(tc, "10.46/16", ogs_lpm_lookup(lpm, &addr));
+
+    /* Default route */
+    addr = 0;
+    ogs_lpm_set(lpm, &addr, 0, "default");
+    addr = ipv4("8.8.8.8");
+    ABTS_STR_EQUAL(tc, "default", ogs_lpm_lookup(lpm, &addr));
+    ABTS_INT_EQUAL(tc, 3, ogs_lpm_count(lpm));
+
+    ogs_lpm_clear(lpm);
+    ABTS_INT_EQUAL(tc, 0, ogs_lpm_count(lpm));
+    ABTS_PTR_EQUAL(tc, NULL, ogs_lpm_lookup(lpm, &addr));
+
+    ogs_lpm_destroy(lpm);
+}
+
+static void lpm_test2(abts_case *tc, void *data)
+{
+    ogs_lpm_t *lpm = NULL;
+    uint8_t addr6[OGS_IPV6_LEN];
+    int i;
+
+    lpm = ogs_lpm_make(OGS_IPV6_LEN);
+    ABTS_PTR_NOTNULL(tc, lpm);
+
+    /* Delegated prefixes 2001:db8:0:i00::/56 */
+    memset(addr6, 0, sizeof(addr6));
+    addr6[0] = 0x20; addr6[1] = 0x01; addr6[2] = 0x0d; addr6[3] = 0xb8;
+    for (i = 0; i < 256; i++) {
+        addr6[6] = i;
+        ogs_lpm_set(lpm, addr6, 56, (void *)(uintptr_t)(i+1));
+    }
+    ABTS_INT_EQUAL(tc, 256, ogs_lpm_count(lpm));
+
+    addr6[6] = 0x12;
+    addr6[7] = 0x34;
+    addr6[15] = 0x01;
+    ABTS_PTR_EQUAL(tc, (void *)(uintptr_t)0x13, ogs_lpm_lookup(lpm, addr6));
+
+    addr6[5] = 0x01;
+    ABTS_PTR_EQUAL(tc, NULL, ogs_lpm_lookup(lpm, addr6));
+    addr6[5] = 0x00;
+
+    for (i = 0; i < 256; i += 2) {
+        addr6[6] = i;
+        ogs_lpm_set(lpm, addr6, 56, NULL);
+    }
+    ABTS_INT_EQUAL(tc, 128, ogs_lpm_count(lpm));
+
+    for (i = 0; i < 256; i++) {
+        addr6[6] = i;
+        if (i % 2)
+            ABTS_PTR_EQUAL(tc, (void *)(uintptr_t)(i+1),
+                    ogs_lpm_lookup(lpm, addr6));
+        else
+            ABTS_PTR_EQUAL(tc, NULL, ogs_lpm_lookup(lpm, addr6));
+    }
+
+    ogs_lpm_destroy(lpm);
+}
+
+abts_suite *test_lpm(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, lpm_test1, NULL);
+    abts_run_test(suite, lpm_test2, NULL);
+
+    return suite;
+}
@@ -70,6 +70,49 @@ static void test4_func(abts_case *tc, void *data)
     ogs_free(q);
 }
 
+static void test5_func(abts_case *tc, void *data)
+{
+    ogs_pkbuf_t *pkbuf, *copy;
+    char *p;
+
+    /* The data is taken over with the headroom */
+    pkbuf = ogs_pkbuf_alloc(NULL, 16 + 10);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+    ogs_pkbuf_reserve(pkbuf, 16);
+    ogs_pkbuf_put_data(pkbuf, "0123456789", 10);
+
+    p = ogs_pkbuf_to_mem(pkbuf);
+    ABTS_PTR_NOTNULL(tc, p);
+    ABTS_TRUE(tc, memcmp(p, "0123456789", 10) == 0);
+    ABTS_TRUE(tc, p == (char *)pkbuf->data);
+    ogs_free(p);
+
+    /* Without the headroom, the data is copied */
+    pkbuf = ogs_pkbuf_alloc(NULL, 10);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+    ogs_pkbuf_put_data(pkbuf, "0123456789", 10);
+
+    p = ogs_pkbuf_to_mem(pkbuf);
+    ABTS_PTR_NOTNULL(tc, p);
+    ABTS_TRUE(tc, memcmp(p, "0123456789", 10) == 0);
+    ogs_free(p);
+
+    /* So is the data shared by a copy */
+    pkbuf = ogs_pkbuf_alloc(NULL, 16 + 10);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+    ogs_pkbuf_reserve(pkbuf, 16);
+    ogs_pkbuf_put_data(pkbuf, "0123456789", 10);
+    copy = ogs_pkbuf_copy(pkbuf);
+    ABTS_PTR_NOTNULL(tc, copy);
+
+    p = ogs_pkbuf_to_mem(pkbuf);
+    ABTS_PTR_NOTNULL(tc, p);
+    ABTS_TRUE(tc, p != (char *)copy->data);
+    ABTS_TRUE(tc, memcmp(p, copy->data, 10) == 0);
+    ogs_free(p);
+    ogs_pkbuf_free(copy);
+}
+
 abts_suite *test_memory(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -78,6 +121,7 @@ abts_suite *test_memory(abts_suite *suite)
     abts_run_test(suite, test2_func, NULL);
     abts_run_test(suite, test3_func, NULL);
     abts_run_test(suite, test4_func, NULL);
+    abts_run_test(suite, test5_func, NULL);
 
     return suite;
 }
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#define PORT 9090
+
+#ifndef AI_PASSIVE
+#define AI_PASSIVE 1
+#endif
+
+static const char *type_name(int index)
+{
+    return index == 1 ? "request" : "response";
+}
+
+static int64_t test1_collect(void *data)
+{
+    return *(int *)data;
+}
+
+typedef struct test1_node_s {
+    int id;
+} test1_node_t;
+static OGS_POOL(test1_pool, test1_node_t);
+
+static void metrics_test1(abts_case *tc, void *data)
+{
+    ogs_metrics_t *counter, *gauge, *vector, *histogram, *collector, *pool;
+    int64_t bucket[3] = { 10, 100, 1000 };
+    test1_node_t *node[2];
+    int used = 42;
+    char *text = NULL;
+    size_t len;
+
+    counter = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "test_total", "Test counter", NULL);
+    ABTS_PTR_NOTNULL(tc, counter);
+    gauge = ogs_metrics_add(OGS_METRICS_GAUGE,
+            "test_sessions", "Test gauge", "nf=\"smf\"");
+    ABTS_PTR_NOTNULL(tc, gauge);
+    vector = ogs_metrics_add_vector(OGS_METRICS_COUNTER,
+            "test_messages_total", "Test vector", "dir=\"rx\"",
+            "type", 3, type_name);
+    ABTS_PTR_NOTNULL(tc, vector);
+    histogram = ogs_metrics_add_histogram(
+            "test_latency", "Test histogram", NULL, bucket, 3);
+    ABTS_PTR_NOTNULL(tc, histogram);
+    collector = ogs_metrics_add_collector(
+            "test_sessions", "Test gauge", "nf=\"upf\"",
+            test1_collect, &used);
+    ABTS_PTR_NOTNULL(tc, collector);
+
+    ogs_pool_init(&test1_pool, 8);
+    pool = ogs_metrics_add_pool(&test1_pool, "test1");
+    ABTS_PTR_NOTNULL(tc, pool);
+
+    ogs_metrics_inc(counter);
+    ogs_metrics_add_value(counter, 9);
+    ABTS_INT_EQUAL(tc, 10, ogs_metrics_value(counter, 0));
+
+    ogs_metrics_inc(gauge);
+    ogs_metrics_inc(gauge);
+    ogs_metrics_dec(gauge);
+    ABTS_INT_EQUAL(tc, 1, ogs_metrics_value(gauge, 0));
+
+    ogs_metrics_vector_inc(vector, 1);
+    ogs_metrics_vector_inc(vector, 1);
+    /* Out of range is ignored */
+    ogs_metrics_vector_inc(vector, 3);
+    ogs_metrics_vector_inc(vector, -1);
+    ABTS_INT_EQUAL(tc, 0, ogs_metrics_value(vector, 0));
+    ABTS_INT_EQUAL(tc, 2, ogs_metrics_value(vector, 1));
+    ABTS_INT_EQUAL(tc, 0, ogs_metrics_value(vector, 2));
+
+    ogs_metrics_observe(histogram, 5);
+    ogs_metrics_observe(histogram, 10);
+    ogs_metrics_observe(histogram, 500);
+    ogs_metrics_observe(histogram, 5000);
+
+    ABTS_INT_EQUAL(tc, 42, ogs_metrics_value(collector, 0));
+
+    ogs_pool_alloc(&test1_pool, &node[0]);
+    ogs_pool_alloc(&test1_pool, &node[1]);
+    ABTS_INT_EQUAL(tc, 2, ogs_metrics_value(pool, 0));
+    ogs_pool_free(&test1_pool, node[1]);
+    ABTS_INT_EQUAL(tc, 1, ogs_metrics_value(pool, 0));
+
+    /* NULL metric is ignored */
+    ogs_metrics_inc(NULL);
+    ogs_metrics_observe(NULL, 1);
+
+    text = ogs_metrics_export(&len);
+    ABTS_PTR_NOTNULL(tc, text);
+    ABTS_INT_EQUAL(tc, strlen(text), len);
+
+    ABTS_PTR_NOTNULL(tc, strstr(text,
+            "# HELP test_total Test counter\n"
+            "# TYPE test_total counter\n"
+            "test_total 10\n"));
+    /* Both gauges are in one family */
+    ABTS_PTR_NOTNULL(tc, strstr(text,
+            "# TYPE test_sessions gauge\n"
+            "test_sessions{nf=\"smf\"} 1\n"
+            "test_sessions{nf=\"upf\"} 42\n"));
+    ABTS_PTR_NOTNULL(tc, strstr(text,
+            "# TYPE test_messages_total counter\n"
+            "test_messages_total{dir=\"rx\",type=\"request\"} 2\n"
+            "# HELP"));
+    ABTS_PTR_NOTNULL(tc, strstr(text,
+            "# TYPE test_latency histogram\n"
+            "test_latency_bucket{le=\"10\"} 2\n"
+            "test_latency_bucket{le=\"100\"} 2\n"
+            "test_latency_bucket{le=\"1000\"} 3\n"
+            "test_latency_bucket{le=\"+Inf\"} 4\n"
+            "test_latency_sum 5515\n"
+            "test_latency_count 4\n"));
+    ABTS_PTR_NOTNULL(tc, strstr(text, "pool_used{pool=\"test1\"} 1\n"));
+    free(text);
+
+    ogs_metrics_remove(counter);
+    ogs_metrics_remove(gauge);
+    ogs_metrics_remove(vector);
+    ogs_metrics_remove(histogram);
+    ogs_metrics_remove(collector);
+    ogs_metrics_remove(pool);
+
+    ogs_pool_free(&test1_pool, node[0]);
+    ogs_pool_final(&test1_pool);
+
+    text = ogs_metrics_export(&len);
+    ABTS_PTR_EQUAL(tc, NULL, strstr(text, "test_"));
+    free(text);
+}
+
+#define TEST2_THREAD 4
+#define TEST2_LOOP 100000
+
+static ogs_metrics_t *test2_counter;
+
+static void test2_main(void *data)
+{
+    int i;
+
+    for (i = 0; i < TEST2_LOOP; i++)
+        ogs_metrics_inc(test2_counter);
+}
+
+static void metrics_test2(abts_case *tc, void *data)
+{
+    ogs_thread_t *thread[TEST2_THREAD];
+    int i;
+
+    test2_counter = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "test2_total", "Updated by many threads", NULL);
+    ABTS_PTR_NOTNULL(tc, test2_counter);
+
+    for (i = 0; i < TEST2_THREAD; i++) {
+        thread[i] = ogs_thread_create(test2_main, NULL);
+        ABTS_PTR_NOTNULL(tc, thread[i]);
+    }
+    for (i = 0; i < TEST2_THREAD; i++)
+        ogs_thread_destroy(thread[i]);
+
+    ABTS_INT_EQUAL(tc, TEST2_THREAD * TEST2_LOOP,
+            ogs_metrics_value(test2_counter, 0));
+
+    ogs_metrics_remove(test2_counter);
+}
+
+static void metrics_test3(abts_case *tc, void *data)
+{
+    int rv, i;
+    ogs_pollset_t *pollset = NULL;
+    ogs_timer_mgr_t *timer_mgr = NULL;
+    ogs_sockaddr_t *addr = NULL;
+    ogs_socknode_t *node = NULL, *client = NULL;
+    ogs_metrics_server_t *server = NULL;
+    ogs_metrics_t *counter = NULL;
+    const char *request = "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    char response[OGS_HUGE_LEN];
+    ssize_t size, len = 0;
+
+    counter = ogs_metrics_add(OGS_METRICS_COUNTER,
+            "test3_total", "Exported over HTTP", NULL);
+    ABTS_PTR_NOTNULL(tc, counter);
+    ogs_metrics_add_value(counter, 3);
+
+    pollset = ogs_pollset_create(512);
+    ABTS_PTR_NOTNULL(tc, pollset);
+    timer_mgr = ogs_timer_mgr_create(16);
+    ABTS_PTR_NOTNULL(tc, timer_mgr);
+
+    rv = ogs_getaddrinfo(&addr, AF_INET, "127.0.0.1", PORT, AI_PASSIVE);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    node = ogs_socknode_new(addr);
+    ABTS_PTR_NOTNULL(tc, node);
+    server = ogs_metrics_server_open(pollset, timer_mgr, node);
+    ABTS_PTR_NOTNULL(tc, server);
+
+    rv = ogs_getaddrinfo(&addr, AF_INET, "127.0.0.1", PORT, AI_PASSIVE);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    client = ogs_socknode_new(addr);
+    ABTS_PTR_NOTNULL(tc, client);
+    ogs_tcp_client(client);
+    ABTS_PTR_NOTNULL(tc, client->sock);
+
+    size = ogs_send(client->sock->fd, request, strlen(request), 0);
+    ABTS_INT_EQUAL(tc, strlen(request), size);
+
+    /* accept(), recv() and send() */
+    for (i = 0; i < 3; i++) {
+        rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    }
+
+    do {
+        size = ogs_recv(client->sock->fd,
+                response + len, sizeof(response) - len - 1, 0);
+        if (size > 0)
+            len += size;
+    } while (size > 0);
+    response[len] = 0;
+
+    ABTS_PTR_NOTNULL(tc, strstr(response, "HTTP/1.0 200 OK\r\n"));
+    ABTS_PTR_NOTNULL(tc, strstr(response, "\r\n\r\n# HELP"));
+    ABTS_PTR_NOTNULL(tc, strstr(response, "\ntest3_total 3\n"));
+
+    ogs_socknode_free(client);
+    ogs_metrics_server_close(server);
+    ogs_socknode_free(node);
+    ogs_timer_mgr_destroy(timer_mgr);
+    ogs_pollset_destroy(pollset);
+
+    ogs_metrics_remove(counter);
+}
+
+abts_suite *test_metrics(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, metrics_test1, NULL);
+    abts_run_test(suite, metrics_test2, NULL);
+    abts_run_test(suite, metrics_test3, NULL);
+
+    return suite;
+}
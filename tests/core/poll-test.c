@@ -653,6 +653,70 @@ static void test8_func(abts_case *tc, void *data)
     ogs_pollset_destroy(pollset);
 }
 
+#define TEST9_NUM 5
+
+static ogs_pollset_t *test9_pollset;
+static int test9_called;
+static int test9_received;
+
+static void test9_handler(short when, ogs_socket_t fd, void *data)
+{
+    char str[STRLEN];
+    ssize_t size;
+
+    test9_called++;
+
+    /* Budget of one datagram per call */
+    size = ogs_recv(fd, str, STRLEN, 0);
+    if (size <= 0)
+        return;
+
+    test9_received++;
+    ogs_pollset_continue(test9_pollset);
+}
+
+static void test9_func(abts_case *tc, void *data)
+{
+    int rv, i;
+    ssize_t size;
+    ogs_socket_t fd[2];
+    ogs_poll_t *poll = NULL;
+
+    test9_pollset = ogs_pollset_create(512);
+    ABTS_PTR_NOTNULL(tc, test9_pollset);
+
+    rv = ogs_socketpair(AF_SOCKPAIR, SOCK_DGRAM, 0, fd);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    poll = ogs_pollset_add(test9_pollset, OGS_POLLIN|OGS_POLLET,
+            fd[1], test9_handler, tc);
+    ABTS_PTR_NOTNULL(tc, poll);
+
+    for (i = 0; i < TEST9_NUM; i++) {
+        size = ogs_send(fd[0], DATASTR, strlen(DATASTR), 0);
+        ABTS_INT_EQUAL(tc, strlen(DATASTR), size);
+    }
+
+    /* No new edge after the first datagram */
+    for (i = 0; i < TEST9_NUM * 2 && test9_received < TEST9_NUM; i++) {
+        rv = ogs_pollset_poll(test9_pollset, ogs_time_from_msec(100));
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    }
+    ABTS_INT_EQUAL(tc, TEST9_NUM, test9_received);
+    ABTS_INT_EQUAL(tc, TEST9_NUM, test9_called);
+
+    /* The handler is called again only if it did not see EAGAIN */
+    rv = ogs_pollset_poll(test9_pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, TEST9_NUM, test9_received);
+
+    ogs_pollset_remove(poll);
+
+    ogs_closesocket(fd[0]);
+    ogs_closesocket(fd[1]);
+
+    ogs_pollset_destroy(test9_pollset);
+}
+
 abts_suite *test_poll(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -668,6 +732,7 @@ abts_suite *test_poll(abts_suite *suite)
     abts_run_test(suite, test6_func, NULL);
     abts_run_test(suite, test7_func, NULL);
     abts_run_test(suite, test8_func, NULL);
+    abts_run_test(suite, test9_func, NULL);
 
     return suite;
 }
@@ -228,6 +228,119 @@ static void test3_func(abts_case *tc, void *data)
     ogs_pool_final(&testpool);
 }
 
+typedef struct {
+    char buf[1000];
+} bignode_t;
+
+#define SIZE_OF_BIGPOOL (OGS_POOL_CHUNK_SIZE * 2 + 100)
+
+static OGS_POOL(bigpool, bignode_t);
+
+static void test4_func(abts_case *tc, void *data)
+{
+    static bignode_t *node[SIZE_OF_BIGPOOL];
+    bignode_t *tmp = NULL;
+    int i, index;
+
+    ogs_pool_init(&bigpool, SIZE_OF_BIGPOOL);
+    ogs_pool_set_trim(&bigpool, true);
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_grown(&bigpool));
+
+    /* Objects are added one chunk at a time */
+    ogs_pool_alloc(&bigpool, &node[0]);
+    ABTS_PTR_NOTNULL(tc, node[0]);
+    ABTS_INT_EQUAL(tc, OGS_POOL_CHUNK_SIZE, ogs_pool_grown(&bigpool));
+
+    for (i = 1; i < SIZE_OF_BIGPOOL; i++) {
+        ogs_pool_alloc(&bigpool, &node[i]);
+        ABTS_PTR_NOTNULL(tc, node[i]);
+        ABTS_INT_EQUAL(tc, i+1, ogs_pool_index(&bigpool, node[i]));
+        memset(node[i], i, sizeof(*node[i]));
+    }
+    ABTS_INT_EQUAL(tc, SIZE_OF_BIGPOOL, ogs_pool_grown(&bigpool));
+    ABTS_INT_EQUAL(tc, SIZE_OF_BIGPOOL, ogs_pool_used(&bigpool));
+    ABTS_INT_EQUAL(tc, SIZE_OF_BIGPOOL, ogs_pool_peak(&bigpool));
+
+    ogs_pool_alloc(&bigpool, &tmp);
+    ABTS_PTR_EQUAL(tc, NULL, tmp);
+
+    /* Free the whole first chunk : the memory is given back to the OS */
+    for (i = 0; i < OGS_POOL_CHUNK_SIZE; i++)
+        ogs_pool_free(&bigpool, node[i]);
+    ABTS_INT_EQUAL(tc, SIZE_OF_BIGPOOL - OGS_POOL_CHUNK_SIZE,
+            ogs_pool_used(&bigpool));
+    ABTS_INT_EQUAL(tc, SIZE_OF_BIGPOOL, ogs_pool_peak(&bigpool));
+
+    /* The index of the objects in use does not change */
+    index = OGS_POOL_CHUNK_SIZE + 10;
+    ABTS_PTR_EQUAL(tc, node[index-1], ogs_pool_find(&bigpool, index));
+    ABTS_INT_EQUAL(tc, (index-1) & 0xff, node[index-1]->buf[999] & 0xff);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_pool_find(&bigpool, 1));
+
+    for (i = 0; i < OGS_POOL_CHUNK_SIZE; i++) {
+        ogs_pool_alloc(&bigpool, &node[i]);
+        ABTS_PTR_NOTNULL(tc, node[i]);
+        memset(node[i], 0, sizeof(*node[i]));
+    }
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_avail(&bigpool));
+
+    for (i = 0; i < SIZE_OF_BIGPOOL; i++)
+        ogs_pool_free(&bigpool, node[i]);
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_used(&bigpool));
+
+    ogs_pool_final(&bigpool);
+}
+
+static void test5_func(abts_case *tc, void *data)
+{
+    static bignode_t *node[SIZE_OF_BIGPOOL];
+    bignode_t *tmp = NULL;
+    int i;
+
+    ogs_pool_init(&bigpool, SIZE_OF_BIGPOOL);
+
+    /* The objects of the previous run keep their index */
+    ogs_pool_restore(&bigpool, &node[0], 3);
+    ABTS_PTR_NOTNULL(tc, node[0]);
+    ogs_pool_restore(&bigpool, &node[1], OGS_POOL_CHUNK_SIZE + 1);
+    ABTS_PTR_NOTNULL(tc, node[1]);
+    ogs_pool_restore(&bigpool, &tmp, 3);
+    ABTS_PTR_EQUAL(tc, NULL, tmp);
+    ogs_pool_restore(&bigpool, &tmp, SIZE_OF_BIGPOOL + 1);
+    ABTS_PTR_EQUAL(tc, NULL, tmp);
+    ogs_pool_restore_done(&bigpool);
+
+    ABTS_INT_EQUAL(tc, 3, ogs_pool_index(&bigpool, node[0]));
+    ABTS_PTR_EQUAL(tc, node[0], ogs_pool_find(&bigpool, 3));
+    ABTS_PTR_EQUAL(tc, node[1],
+            ogs_pool_find(&bigpool, OGS_POOL_CHUNK_SIZE + 1));
+    ABTS_INT_EQUAL(tc, 2, ogs_pool_used(&bigpool));
+    ABTS_INT_EQUAL(tc, 2, ogs_pool_peak(&bigpool));
+
+    /* The others are allocated in the order of the index */
+    for (i = 2; i < SIZE_OF_BIGPOOL; i++) {
+        ogs_pool_alloc(&bigpool, &node[i]);
+        ABTS_PTR_NOTNULL(tc, node[i]);
+    }
+    ABTS_INT_EQUAL(tc, 1, ogs_pool_index(&bigpool, node[2]));
+    ABTS_INT_EQUAL(tc, 2, ogs_pool_index(&bigpool, node[3]));
+    ABTS_INT_EQUAL(tc, 4, ogs_pool_index(&bigpool, node[4]));
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_avail(&bigpool));
+
+    ogs_pool_alloc(&bigpool, &tmp);
+    ABTS_PTR_EQUAL(tc, NULL, tmp);
+
+    for (i = 0; i < SIZE_OF_BIGPOOL; i++)
+        ogs_pool_free(&bigpool, node[i]);
+    ABTS_INT_EQUAL(tc, 0, ogs_pool_used(&bigpool));
+
+    ogs_pool_alloc(&bigpool, &tmp);
+    ABTS_PTR_EQUAL(tc, node[0], tmp);
+    ogs_pool_free(&bigpool, tmp);
+
+    ogs_pool_final(&bigpool);
+}
+
 abts_suite *test_pool(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -235,6 +348,8 @@ abts_suite *test_pool(abts_suite *suite)
     abts_run_test(suite, test1_func, NULL);
     abts_run_test(suite, test2_func, NULL);
     abts_run_test(suite, test3_func, NULL);
+    abts_run_test(suite, test4_func, NULL);
+    abts_run_test(suite, test5_func, NULL);
 
     return suite;
 }
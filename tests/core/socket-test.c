@@ -427,6 +427,66 @@ static void test8_func(abts_case *tc, void *data)
     ABTS_INT_EQUAL(tc, OGS_OK, rv);
 }
 
+static void test9_func(abts_case *tc, void *data)
+{
+    int rv, i, n;
+    ogs_sock_t *udp, *client;
+    ogs_sockaddr_t *addr;
+    ogs_socknode_t *node;
+    ogs_pkbuf_t *pkbuf[4];
+    ogs_sockaddr_t to[3], from[4];
+    char buf[OGS_ADDRSTRLEN];
+
+    rv = ogs_getaddrinfo(&addr, AF_INET, "127.0.0.1", PORT, AI_PASSIVE);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    node = ogs_socknode_new(addr);
+    ABTS_PTR_NOTNULL(tc, node);
+    udp = ogs_udp_server(node);
+    ABTS_PTR_NOTNULL(tc, udp);
+    rv = ogs_nonblocking(udp->fd);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    client = ogs_udp_socket(AF_INET, NULL);
+    ABTS_PTR_NOTNULL(tc, client);
+
+    for (i = 0; i < 3; i++) {
+        pkbuf[i] = ogs_pkbuf_alloc(NULL, STRLEN);
+        ABTS_PTR_NOTNULL(tc, pkbuf[i]);
+        ogs_pkbuf_put_data(pkbuf[i], DATASTR, i+1);
+        memcpy(&to[i], node->addr, sizeof to[i]);
+    }
+
+    n = ogs_sendmmsg(client->fd, pkbuf, to, 3);
+    ABTS_INT_EQUAL(tc, 3, n);
+
+    for (i = 0; i < 3; i++)
+        ogs_pkbuf_free(pkbuf[i]);
+
+    for (i = 0; i < 4; i++) {
+        pkbuf[i] = ogs_pkbuf_alloc(NULL, STRLEN);
+        ABTS_PTR_NOTNULL(tc, pkbuf[i]);
+        ogs_pkbuf_put(pkbuf[i], STRLEN);
+    }
+
+    n = ogs_recvmmsg(udp->fd, pkbuf, from, 4);
+    ABTS_INT_EQUAL(tc, 3, n);
+    for (i = 0; i < n; i++) {
+        ABTS_INT_EQUAL(tc, i+1, pkbuf[i]->len);
+        ABTS_TRUE(tc, memcmp(pkbuf[i]->data, DATASTR, i+1) == 0);
+        ABTS_STR_EQUAL(tc, "127.0.0.1", OGS_ADDR(&from[i], buf));
+    }
+
+    n = ogs_recvmmsg(udp->fd, pkbuf + 3, from + 3, 1);
+    ABTS_INT_EQUAL(tc, -1, n);
+    ABTS_INT_EQUAL(tc, OGS_EAGAIN, ogs_socket_errno);
+
+    for (i = 0; i < 4; i++)
+        ogs_pkbuf_free(pkbuf[i]);
+
+    ogs_sock_destroy(client);
+    ogs_socknode_free(node);
+}
+
 abts_suite *test_socket(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -439,6 +499,7 @@ abts_suite *test_socket(abts_suite *suite)
     abts_run_test(suite, test6_func, NULL);
     abts_run_test(suite, test7_func, NULL);
     abts_run_test(suite, test8_func, NULL);
+    abts_run_test(suite, test9_func, NULL);
 
     return suite;
 }
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gtpbench.h"
+
+static gtpbench_context_t self;
+
+gtpbench_context_t *gtpbench_self(void)
+{
+    return &self;
+}
+
+const char *gtpbench_direction_name(gtpbench_direction_e direction)
+{
+    ogs_assert(direction < MAX_NUM_OF_GTPBENCH_DIRECTION);
+    return direction == GTPBENCH_UPLINK ? "uplink" : "downlink";
+}
+
+/*
+ * "64:7,576:4,1500:1" : IPv4 packet sizes with their weights.
+ *
+ * The sizes are interleaved by the smooth weighted round-robin,
+ * so a burst does not consist of packets of the same size.
+ */
+int gtpbench_parse_size_mix(char *list)
+{
+    char *item = NULL, *saveptr = NULL, *weight = NULL;
+    int current[GTPBENCH_MAX_SIZE_MIX];
+    int i, total = 0, best;
+
+    ogs_assert(list);
+
+    self.num_of_size = 0;
+    for (item = strtok_r(list, ",", &saveptr); item;
+            item = strtok_r(NULL, ",", &saveptr)) {
+        if (self.num_of_size >= GTPBENCH_MAX_SIZE_MIX) {
+            fprintf(stderr, "Too many sizes [%d]\n", GTPBENCH_MAX_SIZE_MIX);
+            return OGS_ERROR;
+        }
+
+        weight = strchr(item, ':');
+        if (weight)
+            *weight++ = 0;
+
+        self.size[self.num_of_size] = atoi(item);
+        self.weight[self.num_of_size] = weight ? atoi(weight) : 1;
+
+        if (self.size[self.num_of_size] < GTPBENCH_MIN_SIZE ||
+            self.size[self.num_of_size] > GTPBENCH_MAX_SIZE) {
+            fprintf(stderr, "Size [%s] is not in %d..%d\n",
+                    item, GTPBENCH_MIN_SIZE, GTPBENCH_MAX_SIZE);
+            return OGS_ERROR;
+        }
+        if (self.weight[self.num_of_size] <= 0) {
+            fprintf(stderr, "Invalid weight of size [%s]\n", item);
+            return OGS_ERROR;
+        }
+
+        total += self.weight[self.num_of_size];
+        self.num_of_size++;
+    }
+
+    if (!self.num_of_size) {
+        fprintf(stderr, "No packet size\n");
+        return OGS_ERROR;
+    }
+    if (total > GTPBENCH_MAX_PATTERN) {
+        fprintf(stderr, "Sum of the weights is over %d\n",
+                GTPBENCH_MAX_PATTERN);
+        return OGS_ERROR;
+    }
+
+    memset(current, 0, sizeof(current));
+    for (self.num_of_pattern = 0;
+            self.num_of_pattern < total; self.num_of_pattern++) {
+        best = 0;
+        for (i = 0; i < self.num_of_size; i++) {
+            current[i] += self.weight[i];
+            if (current[i] > current[best])
+                best = i;
+        }
+        current[best] -= total;
+        self.pattern[self.num_of_pattern] = self.size[best];
+    }
+
+    return OGS_OK;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GTPBENCH_H
+#define GTPBENCH_H
+
+#include "test-common.h"
+#include "ogs-pfcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * User-plane benchmark
+ *
+ * The tool takes the role of the SMF(SGW-C) on N4(Sxa) and installs
+ * sessions in the UPF(SGW-U) under test. Then it sends packets through
+ * the UPF(SGW-U) in both directions and measures the throughput,
+ * the latency and the loss.
+ *
+ * UPF
+ *   uplink   : GTP-U from the gNB address to the N3 F-TEID of a session.
+ *              The inner UDP packet is received on the gateway address
+ *              of the UE subnet, i.e. after it has been written to ogstun.
+ *   downlink : UDP from the gateway address to the UE IP address,
+ *              routed by the kernel into ogstun. The GTP-U packet is
+ *              received on the gNB address.
+ *
+ * SGW-U
+ *   uplink   : GTP-U from the eNB address to the S1-U F-TEID,
+ *              received as GTP-U on the PGW address.
+ *   downlink : GTP-U from the PGW address to the S5-U F-TEID,
+ *              received as GTP-U on the eNB address.
+ *
+ * Every packet carries a stamp with the sequence number and the time
+ * when it was sent, so the receiver can measure the one-way latency.
+ */
+
+#define GTPBENCH_MAGIC              0x4f475342  /* "OGSB" */
+#define GTPBENCH_UDP_PORT           5001
+
+#define GTPBENCH_MIN_SIZE           64
+#define GTPBENCH_MAX_SIZE           1500
+#define GTPBENCH_MAX_SIZE_MIX       8
+#define GTPBENCH_MAX_PATTERN        64
+
+/* Extra PDRs for the SDF filters which do not match the traffic */
+#define GTPBENCH_MAX_SDF_PDR        3
+#define GTPBENCH_MAX_SDF \
+    (GTPBENCH_MAX_SDF_PDR * OGS_MAX_NUM_OF_RULE)
+
+#define GTPBENCH_WINDOW             64      /* Outstanding N4 requests */
+#define GTPBENCH_BURST              32      /* Packets sent at once */
+
+typedef enum {
+    GTPBENCH_UPLINK = 0,
+    GTPBENCH_DOWNLINK,
+
+    MAX_NUM_OF_GTPBENCH_DIRECTION,
+} gtpbench_direction_e;
+
+typedef struct gtpbench_stamp_s {
+    uint32_t magic;
+    uint32_t index;             /* Session */
+    uint64_t seq;
+    int64_t sent;               /* ogs_get_monotonic_time() */
+} __attribute__ ((packed)) gtpbench_stamp_t;
+
+typedef struct gtpbench_stats_s {
+    uint64_t sent;
+    uint64_t sent_bytes;
+    uint64_t send_failed;       /* e.g. EAGAIN or ENOBUFS */
+
+    uint64_t received;
+    uint64_t received_bytes;
+    uint64_t invalid;           /* Not a stamp of this run */
+
+    test_histogram_t latency;
+} gtpbench_stats_t;
+
+typedef struct gtpbench_sess_s {
+    int index;
+
+    ogs_pfcp_sess_t pfcp;
+    uint64_t cp_seid;           /* index + 1 */
+    uint64_t up_seid;
+
+    ogs_pfcp_ue_ip_t *ue_ip;    /* UPF only */
+
+    ogs_pfcp_pdr_t *ul_pdr;
+    ogs_pfcp_pdr_t *dl_pdr;     /* F-TEID in SGW-U */
+
+    uint32_t ue_addr;           /* Inner IPv4 address of the UE */
+
+    /* Allocated by the UPF(SGW-U) : IPv4 only */
+    uint32_t ul_teid, ul_addr;
+    uint32_t dl_teid, dl_addr;  /* SGW-U only */
+
+    bool established;
+    bool failed;
+} gtpbench_sess_t;
+
+typedef struct gtpbench_context_s {
+    bool sgwu;                  /* SGW-U instead of UPF */
+
+    int num_of_sess;
+    int num_of_sdf;             /* SDF filters per direction */
+    bool direction[MAX_NUM_OF_GTPBENCH_DIRECTION];
+
+    int num_of_size;
+    int size[GTPBENCH_MAX_SIZE_MIX];        /* IPv4 total length */
+    int weight[GTPBENCH_MAX_SIZE_MIX];
+    int num_of_pattern;
+    int pattern[GTPBENCH_MAX_PATTERN];      /* Sizes in sending order */
+
+    int rate;                   /* Packets per second, 0 for unlimited */
+    ogs_time_t duration;
+    const char *dnn;
+
+    const char *access_addr;    /* gNB or eNB */
+    const char *core_addr;      /* PGW in SGW-U */
+    const char *metrics_addr;   /* host:port of the UPF metrics */
+
+    ogs_pfcp_node_t *node;      /* UPF(SGW-U) under test */
+    bool associated;
+
+    gtpbench_sess_t *sess;
+    int requested;
+    int responded;
+
+    int *active;                /* Index of the established sessions */
+    int num_of_active;
+
+    ogs_socknode_t *access;     /* GTP-U */
+    ogs_socknode_t *core;       /* UDP on the UE subnet, or GTP-U */
+    ogs_poll_t *access_poll;
+    ogs_poll_t *core_poll;
+    uint32_t sink_addr;         /* Inner IPv4 address of the server */
+
+    ogs_time_t start_time;
+    ogs_time_t stop_time;
+    gtpbench_stats_t stats[MAX_NUM_OF_GTPBENCH_DIRECTION];
+} gtpbench_context_t;
+
+gtpbench_context_t *gtpbench_self(void);
+
+const char *gtpbench_direction_name(gtpbench_direction_e direction);
+int gtpbench_parse_size_mix(char *list);
+
+int gtpbench_pfcp_open(void);
+void gtpbench_pfcp_close(void);
+void gtpbench_pfcp_associate(void);
+void gtpbench_sess_init(gtpbench_sess_t *sess);
+void gtpbench_sess_final(gtpbench_sess_t *sess);
+void gtpbench_sess_establish(gtpbench_sess_t *sess);
+void gtpbench_sess_delete(gtpbench_sess_t *sess);
+
+int gtpbench_traffic_open(void);
+void gtpbench_traffic_close(void);
+int gtpbench_traffic_send(gtpbench_direction_e direction, int count);
+
+char *gtpbench_metrics_scrape(const char *addr);
+void gtpbench_metrics_print(const char *before, const char *after);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GTPBENCH_H */
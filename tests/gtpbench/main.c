@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <signal.h>
+
+#include "gtpbench.h"
+
+#define DEFAULT_SIZE_MIX        "64:7,576:4,1500:1"
+
+static volatile sig_atomic_t stopped = 0;
+
+static void show_help(const char *name)
+{
+    printf("Usage: %s [options]\n"
+        "Options:\n"
+       "   -c filename    : set configuration file\n"
+       "   -l filename    : set logging file\n"
+       "   -e level       : set global log-level (default:info)\n"
+       "   -m domain      : set log-domain (e.g. mme:sgw:gtp)\n"
+       "   -s             : SGW-U instead of UPF\n"
+       "   -n number      : number of sessions (default:100)\n"
+       "   -f number      : SDF filters per direction (default:0, max:%d)\n"
+       "   -z list        : IPv4 packet sizes with weights\n"
+       "                    (default:" DEFAULT_SIZE_MIX ")\n"
+       "   -r rate        : packets per second in each direction\n"
+       "                    (default:0, as fast as possible)\n"
+       "   -t sec         : duration of the traffic (default:10)\n"
+       "   -d direction   : uplink, downlink or both (default:both)\n"
+       "   -A address     : gNB or eNB GTP-U address (default:127.0.0.2)\n"
+       "   -C address     : PGW GTP-U address with -s (default:127.0.0.3)\n"
+       "   -a dnn         : DNN of the UE subnet\n"
+       "   -M host:port   : UPF metrics server for the drops by cause\n"
+       "   -h             : show this message and exit\n"
+       "\n", name, GTPBENCH_MAX_SDF);
+}
+
+static void sig_handler(int signum)
+{
+    stopped = 1;
+}
+
+static void run_once(ogs_time_t timeout)
+{
+    ogs_timer_mgr_t *timer_mgr = ogs_app()->timer_mgr;
+    ogs_time_t next = ogs_timer_mgr_next(timer_mgr);
+
+    if (next == OGS_INFINITE_TIME || next > timeout)
+        next = timeout;
+
+    ogs_pollset_poll(ogs_app()->pollset, next);
+    ogs_timer_mgr_expire(timer_mgr);
+}
+
+static int parse_direction(const char *name)
+{
+    gtpbench_context_t *self = gtpbench_self();
+
+    if (!strcmp(name, "uplink")) {
+        self->direction[GTPBENCH_UPLINK] = true;
+    } else if (!strcmp(name, "downlink")) {
+        self->direction[GTPBENCH_DOWNLINK] = true;
+    } else if (!strcmp(name, "both")) {
+        self->direction[GTPBENCH_UPLINK] = true;
+        self->direction[GTPBENCH_DOWNLINK] = true;
+    } else {
+        fprintf(stderr, "Unknown direction [%s]\n", name);
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
+
+static void print_progress(void)
+{
+    static uint64_t last_sent[MAX_NUM_OF_GTPBENCH_DIRECTION];
+    static uint64_t last_received[MAX_NUM_OF_GTPBENCH_DIRECTION];
+    static ogs_time_t last_time;
+
+    gtpbench_context_t *self = gtpbench_self();
+    gtpbench_stats_t *stats = NULL;
+    ogs_time_t now = ogs_get_monotonic_time();
+    double elapsed;
+    int i;
+
+    if (!last_time)
+        last_time = self->start_time;
+    elapsed = (now - last_time) / 1000000.0;
+    if (elapsed <= 0)
+        return;
+
+    printf("[%6.1fs]", (now - self->start_time) / 1000000.0);
+    for (i = 0; i < MAX_NUM_OF_GTPBENCH_DIRECTION; i++) {
+        if (!self->direction[i])
+            continue;
+
+        stats = &self->stats[i];
+        printf(" %s tx %.3f rx %.3f Mpps", gtpbench_direction_name(i),
+                (stats->sent - last_sent[i]) / elapsed / 1000000.0,
+                (stats->received - last_received[i]) / elapsed / 1000000.0);
+
+        last_sent[i] = stats->sent;
+        last_received[i] = stats->received;
+    }
+    printf("\n");
+    fflush(stdout);
+
+    last_time = now;
+}
+
+static void print_report(const char *size_mix)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    gtpbench_stats_t *stats = NULL;
+    double elapsed;
+    uint64_t lost;
+    int i;
+
+    elapsed = (self->stop_time - self->start_time) / 1000000.0;
+
+    printf("\n%s, %d sessions, %d SDF filters, sizes %s, %.1f seconds\n",
+            self->sgwu ? "SGW-U" : "UPF", self->num_of_active,
+            self->num_of_sdf, size_mix, elapsed);
+    printf("%-9s %11s %11s %9s %7s %8s %8s %9s "
+            "%7s %7s %7s %9s %8s\n",
+            "direction", "sent", "received", "lost", "loss(%)",
+            "tx(Mpps)", "rx(Mpps)", "rx(Mbps)",
+            "p50(us)", "p90(us)", "p99(us)", "p99.9(us)", "max(us)");
+
+    for (i = 0; i < MAX_NUM_OF_GTPBENCH_DIRECTION; i++) {
+        if (!self->direction[i])
+            continue;
+
+        stats = &self->stats[i];
+        lost = stats->sent > stats->received ?
+            stats->sent - stats->received : 0;
+
+        printf("%-9s %11llu %11llu %9llu %7.3f %8.3f %8.3f %9.1f "
+                "%7lld %7lld %7lld %9lld %8lld\n",
+                gtpbench_direction_name(i),
+                (unsigned long long)stats->sent,
+                (unsigned long long)stats->received,
+                (unsigned long long)lost,
+                stats->sent ? lost * 100.0 / stats->sent : 0,
+                elapsed > 0 ? stats->sent / elapsed / 1000000.0 : 0,
+                elapsed > 0 ? stats->received / elapsed / 1000000.0 : 0,
+                elapsed > 0 ?
+                    stats->received_bytes * 8 / elapsed / 1000000.0 : 0,
+                (long long)test_histogram_percentile(&stats->latency, 50),
+                (long long)test_histogram_percentile(&stats->latency, 90),
+                (long long)test_histogram_percentile(&stats->latency, 99),
+                (long long)test_histogram_percentile(&stats->latency, 99.9),
+                (long long)stats->latency.max);
+
+        if (stats->send_failed || stats->invalid)
+            printf("%-9s send failed %llu, invalid received %llu\n", "",
+                    (unsigned long long)stats->send_failed,
+                    (unsigned long long)stats->invalid);
+    }
+}
+
+static int gtpbench_initialize(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    int i, rv;
+
+    ogs_gtp_context_init(OGS_MAX_NUM_OF_GTPU_RESOURCE);
+    ogs_pfcp_context_init();
+
+    rv = ogs_pfcp_xact_init();
+    if (rv != OGS_OK) return rv;
+
+    /* Take the place of the SMF(SGW-C) in the configuration */
+    if (self->sgwu)
+        rv = ogs_pfcp_context_parse_config("sgwc", "sgwu");
+    else
+        rv = ogs_pfcp_context_parse_config("smf", "upf");
+    if (rv != OGS_OK) return rv;
+
+    if (!self->sgwu) {
+        rv = ogs_pfcp_ue_pool_generate();
+        if (rv != OGS_OK) return rv;
+    }
+
+    rv = gtpbench_pfcp_open();
+    if (rv != OGS_OK) return rv;
+    rv = gtpbench_traffic_open();
+    if (rv != OGS_OK) return rv;
+
+    self->sess = ogs_calloc(self->num_of_sess, sizeof(gtpbench_sess_t));
+    ogs_assert(self->sess);
+    self->active = ogs_calloc(self->num_of_sess, sizeof(int));
+    ogs_assert(self->active);
+
+    for (i = 0; i < self->num_of_sess; i++) {
+        self->sess[i].index = i;
+        gtpbench_sess_init(&self->sess[i]);
+    }
+
+    return OGS_OK;
+}
+
+static void gtpbench_terminate(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    int i;
+
+    if (self->sess) {
+        for (i = 0; i < self->num_of_sess; i++)
+            gtpbench_sess_final(&self->sess[i]);
+        ogs_free(self->sess);
+    }
+    if (self->active)
+        ogs_free(self->active);
+
+    gtpbench_traffic_close();
+    gtpbench_pfcp_close();
+
+    ogs_pfcp_context_final();
+    ogs_gtp_context_final();
+    ogs_pfcp_xact_final();
+}
+
+/* Send N4 requests with at most GTPBENCH_WINDOW outstanding */
+static void run_sessions(void (*request)(gtpbench_sess_t *sess))
+{
+    gtpbench_context_t *self = gtpbench_self();
+    int i = 0;
+
+    self->requested = self->responded = 0;
+
+    while (!stopped) {
+        while (i < self->num_of_sess &&
+                self->requested - self->responded < GTPBENCH_WINDOW) {
+            request(&self->sess[i++]);
+        }
+        if (i == self->num_of_sess && self->responded == self->requested)
+            break;
+
+        run_once(ogs_time_from_msec(100));
+    }
+}
+
+static int establish(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_time_t start, deadline;
+    double elapsed;
+    int i;
+
+    gtpbench_pfcp_associate();
+
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(5);
+    while (!stopped && !self->associated) {
+        if (ogs_get_monotonic_time() > deadline) {
+            ogs_fatal("No PFCP association with the %s",
+                    self->sgwu ? "SGW-U" : "UPF");
+            return OGS_ERROR;
+        }
+        run_once(ogs_time_from_msec(100));
+    }
+
+    start = ogs_get_monotonic_time();
+    run_sessions(gtpbench_sess_establish);
+    elapsed = (ogs_get_monotonic_time() - start) / 1000000.0;
+
+    for (i = 0; i < self->num_of_sess; i++)
+        if (self->sess[i].established)
+            self->active[self->num_of_active++] = i;
+
+    printf("%d sessions established in %.2f seconds (%.1f/s), %d failed\n",
+            self->num_of_active, elapsed,
+            elapsed > 0 ? self->num_of_active / elapsed : 0,
+            self->num_of_sess - self->num_of_active);
+
+    if (!self->num_of_active)
+        return OGS_ERROR;
+
+    return OGS_OK;
+}
+
+static void send_traffic(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    gtpbench_stats_t *stats = NULL;
+    ogs_time_t now, end, last_progress, timeout;
+    int64_t due;
+    int i;
+
+    self->start_time = last_progress = ogs_get_monotonic_time();
+    end = self->start_time + self->duration;
+
+    for (now = self->start_time; !stopped && now < end;
+            now = ogs_get_monotonic_time()) {
+        timeout = self->rate ? ogs_max(1000000 / self->rate, 1) : 0;
+
+        for (i = 0; i < MAX_NUM_OF_GTPBENCH_DIRECTION; i++) {
+            if (!self->direction[i])
+                continue;
+
+            stats = &self->stats[i];
+            due = GTPBENCH_BURST;
+            if (self->rate) {
+                /* Packets due from the start time at the fixed rate */
+                due = (now - self->start_time) * self->rate / 1000000 + 1 -
+                    (int64_t)(stats->sent + stats->send_failed);
+                due = ogs_min(due, GTPBENCH_BURST);
+            }
+            if (due <= 0)
+                continue;
+
+            if (gtpbench_traffic_send(i, (int)due) == GTPBENCH_BURST)
+                timeout = 0;
+        }
+
+        if (now - last_progress >= ogs_time_from_sec(1)) {
+            print_progress();
+            last_progress = now;
+        }
+
+        run_once(timeout);
+    }
+
+    self->stop_time = ogs_get_monotonic_time();
+
+    /* Packets in flight */
+    end = self->stop_time + ogs_time_from_sec(1);
+    while (!stopped && ogs_get_monotonic_time() < end)
+        run_once(ogs_time_from_msec(10));
+}
+
+static void gtpbench_run(const char *size_mix)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    char *before = NULL, *after = NULL;
+
+    if (establish() == OGS_OK) {
+        if (self->metrics_addr)
+            before = gtpbench_metrics_scrape(self->metrics_addr);
+
+        send_traffic();
+        print_report(size_mix);
+
+        if (before) {
+            after = gtpbench_metrics_scrape(self->metrics_addr);
+            if (after) {
+                gtpbench_metrics_print(before, after);
+                ogs_free(after);
+            }
+            ogs_free(before);
+        }
+    }
+
+    /* Leave the UPF(SGW-U) as it was. A second signal skips it */
+    stopped = 0;
+    run_sessions(gtpbench_sess_delete);
+}
+
+int main(int argc, const char *const argv[])
+{
+    gtpbench_context_t *self = gtpbench_self();
+    int rv, i, opt;
+    ogs_getopt_t options;
+    const char *size_mix = DEFAULT_SIZE_MIX;
+    const char *direction = "both";
+    const char *argv_out[argc+1];
+
+    memset(self, 0, sizeof(*self));
+    self->num_of_sess = 100;
+    self->duration = ogs_time_from_sec(10);
+    self->access_addr = "127.0.0.2";
+    self->core_addr = "127.0.0.3";
+
+    i = 0;
+    argv_out[i++] = argv[0];
+
+    ogs_getopt_init(&options, (char**)argv);
+    while ((opt = ogs_getopt(&options,
+                    "hsc:l:e:m:n:f:z:r:t:d:A:C:a:M:")) != -1) {
+        switch (opt) {
+        case 'h':
+            show_help(argv[0]);
+            return OGS_OK;
+        case 'c':
+            argv_out[i++] = "-c";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'l':
+            argv_out[i++] = "-l";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'e':
+            argv_out[i++] = "-e";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'm':
+            argv_out[i++] = "-m";
+            argv_out[i++] = options.optarg;
+            break;
+        case 's':
+            self->sgwu = true;
+            break;
+        case 'n':
+            self->num_of_sess = atoi(options.optarg);
+            break;
+        case 'f':
+            self->num_of_sdf = atoi(options.optarg);
+            break;
+        case 'z':
+            size_mix = options.optarg;
+            break;
+        case 'r':
+            self->rate = atoi(options.optarg);
+            break;
+        case 't':
+            self->duration = ogs_time_from_sec(atoi(options.optarg));
+            break;
+        case 'd':
+            direction = options.optarg;
+            break;
+        case 'A':
+            self->access_addr = options.optarg;
+            break;
+        case 'C':
+            self->core_addr = options.optarg;
+            break;
+        case 'a':
+            self->dnn = options.optarg;
+            break;
+        case 'M':
+            self->metrics_addr = options.optarg;
+            break;
+        case '?':
+            fprintf(stderr, "%s: %s\n", argv[0], options.errmsg);
+            show_help(argv[0]);
+            return OGS_ERROR;
+        default:
+            fprintf(stderr, "%s: should not be reached\n", OGS_FUNC);
+            return OGS_ERROR;
+        }
+    }
+    argv_out[i] = NULL;
+
+    if (self->num_of_sess <= 0 || self->rate < 0 || self->duration <= 0 ||
+        self->num_of_sdf < 0 || self->num_of_sdf > GTPBENCH_MAX_SDF) {
+        show_help(argv[0]);
+        return OGS_ERROR;
+    }
+    if (self->sgwu && self->num_of_sdf) {
+        fprintf(stderr, "No SDF filter in the SGW-U\n");
+        return OGS_ERROR;
+    }
+
+    rv = parse_direction(direction);
+    if (rv != OGS_OK) return rv;
+
+    {
+        char list[256];
+        ogs_cpystrn(list, size_mix, sizeof(list));
+        rv = gtpbench_parse_size_mix(list);
+        if (rv != OGS_OK) return rv;
+    }
+
+    rv = ogs_app_initialize(NULL, DEFAULT_CONFIG_FILENAME, argv_out);
+    if (rv != OGS_OK) {
+        ogs_fatal("User-plane benchmark initialization failed. Aborted");
+        return rv;
+    }
+
+    if ((uint64_t)self->num_of_sess > ogs_app()->pool.sess) {
+        ogs_fatal("Too many sessions [%d > pool.sess:%d]",
+                self->num_of_sess, (int)ogs_app()->pool.sess);
+        ogs_app_terminate();
+        return OGS_ERROR;
+    }
+
+    rv = gtpbench_initialize();
+    if (rv == OGS_OK) {
+        signal(SIGINT, sig_handler);
+        signal(SIGTERM, sig_handler);
+
+        gtpbench_run(size_mix);
+    }
+
+    gtpbench_terminate();
+    ogs_app_terminate();
+
+    return rv;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gtpbench.h"
+
+#define METRICS_MAX_LEN         (512 * 1024)
+#define METRICS_DROPPED         "upf_dropped_packets_total"
+
+/*
+ * Fetch the text exposition from the metrics server of the UPF.
+ * 'addr' is "host:port". The caller frees the result with ogs_free().
+ */
+char *gtpbench_metrics_scrape(const char *addr)
+{
+    char *host = NULL, *port = NULL, *buf = NULL, *body = NULL;
+    ogs_sockaddr_t *sa_list = NULL;
+    ogs_socket_t fd = INVALID_SOCKET;
+    const char *request = "GET /metrics HTTP/1.0\r\n\r\n";
+    ssize_t size;
+    size_t len = 0;
+    int rv;
+
+    ogs_assert(addr);
+
+    host = ogs_strdup(addr);
+    ogs_assert(host);
+    port = strrchr(host, ':');
+    if (!port) {
+        ogs_error("Invalid metrics address [%s]", addr);
+        goto cleanup;
+    }
+    *port++ = 0;
+
+    rv = ogs_getaddrinfo(&sa_list, AF_UNSPEC, host, atoi(port), 0);
+    if (rv != OGS_OK) {
+        ogs_error("Invalid metrics address [%s]", addr);
+        goto cleanup;
+    }
+
+    fd = socket(sa_list->ogs_sa_family, SOCK_STREAM, IPPROTO_TCP);
+    if (fd == INVALID_SOCKET ||
+        connect(fd, &sa_list->sa, ogs_sockaddr_len(sa_list)) != 0 ||
+        send(fd, request, strlen(request), 0) != (ssize_t)strlen(request)) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                "Cannot get the metrics from [%s]", addr);
+        goto cleanup;
+    }
+
+    buf = ogs_malloc(METRICS_MAX_LEN);
+    ogs_assert(buf);
+    while (len < METRICS_MAX_LEN - 1) {
+        size = recv(fd, buf + len, METRICS_MAX_LEN - 1 - len, 0);
+        if (size <= 0)
+            break;
+        len += size;
+    }
+    buf[len] = 0;
+
+    body = strstr(buf, "\r\n\r\n");
+    if (!body || strncmp(buf, "HTTP/1.", 7) || !strstr(buf, " 200 ")) {
+        ogs_error("Invalid metrics response from [%s]", addr);
+        body = NULL;
+        goto cleanup;
+    }
+    body = ogs_strdup(body + 4);
+    ogs_assert(body);
+
+cleanup:
+    if (buf)
+        ogs_free(buf);
+    if (fd != INVALID_SOCKET)
+        ogs_closesocket(fd);
+    if (sa_list)
+        ogs_freeaddrinfo(sa_list);
+    ogs_free(host);
+
+    return body;
+}
+
+static long long metrics_value(const char *text, const char *key)
+{
+    const char *p = text;
+    size_t len = strlen(key);
+
+    while (p && *p) {
+        if (strncmp(p, key, len) == 0 && p[len] == ' ')
+            return atoll(p + len + 1);
+        p = strchr(p, '\n');
+        if (p) p++;
+    }
+
+    return 0;
+}
+
+/* Increase of the dropped packets of the UPF between two scrapes */
+void gtpbench_metrics_print(const char *before, const char *after)
+{
+    char *text = NULL, *line = NULL, *saveptr = NULL, *value = NULL;
+    long long delta;
+    int printed = 0;
+
+    ogs_assert(before);
+    ogs_assert(after);
+
+    text = ogs_strdup(after);
+    ogs_assert(text);
+
+    printf("\nUPF drops during the run\n");
+    for (line = strtok_r(text, "\n", &saveptr); line;
+            line = strtok_r(NULL, "\n", &saveptr)) {
+        if (strncmp(line, METRICS_DROPPED, strlen(METRICS_DROPPED)) != 0)
+            continue;
+
+        value = strrchr(line, ' ');
+        if (!value)
+            continue;
+        *value++ = 0;
+
+        delta = atoll(value) - metrics_value(before, line);
+        if (delta) {
+            printf("  %-56s %12lld\n", line, delta);
+            printed++;
+        }
+    }
+    if (!printed)
+        printf("  none\n");
+
+    ogs_free(text);
+}
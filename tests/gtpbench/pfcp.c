@@ -0,0 +1,626 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gtpbench.h"
+
+static gtpbench_sess_t *sess_find_by_seid(uint64_t seid)
+{
+    gtpbench_context_t *self = gtpbench_self();
+
+    if (seid == 0 || seid > (uint64_t)self->num_of_sess)
+        return NULL;
+
+    return &self->sess[seid-1];
+}
+
+static void handle_session_establishment_response(
+        gtpbench_sess_t *sess, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_session_establishment_response_t *rsp)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_pfcp_f_seid_t *up_f_seid = NULL;
+    uint8_t cause_value = OGS_PFCP_CAUSE_REQUEST_ACCEPTED;
+    uint8_t offending_ie_value = 0;
+    int i;
+
+    ogs_assert(xact);
+    ogs_assert(rsp);
+
+    ogs_pfcp_xact_commit(xact);
+    self->responded++;
+
+    if (!sess) {
+        ogs_error("No Context");
+        return;
+    }
+
+    if (!rsp->cause.presence ||
+        rsp->cause.u8 != OGS_PFCP_CAUSE_REQUEST_ACCEPTED) {
+        ogs_error("[%d] Session establishment rejected [%d]",
+                sess->index, rsp->cause.presence ? rsp->cause.u8 : 0);
+        sess->failed = true;
+        return;
+    }
+
+    if (!rsp->up_f_seid.presence) {
+        ogs_error("[%d] No UP F-SEID", sess->index);
+        sess->failed = true;
+        return;
+    }
+    up_f_seid = rsp->up_f_seid.data;
+    ogs_assert(up_f_seid);
+    sess->up_seid = be64toh(up_f_seid->seid);
+
+    for (i = 0; i < (int)OGS_ARRAY_SIZE(rsp->created_pdr); i++) {
+        ogs_pfcp_handle_created_pdr(&sess->pfcp, &rsp->created_pdr[i],
+                &cause_value, &offending_ie_value);
+        if (cause_value != OGS_PFCP_CAUSE_REQUEST_ACCEPTED) {
+            ogs_error("[%d] Invalid Created PDR", sess->index);
+            sess->failed = true;
+            return;
+        }
+    }
+
+    /* Only an IPv4 GTP-U endpoint is supported */
+    if (!sess->ul_pdr->f_teid.ipv4 ||
+        (self->sgwu && !sess->dl_pdr->f_teid.ipv4)) {
+        ogs_error("[%d] No IPv4 F-TEID in Created PDR", sess->index);
+        sess->failed = true;
+        return;
+    }
+
+    sess->ul_teid = sess->ul_pdr->f_teid.teid;
+    sess->ul_addr = sess->ul_pdr->f_teid.addr;
+    if (self->sgwu) {
+        sess->dl_teid = sess->dl_pdr->f_teid.teid;
+        sess->dl_addr = sess->dl_pdr->f_teid.addr;
+    }
+
+    sess->established = true;
+}
+
+static void handle_session_deletion_response(
+        gtpbench_sess_t *sess, ogs_pfcp_xact_t *xact,
+        ogs_pfcp_session_deletion_response_t *rsp)
+{
+    ogs_assert(xact);
+    ogs_assert(rsp);
+
+    ogs_pfcp_xact_commit(xact);
+    gtpbench_self()->responded++;
+
+    if (!sess) {
+        ogs_error("No Context");
+        return;
+    }
+
+    if (!rsp->cause.presence ||
+        rsp->cause.u8 != OGS_PFCP_CAUSE_REQUEST_ACCEPTED) {
+        ogs_error("[%d] Session deletion rejected [%d]",
+                sess->index, rsp->cause.presence ? rsp->cause.u8 : 0);
+        sess->failed = true;
+    }
+
+    sess->established = false;
+}
+
+static void pfcp_recv_cb(short when, ogs_socket_t fd, void *data)
+{
+    gtpbench_context_t *self = gtpbench_self();
+
+    ssize_t size;
+    ogs_pkbuf_t *pkbuf = NULL;
+    ogs_sockaddr_t from;
+    ogs_pfcp_node_t *node = NULL;
+    ogs_pfcp_message_t message;
+    ogs_pfcp_xact_t *xact = NULL;
+    gtpbench_sess_t *sess = NULL;
+
+    ogs_assert(fd != INVALID_SOCKET);
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN);
+
+    size = ogs_recvfrom(fd, pkbuf->data, pkbuf->len, 0, &from);
+    if (size <= 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                "ogs_recvfrom() failed");
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    ogs_pkbuf_trim(pkbuf, size);
+
+    node = ogs_pfcp_node_find(&ogs_pfcp_self()->pfcp_peer_list, &from);
+    if (!node) {
+        ogs_error("Unknown PFCP peer");
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    if (ogs_pfcp_parse_msg(&message, pkbuf) != OGS_OK) {
+        ogs_error("ogs_pfcp_parse_msg() failed");
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    if (ogs_pfcp_xact_receive(node, &message.h, &xact) != OGS_OK) {
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    if (message.h.seid_presence)
+        sess = sess_find_by_seid(message.h.seid);
+
+    switch (message.h.type) {
+    case OGS_PFCP_HEARTBEAT_REQUEST_TYPE:
+        ogs_pfcp_handle_heartbeat_request(
+                node, xact, &message.pfcp_heartbeat_request);
+        break;
+    case OGS_PFCP_HEARTBEAT_RESPONSE_TYPE:
+        ogs_pfcp_xact_commit(xact);
+        break;
+    case OGS_PFCP_ASSOCIATION_SETUP_REQUEST_TYPE:
+        ogs_pfcp_cp_handle_association_setup_request(
+                node, xact, &message.pfcp_association_setup_request);
+        self->associated = true;
+        break;
+    case OGS_PFCP_ASSOCIATION_SETUP_RESPONSE_TYPE:
+        ogs_pfcp_cp_handle_association_setup_response(
+                node, xact, &message.pfcp_association_setup_response);
+        if (message.pfcp_association_setup_response.cause.presence &&
+            message.pfcp_association_setup_response.cause.u8 ==
+                OGS_PFCP_CAUSE_REQUEST_ACCEPTED)
+            self->associated = true;
+        break;
+    case OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE:
+        handle_session_establishment_response(
+                sess, xact, &message.pfcp_session_establishment_response);
+        break;
+    case OGS_PFCP_SESSION_DELETION_RESPONSE_TYPE:
+        handle_session_deletion_response(
+                sess, xact, &message.pfcp_session_deletion_response);
+        break;
+    default:
+        /* e.g. Session Report Request, which is not expected here */
+        ogs_warn("Not handled PFCP message [type:%d]", message.h.type);
+        break;
+    }
+
+    ogs_pkbuf_free(pkbuf);
+}
+
+int gtpbench_pfcp_open(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_socknode_t *node = NULL;
+    ogs_sock_t *sock = NULL;
+    int rv;
+
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_list, node) {
+        sock = ogs_pfcp_server(node);
+        if (!sock) return OGS_ERROR;
+
+        node->poll = ogs_pollset_add(ogs_app()->pollset,
+                OGS_POLLIN, sock->fd, pfcp_recv_cb, sock);
+        ogs_assert(node->poll);
+    }
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_list6, node) {
+        sock = ogs_pfcp_server(node);
+        if (!sock) return OGS_ERROR;
+
+        node->poll = ogs_pollset_add(ogs_app()->pollset,
+                OGS_POLLIN, sock->fd, pfcp_recv_cb, sock);
+        ogs_assert(node->poll);
+    }
+
+    ogs_pfcp_self()->pfcp_sock =
+        ogs_socknode_sock_first(&ogs_pfcp_self()->pfcp_list);
+    ogs_pfcp_self()->pfcp_sock6 =
+        ogs_socknode_sock_first(&ogs_pfcp_self()->pfcp_list6);
+    if (ogs_pfcp_self()->pfcp_sock)
+        ogs_pfcp_self()->pfcp_addr =
+            &ogs_pfcp_self()->pfcp_sock->local_addr;
+    if (ogs_pfcp_self()->pfcp_sock6)
+        ogs_pfcp_self()->pfcp_addr6 =
+            &ogs_pfcp_self()->pfcp_sock6->local_addr;
+
+    if (!ogs_pfcp_self()->pfcp_addr && !ogs_pfcp_self()->pfcp_addr6) {
+        ogs_error("No PFCP address");
+        return OGS_ERROR;
+    }
+
+    /* The first peer in the configuration is the node under test */
+    self->node = ogs_list_first(&ogs_pfcp_self()->pfcp_peer_list);
+    if (!self->node) {
+        ogs_error("No %s in the configuration", self->sgwu ? "sgwu" : "upf");
+        return OGS_ERROR;
+    }
+
+    rv = ogs_pfcp_connect(ogs_pfcp_self()->pfcp_sock,
+            ogs_pfcp_self()->pfcp_sock6, self->node);
+    if (rv != OGS_OK) return rv;
+
+    return OGS_OK;
+}
+
+void gtpbench_pfcp_close(void)
+{
+    ogs_pfcp_node_t *node = NULL;
+
+    ogs_list_for_each(&ogs_pfcp_self()->pfcp_peer_list, node)
+        ogs_pfcp_xact_delete_all(node);
+
+    ogs_socknode_remove_all(&ogs_pfcp_self()->pfcp_list);
+    ogs_socknode_remove_all(&ogs_pfcp_self()->pfcp_list6);
+}
+
+static void association_timeout(ogs_pfcp_xact_t *xact, void *data)
+{
+    ogs_error("No PFCP association setup response");
+}
+
+void gtpbench_pfcp_associate(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+
+    ogs_assert(self->node);
+    ogs_pfcp_cp_send_association_setup_request(
+            self->node, association_timeout);
+}
+
+static void sess_timeout(ogs_pfcp_xact_t *xact, void *data)
+{
+    gtpbench_sess_t *sess = data;
+
+    ogs_assert(xact);
+    ogs_assert(sess);
+
+    ogs_error("[%d] No PFCP response [type:%d]",
+            sess->index, xact->seq[0].type);
+
+    sess->failed = true;
+    gtpbench_self()->responded++;
+}
+
+static ogs_pfcp_pdr_t *sdf_pdr_add(gtpbench_sess_t *sess,
+        ogs_pfcp_interface_t src_if, ogs_pfcp_far_t *far,
+        int precedence, int *filter)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_pfcp_pdr_t *pdr = NULL;
+    char addr[OGS_ADDRSTRLEN];
+
+    pdr = ogs_pfcp_pdr_add(&sess->pfcp);
+    ogs_assert(pdr);
+
+    pdr->src_if = src_if;
+    pdr->precedence = precedence;
+    if (self->dnn)
+        pdr->dnn = ogs_strdup(self->dnn);
+
+    /*
+     * The filters are written for the downlink direction, and the UPF
+     * swaps them for the uplink. The port never matches the traffic,
+     * so every packet is checked against all the filters.
+     */
+    ogs_assert(inet_ntop(AF_INET, &self->sink_addr, addr, sizeof(addr)));
+    while (*filter < self->num_of_sdf &&
+            pdr->num_of_flow < OGS_MAX_NUM_OF_RULE) {
+        pdr->flow_description[pdr->num_of_flow++] = ogs_msprintf(
+                "permit out udp from %s %d to assigned",
+                addr, GTPBENCH_UDP_PORT + 1 + *filter);
+        (*filter)++;
+    }
+
+    ogs_pfcp_pdr_associate_far(pdr, far);
+
+    return pdr;
+}
+
+static void upf_sess_init(gtpbench_sess_t *sess)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_pfcp_far_t *ul_far = NULL, *dl_far = NULL;
+    ogs_pfcp_pdr_t *pdr = NULL;
+    uint8_t addr[OGS_IPV6_LEN];
+    ogs_ip_t ip;
+    int i, filter;
+
+    memset(addr, 0, sizeof(addr));
+    sess->ue_ip = ogs_pfcp_ue_ip_alloc(AF_INET, self->dnn, addr);
+    ogs_assert(sess->ue_ip);
+    sess->ue_addr = sess->ue_ip->addr[0];
+
+    ul_far = ogs_pfcp_far_add(&sess->pfcp);
+    ogs_assert(ul_far);
+    ul_far->dst_if = OGS_PFCP_INTERFACE_CORE;
+    ul_far->apply_action = OGS_PFCP_APPLY_ACTION_FORW;
+
+    dl_far = ogs_pfcp_far_add(&sess->pfcp);
+    ogs_assert(dl_far);
+    dl_far->dst_if = OGS_PFCP_INTERFACE_ACCESS;
+    dl_far->apply_action = OGS_PFCP_APPLY_ACTION_FORW;
+
+    memset(&ip, 0, sizeof(ip));
+    ip.ipv4 = 1;
+    ip.addr = self->access->addr->sin.sin_addr.s_addr;
+    ogs_pfcp_ip_to_outer_header_creation(&ip,
+            &dl_far->outer_header_creation,
+            &dl_far->outer_header_creation_len);
+    dl_far->outer_header_creation.teid = sess->index + 1;
+
+    /* Uplink and Downlink PDRs with the SDF filters come first */
+    for (i = 0, filter = 0; filter < self->num_of_sdf; i++) {
+        int from = filter;
+
+        sdf_pdr_add(sess, OGS_PFCP_INTERFACE_CORE, dl_far, i + 1, &filter);
+
+        filter = from;
+        pdr = sdf_pdr_add(sess, OGS_PFCP_INTERFACE_ACCESS, ul_far,
+                i + 1, &filter);
+        pdr->qfi = 1;
+        pdr->f_teid.ch = 1;
+        pdr->f_teid.chid = 1;
+        pdr->f_teid.choose_id = OGS_PFCP_DEFAULT_CHOOSE_ID;
+        pdr->f_teid_len = 2;
+        pdr->outer_header_removal_len = 1;
+        pdr->outer_header_removal.description =
+            OGS_PFCP_OUTER_HEADER_REMOVAL_GTPU_UDP_IPV4;
+    }
+
+    sess->dl_pdr = ogs_pfcp_pdr_add(&sess->pfcp);
+    ogs_assert(sess->dl_pdr);
+    sess->dl_pdr->src_if = OGS_PFCP_INTERFACE_CORE;
+    sess->dl_pdr->precedence = 0xffff;
+    if (self->dnn)
+        sess->dl_pdr->dnn = ogs_strdup(self->dnn);
+    sess->dl_pdr->ue_ip_addr.ipv4 = 1;
+    sess->dl_pdr->ue_ip_addr.sd = OGS_PFCP_UE_IP_DST;
+    memcpy(&sess->dl_pdr->ue_ip_addr.addr, sess->ue_ip->addr, OGS_IPV4_LEN);
+    sess->dl_pdr->ue_ip_addr_len = OGS_IPV4_LEN + 1;
+    ogs_pfcp_pdr_associate_far(sess->dl_pdr, dl_far);
+
+    sess->ul_pdr = ogs_pfcp_pdr_add(&sess->pfcp);
+    ogs_assert(sess->ul_pdr);
+    sess->ul_pdr->src_if = OGS_PFCP_INTERFACE_ACCESS;
+    sess->ul_pdr->precedence = 0xffff;
+    if (self->dnn)
+        sess->ul_pdr->dnn = ogs_strdup(self->dnn);
+    sess->ul_pdr->qfi = 1;
+    sess->ul_pdr->f_teid.ch = 1;
+    sess->ul_pdr->f_teid.chid = 1;
+    sess->ul_pdr->f_teid.choose_id = OGS_PFCP_DEFAULT_CHOOSE_ID;
+    sess->ul_pdr->f_teid_len = 2;
+    sess->ul_pdr->outer_header_removal_len = 1;
+    sess->ul_pdr->outer_header_removal.description =
+        OGS_PFCP_OUTER_HEADER_REMOVAL_GTPU_UDP_IPV4;
+    ogs_pfcp_pdr_associate_far(sess->ul_pdr, ul_far);
+}
+
+static void sgwu_sess_init(gtpbench_sess_t *sess)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_pfcp_far_t *ul_far = NULL, *dl_far = NULL;
+    ogs_ip_t ip;
+
+    /* Not routed anywhere, since the SGW-U does not look inside */
+    sess->ue_addr = htobe32(be32toh(self->sink_addr) + 1 + sess->index);
+
+    memset(&ip, 0, sizeof(ip));
+    ip.ipv4 = 1;
+
+    ul_far = ogs_pfcp_far_add(&sess->pfcp);
+    ogs_assert(ul_far);
+    ul_far->dst_if = OGS_PFCP_INTERFACE_CORE;
+    ul_far->apply_action = OGS_PFCP_APPLY_ACTION_FORW;
+    ip.addr = self->core->addr->sin.sin_addr.s_addr;
+    ogs_pfcp_ip_to_outer_header_creation(&ip,
+            &ul_far->outer_header_creation,
+            &ul_far->outer_header_creation_len);
+    ul_far->outer_header_creation.teid = sess->index + 1;
+
+    dl_far = ogs_pfcp_far_add(&sess->pfcp);
+    ogs_assert(dl_far);
+    dl_far->dst_if = OGS_PFCP_INTERFACE_ACCESS;
+    dl_far->apply_action = OGS_PFCP_APPLY_ACTION_FORW;
+    ip.addr = self->access->addr->sin.sin_addr.s_addr;
+    ogs_pfcp_ip_to_outer_header_creation(&ip,
+            &dl_far->outer_header_creation,
+            &dl_far->outer_header_creation_len);
+    dl_far->outer_header_creation.teid = sess->index + 1;
+
+    sess->ul_pdr = ogs_pfcp_pdr_add(&sess->pfcp);
+    ogs_assert(sess->ul_pdr);
+    sess->ul_pdr->src_if = OGS_PFCP_INTERFACE_ACCESS;
+    sess->ul_pdr->f_teid.ch = 1;
+    sess->ul_pdr->f_teid_len = 1;
+    sess->ul_pdr->outer_header_removal_len = 1;
+    sess->ul_pdr->outer_header_removal.description =
+        OGS_PFCP_OUTER_HEADER_REMOVAL_GTPU_UDP_IPV4;
+    ogs_pfcp_pdr_associate_far(sess->ul_pdr, ul_far);
+
+    sess->dl_pdr = ogs_pfcp_pdr_add(&sess->pfcp);
+    ogs_assert(sess->dl_pdr);
+    sess->dl_pdr->src_if = OGS_PFCP_INTERFACE_CORE;
+    sess->dl_pdr->f_teid.ch = 1;
+    sess->dl_pdr->f_teid_len = 1;
+    sess->dl_pdr->outer_header_removal_len = 1;
+    sess->dl_pdr->outer_header_removal.description =
+        OGS_PFCP_OUTER_HEADER_REMOVAL_GTPU_UDP_IPV4;
+    ogs_pfcp_pdr_associate_far(sess->dl_pdr, dl_far);
+}
+
+void gtpbench_sess_init(gtpbench_sess_t *sess)
+{
+    ogs_assert(sess);
+
+    ogs_pfcp_pool_init(&sess->pfcp);
+    sess->cp_seid = sess->index + 1;
+
+    if (gtpbench_self()->sgwu)
+        sgwu_sess_init(sess);
+    else
+        upf_sess_init(sess);
+}
+
+void gtpbench_sess_final(gtpbench_sess_t *sess)
+{
+    ogs_pfcp_pdr_t *pdr = NULL;
+    int i;
+
+    ogs_assert(sess);
+
+    ogs_list_for_each(&sess->pfcp.pdr_list, pdr)
+        for (i = 0; i < pdr->num_of_flow; i++)
+            ogs_free(pdr->flow_description[i]);
+
+    ogs_pfcp_sess_clear(&sess->pfcp);
+    ogs_pfcp_pool_final(&sess->pfcp);
+
+    if (sess->ue_ip)
+        ogs_pfcp_ue_ip_free(sess->ue_ip);
+}
+
+static ogs_pkbuf_t *build_session_establishment_request(
+        uint8_t type, gtpbench_sess_t *sess)
+{
+    ogs_pfcp_message_t pfcp_message;
+    ogs_pfcp_session_establishment_request_t *req = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_pfcp_pdr_t *pdr = NULL;
+    ogs_pfcp_far_t *far = NULL;
+    int i;
+
+    ogs_pfcp_node_id_t node_id;
+    ogs_pfcp_f_seid_t f_seid;
+    int len;
+
+    ogs_assert(sess);
+
+    req = &pfcp_message.pfcp_session_establishment_request;
+    memset(&pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+
+    /* Node ID */
+    ogs_pfcp_sockaddr_to_node_id(
+            ogs_pfcp_self()->pfcp_addr, ogs_pfcp_self()->pfcp_addr6,
+            ogs_app()->parameter.prefer_ipv4,
+            &node_id, &len);
+    req->node_id.presence = 1;
+    req->node_id.data = &node_id;
+    req->node_id.len = len;
+
+    /* F-SEID */
+    ogs_pfcp_sockaddr_to_f_seid(
+            ogs_pfcp_self()->pfcp_addr, ogs_pfcp_self()->pfcp_addr6,
+            &f_seid, &len);
+    f_seid.seid = htobe64(sess->cp_seid);
+    req->cp_f_seid.presence = 1;
+    req->cp_f_seid.data = &f_seid;
+    req->cp_f_seid.len = len;
+
+    ogs_pfcp_pdrbuf_init();
+
+    /* Create PDR */
+    i = 0;
+    ogs_list_for_each(&sess->pfcp.pdr_list, pdr) {
+        ogs_pfcp_build_create_pdr(&req->create_pdr[i], i, pdr);
+        i++;
+    }
+
+    /* Create FAR */
+    i = 0;
+    ogs_list_for_each(&sess->pfcp.far_list, far) {
+        ogs_pfcp_build_create_far(&req->create_far[i], i, far);
+        i++;
+    }
+
+    /* PDN Type */
+    if (sess->ue_ip) {
+        req->pdn_type.presence = 1;
+        req->pdn_type.u8 = OGS_PDU_SESSION_TYPE_IPV4;
+    }
+
+    pfcp_message.h.type = type;
+    pkbuf = ogs_pfcp_build_msg(&pfcp_message);
+
+    ogs_pfcp_pdrbuf_clear();
+
+    return pkbuf;
+}
+
+void gtpbench_sess_establish(gtpbench_sess_t *sess)
+{
+    int rv;
+    ogs_pkbuf_t *n4buf = NULL;
+    ogs_pfcp_header_t h;
+    ogs_pfcp_xact_t *xact = NULL;
+
+    ogs_assert(sess);
+
+    memset(&h, 0, sizeof(ogs_pfcp_header_t));
+    h.type = OGS_PFCP_SESSION_ESTABLISHMENT_REQUEST_TYPE;
+    h.seid = 0;
+
+    n4buf = build_session_establishment_request(h.type, sess);
+    ogs_expect_or_return(n4buf);
+
+    xact = ogs_pfcp_xact_local_create(
+            gtpbench_self()->node, &h, n4buf, sess_timeout, sess);
+    ogs_expect_or_return(xact);
+
+    rv = ogs_pfcp_xact_commit(xact);
+    ogs_expect(rv == OGS_OK);
+
+    gtpbench_self()->requested++;
+}
+
+void gtpbench_sess_delete(gtpbench_sess_t *sess)
+{
+    int rv;
+    ogs_pkbuf_t *n4buf = NULL;
+    ogs_pfcp_header_t h;
+    ogs_pfcp_message_t pfcp_message;
+    ogs_pfcp_xact_t *xact = NULL;
+
+    ogs_assert(sess);
+
+    if (!sess->established)
+        return;
+
+    memset(&h, 0, sizeof(ogs_pfcp_header_t));
+    h.type = OGS_PFCP_SESSION_DELETION_REQUEST_TYPE;
+    h.seid = sess->up_seid;
+
+    memset(&pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+    pfcp_message.h.type = h.type;
+    n4buf = ogs_pfcp_build_msg(&pfcp_message);
+    ogs_expect_or_return(n4buf);
+
+    xact = ogs_pfcp_xact_local_create(
+            gtpbench_self()->node, &h, n4buf, sess_timeout, sess);
+    ogs_expect_or_return(xact);
+
+    rv = ogs_pfcp_xact_commit(xact);
+    ogs_expect(rv == OGS_OK);
+
+    gtpbench_self()->requested++;
+}
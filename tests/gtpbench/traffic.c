@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "gtpbench.h"
+
+#if HAVE_NETINET_IP_H
+#include <netinet/ip.h>
+#endif
+
+#if HAVE_NETINET_UDP_H
+#include <netinet/udp.h>
+#endif
+
+#define UDP_HEADER_LEN          8
+#define IPV4_UDP_HEADER_LEN     (20 + UDP_HEADER_LEN)
+
+#define SOCKET_BUFFER_SIZE      (8 * 1024 * 1024)
+
+static struct {
+    int next;                   /* Index in the active sessions */
+    int pattern;                /* Index in the size pattern */
+    uint64_t seq;
+} sender[MAX_NUM_OF_GTPBENCH_DIRECTION];
+
+static uint8_t sendbuf[OGS_GTPV1U_5GC_HEADER_LEN + GTPBENCH_MAX_SIZE];
+static uint8_t recvbuf[OGS_MAX_PKT_LEN];
+
+/* Offset of the T-PDU in a G-PDU, or -1 */
+static int gtpu_payload_offset(uint8_t *data, int len)
+{
+    ogs_gtp_header_t *gtp_h = (ogs_gtp_header_t *)data;
+    uint8_t next_type;
+    int offset;
+
+    if (len < OGS_GTPV1U_HEADER_LEN ||
+        gtp_h->version != OGS_GTP_VERSION_1 ||
+        gtp_h->type != OGS_GTPU_MSGTYPE_GPDU)
+        return -1;
+
+    offset = OGS_GTPV1U_HEADER_LEN;
+    if (gtp_h->flags & (OGS_GTPU_FLAGS_E|OGS_GTPU_FLAGS_S|OGS_GTPU_FLAGS_PN))
+        offset += 4;
+    if (offset > len)
+        return -1;
+
+    if (gtp_h->flags & OGS_GTPU_FLAGS_E) {
+        next_type = data[offset-1];
+        while (next_type) {
+            if (offset >= len || data[offset] == 0)
+                return -1;
+            offset += data[offset] * 4;
+            if (offset > len)
+                return -1;
+            next_type = data[offset-1];
+        }
+    }
+
+    return offset;
+}
+
+static void receive(gtpbench_direction_e direction,
+        uint8_t *data, int len, int size)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    gtpbench_stats_t *stats = &self->stats[direction];
+    gtpbench_stamp_t stamp;
+
+    if (len < (int)sizeof(stamp)) {
+        stats->invalid++;
+        return;
+    }
+
+    memcpy(&stamp, data, sizeof(stamp));
+    if (stamp.magic != htobe32(GTPBENCH_MAGIC) ||
+        stamp.index >= (uint32_t)self->num_of_sess) {
+        stats->invalid++;
+        return;
+    }
+
+    stats->received++;
+    stats->received_bytes += size;
+    test_histogram_add(&stats->latency,
+            ogs_get_monotonic_time() - stamp.sent);
+}
+
+static void receive_gtpu(gtpbench_direction_e direction, int len)
+{
+    struct ip *ip_h = NULL;
+    int offset;
+
+    offset = gtpu_payload_offset(recvbuf, len);
+    if (offset < 0 || len - offset < IPV4_UDP_HEADER_LEN) {
+        gtpbench_self()->stats[direction].invalid++;
+        return;
+    }
+
+    ip_h = (struct ip *)(recvbuf + offset);
+    if (ip_h->ip_v != 4 || ip_h->ip_p != IPPROTO_UDP) {
+        gtpbench_self()->stats[direction].invalid++;
+        return;
+    }
+
+    offset += ip_h->ip_hl * 4 + UDP_HEADER_LEN;
+    if (offset > len) {
+        gtpbench_self()->stats[direction].invalid++;
+        return;
+    }
+
+    receive(direction, recvbuf + offset, len - offset, be16toh(ip_h->ip_len));
+}
+
+static void recv_handler(short when, ogs_socket_t fd, void *data)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    gtpbench_direction_e direction;
+    ssize_t size;
+    int i;
+
+    /* Packets from the access side are in the downlink */
+    direction = (data == self->access) ? GTPBENCH_DOWNLINK : GTPBENCH_UPLINK;
+
+    /* Drain the socket, but let the other socket in between */
+    for (i = 0; i < GTPBENCH_BURST * 4; i++) {
+        size = recv(fd, recvbuf, sizeof(recvbuf), MSG_DONTWAIT);
+        if (size < 0) {
+            if (ogs_socket_errno != OGS_EAGAIN)
+                ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                        "recv() failed");
+            break;
+        }
+
+        if (direction == GTPBENCH_UPLINK && !self->sgwu)
+            /* UDP payload from ogstun */
+            receive(direction, recvbuf, size, size + IPV4_UDP_HEADER_LEN);
+        else
+            receive_gtpu(direction, size);
+    }
+}
+
+static ogs_socknode_t *server(const char *addr, uint16_t port)
+{
+    ogs_sockaddr_t *sa_list = NULL;
+    ogs_socknode_t *node = NULL;
+    ogs_sock_t *sock = NULL;
+    int rv, n;
+
+    rv = ogs_getaddrinfo(&sa_list, AF_INET, addr, port, 0);
+    if (rv != OGS_OK) {
+        ogs_error("Invalid address [%s]", addr);
+        return NULL;
+    }
+
+    node = ogs_socknode_new(sa_list);
+    ogs_assert(node);
+
+    sock = ogs_udp_server(node);
+    if (!sock) {
+        ogs_socknode_free(node);
+        return NULL;
+    }
+
+    /* The buffers are capped by net.core.[rw]mem_max */
+    n = SOCKET_BUFFER_SIZE;
+    if (setsockopt(sock->fd, SOL_SOCKET, SO_RCVBUF, &n, sizeof(n)) != 0 ||
+        setsockopt(sock->fd, SOL_SOCKET, SO_SNDBUF, &n, sizeof(n)) != 0)
+        ogs_log_message(OGS_LOG_WARN, ogs_socket_errno,
+                "setsockopt(SO_RCVBUF/SO_SNDBUF) failed");
+
+    rv = ogs_nonblocking(sock->fd);
+    ogs_assert(rv == OGS_OK);
+
+    return node;
+}
+
+int gtpbench_traffic_open(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    ogs_pfcp_subnet_t *subnet = NULL;
+    char buf[OGS_ADDRSTRLEN];
+
+    self->access = server(self->access_addr, OGS_GTPV1_U_UDP_PORT);
+    if (!self->access) return OGS_ERROR;
+
+    if (self->sgwu) {
+        self->core = server(self->core_addr, OGS_GTPV1_U_UDP_PORT);
+        if (!self->core) return OGS_ERROR;
+
+        /* Inner addresses are only carried by the SGW-U */
+        ogs_assert(inet_pton(AF_INET, TEST_PING_IPV4, &self->sink_addr) == 1);
+
+    } else {
+        if (self->dnn)
+            subnet = ogs_pfcp_find_subnet_by_dnn(AF_INET, self->dnn);
+        else
+            subnet = ogs_pfcp_find_subnet(AF_INET);
+        if (!subnet) {
+            ogs_error("No IPv4 subnet [dnn:%s]", self->dnn ? self->dnn : "");
+            return OGS_ERROR;
+        }
+
+        self->sink_addr = subnet->gw.sub[0];
+        ogs_assert(inet_ntop(AF_INET, &self->sink_addr, buf, sizeof(buf)));
+
+        /* The gateway address is assigned to ogstun */
+        self->core = server(buf, GTPBENCH_UDP_PORT);
+        if (!self->core) {
+            ogs_error("Cannot bind to [%s]:%d. Is ogstun up?",
+                    buf, GTPBENCH_UDP_PORT);
+            return OGS_ERROR;
+        }
+    }
+
+    self->access_poll = ogs_pollset_add(ogs_app()->pollset, OGS_POLLIN,
+            self->access->sock->fd, recv_handler, self->access);
+    ogs_assert(self->access_poll);
+    self->core_poll = ogs_pollset_add(ogs_app()->pollset, OGS_POLLIN,
+            self->core->sock->fd, recv_handler, self->core);
+    ogs_assert(self->core_poll);
+
+    return OGS_OK;
+}
+
+void gtpbench_traffic_close(void)
+{
+    gtpbench_context_t *self = gtpbench_self();
+
+    if (self->access_poll)
+        ogs_pollset_remove(self->access_poll);
+    if (self->core_poll)
+        ogs_pollset_remove(self->core_poll);
+
+    if (self->access) {
+        ogs_sock_destroy(self->access->sock);
+        ogs_socknode_free(self->access);
+    }
+    if (self->core) {
+        ogs_sock_destroy(self->core->sock);
+        ogs_socknode_free(self->core);
+    }
+}
+
+/* GTP-U header, or none for the downlink of the UPF */
+static int build_gtpu_header(gtpbench_direction_e direction,
+        gtpbench_sess_t *sess, int size)
+{
+    ogs_gtp_header_t *gtp_h = (ogs_gtp_header_t *)sendbuf;
+    ogs_gtp_extension_header_t *ext_h = NULL;
+    int hlen;
+
+    if (direction == GTPBENCH_DOWNLINK && !gtpbench_self()->sgwu)
+        return 0;
+
+    hlen = gtpbench_self()->sgwu ?
+        OGS_GTPV1U_HEADER_LEN : OGS_GTPV1U_5GC_HEADER_LEN;
+    memset(sendbuf, 0, hlen);
+
+    gtp_h->flags = OGS_GTPU_FLAGS_V | OGS_GTPU_FLAGS_PT;
+    gtp_h->type = OGS_GTPU_MSGTYPE_GPDU;
+    gtp_h->length = htobe16(hlen + size - OGS_GTPV1U_HEADER_LEN);
+    gtp_h->teid = htobe32(direction == GTPBENCH_UPLINK ?
+            sess->ul_teid : sess->dl_teid);
+
+    if (hlen == OGS_GTPV1U_5GC_HEADER_LEN) {
+        gtp_h->flags |= OGS_GTPU_FLAGS_E;
+
+        ext_h = (ogs_gtp_extension_header_t *)
+            (sendbuf + OGS_GTPV1U_HEADER_LEN);
+        ext_h->type = OGS_GTP_EXTENSION_HEADER_TYPE_PDU_SESSION_CONTAINER;
+        ext_h->len = 1;
+        ext_h->pdu_type =
+            OGS_GTP_EXTENSION_HEADER_PDU_TYPE_UL_PDU_SESSION_INFORMATION;
+        ext_h->qos_flow_identifier = 1;
+        ext_h->next_type =
+            OGS_GTP_EXTENSION_HEADER_TYPE_NO_MORE_EXTENSION_HEADERS;
+    }
+
+    return hlen;
+}
+
+static void build_ipv4_udp(uint8_t *data,
+        uint32_t src, uint32_t dst, int size)
+{
+    struct ip *ip_h = (struct ip *)data;
+    struct udphdr *udp_h = (struct udphdr *)(data + sizeof(*ip_h));
+
+    memset(ip_h, 0, sizeof(*ip_h));
+    ip_h->ip_v = 4;
+    ip_h->ip_hl = 5;
+    ip_h->ip_ttl = 64;
+    ip_h->ip_p = IPPROTO_UDP;
+    ip_h->ip_len = htobe16(size);
+    ip_h->ip_src.s_addr = src;
+    ip_h->ip_dst.s_addr = dst;
+    ip_h->ip_sum = ogs_in_cksum((uint16_t *)ip_h, sizeof(*ip_h));
+
+    /* UDP checksum is optional in IPv4 */
+    udp_h->uh_sport = htobe16(GTPBENCH_UDP_PORT);
+    udp_h->uh_dport = htobe16(GTPBENCH_UDP_PORT);
+    udp_h->uh_ulen = htobe16(size - sizeof(*ip_h));
+    udp_h->uh_sum = 0;
+}
+
+/* Returns the number of packets sent */
+int gtpbench_traffic_send(gtpbench_direction_e direction, int count)
+{
+    gtpbench_context_t *self = gtpbench_self();
+    gtpbench_stats_t *stats = &self->stats[direction];
+    gtpbench_sess_t *sess = NULL;
+    gtpbench_stamp_t stamp;
+    ogs_sockaddr_t to;
+    ogs_socket_t fd;
+    ssize_t sent;
+    int i, size, hlen, len;
+    uint8_t *data = NULL;
+
+    ogs_assert(self->num_of_active);
+
+    memset(&to, 0, sizeof(to));
+    to.ogs_sa_family = AF_INET;
+
+    fd = direction == GTPBENCH_UPLINK ?
+        self->access->sock->fd : self->core->sock->fd;
+
+    for (i = 0; i < count; i++) {
+        sess = &self->sess[self->active[sender[direction].next]];
+        size = self->pattern[sender[direction].pattern];
+
+        hlen = build_gtpu_header(direction, sess, size);
+
+        if (hlen) {
+            if (direction == GTPBENCH_UPLINK)
+                build_ipv4_udp(sendbuf + hlen,
+                        sess->ue_addr, self->sink_addr, size);
+            else
+                build_ipv4_udp(sendbuf + hlen,
+                        self->sink_addr, sess->ue_addr, size);
+
+            data = sendbuf + hlen + IPV4_UDP_HEADER_LEN;
+            len = hlen + size;
+
+            to.ogs_sin_port = htobe16(OGS_GTPV1_U_UDP_PORT);
+            to.sin.sin_addr.s_addr = direction == GTPBENCH_UPLINK ?
+                sess->ul_addr : sess->dl_addr;
+        } else {
+            /* The kernel adds the headers and routes it into ogstun */
+            data = sendbuf;
+            len = size - IPV4_UDP_HEADER_LEN;
+
+            to.ogs_sin_port = htobe16(GTPBENCH_UDP_PORT);
+            to.sin.sin_addr.s_addr = sess->ue_addr;
+        }
+
+        stamp.magic = htobe32(GTPBENCH_MAGIC);
+        stamp.index = sess->index;
+        stamp.seq = sender[direction].seq;
+        stamp.sent = ogs_get_monotonic_time();
+        memcpy(data, &stamp, sizeof(stamp));
+
+        sent = ogs_sendto(fd, sendbuf, len, 0, &to);
+        if (sent < 0 || sent != len) {
+            if (ogs_socket_errno != OGS_EAGAIN &&
+                ogs_socket_errno != ENOBUFS)
+                ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                        "ogs_sendto() failed");
+            stats->send_failed++;
+            break;
+        }
+
+        stats->sent++;
+        stats->sent_bytes += size;
+
+        sender[direction].seq++;
+        sender[direction].next =
+            (sender[direction].next + 1) % self->num_of_active;
+        sender[direction].pattern =
+            (sender[direction].pattern + 1) % self->num_of_pattern;
+    }
+
+    return i;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loadgen.h"
+
+static loadgen_context_t self;
+
+static const char *procedure_name[MAX_NUM_OF_LOADGEN_PROCEDURE] = {
+    "registration",
+    "pdu-session",
+    "release",
+    "service-request",
+    "paging",
+    "handover",
+    "deregistration",
+    "attach",
+    "detach",
+};
+
+loadgen_context_t *loadgen_self(void)
+{
+    return &self;
+}
+
+const char *loadgen_procedure_name(loadgen_procedure_e procedure)
+{
+    ogs_assert(procedure < MAX_NUM_OF_LOADGEN_PROCEDURE);
+    return procedure_name[procedure];
+}
+
+int loadgen_procedure_from_name(const char *name)
+{
+    int i;
+
+    ogs_assert(name);
+
+    for (i = 0; i < MAX_NUM_OF_LOADGEN_PROCEDURE; i++)
+        if (strcmp(procedure_name[i], name) == 0)
+            return i;
+
+    return -1;
+}
@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loadgen.h"
+
+/*
+ * Find RAN-UE-NGAP-ID or eNB-UE-S1AP-ID in the protocol IEs.
+ * Every NGAP/S1AP message has the same layout of IE list.
+ */
+#define RAN_UE_ID_IN(__mESSAGE, __iD, __iE_ID, __cHOICE) do { \
+    int __i; \
+    for (__i = 0; __i < (__mESSAGE)->protocolIEs.list.count; __i++) { \
+        if ((__mESSAGE)->protocolIEs.list.array[__i]->id == (__iE_ID)) { \
+            (__iD) = (__mESSAGE)->protocolIEs.list.array[__i]-> \
+                value.choice.__cHOICE; \
+            break; \
+        } \
+    } \
+} while (0)
+
+#define RAN_UE_NGAP_ID_IN(__mESSAGE, __iD) \
+    RAN_UE_ID_IN(__mESSAGE, __iD, \
+            NGAP_ProtocolIE_ID_id_RAN_UE_NGAP_ID, RAN_UE_NGAP_ID)
+#define ENB_UE_S1AP_ID_IN(__mESSAGE, __iD) \
+    RAN_UE_ID_IN(__mESSAGE, __iD, \
+            S1AP_ProtocolIE_ID_id_eNB_UE_S1AP_ID, ENB_UE_S1AP_ID)
+
+static loadgen_ue_t *find_ue_by_ran_ue_id(uint32_t ran_ue_id)
+{
+    if (!ran_ue_id)
+        return NULL;
+
+    return ogs_ihash_get(loadgen_self()->ran_ue_id_hash, &ran_ue_id);
+}
+
+static loadgen_ue_t *find_ue_by_core_ue_id(uint64_t core_ue_id)
+{
+    return ogs_ihash_get(loadgen_self()->core_ue_id_hash, &core_ue_id);
+}
+
+static loadgen_ue_t *ngap_find_ue_by_release_command(
+        NGAP_UEContextReleaseCommand_t *UEContextReleaseCommand)
+{
+    int i;
+    NGAP_UE_NGAP_IDs_t *UE_NGAP_IDs = NULL;
+    uint64_t amf_ue_ngap_id;
+
+    for (i = 0; i < UEContextReleaseCommand->protocolIEs.list.count; i++) {
+        NGAP_UEContextReleaseCommand_IEs_t *ie =
+            UEContextReleaseCommand->protocolIEs.list.array[i];
+        if (ie->id == NGAP_ProtocolIE_ID_id_UE_NGAP_IDs)
+            UE_NGAP_IDs = &ie->value.choice.UE_NGAP_IDs;
+    }
+
+    if (!UE_NGAP_IDs)
+        return NULL;
+
+    if (UE_NGAP_IDs->present == NGAP_UE_NGAP_IDs_PR_uE_NGAP_ID_pair)
+        return find_ue_by_ran_ue_id(
+                UE_NGAP_IDs->choice.uE_NGAP_ID_pair->rAN_UE_NGAP_ID);
+
+    if (UE_NGAP_IDs->present == NGAP_UE_NGAP_IDs_PR_aMF_UE_NGAP_ID) {
+        amf_ue_ngap_id = 0;
+        asn_INTEGER2ulong(&UE_NGAP_IDs->choice.aMF_UE_NGAP_ID,
+                (unsigned long *)&amf_ue_ngap_id);
+        return find_ue_by_core_ue_id(amf_ue_ngap_id);
+    }
+
+    return NULL;
+}
+
+static loadgen_ue_t *ngap_find_ue_by_paging(NGAP_Paging_t *Paging)
+{
+    int i;
+    NGAP_UEPagingIdentity_t *UEPagingIdentity = NULL;
+    uint32_t m_tmsi;
+
+    for (i = 0; i < Paging->protocolIEs.list.count; i++) {
+        NGAP_PagingIEs_t *ie = Paging->protocolIEs.list.array[i];
+        if (ie->id == NGAP_ProtocolIE_ID_id_UEPagingIdentity)
+            UEPagingIdentity = &ie->value.choice.UEPagingIdentity;
+    }
+
+    if (!UEPagingIdentity ||
+        UEPagingIdentity->present != NGAP_UEPagingIdentity_PR_fiveG_S_TMSI)
+        return NULL;
+
+    ogs_asn_OCTET_STRING_to_uint32(
+            &UEPagingIdentity->choice.fiveG_S_TMSI->fiveG_TMSI, &m_tmsi);
+
+    return ogs_ihash_get(loadgen_self()->m_tmsi_hash, &m_tmsi);
+}
+
+static loadgen_ue_t *ngap_find_ue(ogs_ngap_message_t *message)
+{
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+    NGAP_SuccessfulOutcome_t *successfulOutcome = NULL;
+    NGAP_UnsuccessfulOutcome_t *unsuccessfulOutcome = NULL;
+
+    uint32_t ran_ue_ngap_id = 0;
+
+    switch (message->present) {
+    case NGAP_NGAP_PDU_PR_initiatingMessage:
+        initiatingMessage = message->choice.initiatingMessage;
+        ogs_assert(initiatingMessage);
+
+        switch (initiatingMessage->procedureCode) {
+        case NGAP_ProcedureCode_id_DownlinkNASTransport:
+            RAN_UE_NGAP_ID_IN(
+                &initiatingMessage->value.choice.DownlinkNASTransport,
+                ran_ue_ngap_id);
+            break;
+        case NGAP_ProcedureCode_id_InitialContextSetup:
+            RAN_UE_NGAP_ID_IN(
+                &initiatingMessage->value.choice.InitialContextSetupRequest,
+                ran_ue_ngap_id);
+            break;
+        case NGAP_ProcedureCode_id_PDUSessionResourceSetup:
+            RAN_UE_NGAP_ID_IN(
+                &initiatingMessage->value.choice.
+                    PDUSessionResourceSetupRequest,
+                ran_ue_ngap_id);
+            break;
+        case NGAP_ProcedureCode_id_PDUSessionResourceModify:
+            RAN_UE_NGAP_ID_IN(
+                &initiatingMessage->value.choice.
+                    PDUSessionResourceModifyRequest,
+                ran_ue_ngap_id);
+            break;
+        case NGAP_ProcedureCode_id_PDUSessionResourceRelease:
+            RAN_UE_NGAP_ID_IN(
+                &initiatingMessage->value.choice.
+                    PDUSessionResourceReleaseCommand,
+                ran_ue_ngap_id);
+            break;
+        case NGAP_ProcedureCode_id_UEContextRelease:
+            return ngap_find_ue_by_release_command(
+                &initiatingMessage->value.choice.UEContextReleaseCommand);
+        case NGAP_ProcedureCode_id_Paging:
+            return ngap_find_ue_by_paging(
+                &initiatingMessage->value.choice.Paging);
+        default:
+            break;
+        }
+        break;
+    case NGAP_NGAP_PDU_PR_successfulOutcome:
+        successfulOutcome = message->choice.successfulOutcome;
+        ogs_assert(successfulOutcome);
+
+        if (successfulOutcome->procedureCode ==
+                NGAP_ProcedureCode_id_PathSwitchRequest)
+            RAN_UE_NGAP_ID_IN(
+                &successfulOutcome->value.choice.PathSwitchRequestAcknowledge,
+                ran_ue_ngap_id);
+        break;
+    case NGAP_NGAP_PDU_PR_unsuccessfulOutcome:
+        unsuccessfulOutcome = message->choice.unsuccessfulOutcome;
+        ogs_assert(unsuccessfulOutcome);
+
+        if (unsuccessfulOutcome->procedureCode ==
+                NGAP_ProcedureCode_id_PathSwitchRequest)
+            RAN_UE_NGAP_ID_IN(
+                &unsuccessfulOutcome->value.choice.PathSwitchRequestFailure,
+                ran_ue_ngap_id);
+        break;
+    default:
+        break;
+    }
+
+    return find_ue_by_ran_ue_id(ran_ue_ngap_id);
+}
+
+static loadgen_ue_t *s1ap_find_ue_by_release_command(
+        S1AP_UEContextReleaseCommand_t *UEContextReleaseCommand)
+{
+    int i;
+    S1AP_UE_S1AP_IDs_t *UE_S1AP_IDs = NULL;
+
+    for (i = 0; i < UEContextReleaseCommand->protocolIEs.list.count; i++) {
+        S1AP_UEContextReleaseCommand_IEs_t *ie =
+            UEContextReleaseCommand->protocolIEs.list.array[i];
+        if (ie->id == S1AP_ProtocolIE_ID_id_UE_S1AP_IDs)
+            UE_S1AP_IDs = &ie->value.choice.UE_S1AP_IDs;
+    }
+
+    if (!UE_S1AP_IDs)
+        return NULL;
+
+    if (UE_S1AP_IDs->present == S1AP_UE_S1AP_IDs_PR_uE_S1AP_ID_pair)
+        return find_ue_by_ran_ue_id(
+                UE_S1AP_IDs->choice.uE_S1AP_ID_pair->eNB_UE_S1AP_ID);
+
+    if (UE_S1AP_IDs->present == S1AP_UE_S1AP_IDs_PR_mME_UE_S1AP_ID)
+        return find_ue_by_core_ue_id(UE_S1AP_IDs->choice.mME_UE_S1AP_ID);
+
+    return NULL;
+}
+
+static loadgen_ue_t *s1ap_find_ue(ogs_s1ap_message_t *message)
+{
+    S1AP_InitiatingMessage_t *initiatingMessage = NULL;
+
+    uint32_t enb_ue_s1ap_id = 0;
+
+    if (message->present != S1AP_S1AP_PDU_PR_initiatingMessage)
+        return NULL;
+
+    initiatingMessage = message->choice.initiatingMessage;
+    ogs_assert(initiatingMessage);
+
+    switch (initiatingMessage->procedureCode) {
+    case S1AP_ProcedureCode_id_downlinkNASTransport:
+        ENB_UE_S1AP_ID_IN(
+            &initiatingMessage->value.choice.DownlinkNASTransport,
+            enb_ue_s1ap_id);
+        break;
+    case S1AP_ProcedureCode_id_InitialContextSetup:
+        ENB_UE_S1AP_ID_IN(
+            &initiatingMessage->value.choice.InitialContextSetupRequest,
+            enb_ue_s1ap_id);
+        break;
+    case S1AP_ProcedureCode_id_E_RABSetup:
+        ENB_UE_S1AP_ID_IN(
+            &initiatingMessage->value.choice.E_RABSetupRequest,
+            enb_ue_s1ap_id);
+        break;
+    case S1AP_ProcedureCode_id_E_RABModify:
+        ENB_UE_S1AP_ID_IN(
+            &initiatingMessage->value.choice.E_RABModifyRequest,
+            enb_ue_s1ap_id);
+        break;
+    case S1AP_ProcedureCode_id_E_RABRelease:
+        ENB_UE_S1AP_ID_IN(
+            &initiatingMessage->value.choice.E_RABReleaseCommand,
+            enb_ue_s1ap_id);
+        break;
+    case S1AP_ProcedureCode_id_UEContextRelease:
+        return s1ap_find_ue_by_release_command(
+            &initiatingMessage->value.choice.UEContextReleaseCommand);
+    default:
+        break;
+    }
+
+    return find_ue_by_ran_ue_id(enb_ue_s1ap_id);
+}
+
+static void setup_done(loadgen_gnb_t *gnb)
+{
+    ogs_assert(gnb);
+
+    if (gnb->setup_done)
+        return;
+
+    gnb->setup_done = true;
+    loadgen_self()->num_of_setup++;
+}
+
+static void ngap_recv(loadgen_gnb_t *gnb, ogs_pkbuf_t *pkbuf)
+{
+    ogs_ngap_message_t message;
+    loadgen_ue_t *ue = NULL;
+
+    if (ogs_ngap_decode(&message, pkbuf) != OGS_OK) {
+        ogs_error("[gNB-%d] Cannot decode NGAP message", gnb->index);
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    if (message.present == NGAP_NGAP_PDU_PR_successfulOutcome &&
+        message.choice.successfulOutcome->procedureCode ==
+            NGAP_ProcedureCode_id_NGSetup) {
+        setup_done(gnb);
+    } else if (message.present == NGAP_NGAP_PDU_PR_unsuccessfulOutcome &&
+        message.choice.unsuccessfulOutcome->procedureCode ==
+            NGAP_ProcedureCode_id_NGSetup) {
+        ogs_fatal("[gNB-%d] NG Setup failed", gnb->index);
+        ogs_assert_if_reached();
+    } else {
+        ue = ngap_find_ue(&message);
+        if (ue)
+            loadgen_ue_ngap_recv(ue, &message);
+    }
+
+    ogs_ngap_free(&message);
+    ogs_pkbuf_free(pkbuf);
+}
+
+static void s1ap_recv(loadgen_gnb_t *gnb, ogs_pkbuf_t *pkbuf)
+{
+    ogs_s1ap_message_t message;
+    loadgen_ue_t *ue = NULL;
+
+    if (ogs_s1ap_decode(&message, pkbuf) != OGS_OK) {
+        ogs_error("[eNB-%d] Cannot decode S1AP message", gnb->index);
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    if (message.present == S1AP_S1AP_PDU_PR_successfulOutcome &&
+        message.choice.successfulOutcome->procedureCode ==
+            S1AP_ProcedureCode_id_S1Setup) {
+        setup_done(gnb);
+    } else if (message.present == S1AP_S1AP_PDU_PR_unsuccessfulOutcome &&
+        message.choice.unsuccessfulOutcome->procedureCode ==
+            S1AP_ProcedureCode_id_S1Setup) {
+        ogs_fatal("[eNB-%d] S1 Setup failed", gnb->index);
+        ogs_assert_if_reached();
+    } else {
+        ue = s1ap_find_ue(&message);
+        if (ue)
+            loadgen_ue_s1ap_recv(ue, &message);
+    }
+
+    ogs_s1ap_free(&message);
+    ogs_pkbuf_free(pkbuf);
+}
+
+static void gnb_recv_handler(short when, ogs_socket_t fd, void *data)
+{
+    loadgen_gnb_t *gnb = data;
+    ogs_pkbuf_t *pkbuf = NULL;
+    int size, flags = 0;
+
+    ogs_assert(gnb);
+    ogs_assert(gnb->node);
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN);
+
+    size = ogs_sctp_recvmsg(gnb->node->sock,
+            pkbuf->data, pkbuf->len, NULL, NULL, &flags);
+    if (size <= 0) {
+        ogs_error("[%s-%d] Connection lost",
+                loadgen_self()->epc ? "eNB" : "gNB", gnb->index);
+        ogs_pkbuf_free(pkbuf);
+
+        ogs_pollset_remove(gnb->poll);
+        gnb->poll = NULL;
+        return;
+    }
+
+    if (flags & MSG_NOTIFICATION) {
+        ogs_pkbuf_free(pkbuf);
+        return;
+    }
+
+    ogs_pkbuf_trim(pkbuf, size);
+
+    if (loadgen_self()->epc)
+        s1ap_recv(gnb, pkbuf);
+    else
+        ngap_recv(gnb, pkbuf);
+}
+
+int loadgen_gnb_open(loadgen_gnb_t *gnb)
+{
+    ogs_pkbuf_t *sendbuf = NULL;
+
+    ogs_assert(gnb);
+
+    if (loadgen_self()->epc) {
+        gnb->node = tests1ap_client(AF_INET);
+        ogs_assert(gnb->node);
+        sendbuf = test_s1ap_build_s1_setup_request(
+                S1AP_ENB_ID_PR_macroENB_ID, gnb->id);
+    } else {
+        gnb->node = testngap_client(AF_INET);
+        ogs_assert(gnb->node);
+        sendbuf = testngap_build_ng_setup_request(
+                gnb->id, LOADGEN_GNB_ID_BITSIZE);
+    }
+    ogs_assert(sendbuf);
+
+    gnb->poll = ogs_pollset_add(ogs_app()->pollset,
+            OGS_POLLIN, gnb->node->sock->fd, gnb_recv_handler, gnb);
+    ogs_assert(gnb->poll);
+
+    return loadgen_gnb_send(gnb, sendbuf);
+}
+
+void loadgen_gnb_close(loadgen_gnb_t *gnb)
+{
+    ogs_assert(gnb);
+
+    if (gnb->poll)
+        ogs_pollset_remove(gnb->poll);
+    gnb->poll = NULL;
+
+    if (gnb->node)
+        ogs_socknode_free(gnb->node);
+    gnb->node = NULL;
+}
+
+int loadgen_gnb_send(loadgen_gnb_t *gnb, ogs_pkbuf_t *pkbuf)
+{
+    ogs_assert(gnb);
+    ogs_assert(pkbuf);
+
+    if (!gnb->poll) {
+        ogs_pkbuf_free(pkbuf);
+        return OGS_ERROR;
+    }
+
+    if (loadgen_self()->epc)
+        return testenb_s1ap_send(gnb->node, pkbuf);
+    else
+        return testgnb_ngap_send(gnb->node, pkbuf);
+}
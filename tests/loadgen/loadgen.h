@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOADGEN_H
+#define LOADGEN_H
+
+#include "test-common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Control-plane load generator
+ *
+ * A number of gNBs(eNBs) are connected to the AMF(MME) from one process.
+ * UEs are started at a fixed rate, and each UE runs the same list of
+ * procedures. The latency of a procedure is measured from the first
+ * message sent by the UE to the message that completes the procedure,
+ * e.g. Registration Accept.
+ *
+ * All UEs are driven from one ogs_pollset_t, so the UE/gNB emulation of
+ * tests/common is reused without any thread.
+ */
+
+typedef enum {
+    LOADGEN_REGISTRATION = 0,
+    LOADGEN_PDU_SESSION,
+    LOADGEN_RELEASE,
+    LOADGEN_SERVICE_REQUEST,
+    LOADGEN_PAGING,
+    LOADGEN_HANDOVER,
+    LOADGEN_DEREGISTRATION,
+    LOADGEN_ATTACH,
+    LOADGEN_DETACH,
+
+    MAX_NUM_OF_LOADGEN_PROCEDURE,
+} loadgen_procedure_e;
+
+#define LOADGEN_MAX_SCENARIO    16
+#define LOADGEN_GNB_ID_BITSIZE  22
+
+typedef struct loadgen_stats_s {
+    uint64_t failed;
+    uint64_t timeout;
+
+    test_histogram_t latency;   /* Completed procedures */
+} loadgen_stats_t;
+
+typedef struct loadgen_gnb_s {
+    int index;
+    uint32_t id;                /* gNB-ID or eNB-ID */
+
+    ogs_socknode_t *node;
+    ogs_poll_t *poll;
+
+    bool setup_done;
+} loadgen_gnb_t;
+
+typedef enum {
+    LOADGEN_UE_IDLE = 0,        /* No NG/S1 connection */
+    LOADGEN_UE_CONNECTED,
+} loadgen_ue_connection_e;
+
+typedef struct loadgen_ue_s {
+    int index;
+
+    test_ue_t *test_ue;
+    test_sess_t *sess;
+
+    loadgen_gnb_t *gnb;
+    loadgen_ue_connection_e connection;
+
+    /* UE-associated logical connection */
+    uint32_t ran_ue_id;
+    uint64_t core_ue_id;
+
+    int step;                   /* Index in the scenario */
+    int state;                  /* Next message within the procedure */
+    bool running;               /* Procedure in progress */
+    bool done;                  /* Scenario is finished */
+    bool ack_configuration_update;
+
+    ogs_time_t start;
+    ogs_timer_t *timer;
+
+    ogs_pkbuf_t *nasbuf;        /* Complete Registration Request */
+    uint32_t paging_m_tmsi;
+} loadgen_ue_t;
+
+typedef struct loadgen_context_s {
+    int num_of_ue;
+    int num_of_gnb;
+    int rate;                   /* UEs started per second */
+    bool epc;                   /* eNB/MME instead of gNB/AMF */
+    bool provision;             /* Insert subscribers in the database */
+
+    int num_of_scenario;
+    loadgen_procedure_e scenario[LOADGEN_MAX_SCENARIO];
+
+    ogs_time_t timeout;
+    ogs_time_t think;
+
+    const char *msin;           /* MSIN of the first UE */
+    const char *dnn;
+
+    loadgen_gnb_t *gnb;
+    loadgen_ue_t *ue;
+
+    ogs_socknode_t *gtpu;       /* gNB N3 for Paging */
+    ogs_poll_t *gtpu_poll;
+
+    ogs_ihash_t *ran_ue_id_hash;
+    ogs_ihash_t *core_ue_id_hash;
+    ogs_ihash_t *m_tmsi_hash;
+    uint32_t ran_ue_id;         /* Last RAN-UE-NGAP-ID/eNB-UE-S1AP-ID */
+
+    int num_of_setup;
+    int started;
+    int finished;
+
+    ogs_time_t start_time;
+    loadgen_stats_t stats[MAX_NUM_OF_LOADGEN_PROCEDURE];
+} loadgen_context_t;
+
+loadgen_context_t *loadgen_self(void);
+
+const char *loadgen_procedure_name(loadgen_procedure_e procedure);
+int loadgen_procedure_from_name(const char *name);
+
+int loadgen_gnb_open(loadgen_gnb_t *gnb);
+void loadgen_gnb_close(loadgen_gnb_t *gnb);
+int loadgen_gnb_send(loadgen_gnb_t *gnb, ogs_pkbuf_t *pkbuf);
+
+int loadgen_ue_init(loadgen_ue_t *ue);
+void loadgen_ue_final(loadgen_ue_t *ue);
+void loadgen_ue_start(loadgen_ue_t *ue);
+void loadgen_ue_set_ran_ue_id(loadgen_ue_t *ue, uint32_t ran_ue_id);
+void loadgen_ue_set_core_ue_id(loadgen_ue_t *ue, uint64_t core_ue_id);
+
+void loadgen_ue_ngap_recv(loadgen_ue_t *ue, ogs_ngap_message_t *message);
+void loadgen_ue_s1ap_recv(loadgen_ue_t *ue, ogs_s1ap_message_t *message);
+void loadgen_ue_paging(loadgen_ue_t *ue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOADGEN_H */
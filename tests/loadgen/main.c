@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <signal.h>
+
+#include "loadgen.h"
+
+#define DEFAULT_SCENARIO \
+    "registration,pdu-session,release,service-request,deregistration"
+
+static volatile sig_atomic_t stopped = 0;
+
+static void show_help(const char *name)
+{
+    printf("Usage: %s [options]\n"
+        "Options:\n"
+       "   -c filename    : set configuration file\n"
+       "   -l filename    : set logging file\n"
+       "   -e level       : set global log-level (default:info)\n"
+       "   -m domain      : set log-domain (e.g. mme:sgw:gtp)\n"
+       "   -n number      : number of UEs (default:1000)\n"
+       "   -g number      : number of gNBs or eNBs (default:1)\n"
+       "   -r rate        : UEs started per second (default:100)\n"
+       "   -p list        : procedures of each UE (default:\n"
+       "                    " DEFAULT_SCENARIO ")\n"
+       "   -t msec        : timeout of a procedure (default:5000)\n"
+       "   -w msec        : think time between procedures (default:100)\n"
+       "   -i msin        : MSIN of the first UE (default:0000021309)\n"
+       "   -a dnn         : DNN or APN (default:internet)\n"
+       "   -N             : do not insert subscribers in the database\n"
+       "   -h             : show this message and exit\n"
+       "\n"
+       "Procedures:\n"
+       "   5GC : registration, pdu-session, release, service-request,\n"
+       "         paging, handover, deregistration\n"
+       "   EPC : attach, release, service-request, detach\n"
+       "\n", name);
+}
+
+static void sig_handler(int signum)
+{
+    stopped = 1;
+}
+
+static int parse_scenario(char *list)
+{
+    loadgen_context_t *self = loadgen_self();
+    char *name = NULL, *saveptr = NULL;
+    bool epc = false, fivegc = false;
+    int procedure;
+
+    for (name = strtok_r(list, ",", &saveptr); name;
+            name = strtok_r(NULL, ",", &saveptr)) {
+        procedure = loadgen_procedure_from_name(name);
+        if (procedure < 0) {
+            fprintf(stderr, "Unknown procedure [%s]\n", name);
+            return OGS_ERROR;
+        }
+        if (self->num_of_scenario >= LOADGEN_MAX_SCENARIO) {
+            fprintf(stderr, "Too many procedures [%d]\n",
+                    LOADGEN_MAX_SCENARIO);
+            return OGS_ERROR;
+        }
+
+        switch (procedure) {
+        case LOADGEN_ATTACH:
+        case LOADGEN_DETACH:
+            epc = true;
+            break;
+        case LOADGEN_RELEASE:
+        case LOADGEN_SERVICE_REQUEST:
+            break;
+        default:
+            fivegc = true;
+            break;
+        }
+
+        self->scenario[self->num_of_scenario++] = procedure;
+    }
+
+    if (!self->num_of_scenario) {
+        fprintf(stderr, "No procedure\n");
+        return OGS_ERROR;
+    }
+    if (epc && fivegc) {
+        fprintf(stderr, "Cannot mix EPC and 5GC procedures\n");
+        return OGS_ERROR;
+    }
+
+    self->epc = epc;
+
+    return OGS_OK;
+}
+
+static void gtpu_recv_handler(short when, ogs_socket_t fd, void *data)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    /* Downlink data after Paging is not checked */
+    pkbuf = test_gtpu_read(loadgen_self()->gtpu);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_free(pkbuf);
+}
+
+static void run_once(ogs_time_t timeout)
+{
+    ogs_timer_mgr_t *timer_mgr = ogs_app()->timer_mgr;
+    ogs_time_t next = ogs_timer_mgr_next(timer_mgr);
+
+    if (next == OGS_INFINITE_TIME || next > timeout)
+        next = timeout;
+
+    ogs_pollset_poll(ogs_app()->pollset, next);
+    ogs_timer_mgr_expire(timer_mgr);
+}
+
+static void print_progress(void)
+{
+    loadgen_context_t *self = loadgen_self();
+    uint64_t completed = 0, failed = 0;
+    int i;
+
+    for (i = 0; i < MAX_NUM_OF_LOADGEN_PROCEDURE; i++) {
+        completed += self->stats[i].latency.count;
+        failed += self->stats[i].failed + self->stats[i].timeout;
+    }
+
+    printf("[%6.1fs] started %d/%d, finished %d, "
+            "procedures %llu, failed %llu\n",
+            (ogs_get_monotonic_time() - self->start_time) / 1000000.0,
+            self->started, self->num_of_ue, self->finished,
+            (unsigned long long)completed, (unsigned long long)failed);
+    fflush(stdout);
+}
+
+static void print_report(void)
+{
+    loadgen_context_t *self = loadgen_self();
+    loadgen_stats_t *stats = NULL;
+    double elapsed;
+    int i;
+
+    elapsed = (ogs_get_monotonic_time() - self->start_time) / 1000000.0;
+
+    printf("\n%d UEs on %d %s, %.1f seconds\n",
+            self->finished, self->num_of_gnb,
+            self->epc ? "eNBs" : "gNBs", elapsed);
+    printf("%-16s %8s %6s %7s %9s %9s %9s %9s %9s %9s\n",
+            "procedure", "count", "fail", "timeout", "proc/s",
+            "p50(us)", "p90(us)", "p99(us)", "p99.9(us)", "max(us)");
+
+    for (i = 0; i < MAX_NUM_OF_LOADGEN_PROCEDURE; i++) {
+        stats = &self->stats[i];
+        if (!stats->latency.count && !stats->failed && !stats->timeout)
+            continue;
+
+        printf("%-16s %8llu %6llu %7llu %9.1f %9lld %9lld %9lld %9lld %9lld\n",
+                loadgen_procedure_name(i),
+                (unsigned long long)stats->latency.count,
+                (unsigned long long)stats->failed,
+                (unsigned long long)stats->timeout,
+                elapsed > 0 ? stats->latency.count / elapsed : 0,
+                (long long)test_histogram_percentile(&stats->latency, 50),
+                (long long)test_histogram_percentile(&stats->latency, 90),
+                (long long)test_histogram_percentile(&stats->latency, 99),
+                (long long)test_histogram_percentile(&stats->latency, 99.9),
+                (long long)stats->latency.max);
+    }
+}
+
+static int loadgen_initialize(void)
+{
+    loadgen_context_t *self = loadgen_self();
+    int i, rv;
+
+    test_context_init();
+    rv = test_context_parse_config();
+    if (rv != OGS_OK) return rv;
+
+    ogs_sctp_init(ogs_app()->usrsctp.udp_port);
+    if (self->provision) {
+        rv = ogs_dbi_init(ogs_app()->db_uri);
+        if (rv != OGS_OK) return rv;
+    }
+
+    self->ran_ue_id_hash = ogs_ihash_make(sizeof(uint32_t));
+    ogs_assert(self->ran_ue_id_hash);
+    self->core_ue_id_hash = ogs_ihash_make(sizeof(uint64_t));
+    ogs_assert(self->core_ue_id_hash);
+    self->m_tmsi_hash = ogs_ihash_make(sizeof(uint32_t));
+    ogs_assert(self->m_tmsi_hash);
+
+    self->gnb = ogs_calloc(self->num_of_gnb, sizeof(loadgen_gnb_t));
+    ogs_assert(self->gnb);
+    for (i = 0; i < self->num_of_gnb; i++) {
+        self->gnb[i].index = i;
+        self->gnb[i].id = (self->epc ? 0x54f64 : 0x4000) + i;
+    }
+
+    self->ue = ogs_calloc(self->num_of_ue, sizeof(loadgen_ue_t));
+    ogs_assert(self->ue);
+
+    printf("Initializing %d UEs%s\n", self->num_of_ue,
+            self->provision ? " and subscribers" : "");
+    for (i = 0; i < self->num_of_ue; i++) {
+        self->ue[i].index = i;
+        rv = loadgen_ue_init(&self->ue[i]);
+        if (rv != OGS_OK) return rv;
+    }
+
+    if (!self->epc) {
+        self->gtpu = test_gtpu_server(1, AF_INET);
+        if (self->gtpu) {
+            self->gtpu_poll = ogs_pollset_add(ogs_app()->pollset,
+                    OGS_POLLIN, self->gtpu->sock->fd,
+                    gtpu_recv_handler, NULL);
+            ogs_assert(self->gtpu_poll);
+        }
+    }
+
+    return OGS_OK;
+}
+
+static void loadgen_terminate(void)
+{
+    loadgen_context_t *self = loadgen_self();
+    int i;
+
+    if (self->gtpu_poll)
+        ogs_pollset_remove(self->gtpu_poll);
+    if (self->gtpu)
+        test_gtpu_close(self->gtpu);
+
+    if (self->ue) {
+        for (i = 0; i < self->num_of_ue; i++)
+            if (self->ue[i].test_ue)
+                loadgen_ue_final(&self->ue[i]);
+        ogs_free(self->ue);
+    }
+
+    if (self->gnb) {
+        for (i = 0; i < self->num_of_gnb; i++)
+            loadgen_gnb_close(&self->gnb[i]);
+        ogs_free(self->gnb);
+    }
+
+    if (self->m_tmsi_hash)
+        ogs_ihash_destroy(self->m_tmsi_hash);
+    if (self->core_ue_id_hash)
+        ogs_ihash_destroy(self->core_ue_id_hash);
+    if (self->ran_ue_id_hash)
+        ogs_ihash_destroy(self->ran_ue_id_hash);
+
+    test_context_final();
+
+    if (self->provision)
+        ogs_dbi_final();
+    ogs_sctp_final();
+}
+
+static void loadgen_run(void)
+{
+    loadgen_context_t *self = loadgen_self();
+    ogs_time_t now, deadline, last_progress;
+    int i, target;
+
+    for (i = 0; i < self->num_of_gnb; i++)
+        ogs_assert(loadgen_gnb_open(&self->gnb[i]) == OGS_OK);
+
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(5);
+    while (!stopped && self->num_of_setup < self->num_of_gnb) {
+        if (ogs_get_monotonic_time() > deadline) {
+            ogs_fatal("%d of %d %s set up", self->num_of_setup,
+                    self->num_of_gnb, self->epc ? "eNBs" : "gNBs");
+            return;
+        }
+        run_once(ogs_time_from_msec(100));
+    }
+
+    self->start_time = last_progress = ogs_get_monotonic_time();
+
+    while (!stopped && self->finished < self->num_of_ue) {
+        now = ogs_get_monotonic_time();
+
+        /* Start UEs at a fixed rate from the start time */
+        target = ogs_min(self->num_of_ue,
+                (now - self->start_time) * self->rate / 1000000 + 1);
+        while (self->started < target)
+            loadgen_ue_start(&self->ue[self->started]);
+
+        if (now - last_progress >= ogs_time_from_sec(1)) {
+            print_progress();
+            last_progress = now;
+        }
+
+        run_once(self->started < self->num_of_ue ?
+                ogs_max(1000000 / self->rate, 1000) : ogs_time_from_msec(100));
+    }
+
+    print_progress();
+    print_report();
+}
+
+int main(int argc, const char *const argv[])
+{
+    loadgen_context_t *self = loadgen_self();
+    int rv, i, opt;
+    ogs_getopt_t options;
+    char *scenario = NULL;
+    const char *argv_out[argc+1];
+
+    memset(self, 0, sizeof(*self));
+    self->num_of_ue = 1000;
+    self->num_of_gnb = 1;
+    self->rate = 100;
+    self->provision = true;
+    self->timeout = ogs_time_from_msec(5000);
+    self->think = ogs_time_from_msec(100);
+    self->msin = "0000021309";
+    self->dnn = "internet";
+
+    i = 0;
+    argv_out[i++] = argv[0];
+
+    ogs_getopt_init(&options, (char**)argv);
+    while ((opt = ogs_getopt(&options, "hNc:l:e:m:n:g:r:p:t:w:i:a:")) != -1) {
+        switch (opt) {
+        case 'h':
+            show_help(argv[0]);
+            return OGS_OK;
+        case 'c':
+            argv_out[i++] = "-c";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'l':
+            argv_out[i++] = "-l";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'e':
+            argv_out[i++] = "-e";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'm':
+            argv_out[i++] = "-m";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'n':
+            self->num_of_ue = atoi(options.optarg);
+            break;
+        case 'g':
+            self->num_of_gnb = atoi(options.optarg);
+            break;
+        case 'r':
+            self->rate = atoi(options.optarg);
+            break;
+        case 'p':
+            scenario = options.optarg;
+            break;
+        case 't':
+            self->timeout = ogs_time_from_msec(atoi(options.optarg));
+            break;
+        case 'w':
+            self->think = ogs_time_from_msec(atoi(options.optarg));
+            break;
+        case 'i':
+            self->msin = options.optarg;
+            break;
+        case 'a':
+            self->dnn = options.optarg;
+            break;
+        case 'N':
+            self->provision = false;
+            break;
+        case '?':
+            fprintf(stderr, "%s: %s\n", argv[0], options.errmsg);
+            show_help(argv[0]);
+            return OGS_ERROR;
+        default:
+            fprintf(stderr, "%s: should not be reached\n", OGS_FUNC);
+            return OGS_ERROR;
+        }
+    }
+    argv_out[i] = NULL;
+
+    if (self->num_of_ue <= 0 || self->num_of_gnb <= 0 || self->rate <= 0 ||
+        self->timeout <= 0 || self->think < 0) {
+        show_help(argv[0]);
+        return OGS_ERROR;
+    }
+
+    {
+        char list[] = DEFAULT_SCENARIO;
+        rv = parse_scenario(scenario ? scenario : list);
+        if (rv != OGS_OK) return rv;
+    }
+
+    rv = ogs_app_initialize(NULL, DEFAULT_CONFIG_FILENAME, argv_out);
+    if (rv != OGS_OK) {
+        ogs_fatal("Load generator initialization failed. Aborted");
+        return rv;
+    }
+
+    /* Pools of tests/common are sized by the configuration */
+    if ((uint64_t)self->num_of_ue > ogs_app()->max.ue) {
+        ogs_fatal("Too many UEs [%d > max.ue:%d]",
+                self->num_of_ue, (int)ogs_app()->max.ue);
+        ogs_app_terminate();
+        return OGS_ERROR;
+    }
+    if ((uint64_t)self->num_of_gnb > ogs_app()->max.gnb) {
+        ogs_fatal("Too many gNBs [%d > max.gnb:%d]",
+                self->num_of_gnb, (int)ogs_app()->max.gnb);
+        ogs_app_terminate();
+        return OGS_ERROR;
+    }
+
+    rv = loadgen_initialize();
+    if (rv == OGS_OK) {
+        signal(SIGINT, sig_handler);
+        signal(SIGTERM, sig_handler);
+
+        loadgen_run();
+    }
+
+    loadgen_terminate();
+    ogs_app_terminate();
+
+    return rv;
+}
@@ -0,0 +1,902 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "loadgen.h"
+
+typedef enum {
+    STATE_NONE = 0,
+    STATE_WAIT_NAS,             /* Registration/Attach in progress */
+    STATE_WAIT_SESSION,         /* PDUSessionResourceSetupRequest */
+    STATE_WAIT_RELEASE,         /* UEContextReleaseCommand */
+    STATE_WAIT_CONTEXT,         /* InitialContextSetupRequest */
+    STATE_WAIT_PAGING,          /* Paging */
+    STATE_WAIT_PATH_SWITCH,     /* PathSwitchRequestAcknowledge */
+} loadgen_ue_state_e;
+
+#define UE_NAME(__uE) (__uE)->test_ue->imsi
+
+static void begin(loadgen_ue_t *ue);
+
+static loadgen_procedure_e procedure(loadgen_ue_t *ue)
+{
+    ogs_assert(ue->step < loadgen_self()->num_of_scenario);
+    return loadgen_self()->scenario[ue->step];
+}
+
+static void finish(loadgen_ue_t *ue)
+{
+    if (ue->done)
+        return;
+
+    ue->done = true;
+    ue->running = false;
+    ogs_timer_stop(ue->timer);
+
+    if (ue->paging_m_tmsi) {
+        ogs_ihash_set(loadgen_self()->m_tmsi_hash, &ue->paging_m_tmsi, NULL);
+        ue->paging_m_tmsi = 0;
+    }
+
+    loadgen_self()->finished++;
+}
+
+static void complete(loadgen_ue_t *ue)
+{
+    loadgen_stats_t *stats = NULL;
+
+    ogs_assert(ue);
+
+    if (!ue->running)
+        return;
+
+    stats = &loadgen_self()->stats[procedure(ue)];
+    test_histogram_add(
+            &stats->latency, ogs_get_monotonic_time() - ue->start);
+
+    ue->running = false;
+    ue->state = STATE_NONE;
+    ue->step++;
+
+    if (loadgen_self()->think)
+        ogs_timer_start(ue->timer, loadgen_self()->think);
+    else
+        begin(ue);
+}
+
+static void fail(loadgen_ue_t *ue, bool timeout)
+{
+    loadgen_stats_t *stats = NULL;
+
+    ogs_assert(ue);
+
+    if (ue->done)
+        return;
+
+    if (ue->step < loadgen_self()->num_of_scenario) {
+        stats = &loadgen_self()->stats[procedure(ue)];
+        if (timeout)
+            stats->timeout++;
+        else
+            stats->failed++;
+
+        ogs_warn("[%s] %s %s", UE_NAME(ue),
+                loadgen_procedure_name(procedure(ue)),
+                timeout ? "timed out" : "failed");
+    }
+
+    /* The state of the UE is unknown. Stop the scenario */
+    finish(ue);
+}
+
+static uint32_t next_ran_ue_id(void)
+{
+    loadgen_context_t *self = loadgen_self();
+
+    /* eNB-UE-S1AP-ID has 24 bits */
+    do {
+        self->ran_ue_id++;
+        if (self->epc)
+            self->ran_ue_id &= 0xffffff;
+    } while (!self->ran_ue_id ||
+            ogs_ihash_get(self->ran_ue_id_hash, &self->ran_ue_id));
+
+    return self->ran_ue_id;
+}
+
+/*
+ * Assign a new RAN UE ID before the Initial UE Message.
+ * The builder increments the ID in test_ue_t.
+ */
+static void new_connection(loadgen_ue_t *ue)
+{
+    uint32_t id = next_ran_ue_id();
+
+    loadgen_ue_set_ran_ue_id(ue, id);
+    loadgen_ue_set_core_ue_id(ue, 0);
+
+    if (loadgen_self()->epc)
+        ue->test_ue->enb_ue_s1ap_id = id - 1;
+    else
+        ue->test_ue->ran_ue_ngap_id = id - 1;
+}
+
+static void send_ran(loadgen_ue_t *ue, ogs_pkbuf_t *sendbuf)
+{
+    ogs_assert(sendbuf);
+
+    if (loadgen_gnb_send(ue->gnb, sendbuf) != OGS_OK)
+        fail(ue, false);
+}
+
+static void send_nas(loadgen_ue_t *ue, ogs_pkbuf_t *nasbuf)
+{
+    ogs_pkbuf_t *sendbuf = NULL;
+
+    ogs_assert(nasbuf);
+
+    if (loadgen_self()->epc)
+        sendbuf = test_s1ap_build_uplink_nas_transport(ue->test_ue, nasbuf);
+    else
+        sendbuf = testngap_build_uplink_nas_transport(ue->test_ue, nasbuf);
+
+    send_ran(ue, sendbuf);
+}
+
+static void set_cell(loadgen_ue_t *ue)
+{
+    if (loadgen_self()->epc)
+        /* ECI = eNB-ID(20bit) + Cell-ID(8bit) */
+        ue->test_ue->e_cgi.cell_id = (ue->gnb->id << 8) | 1;
+    else
+        /* NCI = gNB-ID(22bit) + Cell-ID(14bit) */
+        ue->test_ue->nr_cgi.cell_id =
+            ((uint64_t)ue->gnb->id << (36 - LOADGEN_GNB_ID_BITSIZE)) | 1;
+}
+
+/***********************************************************************
+ * 5GC procedures
+ */
+static bool start_registration(loadgen_ue_t *ue)
+{
+    test_ue_t *test_ue = ue->test_ue;
+    ogs_pkbuf_t *gmmbuf = NULL;
+
+    memset(&test_ue->registration_request_param, 0,
+            sizeof(test_ue->registration_request_param));
+    gmmbuf = testgmm_build_registration_request(test_ue, NULL);
+    ogs_assert(gmmbuf);
+
+    test_ue->registration_request_param.gmm_capability = 1;
+    test_ue->registration_request_param.requested_nssai = 1;
+    test_ue->registration_request_param.last_visited_registered_tai = 1;
+    test_ue->registration_request_param.ue_usage_setting = 1;
+    if (ue->nasbuf)
+        ogs_pkbuf_free(ue->nasbuf);
+    ue->nasbuf = testgmm_build_registration_request(test_ue, NULL);
+    ogs_assert(ue->nasbuf);
+
+    new_connection(ue);
+    ue->state = STATE_WAIT_NAS;
+    send_ran(ue, testngap_build_initial_ue_message(
+                test_ue, gmmbuf, false, true));
+
+    return true;
+}
+
+static bool start_pdu_session(loadgen_ue_t *ue)
+{
+    test_sess_t *sess = NULL;
+    ogs_pkbuf_t *gsmbuf = NULL, *gmmbuf = NULL;
+
+    if (ue->connection != LOADGEN_UE_CONNECTED || ue->sess)
+        return false;
+
+    sess = test_sess_add_by_dnn_and_psi(
+            ue->test_ue, (char *)loadgen_self()->dnn, 5);
+    ogs_assert(sess);
+    ue->sess = sess;
+
+    sess->ul_nas_transport_param.request_type =
+        OGS_NAS_5GS_REQUEST_TYPE_INITIAL;
+    sess->ul_nas_transport_param.dnn = 1;
+    sess->ul_nas_transport_param.s_nssai = 0;
+
+    sess->pdu_session_establishment_param.ssc_mode = 1;
+    sess->pdu_session_establishment_param.epco = 1;
+
+    gsmbuf = testgsm_build_pdu_session_establishment_request(sess);
+    ogs_assert(gsmbuf);
+    gmmbuf = testgmm_build_ul_nas_transport(sess,
+            OGS_NAS_PAYLOAD_CONTAINER_N1_SM_INFORMATION, gsmbuf);
+    ogs_assert(gmmbuf);
+
+    ue->state = STATE_WAIT_SESSION;
+    send_nas(ue, gmmbuf);
+
+    return true;
+}
+
+static bool start_release(loadgen_ue_t *ue)
+{
+    ogs_pkbuf_t *sendbuf = NULL;
+
+    if (ue->connection != LOADGEN_UE_CONNECTED)
+        return false;
+
+    if (loadgen_self()->epc)
+        sendbuf = test_s1ap_build_ue_context_release_request(ue->test_ue,
+                S1AP_Cause_PR_radioNetwork,
+                S1AP_CauseRadioNetwork_user_inactivity);
+    else
+        sendbuf = testngap_build_ue_context_release_request(ue->test_ue,
+                NGAP_Cause_PR_radioNetwork,
+                NGAP_CauseRadioNetwork_user_inactivity, ue->sess != NULL);
+
+    ue->state = STATE_WAIT_RELEASE;
+    send_ran(ue, sendbuf);
+
+    return true;
+}
+
+static void send_service_request(loadgen_ue_t *ue, uint8_t service_type)
+{
+    test_ue_t *test_ue = ue->test_ue;
+    test_service_request_param_t *param = &test_ue->service_request_param;
+    ogs_pkbuf_t *nasbuf = NULL, *gmmbuf = NULL;
+
+    /* Complete message in the NAS message container */
+    memset(param, 0, sizeof(*param));
+    if (ue->sess && service_type == OGS_NAS_SERVICE_TYPE_DATA) {
+        param->uplink_data_status = 1;
+        param->psimask.uplink_data_status = 1 << ue->sess->psi;
+    } else if (ue->sess) {
+        param->pdu_session_status = 1;
+        param->psimask.pdu_session_status = 1 << ue->sess->psi;
+    }
+    nasbuf = testgmm_build_service_request(test_ue, service_type, NULL);
+    ogs_assert(nasbuf);
+
+    memset(param, 0, sizeof(*param));
+    param->integrity_protected = 1;
+    gmmbuf = testgmm_build_service_request(test_ue, service_type, nasbuf);
+    ogs_assert(gmmbuf);
+
+    new_connection(ue);
+    ue->state = STATE_WAIT_CONTEXT;
+    send_ran(ue, testngap_build_initial_ue_message(
+                test_ue, gmmbuf, true, true));
+}
+
+static bool start_service_request(loadgen_ue_t *ue)
+{
+    if (ue->connection != LOADGEN_UE_IDLE)
+        return false;
+
+    if (loadgen_self()->epc) {
+        ogs_pkbuf_t *emmbuf = testemm_build_service_request(ue->test_ue);
+        ogs_assert(emmbuf);
+
+        new_connection(ue);
+        ue->state = STATE_WAIT_CONTEXT;
+        send_ran(ue, test_s1ap_build_initial_ue_message(ue->test_ue, emmbuf,
+                    S1AP_RRC_Establishment_Cause_mo_Data, true));
+    } else {
+        send_service_request(ue, ue->sess ?
+                OGS_NAS_SERVICE_TYPE_DATA : OGS_NAS_SERVICE_TYPE_SIGNALLING);
+    }
+
+    return true;
+}
+
+static bool start_paging(loadgen_ue_t *ue)
+{
+    test_bearer_t *qos_flow = NULL;
+
+    if (ue->connection != LOADGEN_UE_IDLE || !ue->sess ||
+        !loadgen_self()->gtpu)
+        return false;
+
+    qos_flow = test_qos_flow_find_by_qfi(ue->sess, 1);
+    if (!qos_flow)
+        return false;
+
+    /* Downlink data is buffered in the UPF and triggers Paging */
+    ue->paging_m_tmsi = ue->test_ue->nas_5gs_guti.m_tmsi;
+    ogs_ihash_set(loadgen_self()->m_tmsi_hash, &ue->paging_m_tmsi, ue);
+
+    ue->state = STATE_WAIT_PAGING;
+    if (test_gtpu_send_ping(loadgen_self()->gtpu,
+                qos_flow, TEST_PING_IPV4) != OGS_OK)
+        return false;
+
+    return true;
+}
+
+void loadgen_ue_paging(loadgen_ue_t *ue)
+{
+    ogs_assert(ue);
+
+    /* Paging is sent to every gNB in the TA. Take the first one */
+    if (!ue->running || ue->state != STATE_WAIT_PAGING)
+        return;
+
+    ogs_ihash_set(loadgen_self()->m_tmsi_hash, &ue->paging_m_tmsi, NULL);
+    ue->paging_m_tmsi = 0;
+
+    send_service_request(ue, OGS_NAS_SERVICE_TYPE_MOBILE_TERMINATED_SERVICES);
+}
+
+static bool start_handover(loadgen_ue_t *ue)
+{
+    loadgen_context_t *self = loadgen_self();
+    loadgen_gnb_t *target = NULL;
+    uint32_t id;
+
+    if (ue->connection != LOADGEN_UE_CONNECTED || !ue->sess ||
+        self->num_of_gnb < 2)
+        return false;
+
+    /* Xn handover to the next gNB */
+    target = &self->gnb[(ue->gnb->index + 1) % self->num_of_gnb];
+    ue->gnb = target;
+    set_cell(ue);
+
+    id = next_ran_ue_id();
+    loadgen_ue_set_ran_ue_id(ue, id);
+    ue->test_ue->ran_ue_ngap_id = id;
+
+    ue->state = STATE_WAIT_PATH_SWITCH;
+    send_ran(ue, testngap_build_path_switch_request(ue->test_ue));
+
+    return true;
+}
+
+static bool start_deregistration(loadgen_ue_t *ue)
+{
+    ogs_pkbuf_t *nasbuf = NULL;
+
+    if (loadgen_self()->epc)
+        nasbuf = testemm_build_detach_request(ue->test_ue, 1);
+    else
+        nasbuf = testgmm_build_de_registration_request(ue->test_ue, 1);
+    ogs_assert(nasbuf);
+
+    ue->state = STATE_WAIT_RELEASE;
+
+    if (ue->connection == LOADGEN_UE_CONNECTED) {
+        send_nas(ue, nasbuf);
+        return true;
+    }
+
+    new_connection(ue);
+    if (loadgen_self()->epc)
+        send_ran(ue, test_s1ap_build_initial_ue_message(ue->test_ue, nasbuf,
+                    S1AP_RRC_Establishment_Cause_mo_Signalling, true));
+    else
+        send_ran(ue, testngap_build_initial_ue_message(
+                    ue->test_ue, nasbuf, true, false));
+
+    return true;
+}
+
+/***********************************************************************
+ * EPC procedures
+ */
+static bool start_attach(loadgen_ue_t *ue)
+{
+    test_ue_t *test_ue = ue->test_ue;
+    test_sess_t *sess = NULL;
+    ogs_pkbuf_t *esmbuf = NULL, *emmbuf = NULL;
+
+    if (!ue->sess) {
+        ue->sess = test_sess_add_by_apn(test_ue, (char *)loadgen_self()->dnn);
+        ogs_assert(ue->sess);
+    }
+    sess = ue->sess;
+
+    memset(&sess->pdn_connectivity_param,
+            0, sizeof(sess->pdn_connectivity_param));
+    sess->pdn_connectivity_param.eit = 1;
+    sess->pdn_connectivity_param.pco = 1;
+    esmbuf = testesm_build_pdn_connectivity_request(sess);
+    ogs_assert(esmbuf);
+
+    memset(&test_ue->attach_request_param,
+            0, sizeof(test_ue->attach_request_param));
+    test_ue->attach_request_param.ms_network_feature_support = 1;
+    emmbuf = testemm_build_attach_request(test_ue, esmbuf);
+    ogs_assert(emmbuf);
+
+    memset(&test_ue->initial_ue_param, 0, sizeof(test_ue->initial_ue_param));
+
+    new_connection(ue);
+    ue->state = STATE_WAIT_NAS;
+    send_ran(ue, test_s1ap_build_initial_ue_message(test_ue, emmbuf,
+                S1AP_RRC_Establishment_Cause_mo_Signalling, false));
+
+    return true;
+}
+
+/***********************************************************************
+ * Scenario
+ */
+static void begin(loadgen_ue_t *ue)
+{
+    loadgen_context_t *self = loadgen_self();
+    bool ok = false;
+
+    ogs_assert(ue);
+
+    if (ue->done)
+        return;
+
+    if (ue->step >= self->num_of_scenario) {
+        finish(ue);
+        return;
+    }
+
+    ue->start = ogs_get_monotonic_time();
+    ue->running = true;
+    ogs_timer_start(ue->timer, self->timeout);
+
+    switch (procedure(ue)) {
+    case LOADGEN_REGISTRATION:
+        ok = start_registration(ue);
+        break;
+    case LOADGEN_PDU_SESSION:
+        ok = start_pdu_session(ue);
+        break;
+    case LOADGEN_RELEASE:
+        ok = start_release(ue);
+        break;
+    case LOADGEN_SERVICE_REQUEST:
+        ok = start_service_request(ue);
+        break;
+    case LOADGEN_PAGING:
+        ok = start_paging(ue);
+        break;
+    case LOADGEN_HANDOVER:
+        ok = start_handover(ue);
+        break;
+    case LOADGEN_DEREGISTRATION:
+    case LOADGEN_DETACH:
+        ok = start_deregistration(ue);
+        break;
+    case LOADGEN_ATTACH:
+        ok = start_attach(ue);
+        break;
+    default:
+        ogs_assert_if_reached();
+    }
+
+    if (!ok) {
+        ogs_error("[%s] Cannot start %s in this state", UE_NAME(ue),
+                loadgen_procedure_name(procedure(ue)));
+        fail(ue, false);
+    }
+}
+
+static void timer_cb(void *data)
+{
+    loadgen_ue_t *ue = data;
+
+    ogs_assert(ue);
+
+    if (ue->running)
+        fail(ue, true);
+    else
+        begin(ue);
+}
+
+void loadgen_ue_start(loadgen_ue_t *ue)
+{
+    ogs_assert(ue);
+
+    loadgen_self()->started++;
+    begin(ue);
+}
+
+/***********************************************************************
+ * 5GC message handling
+ */
+static void gmm_recv(loadgen_ue_t *ue)
+{
+    test_ue_t *test_ue = ue->test_ue;
+
+    switch (test_ue->gmm_message_type) {
+    case OGS_NAS_5GS_IDENTITY_REQUEST:
+        send_nas(ue, testgmm_build_identity_response(test_ue));
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_REQUEST:
+        send_nas(ue, testgmm_build_authentication_response(test_ue));
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_COMMAND:
+        ogs_assert(ue->nasbuf);
+        send_nas(ue, testgmm_build_security_mode_complete(
+                    test_ue, ue->nasbuf));
+        ue->nasbuf = NULL;
+        break;
+    case OGS_NAS_5GS_REGISTRATION_ACCEPT:
+        send_ran(ue,
+                testngap_build_ue_radio_capability_info_indication(test_ue));
+        send_ran(ue, testngap_build_initial_context_setup_response(
+                    test_ue, false));
+        send_nas(ue, testgmm_build_registration_complete(test_ue));
+
+        complete(ue);
+        break;
+    case OGS_NAS_5GS_SERVICE_ACCEPT:
+        break;
+    case OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND:
+        /* Acknowledgement is requested for a new 5G-GUTI */
+        if (ue->ack_configuration_update) {
+            ue->ack_configuration_update = false;
+            send_nas(ue, testgmm_build_configuration_update_complete(
+                        test_ue));
+        }
+        break;
+    case OGS_NAS_5GS_DL_NAS_TRANSPORT:
+        if (test_ue->gsm_message_type ==
+                OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT)
+            fail(ue, false);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_REJECT:
+    case OGS_NAS_5GS_SERVICE_REJECT:
+    case OGS_NAS_5GS_AUTHENTICATION_REJECT:
+        fail(ue, false);
+        break;
+    default:
+        break;
+    }
+}
+
+void loadgen_ue_ngap_recv(loadgen_ue_t *ue, ogs_ngap_message_t *message)
+{
+    test_ue_t *test_ue = NULL;
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+    NGAP_ProcedureCode_t procedureCode;
+
+    ogs_assert(ue);
+    ogs_assert(message);
+
+    test_ue = ue->test_ue;
+    ogs_assert(test_ue);
+
+    if (ue->done)
+        return;
+
+    if (message->present == NGAP_NGAP_PDU_PR_initiatingMessage &&
+        message->choice.initiatingMessage->procedureCode ==
+            NGAP_ProcedureCode_id_Paging) {
+        loadgen_ue_paging(ue);
+        return;
+    }
+
+    test_ue->gmm_message_type = 0;
+    test_ue->gsm_message_type = 0;
+
+    testngap_dispatch(test_ue, message);
+    loadgen_ue_set_core_ue_id(ue, test_ue->amf_ue_ngap_id);
+
+    switch (message->present) {
+    case NGAP_NGAP_PDU_PR_initiatingMessage:
+        initiatingMessage = message->choice.initiatingMessage;
+        procedureCode = initiatingMessage->procedureCode;
+
+        switch (procedureCode) {
+        case NGAP_ProcedureCode_id_DownlinkNASTransport:
+            gmm_recv(ue);
+            break;
+        case NGAP_ProcedureCode_id_InitialContextSetup:
+            ue->connection = LOADGEN_UE_CONNECTED;
+            if (test_ue->gmm_message_type)
+                gmm_recv(ue);
+
+            if (ue->running && ue->state == STATE_WAIT_CONTEXT) {
+                ue->ack_configuration_update = true;
+                send_ran(ue, testngap_build_initial_context_setup_response(
+                            test_ue, ue->sess != NULL));
+                complete(ue);
+            }
+            break;
+        case NGAP_ProcedureCode_id_PDUSessionResourceSetup:
+            if (!ue->sess)
+                break;
+            send_ran(ue,
+                testngap_sess_build_pdu_session_resource_setup_response(
+                    ue->sess));
+            if (ue->running && ue->state == STATE_WAIT_SESSION)
+                complete(ue);
+            break;
+        case NGAP_ProcedureCode_id_UEContextRelease:
+            send_ran(ue, testngap_build_ue_context_release_complete(test_ue));
+            ue->connection = LOADGEN_UE_IDLE;
+            loadgen_ue_set_ran_ue_id(ue, 0);
+            loadgen_ue_set_core_ue_id(ue, 0);
+
+            if (ue->running) {
+                if (ue->state == STATE_WAIT_RELEASE)
+                    complete(ue);
+                else
+                    fail(ue, false);
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    case NGAP_NGAP_PDU_PR_successfulOutcome:
+        if (ue->running && ue->state == STATE_WAIT_PATH_SWITCH)
+            complete(ue);
+        break;
+    case NGAP_NGAP_PDU_PR_unsuccessfulOutcome:
+        if (ue->running)
+            fail(ue, false);
+        break;
+    default:
+        break;
+    }
+}
+
+/***********************************************************************
+ * EPC message handling
+ */
+static void emm_recv(loadgen_ue_t *ue)
+{
+    test_ue_t *test_ue = ue->test_ue;
+    test_bearer_t *bearer = NULL;
+    ogs_pkbuf_t *esmbuf = NULL;
+
+    if (test_ue->esm_message_type == OGS_NAS_EPS_ESM_INFORMATION_REQUEST) {
+        ogs_assert(ue->sess);
+        send_nas(ue, testesm_build_esm_information_response(ue->sess));
+        return;
+    }
+
+    switch (test_ue->emm_message_type) {
+    case OGS_NAS_EPS_IDENTITY_REQUEST:
+        send_nas(ue, testemm_build_identity_response(test_ue));
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_REQUEST:
+        send_nas(ue, testemm_build_authentication_response(test_ue));
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_COMMAND:
+        test_ue->mobile_identity_imeisv_presence = true;
+        send_nas(ue, testemm_build_security_mode_complete(test_ue));
+        break;
+    case OGS_NAS_EPS_ATTACH_ACCEPT:
+        bearer = test_bearer_find_by_ue_ebi(test_ue, 5);
+        if (!bearer) {
+            fail(ue, false);
+            break;
+        }
+
+        send_ran(ue,
+                tests1ap_build_ue_radio_capability_info_indication(test_ue));
+        send_ran(ue, test_s1ap_build_initial_context_setup_response(test_ue));
+
+        esmbuf = testesm_build_activate_default_eps_bearer_context_accept(
+                bearer, false);
+        ogs_assert(esmbuf);
+        send_nas(ue, testemm_build_attach_complete(test_ue, esmbuf));
+
+        complete(ue);
+        break;
+    case OGS_NAS_EPS_ATTACH_REJECT:
+    case OGS_NAS_EPS_SERVICE_REJECT:
+    case OGS_NAS_EPS_AUTHENTICATION_REJECT:
+        fail(ue, false);
+        break;
+    default:
+        break;
+    }
+}
+
+void loadgen_ue_s1ap_recv(loadgen_ue_t *ue, ogs_s1ap_message_t *message)
+{
+    test_ue_t *test_ue = NULL;
+    S1AP_InitiatingMessage_t *initiatingMessage = NULL;
+
+    ogs_assert(ue);
+    ogs_assert(message);
+
+    test_ue = ue->test_ue;
+    ogs_assert(test_ue);
+
+    if (ue->done)
+        return;
+
+    test_ue->emm_message_type = 0;
+    test_ue->esm_message_type = 0;
+
+    tests1ap_dispatch(test_ue, message);
+    loadgen_ue_set_core_ue_id(ue, test_ue->mme_ue_s1ap_id);
+
+    if (message->present != S1AP_S1AP_PDU_PR_initiatingMessage)
+        return;
+
+    initiatingMessage = message->choice.initiatingMessage;
+
+    switch (initiatingMessage->procedureCode) {
+    case S1AP_ProcedureCode_id_downlinkNASTransport:
+        emm_recv(ue);
+        break;
+    case S1AP_ProcedureCode_id_InitialContextSetup:
+        ue->connection = LOADGEN_UE_CONNECTED;
+        if (test_ue->emm_message_type) {
+            emm_recv(ue);
+        } else if (ue->running && ue->state == STATE_WAIT_CONTEXT) {
+            send_ran(ue,
+                test_s1ap_build_initial_context_setup_response(test_ue));
+            complete(ue);
+        }
+        break;
+    case S1AP_ProcedureCode_id_UEContextRelease:
+        send_ran(ue, test_s1ap_build_ue_context_release_complete(test_ue));
+        ue->connection = LOADGEN_UE_IDLE;
+        loadgen_ue_set_ran_ue_id(ue, 0);
+        loadgen_ue_set_core_ue_id(ue, 0);
+
+        if (ue->running) {
+            if (ue->state == STATE_WAIT_RELEASE)
+                complete(ue);
+            else
+                fail(ue, false);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/***********************************************************************
+ * Context
+ */
+void loadgen_ue_set_ran_ue_id(loadgen_ue_t *ue, uint32_t ran_ue_id)
+{
+    ogs_ihash_t *hash = loadgen_self()->ran_ue_id_hash;
+
+    ogs_assert(ue);
+
+    if (ue->ran_ue_id)
+        ogs_ihash_set(hash, &ue->ran_ue_id, NULL);
+
+    ue->ran_ue_id = ran_ue_id;
+
+    if (ue->ran_ue_id)
+        ogs_ihash_set(hash, &ue->ran_ue_id, ue);
+}
+
+void loadgen_ue_set_core_ue_id(loadgen_ue_t *ue, uint64_t core_ue_id)
+{
+    ogs_ihash_t *hash = loadgen_self()->core_ue_id_hash;
+
+    ogs_assert(ue);
+
+    if (ue->core_ue_id == core_ue_id)
+        return;
+
+    if (ue->core_ue_id)
+        ogs_ihash_set(hash, &ue->core_ue_id, NULL);
+
+    ue->core_ue_id = core_ue_id;
+
+    if (ue->core_ue_id)
+        ogs_ihash_set(hash, &ue->core_ue_id, ue);
+}
+
+int loadgen_ue_init(loadgen_ue_t *ue)
+{
+    loadgen_context_t *self = loadgen_self();
+    ogs_nas_5gs_mobile_identity_suci_t mobile_identity_suci;
+    char msin[OGS_MAX_IMSI_BCD_LEN+1];
+    test_ue_t *test_ue = NULL;
+    int i;
+
+    ogs_assert(ue);
+    ogs_assert(self->msin);
+
+    ogs_snprintf(msin, sizeof(msin), "%010llu",
+            (unsigned long long)(atoll(self->msin) + ue->index));
+    if (strlen(msin) != 10) {
+        ogs_error("Invalid MSIN [%s]", msin);
+        return OGS_ERROR;
+    }
+
+    memset(&mobile_identity_suci, 0, sizeof(mobile_identity_suci));
+
+    mobile_identity_suci.h.supi_format = OGS_NAS_5GS_SUPI_FORMAT_IMSI;
+    mobile_identity_suci.h.type = OGS_NAS_5GS_MOBILE_IDENTITY_SUCI;
+    mobile_identity_suci.routing_indicator1 = 0;
+    mobile_identity_suci.routing_indicator2 = 0xf;
+    mobile_identity_suci.routing_indicator3 = 0xf;
+    mobile_identity_suci.routing_indicator4 = 0xf;
+    mobile_identity_suci.protection_scheme_id = OGS_NAS_5GS_NULL_SCHEME;
+    mobile_identity_suci.home_network_pki_value = 0;
+    for (i = 0; i < 5; i++)
+        mobile_identity_suci.scheme_output[i] =
+            ((msin[i*2+1] - '0') << 4) | (msin[i*2] - '0');
+
+    test_ue = test_ue_add_by_suci(&mobile_identity_suci, 13);
+    if (!test_ue) {
+        ogs_error("Cannot add UE [%s]", msin);
+        return OGS_ERROR;
+    }
+    ue->test_ue = test_ue;
+
+    ue->gnb = &self->gnb[ue->index % self->num_of_gnb];
+    set_cell(ue);
+
+    if (self->epc) {
+        test_ue->nas.ksi = OGS_NAS_KSI_NO_KEY_IS_AVAILABLE;
+        test_ue->nas.value = OGS_NAS_ATTACH_TYPE_EPS_ATTACH;
+    } else {
+        test_ue->nas.registration.type = OGS_NAS_KSI_NO_KEY_IS_AVAILABLE;
+        test_ue->nas.registration.follow_on_request = 1;
+        test_ue->nas.registration.value =
+            OGS_NAS_5GS_REGISTRATION_TYPE_INITIAL;
+    }
+
+    test_ue->k_string = "465b5ce8b199b49faa5f0a2ee238a6bc";
+    test_ue->opc_string = "e8ed289deba952e4283b54e88e6183ca";
+    OGS_HEX(test_ue->k_string, strlen(test_ue->k_string), test_ue->k);
+    OGS_HEX(test_ue->opc_string, strlen(test_ue->opc_string), test_ue->opc);
+
+    if (self->provision) {
+        bson_t *doc = test_db_new_simple(test_ue);
+        ogs_assert(doc);
+        if (test_db_insert_ue(test_ue, doc) != OGS_OK) {
+            ogs_error("[%s] Cannot insert subscriber", UE_NAME(ue));
+            return OGS_ERROR;
+        }
+    }
+
+    ue->timer = ogs_timer_add(ogs_app()->timer_mgr, timer_cb, ue);
+    ogs_assert(ue->timer);
+
+    return OGS_OK;
+}
+
+void loadgen_ue_final(loadgen_ue_t *ue)
+{
+    ogs_assert(ue);
+
+    loadgen_ue_set_ran_ue_id(ue, 0);
+    loadgen_ue_set_core_ue_id(ue, 0);
+
+    if (ue->paging_m_tmsi)
+        ogs_ihash_set(loadgen_self()->m_tmsi_hash, &ue->paging_m_tmsi, NULL);
+    ue->paging_m_tmsi = 0;
+
+    if (ue->nasbuf)
+        ogs_pkbuf_free(ue->nasbuf);
+    ue->nasbuf = NULL;
+
+    if (ue->timer)
+        ogs_timer_delete(ue->timer);
+    ue->timer = NULL;
+
+    if (ue->test_ue) {
+        if (loadgen_self()->provision)
+            test_db_remove_ue(ue->test_ue);
+        test_ue_remove(ue->test_ue);
+    }
+    ue->test_ue = NULL;
+    ue->sess = NULL;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-common.h"
+
+/*
+ * overload.yaml sets 'max.ue: 200' and 'amf.overload.pool: 1',
+ * so the AMF is overloaded with 2 UE contexts and recovers with 1.
+ */
+#define NUM_OF_TEST_UE 3
+
+static void send_registration_request(abts_case *tc,
+        ogs_socknode_t *ngap, test_ue_t *test_ue)
+{
+    int rv;
+    ogs_pkbuf_t *gmmbuf;
+    ogs_pkbuf_t *sendbuf;
+
+    test_ue->registration_request_param.gmm_capability = 1;
+    gmmbuf = testgmm_build_registration_request(test_ue, NULL);
+    ABTS_PTR_NOTNULL(tc, gmmbuf);
+    sendbuf = testngap_build_initial_ue_message(test_ue, gmmbuf, false, true);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testgnb_ngap_send(ngap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+}
+
+static void send_authentication_failure(abts_case *tc,
+        ogs_socknode_t *ngap, test_ue_t *test_ue)
+{
+    int rv;
+    ogs_pkbuf_t *gmmbuf;
+    ogs_pkbuf_t *sendbuf;
+    ogs_pkbuf_t *recvbuf;
+
+    /* Send Authentication failure - MAC failure */
+    gmmbuf = testgmm_build_authentication_failure(
+            test_ue, OGS_5GMM_CAUSE_MAC_FAILURE, 0);
+    ABTS_PTR_NOTNULL(tc, gmmbuf);
+    sendbuf = testngap_build_uplink_nas_transport(test_ue, gmmbuf);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testgnb_ngap_send(ngap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    /* Receive Authentication reject */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue, recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_5GS_AUTHENTICATION_REJECT, test_ue->gmm_message_type);
+
+    /* Receive UEContextReleaseCommand */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue, recvbuf);
+    ABTS_INT_EQUAL(tc,
+            NGAP_ProcedureCode_id_UEContextRelease,
+            test_ue->ngap_procedure_code);
+
+    /* Send UEContextReleaseComplete */
+    sendbuf = testngap_build_ue_context_release_complete(test_ue);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testgnb_ngap_send(ngap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+}
+
+static void test1_func(abts_case *tc, void *data)
+{
+    int rv, i;
+    ogs_socknode_t *ngap;
+    ogs_pkbuf_t *sendbuf;
+    ogs_pkbuf_t *recvbuf;
+
+    ogs_nas_5gs_mobile_identity_suci_t mobile_identity_suci;
+    test_ue_t *test_ue[NUM_OF_TEST_UE];
+
+    bson_t *doc = NULL;
+
+    /* gNB connects to AMF */
+    ngap = testngap_client(AF_INET);
+    ABTS_PTR_NOTNULL(tc, ngap);
+
+    for (i = 0; i < NUM_OF_TEST_UE; i++) {
+        uint64_t imsi_index;
+
+        /* Setup Test UE Context */
+        memset(&mobile_identity_suci, 0, sizeof(mobile_identity_suci));
+
+        mobile_identity_suci.h.supi_format = OGS_NAS_5GS_SUPI_FORMAT_IMSI;
+        mobile_identity_suci.h.type = OGS_NAS_5GS_MOBILE_IDENTITY_SUCI;
+        mobile_identity_suci.routing_indicator1 = 0;
+        mobile_identity_suci.routing_indicator2 = 0xf;
+        mobile_identity_suci.routing_indicator3 = 0xf;
+        mobile_identity_suci.routing_indicator4 = 0xf;
+        mobile_identity_suci.protection_scheme_id = OGS_NAS_5GS_NULL_SCHEME;
+        mobile_identity_suci.home_network_pki_value = 0;
+
+        imsi_index = i + 1;
+        ogs_uint64_to_buffer(imsi_index, 5, mobile_identity_suci.scheme_output);
+
+        test_ue[i] = test_ue_add_by_suci(&mobile_identity_suci, 13);
+        ogs_assert(test_ue[i]);
+
+        /* Multiple RAN-UE-NGAP-ID */
+        test_ue[i]->ran_ue_ngap_id = i * 10;
+
+        test_ue[i]->nr_cgi.cell_id = 0x40001;
+
+        test_ue[i]->nas.registration.type = OGS_NAS_KSI_NO_KEY_IS_AVAILABLE;
+        test_ue[i]->nas.registration.follow_on_request = 1;
+        test_ue[i]->nas.registration.value =
+            OGS_NAS_5GS_REGISTRATION_TYPE_INITIAL;
+
+        test_ue[i]->k_string = "465b5ce8b199b49faa5f0a2ee238a6bc";
+        test_ue[i]->opc_string = "e8ed289deba952e4283b54e88e6183ca";
+
+        /********** Insert Subscriber in Database */
+        doc = test_db_new_simple(test_ue[i]);
+        ABTS_PTR_NOTNULL(tc, doc);
+        ABTS_INT_EQUAL(tc, OGS_OK, test_db_insert_ue(test_ue[i], doc));
+    }
+
+    /* Send NG-Setup Reqeust */
+    sendbuf = testngap_build_ng_setup_request(0x4000, 22);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testgnb_ngap_send(ngap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    /* Receive NG-Setup Response */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[0], recvbuf);
+
+    /* UE#1 : Send Registration request */
+    send_registration_request(tc, ngap, test_ue[0]);
+
+    /* UE#1 : Receive Authentication request */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[0], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_5GS_AUTHENTICATION_REQUEST, test_ue[0]->gmm_message_type);
+
+    /* UE#2 : Send Registration request */
+    send_registration_request(tc, ngap, test_ue[1]);
+
+    /* Receive Overload Start */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[1], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            NGAP_ProcedureCode_id_OverloadStart,
+            test_ue[1]->ngap_procedure_code);
+
+    /* UE#2 : Receive Authentication request */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[1], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_5GS_AUTHENTICATION_REQUEST, test_ue[1]->gmm_message_type);
+
+    /* UE#3 : Send Registration request */
+    send_registration_request(tc, ngap, test_ue[2]);
+
+    /* UE#3 : Receive Registration reject */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[2], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_5GS_REGISTRATION_REJECT, test_ue[2]->gmm_message_type);
+
+    /* UE#3 : Receive UEContextReleaseCommand */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[2], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            NGAP_ProcedureCode_id_UEContextRelease,
+            test_ue[2]->ngap_procedure_code);
+
+    /* UE#3 : Send UEContextReleaseComplete */
+    sendbuf = testngap_build_ue_context_release_complete(test_ue[2]);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testgnb_ngap_send(ngap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    /* UE#2 : Release the UE context */
+    send_authentication_failure(tc, ngap, test_ue[1]);
+
+    /* Receive Overload Stop */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[1], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            NGAP_ProcedureCode_id_OverloadStop,
+            test_ue[1]->ngap_procedure_code);
+
+    /* UE#1 : Release the UE context */
+    send_authentication_failure(tc, ngap, test_ue[0]);
+
+    /* UE#3 : Send Registration request */
+    send_registration_request(tc, ngap, test_ue[2]);
+
+    /* UE#3 : Receive Authentication request */
+    recvbuf = testgnb_ngap_read(ngap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    testngap_recv(test_ue[2], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_5GS_AUTHENTICATION_REQUEST, test_ue[2]->gmm_message_type);
+
+    /* UE#3 : Release the UE context */
+    send_authentication_failure(tc, ngap, test_ue[2]);
+
+    ogs_msleep(300);
+
+    /********** Remove Subscriber in Database */
+    for (i = 0; i < NUM_OF_TEST_UE; i++)
+        ABTS_INT_EQUAL(tc, OGS_OK, test_db_remove_ue(test_ue[i]));
+
+    /* gNB disonncect from AMF */
+    testgnb_ngap_close(ngap);
+
+    /* Clear Test UE Context */
+    test_ue_remove_all();
+}
+
+abts_suite *test_5gc(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, test1_func, NULL);
+
+    return suite;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-common.h"
+
+/*
+ * overload.yaml sets 'max.ue: 200' and 'mme.overload.pool: 1',
+ * so the MME is overloaded with 2 UE contexts and recovers with 1.
+ */
+#define NUM_OF_TEST_UE 3
+
+static void send_attach_request(abts_case *tc,
+        ogs_socknode_t *s1ap, test_ue_t *test_ue)
+{
+    int rv;
+    ogs_pkbuf_t *emmbuf;
+    ogs_pkbuf_t *esmbuf;
+    ogs_pkbuf_t *sendbuf;
+    test_sess_t *sess = NULL;
+
+    sess = test_sess_find_by_apn(test_ue, "internet");
+    ogs_assert(sess);
+
+    memset(&sess->pdn_connectivity_param,
+            0, sizeof(sess->pdn_connectivity_param));
+    sess->pdn_connectivity_param.eit = 1;
+    sess->pdn_connectivity_param.pco = 1;
+    esmbuf = testesm_build_pdn_connectivity_request(sess);
+    ABTS_PTR_NOTNULL(tc, esmbuf);
+
+    memset(&test_ue->attach_request_param,
+            0, sizeof(test_ue->attach_request_param));
+    test_ue->attach_request_param.drx_parameter = 1;
+    test_ue->attach_request_param.ms_network_capability = 1;
+    test_ue->attach_request_param.tmsi_status = 1;
+    test_ue->attach_request_param.mobile_station_classmark_2 = 1;
+    test_ue->attach_request_param.ue_usage_setting = 1;
+    emmbuf = testemm_build_attach_request(test_ue, esmbuf);
+    ABTS_PTR_NOTNULL(tc, emmbuf);
+
+    memset(&test_ue->initial_ue_param, 0, sizeof(test_ue->initial_ue_param));
+    sendbuf = test_s1ap_build_initial_ue_message(
+            test_ue, emmbuf, S1AP_RRC_Establishment_Cause_mo_Signalling, false);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testenb_s1ap_send(s1ap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+}
+
+static void send_authentication_failure(abts_case *tc,
+        ogs_socknode_t *s1ap, test_ue_t *test_ue)
+{
+    int rv;
+    ogs_pkbuf_t *emmbuf;
+    ogs_pkbuf_t *sendbuf;
+    ogs_pkbuf_t *recvbuf;
+
+    /* Send Authentication failure - MAC failure */
+    emmbuf = testemm_build_authentication_failure(
+            test_ue, EMM_CAUSE_MAC_FAILURE, 0);
+    ABTS_PTR_NOTNULL(tc, emmbuf);
+    sendbuf = test_s1ap_build_uplink_nas_transport(test_ue, emmbuf);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testenb_s1ap_send(s1ap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    /* Receive Authentication reject */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue, recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_EPS_AUTHENTICATION_REJECT, test_ue->emm_message_type);
+
+    /* Receive UE Context Release Command */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue, recvbuf);
+    ABTS_INT_EQUAL(tc,
+            S1AP_ProcedureCode_id_UEContextRelease,
+            test_ue->s1ap_procedure_code);
+
+    /* Send UE Context Release Complete */
+    sendbuf = test_s1ap_build_ue_context_release_complete(test_ue);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testenb_s1ap_send(s1ap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+}
+
+static void test1_func(abts_case *tc, void *data)
+{
+    int rv, i;
+    ogs_socknode_t *s1ap;
+    ogs_pkbuf_t *sendbuf;
+    ogs_pkbuf_t *recvbuf;
+
+    ogs_nas_5gs_mobile_identity_suci_t mobile_identity_suci;
+    test_ue_t *test_ue[NUM_OF_TEST_UE];
+    test_sess_t *sess = NULL;
+
+    bson_t *doc = NULL;
+
+    /* eNB connects to MME */
+    s1ap = tests1ap_client(AF_INET);
+    ABTS_PTR_NOTNULL(tc, s1ap);
+
+    /* Send S1-Setup Reqeust */
+    sendbuf = test_s1ap_build_s1_setup_request(
+            S1AP_ENB_ID_PR_macroENB_ID, 0x54f64);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testenb_s1ap_send(s1ap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    /* Receive S1-Setup Response */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(NULL, recvbuf);
+
+    for (i = 0; i < NUM_OF_TEST_UE; i++) {
+        uint64_t imsi_index;
+
+        /* Setup Test UE & Session Context */
+        memset(&mobile_identity_suci, 0, sizeof(mobile_identity_suci));
+
+        mobile_identity_suci.h.supi_format = OGS_NAS_5GS_SUPI_FORMAT_IMSI;
+        mobile_identity_suci.h.type = OGS_NAS_5GS_MOBILE_IDENTITY_SUCI;
+        mobile_identity_suci.routing_indicator1 = 0;
+        mobile_identity_suci.routing_indicator2 = 0xf;
+        mobile_identity_suci.routing_indicator3 = 0xf;
+        mobile_identity_suci.routing_indicator4 = 0xf;
+        mobile_identity_suci.protection_scheme_id = OGS_NAS_5GS_NULL_SCHEME;
+        mobile_identity_suci.home_network_pki_value = 0;
+
+        imsi_index = i + 1;
+        ogs_uint64_to_buffer(imsi_index, 5, mobile_identity_suci.scheme_output);
+
+        test_ue[i] = test_ue_add_by_suci(&mobile_identity_suci, 13);
+        ogs_assert(test_ue[i]);
+
+        /* Multiple eNB-UE-S1AP-UD */
+        test_ue[i]->enb_ue_s1ap_id = i * 10;
+
+        test_ue[i]->e_cgi.cell_id = 0x54f6401;
+        test_ue[i]->nas.ksi = OGS_NAS_KSI_NO_KEY_IS_AVAILABLE;
+        test_ue[i]->nas.value = OGS_NAS_ATTACH_TYPE_COMBINED_EPS_IMSI_ATTACH;
+
+        test_ue[i]->k_string = "465b5ce8b199b49faa5f0a2ee238a6bc";
+        test_ue[i]->opc_string = "e8ed289deba952e4283b54e88e6183ca";
+
+        sess = test_sess_add_by_apn(test_ue[i], "internet");
+        ogs_assert(sess);
+
+        /********** Insert Subscriber in Database */
+        doc = test_db_new_simple(test_ue[i]);
+        ABTS_PTR_NOTNULL(tc, doc);
+        ABTS_INT_EQUAL(tc, OGS_OK, test_db_insert_ue(test_ue[i], doc));
+    }
+
+    /* UE#1 : Send Attach Request */
+    send_attach_request(tc, s1ap, test_ue[0]);
+
+    /* UE#1 : Receive Authentication Request */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[0], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_EPS_AUTHENTICATION_REQUEST, test_ue[0]->emm_message_type);
+
+    /* UE#2 : Send Attach Request */
+    send_attach_request(tc, s1ap, test_ue[1]);
+
+    /* Receive Overload Start */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[1], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            S1AP_ProcedureCode_id_OverloadStart,
+            test_ue[1]->s1ap_procedure_code);
+
+    /* UE#2 : Receive Authentication Request */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[1], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_EPS_AUTHENTICATION_REQUEST, test_ue[1]->emm_message_type);
+
+    /* UE#3 : Send Attach Request */
+    send_attach_request(tc, s1ap, test_ue[2]);
+
+    /* UE#3 : Receive Attach Reject */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[2], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_EPS_ATTACH_REJECT, test_ue[2]->emm_message_type);
+
+    /* UE#3 : Receive UE Context Release Command */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[2], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            S1AP_ProcedureCode_id_UEContextRelease,
+            test_ue[2]->s1ap_procedure_code);
+
+    /* UE#3 : Send UE Context Release Complete */
+    sendbuf = test_s1ap_build_ue_context_release_complete(test_ue[2]);
+    ABTS_PTR_NOTNULL(tc, sendbuf);
+    rv = testenb_s1ap_send(s1ap, sendbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    /* UE#2 : Release the UE context */
+    send_authentication_failure(tc, s1ap, test_ue[1]);
+
+    /* Receive Overload Stop */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[1], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            S1AP_ProcedureCode_id_OverloadStop,
+            test_ue[1]->s1ap_procedure_code);
+
+    /* UE#1 : Release the UE context */
+    send_authentication_failure(tc, s1ap, test_ue[0]);
+
+    /* UE#3 : Send Attach Request */
+    send_attach_request(tc, s1ap, test_ue[2]);
+
+    /* UE#3 : Receive Authentication Request */
+    recvbuf = testenb_s1ap_read(s1ap);
+    ABTS_PTR_NOTNULL(tc, recvbuf);
+    tests1ap_recv(test_ue[2], recvbuf);
+    ABTS_INT_EQUAL(tc,
+            OGS_NAS_EPS_AUTHENTICATION_REQUEST, test_ue[2]->emm_message_type);
+
+    /* UE#3 : Release the UE context */
+    send_authentication_failure(tc, s1ap, test_ue[2]);
+
+    ogs_msleep(300);
+
+    /********** Remove Subscriber in Database */
+    for (i = 0; i < NUM_OF_TEST_UE; i++)
+        ABTS_INT_EQUAL(tc, OGS_OK, test_db_remove_ue(test_ue[i]));
+
+    /* eNB disonncect from MME */
+    testenb_s1ap_close(s1ap);
+
+    test_ue_remove_all();
+}
+
+abts_suite *test_epc(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, test1_func, NULL);
+
+    return suite;
+}
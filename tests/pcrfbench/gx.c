@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pcrfbench.h"
+
+static struct disp_hdl *hdl_gx_fb = NULL;
+
+static void pcrfbench_gx_cca_cb(void *data, struct msg **msg);
+
+static int pcrfbench_gx_fb_cb(struct msg **msg, struct avp *avp,
+        struct session *sess, void *opaque, enum disp_action *act)
+{
+    /* Re-Auth-Request is not expected without Rx */
+    ogs_warn("Unexpected message received!");
+
+    return ENOTSUP;
+}
+
+static void send_ccr(pcrfbench_worker_t *worker)
+{
+    pcrfbench_context_t *self = pcrfbench_self();
+    pcrfbench_subscriber_t *subscriber = NULL;
+    int ret;
+
+    struct msg *req = NULL;
+    struct avp *avp;
+    struct avp *avpch1;
+    union avp_value val;
+    struct session *session = NULL;
+    int new;
+
+    ogs_assert(worker);
+    subscriber = worker->subscriber;
+    ogs_assert(subscriber);
+    ogs_assert(subscriber->test_ue);
+
+    /* Create the request */
+    ret = fd_msg_new(ogs_diam_gx_cmd_ccr, MSGFL_ALLOC_ETEID, &req);
+    ogs_assert(ret == 0);
+
+    if (worker->request == PCRFBENCH_CCR_INITIAL) {
+        os0_t sid;
+        size_t sidlen;
+
+        /* Create a new session */
+        #define PCRFBENCH_GX_SID_OPT  "app_gx"
+        ret = fd_msg_new_session(req, (os0_t)PCRFBENCH_GX_SID_OPT,
+                CONSTSTRLEN(PCRFBENCH_GX_SID_OPT));
+        ogs_assert(ret == 0);
+        ret = fd_msg_sess_get(fd_g_config->cnf_dict, req, &session, NULL);
+        ogs_assert(ret == 0);
+        ret = fd_sess_getsid(session, &sid, &sidlen);
+        ogs_assert(ret == 0);
+
+        ogs_assert(!worker->sid);
+        worker->sid = ogs_strdup((char *)sid);
+        ogs_assert(worker->sid);
+    } else {
+        size_t sidlen;
+
+        /* Retrieve session by Session-Id */
+        ogs_assert(worker->sid);
+        sidlen = strlen(worker->sid);
+        ret = fd_sess_fromsid_msg(
+                (os0_t)worker->sid, sidlen, &session, &new);
+        ogs_assert(ret == 0);
+
+        ret = ogs_diam_message_session_id_set(
+                req, (os0_t)worker->sid, sidlen);
+        ogs_assert(ret == 0);
+        ret = fd_msg_sess_set(req, session);
+        ogs_assert(ret == 0);
+    }
+
+    /* Set Origin-Host & Origin-Realm */
+    ret = fd_msg_add_origin(req, 0);
+    ogs_assert(ret == 0);
+
+    /* Set the Destination-Realm AVP */
+    ret = fd_msg_avp_new(ogs_diam_destination_realm, 0, &avp);
+    ogs_assert(ret == 0);
+    val.os.data = (unsigned char *)(fd_g_config->cnf_diamrlm);
+    val.os.len  = strlen(fd_g_config->cnf_diamrlm);
+    ret = fd_msg_avp_setvalue(avp, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+    ogs_assert(ret == 0);
+
+    /* Set the Auth-Application-Id AVP */
+    ret = fd_msg_avp_new(ogs_diam_auth_application_id, 0, &avp);
+    ogs_assert(ret == 0);
+    val.i32 = OGS_DIAM_GX_APPLICATION_ID;
+    ret = fd_msg_avp_setvalue(avp, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+    ogs_assert(ret == 0);
+
+    /* Set CC-Request-Type, CC-Request-Number */
+    ret = fd_msg_avp_new(ogs_diam_gx_cc_request_type, 0, &avp);
+    ogs_assert(ret == 0);
+    val.i32 = worker->request == PCRFBENCH_CCR_INITIAL ?
+        OGS_DIAM_GX_CC_REQUEST_TYPE_INITIAL_REQUEST :
+        OGS_DIAM_GX_CC_REQUEST_TYPE_TERMINATION_REQUEST;
+    ret = fd_msg_avp_setvalue(avp, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+    ogs_assert(ret == 0);
+
+    ret = fd_msg_avp_new(ogs_diam_gx_cc_request_number, 0, &avp);
+    ogs_assert(ret == 0);
+    val.i32 = worker->request == PCRFBENCH_CCR_INITIAL ? 0 : 1;
+    ret = fd_msg_avp_setvalue(avp, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+    ogs_assert(ret == 0);
+
+    /* Set Subscription-Id */
+    ret = fd_msg_avp_new(ogs_diam_gx_subscription_id, 0, &avp);
+    ogs_assert(ret == 0);
+
+    ret = fd_msg_avp_new(ogs_diam_gx_subscription_id_type, 0, &avpch1);
+    ogs_assert(ret == 0);
+    val.i32 = OGS_DIAM_GX_SUBSCRIPTION_ID_TYPE_END_USER_IMSI;
+    ret = fd_msg_avp_setvalue (avpch1, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add (avp, MSG_BRW_LAST_CHILD, avpch1);
+    ogs_assert(ret == 0);
+
+    ret = fd_msg_avp_new(ogs_diam_gx_subscription_id_data, 0, &avpch1);
+    ogs_assert(ret == 0);
+    val.os.data = (uint8_t *)subscriber->test_ue->imsi;
+    val.os.len  = strlen(subscriber->test_ue->imsi);
+    ret = fd_msg_avp_setvalue (avpch1, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add (avp, MSG_BRW_LAST_CHILD, avpch1);
+    ogs_assert(ret == 0);
+
+    ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+    ogs_assert(ret == 0);
+
+    if (worker->request == PCRFBENCH_CCR_INITIAL) {
+        /* Set Framed-IP-Address */
+        ret = fd_msg_avp_new(ogs_diam_gx_framed_ip_address, 0, &avp);
+        ogs_assert(ret == 0);
+        val.os.data = (uint8_t *)&subscriber->ipv4;
+        val.os.len = OGS_IPV4_LEN;
+        ret = fd_msg_avp_setvalue(avp, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+        ogs_assert(ret == 0);
+
+        /* Set IP-Can-Type */
+        ret = fd_msg_avp_new(ogs_diam_gx_ip_can_type, 0, &avp);
+        ogs_assert(ret == 0);
+        val.i32 = OGS_DIAM_GX_IP_CAN_TYPE_3GPP_EPS;
+        ret = fd_msg_avp_setvalue(avp, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+        ogs_assert(ret == 0);
+
+        /* Set RAT-Type */
+        ret = fd_msg_avp_new(ogs_diam_gx_rat_type, 0, &avp);
+        ogs_assert(ret == 0);
+        val.i32 = OGS_DIAM_GX_RAT_TYPE_EUTRAN;
+        ret = fd_msg_avp_setvalue(avp, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+        ogs_assert(ret == 0);
+    }
+
+    /* Set Called-Station-Id */
+    ret = fd_msg_avp_new(ogs_diam_gx_called_station_id, 0, &avp);
+    ogs_assert(ret == 0);
+    val.os.data = (uint8_t *)self->apn;
+    val.os.len = strlen(self->apn);
+    ret = fd_msg_avp_setvalue(avp, &val);
+    ogs_assert(ret == 0);
+    ret = fd_msg_avp_add(req, MSG_BRW_LAST_CHILD, avp);
+    ogs_assert(ret == 0);
+
+    worker->start = ogs_get_monotonic_time();
+
+    /* Send the request */
+    ret = fd_msg_send(&req, pcrfbench_gx_cca_cb, worker);
+    ogs_assert(ret == 0);
+}
+
+/* Selects the next subscriber of the worker, or returns false when done */
+static bool next_subscriber(pcrfbench_worker_t *worker)
+{
+    pcrfbench_context_t *self = pcrfbench_self();
+
+    ogs_assert(worker);
+
+    if (worker->next >= self->num_of_subscriber) {
+        worker->round++;
+        worker->next = worker->index;
+    }
+    if (self->stopping || worker->round >= self->num_of_round ||
+        worker->next >= self->num_of_subscriber)
+        return false;
+
+    worker->subscriber = &self->subscriber[worker->next];
+    worker->next += self->num_of_worker;
+
+    return true;
+}
+
+static void worker_finish(pcrfbench_worker_t *worker)
+{
+    pcrfbench_context_t *self = pcrfbench_self();
+
+    ogs_assert(worker);
+
+    worker->done = true;
+
+    ogs_thread_mutex_lock(&self->lock);
+    self->finished++;
+    ogs_thread_mutex_unlock(&self->lock);
+}
+
+void pcrfbench_worker_start(pcrfbench_worker_t *worker)
+{
+    ogs_assert(worker);
+
+    worker->next = worker->index;
+    worker->round = 0;
+
+    if (!next_subscriber(worker)) {
+        worker_finish(worker);
+        return;
+    }
+
+    worker->request = PCRFBENCH_CCR_INITIAL;
+    send_ccr(worker);
+}
+
+static void pcrfbench_gx_cca_cb(void *data, struct msg **msg)
+{
+    pcrfbench_context_t *self = pcrfbench_self();
+    pcrfbench_worker_t *worker = data;
+    int ret;
+
+    struct avp *avp;
+    struct avp_hdr *hdr;
+    struct session *session = NULL;
+    uint32_t result_code = 0;
+    ogs_time_t latency;
+    int new;
+
+    ogs_assert(worker);
+    latency = ogs_get_monotonic_time() - worker->start;
+
+    ret = fd_msg_search_avp(*msg, ogs_diam_result_code, &avp);
+    ogs_assert(ret == 0);
+    if (avp) {
+        ret = fd_msg_avp_hdr(avp, &hdr);
+        ogs_assert(ret == 0);
+        result_code = hdr->avp_value->i32;
+    }
+
+    ogs_thread_mutex_lock(&self->lock);
+    if (result_code == ER_DIAMETER_SUCCESS)
+        test_histogram_add(&self->stats[worker->request].latency, latency);
+    else
+        self->stats[worker->request].failed++;
+    ogs_thread_mutex_unlock(&self->lock);
+
+    ret = fd_msg_sess_get(fd_g_config->cnf_dict, *msg, &session, &new);
+    ogs_assert(ret == 0);
+
+    ret = fd_msg_free(*msg);
+    ogs_assert(ret == 0);
+    *msg = NULL;
+
+    if (worker->request == PCRFBENCH_CCR_INITIAL &&
+            result_code == ER_DIAMETER_SUCCESS) {
+        worker->request = PCRFBENCH_CCR_TERMINATION;
+        send_ccr(worker);
+        return;
+    }
+
+    /* The session is over, and has no state in this process */
+    if (session) {
+        ret = fd_sess_reclaim(&session);
+        ogs_assert(ret == 0);
+    }
+    ogs_assert(worker->sid);
+    ogs_free(worker->sid);
+    worker->sid = NULL;
+
+    if (!next_subscriber(worker)) {
+        worker_finish(worker);
+        return;
+    }
+
+    worker->request = PCRFBENCH_CCR_INITIAL;
+    send_ccr(worker);
+}
+
+int pcrfbench_gx_init(void)
+{
+    int ret;
+    struct disp_when data;
+
+    /* Install objects definitions for this application */
+    ret = ogs_diam_gx_init();
+    ogs_assert(ret == 0);
+
+    /* Fallback CB if command != unexpected message received */
+    memset(&data, 0, sizeof(data));
+    data.app = ogs_diam_gx_application;
+
+    ret = fd_disp_register(pcrfbench_gx_fb_cb, DISP_HOW_APPID, &data, NULL,
+                &hdl_gx_fb);
+    ogs_assert(ret == 0);
+
+    /* Advertise the support for the application in the peer */
+    ret = fd_disp_app_support(ogs_diam_gx_application, ogs_diam_vendor, 1, 0);
+    ogs_assert(ret == 0);
+
+    return OGS_OK;
+}
+
+void pcrfbench_gx_final(void)
+{
+    if (hdl_gx_fb)
+        (void) fd_disp_unregister(&hdl_gx_fb, NULL);
+}
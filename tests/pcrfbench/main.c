@@ -0,0 +1,427 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <signal.h>
+
+#include "pcrfbench.h"
+
+static pcrfbench_context_t self;
+static ogs_diam_config_t diam_config;
+
+static volatile sig_atomic_t stopped = 0;
+
+pcrfbench_context_t *pcrfbench_self(void)
+{
+    return &self;
+}
+
+static void show_help(const char *name)
+{
+    printf("Usage: %s [options]\n"
+        "Options:\n"
+       "   -c filename    : set configuration file\n"
+       "   -l filename    : set logging file\n"
+       "   -e level       : set global log-level (default:info)\n"
+       "   -m domain      : set log-domain (e.g. mme:sgw:gtp)\n"
+       "   -n number      : number of subscribers (default:1000)\n"
+       "   -w number      : number of concurrent sessions (default:64)\n"
+       "   -r number      : sessions per subscriber (default:10)\n"
+       "   -i msin        : MSIN of the first subscriber "
+                            "(default:0000021309)\n"
+       "   -a apn         : APN (default:internet)\n"
+       "   -L address     : local Diameter address (default:127.0.0.1)\n"
+       "   -P address     : PCRF Diameter address (default:127.0.0.9)\n"
+       "   -N             : do not insert subscribers in the database\n"
+       "   -h             : show this message and exit\n"
+       "\n", name);
+}
+
+static void sig_handler(int signum)
+{
+    stopped = 1;
+}
+
+static void pcrfbench_diam_config(void)
+{
+    memset(&diam_config, 0, sizeof(ogs_diam_config_t));
+
+    diam_config.cnf_diamid = PCRFBENCH_IDENTITY;
+    diam_config.cnf_diamrlm = "localdomain";
+    diam_config.cnf_port = DIAMETER_PORT;
+    diam_config.cnf_port_tls = DIAMETER_SECURE_PORT;
+    diam_config.cnf_flags.no_sctp = 1;
+    diam_config.cnf_addr = self.local_addr;
+
+    diam_config.ext[diam_config.num_of_ext].module =
+        FD_EXT_DIR OGS_DIR_SEPARATOR_S "dict_rfc5777.fdx";
+    diam_config.num_of_ext++;
+    diam_config.ext[diam_config.num_of_ext].module =
+        FD_EXT_DIR OGS_DIR_SEPARATOR_S "dict_mip6i.fdx";
+    diam_config.num_of_ext++;
+    diam_config.ext[diam_config.num_of_ext].module =
+        FD_EXT_DIR OGS_DIR_SEPARATOR_S "dict_nasreq.fdx";
+    diam_config.num_of_ext++;
+    diam_config.ext[diam_config.num_of_ext].module =
+        FD_EXT_DIR OGS_DIR_SEPARATOR_S "dict_nas_mipv6.fdx";
+    diam_config.num_of_ext++;
+    diam_config.ext[diam_config.num_of_ext].module =
+        FD_EXT_DIR OGS_DIR_SEPARATOR_S "dict_dcca.fdx";
+    diam_config.num_of_ext++;
+    diam_config.ext[diam_config.num_of_ext].module =
+        FD_EXT_DIR OGS_DIR_SEPARATOR_S "dict_dcca_3gpp.fdx";
+    diam_config.num_of_ext++;
+
+    diam_config.conn[diam_config.num_of_conn].identity =
+        PCRFBENCH_PCRF_IDENTITY;
+    diam_config.conn[diam_config.num_of_conn].addr = self.pcrf_addr;
+    diam_config.num_of_conn++;
+}
+
+static int subscriber_init(int index)
+{
+    pcrfbench_subscriber_t *subscriber = &self.subscriber[index];
+    ogs_nas_5gs_mobile_identity_suci_t mobile_identity_suci;
+    char msin[OGS_MAX_IMSI_BCD_LEN+1];
+    int i;
+
+    ogs_snprintf(msin, sizeof(msin), "%010llu",
+            (unsigned long long)(atoll(self.msin) + index));
+    if (strlen(msin) != 10) {
+        ogs_error("Invalid MSIN [%s]", msin);
+        return OGS_ERROR;
+    }
+
+    memset(&mobile_identity_suci, 0, sizeof(mobile_identity_suci));
+
+    mobile_identity_suci.h.supi_format = OGS_NAS_5GS_SUPI_FORMAT_IMSI;
+    mobile_identity_suci.h.type = OGS_NAS_5GS_MOBILE_IDENTITY_SUCI;
+    mobile_identity_suci.routing_indicator1 = 0;
+    mobile_identity_suci.routing_indicator2 = 0xf;
+    mobile_identity_suci.routing_indicator3 = 0xf;
+    mobile_identity_suci.routing_indicator4 = 0xf;
+    mobile_identity_suci.protection_scheme_id = OGS_NAS_5GS_NULL_SCHEME;
+    mobile_identity_suci.home_network_pki_value = 0;
+    for (i = 0; i < 5; i++)
+        mobile_identity_suci.scheme_output[i] =
+            ((msin[i*2+1] - '0') << 4) | (msin[i*2] - '0');
+
+    subscriber->test_ue = test_ue_add_by_suci(&mobile_identity_suci, 13);
+    if (!subscriber->test_ue) {
+        ogs_error("Cannot add subscriber [%s]", msin);
+        return OGS_ERROR;
+    }
+
+    subscriber->test_ue->k_string = "465b5ce8b199b49faa5f0a2ee238a6bc";
+    subscriber->test_ue->opc_string = "e8ed289deba952e4283b54e88e6183ca";
+
+    /* 10.0.0.1 for the first subscriber */
+    subscriber->ipv4 = htobe32(0x0a000001 + index);
+
+    if (self.provision) {
+        bson_t *doc = test_db_new_simple(subscriber->test_ue);
+        ogs_assert(doc);
+        if (test_db_insert_ue(subscriber->test_ue, doc) != OGS_OK) {
+            ogs_error("[%s] Cannot insert subscriber",
+                    subscriber->test_ue->imsi);
+            return OGS_ERROR;
+        }
+    }
+
+    return OGS_OK;
+}
+
+static void print_progress(void)
+{
+    uint64_t completed = 0, failed = 0;
+    int i;
+
+    ogs_thread_mutex_lock(&self.lock);
+    for (i = 0; i < MAX_NUM_OF_PCRFBENCH_REQUEST; i++) {
+        completed += self.stats[i].latency.count;
+        failed += self.stats[i].failed;
+    }
+    ogs_thread_mutex_unlock(&self.lock);
+
+    printf("[%6.1fs] requests %llu, failed %llu\n",
+            (ogs_get_monotonic_time() - self.start_time) / 1000000.0,
+            (unsigned long long)completed, (unsigned long long)failed);
+    fflush(stdout);
+}
+
+static void print_report(void)
+{
+    static const char *name[MAX_NUM_OF_PCRFBENCH_REQUEST] = {
+        "CCR-Initial", "CCR-Termination",
+    };
+    pcrfbench_stats_t *stats = NULL;
+    double elapsed;
+    int i;
+
+    elapsed = (ogs_get_monotonic_time() - self.start_time) / 1000000.0;
+
+    printf("\n%d subscribers, %d concurrent sessions, %.1f seconds\n",
+            self.num_of_subscriber, self.num_of_worker, elapsed);
+    printf("%-16s %8s %6s %9s %9s %9s %9s %9s %9s\n",
+            "request", "count", "fail", "req/s",
+            "p50(us)", "p90(us)", "p99(us)", "p99.9(us)", "max(us)");
+
+    ogs_thread_mutex_lock(&self.lock);
+    for (i = 0; i < MAX_NUM_OF_PCRFBENCH_REQUEST; i++) {
+        stats = &self.stats[i];
+
+        printf("%-16s %8llu %6llu %9.1f %9lld %9lld %9lld %9lld %9lld\n",
+                name[i],
+                (unsigned long long)stats->latency.count,
+                (unsigned long long)stats->failed,
+                elapsed > 0 ? stats->latency.count / elapsed : 0,
+                (long long)test_histogram_percentile(&stats->latency, 50),
+                (long long)test_histogram_percentile(&stats->latency, 90),
+                (long long)test_histogram_percentile(&stats->latency, 99),
+                (long long)test_histogram_percentile(&stats->latency, 99.9),
+                (long long)stats->latency.max);
+    }
+    ogs_thread_mutex_unlock(&self.lock);
+}
+
+static int pcrfbench_initialize(void)
+{
+    int i, rv;
+
+    ogs_thread_mutex_init(&self.lock);
+
+    test_context_init();
+    rv = test_context_parse_config();
+    if (rv != OGS_OK) return rv;
+
+    if (self.provision) {
+        rv = ogs_dbi_init(ogs_app()->db_uri);
+        if (rv != OGS_OK) return rv;
+    }
+
+    self.subscriber = ogs_calloc(
+            self.num_of_subscriber, sizeof(pcrfbench_subscriber_t));
+    ogs_assert(self.subscriber);
+
+    printf("Initializing %d subscribers\n", self.num_of_subscriber);
+    for (i = 0; i < self.num_of_subscriber; i++) {
+        rv = subscriber_init(i);
+        if (rv != OGS_OK) return rv;
+    }
+
+    self.worker = ogs_calloc(self.num_of_worker, sizeof(pcrfbench_worker_t));
+    ogs_assert(self.worker);
+    for (i = 0; i < self.num_of_worker; i++)
+        self.worker[i].index = i;
+
+    pcrfbench_diam_config();
+
+    rv = ogs_diam_init(FD_MODE_CLIENT, NULL, &diam_config);
+    if (rv != 0) return OGS_ERROR;
+
+    return pcrfbench_gx_init();
+}
+
+static void pcrfbench_terminate(void)
+{
+    int i;
+
+    pcrfbench_gx_final();
+    ogs_diam_final();
+
+    if (self.worker) {
+        for (i = 0; i < self.num_of_worker; i++)
+            if (self.worker[i].sid)
+                ogs_free(self.worker[i].sid);
+        ogs_free(self.worker);
+    }
+
+    if (self.subscriber) {
+        for (i = 0; i < self.num_of_subscriber; i++) {
+            if (!self.subscriber[i].test_ue)
+                continue;
+            if (self.provision)
+                test_db_remove_ue(self.subscriber[i].test_ue);
+            test_ue_remove(self.subscriber[i].test_ue);
+        }
+        ogs_free(self.subscriber);
+    }
+
+    test_context_final();
+
+    if (self.provision)
+        ogs_dbi_final();
+
+    ogs_thread_mutex_destroy(&self.lock);
+}
+
+static void pcrfbench_run(void)
+{
+    ogs_time_t deadline, last_progress;
+    int i, finished;
+
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(5);
+    while (!stopped && !ogs_diam_peer_connected()) {
+        if (ogs_get_monotonic_time() > deadline) {
+            ogs_fatal("Cannot connect to PCRF [%s]", self.pcrf_addr);
+            return;
+        }
+        ogs_msleep(100);
+    }
+
+    self.start_time = last_progress = ogs_get_monotonic_time();
+
+    for (i = 0; i < self.num_of_worker; i++)
+        pcrfbench_worker_start(&self.worker[i]);
+
+    do {
+        ogs_msleep(100);
+
+        if (ogs_get_monotonic_time() - last_progress >=
+                ogs_time_from_sec(1)) {
+            print_progress();
+            last_progress = ogs_get_monotonic_time();
+        }
+
+        ogs_thread_mutex_lock(&self.lock);
+        finished = self.finished;
+        ogs_thread_mutex_unlock(&self.lock);
+    } while (!stopped && finished < self.num_of_worker);
+
+    print_progress();
+    print_report();
+
+    /* Outstanding answers still refer to the workers */
+    self.stopping = true;
+    if (finished < self.num_of_worker)
+        ogs_msleep(1000);
+}
+
+int main(int argc, const char *const argv[])
+{
+    int rv, i, opt;
+    ogs_getopt_t options;
+    const char *argv_out[argc+1];
+
+    memset(&self, 0, sizeof(self));
+    self.num_of_subscriber = 1000;
+    self.num_of_worker = 64;
+    self.num_of_round = 10;
+    self.provision = true;
+    self.msin = "0000021309";
+    self.apn = "internet";
+    self.local_addr = "127.0.0.1";
+    self.pcrf_addr = "127.0.0.9";
+
+    i = 0;
+    argv_out[i++] = argv[0];
+
+    ogs_getopt_init(&options, (char**)argv);
+    while ((opt = ogs_getopt(&options, "hNc:l:e:m:n:w:r:i:a:L:P:")) != -1) {
+        switch (opt) {
+        case 'h':
+            show_help(argv[0]);
+            return OGS_OK;
+        case 'c':
+            argv_out[i++] = "-c";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'l':
+            argv_out[i++] = "-l";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'e':
+            argv_out[i++] = "-e";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'm':
+            argv_out[i++] = "-m";
+            argv_out[i++] = options.optarg;
+            break;
+        case 'n':
+            self.num_of_subscriber = atoi(options.optarg);
+            break;
+        case 'w':
+            self.num_of_worker = atoi(options.optarg);
+            break;
+        case 'r':
+            self.num_of_round = atoi(options.optarg);
+            break;
+        case 'i':
+            self.msin = options.optarg;
+            break;
+        case 'a':
+            self.apn = options.optarg;
+            break;
+        case 'L':
+            self.local_addr = options.optarg;
+            break;
+        case 'P':
+            self.pcrf_addr = options.optarg;
+            break;
+        case 'N':
+            self.provision = false;
+            break;
+        case '?':
+            fprintf(stderr, "%s: %s\n", argv[0], options.errmsg);
+            show_help(argv[0]);
+            return OGS_ERROR;
+        default:
+            fprintf(stderr, "%s: should not be reached\n", OGS_FUNC);
+            return OGS_ERROR;
+        }
+    }
+    argv_out[i] = NULL;
+
+    if (self.num_of_subscriber <= 0 || self.num_of_worker <= 0 ||
+        self.num_of_round <= 0) {
+        show_help(argv[0]);
+        return OGS_ERROR;
+    }
+
+    /* A subscriber has one session at a time */
+    if (self.num_of_worker > self.num_of_subscriber)
+        self.num_of_worker = self.num_of_subscriber;
+
+    rv = ogs_app_initialize(NULL, DEFAULT_CONFIG_FILENAME, argv_out);
+    if (rv != OGS_OK) {
+        ogs_fatal("PCRF benchmark initialization failed. Aborted");
+        return rv;
+    }
+
+    /* Pools of tests/common are sized by the configuration */
+    if ((uint64_t)self.num_of_subscriber > ogs_app()->max.ue) {
+        ogs_fatal("Too many subscribers [%d > max.ue:%d]",
+                self.num_of_subscriber, (int)ogs_app()->max.ue);
+        ogs_app_terminate();
+        return OGS_ERROR;
+    }
+
+    rv = pcrfbench_initialize();
+    if (rv == OGS_OK) {
+        signal(SIGINT, sig_handler);
+        signal(SIGTERM, sig_handler);
+
+        pcrfbench_run();
+    }
+
+    pcrfbench_terminate();
+    ogs_app_terminate();
+
+    return rv;
+}
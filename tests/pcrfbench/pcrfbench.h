@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2019,2020 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PCRFBENCH_H
+#define PCRFBENCH_H
+
+#include "test-common.h"
+#include "ogs-diameter-gx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Gx load generator for the PCRF
+ *
+ * The tool connects to the PCRF as a Diameter client in place of the SMF.
+ * A number of workers run concurrently, and each worker repeats
+ * CCR-Initial and CCR-Termination for its own subscribers, so that
+ * a Framed-IP-Address is never used by two sessions at the same time.
+ *
+ * The next request of a worker is sent from the callback of the answer,
+ * so the load is driven by the threads of freeDiameter, as in the PCRF.
+ */
+
+#define PCRFBENCH_IDENTITY      "pcrfbench.localdomain"
+#define PCRFBENCH_PCRF_IDENTITY "pcrf.localdomain"
+
+typedef enum {
+    PCRFBENCH_CCR_INITIAL = 0,
+    PCRFBENCH_CCR_TERMINATION,
+
+    MAX_NUM_OF_PCRFBENCH_REQUEST,
+} pcrfbench_request_e;
+
+typedef struct pcrfbench_stats_s {
+    uint64_t failed;
+
+    test_histogram_t latency;   /* Successful answers */
+} pcrfbench_stats_t;
+
+typedef struct pcrfbench_subscriber_s {
+    test_ue_t *test_ue;
+    uint32_t ipv4;              /* Framed-IP-Address in network byte order */
+} pcrfbench_subscriber_t;
+
+typedef struct pcrfbench_worker_s {
+    int index;
+
+    int next;                   /* Next subscriber of this worker */
+    int round;
+    pcrfbench_subscriber_t *subscriber;
+    pcrfbench_request_e request;
+
+    char *sid;                  /* Gx Session-Id of the current session */
+    ogs_time_t start;
+
+    bool done;
+} pcrfbench_worker_t;
+
+typedef struct pcrfbench_context_s {
+    int num_of_subscriber;
+    int num_of_worker;
+    int num_of_round;           /* Sessions per subscriber */
+    bool provision;             /* Insert subscribers in the database */
+
+    const char *msin;           /* MSIN of the first subscriber */
+    const char *apn;
+    const char *local_addr;
+    const char *pcrf_addr;
+
+    pcrfbench_subscriber_t *subscriber;
+    pcrfbench_worker_t *worker;
+
+    ogs_thread_mutex_t lock;    /* Statistics of the answers */
+    int finished;
+    bool stopping;              /* No new session is started */
+    ogs_time_t start_time;
+    pcrfbench_stats_t stats[MAX_NUM_OF_PCRFBENCH_REQUEST];
+} pcrfbench_context_t;
+
+pcrfbench_context_t *pcrfbench_self(void);
+
+int pcrfbench_gx_init(void);
+void pcrfbench_gx_final(void);
+void pcrfbench_worker_start(pcrfbench_worker_t *worker);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCRFBENCH_H */
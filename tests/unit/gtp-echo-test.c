@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-gtp.h"
+#include "core/abts.h"
+
+#define LOCAL_PORT      22152
+#define PEER_PORT       22153
+
+#define NUM_OF_PEER     1000
+
+static ogs_socknode_t *local, *peer;
+
+static struct {
+    int num_of_failure;
+    int num_of_recovery;
+} path;
+
+static ogs_gtp_node_t gnode[NUM_OF_PEER];
+
+static void path_changed(ogs_gtp_node_t *node)
+{
+    if (node->path.down)
+        path.num_of_failure++;
+    else
+        path.num_of_recovery++;
+}
+
+static ogs_socknode_t *server(uint16_t port)
+{
+    ogs_sockaddr_t *addr = NULL;
+    ogs_socknode_t *node = NULL;
+    int rv;
+
+    rv = ogs_getaddrinfo(&addr, AF_INET, "127.0.0.1", port, 0);
+    ogs_assert(rv == OGS_OK);
+    node = ogs_socknode_new(addr);
+    ogs_assert(node);
+    ogs_assert(ogs_udp_server(node));
+    rv = ogs_nonblocking(node->sock->fd);
+    ogs_assert(rv == OGS_OK);
+
+    return node;
+}
+
+static void echo_init(void)
+{
+    int i;
+
+    ogs_app()->timer_mgr = ogs_timer_mgr_create(16);
+    ogs_assert(ogs_app()->timer_mgr);
+
+    ogs_gtp_self()->echo.interval = ogs_time_from_msec(300);
+    ogs_gtp_self()->echo.t3_response_duration = ogs_time_from_msec(100);
+    ogs_gtp_self()->echo.n3_response_rcount = 2;
+
+    local = server(LOCAL_PORT);
+    peer = server(PEER_PORT);
+
+    memset(gnode, 0, sizeof(gnode));
+    for (i = 0; i < NUM_OF_PEER; i++) {
+        gnode[i].sock = local->sock;
+        memcpy(&gnode[i].addr, peer->addr, sizeof(gnode[i].addr));
+    }
+    memset(&path, 0, sizeof(path));
+
+    ogs_assert(ogs_gtp_echo_open(path_changed) == OGS_OK);
+}
+
+static void echo_final(void)
+{
+    int i;
+
+    for (i = 0; i < NUM_OF_PEER; i++)
+        ogs_gtp_echo_remove(&gnode[i]);
+    ogs_gtp_echo_close();
+
+    ogs_socknode_free(local);
+    ogs_socknode_free(peer);
+
+    ogs_timer_mgr_destroy(ogs_app()->timer_mgr);
+    ogs_app()->timer_mgr = NULL;
+
+    memset(&ogs_gtp_self()->echo, 0, sizeof(ogs_gtp_self()->echo));
+}
+
+static ogs_pkbuf_t *recv_pkbuf(ogs_socket_t fd, ogs_sockaddr_t *from)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+    ssize_t size;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN);
+
+    size = ogs_recvfrom(fd, pkbuf->data, pkbuf->len, 0, from);
+    if (size <= 0) {
+        ogs_pkbuf_free(pkbuf);
+        return NULL;
+    }
+    ogs_pkbuf_trim(pkbuf, size);
+
+    return pkbuf;
+}
+
+/* Returns the number of Echo Requests received by the peer */
+static int peer_run(bool answer)
+{
+    ogs_pkbuf_t *pkbuf = NULL, *echo_rsp = NULL;
+    ogs_sockaddr_t from;
+    int n = 0;
+
+    while ((pkbuf = recv_pkbuf(peer->sock->fd, &from))) {
+        n++;
+        if (answer) {
+            echo_rsp = ogs_gtp_handle_echo_req(pkbuf);
+            ogs_assert(echo_rsp);
+            ogs_sendto(peer->sock->fd,
+                    echo_rsp->data, echo_rsp->len, 0, &from);
+            ogs_pkbuf_free(echo_rsp);
+        }
+        ogs_pkbuf_free(pkbuf);
+    }
+
+    while ((pkbuf = recv_pkbuf(local->sock->fd, &from))) {
+        ogs_gtp_send_batch_start();
+        ogs_gtp_echo_handle_response(pkbuf, &from);
+        ogs_gtp_send_batch_flush();
+        ogs_pkbuf_free(pkbuf);
+    }
+
+    return n;
+}
+
+static void gtp_echo_test1(abts_case *tc, void *data)
+{
+    ogs_time_t deadline;
+    int num_of_request;
+
+    echo_init();
+    ogs_gtp_echo_add(&gnode[0]);
+
+    /* The peer answers */
+    num_of_request = 0;
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(2);
+    while (num_of_request < 3 && ogs_get_monotonic_time() < deadline) {
+        ogs_msleep(10);
+        ogs_timer_mgr_expire(ogs_app()->timer_mgr);
+        num_of_request += peer_run(true);
+    }
+    ABTS_INT_EQUAL(tc, 3, num_of_request);
+    ABTS_TRUE(tc, gnode[0].path.down == false);
+    ABTS_INT_EQUAL(tc, 0, gnode[0].path.lost);
+    ABTS_TRUE(tc, gnode[0].path.rtt > 0);
+
+    /* The peer stops answering */
+    num_of_request = 0;
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(2);
+    while (path.num_of_failure == 0 && ogs_get_monotonic_time() < deadline) {
+        ogs_msleep(10);
+        ogs_timer_mgr_expire(ogs_app()->timer_mgr);
+        num_of_request += peer_run(false);
+    }
+    ABTS_INT_EQUAL(tc, 1, path.num_of_failure);
+    ABTS_TRUE(tc, gnode[0].path.down == true);
+
+    /* N3-REQUESTS, and the one in flight when the peer stopped, if any */
+    ABTS_TRUE(tc, num_of_request >= 2 && num_of_request <= 3);
+
+    /* The peer is probed each interval while the path is down */
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(2);
+    while (path.num_of_recovery == 0 && ogs_get_monotonic_time() < deadline) {
+        ogs_msleep(10);
+        ogs_timer_mgr_expire(ogs_app()->timer_mgr);
+        peer_run(true);
+    }
+    ABTS_INT_EQUAL(tc, 1, path.num_of_failure);
+    ABTS_INT_EQUAL(tc, 1, path.num_of_recovery);
+    ABTS_TRUE(tc, gnode[0].path.down == false);
+
+    echo_final();
+}
+
+static void gtp_echo_test2(abts_case *tc, void *data)
+{
+    ogs_time_t deadline;
+    int i;
+
+    echo_init();
+
+    /* Nobody answers, so the address of the peer can be shared */
+    for (i = 0; i < NUM_OF_PEER; i++)
+        ogs_gtp_echo_add(&gnode[i]);
+
+    /* The timer is run late */
+    ogs_msleep(400);
+
+    deadline = ogs_get_monotonic_time() + ogs_time_from_sec(3);
+    while (path.num_of_failure < NUM_OF_PEER &&
+            ogs_get_monotonic_time() < deadline) {
+        ogs_msleep(10);
+        ogs_timer_mgr_expire(ogs_app()->timer_mgr);
+        peer_run(false);
+    }
+    ABTS_INT_EQUAL(tc, NUM_OF_PEER, path.num_of_failure);
+
+    for (i = 0; i < NUM_OF_PEER; i++) {
+        ABTS_TRUE(tc, gnode[i].path.down == true);
+        ABTS_INT_EQUAL(tc, 2, gnode[i].path.lost);
+    }
+
+    echo_final();
+}
+
+abts_suite *test_gtp_echo(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, gtp_echo_test1, NULL);
+    abts_run_test(suite, gtp_echo_test2, NULL);
+
+    return suite;
+}
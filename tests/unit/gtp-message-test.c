@@ -307,11 +307,83 @@ static void gtp_message_test1(abts_case *tc, void *data)
     ABTS_INT_EQUAL(tc, 0, req.ue_tcp_port.presence);
 }
 
+static void gtp_message_test2(abts_case *tc, void *data)
+{
+    int rv;
+    /* Create Session Request */
+    const char *_payload = 
+        "0100080055153011 340010f44c000600 9471527600414b00 0800536120009178"
+        "840056000d001855 f501102255f50100 019d015300030055 f501520001000657"
+        "0009008a80000084 0a32360a57000901 87000000000a3236 254700220005766f"
+        "6c7465036e673204 6d6e6574066d6e63 303130066d636335 3535046770727380"
+        "000100fc63000100 014f000500010000 00007f0001000048 000800000003e800"
+        "0007d04e001a0080 8021100100001081 0600000000830600 000000000d00000a"
+        "005d001f00490001 0005500016004505 0000000000000000 0000000000000000"
+        "0000000072000200 40005f0002005400";
+    char hexbuf[OGS_MAX_SDU_LEN];
+    int len;
+
+    ogs_gtp_message_t message;
+    ogs_gtp_create_session_request_t *req =
+        &message.create_session_request;
+    ogs_gtp_header_t *h = NULL;
+    ogs_pkbuf_t *pkbuf = NULL, *rebuilt = NULL;
+
+    OGS_HEX(_payload, strlen(_payload), hexbuf);
+    len = 240;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_TLV_MAX_HEADROOM + len);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+    ogs_pkbuf_reserve(pkbuf, OGS_TLV_MAX_HEADROOM);
+    ogs_pkbuf_put_data(pkbuf, hexbuf, len);
+
+    h = (ogs_gtp_header_t *)ogs_pkbuf_push(pkbuf, OGS_GTPV2C_HEADER_LEN);
+    memset(h, 0, OGS_GTPV2C_HEADER_LEN);
+    h->version = 2;
+    h->teid_presence = 1;
+    h->type = OGS_GTP_CREATE_SESSION_REQUEST_TYPE;
+    h->length = htobe16(pkbuf->len - 4);
+
+    /* The generated decoder dispatches the IEs with a switch */
+    rv = ogs_gtp_parse_msg(&message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+    ABTS_INT_EQUAL(tc, 1, req->imsi.presence);
+    ABTS_INT_EQUAL(tc, 8, req->imsi.len);
+    ABTS_INT_EQUAL(tc, 1, req->rat_type.presence);
+    ABTS_INT_EQUAL(tc, OGS_GTP_RAT_TYPE_EUTRAN, req->rat_type.u8);
+    ABTS_INT_EQUAL(tc, 1, req->sender_f_teid_for_control_plane.presence);
+    ABTS_INT_EQUAL(tc, 1,
+            req->pgw_s5_s8_address_for_control_plane_or_pmip.presence);
+    ABTS_INT_EQUAL(tc, 1, req->bearer_contexts_to_be_created.presence);
+    ABTS_INT_EQUAL(tc, 5,
+            req->bearer_contexts_to_be_created.eps_bearer_id.u8);
+    ABTS_INT_EQUAL(tc, 22,
+            req->bearer_contexts_to_be_created.bearer_level_qos.len);
+    ABTS_INT_EQUAL(tc, 0, req->bearer_contexts_to_be_removed.presence);
+    ABTS_INT_EQUAL(tc, 1, req->charging_characteristics.presence);
+
+    /* The generated encoder gives back the same octets */
+    rebuilt = ogs_gtp_build_msg(&message);
+    ABTS_PTR_NOTNULL(tc, rebuilt);
+    ABTS_INT_EQUAL(tc, len, rebuilt->len);
+    ABTS_TRUE(tc, memcmp(rebuilt->data, hexbuf, len) == 0);
+    ogs_pkbuf_free(rebuilt);
+
+    /* The last IE overruns the message */
+    ogs_pkbuf_trim(pkbuf, pkbuf->len - 1);
+    rv = ogs_gtp_parse_msg(&message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_ERROR, rv);
+
+    ogs_pkbuf_free(pkbuf);
+}
+
 abts_suite *test_gtp_message(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
 
     abts_run_test(suite, gtp_message_test1, NULL);
+    abts_run_test(suite, gtp_message_test2, NULL);
 
     return suite;
 }
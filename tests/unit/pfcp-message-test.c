@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-pfcp.h"
+#include "core/abts.h"
+
+/*
+ * The test plays the UPF: it reports its load in a Session Establishment
+ * Response, and the SMF side of the library applies it to the node.
+ */
+static void pfcp_message_send_response(abts_case *tc, ogs_pfcp_node_t *node)
+{
+    int rv;
+    ogs_pfcp_message_t pfcp_message;
+    ogs_pfcp_session_establishment_response_t *rsp = NULL;
+    ogs_pfcp_header_t *h = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    rsp = &pfcp_message.pfcp_session_establishment_response;
+    memset(&pfcp_message, 0, sizeof(ogs_pfcp_message_t));
+
+    rsp->cause.presence = 1;
+    rsp->cause.u8 = OGS_PFCP_CAUSE_REQUEST_ACCEPTED;
+    ogs_pfcp_up_build_load_control_information(
+            &rsp->load_control_information);
+    ogs_pfcp_up_build_overload_control_information(
+            &rsp->overload_control_information);
+
+    pfcp_message.h.type = OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE;
+    pkbuf = ogs_pfcp_build_msg(&pfcp_message);
+    ABTS_PTR_NOTNULL(tc, pkbuf);
+
+    h = (ogs_pfcp_header_t *)ogs_pkbuf_push(pkbuf, OGS_PFCP_HEADER_LEN);
+    memset(h, 0, OGS_PFCP_HEADER_LEN);
+    h->version = OGS_PFCP_VERSION;
+    h->seid_presence = 1;
+    h->type = OGS_PFCP_SESSION_ESTABLISHMENT_RESPONSE_TYPE;
+    h->length = htobe16(pkbuf->len - 4);
+
+    rv = ogs_pfcp_parse_msg(&pfcp_message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_pkbuf_free(pkbuf);
+
+    ogs_pfcp_cp_handle_load_control_information(node,
+            &rsp->load_control_information);
+    ogs_pfcp_cp_handle_overload_control_information(node,
+            &rsp->overload_control_information);
+}
+
+static void pfcp_message_test1(abts_case *tc, void *data)
+{
+    ogs_pfcp_node_t node;
+    uint32_t sqn;
+    int i, throttled;
+
+    memset(&node, 0, sizeof(node));
+    ogs_pfcp_self()->cp_function_features.octet5 = 0;
+
+    /* No report unless the SMF supports Load Control */
+    ogs_pfcp_up_update_load(30);
+    pfcp_message_send_response(tc, &node);
+    ABTS_TRUE(tc, node.load.received == false);
+
+    ogs_pfcp_self()->cp_function_features.load = 1;
+    ogs_pfcp_self()->cp_function_features.ovrl = 1;
+
+    pfcp_message_send_response(tc, &node);
+    ABTS_TRUE(tc, node.load.received == true);
+    ABTS_INT_EQUAL(tc, 30, node.load.metric);
+    ABTS_TRUE(tc, node.overload.received == false);
+    ABTS_TRUE(tc, ogs_pfcp_node_overloaded(&node) == false);
+    ABTS_TRUE(tc, ogs_pfcp_node_throttled(&node) == false);
+
+    /* A stale sequence number is ignored */
+    sqn = ogs_pfcp_self()->load.sqn;
+    ogs_pfcp_up_update_load(40);
+    ogs_pfcp_self()->load.sqn = sqn;
+    pfcp_message_send_response(tc, &node);
+    ABTS_INT_EQUAL(tc, 30, node.load.metric);
+    ogs_pfcp_self()->load.sqn = sqn + 1;
+
+    /* Overload at 90% : reduce half of the new sessions */
+    ogs_pfcp_up_update_load(90);
+    pfcp_message_send_response(tc, &node);
+    ABTS_INT_EQUAL(tc, 90, node.load.metric);
+    ABTS_INT_EQUAL(tc, 50, node.overload.metric);
+    ABTS_TRUE(tc, ogs_pfcp_node_overloaded(&node) == true);
+
+    throttled = 0;
+    for (i = 0; i < 100; i++)
+        if (ogs_pfcp_node_throttled(&node) == true)
+            throttled++;
+    ABTS_INT_EQUAL(tc, 50, throttled);
+
+    /* Still overloaded until the load drops to 80% */
+    ogs_pfcp_up_update_load(85);
+    pfcp_message_send_response(tc, &node);
+    ABTS_INT_EQUAL(tc, 25, node.overload.metric);
+    ABTS_TRUE(tc, ogs_pfcp_node_overloaded(&node) == true);
+
+    ogs_pfcp_up_update_load(80);
+    pfcp_message_send_response(tc, &node);
+    ABTS_INT_EQUAL(tc, 80, node.load.metric);
+    ABTS_INT_EQUAL(tc, 0, node.overload.metric);
+    ABTS_TRUE(tc, ogs_pfcp_node_overloaded(&node) == false);
+    ABTS_TRUE(tc, ogs_pfcp_node_throttled(&node) == false);
+
+    /* The overload expires with the Period of Validity */
+    ogs_pfcp_up_update_load(100);
+    pfcp_message_send_response(tc, &node);
+    ABTS_INT_EQUAL(tc, 100, node.overload.metric);
+    ABTS_TRUE(tc, ogs_pfcp_node_throttled(&node) == true);
+    node.overload.expires = ogs_get_monotonic_time() - 1;
+    ABTS_TRUE(tc, ogs_pfcp_node_overloaded(&node) == false);
+
+    ogs_pfcp_self()->cp_function_features.octet5 = 0;
+}
+
+static void pfcp_message_test2(abts_case *tc, void *data)
+{
+    ABTS_INT_EQUAL(tc, 0x05, ogs_pfcp_timer_from_time(ogs_time_from_sec(10)));
+    ABTS_INT_EQUAL(tc, 0x1f, ogs_pfcp_timer_from_time(ogs_time_from_sec(62)));
+    ABTS_INT_EQUAL(tc, 0x22, ogs_pfcp_timer_from_time(ogs_time_from_sec(90)));
+    ABTS_INT_EQUAL(tc, 0xe0,
+            ogs_pfcp_timer_from_time(ogs_time_from_sec(2000000)));
+
+    ABTS_TRUE(tc, ogs_time_from_sec(10) == ogs_pfcp_timer_to_time(0x05));
+    ABTS_TRUE(tc, ogs_time_from_sec(120) == ogs_pfcp_timer_to_time(0x22));
+    ABTS_TRUE(tc, ogs_time_from_sec(3 * 600) == ogs_pfcp_timer_to_time(0x43));
+    ABTS_TRUE(tc, ogs_time_from_sec(2 * 60) == ogs_pfcp_timer_to_time(0xa2));
+    ABTS_TRUE(tc, 0 == ogs_pfcp_timer_to_time(0xe0));
+}
+
+abts_suite *test_pfcp_message(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, pfcp_message_test1, NULL);
+    abts_run_test(suite, pfcp_message_test2, NULL);
+
+    return suite;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-pfcp.h"
+#include "core/abts.h"
+
+/*
+ * The test plays the UPF under a storm of Error Indications
+ * from a gNB which lost the contexts of all its UEs.
+ */
+#define NUM_OF_SESS     2000
+#define NUM_OF_ERR_IND  50000
+
+static ogs_pfcp_node_t node;
+static ogs_pfcp_sess_t sess[NUM_OF_SESS];
+
+static struct {
+    int num_of_request;
+    int num_of_dldr;
+    int num_of_erir;
+} sent;
+
+static void send_report(
+        ogs_pfcp_sess_t *pfcp_sess, ogs_pfcp_user_plane_report_t *report)
+{
+    sent.num_of_request++;
+    if (report->type.downlink_data_report)
+        sent.num_of_dldr++;
+    if (report->type.error_indication_report)
+        sent.num_of_erir++;
+}
+
+static void report_init(ogs_time_t window, uint32_t rate, uint32_t burst)
+{
+    ogs_pfcp_self()->report.window = window;
+    ogs_pfcp_self()->report.rate = rate;
+    ogs_pfcp_self()->report.burst = burst;
+
+    memset(&node, 0, sizeof(node));
+    ogs_list_init(&node.report.pending_list);
+    memset(sess, 0, sizeof(sess));
+    memset(&sent, 0, sizeof(sent));
+}
+
+static void error_indication(ogs_pfcp_user_plane_report_t *report, int i)
+{
+    memset(report, 0, sizeof(*report));
+    report->type.error_indication_report = 1;
+    report->error_indication.remote_f_teid.teid = i + 1;
+    report->error_indication.remote_f_teid_len = 5;
+}
+
+static void pfcp_report_test1(abts_case *tc, void *data)
+{
+    ogs_pfcp_user_plane_report_t report;
+    int result[OGS_PFCP_MAX_NUM_OF_REPORT_RESULT];
+    int i, n;
+
+    report_init(0, 0, 0);
+    memset(result, 0, sizeof(result));
+
+    for (i = 0; i < NUM_OF_ERR_IND; i++) {
+        error_indication(&report, i);
+        result[ogs_pfcp_up_report_add(
+                &node, &sess[i % NUM_OF_SESS], &report)]++;
+    }
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS, result[OGS_PFCP_REPORT_QUEUED]);
+    ABTS_INT_EQUAL(tc, NUM_OF_ERR_IND - NUM_OF_SESS,
+            result[OGS_PFCP_REPORT_MERGED]);
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS,
+            ogs_list_count(&node.report.pending_list));
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS, ogs_pfcp_self()->report.num_of_pending);
+
+    /* The first Error Indication of the session is reported */
+    ABTS_INT_EQUAL(tc, 1,
+            sess[0].report.pending.error_indication.remote_f_teid.teid);
+
+    /* Another trigger is merged into the same request */
+    memset(&report, 0, sizeof(report));
+    report.type.downlink_data_report = 1;
+    report.downlink_data.pdr_id = 2;
+    ABTS_INT_EQUAL(tc, OGS_PFCP_REPORT_MERGED,
+            ogs_pfcp_up_report_add(&node, &sess[0], &report));
+    ABTS_INT_EQUAL(tc, 2, sess[0].report.pending.downlink_data.pdr_id);
+
+    n = ogs_pfcp_up_report_flush(&node, send_report);
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS, n);
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS, sent.num_of_request);
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS, sent.num_of_erir);
+    ABTS_INT_EQUAL(tc, 1, sent.num_of_dldr);
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&node.report.pending_list));
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_self()->report.num_of_pending);
+
+    /* The storm goes on while the SMF handles the requests */
+    memset(result, 0, sizeof(result));
+    for (i = 0; i < NUM_OF_ERR_IND; i++) {
+        error_indication(&report, i);
+        result[ogs_pfcp_up_report_add(
+                &node, &sess[i % NUM_OF_SESS], &report)]++;
+    }
+    ABTS_INT_EQUAL(tc, NUM_OF_ERR_IND, result[OGS_PFCP_REPORT_SUPPRESSED]);
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_up_report_flush(&node, send_report));
+
+    /* A new report once the response is received */
+    ogs_pfcp_up_report_done(&sess[5]);
+    error_indication(&report, 5);
+    ABTS_INT_EQUAL(tc, OGS_PFCP_REPORT_QUEUED,
+            ogs_pfcp_up_report_add(&node, &sess[5], &report));
+    ABTS_INT_EQUAL(tc, 1, ogs_pfcp_self()->report.num_of_pending);
+
+    /* The session is removed before the report is sent */
+    ogs_pfcp_up_report_cancel(&sess[5]);
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&node.report.pending_list));
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_self()->report.num_of_pending);
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_up_report_flush(&node, send_report));
+}
+
+static void pfcp_report_test2(abts_case *tc, void *data)
+{
+    ogs_pfcp_user_plane_report_t report;
+    ogs_time_t start, elapsed;
+    int i;
+
+    /* The reports are held for the window */
+    report_init(ogs_time_from_msec(50), 0, 0);
+
+    error_indication(&report, 0);
+    ogs_pfcp_up_report_add(&node, &sess[0], &report);
+    ABTS_INT_EQUAL(tc, 0, ogs_pfcp_up_report_flush(&node, send_report));
+
+    ogs_msleep(60);
+    ABTS_INT_EQUAL(tc, 1, ogs_pfcp_up_report_flush(&node, send_report));
+
+    /* 10000 requests per second with a burst of 100 */
+    report_init(0, 10000, 100);
+
+    for (i = 0; i < NUM_OF_SESS; i++) {
+        error_indication(&report, i);
+        ogs_pfcp_up_report_add(&node, &sess[i], &report);
+    }
+
+    start = ogs_get_monotonic_time();
+    ABTS_INT_EQUAL(tc, 100, ogs_pfcp_up_report_flush(&node, send_report));
+
+    while (ogs_list_first(&node.report.pending_list)) {
+        ogs_msleep(1);
+        ogs_pfcp_up_report_flush(&node, send_report);
+
+        elapsed = ogs_get_monotonic_time() - start;
+        ABTS_TRUE(tc, sent.num_of_request <=
+                100 + elapsed * 10000 / OGS_USEC_PER_SEC + 1);
+        if (elapsed > ogs_time_from_sec(5))
+            break;
+    }
+    ABTS_INT_EQUAL(tc, NUM_OF_SESS, sent.num_of_request);
+
+    /* (2000 - 100) / 10000 = 190ms at least */
+    elapsed = ogs_get_monotonic_time() - start;
+    ABTS_TRUE(tc, elapsed >= ogs_time_from_msec(190) - 1000);
+}
+
+abts_suite *test_pfcp_report(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, pfcp_report_test1, NULL);
+    abts_run_test(suite, pfcp_report_test2, NULL);
+
+    return suite;
+}